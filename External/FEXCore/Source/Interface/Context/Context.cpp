@@ -187,6 +187,18 @@ namespace FEXCore::Context {
     CTX->FinalizeAOTIRCache();
   }
 
+  void SetCodeCacheFDRequester(FEXCore::Context::Context *CTX, std::function<int(const std::string&)> Requester) {
+    CTX->SetCodeCacheFDRequester(std::move(Requester));
+  }
+
+  void AddNamedRegion(FEXCore::Context::Context *CTX, uintptr_t Base, uintptr_t Size, uintptr_t Offset, const std::string &Filename, const std::string &FileIdentity) {
+    CTX->AddNamedRegion(Base, Size, Offset, Filename, FileIdentity);
+  }
+
+  void RemoveNamedRegion(FEXCore::Context::Context *CTX, uintptr_t Base, uintptr_t Size) {
+    CTX->RemoveNamedRegion(Base, Size);
+  }
+
   void WriteFilesWithCode(FEXCore::Context::Context *CTX, std::function<void(const std::string& fileid, const std::string& filename)> Writer) {
     CTX->WriteFilesWithCode(Writer);
   }
@@ -3,6 +3,7 @@
 #include "Common/JitSymbols.h"
 #include "FEXHeaderUtils/ScopedSignalMask.h"
 #include "Interface/Core/CPUID.h"
+#include "Interface/Core/DecodeCache.h"
 #include "Interface/Core/X86HelperGen.h"
 #include "Interface/Core/ObjectCache/ObjectCacheService.h"
 #include "Interface/Core/Dispatcher/Dispatcher.h"
@@ -15,6 +16,7 @@
 #include <FEXCore/Debug/InternalThreadState.h>
 #include <FEXCore/Utils/CompilerDefs.h>
 #include <FEXCore/Utils/Event.h>
+#include <FEXCore/Utils/ThreadPoolAllocator.h>
 #include <FEXHeaderUtils/Syscalls.h>
 #include <stdint.h>
 
@@ -26,10 +28,12 @@
 #include <map>
 #include <memory>
 #include <mutex>
+#include <set>
 #include <shared_mutex>
 #include <stddef.h>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <queue>
 #include <vector>
 
@@ -90,13 +94,15 @@ namespace FEXCore::Context {
       bool ValidateIRarser { false };
 
       FEX_CONFIG_OPT(Multiblock, MULTIBLOCK);
+      FEX_CONFIG_OPT(MultiblockFunctions, MULTIBLOCKFUNCTIONS);
       FEX_CONFIG_OPT(SingleStepConfig, SINGLESTEP);
       FEX_CONFIG_OPT(GdbServer, GDBSERVER);
       FEX_CONFIG_OPT(Is64BitMode, IS64BIT_MODE);
       FEX_CONFIG_OPT(TSOEnabled, TSOENABLED);
       FEX_CONFIG_OPT(TSOAutoMigration, TSOAUTOMIGRATION);
+      FEX_CONFIG_OPT(TSORelaxPrivateAccesses, TSORELAXPRIVATEACCESSES);
+      FEX_CONFIG_OPT(TSOPageTracking, TSOPAGETRACKING);
       FEX_CONFIG_OPT(ABILocalFlags, ABILOCALFLAGS);
-      FEX_CONFIG_OPT(ABINoPF, ABINOPF);
       FEX_CONFIG_OPT(AOTIRCapture, AOTIRCAPTURE);
       FEX_CONFIG_OPT(AOTIRGenerate, AOTIRGENERATE);
       FEX_CONFIG_OPT(AOTIRLoad, AOTIRLOAD);
@@ -324,15 +330,49 @@ namespace FEXCore::Context {
       IRCaptureCache.SetAOTIRRenamer(CacheRenamer);
     }
 
+    void SetCodeCacheFDRequester(std::function<int(const std::string&)> Requester);
+    void AddNamedRegion(uintptr_t Base, uintptr_t Size, uintptr_t Offset, const std::string &Filename, const std::string &FileIdentity);
+    void RemoveNamedRegion(uintptr_t Base, uintptr_t Size);
+
     void AppendThunkDefinitions(std::vector<FEXCore::IR::ThunkDefinition> const& Definitions);
 
-    FEXCore::Utils::PooledAllocatorMMap OpDispatcherAllocator;
     FEXCore::Utils::PooledAllocatorMMap FrontendAllocator;
+    // Decoded guest instructions shared by every thread's frontend
+    FEXCore::Frontend::DecodedInstructionCache DecodeCache;
 
     void MarkMemoryShared();
+    void MarkMemorySharedByThreads();
 
     bool IsTSOEnabled() { return (IsMemoryShared || !Config.TSOAutoMigration) && Config.TSOEnabled; }
 
+    // With TSO page tracking only blocks that were seen touching shared pages get TSO memory ops
+    bool IsTSOPageTrackingActive() const { return TSOPageTrackingActive; }
+    bool IsTSORequired(uint64_t GuestRIP);
+    void MarkBlockRequiresTSO(uint64_t GuestRIP);
+
+    // Pages that validate their code on every run instead of relying on mtrack write protection
+    void MarkGuestCodePageValidated(uint64_t PageBase);
+    bool IsGuestCodePageValidated(uint64_t PageBase);
+    void ClearGuestCodePagesValidated(uint64_t Start, uint64_t Length);
+    bool IsGuestCodeRangeValidated(uint64_t Start, uint64_t Length);
+
+    // Process wide record of the guest bytes covered by compiled code, in 64 byte chunks.
+    // Lock and allocation free so the SMC fault handler can query it
+    void AddGuestCodeChunks(uint64_t Start, uint64_t Length);
+    void ClearGuestCodeChunks(uint64_t Start, uint64_t Length);
+    bool IsGuestCodeInRange(uint64_t Start, uint64_t Length);
+
+    // Guest function bounds that MultiblockFunctions compilation is allowed to grow to
+    void AddFunctionRanges(std::vector<FunctionRange> const &Ranges);
+    void RemoveFunctionRanges(uint64_t Base, uint64_t Size);
+    bool FindFunctionRange(uint64_t RIP, FunctionRange *Range);
+
+    // Gives back the thread's IR arena memory while it isn't compiling
+    void ReleaseCompileMemory(FEXCore::Core::InternalThreadState *Thread);
+
+    // If the block can come from or go to the code object cache
+    bool IsBlockCacheable(uint64_t GuestRIP);
+
   protected:
     void ClearCodeCache(FEXCore::Core::InternalThreadState *Thread);
 
@@ -370,8 +410,35 @@ namespace FEXCore::Context {
 
     bool StartPaused = false;
     bool IsMemoryShared = false;
+    std::atomic_bool TSOPageTrackingActive {false};
+
+    std::shared_mutex TSORequiredBlocksMutex;
+    std::unordered_set<uint64_t> TSORequiredBlocks;
+
+    std::shared_mutex SMCValidatedPagesMutex;
+    std::set<uint64_t> SMCValidatedPages;
+    // Lets compilation skip the lock while no page is validated
+    std::atomic<size_t> SMCValidatedPagesCount{};
     FEX_CONFIG_OPT(AppFilename, APP_FILENAME);
 
+    struct GuestCodeChunkPage {
+      // Guest page number + 1, zero while the slot is free. Slots are never given back
+      std::atomic<uint64_t> Page;
+      // Bit N set if bytes [N * 64, N * 64 + 64) of the page are part of a compiled block
+      std::atomic<uint64_t> Chunks;
+    };
+    static constexpr size_t GuestCodeChunkPagesCount = 1 << 16;
+    static constexpr size_t GuestCodeChunkMaxProbes = 32;
+    // Only allocated with mtrack SMC checks
+    GuestCodeChunkPage *GuestCodeChunkPages{};
+    // A page didn't get a slot, lookups that miss have to assume code
+    std::atomic_bool GuestCodeChunkPagesFull{};
+    GuestCodeChunkPage *FindGuestCodeChunkPage(uint64_t Page, bool Insert);
+
+    std::shared_mutex FunctionRangesMutex;
+    // Function start to function end
+    std::map<uint64_t, uint64_t> FunctionRanges;
+
     std::shared_mutex CustomIRMutex;
     std::unordered_map<uint64_t, std::tuple<std::function<void(uintptr_t Entrypoint, FEXCore::IR::IREmitter *)>, void *, void *>> CustomIRHandlers;
     FEXCore::CPU::CPUBackendFeatures BackendFeatures;
@@ -7,6 +7,7 @@
 #include <FEXCore/Utils/Telemetry.h>
 
 #include <atomic>
+#include <bit>
 #include <csignal>
 #include <cstdint>
 
@@ -2316,4 +2317,98 @@ bool HandleSIGBUS(bool ParanoidTSO, int Signal, void *info, void *ucontext) {
   return false;
 }
 
+
+bool EmulateStore(void *ucontext, StoreWriter const &Write) {
+  uint32_t *PC = (uint32_t*)ArchHelpers::Context::GetPc(ucontext);
+  const uint32_t Instr = PC[0];
+  const uint32_t Size = (Instr >> 30) & 0b11;
+  const uint32_t AddrReg = (Instr >> 5) & 0b1'1111;
+  const uint32_t DataReg = Instr & 0b1'1111;
+
+  // Register 31 is SP as a base and XZR as data
+  const uint64_t Base = AddrReg == 31 ? ArchHelpers::Context::GetSp(ucontext) : ArchHelpers::Context::GetArmReg(ucontext, AddrReg);
+  auto GetGPR = [ucontext](uint32_t Reg) -> uint64_t {
+    return Reg == 31 ? 0 : ArchHelpers::Context::GetArmReg(ucontext, Reg);
+  };
+  auto GetIndex = [&](uint32_t Scale) -> uint64_t {
+    const uint32_t Option = (Instr >> 13) & 0b111;
+    const bool Shift = (Instr >> 12) & 1;
+    uint64_t Index = GetGPR((Instr >> 16) & 0b1'1111);
+    switch (Option) {
+      case 0b010: Index = static_cast<uint32_t>(Index); break; // UXTW
+      case 0b110: Index = static_cast<int64_t>(static_cast<int32_t>(Index)); break; // SXTW
+      case 0b011: // LSL
+      case 0b111: break; // SXTX
+      default: return ~0ULL;
+    }
+    return Shift ? Index << Scale : Index;
+  };
+
+  bool Vector {};
+  bool Release {};
+  uint32_t AccessSize {};
+  uint64_t Addr {};
+
+  if ((Instr & 0x3FC0'0000) == 0x3900'0000) { // STR{B,H} unsigned offset
+    AccessSize = 1U << Size;
+    Addr = Base + (((Instr >> 10) & 0xFFF) << Size);
+  }
+  else if ((Instr & 0x3FE0'0C00) == 0x3800'0000 || // STUR{B,H}
+           (Instr & RCPC2_MASK) == STLUR_INST) {   // STLUR{B,H}
+    AccessSize = 1U << Size;
+    Release = (Instr & RCPC2_MASK) == STLUR_INST;
+    Addr = Base + (static_cast<int32_t>(Instr) << 11 >> 23);
+  }
+  else if ((Instr & 0x3FE0'0C00) == 0x3820'0800) { // STR{B,H} register offset
+    AccessSize = 1U << Size;
+    const uint64_t Index = GetIndex(Size);
+    if (Index == ~0ULL) {
+      return false;
+    }
+    Addr = Base + Index;
+  }
+  else if ((Instr & 0x3FFF'FC00) == 0x089F'FC00) { // STLR{B,H}
+    AccessSize = 1U << Size;
+    Release = true;
+    Addr = Base;
+  }
+  else if ((Instr & 0x3F40'0000) == 0x3D00'0000) { // STR (SIMD&FP) unsigned offset
+    Vector = true;
+    AccessSize = (Instr >> 23) & 1 ? 16 : 1U << Size;
+    Addr = Base + (((Instr >> 10) & 0xFFF) * AccessSize);
+  }
+  else if ((Instr & 0x3F60'0C00) == 0x3C00'0000) { // STUR (SIMD&FP)
+    Vector = true;
+    AccessSize = (Instr >> 23) & 1 ? 16 : 1U << Size;
+    Addr = Base + (static_cast<int32_t>(Instr) << 11 >> 23);
+  }
+  else if ((Instr & 0x3F60'0C00) == 0x3C20'0800) { // STR (SIMD&FP) register offset
+    Vector = true;
+    AccessSize = (Instr >> 23) & 1 ? 16 : 1U << Size;
+    const uint64_t Index = GetIndex(std::countr_zero(AccessSize));
+    if (Index == ~0ULL) {
+      return false;
+    }
+    Addr = Base + Index;
+  }
+  else {
+    return false;
+  }
+
+  bool Result {};
+  if (Vector) {
+    const __uint128_t Data = ArchHelpers::Context::GetArmFPR(ucontext, DataReg);
+    Result = Write(Addr, &Data, AccessSize, Release);
+  }
+  else {
+    const uint64_t Data = GetGPR(DataReg);
+    Result = Write(Addr, &Data, AccessSize, Release);
+  }
+
+  if (Result) {
+    ArchHelpers::Context::SetPc(ucontext, ArchHelpers::Context::GetPc(ucontext) + 4);
+  }
+  return Result;
+}
+
 }
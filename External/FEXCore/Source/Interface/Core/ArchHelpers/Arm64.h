@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstddef>
+#include <functional>
 #include <stdint.h>
 
 namespace FEXCore::ArchHelpers::Arm64 {
@@ -106,4 +108,10 @@ namespace FEXCore::ArchHelpers::Arm64 {
   bool HandleCASAL(void *_ucontext, void *_info, uint32_t Instr);
   bool HandleAtomicMemOp(void *_ucontext, void *_info, uint32_t Instr);
   [[nodiscard]] bool HandleSIGBUS(bool ParanoidTSO, int Signal, void *info, void *ucontext);
+
+  // Decodes the store at the faulting PC and hands its target and data to Write.
+  // Steps over the store if Write returns true.
+  // Covers the single register store forms, returns false for anything else.
+  using StoreWriter = std::function<bool(uint64_t Addr, void const *Data, size_t Size, bool Release)>;
+  [[nodiscard]] bool EmulateStore(void *ucontext, StoreWriter const &Write);
 }
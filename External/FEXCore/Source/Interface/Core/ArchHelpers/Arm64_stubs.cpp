@@ -22,6 +22,11 @@ bool HandleCASAL(void *_ucontext, void *_info, uint32_t Instr) {
 bool HandleAtomicMemOp(void *_ucontext, void *_info, uint32_t Instr) {
     ERROR_AND_DIE_FMT("HandleAtomicMemOp Not Implemented");
 }
+
+bool EmulateStore(void *ucontext, StoreWriter const &Write) {
+    // Only arm64 stores can be decoded, callers fall back to their slow path
+    return false;
+}
 #endif
 
 }
@@ -2885,7 +2885,18 @@ public:
 
   // SVE Floating Point Multiply-Add
   // SVE floating-point multiply-accumulate writing addend
-  // XXX:
+  void fmla(FEXCore::ARMEmitter::SubRegSize size, FEXCore::ARMEmitter::ZRegister zda, FEXCore::ARMEmitter::PRegisterMerge pg, FEXCore::ARMEmitter::ZRegister zn, FEXCore::ARMEmitter::ZRegister zm) {
+    SVEFloatMultiplyAddAddend(0b00, size, pg, zm, zn, zda);
+  }
+  void fmls(FEXCore::ARMEmitter::SubRegSize size, FEXCore::ARMEmitter::ZRegister zda, FEXCore::ARMEmitter::PRegisterMerge pg, FEXCore::ARMEmitter::ZRegister zn, FEXCore::ARMEmitter::ZRegister zm) {
+    SVEFloatMultiplyAddAddend(0b01, size, pg, zm, zn, zda);
+  }
+  void fnmla(FEXCore::ARMEmitter::SubRegSize size, FEXCore::ARMEmitter::ZRegister zda, FEXCore::ARMEmitter::PRegisterMerge pg, FEXCore::ARMEmitter::ZRegister zn, FEXCore::ARMEmitter::ZRegister zm) {
+    SVEFloatMultiplyAddAddend(0b10, size, pg, zm, zn, zda);
+  }
+  void fnmls(FEXCore::ARMEmitter::SubRegSize size, FEXCore::ARMEmitter::ZRegister zda, FEXCore::ARMEmitter::PRegisterMerge pg, FEXCore::ARMEmitter::ZRegister zn, FEXCore::ARMEmitter::ZRegister zm) {
+    SVEFloatMultiplyAddAddend(0b11, size, pg, zm, zn, zda);
+  }
   // SVE floating-point multiply-accumulate writing multiplicand
   // XXX:
 
@@ -3679,6 +3690,20 @@ private:
     dc32(Instr);
   }
 
+  // SVE floating-point multiply-accumulate writing addend
+  void SVEFloatMultiplyAddAddend(uint32_t opc, FEXCore::ARMEmitter::SubRegSize size, FEXCore::ARMEmitter::PRegister pg, FEXCore::ARMEmitter::ZRegister zm, FEXCore::ARMEmitter::ZRegister zn, FEXCore::ARMEmitter::ZRegister zda) {
+    LOGMAN_THROW_A_FMT(size == FEXCore::ARMEmitter::SubRegSize::i16Bit || size == FEXCore::ARMEmitter::SubRegSize::i32Bit || size == FEXCore::ARMEmitter::SubRegSize::i64Bit, "Invalid float size");
+    uint32_t Instr = 0b0110'0101'0010'0000'0000'0000'0000'0000;
+
+    Instr |= FEXCore::ToUnderlying(size) << 22;
+    Instr |= zm.Idx() << 16;
+    Instr |= opc << 13;
+    Instr |= pg.Idx() << 10;
+    Instr |= zn.Idx() << 5;
+    Instr |= zda.Idx();
+    dc32(Instr);
+  }
+
   // SVE bitwise logical operations (predicated)
   void SVEBitwiseLogicalPredicated(uint32_t Op, uint32_t opc, FEXCore::ARMEmitter::SubRegSize size, FEXCore::ARMEmitter::PRegister pg, FEXCore::ARMEmitter::ZRegister zm, FEXCore::ARMEmitter::ZRegister zd) {
     uint32_t Instr = Op;
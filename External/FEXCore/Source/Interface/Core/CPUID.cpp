@@ -407,8 +407,11 @@ FEXCore::CPUID::FunctionResults CPUIDEmu::Function_0h(uint32_t Leaf) {
 FEXCore::CPUID::FunctionResults CPUIDEmu::Function_01h(uint32_t Leaf) {
   FEXCore::CPUID::FunctionResults Res{};
   uint32_t CoreCount = Cores();
-  // XXX: Enable once the rest of the SSE4.2 instructions are emulated
-  uint32_t SupportsSSE42 = CTX->HostFeatures.SupportsCRC && false ? 1 : 0;
+  // CRC32 is the only SSE4.2 instruction that needs host support
+  uint32_t SupportsSSE42 = CTX->HostFeatures.SupportsCRC ? 1 : 0;
+  // FMA3 and F16C are VEX encoded so they need the AVX tables as well
+  uint32_t SupportsFMA = CTX->HostFeatures.SupportsAVX && CTX->HostFeatures.SupportsFMA ? 1 : 0;
+  uint32_t SupportsF16C = CTX->HostFeatures.SupportsAVX && CTX->HostFeatures.SupportsF16C ? 1 : 0;
 
   Res.eax = FAMILY_IDENTIFIER;
 
@@ -430,7 +433,7 @@ FEXCore::CPUID::FunctionResults CPUIDEmu::Function_01h(uint32_t Leaf) {
     (1 <<  9) | // SSSE3
     (0 << 10) | // L1 context ID
     (0 << 11) | // Silicon debug
-    (0 << 12) | // FMA3
+    (SupportsFMA << 12) | // FMA3
     (1 << 13) | // CMPXCHG16B
     (0 << 14) | // xTPR update control
     (0 << 15) | // Perfmon and debug capability
@@ -447,7 +450,7 @@ FEXCore::CPUID::FunctionResults CPUIDEmu::Function_01h(uint32_t Leaf) {
     (0 << 26) | // XSAVE
     (0 << 27) | // OSXSAVE
     (SUPPORTS_AVX << 28) | // AVX
-    (0 << 29) | // F16C
+    (SupportsF16C << 29) | // F16C
     (CTX->HostFeatures.SupportsRAND << 30) | // RDRAND
     (1 << 31);  // Hypervisor always returns one
 
@@ -629,6 +632,8 @@ FEXCore::CPUID::FunctionResults CPUIDEmu::Function_06h(uint32_t Leaf) {
 FEXCore::CPUID::FunctionResults CPUIDEmu::Function_07h(uint32_t Leaf) {
   FEXCore::CPUID::FunctionResults Res{};
   if (Leaf == 0) {
+    uint32_t SupportsAVX2 = CTX->HostFeatures.SupportsAVX && CTX->HostFeatures.SupportsAVX2 ? 1 : 0;
+
     // Number of subfunctions
     Res.eax = 0x0;
     Res.ebx =
@@ -637,7 +642,7 @@ FEXCore::CPUID::FunctionResults CPUIDEmu::Function_07h(uint32_t Leaf) {
       (0 <<  2) | // SGX
       (1 <<  3) | // BMI1
       (0 <<  4) | // Intel Hardware Lock Elison
-      (0 <<  5) | // AVX2 support
+      (SupportsAVX2 << 5) | // AVX2 support
       (1 <<  6) | // FPU data pointer updated only on exception
       (1 <<  7) | // SMEP support
       (1 <<  8) | // BMI2
@@ -10,6 +10,7 @@ $end_info$
 #include <cstdint>
 #include "Interface/Context/Context.h"
 #include "Interface/Core/LookupCache.h"
+#include "Interface/Core/ArchHelpers/Arm64.h"
 #include "Interface/Core/Core.h"
 #include "Interface/Core/CPUID.h"
 #include "Interface/Core/Frontend.h"
@@ -45,8 +46,10 @@ $end_info$
 #include <FEXCore/Utils/LogManager.h>
 #include <FEXCore/Utils/Threads.h>
 #include <FEXCore/Utils/Profiler.h>
+#include <FEXCore/Utils/Telemetry.h>
 #include <FEXHeaderUtils/Syscalls.h>
 #include <FEXHeaderUtils/TodoDefines.h>
+#include <FEXHeaderUtils/TypeDefines.h>
 
 #include <algorithm>
 #include <array>
@@ -170,6 +173,13 @@ namespace FEXCore::Context {
       // Only initialize symbols file if enabled. Ensures we don't pollute /tmp with empty files.
       Symbols.InitFile();
     }
+
+    if (Config.SMCChecks == FEXCore::Config::CONFIG_SMC_MTRACK) {
+      // Allocated up front, the SMC fault handler looks pages up and compilation adds them from any thread
+      GuestCodeChunkPages = reinterpret_cast<GuestCodeChunkPage*>(FEXCore::Allocator::mmap(nullptr,
+        GuestCodeChunkPagesCount * sizeof(GuestCodeChunkPage), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+      LogMan::Throw::AFmt(GuestCodeChunkPages != MAP_FAILED, "Couldn't allocate the guest code chunk table");
+    }
   }
 
   Context::~Context() {
@@ -189,6 +199,10 @@ namespace FEXCore::Context {
       }
       Threads.clear();
     }
+
+    if (GuestCodeChunkPages) {
+      FEXCore::Allocator::munmap(GuestCodeChunkPages, GuestCodeChunkPagesCount * sizeof(GuestCodeChunkPage));
+    }
   }
 
   static FEXCore::Core::CPUState CreateDefaultCPUState() {
@@ -206,9 +220,8 @@ namespace FEXCore::Context {
       xmm[2] = 0xDEADCAFEULL;
       xmm[3] = 0xBAD2CAD3ULL;
     }
-    memset(NewThreadState.flags, 0, Core::CPUState::NUM_EFLAG_BITS);
-    NewThreadState.flags[1] = 1;
-    NewThreadState.flags[9] = 1;
+    // Bit 1 and IF are always set
+    NewThreadState.SetPackedEFLAGS((1U << 1) | (1U << X86State::RFLAG_IF_LOC));
     NewThreadState.FCW = 0x37F;
     NewThreadState.FTW = 0xFFFF;
     return NewThreadState;
@@ -727,13 +740,12 @@ namespace FEXCore::Context {
   static void ValidateIR(FEXCore::Context::Context *ctx, IR::IREmitter *IREmitter) {
     // Convert to text, Parse, Convert to text again and make sure the texts match
     std::stringstream out;
-    static auto compaction = IR::CreateIRCompaction(ctx->OpDispatcherAllocator);
+    static auto compaction = IR::CreateIRCompaction();
     compaction->Run(IREmitter);
     auto NewIR = IREmitter->ViewIR();
     Dump(&out, &NewIR, nullptr);
     out.seekg(0);
-    FEXCore::Utils::PooledAllocatorMalloc Allocator;
-    auto reparsed = IR::Parse(Allocator, &out);
+    auto reparsed = IR::Parse(&out);
     if (reparsed == nullptr) {
       LOGMAN_MSG_A_FMT("Failed to parse IR\n");
     } else {
@@ -748,11 +760,14 @@ namespace FEXCore::Context {
     }
   }
 
+  FEXCORE_TELEMETRY_STATIC_INIT(IRPeakMemory, TYPE_IR_PEAK_MEMORY);
+  FEXCORE_TELEMETRY_STATIC_INIT(IRArenaTrims, TYPE_IR_ARENA_TRIMS);
+
   Context::GenerateIRResult Context::GenerateIR(FEXCore::Core::InternalThreadState *Thread, uint64_t GuestRIP, bool ExtendedDebugInfo) {
     FEXCORE_PROFILE_SCOPED("GenerateIR");
 
-    Thread->OpDispatcher->ReownOrClaimBuffer();
     Thread->OpDispatcher->ResetWorkingList();
+    Thread->OpDispatcher->SetTSOEnabled(IsTSORequired(GuestRIP));
 
     uint64_t TotalInstructions {0};
     uint64_t TotalInstructionsLength {0};
@@ -774,6 +789,7 @@ namespace FEXCore::Context {
       bool HadDispatchError {false};
 
       Thread->FrontendDecoder->DecodeInstructionsAtEntry(GuestCode, GuestRIP, [Thread](uint64_t BlockEntry, uint64_t Start, uint64_t Length) {
+        Thread->CTX->AddGuestCodeChunks(Start, Length);
         if (Thread->LookupCache->AddBlockExecutableRange(BlockEntry, Start, Length)) {
           Thread->CTX->SyscallHandler->MarkGuestExecutableRange(Start, Length);
         }
@@ -785,6 +801,23 @@ namespace FEXCore::Context {
 
       const uint8_t GPRSize = GetGPRSize();
 
+      // mtrack pages that thrashed too much validate their code instead of being write protected
+      auto NeedsCodeValidation = [this, LastPage = ~0ULL, LastResult = false](uint64_t Addr, uint64_t Size) mutable {
+        if (Config.SMCChecks != FEXCore::Config::CONFIG_SMC_MTRACK) {
+          return false;
+        }
+
+        bool Result = false;
+        for (auto Page = Addr & FHU::FEX_PAGE_MASK; Page < Addr + Size; Page += FHU::FEX_PAGE_SIZE) {
+          if (Page != LastPage) {
+            LastPage = Page;
+            LastResult = IsGuestCodePageValidated(Page);
+          }
+          Result |= LastResult;
+        }
+        return Result;
+      };
+
       for (size_t j = 0; j < CodeBlocks->size(); ++j) {
         FEXCore::Frontend::Decoder::DecodedBlocks const &Block = CodeBlocks->at(j);
         // Set the block entry point
@@ -795,6 +828,10 @@ namespace FEXCore::Context {
         // Reset any block-specific state
         Thread->OpDispatcher->StartNewBlock();
 
+        if (Block.IsResumeEntry) {
+          Thread->OpDispatcher->_ResumeEntry(Block.Entry - GuestRIP);
+        }
+
         if (Config.x86dec_SynchronizeRIPOnAllBlocks) {
           // Ensure the RIP is synchronized to the context on block entry.
           // In the case of block linking, the RIP may not have synchronized.
@@ -816,7 +853,8 @@ namespace FEXCore::Context {
             Thread->OpDispatcher->_GuestOpcode(Block.Entry + BlockInstructionsLength - GuestRIP);
           }
 
-          if (Config.SMCChecks == FEXCore::Config::CONFIG_SMC_FULL) {
+          if (Config.SMCChecks == FEXCore::Config::CONFIG_SMC_FULL ||
+              NeedsCodeValidation(Block.Entry + BlockInstructionsLength, DecodedInfo->InstSize)) {
             auto ExistingCodePtr = reinterpret_cast<uint64_t*>(Block.Entry + BlockInstructionsLength);
 
             auto CodeChanged = Thread->OpDispatcher->_ValidateCode(ExistingCodePtr[0], ExistingCodePtr[1], (uintptr_t)ExistingCodePtr - GuestRIP, DecodedInfo->InstSize);
@@ -918,7 +956,11 @@ namespace FEXCore::Context {
     auto RAData = Thread->PassManager->HasPass("RA") ? Thread->PassManager->GetPass<IR::RegisterAllocationPass>("RA")->PullAllocationData() : nullptr;
     auto IRList = IREmitter->CreateIRCopy();
 
-    IREmitter->DelayedDisownBuffer();
+    // The IR has been copied out, so the arena can give back whatever a large block grew it to
+    FEXCORE_TELEMETRY_MAX(IRPeakMemory, IREmitter->GetPeakIRSize());
+    if (IREmitter->TrimArena()) {
+      FEXCORE_TELEMETRY_INC(IRArenaTrims);
+    }
 
     return {
       .IRList = IRList,
@@ -930,6 +972,31 @@ namespace FEXCore::Context {
     };
   }
 
+  void Context::SetCodeCacheFDRequester(std::function<int(const std::string&)> Requester) {
+    if (CodeObjectCacheService) {
+      CodeObjectCacheService->SetCodeCacheFDRequester(std::move(Requester));
+    }
+  }
+
+  void Context::AddNamedRegion(uintptr_t Base, uintptr_t Size, uintptr_t Offset, const std::string &Filename, const std::string &FileIdentity) {
+    if (CodeObjectCacheService) {
+      CodeObjectCacheService->AsyncAddNamedRegionJob(Base, Size, Offset, Filename, FileIdentity);
+    }
+  }
+
+  void Context::RemoveNamedRegion(uintptr_t Base, uintptr_t Size) {
+    if (CodeObjectCacheService) {
+      CodeObjectCacheService->AsyncRemoveNamedRegionJob(Base, Size);
+    }
+  }
+
+  bool Context::IsBlockCacheable(uint64_t GuestRIP) {
+    // Cached code doesn't know if a block was promoted to TSO by page tracking, compile those fresh
+    // Same for blocks on pages that switched to code validation
+    return (!TSOPageTrackingActive || !IsTSORequired(GuestRIP)) &&
+      !IsGuestCodePageValidated(GuestRIP & FHU::FEX_PAGE_MASK);
+  }
+
   Context::CompileCodeResult Context::CompileCode(FEXCore::Core::InternalThreadState *Thread, uint64_t GuestRIP) {
     FEXCore::IR::IRListView *IRList {};
     FEXCore::Core::DebugData *DebugData {};
@@ -938,11 +1005,29 @@ namespace FEXCore::Context {
     uint64_t StartAddr {};
     uint64_t Length {};
 
+    const bool CanUseCachedCode = IsBlockCacheable(GuestRIP);
+
     // JIT Code object cache lookup
-    if (CodeObjectCacheService) {
-      auto CodeCacheEntry = CodeObjectCacheService->FetchCodeObjectFromCache(GuestRIP);
-      if (CodeCacheEntry) {
-        auto CompiledCode = Thread->CPUBackend->RelocateJITObjectCode(GuestRIP, CodeCacheEntry);
+    // The GDB pause check embeds per-process state, blocks with it are never cached
+    CodeSerialize::CodeObjectFileSection CodeCacheEntry{};
+    if (CodeObjectCacheService && CanUseCachedCode && !GetGdbServerStatus()) {
+      auto MarkGuestCode = [this, Thread, GuestRIP](uint64_t Start, uint64_t Length) {
+        // The entry page was checked above, the block can still run on to a validated page
+        if (IsGuestCodeRangeValidated(Start, Length)) {
+          return false;
+        }
+
+        // Same tracking the frontend does when decoding, the pages get write protected for SMC detection
+        AddGuestCodeChunks(Start, Length);
+        if (Thread->LookupCache->AddBlockExecutableRange(GuestRIP, Start, Length)) {
+          SyscallHandler->MarkGuestExecutableRange(Start, Length);
+        }
+        return true;
+      };
+
+      const uint64_t CodeFlags = IsTSORequired(GuestRIP) ? CodeSerialize::SharedCodeCache::FLAG_TSO : 0;
+      if (CodeObjectCacheService->FetchCodeObjectFromCache(GuestRIP, CodeFlags, MarkGuestCode, &CodeCacheEntry)) {
+        auto CompiledCode = Thread->CPUBackend->RelocateJITObjectCode(GuestRIP, &CodeCacheEntry);
         if (CompiledCode) {
           return {
               .CompiledCode = CompiledCode,
@@ -966,9 +1051,13 @@ namespace FEXCore::Context {
     }
 
     // AOT IR bookkeeping and cache
-    {
+    if (CanUseCachedCode) {
       auto [IRCopy, RACopy, DebugDataCopy, _StartAddr, _Length, _GeneratedIR] = IRCaptureCache.PreGenerateIRFetch(GuestRIP, IRList);
-      if (_GeneratedIR) {
+      if (_GeneratedIR && IsGuestCodeRangeValidated(_StartAddr, _Length)) {
+        // The cached IR doesn't validate itself, compile the block fresh
+        delete DebugDataCopy;
+      }
+      else if (_GeneratedIR) {
         // Setup pointers to internal structures
         IRList = IRCopy;
         RAData = std::move(RACopy);
@@ -1082,14 +1171,18 @@ namespace FEXCore::Context {
     }
 
     // Tell the object cache service to serialize the code if enabled
+    // Blocks that depend on this process' TSO page tracking, code validation or GDB state aren't shared
     if (CodeObjectCacheService &&
         Config.CacheObjectCodeCompilation == FEXCore::Config::ConfigObjectCodeHandler::CONFIG_READWRITE &&
-        DebugData) {
+        DebugData && Length && IsBlockCacheable(GuestRIP) && !IsGuestCodeRangeValidated(StartAddr, Length) &&
+        !GetGdbServerStatus()) {
       CodeObjectCacheService->AsyncAddSerializationJob(std::make_unique<CodeSerialize::AsyncJobHandler::SerializationJobData>(
         CodeSerialize::AsyncJobHandler::SerializationJobData {
           .GuestRIP = GuestRIP,
+          .GuestCodeStart = StartAddr,
           .GuestCodeLength = Length,
           .GuestCodeHash = 0,
+          .CodeFlags = IsTSORequired(GuestRIP) ? CodeSerialize::SharedCodeCache::FLAG_TSO : 0,
           .HostCodeBegin = CodePtr,
           .HostCodeLength = DebugData->HostCodeSize,
           .HostCodeHash = 0,
@@ -1120,6 +1213,23 @@ namespace FEXCore::Context {
     // Pages containing this block are added via AddBlockExecutableRange before each page gets accessed in the frontend
     AddBlockMapping(Thread, GuestRIP, CodePtr);
 
+    // Return sites compiled in to this function get entered directly when the callee returns
+    // They cover the same guest range as the function so invalidating any of it drops them too
+    if (DebugData && Length) {
+      for (auto &ResumeEntry : DebugData->ResumeEntries) {
+        const uint64_t ResumeRIP = GuestRIP + ResumeEntry.GuestEntryOffset;
+        if (Thread->LookupCache->FindBlock(ResumeRIP)) {
+          continue;
+        }
+
+        AddGuestCodeChunks(StartAddr, Length);
+        if (Thread->LookupCache->AddBlockExecutableRange(ResumeRIP, StartAddr, Length)) {
+          SyscallHandler->MarkGuestExecutableRange(StartAddr, Length);
+        }
+        AddBlockMapping(Thread, ResumeRIP, reinterpret_cast<uint8_t*>(CodePtr) + ResumeEntry.HostEntryOffset);
+      }
+    }
+
     return (uintptr_t)CodePtr;
   }
 
@@ -1172,6 +1282,9 @@ namespace FEXCore::Context {
     --IdleWaitRefCount;
     IdleWaitCV.notify_all();
 
+    // A parent waiting to join can keep the thread object alive for a long time
+    ReleaseCompileMemory(Thread);
+
     SignalDelegation->UninstallTLSState(Thread);
 
     // If the parent thread is waiting to join, then we can't destroy our thread object
@@ -1187,8 +1300,8 @@ namespace FEXCore::Context {
     auto upper = Thread->LookupCache->CodePages.upper_bound((Start + Length - 1) >> 12);
 
     for (auto it = lower; it != upper; it++) {
-      for (auto Address: it->second) {
-        Context::ThreadRemoveCodeEntry(Thread, Address);
+      for (auto &Range : it->second) {
+        Context::ThreadRemoveCodeEntry(Thread, Range.Address);
       }
       it->second.clear();
     }
@@ -1200,6 +1313,9 @@ namespace FEXCore::Context {
     for (auto &Thread : CTX->Threads) {
       InvalidateGuestThreadCodeRange(Thread, Start, Length);
     }
+
+    // Whole pages, same as the per thread CodePages. Compilation is held off by CodeInvalidationMutex
+    CTX->ClearGuestCodeChunks(Start, Length);
   }
 
   void InvalidateGuestCodeRange(FEXCore::Context::Context *CTX, uint64_t Start, uint64_t Length) {
@@ -1216,6 +1332,15 @@ namespace FEXCore::Context {
   }
 
   void Context::MarkMemoryShared() {
+    if (TSOPageTrackingActive) {
+      // Memory shared with something other than our own threads can't be tracked per page.
+      // Fall back to process-wide TSO and recompile everything.
+      TSOPageTrackingActive = false;
+      LogMan::Msg::IFmt("TSO page tracking disabled, shared memory mapped");
+      InvalidateGuestCodeRange(this, 0, ~0ULL);
+      return;
+    }
+
     if (!IsMemoryShared) {
       IsMemoryShared = true;
 
@@ -1239,6 +1364,307 @@ namespace FEXCore::Context {
     CTX->MarkMemoryShared();
   }
 
+  void Context::MarkMemorySharedByThreads() {
+    if (TSOPageTrackingActive) {
+      // Already tracking, more threads don't change anything
+      return;
+    }
+
+    if (!IsMemoryShared && Config.TSOAutoMigration && Config.TSOPageTracking) {
+      // Memory only becomes shared once a second thread touches it.
+      // Existing code stays valid since it was compiled without TSO, which is what tracking starts with.
+      IsMemoryShared = true;
+      TSOPageTrackingActive = true;
+      return;
+    }
+
+    MarkMemoryShared();
+  }
+
+  void MarkMemorySharedByThreads(FEXCore::Context::Context *CTX) {
+    CTX->MarkMemorySharedByThreads();
+  }
+
+  bool IsTSOPageTrackingActive(FEXCore::Context::Context *CTX) {
+    return CTX->IsTSOPageTrackingActive();
+  }
+
+  bool Context::IsTSORequired(uint64_t GuestRIP) {
+    if (!IsTSOEnabled()) {
+      return false;
+    }
+
+    if (!TSOPageTrackingActive) {
+      return true;
+    }
+
+    // Also taken from the fault handler, mask signals while held
+    FHU::ScopedSignalMaskWithSharedLock lk(TSORequiredBlocksMutex);
+    return TSORequiredBlocks.contains(GuestRIP);
+  }
+
+  void Context::MarkBlockRequiresTSO(uint64_t GuestRIP) {
+    {
+      FHU::ScopedSignalMaskWithUniqueLock lk(TSORequiredBlocksMutex);
+      if (!TSORequiredBlocks.emplace(GuestRIP).second) {
+        // Already recompiled, or about to be
+        return;
+      }
+    }
+
+    // Drop the non-TSO version of the block from every thread so it gets recompiled
+    InvalidateGuestCodeRange(this, GuestRIP, 1);
+  }
+
+  void MarkBlockRequiresTSO(FEXCore::Context::Context *CTX, uint64_t GuestRIP) {
+    CTX->MarkBlockRequiresTSO(GuestRIP);
+  }
+
+  // Chunks of guest page {Page} touched by [Start, End)
+  static uint64_t GuestCodeChunkMask(uint64_t Page, uint64_t Start, uint64_t End) {
+    const auto FirstChunk = (std::max(Start, Page << 12) & 0xFFF) / 64;
+    const auto LastChunk = ((std::min(End, (Page + 1) << 12) - 1) & 0xFFF) / 64;
+    const uint64_t Upper = LastChunk == 63 ? ~0ULL : ((1ULL << (LastChunk + 1)) - 1);
+    return Upper & ~((1ULL << FirstChunk) - 1);
+  }
+
+  Context::GuestCodeChunkPage *Context::FindGuestCodeChunkPage(uint64_t Page, bool Insert) {
+    const uint64_t Key = Page + 1;
+    const size_t Hash = (Page * 0x9E3779B97F4A7C15ULL) >> 48;
+
+    for (size_t Probe = 0; Probe < GuestCodeChunkMaxProbes; ++Probe) {
+      auto Entry = &GuestCodeChunkPages[(Hash + Probe) & (GuestCodeChunkPagesCount - 1)];
+      auto Current = Entry->Page.load(std::memory_order_acquire);
+
+      if (Current == Key) {
+        return Entry;
+      }
+
+      if (Current == 0) {
+        if (!Insert) {
+          // Slots are filled in probe order and never freed, the page isn't further along
+          return nullptr;
+        }
+
+        if (Entry->Page.compare_exchange_strong(Current, Key, std::memory_order_acq_rel) || Current == Key) {
+          return Entry;
+        }
+      }
+    }
+
+    if (Insert) {
+      GuestCodeChunkPagesFull.store(true, std::memory_order_release);
+    }
+    return nullptr;
+  }
+
+  void Context::AddGuestCodeChunks(uint64_t Start, uint64_t Length) {
+    if (!GuestCodeChunkPages || !Length) {
+      return;
+    }
+
+    const auto End = Start + Length;
+    for (auto Page = Start >> 12, EndPage = (End - 1) >> 12; Page <= EndPage; ++Page) {
+      auto Entry = FindGuestCodeChunkPage(Page, true);
+      if (!Entry) {
+        // Lookups treat every page without a slot as code from now on
+        continue;
+      }
+
+      const auto Mask = GuestCodeChunkMask(Page, Start, End);
+
+      Entry->Chunks.fetch_or(Mask, std::memory_order_release);
+    }
+  }
+
+  void Context::ClearGuestCodeChunks(uint64_t Start, uint64_t Length) {
+    if (!GuestCodeChunkPages || !Length) {
+      return;
+    }
+
+    // Invalidating everything passes a Length that wraps
+    const auto FirstPage = Start >> 12;
+    const auto LastPage = (Length > ~0ULL - Start ? ~0ULL : Start + Length - 1) >> 12;
+
+    if (LastPage - FirstPage >= GuestCodeChunkPagesCount) {
+      // Large invalidations walk the table instead of the range
+      for (size_t i = 0; i < GuestCodeChunkPagesCount; ++i) {
+        auto Key = GuestCodeChunkPages[i].Page.load(std::memory_order_acquire);
+        if (Key && (Key - 1) >= FirstPage && (Key - 1) <= LastPage) {
+          GuestCodeChunkPages[i].Chunks.store(0, std::memory_order_release);
+        }
+      }
+      return;
+    }
+
+    for (auto Page = FirstPage; Page <= LastPage; ++Page) {
+      if (auto Entry = FindGuestCodeChunkPage(Page, false)) {
+        Entry->Chunks.store(0, std::memory_order_release);
+      }
+    }
+  }
+
+  bool Context::IsGuestCodeInRange(uint64_t Start, uint64_t Length) {
+    if (!GuestCodeChunkPages) {
+      return true;
+    }
+
+    const bool Full = GuestCodeChunkPagesFull.load(std::memory_order_acquire);
+    const auto End = Start + Length;
+    for (auto Page = Start >> 12, EndPage = (End - 1) >> 12; Page <= EndPage; ++Page) {
+      auto Entry = FindGuestCodeChunkPage(Page, false);
+      if (!Entry) {
+        if (Full) {
+          return true;
+        }
+        continue;
+      }
+
+      const auto Mask = GuestCodeChunkMask(Page, Start, End);
+
+      if (Entry->Chunks.load(std::memory_order_acquire) & Mask) {
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  bool IsGuestCodeInRange(FEXCore::Context::Context *CTX, uint64_t Start, uint64_t Length) {
+    return CTX->IsGuestCodeInRange(Start, Length);
+  }
+
+  void Context::MarkGuestCodePageValidated(uint64_t PageBase) {
+    FHU::ScopedSignalMaskWithUniqueLock lk(SMCValidatedPagesMutex);
+    if (SMCValidatedPages.emplace(PageBase).second) {
+      ++SMCValidatedPagesCount;
+    }
+  }
+
+  bool Context::IsGuestCodePageValidated(uint64_t PageBase) {
+    if (SMCValidatedPagesCount.load(std::memory_order_relaxed) == 0) {
+      return false;
+    }
+
+    FHU::ScopedSignalMaskWithSharedLock lk(SMCValidatedPagesMutex);
+    return SMCValidatedPages.contains(PageBase);
+  }
+
+  void Context::ClearGuestCodePagesValidated(uint64_t Start, uint64_t Length) {
+    if (SMCValidatedPagesCount.load(std::memory_order_relaxed) == 0) {
+      return;
+    }
+
+    FHU::ScopedSignalMaskWithUniqueLock lk(SMCValidatedPagesMutex);
+    auto lower = SMCValidatedPages.lower_bound(Start);
+    auto upper = SMCValidatedPages.lower_bound(Start + Length);
+    SMCValidatedPagesCount -= std::distance(lower, upper);
+    SMCValidatedPages.erase(lower, upper);
+  }
+
+  bool Context::IsGuestCodeRangeValidated(uint64_t Start, uint64_t Length) {
+    if (SMCValidatedPagesCount.load(std::memory_order_relaxed) == 0) {
+      return false;
+    }
+
+    FHU::ScopedSignalMaskWithSharedLock lk(SMCValidatedPagesMutex);
+    auto it = SMCValidatedPages.lower_bound(Start & FHU::FEX_PAGE_MASK);
+    return it != SMCValidatedPages.end() && *it < Start + Length;
+  }
+
+  bool EmulateFaultingStore(void *ucontext, std::function<bool(uint64_t Addr, void const *Data, size_t Size, bool Release)> const &Write) {
+    return FEXCore::ArchHelpers::Arm64::EmulateStore(ucontext, Write);
+  }
+
+  void MarkGuestCodePageValidated(FEXCore::Context::Context *CTX, uint64_t PageBase) {
+    CTX->MarkGuestCodePageValidated(PageBase);
+  }
+
+  bool IsGuestCodePageValidated(FEXCore::Context::Context *CTX, uint64_t PageBase) {
+    return CTX->IsGuestCodePageValidated(PageBase);
+  }
+
+  void ClearGuestCodePagesValidated(FEXCore::Context::Context *CTX, uint64_t Start, uint64_t Length) {
+    CTX->ClearGuestCodePagesValidated(Start, Length);
+  }
+
+  void Context::AddFunctionRanges(std::vector<FunctionRange> const &Ranges) {
+    FHU::ScopedSignalMaskWithUniqueLock lk(FunctionRangesMutex);
+
+    for (auto const &Range : Ranges) {
+      if (Range.Start >= Range.End) {
+        continue;
+      }
+
+      // Drop anything this range overlaps, including a function that starts before it
+      auto it = FunctionRanges.upper_bound(Range.Start);
+      if (it != FunctionRanges.begin() && std::prev(it)->second > Range.Start) {
+        --it;
+      }
+
+      while (it != FunctionRanges.end() && it->first < Range.End) {
+        it = FunctionRanges.erase(it);
+      }
+
+      FunctionRanges.emplace(Range.Start, Range.End);
+    }
+  }
+
+  void Context::RemoveFunctionRanges(uint64_t Base, uint64_t Size) {
+    FHU::ScopedSignalMaskWithUniqueLock lk(FunctionRangesMutex);
+    FunctionRanges.erase(FunctionRanges.lower_bound(Base), FunctionRanges.lower_bound(Base + Size));
+  }
+
+  bool Context::FindFunctionRange(uint64_t RIP, FunctionRange *Range) {
+    FHU::ScopedSignalMaskWithSharedLock lk(FunctionRangesMutex);
+
+    auto it = FunctionRanges.upper_bound(RIP);
+    if (it == FunctionRanges.begin()) {
+      return false;
+    }
+
+    --it;
+    if (RIP >= it->second) {
+      return false;
+    }
+
+    *Range = FunctionRange {
+      .Start = it->first,
+      .End = it->second,
+    };
+    return true;
+  }
+
+  void Context::ReleaseCompileMemory(FEXCore::Core::InternalThreadState *Thread) {
+    if (Thread->OpDispatcher && Thread->OpDispatcher->ReleaseArena()) {
+      FEXCORE_TELEMETRY_INC(IRArenaTrims);
+    }
+
+    if (Thread->PassManager) {
+      Thread->PassManager->ReleaseMemory();
+    }
+  }
+
+  void ReleaseCompileMemory(FEXCore::Core::InternalThreadState *Thread) {
+    Thread->CTX->ReleaseCompileMemory(Thread);
+  }
+
+  void AddFunctionRanges(FEXCore::Context::Context *CTX, std::vector<FunctionRange> const &Ranges) {
+    CTX->AddFunctionRanges(Ranges);
+  }
+
+  void RemoveFunctionRanges(FEXCore::Context::Context *CTX, uint64_t Base, uint64_t Size) {
+    CTX->RemoveFunctionRanges(Base, Size);
+  }
+
+  uint64_t FindGuestBlockFromHostPC(FEXCore::Core::InternalThreadState *Thread, uintptr_t HostPC) {
+    if (!Thread->CPUBackend->IsAddressInCodeBuffer(HostPC)) {
+      return 0;
+    }
+
+    return Thread->LookupCache->FindGuestBlockFromHostCode(HostPC);
+  }
+
   void Context::ThreadAddBlockLink(FEXCore::Core::InternalThreadState *Thread, uint64_t GuestDestination, uintptr_t HostLink, const std::function<void()> &delinker) {
     std::shared_lock lk(Thread->CTX->CodeInvalidationMutex);
 
@@ -0,0 +1,79 @@
+/*
+$info$
+tags: frontend|x86-meta-blocks
+desc: Caches decoded instructions per guest page so unchanged code isn't decoded twice
+$end_info$
+*/
+
+#include "Interface/Core/DecodeCache.h"
+
+#include <FEXHeaderUtils/TypeDefines.h>
+
+#include <algorithm>
+#include <xxhash.h>
+
+namespace FEXCore::Frontend {
+uint64_t DecodedInstructionCache::HashPage(uint8_t const *HostPage) {
+  return XXH3_64bits(HostPage, FHU::FEX_PAGE_SIZE);
+}
+
+FEXCore::X86Tables::DecodedInst const *DecodedInstructionCache::FindInstruction(InstructionList const *Page, uint64_t PC) {
+  auto it = std::lower_bound(Page->begin(), Page->end(), PC, [](FEXCore::X86Tables::DecodedInst const &Inst, uint64_t PC) {
+    return Inst.PC < PC;
+  });
+
+  if (it == Page->end() || it->PC != PC) {
+    return nullptr;
+  }
+  return &*it;
+}
+
+void DecodedInstructionCache::Insert(uint64_t PageBase, uint64_t Hash, FEXCore::X86Tables::DecodedInst const *Instructions, size_t Count) {
+  std::unique_lock lk {Mutex};
+
+  if (NumInstructions + Count > MaxInstructions) {
+    Pages.clear();
+    NumInstructions = 0;
+  }
+
+  auto &Entry = Pages[PageBase];
+  if (Entry.Hash != Hash) {
+    // The bytes changed underneath the old decoding
+    NumInstructions -= Entry.Instructions.size();
+    Entry.Instructions.clear();
+    Entry.Hash = Hash;
+  }
+
+  auto &List = Entry.Instructions;
+  const auto OldSize = List.size();
+  List.insert(List.end(), Instructions, Instructions + Count);
+
+  auto ComparePC = [](FEXCore::X86Tables::DecodedInst const &a, FEXCore::X86Tables::DecodedInst const &b) {
+    return a.PC < b.PC;
+  };
+  // Blocks can overlap, so the new instructions may repeat themselves or what is already cached
+  std::stable_sort(List.begin() + OldSize, List.end(), ComparePC);
+  std::inplace_merge(List.begin(), List.begin() + OldSize, List.end(), ComparePC);
+  List.erase(std::unique(List.begin(), List.end(), [](FEXCore::X86Tables::DecodedInst const &a, FEXCore::X86Tables::DecodedInst const &b) {
+    return a.PC == b.PC;
+  }), List.end());
+
+  NumInstructions += List.size() - OldSize;
+}
+
+void DecodedInstructionCache::Clear() {
+  std::unique_lock lk {Mutex};
+  Pages.clear();
+  NumInstructions = 0;
+}
+
+DecodedInstructionCache::Stats DecodedInstructionCache::GetStats() const {
+  std::shared_lock lk {Mutex};
+  return Stats {
+    .Hits = TotalHits.load(std::memory_order_relaxed),
+    .Misses = TotalMisses.load(std::memory_order_relaxed),
+    .Pages = Pages.size(),
+    .Instructions = NumInstructions,
+  };
+}
+}
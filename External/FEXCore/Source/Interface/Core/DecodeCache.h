@@ -0,0 +1,89 @@
+#pragma once
+
+#include <FEXCore/Debug/X86Tables.h>
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+#include <stddef.h>
+#include <vector>
+#include <tsl/robin_map.h>
+
+namespace FEXCore::Frontend {
+/**
+ * @brief Decoded guest instructions shared between all threads, keyed by guest page
+ *
+ * Every page remembers the hash of the bytes its instructions were decoded from. The decoder checks that hash once
+ * per decode before using anything from the page, so code that gets invalidated and compiled again with unchanged
+ * bytes skips decoding. Instructions that cross a page boundary are never cached.
+ */
+class DecodedInstructionCache final {
+public:
+  using InstructionList = std::vector<FEXCore::X86Tables::DecodedInst>;
+
+  struct Stats {
+    uint64_t Hits;
+    uint64_t Misses;
+    uint64_t Pages;
+    uint64_t Instructions;
+  };
+
+  [[nodiscard]] static uint64_t HashPage(uint8_t const *HostPage);
+
+  /**
+   * @brief Taken by a decoder for the whole decode so that the instruction lists it found stay valid
+   */
+  [[nodiscard]] std::shared_lock<std::shared_mutex> LockShared() {
+    return std::shared_lock {Mutex};
+  }
+
+  /**
+   * @brief Returns the cached instructions of a page, or nullptr if it has none or its bytes no longer hash to Hash
+   *
+   * The caller must hold the shared lock.
+   */
+  [[nodiscard]] InstructionList const *FindPage(uint64_t PageBase, uint64_t Hash) const {
+    auto it = Pages.find(PageBase);
+    if (it == Pages.end() || it->second.Hash != Hash) {
+      return nullptr;
+    }
+    return &it->second.Instructions;
+  }
+
+  /**
+   * @brief Binary searches a page's instruction list for the instruction starting at PC
+   */
+  [[nodiscard]] static FEXCore::X86Tables::DecodedInst const *FindInstruction(InstructionList const *Page, uint64_t PC);
+
+  /**
+   * @brief Merges freshly decoded instructions in to a page, replacing its old contents if the hash changed
+   */
+  void Insert(uint64_t PageBase, uint64_t Hash, FEXCore::X86Tables::DecodedInst const *Instructions, size_t Count);
+
+  void AddLookups(uint64_t Hits, uint64_t Misses) {
+    TotalHits.fetch_add(Hits, std::memory_order_relaxed);
+    TotalMisses.fetch_add(Misses, std::memory_order_relaxed);
+  }
+
+  void Clear();
+  [[nodiscard]] Stats GetStats() const;
+
+private:
+  // Roughly 32MB of decoded instructions before the whole cache is dropped
+  static constexpr size_t MaxInstructions = 256 * 1024;
+
+  struct PageEntry {
+    uint64_t Hash;
+    // Sorted by PC with no duplicates
+    InstructionList Instructions;
+  };
+
+  mutable std::shared_mutex Mutex;
+  tsl::robin_map<uint64_t, PageEntry> Pages;
+  size_t NumInstructions{};
+
+  std::atomic<uint64_t> TotalHits{};
+  std::atomic<uint64_t> TotalMisses{};
+};
+}
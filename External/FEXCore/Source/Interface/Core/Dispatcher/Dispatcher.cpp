@@ -104,12 +104,8 @@ void Dispatcher::RestoreFrame_ia32(ArchHelpers::Context::ContextBackup* Context,
     // XXX: Full context setting
     // First 32-bytes of flags is EFLAGS broken out
     uint32_t eflags = guest_uctx->sc.flags;
-    for (size_t i = 0; i < Core::CPUState::NUM_EFLAG_BITS; ++i) {
-      Frame->State.flags[i] = (eflags & (1U << i)) ? 1 : 0;
-    }
-
-    Frame->State.flags[1] = 1;
-    Frame->State.flags[9] = 1;
+    // Bit 1 and IF are always set
+    Frame->State.SetPackedEFLAGS(eflags | (1U << 1) | (1U << X86State::RFLAG_IF_LOC));
 
     Frame->State.rip = guest_uctx->sc.ip;
     Frame->State.cs_idx = guest_uctx->sc.cs;
@@ -187,12 +183,8 @@ void Dispatcher::RestoreRTFrame_ia32(ArchHelpers::Context::ContextBackup* Contex
     // XXX: Full context setting
     // First 32-bytes of flags is EFLAGS broken out
     uint32_t eflags = guest_uctx->uc.uc_mcontext.gregs[FEXCore::x86::FEX_REG_EFL];
-    for (size_t i = 0; i < Core::CPUState::NUM_EFLAG_BITS; ++i) {
-      Frame->State.flags[i] = (eflags & (1U << i)) ? 1 : 0;
-    }
-
-    Frame->State.flags[1] = 1;
-    Frame->State.flags[9] = 1;
+    // Bit 1 and IF are always set
+    Frame->State.SetPackedEFLAGS(eflags | (1U << 1) | (1U << X86State::RFLAG_IF_LOC));
 
     Frame->State.rip = guest_uctx->uc.uc_mcontext.gregs[FEXCore::x86::FEX_REG_EIP];
     Frame->State.cs_idx = guest_uctx->uc.uc_mcontext.gregs[FEXCore::x86::FEX_REG_CS];
@@ -667,12 +659,8 @@ void Dispatcher::RestoreFrame_x64(ArchHelpers::Context::ContextBackup* Context,
     Frame->State.rip = guest_uctx->uc_mcontext.gregs[FEXCore::x86_64::FEX_REG_RIP];
     // XXX: Full context setting
     uint32_t eflags = guest_uctx->uc_mcontext.gregs[FEXCore::x86_64::FEX_REG_EFL];
-    for (size_t i = 0; i < Core::CPUState::NUM_EFLAG_BITS; ++i) {
-      Frame->State.flags[i] = (eflags & (1U << i)) ? 1 : 0;
-    }
-
-    Frame->State.flags[1] = 1;
-    Frame->State.flags[9] = 1;
+    // Bit 1 and IF are always set
+    Frame->State.SetPackedEFLAGS(eflags | (1U << 1) | (1U << X86State::RFLAG_IF_LOC));
 
 #define COPY_REG(x) \
         Frame->State.gregs[X86State::REG_##x] = guest_uctx->uc_mcontext.gregs[FEXCore::x86_64::FEX_REG_##x];
@@ -969,10 +957,7 @@ bool Dispatcher::HandleGuestSignal(FEXCore::Core::InternalThreadState *Thread, i
   // Backup where we think the RIP currently is
   ContextBackup->OriginalRIP = Frame->State.rip;
   // Calculate eflags upfront.
-  uint32_t eflags = 0;
-  for (size_t i = 0; i < Core::CPUState::NUM_EFLAG_BITS; ++i) {
-    eflags |= Frame->State.flags[i] << i;
-  }
+  uint32_t eflags = Frame->State.GetPackedEFLAGS();
 
   if (Is64BitMode) {
     NewGuestSP = SetupFrame_x64(Thread, ContextBackup, Frame, Signal, HostSigInfo, ucontext, GuestAction, GuestStack, NewGuestSP, eflags);
@@ -21,7 +21,7 @@ $end_info$
 #include <FEXCore/Utils/Profiler.h>
 #include <FEXCore/Utils/Telemetry.h>
 #include <FEXHeaderUtils/TypeDefines.h>
-#include <set>
+#include <functional>
 #include <sys/mman.h>
 
 namespace FEXCore::Frontend {
@@ -697,6 +697,10 @@ bool Decoder::NormalOpHeader(FEXCore::X86Tables::X86InstInfo const *Info, uint16
       options.vvvv = 15 - ((Byte2 & 0b01111000) >> 3);
       options.w = (Byte2 & 0b10000000) != 0;
       options.L = (Byte2 & 0b100) != 0;
+      if (options.w) {
+        // VEX.W selects the element size for ops like FMA, the dispatcher needs to see it.
+        DecodeInst->Flags |= DecodeFlags::FLAG_OPTION_AVX_W;
+      }
       if ((Byte1 & 0b01000000) == 0) {
         LOGMAN_THROW_A_FMT(CTX->Config.Is64BitMode, "VEX.X shouldn't be 0 in 32-bit mode!");
         DecodeInst->Flags |= DecodeFlags::FLAG_REX_XGPR_X;
@@ -985,11 +989,29 @@ void Decoder::BranchTargetInMultiblockRange() {
       TargetRIP = DecodeInst->PC + DecodeInst->InstSize + DecodeInst->Src[0].Data.Literal.Value;
       Conditional = false;
     break;
-    case 0xE8: // Call - Immediate target, We don't want to inline calls
+    case 0xE8: { // Call - Immediate target, We don't want to inline calls
+      const uint64_t ReturnRIP = DecodeInst->PC + DecodeInst->InstSize;
       if (ExternalBranches) {
-        ExternalBranches->insert(DecodeInst->PC + DecodeInst->InstSize);
+        ExternalBranches->insert(ReturnRIP);
+      }
+
+      // With function multiblock the rest of the function keeps compiling past the call
+      // The call still exits to the callee, the return lands on the return site through its resume entry
+      LOGMAN_THROW_A_FMT(DecodeInst->Src[0].IsLiteral(), "Had wrong operand type");
+      uint64_t CallTargetRIP = ReturnRIP + DecodeInst->Src[0].Data.Literal.Value;
+      if (GPRSize == 4) {
+        CallTargetRIP &= 0xFFFFFFFFU;
       }
-      [[fallthrough]];
+      if (SymbolAvailable && CallTargetRIP != ReturnRIP &&
+          ReturnRIP >= SymbolMinAddress && ReturnRIP < SymbolMaxAddress) {
+        auto it = std::lower_bound(ResumeEntries.begin(), ResumeEntries.end(), ReturnRIP);
+        if (it == ResumeEntries.end() || *it != ReturnRIP) {
+          ResumeEntries.insert(it, ReturnRIP);
+        }
+        AddBlockToDecode(ReturnRIP);
+      }
+      return;
+    }
     case 0xC2: // RET imm
     case 0xC3: // RET
     default:
@@ -1011,16 +1033,10 @@ void Decoder::BranchTargetInMultiblockRange() {
 
       // If we are conditional then a target can be the instruction past the conditional instruction
       uint64_t FallthroughRIP = DecodeInst->PC + DecodeInst->InstSize;
-      if (HasBlocks.find(FallthroughRIP) == HasBlocks.end() &&
-          BlocksToDecode.find(FallthroughRIP) == BlocksToDecode.end()) {
-        BlocksToDecode.emplace(FallthroughRIP);
-      }
+      AddBlockToDecode(FallthroughRIP);
     }
 
-    if (HasBlocks.find(TargetRIP) == HasBlocks.end() &&
-        BlocksToDecode.find(TargetRIP) == BlocksToDecode.end()) {
-      BlocksToDecode.emplace(TargetRIP);
-    }
+    AddBlockToDecode(TargetRIP);
   } else {
     if (ExternalBranches) {
       ExternalBranches->insert(TargetRIP);
@@ -1028,6 +1044,17 @@ void Decoder::BranchTargetInMultiblockRange() {
   }
 }
 
+void Decoder::AddBlockToDecode(uint64_t RIP) {
+  if (std::binary_search(HasBlocks.begin(), HasBlocks.end(), RIP)) {
+    return;
+  }
+
+  auto it = std::lower_bound(BlocksToDecode.begin(), BlocksToDecode.end(), RIP, std::greater<>());
+  if (it == BlocksToDecode.end() || *it != RIP) {
+    BlocksToDecode.insert(it, RIP);
+  }
+}
+
 bool Decoder::BranchTargetCanContinue(bool FinalInstruction) const {
   if (FinalInstruction) {
     return false;
@@ -1076,21 +1103,105 @@ const uint8_t *Decoder::AdjustAddrForSpecialRegion(uint8_t const* _InstStream, u
   return _InstStream - EntryPoint + RIP;
 }
 
+Decoder::CachePage *Decoder::GetCachePage(uint64_t PageBase) {
+  for (auto &Page : CachePages) {
+    if (Page.PageBase == PageBase) {
+      return &Page;
+    }
+  }
+
+  // Special regions like the vsyscall page aren't backed by the guest's memory
+  const auto HostPage = AdjustAddrForSpecialRegion(EntryInstStream, EntryPoint, PageBase);
+  const bool Cacheable = reinterpret_cast<uintptr_t>(HostPage) == reinterpret_cast<uintptr_t>(EntryInstStream) - EntryPoint + PageBase;
+  const uint64_t Hash = Cacheable ? DecodedInstructionCache::HashPage(HostPage) : 0;
+
+  return &CachePages.emplace_back(CachePage {
+    .PageBase = PageBase,
+    .Hash = Hash,
+    .Instructions = Cacheable ? CTX->DecodeCache.FindPage(PageBase, Hash) : nullptr,
+    .Cacheable = Cacheable,
+  });
+}
+
+FEXCore::X86Tables::DecodedInst const *Decoder::FindCachedInstruction(uint64_t PC) {
+  auto Page = GetCachePage(PC & FHU::FEX_PAGE_MASK);
+  auto Inst = Page->Instructions ? DecodedInstructionCache::FindInstruction(Page->Instructions, PC) : nullptr;
+
+  if (Inst) {
+    ++CacheHits;
+  }
+  else {
+    ++CacheMisses;
+  }
+  return Inst;
+}
+
+void Decoder::CacheDecodedInstructions() {
+  CTX->DecodeCache.AddLookups(CacheHits, CacheMisses);
+
+  if (InstructionsToCache.empty()) {
+    return;
+  }
+
+  std::vector<FEXCore::X86Tables::DecodedInst> PageInstructions;
+  for (auto &Page : CachePages) {
+    if (!Page.Cacheable) {
+      continue;
+    }
+
+    PageInstructions.clear();
+    for (auto Index : InstructionsToCache) {
+      auto const &Inst = DecodedBuffer[Index];
+      // Instructions crossing in to the next page depend on two hashes, leave them out
+      if ((Inst.PC & FHU::FEX_PAGE_MASK) == Page.PageBase &&
+          Inst.PC + Inst.InstSize <= Page.PageBase + FHU::FEX_PAGE_SIZE) {
+        PageInstructions.emplace_back(Inst);
+      }
+    }
+
+    if (PageInstructions.empty()) {
+      continue;
+    }
+
+    // Don't cache anything if the page was written while it was being decoded
+    const auto HostPage = AdjustAddrForSpecialRegion(EntryInstStream, EntryPoint, Page.PageBase);
+    if (DecodedInstructionCache::HashPage(HostPage) != Page.Hash) {
+      continue;
+    }
+
+    CTX->DecodeCache.Insert(Page.PageBase, Page.Hash, PageInstructions.data(), PageInstructions.size());
+  }
+}
+
 void Decoder::DecodeInstructionsAtEntry(uint8_t const* _InstStream, uint64_t PC, std::function<void(uint64_t BlockEntry, uint64_t Start, uint64_t Length)> AddContainedCodePage) {
   FEXCORE_PROFILE_SCOPED("DecodeInstructions");
   Blocks.clear();
   BlocksToDecode.clear();
   HasBlocks.clear();
+  ResumeEntries.clear();
+  CachePages.clear();
+  InstructionsToCache.clear();
+  CacheHits = 0;
+  CacheMisses = 0;
   // Reset internal state management
   DecodedSize = 0;
   MaxCondBranchForward = 0;
   MaxCondBranchBackwards = ~0ULL;
   DecodedBuffer = PoolObject.ReownOrClaimBuffer();
 
-  // XXX: Load symbol data
-  SymbolAvailable = false;
+  // With function multiblock the containing function bounds the range, so backwards branches can be followed
+  FEXCore::Context::FunctionRange Function{};
+  SymbolAvailable = CTX->Config.Multiblock &&
+    CTX->Config.MultiblockFunctions &&
+    CTX->FindFunctionRange(PC, &Function);
+  if (SymbolAvailable) {
+    SymbolMinAddress = Function.Start;
+    SymbolMaxAddress = std::min(Function.End, SectionMaxAddress);
+  }
+
   EntryPoint = PC;
   InstStream = _InstStream;
+  EntryInstStream = _InstStream;
 
   uint64_t TotalInstructions{};
 
@@ -1105,17 +1216,22 @@ void Decoder::DecodeInstructionsAtEntry(uint8_t const* _InstStream, uint64_t PC,
   DecodedMaxAddress = EntryPoint;
 
   // Entry is a jump target
-  BlocksToDecode.emplace(PC);
+  BlocksToDecode.emplace_back(PC);
 
   uint64_t CurrentCodePage = PC & FHU::FEX_PAGE_MASK;
 
-  std::set<uint64_t> CodePages = { CurrentCodePage };
+  std::vector<uint64_t> CodePages = { CurrentCodePage };
 
   AddContainedCodePage(PC, CurrentCodePage, FHU::FEX_PAGE_SIZE);
 
+  // Keeps the cached instruction lists alive until decoding is done
+  auto CacheLock = CTX->DecodeCache.LockShared();
+
   while (!BlocksToDecode.empty()) {
-    auto BlockDecodeIt = BlocksToDecode.begin();
-    uint64_t RIPToDecode = *BlockDecodeIt;
+    uint64_t RIPToDecode = BlocksToDecode.back();
+    BlocksToDecode.pop_back();
+    HasBlocks.insert(std::upper_bound(HasBlocks.begin(), HasBlocks.end(), RIPToDecode), RIPToDecode);
+
     Blocks.emplace_back();
     DecodedBlocks &CurrentBlockDecoding = Blocks.back();
 
@@ -1139,15 +1255,27 @@ void Decoder::DecodeInstructionsAtEntry(uint8_t const* _InstStream, uint64_t PC,
 
       if (OpMinPage != CurrentCodePage) {
         CurrentCodePage = OpMinPage;
-        CodePages.insert(CurrentCodePage);
+        CodePages.emplace_back(CurrentCodePage);
       }
 
       if (OpMaxPage != CurrentCodePage) {
         CurrentCodePage = OpMaxPage;
-        CodePages.insert(CurrentCodePage);
+        CodePages.emplace_back(CurrentCodePage);
+      }
+
+      bool ErrorDuringDecoding = false;
+
+      if (auto CachedInst = FindCachedInstruction(RIPToDecode + PCOffset)) {
+        DecodeInst = &DecodedBuffer[DecodedSize];
+        *DecodeInst = *CachedInst;
       }
+      else {
+        ErrorDuringDecoding = !DecodeInstruction(RIPToDecode + PCOffset);
 
-      bool ErrorDuringDecoding = !DecodeInstruction(RIPToDecode + PCOffset);
+        if (!ErrorDuringDecoding) {
+          InstructionsToCache.emplace_back(DecodedSize);
+        }
+      }
 
       if (ErrorDuringDecoding) [[unlikely]] {
         LogMan::Msg::DFmt("Couldn't Decode something at 0x{:x}, Started at 0x{:x}", RIPToDecode + PCOffset, PC);
@@ -1198,20 +1326,36 @@ void Decoder::DecodeInstructionsAtEntry(uint8_t const* _InstStream, uint64_t PC,
       InstStream += DecodeInst->InstSize;
     }
 
-    BlocksToDecode.erase(BlockDecodeIt);
-    HasBlocks.emplace(RIPToDecode);
-
     // Copy over only the number of instructions we decoded
     CurrentBlockDecoding.NumInstructions = BlockNumberOfInstructions;
     CurrentBlockDecoding.DecodedInstructions = &DecodedBuffer[BlockStartOffset];
   }
 
+  CacheLock.unlock();
+  CacheDecodedInstructions();
+
+  std::sort(CodePages.begin(), CodePages.end());
+  CodePages.erase(std::unique(CodePages.begin(), CodePages.end()), CodePages.end());
+
   for (auto CodePage : CodePages) {
     AddContainedCodePage(PC, CodePage, FHU::FEX_PAGE_SIZE);
   }
 
+  // A return site can be decoded as a branch target before the call that returns to it
+  if (!ResumeEntries.empty()) {
+    for (auto &Block : Blocks) {
+      Block.IsResumeEntry = Block.Entry != EntryPoint &&
+        std::binary_search(ResumeEntries.begin(), ResumeEntries.end(), Block.Entry);
+    }
+  }
+
   // sort for better branching
-  std::sort(Blocks.begin(), Blocks.end(), [](const FEXCore::Frontend::Decoder::DecodedBlocks& a, const FEXCore::Frontend::Decoder::DecodedBlocks& b) {
+  // The entry block stays first even when backwards branches decoded blocks below it.
+  // The IR header points at the entry block and only the blocks linked after it get emitted.
+  std::sort(Blocks.begin(), Blocks.end(), [EntryPoint = EntryPoint](const FEXCore::Frontend::Decoder::DecodedBlocks& a, const FEXCore::Frontend::Decoder::DecodedBlocks& b) {
+    if (a.Entry == EntryPoint || b.Entry == EntryPoint) {
+      return a.Entry == EntryPoint && b.Entry != EntryPoint;
+    }
     return a.Entry < b.Entry;
   });
 }
@@ -1,8 +1,11 @@
 #pragma once
 
+#include "Interface/Core/DecodeCache.h"
+
 #include <FEXCore/Debug/X86Tables.h>
 #include <FEXCore/HLE/SyscallHandler.h>
 #include <FEXCore/Utils/Telemetry.h>
+#include <FEXCore/Utils/ThreadPoolAllocator.h>
 
 #include <array>
 #include <cstdint>
@@ -23,6 +26,8 @@ public:
     uint64_t NumInstructions{};
     FEXCore::X86Tables::DecodedInst *DecodedInstructions;
     bool HasInvalidInstruction{};
+    // Return site of a CALL, the dispatcher can enter the compiled function here when the callee returns
+    bool IsResumeEntry{};
   };
 
   Decoder(FEXCore::Context::Context *ctx);
@@ -90,10 +95,33 @@ private:
   uint64_t SectionMaxAddress {~0ULL};
 
   std::vector<DecodedBlocks> Blocks;
-  std::set<uint64_t> BlocksToDecode;
-  std::set<uint64_t> HasBlocks;
+  // Sorted descending so the lowest address is popped from the back
+  std::vector<uint64_t> BlocksToDecode;
+  // Sorted ascending
+  std::vector<uint64_t> HasBlocks;
+  // Sorted ascending
+  std::vector<uint64_t> ResumeEntries;
   std::set<uint64_t> *ExternalBranches {nullptr};
 
+  // Decoded instruction cache state for the current decode
+  struct CachePage {
+    uint64_t PageBase;
+    uint64_t Hash;
+    DecodedInstructionCache::InstructionList const *Instructions;
+    bool Cacheable;
+  };
+  std::vector<CachePage> CachePages;
+  // Indexes in to DecodedBuffer of instructions decoded this time that can go in to the cache
+  std::vector<size_t> InstructionsToCache;
+  uint8_t const *EntryInstStream{};
+  uint64_t CacheHits{};
+  uint64_t CacheMisses{};
+
+  CachePage *GetCachePage(uint64_t PageBase);
+  FEXCore::X86Tables::DecodedInst const *FindCachedInstruction(uint64_t PC);
+  void CacheDecodedInstructions();
+  void AddBlockToDecode(uint64_t RIP);
+
   // ModRM rm decoding
   using DecodeModRMPtr = void (FEXCore::Frontend::Decoder::*)(X86Tables::DecodedOperand *Operand, X86Tables::ModRMDecoded ModRM);
   void DecodeModRM_16(X86Tables::DecodedOperand *Operand, X86Tables::ModRMDecoded ModRM);
@@ -288,10 +288,7 @@ std::string GdbServer::readRegs() {
   memcpy(&GDB.gregs[0], &state.gregs[0], sizeof(GDB.gregs));
   memcpy(&GDB.rip, &state.rip, sizeof(GDB.rip));
 
-  for (size_t i = 0; i < Core::CPUState::NUM_EFLAG_BITS; ++i) {
-    uint64_t Flag = state.flags[i];
-    GDB.eflags |= (Flag << i);
-  }
+  GDB.eflags = state.GetPackedEFLAGS();
 
   for (size_t i = 0; i < Core::CPUState::NUM_MMS; ++i) {
     memcpy(&GDB.mm[i], &state.mm[i], sizeof(GDB.mm));
@@ -345,11 +342,7 @@ GdbServer::HandledPacketType GdbServer::readReg(const std::string& packet) {
     return {encodeHex((unsigned char *)(&state.rip), sizeof(uint64_t)), HandledPacketType::TYPE_ACK};
   }
   else if (addr == offsetof(GDBContextDefinition, eflags)) {
-    uint32_t eflags{};
-    for (size_t i = 0; i < Core::CPUState::NUM_EFLAG_BITS; ++i) {
-      uint64_t Flag = state.flags[i];
-      eflags |= (Flag << i);
-    }
+    uint32_t eflags = state.GetPackedEFLAGS();
     return {encodeHex((unsigned char *)(&eflags), sizeof(uint32_t)), HandledPacketType::TYPE_ACK};
   }
   else if (addr >= offsetof(GDBContextDefinition, cs) &&
@@ -76,6 +76,11 @@ HostFeatures::HostFeatures() {
   SupportsAVX = Features.Has(vixl::CPUFeatures::Feature::kSVE2) &&
                 vixl::aarch64::CPU::ReadSVEVectorLengthInBits() >= 256;
 #endif
+  // The 256-bit integer ops lower to the same SVE paths as AVX
+  SupportsAVX2 = SupportsAVX;
+  // Fused multiply-add and half-float conversions are part of base ASIMD
+  SupportsFMA = true;
+  SupportsF16C = true;
   SupportsSHA = true;
   SupportsBMI1 = true;
   SupportsBMI2 = true;
@@ -126,6 +131,9 @@ HostFeatures::HostFeatures() {
   Supports3DNow = Features.has(Xbyak::util::Cpu::t3DN) && Features.has(Xbyak::util::Cpu::tE3DN);
   SupportsSSE4A = Features.has(Xbyak::util::Cpu::tSSE4a);
   SupportsAVX = true;
+  SupportsAVX2 = Features.has(Xbyak::util::Cpu::tAVX2);
+  SupportsFMA = Features.has(Xbyak::util::Cpu::tFMA);
+  SupportsF16C = Features.has(Xbyak::util::Cpu::tF16C);
   SupportsSHA = Features.has(Xbyak::util::Cpu::tSHA);
   SupportsBMI1 = Features.has(Xbyak::util::Cpu::tBMI1);
   SupportsBMI2 = Features.has(Xbyak::util::Cpu::tBMI2);
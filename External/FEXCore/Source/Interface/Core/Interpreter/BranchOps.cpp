@@ -128,8 +128,49 @@ DEF_OP(InlineSyscall) {
 DEF_OP(Thunk) {
   auto Op = IROp->C<IR::IROp_Thunk>();
 
-  auto thunkFn = Data->State->CTX->ThunkHandler->LookupThunk(Op->ThunkNameHash);
-  thunkFn(*GetSrc<void**>(Data->SSAData, Op->ArgPtr));
+  auto CTX = Data->State->CTX;
+  auto thunkFn = CTX->ThunkHandler->LookupThunk(Op->ThunkNameHash);
+
+  if (CTX->Config.TSOPageTracking) {
+    GD = CallThunk(*GetSrc<uint64_t*>(Data->SSAData, Op->ArgPtr),
+                   *GetSrc<uint64_t*>(Data->SSAData, Op->Arg1),
+                   *GetSrc<uint64_t*>(Data->SSAData, Op->Arg2),
+                   *GetSrc<uint64_t*>(Data->SSAData, Op->Arg3),
+                   *GetSrc<uint64_t*>(Data->SSAData, Op->Arg4),
+                   *GetSrc<uint64_t*>(Data->SSAData, Op->Arg5),
+                   thunkFn);
+    if (!(Op->Flags & THUNK_FLAG_RESULT)) {
+      GD = 0;
+    }
+    return;
+  }
+
+  if (!(Op->Flags & THUNK_FLAG_REGISTERS)) {
+    // Packed arguments, the host function reads and writes them in guest memory
+    thunkFn(*GetSrc<void**>(Data->SSAData, Op->ArgPtr));
+    GD = 0;
+    return;
+  }
+
+  const uint64_t Args[] = {
+    *GetSrc<uint64_t*>(Data->SSAData, Op->ArgPtr),
+    *GetSrc<uint64_t*>(Data->SSAData, Op->Arg1),
+    *GetSrc<uint64_t*>(Data->SSAData, Op->Arg2),
+    *GetSrc<uint64_t*>(Data->SSAData, Op->Arg3),
+    *GetSrc<uint64_t*>(Data->SSAData, Op->Arg4),
+    *GetSrc<uint64_t*>(Data->SSAData, Op->Arg5),
+  };
+
+  // Register thunks take at most six integer arguments, passing all of them is harmless in the host ABI like in the JITs
+  if (Op->Flags & THUNK_FLAG_RESULT) {
+    using RegisterThunkFn = uint64_t(uint64_t, uint64_t, uint64_t, uint64_t, uint64_t, uint64_t);
+    GD = reinterpret_cast<RegisterThunkFn*>(thunkFn)(Args[0], Args[1], Args[2], Args[3], Args[4], Args[5]);
+  }
+  else {
+    using VoidRegisterThunkFn = void(uint64_t, uint64_t, uint64_t, uint64_t, uint64_t, uint64_t);
+    reinterpret_cast<VoidRegisterThunkFn*>(thunkFn)(Args[0], Args[1], Args[2], Args[3], Args[4], Args[5]);
+    GD = 0;
+  }
 }
 
 DEF_OP(ValidateCode) {
@@ -8,9 +8,89 @@ $end_info$
 #include "Interface/Core/Interpreter/InterpreterOps.h"
 #include "Interface/Core/Interpreter/InterpreterDefines.h"
 
+#include <algorithm>
+#include <bit>
+#include <cfenv>
+#include <cmath>
 #include <cstdint>
 
 namespace FEXCore::CPU {
+namespace {
+float HalfToFloat(uint16_t Half) {
+  const bool Sign = Half >> 15;
+  const uint32_t Exponent = (Half >> 10) & 0x1F;
+  const uint32_t Mantissa = Half & 0x3FF;
+
+  if (Exponent == 0x1F) {
+    // Inf or NaN, NaN payload moves in to the top of the float mantissa and gets quietened
+    const uint32_t Quiet = Mantissa ? 0x40'0000U : 0;
+    return std::bit_cast<float>((uint32_t(Sign) << 31) | 0x7F80'0000U | Quiet | (Mantissa << 13));
+  }
+
+  // Every half is exactly representable as a float
+  const float Magnitude = Exponent == 0 ? std::ldexp(float(Mantissa), -24)
+                                        : std::ldexp(float(Mantissa | 0x400), int(Exponent) - 25);
+  return Sign ? -Magnitude : Magnitude;
+}
+
+// Rounds with the host rounding mode, which tracks the guest's MXCSR.RC
+uint16_t FloatToHalf(float Value) {
+  const uint32_t Bits = std::bit_cast<uint32_t>(Value);
+  const uint16_t Sign = (Bits >> 16) & 0x8000;
+  const uint32_t Exponent = (Bits >> 23) & 0xFF;
+  const uint32_t Mantissa = Bits & 0x7F'FFFF;
+
+  if (Exponent == 0xFF) {
+    // Inf or NaN, NaNs are quietened
+    return Sign | 0x7C00 | (Mantissa ? (0x200 | (Mantissa >> 13)) : 0);
+  }
+
+  // Value = Significand * 2^Scale
+  const uint32_t Significand = Exponent ? (Mantissa | 0x80'0000) : Mantissa;
+  const int Scale = int(Exponent ? Exponent : 1) - 150;
+  if (Significand == 0) {
+    return Sign;
+  }
+
+  // Quantum of the result: 11 significant bits but never below the smallest half denormal
+  const int Log2 = 31 - std::countl_zero(Significand) + Scale;
+  const int Quantum = std::max(Log2 - 10, -24);
+  // Anything shifted past bit 32 rounds the same way as a shift of 32
+  const int Shift = std::min(Quantum - Scale, 32);
+
+  uint32_t Result{};
+  if (Shift <= 0) {
+    Result = Significand << -Shift;
+  } else {
+    Result = Shift == 32 ? 0 : (Significand >> Shift);
+    const uint32_t Remainder = Shift == 32 ? Significand : (Significand & ((1U << Shift) - 1));
+    if (Remainder) {
+      const uint64_t Half = uint64_t{1} << (Shift - 1);
+      bool RoundUp{};
+      switch (fegetround()) {
+        case FE_TONEAREST: RoundUp = Remainder > Half || (Remainder == Half && (Result & 1)); break;
+        case FE_DOWNWARD: RoundUp = Sign != 0; break;
+        case FE_UPWARD: RoundUp = Sign == 0; break;
+        default: break;
+      }
+      Result += RoundUp;
+    }
+  }
+
+  // Denormals land on the exponent bits naturally, a carry out of the mantissa bumps the exponent
+  Result += uint32_t(Quantum + 24) << 10;
+  if (Result >= 0x7C00) {
+    // Overflow goes to infinity unless the rounding direction points back at the largest finite half
+    const int Round = fegetround();
+    const bool ToInfinity = Round == FE_TONEAREST ||
+                            (Round == FE_UPWARD && !Sign) ||
+                            (Round == FE_DOWNWARD && Sign);
+    Result = ToInfinity ? 0x7C00 : 0x7BFF;
+  }
+  return Sign | Result;
+}
+}
+
 #define DEF_OP(x) void InterpreterOps::Op_##x(IR::IROp_Header *IROp, IROpData *Data, IR::NodeID Node)
 DEF_OP(VInsGPR) {
   const auto Op = IROp->C<IR::IROp_VInsGPR>();
@@ -199,6 +279,18 @@ DEF_OP(Vector_FToF) {
       DO_VECTOR_1SRC_2TYPE_OP_NOSIZE(float, double, Func, 0, 0)
       break;
     }
+    case 0x0402: { // Float <- Half
+      uint8_t Elements = OpSize / 4;
+      const auto HalfFunc = [](uint16_t a, auto min, auto max) { return HalfToFloat(a); };
+      DO_VECTOR_1SRC_2TYPE_OP_NOSIZE(float, uint16_t, HalfFunc, 0, 0)
+      break;
+    }
+    case 0x0204: { // Half <- Float
+      uint8_t Elements = OpSize / 4;
+      const auto HalfFunc = [](float a, auto min, auto max) { return FloatToHalf(a); };
+      DO_VECTOR_1SRC_2TYPE_OP_NOSIZE(uint16_t, float, HalfFunc, 0, 0)
+      break;
+    }
     default:
       LOGMAN_MSG_A_FMT("Unknown Conversion Type : 0x{:04x}", Conv);
       break;
@@ -3,6 +3,7 @@
 #include "Interface/Core/InternalThreadState.h"
 #include "Interface/Core/Dispatcher/Dispatcher.h"
 
+#include <FEXCore/Config/Config.h>
 #include <FEXCore/Core/CPUBackend.h>
 #include <FEXCore/IR/IR.h>
 #include <FEXCore/IR/IntrusiveIRList.h>
@@ -40,6 +41,7 @@ public:
   void ClearCache() override;
 
 private:
+  FEX_CONFIG_OPT(InterpreterPredecode, INTERPRETERPREDECODE);
   size_t BufferUsed;
   Dispatcher *Dispatch;
 };
@@ -44,7 +44,12 @@ InterpreterCore::InterpreterCore(Dispatcher *Dispatcher, FEXCore::Core::Internal
 
   auto &Interpreter = Thread->CurrentFrame->Pointers.Interpreter;
 
-  Interpreter.FragmentExecuter = reinterpret_cast<uint64_t>(&InterpreterOps::InterpretIR);
+  if (InterpreterPredecode()) {
+    Interpreter.FragmentExecuter = reinterpret_cast<uint64_t>(&InterpreterOps::InterpretPredecoded);
+  }
+  else {
+    Interpreter.FragmentExecuter = reinterpret_cast<uint64_t>(&InterpreterOps::InterpretIR);
+  }
 
   ClearCache();
 }
@@ -61,7 +66,10 @@ void InterpreterCore::InitializeSignalHandlers(FEXCore::Context::Context *CTX) {
 void *InterpreterCore::CompileCode(uint64_t Entry, [[maybe_unused]] FEXCore::IR::IRListView const *IR, [[maybe_unused]] FEXCore::Core::DebugData *DebugData, FEXCore::IR::RegisterAllocationData *RAData, bool GDBEnabled) {
 
   const auto IRSize = AlignUp(IR->GetInlineSize(), 16);
-  const auto MaxSize = IRSize + Dispatcher::MaxInterpreterTrampolineSize + GDBEnabled * Dispatcher::MaxGDBPauseCheckSize;
+  // The pre-decoded fragment header sits where the trampoline points, the op array is aligned after the IR
+  const auto PredecodedSize = InterpreterPredecode() ?
+    sizeof(InterpreterOps::PredecodedFragment) + 16 + InterpreterOps::GetMaxPredecodedOps(IR) * sizeof(InterpreterOps::PredecodedOp) + 16 : 0;
+  const auto MaxSize = IRSize + PredecodedSize + Dispatcher::MaxInterpreterTrampolineSize + GDBEnabled * Dispatcher::MaxGDBPauseCheckSize;
 
   if ((BufferUsed + MaxSize) > CurrentCodeBuffer->Size) {
     ThreadState->CTX->ClearCodeCache(ThreadState);
@@ -74,17 +82,30 @@ void *InterpreterCore::CompileCode(uint64_t Entry, [[maybe_unused]] FEXCore::IR:
   if (GDBEnabled) {
     const auto GDBSize = Dispatch->GenerateGDBPauseCheck(DestBuffer, Entry);
     DestBuffer += GDBSize;
-    BufferUsed += GDBSize;
   }
 
   const auto TrampolineSize = Dispatch->GenerateInterpreterTrampoline(DestBuffer);
   DestBuffer += TrampolineSize;
-  BufferUsed += TrampolineSize;
 
+  if (InterpreterPredecode()) {
+    auto Fragment = reinterpret_cast<InterpreterOps::PredecodedFragment*>(DestBuffer);
+    DestBuffer = reinterpret_cast<uint8_t*>(AlignUp(reinterpret_cast<uintptr_t>(DestBuffer + sizeof(*Fragment)), 16));
+
+    // Handlers point in to this copy of the IR so it has to be the one that is decoded
+    auto InlineIR = reinterpret_cast<FEXCore::IR::IRListView const*>(DestBuffer);
+    IR->Serialize(DestBuffer);
+    DestBuffer += IRSize;
+
+    auto Ops = reinterpret_cast<InterpreterOps::PredecodedOp*>(AlignUp(reinterpret_cast<uintptr_t>(DestBuffer), 16));
+    InterpreterOps::Predecode(Fragment, Ops, InlineIR);
+    DestBuffer = reinterpret_cast<uint8_t*>(Ops + Fragment->OpCount);
+  }
+  else {
+    IR->Serialize(DestBuffer);
+    DestBuffer += IRSize;
+  }
 
-  IR->Serialize(DestBuffer);
-  DestBuffer += IRSize;
-  BufferUsed += IRSize;
+  BufferUsed += DestBuffer - BufferStart;
 
   return BufferStart;
 }
@@ -42,6 +42,17 @@
   }                                                 \
   break;                                            \
   }
+#define DO_VECTOR_3SRC_OP(size, type, func)              \
+  case size: {                                      \
+  auto *Dst_d  = reinterpret_cast<type*>(Tmp);  \
+  auto *Src1_d = reinterpret_cast<type*>(Src1); \
+  auto *Src2_d = reinterpret_cast<type*>(Src2); \
+  auto *Src3_d = reinterpret_cast<type*>(Src3); \
+  for (uint8_t i = 0; i < Elements; ++i) {          \
+    Dst_d[i] = func(Src1_d[i], Src2_d[i], Src3_d[i]);          \
+  }                                                 \
+  break;                                            \
+  }
 #define DO_VECTOR_PAIR_OP(size, type, func)              \
   case size: {                                      \
   auto *Dst_d  = reinterpret_cast<type*>(Tmp);  \
@@ -182,3 +193,9 @@ Res GetSrc(void* SSAData, FEXCore::IR::OrderedNodeWrapper Src) {
   auto DstPtr = &reinterpret_cast<InterpVector256*>(SSAData)[Src.ID().Value];
   return reinterpret_cast<Res>(DstPtr);
 }
+
+template<typename Res>
+Res GetSrc(void* SSAData, FEXCore::IR::NodeID Src) {
+  auto DstPtr = &reinterpret_cast<InterpVector256*>(SSAData)[Src.Value];
+  return reinterpret_cast<Res>(DstPtr);
+}
@@ -33,10 +33,11 @@
 #include <ctime>
 #include <limits>
 #include <memory>
+#include <vector>
 
 namespace FEXCore::CPU {
 
-using OpHandler = void (*)(IR::IROp_Header *IROp, InterpreterOps::IROpData *Data, IR::NodeID Node);
+using OpHandler = InterpreterOps::OpHandler;
 using OpHandlerArray = std::array<OpHandler, IR::IROps::OP_LAST + 1>;
 
 constexpr OpHandlerArray InterpreterOpHandlers = [] {
@@ -157,6 +158,9 @@ constexpr OpHandlerArray InterpreterOpHandlers = [] {
   REGISTER_OP(CACHELINECLEAR,         CacheLineClear);
   REGISTER_OP(CACHELINECLEAN,         CacheLineClean);
   REGISTER_OP(CACHELINEZERO,          CacheLineZero);
+  REGISTER_OP(MEMSET,                 MemSet);
+  REGISTER_OP(MEMCPY,                 MemCpy);
+  REGISTER_OP(MEMCMP,                 MemCmp);
 
   // Misc ops
   REGISTER_OP(DUMMY,                  NoOp);
@@ -165,6 +169,7 @@ constexpr OpHandlerArray InterpreterOpHandlers = [] {
   REGISTER_OP(BEGINBLOCK,             NoOp);
   REGISTER_OP(ENDBLOCK,               NoOp);
   REGISTER_OP(GUESTOPCODE,            NoOp);
+  REGISTER_OP(RESUMEENTRY,            NoOp);
   REGISTER_OP(FENCE,                  Fence);
   REGISTER_OP(BREAK,                  Break);
   REGISTER_OP(PHI,                    NoOp);
@@ -206,6 +211,10 @@ constexpr OpHandlerArray InterpreterOpHandlers = [] {
   REGISTER_OP(VFSUB,                  VFSub);
   REGISTER_OP(VFMUL,                  VFMul);
   REGISTER_OP(VFDIV,                  VFDiv);
+  REGISTER_OP(VFMLA,                  VFMLA);
+  REGISTER_OP(VFMLS,                  VFMLS);
+  REGISTER_OP(VFNMLA,                 VFNMLA);
+  REGISTER_OP(VFNMLS,                 VFNMLS);
   REGISTER_OP(VFMIN,                  VFMin);
   REGISTER_OP(VFMAX,                  VFMax);
   REGISTER_OP(VFRECP,                 VFRecp);
@@ -223,6 +232,7 @@ constexpr OpHandlerArray InterpreterOpHandlers = [] {
   REGISTER_OP(VUNZIP,                 VUnZip);
   REGISTER_OP(VUNZIP2,                VUnZip);
   REGISTER_OP(VBSL,                   VBSL);
+  REGISTER_OP(VPCMPXSTRX,             VPCMPXSTRX);
   REGISTER_OP(VCMPEQ,                 VCMPEQ);
   REGISTER_OP(VCMPEQZ,                VCMPEQZ);
   REGISTER_OP(VCMPGT,                 VCMPGT);
@@ -392,4 +402,243 @@ void InterpreterOps::InterpretIR(FEXCore::Core::CpuStateFrame *Frame, FEXCore::I
   }
 }
 
+void InterpreterOps::Predecode(PredecodedFragment *Fragment, PredecodedOp *Ops, FEXCore::IR::IRListView const *IR) {
+  using namespace FEXCore::IR;
+
+  // Block ID to the index of its first op, branches are patched once every block is placed
+  std::vector<uint32_t> BlockStart(IR->GetSSACount());
+  uint32_t OpCount = 0;
+
+  for (auto [BlockNode, BlockHeader] : IR->GetBlocks()) {
+    auto BlockIROp = BlockHeader->CW<IROp_CodeBlock>();
+    LOGMAN_THROW_AA_FMT(BlockIROp->Header.Op == IR::OP_CODEBLOCK, "IR type failed to be a code block");
+
+    BlockStart[IR->GetID(BlockNode).Value] = OpCount;
+
+    auto CodeBegin = IR->at(BlockIROp->Begin);
+    auto CodeLast = IR->at(BlockIROp->Last);
+
+    for (auto [CodeNode, IROp] : IR->GetCode(BlockNode)) {
+      const OpHandler Handler = InterpreterOpHandlers[IROp->Op];
+
+      if (Handler != &InterpreterOps::Op_NoOp) {
+        auto &Op = Ops[OpCount++];
+        Op = PredecodedOp {
+          .Handler = Handler,
+          .IROp = IROp,
+          .Node = IR->GetID(CodeNode),
+          .Kind = PREDECODED_OP,
+        };
+
+        // Only the sizes every one of the ALU handlers supports
+        auto SetALU = [&](PredecodedKind Kind, OrderedNodeWrapper Src1, OrderedNodeWrapper Src2) {
+          if (IROp->Size == 4 || IROp->Size == 8) {
+            Op.Kind = Kind;
+            Op.Size = IROp->Size;
+            Op.Src[0] = Src1.ID();
+            Op.Src[1] = Src2.ID();
+          }
+        };
+
+        switch (IROp->Op) {
+          case OP_JUMP: {
+            auto Jump = IROp->C<IROp_Jump>();
+            Op.Kind = PREDECODED_JUMP;
+            Op.Target[0] = Jump->TargetBlock.ID().Value;
+            break;
+          }
+          case OP_CONDJUMP: {
+            auto CondJump = IROp->C<IROp_CondJump>();
+            Op.Kind = PREDECODED_CONDJUMP;
+            Op.Cond = CondJump->Cond.Val;
+            Op.Size = CondJump->CompareSize;
+            Op.Target[0] = CondJump->TrueBlock.ID().Value;
+            Op.Target[1] = CondJump->FalseBlock.ID().Value;
+            Op.Src[0] = CondJump->Cmp1.ID();
+            Op.Src[1] = CondJump->Cmp2.ID();
+            break;
+          }
+          case OP_EXITFUNCTION:
+            Op.Kind = PREDECODED_EXIT;
+            break;
+          case OP_CONSTANT:
+            Op.Kind = PREDECODED_CONSTANT;
+            Op.Value = IROp->C<IROp_Constant>()->Constant;
+            break;
+          // Vector sized accesses stay with the handlers
+          case OP_LOADREGISTER:
+          case OP_LOADCONTEXT:
+            if (IROp->Size <= 8) {
+              Op.Kind = PREDECODED_LOADCONTEXT;
+              Op.Size = IROp->Size;
+              Op.Value = IROp->Op == OP_LOADREGISTER ? IROp->C<IROp_LoadRegister>()->Offset : IROp->C<IROp_LoadContext>()->Offset;
+            }
+            break;
+          case OP_STOREREGISTER:
+          case OP_STORECONTEXT:
+            if (IROp->Size <= 8) {
+              Op.Kind = PREDECODED_STORECONTEXT;
+              Op.Size = IROp->Size;
+              if (IROp->Op == OP_STOREREGISTER) {
+                Op.Src[0] = IROp->C<IROp_StoreRegister>()->Value.ID();
+                Op.Value = IROp->C<IROp_StoreRegister>()->Offset;
+              }
+              else {
+                Op.Src[0] = IROp->C<IROp_StoreContext>()->Value.ID();
+                Op.Value = IROp->C<IROp_StoreContext>()->Offset;
+              }
+            }
+            break;
+          case OP_ADD: SetALU(PREDECODED_ADD, IROp->C<IROp_Add>()->Src1, IROp->C<IROp_Add>()->Src2); break;
+          case OP_SUB: SetALU(PREDECODED_SUB, IROp->C<IROp_Sub>()->Src1, IROp->C<IROp_Sub>()->Src2); break;
+          case OP_AND: SetALU(PREDECODED_AND, IROp->C<IROp_And>()->Src1, IROp->C<IROp_And>()->Src2); break;
+          case OP_OR: SetALU(PREDECODED_OR, IROp->C<IROp_Or>()->Src1, IROp->C<IROp_Or>()->Src2); break;
+          case OP_XOR: SetALU(PREDECODED_XOR, IROp->C<IROp_Xor>()->Src1, IROp->C<IROp_Xor>()->Src2); break;
+          default: break;
+        }
+      }
+
+      if (CodeBegin == CodeLast) {
+        break;
+      }
+      ++CodeBegin;
+    }
+  }
+
+  // Falling off the last block leaves the fragment like the IR walker does
+  Ops[OpCount++] = PredecodedOp {
+    .Kind = PREDECODED_END,
+  };
+
+  for (uint32_t i = 0; i < OpCount; ++i) {
+    auto &Op = Ops[i];
+    if (Op.Kind == PREDECODED_JUMP || Op.Kind == PREDECODED_CONDJUMP) {
+      Op.Target[0] = BlockStart[Op.Target[0]];
+      Op.Target[1] = BlockStart[Op.Target[1]];
+    }
+  }
+
+  Fragment->IR = IR;
+  Fragment->Ops = Ops;
+  Fragment->SSACount = IR->GetSSACount();
+  Fragment->OpCount = OpCount;
+}
+
+void InterpreterOps::InterpretPredecoded(FEXCore::Core::CpuStateFrame *Frame, PredecodedFragment const *Fragment) {
+  volatile void *StackEntry = alloca(0);
+
+  constexpr size_t ListEntrySizeInBytes = sizeof(InterpVector256);
+  const size_t SSADataSize = Fragment->SSACount * ListEntrySizeInBytes;
+
+  InterpreterOps::IROpData OpData{
+    .State = Frame->Thread,
+    .CurrentEntry = Frame->State.rip,
+    .CurrentIR = Fragment->IR,
+    .StackEntry = StackEntry,
+    .SSAData = alloca(SSADataSize),
+  };
+
+  // Clear all SSAData entries to zero. Required for Zero-extend semantics
+  memset(OpData.SSAData, 0, SSADataSize);
+
+  // Indexed by PredecodedKind
+  static void *const DispatchTable[] = {
+    &&ExecuteOp,
+    &&ExecuteJump,
+    &&ExecuteCondJump,
+    &&ExecuteExit,
+    &&ExecuteEnd,
+    &&ExecuteConstant,
+    &&ExecuteLoadContext,
+    &&ExecuteStoreContext,
+    &&ExecuteAdd,
+    &&ExecuteSub,
+    &&ExecuteAnd,
+    &&ExecuteOr,
+    &&ExecuteXor,
+  };
+
+  const PredecodedOp *Ops = Fragment->Ops;
+  const PredecodedOp *Current = Ops;
+  auto ContextPtr = reinterpret_cast<uint8_t*>(OpData.State->CurrentFrame);
+
+  // Every op jumps straight to the next one's label rather than returning to a shared loop
+#define DISPATCH() goto *DispatchTable[Current->Kind]
+
+  DISPATCH();
+
+ExecuteOp:
+  Current->Handler(Current->IROp, &OpData, Current->Node);
+  ++Current;
+  DISPATCH();
+
+ExecuteJump:
+  Current = &Ops[Current->Target[0]];
+  DISPATCH();
+
+ExecuteCondJump: {
+  const uint64_t Src1 = *GetSrc<uint64_t*>(OpData.SSAData, Current->Src[0]);
+  const uint64_t Src2 = *GetSrc<uint64_t*>(OpData.SSAData, Current->Src[1]);
+
+  bool CompResult;
+  if (Current->Size == 4) {
+    CompResult = IsConditionTrue<uint32_t, int32_t, float>(Current->Cond, Src1, Src2);
+  }
+  else {
+    CompResult = IsConditionTrue<uint64_t, int64_t, double>(Current->Cond, Src1, Src2);
+  }
+
+  Current = &Ops[Current->Target[CompResult ? 0 : 1]];
+  DISPATCH();
+}
+
+ExecuteExit:
+  Current->Handler(Current->IROp, &OpData, Current->Node);
+  return;
+
+ExecuteEnd:
+  return;
+
+ExecuteConstant:
+  *GetDest<uint64_t*>(OpData.SSAData, Current->Node) = Current->Value;
+  ++Current;
+  DISPATCH();
+
+ExecuteLoadContext: {
+  // Zero extends in to the slot like the handler
+  uint64_t Value {};
+  memcpy(&Value, ContextPtr + Current->Value, Current->Size);
+  *GetDest<uint64_t*>(OpData.SSAData, Current->Node) = Value;
+  ++Current;
+  DISPATCH();
+}
+
+ExecuteStoreContext:
+  memcpy(ContextPtr + Current->Value, GetSrc<void*>(OpData.SSAData, Current->Src[0]), Current->Size);
+  ++Current;
+  DISPATCH();
+
+#define EXECUTE_ALU(Label, Operator) \
+Label: { \
+  const uint64_t Src1 = *GetSrc<uint64_t*>(OpData.SSAData, Current->Src[0]); \
+  const uint64_t Src2 = *GetSrc<uint64_t*>(OpData.SSAData, Current->Src[1]); \
+  if (Current->Size == 4) { \
+    *GetDest<uint32_t*>(OpData.SSAData, Current->Node) = static_cast<uint32_t>(Src1 Operator Src2); \
+  } \
+  else { \
+    *GetDest<uint64_t*>(OpData.SSAData, Current->Node) = Src1 Operator Src2; \
+  } \
+  ++Current; \
+  DISPATCH(); \
+}
+
+EXECUTE_ALU(ExecuteAdd, +)
+EXECUTE_ALU(ExecuteSub, -)
+EXECUTE_ALU(ExecuteAnd, &)
+EXECUTE_ALU(ExecuteOr, |)
+EXECUTE_ALU(ExecuteXor, ^)
+#undef EXECUTE_ALU
+#undef DISPATCH
+}
+
 }
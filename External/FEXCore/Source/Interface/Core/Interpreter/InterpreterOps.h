@@ -65,6 +65,65 @@ namespace FEXCore::CPU {
         IR::NodeIterator BlockIterator{0, 0};
       };
 
+      using OpHandler = void (*)(IR::IROp_Header *IROp, IROpData *Data, IR::NodeID Node);
+
+      ///< How the pre-decoded executor dispatches an op. Order matches the executor's label table.
+      enum PredecodedKind : uint8_t {
+        PREDECODED_OP,
+        PREDECODED_JUMP,
+        PREDECODED_CONDJUMP,
+        PREDECODED_EXIT,
+        PREDECODED_END,
+        // Executed inline from resolved slots, without going through the handler or the IROp
+        PREDECODED_CONSTANT,
+        PREDECODED_LOADCONTEXT,
+        PREDECODED_STORECONTEXT,
+        PREDECODED_ADD,
+        PREDECODED_SUB,
+        PREDECODED_AND,
+        PREDECODED_OR,
+        PREDECODED_XOR,
+      };
+
+      struct PredecodedOp {
+        OpHandler Handler;
+        IR::IROp_Header *IROp;
+        // SSA slot the result is written to
+        IR::NodeID Node;
+        PredecodedKind Kind;
+        uint8_t Cond;
+        // CondJump compare size, or the operation size of inline ops
+        uint8_t Size;
+        // Branch targets are indices in to the op array
+        uint32_t Target[2];
+        // Resolved SSA slots of the sources
+        IR::NodeID Src[2];
+        // Constant of PREDECODED_CONSTANT, context offset of PREDECODED_LOADCONTEXT and PREDECODED_STORECONTEXT
+        uint64_t Value;
+      };
+
+      /**
+       * @brief An IR fragment lowered once at compile time to a flat op array
+       *
+       * No-ops are dropped, block boundaries disappear and branches point directly at their target op, so the executor
+       * never walks the IR lists. Constants, context accesses and the common integer ALU ops are executed inline from
+       * resolved slots, everything else calls its handler. Lives inline in the code buffer alongside the serialized IR
+       * that the handlers read.
+       */
+      struct PredecodedFragment {
+        FEXCore::IR::IRListView const *IR;
+        PredecodedOp const *Ops;
+        uint32_t SSACount;
+        uint32_t OpCount;
+      };
+
+      [[nodiscard]] static size_t GetMaxPredecodedOps(FEXCore::IR::IRListView const *IR) {
+        // At most one op per node plus the terminator
+        return IR->GetSSACount() + 1;
+      }
+      static void Predecode(PredecodedFragment *Fragment, PredecodedOp *Ops, FEXCore::IR::IRListView const *IR);
+      static void InterpretPredecoded(FEXCore::Core::CpuStateFrame *Frame, PredecodedFragment const *Fragment);
+
 #define DEF_OP(x) static void Op_##x(IR::IROp_Header *IROp, IROpData *Data, IR::NodeID Node)
 
   ///< Unhandled handler
@@ -184,6 +243,9 @@ namespace FEXCore::CPU {
   DEF_OP(CacheLineClear);
   DEF_OP(CacheLineClean);
   DEF_OP(CacheLineZero);
+  DEF_OP(MemSet);
+  DEF_OP(MemCpy);
+  DEF_OP(MemCmp);
 
   ///< Misc ops
   DEF_OP(EndBlock);
@@ -228,6 +290,10 @@ namespace FEXCore::CPU {
   DEF_OP(VFSub);
   DEF_OP(VFMul);
   DEF_OP(VFDiv);
+  DEF_OP(VFMLA);
+  DEF_OP(VFMLS);
+  DEF_OP(VFNMLA);
+  DEF_OP(VFNMLS);
   DEF_OP(VFMin);
   DEF_OP(VFMax);
   DEF_OP(VFRecp);
@@ -243,6 +309,7 @@ namespace FEXCore::CPU {
   DEF_OP(VZip);
   DEF_OP(VUnZip);
   DEF_OP(VBSL);
+  DEF_OP(VPCMPXSTRX);
   DEF_OP(VCMPEQ);
   DEF_OP(VCMPEQZ);
   DEF_OP(VCMPGT);
@@ -9,7 +9,9 @@ $end_info$
 #include "Interface/Core/Interpreter/InterpreterOps.h"
 #include "Interface/Core/Interpreter/InterpreterDefines.h"
 
+#include <atomic>
 #include <cstdint>
+#include <cstring>
 
 namespace FEXCore::CPU {
 static inline void CacheLineFlush(char *Addr) {
@@ -323,5 +325,81 @@ DEF_OP(CacheLineZero) {
   }
 }
 
+DEF_OP(MemSet) {
+  const auto Op = IROp->C<IR::IROp_MemSet>();
+  const int64_t Size = Op->Size;
+
+  uint8_t *MemData = *GetSrc<uint8_t **>(Data->SSAData, Op->Addr);
+  const uint64_t Value = *GetSrc<uint64_t*>(Data->SSAData, Op->Value);
+  const uint64_t Length = *GetSrc<uint64_t*>(Data->SSAData, Op->Length);
+  const int64_t Step = *GetSrc<uint64_t*>(Data->SSAData, Op->Direction) ? -Size : Size;
+
+  if (Op->IsTSO) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+  }
+
+  for (uint64_t i = 0; i < Length; ++i, MemData += Step) {
+    memcpy(MemData, &Value, Size);
+  }
+
+  if (Op->IsTSO) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+  }
+}
+
+DEF_OP(MemCpy) {
+  const auto Op = IROp->C<IR::IROp_MemCpy>();
+  const int64_t Size = Op->Size;
+
+  uint8_t *Dest = *GetSrc<uint8_t **>(Data->SSAData, Op->Dest);
+  uint8_t const *Src = *GetSrc<uint8_t const**>(Data->SSAData, Op->Src);
+  const uint64_t Length = *GetSrc<uint64_t*>(Data->SSAData, Op->Length);
+  const int64_t Step = *GetSrc<uint64_t*>(Data->SSAData, Op->Direction) ? -Size : Size;
+
+  if (Op->IsTSO) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+  }
+
+  for (uint64_t i = 0; i < Length; ++i, Dest += Step, Src += Step) {
+    memcpy(Dest, Src, Size);
+  }
+
+  if (Op->IsTSO) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+  }
+}
+
+DEF_OP(MemCmp) {
+  const auto Op = IROp->C<IR::IROp_MemCmp>();
+  const int64_t Size = Op->Size;
+
+  uint8_t const *Src1 = *GetSrc<uint8_t const**>(Data->SSAData, Op->Src1);
+  uint8_t const *Src2 = *GetSrc<uint8_t const**>(Data->SSAData, Op->Src2);
+  const uint64_t Length = *GetSrc<uint64_t*>(Data->SSAData, Op->Length);
+  const int64_t Step = *GetSrc<uint64_t*>(Data->SSAData, Op->Direction) ? -Size : Size;
+
+  if (Op->IsTSO) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+  }
+
+  uint64_t Compared = 0;
+  while (Compared < Length) {
+    const bool Equal = memcmp(Src1, Src2, Size) == 0;
+    ++Compared;
+    Src1 += Step;
+    Src2 += Step;
+
+    if (Equal != Op->RepeatWhileEqual) {
+      break;
+    }
+  }
+
+  if (Op->IsTSO) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+  }
+
+  GD = Compared;
+}
+
 #undef DEF_OP
 } // namespace FEXCore::CPU
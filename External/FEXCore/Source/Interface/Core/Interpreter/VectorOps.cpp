@@ -13,6 +13,7 @@ $end_info$
 
 #include <array>
 #include <bit>
+#include <cmath>
 #include <cstdint>
 #include <limits>
 #include <type_traits>
@@ -582,6 +583,98 @@ DEF_OP(VFDiv) {
   memcpy(GDP, Tmp, OpSize);
 }
 
+DEF_OP(VFMLA) {
+  const auto Op = IROp->C<IR::IROp_VFMLA>();
+  const uint8_t OpSize = IROp->Size;
+
+  void *Src1 = GetSrc<void*>(Data->SSAData, Op->Vector1);
+  void *Src2 = GetSrc<void*>(Data->SSAData, Op->Vector2);
+  void *Src3 = GetSrc<void*>(Data->SSAData, Op->Addend);
+  uint8_t Tmp[Core::CPUState::XMM_AVX_REG_SIZE]{};
+
+  const uint8_t ElementSize = Op->Header.ElementSize;
+  const uint8_t Elements = OpSize / ElementSize;
+
+  const auto Func = [](auto a, auto b, auto c) { return std::fma(a, b, c); };
+  switch (ElementSize) {
+    DO_VECTOR_3SRC_OP(4, float, Func)
+    DO_VECTOR_3SRC_OP(8, double, Func)
+    default:
+      LOGMAN_MSG_A_FMT("Unknown Element Size: {}", ElementSize);
+      break;
+  }
+  memcpy(GDP, Tmp, OpSize);
+}
+
+DEF_OP(VFMLS) {
+  const auto Op = IROp->C<IR::IROp_VFMLS>();
+  const uint8_t OpSize = IROp->Size;
+
+  void *Src1 = GetSrc<void*>(Data->SSAData, Op->Vector1);
+  void *Src2 = GetSrc<void*>(Data->SSAData, Op->Vector2);
+  void *Src3 = GetSrc<void*>(Data->SSAData, Op->Addend);
+  uint8_t Tmp[Core::CPUState::XMM_AVX_REG_SIZE]{};
+
+  const uint8_t ElementSize = Op->Header.ElementSize;
+  const uint8_t Elements = OpSize / ElementSize;
+
+  const auto Func = [](auto a, auto b, auto c) { return std::fma(a, b, -c); };
+  switch (ElementSize) {
+    DO_VECTOR_3SRC_OP(4, float, Func)
+    DO_VECTOR_3SRC_OP(8, double, Func)
+    default:
+      LOGMAN_MSG_A_FMT("Unknown Element Size: {}", ElementSize);
+      break;
+  }
+  memcpy(GDP, Tmp, OpSize);
+}
+
+DEF_OP(VFNMLA) {
+  const auto Op = IROp->C<IR::IROp_VFNMLA>();
+  const uint8_t OpSize = IROp->Size;
+
+  void *Src1 = GetSrc<void*>(Data->SSAData, Op->Vector1);
+  void *Src2 = GetSrc<void*>(Data->SSAData, Op->Vector2);
+  void *Src3 = GetSrc<void*>(Data->SSAData, Op->Addend);
+  uint8_t Tmp[Core::CPUState::XMM_AVX_REG_SIZE]{};
+
+  const uint8_t ElementSize = Op->Header.ElementSize;
+  const uint8_t Elements = OpSize / ElementSize;
+
+  const auto Func = [](auto a, auto b, auto c) { return std::fma(-a, b, c); };
+  switch (ElementSize) {
+    DO_VECTOR_3SRC_OP(4, float, Func)
+    DO_VECTOR_3SRC_OP(8, double, Func)
+    default:
+      LOGMAN_MSG_A_FMT("Unknown Element Size: {}", ElementSize);
+      break;
+  }
+  memcpy(GDP, Tmp, OpSize);
+}
+
+DEF_OP(VFNMLS) {
+  const auto Op = IROp->C<IR::IROp_VFNMLS>();
+  const uint8_t OpSize = IROp->Size;
+
+  void *Src1 = GetSrc<void*>(Data->SSAData, Op->Vector1);
+  void *Src2 = GetSrc<void*>(Data->SSAData, Op->Vector2);
+  void *Src3 = GetSrc<void*>(Data->SSAData, Op->Addend);
+  uint8_t Tmp[Core::CPUState::XMM_AVX_REG_SIZE]{};
+
+  const uint8_t ElementSize = Op->Header.ElementSize;
+  const uint8_t Elements = OpSize / ElementSize;
+
+  const auto Func = [](auto a, auto b, auto c) { return std::fma(-a, b, -c); };
+  switch (ElementSize) {
+    DO_VECTOR_3SRC_OP(4, float, Func)
+    DO_VECTOR_3SRC_OP(8, double, Func)
+    default:
+      LOGMAN_MSG_A_FMT("Unknown Element Size: {}", ElementSize);
+      break;
+  }
+  memcpy(GDP, Tmp, OpSize);
+}
+
 DEF_OP(VFMin) {
   const auto Op = IROp->C<IR::IROp_VFMin>();
   const uint8_t OpSize = IROp->Size;
@@ -977,6 +1070,77 @@ DEF_OP(VBSL) {
   memcpy(GDP, &Tmp, sizeof(Tmp));
 }
 
+DEF_OP(VPCMPXSTRX) {
+  const auto Op = IROp->C<IR::IROp_VPCMPXSTRX>();
+
+  const auto *LHS = GetSrc<uint8_t*>(Data->SSAData, Op->LHS);
+  const auto *RHS = GetSrc<uint8_t*>(Data->SSAData, Op->RHS);
+  const uint64_t LHSLength = *GetSrc<uint64_t*>(Data->SSAData, Op->LHSLength);
+  const uint64_t RHSLength = *GetSrc<uint64_t*>(Data->SSAData, Op->RHSLength);
+  const uint8_t Control = Op->Control;
+
+  const bool IsWord = (Control & 1) != 0;
+  const bool IsSigned = (Control & 2) != 0;
+  const uint32_t NumElements = IsWord ? 8 : 16;
+
+  const auto Element = [IsWord, IsSigned](const uint8_t *Src, uint64_t Index) -> int32_t {
+    if (IsWord) {
+      uint16_t Value;
+      memcpy(&Value, Src + Index * 2, sizeof(Value));
+      return IsSigned ? static_cast<int16_t>(Value) : Value;
+    }
+    return IsSigned ? static_cast<int8_t>(Src[Index]) : Src[Index];
+  };
+
+  uint32_t Result{};
+  for (uint32_t j = 0; j < NumElements; ++j) {
+    const bool RHSValid = j < RHSLength;
+    bool Match{};
+
+    switch ((Control >> 2) & 0b11) {
+      case 0b00: // Equal any
+        for (uint64_t i = 0; i < LHSLength; ++i) {
+          Match |= RHSValid && Element(LHS, i) == Element(RHS, j);
+        }
+        break;
+      case 0b01: // Ranges
+        for (uint64_t i = 0; i + 1 < LHSLength; i += 2) {
+          Match |= RHSValid && Element(LHS, i) <= Element(RHS, j) && Element(RHS, j) <= Element(LHS, i + 1);
+        }
+        break;
+      case 0b10: // Equal each
+        if (j < LHSLength && RHSValid) {
+          Match = Element(LHS, j) == Element(RHS, j);
+        }
+        else {
+          Match = j >= LHSLength && !RHSValid;
+        }
+        break;
+      case 0b11: // Equal ordered
+        Match = true;
+        for (uint64_t k = 0; k < LHSLength && j + k < NumElements; ++k) {
+          Match &= (j + k) < RHSLength && Element(LHS, k) == Element(RHS, j + k);
+        }
+        break;
+    }
+
+    Result |= static_cast<uint32_t>(Match) << j;
+  }
+
+  switch ((Control >> 4) & 0b11) {
+    case 0b01: // Negative polarity
+      Result ^= (1U << NumElements) - 1;
+      break;
+    case 0b11: // Masked negative polarity
+      Result ^= (1U << RHSLength) - 1;
+      break;
+    default:
+      break;
+  }
+
+  GD = Result;
+}
+
 DEF_OP(VCMPEQ) {
   const auto Op = IROp->C<IR::IROp_VCMPEQ>();
   const uint8_t OpSize = IROp->Size;
@@ -41,15 +41,7 @@ DEF_OP(Constant) {
 DEF_OP(EntrypointOffset) {
   auto Op = IROp->C<IR::IROp_EntrypointOffset>();
 
-  auto Constant = Entry + Op->Offset;
-  auto Dst = GetReg(Node);
-  uint64_t Mask = ~0ULL;
-  uint8_t OpSize = IROp->Size;
-  if (OpSize == 4) {
-    Mask = 0xFFFF'FFFFULL;
-  }
-
-  LoadConstant(ARMEmitter::Size::i64Bit, Dst, Constant & Mask);
+  InsertGuestRIPMove(GetReg(Node), Op->Offset, IROp->Size);
 }
 
 DEF_OP(InlineConstant) {
@@ -6,8 +6,11 @@ $end_info$
 */
 #include "Interface/Context/Context.h"
 #include "Interface/Core/JIT/Arm64/JITClass.h"
+#include "Interface/Core/ObjectCache/ObjectCacheService.h"
 #include "Interface/HLE/Thunks/Thunks.h"
 
+#include <cstring>
+
 namespace FEXCore::CPU {
 
 uint64_t Arm64JITCore::GetNamedSymbolLiteral(FEXCore::CPU::RelocNamedSymbolLiteral::NamedSymbol Op) {
@@ -65,19 +68,34 @@ void Arm64JITCore::PlaceNamedSymbolLiteral(NamedSymbolLiteralPair &Lit) {
   Relocations.emplace_back(Lit.MoveABI);
 }
 
-void Arm64JITCore::InsertGuestRIPMove(ARMEmitter::Register Reg, uint64_t Constant) {
+void Arm64JITCore::InsertGuestRIPMove(ARMEmitter::Register Reg, int64_t GuestEntryOffset, uint8_t GuestRIPSize) {
   Relocation MoveABI{};
   MoveABI.GuestRIPMove.Header.Type = FEXCore::CPU::RelocationTypes::RELOC_GUEST_RIP_MOVE;
   // Offset is the offset from the entrypoint of the block
   auto CurrentCursor = GetCursorAddress<uint8_t *>();
   MoveABI.GuestRIPMove.Offset = CurrentCursor - GuestEntry;
-  MoveABI.GuestRIPMove.GuestRIP = Constant;
+  MoveABI.GuestRIPMove.GuestEntryOffset = GuestEntryOffset;
+  MoveABI.GuestRIPMove.GuestRIPSize = GuestRIPSize;
   MoveABI.GuestRIPMove.RegisterIndex = Reg.Idx();
 
+  uint64_t Constant = GetRelocatedGuestRIP(Entry, GuestEntryOffset, GuestRIPSize);
   LoadConstant(ARMEmitter::Size::i64Bit, Reg, Constant, EmitterCTX->Config.CacheObjectCodeCompilation());
   Relocations.emplace_back(MoveABI);
 }
 
+void Arm64JITCore::PlaceGuestRIPLiteral(int64_t GuestEntryOffset, uint8_t GuestRIPSize) {
+  Relocation MoveABI{};
+  MoveABI.GuestRIPLiteral.Header.Type = FEXCore::CPU::RelocationTypes::RELOC_GUEST_RIP_LITERAL;
+  // Offset is the offset from the entrypoint of the block
+  auto CurrentCursor = GetCursorAddress<uint8_t *>();
+  MoveABI.GuestRIPLiteral.Offset = CurrentCursor - GuestEntry;
+  MoveABI.GuestRIPLiteral.GuestEntryOffset = GuestEntryOffset;
+  MoveABI.GuestRIPLiteral.GuestRIPSize = GuestRIPSize;
+
+  dc64(GetRelocatedGuestRIP(Entry, GuestEntryOffset, GuestRIPSize));
+  Relocations.emplace_back(MoveABI);
+}
+
 bool Arm64JITCore::ApplyRelocations(uint64_t GuestEntry, uint64_t CodeEntry, uint64_t CursorEntry, size_t NumRelocations, const char* EntryRelocations) {
   size_t DataIndex{};
   for (size_t j = 0; j < NumRelocations; ++j) {
@@ -98,7 +116,8 @@ bool Arm64JITCore::ApplyRelocations(uint64_t GuestEntry, uint64_t CodeEntry, uin
       }
       case FEXCore::CPU::RelocationTypes::RELOC_NAMED_THUNK_MOVE: {
         uint64_t Pointer = reinterpret_cast<uint64_t>(EmitterCTX->ThunkHandler->LookupThunk(Reloc->NamedThunkMove.Symbol));
-        if (Pointer == ~0ULL) {
+        if (Pointer == 0) {
+          // The library providing this thunk isn't loaded (yet)
           return false;
         }
 
@@ -109,12 +128,7 @@ bool Arm64JITCore::ApplyRelocations(uint64_t GuestEntry, uint64_t CodeEntry, uin
         break;
       }
       case FEXCore::CPU::RelocationTypes::RELOC_GUEST_RIP_MOVE: {
-        // XXX: Reenable once the JIT Object Cache is upstream
-        // XXX: Should spin the relocation list, create a list of guest RIP moves, and ask for them all once, reduces lock contention.
-        uint64_t Pointer = ~0ULL; // EmitterCTX->JITObjectCache->FindRelocatedRIP(Reloc->GuestRIPMove.GuestRIP);
-        if (Pointer == ~0ULL) {
-          return false;
-        }
+        uint64_t Pointer = GetRelocatedGuestRIP(GuestEntry, Reloc->GuestRIPMove.GuestEntryOffset, Reloc->GuestRIPMove.GuestRIPSize);
 
         // Relocation occurs at the cursorEntry + offset relative to that cursor.
         SetCursorOffset(CursorEntry + Reloc->GuestRIPMove.Offset);
@@ -122,10 +136,43 @@ bool Arm64JITCore::ApplyRelocations(uint64_t GuestEntry, uint64_t CodeEntry, uin
         DataIndex += sizeof(Reloc->GuestRIPMove);
         break;
       }
+      case FEXCore::CPU::RelocationTypes::RELOC_GUEST_RIP_LITERAL: {
+        uint64_t Pointer = GetRelocatedGuestRIP(GuestEntry, Reloc->GuestRIPLiteral.GuestEntryOffset, Reloc->GuestRIPLiteral.GuestRIPSize);
+
+        // Relocation occurs at the cursorEntry + offset relative to that cursor.
+        SetCursorOffset(CursorEntry + Reloc->GuestRIPLiteral.Offset);
+        dc64(Pointer);
+        DataIndex += sizeof(Reloc->GuestRIPLiteral);
+        break;
+      }
+      default:
+        return false;
     }
   }
 
   return true;
 }
+
+void *Arm64JITCore::RelocateJITObjectCode(uint64_t Entry, CodeSerialize::CodeObjectFileSection const *SerializationData) {
+  const auto HostCodeSize = SerializationData->HostCodeSize;
+  if ((GetCursorOffset() + HostCodeSize) > CurrentCodeBuffer->Size) {
+    CTX->ClearCodeCache(ThreadState);
+  }
+
+  const auto CursorEntry = GetCursorOffset();
+  auto CodeEntry = GetCursorAddress<uint8_t *>();
+  memcpy(CodeEntry, SerializationData->HostCode, HostCodeSize);
+
+  if (!ApplyRelocations(Entry, reinterpret_cast<uint64_t>(CodeEntry), CursorEntry, SerializationData->NumRelocations, SerializationData->Relocations)) {
+    // Leave the cursor where it was, the copied code gets overwritten by the next block
+    SetCursorOffset(CursorEntry);
+    return nullptr;
+  }
+
+  SetCursorOffset(CursorEntry + HostCodeSize);
+  ClearICache(CodeEntry, HostCodeSize);
+
+  return CodeEntry;
+}
 }
 
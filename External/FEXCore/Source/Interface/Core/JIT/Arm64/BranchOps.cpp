@@ -68,18 +68,22 @@ DEF_OP(ExitFunction) {
 
   uint64_t NewRIP;
 
-  if (IsInlineConstant(Op->NewRIP, &NewRIP) || IsInlineEntrypointOffset(Op->NewRIP, &NewRIP)) {
-    ARMEmitter::ForwardLabel l_BranchHost;
-    ARMEmitter::ForwardLabel l_BranchGuest;
+  const bool IsEntrypointOffset = IsInlineEntrypointOffset(Op->NewRIP, &NewRIP);
+  if (IsInlineConstant(Op->NewRIP, &NewRIP) || IsEntrypointOffset) {
+    auto BranchHost = InsertNamedSymbolLiteral(FEXCore::CPU::RelocNamedSymbolLiteral::NamedSymbol::SYMBOL_LITERAL_EXITFUNCTION_LINKER);
 
-    ldr(ARMEmitter::XReg::x0, &l_BranchHost);
+    ldr(ARMEmitter::XReg::x0, &BranchHost.Loc);
     blr(ARMEmitter::Reg::r0);
 
-    Bind(&l_BranchHost);
-    dc64(ThreadState->CurrentFrame->Pointers.Common.ExitFunctionLinker);
-    Bind(&l_BranchGuest);
-    dc64(NewRIP);
+    PlaceNamedSymbolLiteral(BranchHost);
 
+    if (IsEntrypointOffset) {
+      auto InlineOp = IR->GetOp<IR::IROp_InlineEntrypointOffset>(Op->NewRIP);
+      PlaceGuestRIPLiteral(InlineOp->Offset, InlineOp->Header.Size);
+    }
+    else {
+      dc64(NewRIP);
+    }
   } else {
 
     ARMEmitter::ForwardLabel FullLookup;
@@ -332,26 +336,55 @@ DEF_OP(InlineSyscall) {
 DEF_OP(Thunk) {
   auto Op = IROp->C<IR::IROp_Thunk>();
   // Arguments are passed as follows:
-  // X0: CTX
-  // X1: Args (from guest stack)
+  // X0: ArgPtr (packed arguments on the guest stack, or the first register argument)
+  // X1-X5: Arg1-Arg5
+  // X6: Host function
+  //
+  // Result: X0
+  //
+  // With TSO page tracking, CallThunk is called instead and gets the host function as its seventh argument
 
   SpillStaticRegs(); // spill to ctx before ra64 spill
 
   PushDynamicRegsAndLR(TMP1);
 
-  mov(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::r0, GetReg(Op->ArgPtr.ID()));
-
-  auto thunkFn = ThreadState->CTX->ThunkHandler->LookupThunk(Op->ThunkNameHash);
-  LoadConstant(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::r2, (uintptr_t)thunkFn);
+  // Sources may live in the argument registers, so go through the stack
+  sub(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::rsp, ARMEmitter::Reg::rsp, 48);
+  str(GetReg(Op->ArgPtr.ID()).X(), ARMEmitter::Reg::rsp, 0);
+  str(GetReg(Op->Arg1.ID()).X(), ARMEmitter::Reg::rsp, 8);
+  str(GetReg(Op->Arg2.ID()).X(), ARMEmitter::Reg::rsp, 16);
+  str(GetReg(Op->Arg3.ID()).X(), ARMEmitter::Reg::rsp, 24);
+  str(GetReg(Op->Arg4.ID()).X(), ARMEmitter::Reg::rsp, 32);
+  str(GetReg(Op->Arg5.ID()).X(), ARMEmitter::Reg::rsp, 40);
+  ldp<ARMEmitter::IndexType::OFFSET>(ARMEmitter::XReg::x0, ARMEmitter::XReg::x1, ARMEmitter::Reg::rsp, 0);
+  ldp<ARMEmitter::IndexType::OFFSET>(ARMEmitter::XReg::x2, ARMEmitter::XReg::x3, ARMEmitter::Reg::rsp, 16);
+  ldp<ARMEmitter::IndexType::OFFSET>(ARMEmitter::XReg::x4, ARMEmitter::XReg::x5, ARMEmitter::Reg::rsp, 32);
+  add(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::rsp, ARMEmitter::Reg::rsp, 48);
+
+  // Bound once at compile time, the relocation rebinds it when the code is loaded from a cache
+  InsertNamedThunkRelocation(ARMEmitter::Reg::r6, Op->ThunkNameHash);
+  if (CTX->Config.TSOPageTracking) {
+    ldr(ARMEmitter::XReg::x7, STATE, offsetof(FEXCore::Core::CpuStateFrame, Pointers.Common.CallThunkFunc));
 #ifdef VIXL_SIMULATOR
-  GenerateIndirectRuntimeCall<void, void*, void*>(ARMEmitter::Reg::r2);
+    GenerateIndirectRuntimeCall<uint64_t, uint64_t, uint64_t, uint64_t, uint64_t, uint64_t, uint64_t, uint64_t>(ARMEmitter::Reg::r7);
 #else
-  blr(ARMEmitter::Reg::r2);
+    blr(ARMEmitter::Reg::r7);
+#endif
+  }
+  else {
+#ifdef VIXL_SIMULATOR
+    GenerateIndirectRuntimeCall<uint64_t, uint64_t, uint64_t, uint64_t, uint64_t, uint64_t, uint64_t>(ARMEmitter::Reg::r6);
+#else
+    blr(ARMEmitter::Reg::r6);
 #endif
+  }
 
   PopDynamicRegsAndLR();
 
   FillStaticRegs(); // load from ctx after ra64 refill
+
+  // Move result to its destination register
+  mov(ARMEmitter::Size::i64Bit, GetReg(Node), ARMEmitter::Reg::r0);
 }
 
 DEF_OP(ValidateCode) {
@@ -361,7 +394,7 @@ DEF_OP(ValidateCode) {
   int idx = 0;
 
   LoadConstant(ARMEmitter::Size::i64Bit, GetReg(Node), 0);
-  LoadConstant(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::r0, Entry + Op->Offset);
+  InsertGuestRIPMove(ARMEmitter::Reg::r0, Op->Offset, 8);
   LoadConstant(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::r1, 1);
 
   const auto Dst = GetReg(Node);
@@ -412,7 +445,7 @@ DEF_OP(ThreadRemoveCodeEntry) {
   PushDynamicRegsAndLR(TMP1);
 
   mov(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::r0, STATE.R());
-  LoadConstant(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::r1, Entry);
+  InsertGuestRIPMove(ARMEmitter::Reg::r1, 0, 8);
 
   ldr(ARMEmitter::XReg::x2, STATE, offsetof(FEXCore::Core::CpuStateFrame, Pointers.Common.ThreadRemoveCodeEntryFromJIT));
   SpillStaticRegs();
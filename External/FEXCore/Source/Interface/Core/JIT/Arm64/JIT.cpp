@@ -19,6 +19,7 @@ $end_info$
 #include "Interface/Core/Dispatcher/Arm64Dispatcher.h"
 #include "Interface/Core/JIT/Arm64/JITClass.h"
 #include "Interface/Core/InternalThreadState.h"
+#include "Interface/HLE/Thunks/Thunks.h"
 
 #include "Interface/IR/Passes/RegisterAllocationPass.h"
 
@@ -553,6 +554,7 @@ Arm64JITCore::Arm64JITCore(FEXCore::Context::Context *ctx, FEXCore::Core::Intern
 
     Common.SyscallHandlerObj = reinterpret_cast<uint64_t>(CTX->SyscallHandler);
     Common.SyscallHandlerFunc = reinterpret_cast<uint64_t>(FEXCore::Context::HandleSyscall);
+    Common.CallThunkFunc = reinterpret_cast<uint64_t>(FEXCore::CallThunk);
     Common.ExitFunctionLink = reinterpret_cast<uintptr_t>(&Context::Context::ThreadExitFunctionLink<Arm64JITCore_ExitFunctionLink>);
 
 
@@ -716,17 +718,9 @@ void *Arm64JITCore::CompileCode(uint64_t Entry,
   //LOGMAN_THROW_A_FMT(RAData->HasFullRA(), "Arm64 JIT only works with RA");
 
   SpillSlots = RAData->SpillSlots();
+  this->GDBEnabled = GDBEnabled;
 
-  if (SpillSlots) {
-    const auto TotalSpillSlotsSize = SpillSlots * MaxSpillSlotSize;
-
-    if (vixl::aarch64::Assembler::IsImmAddSub(TotalSpillSlotsSize)) {
-      sub(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::rsp, ARMEmitter::Reg::rsp, TotalSpillSlotsSize);
-    } else {
-      LoadConstant(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::r0, TotalSpillSlotsSize);
-      sub(ARMEmitter::Size::i64Bit, ARMEmitter::XReg::rsp, ARMEmitter::XReg::rsp, ARMEmitter::XReg::x0, ARMEmitter::ExtendedType::LSL_64, 0);
-    }
-  }
+  AllocateStack();
 
   PendingTargetLabel = nullptr;
 
@@ -890,6 +884,9 @@ void *Arm64JITCore::CompileCode(uint64_t Entry,
         REGISTER_OP(CACHELINECLEAR,      CacheLineClear);
         REGISTER_OP(CACHELINECLEAN,      CacheLineClean);
         REGISTER_OP(CACHELINEZERO,       CacheLineZero);
+        REGISTER_OP(MEMSET,              MemSet);
+        REGISTER_OP(MEMCPY,              MemCpy);
+        REGISTER_OP(MEMCMP,              MemCmp);
 
         // Misc ops
         REGISTER_OP(DUMMY,      NoOp);
@@ -898,6 +895,7 @@ void *Arm64JITCore::CompileCode(uint64_t Entry,
         REGISTER_OP(BEGINBLOCK, NoOp);
         REGISTER_OP(ENDBLOCK,   NoOp);
         REGISTER_OP(GUESTOPCODE, GuestOpcode);
+        REGISTER_OP(RESUMEENTRY, ResumeEntry);
         REGISTER_OP(FENCE,      Fence);
         REGISTER_OP(BREAK,      Break);
         REGISTER_OP(PHI,        NoOp);
@@ -939,6 +937,10 @@ void *Arm64JITCore::CompileCode(uint64_t Entry,
         REGISTER_OP(VFSUB,             VFSub);
         REGISTER_OP(VFMUL,             VFMul);
         REGISTER_OP(VFDIV,             VFDiv);
+        REGISTER_OP(VFMLA,             VFMLA);
+        REGISTER_OP(VFMLS,             VFMLS);
+        REGISTER_OP(VFNMLA,            VFNMLA);
+        REGISTER_OP(VFNMLS,            VFNMLS);
         REGISTER_OP(VFMIN,             VFMin);
         REGISTER_OP(VFMAX,             VFMax);
         REGISTER_OP(VFRECP,            VFRecp);
@@ -956,6 +958,7 @@ void *Arm64JITCore::CompileCode(uint64_t Entry,
         REGISTER_OP(VUNZIP,            VUnZip);
         REGISTER_OP(VUNZIP2,           VUnZip2);
         REGISTER_OP(VBSL,              VBSL);
+        REGISTER_OP(VPCMPXSTRX,        VPCMPXSTRX);
         REGISTER_OP(VCMPEQ,            VCMPEQ);
         REGISTER_OP(VCMPEQZ,           VCMPEQZ);
         REGISTER_OP(VCMPGT,            VCMPGT);
@@ -1040,6 +1043,21 @@ void *Arm64JITCore::CompileCode(uint64_t Entry,
   return GuestEntry;
 }
 
+void Arm64JITCore::AllocateStack() {
+  if (SpillSlots == 0) {
+    return;
+  }
+
+  const auto TotalSpillSlotsSize = SpillSlots * MaxSpillSlotSize;
+
+  if (vixl::aarch64::Assembler::IsImmAddSub(TotalSpillSlotsSize)) {
+    sub(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::rsp, ARMEmitter::Reg::rsp, TotalSpillSlotsSize);
+  } else {
+    LoadConstant(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::r0, TotalSpillSlotsSize);
+    sub(ARMEmitter::Size::i64Bit, ARMEmitter::XReg::rsp, ARMEmitter::XReg::rsp, ARMEmitter::XReg::x0, ARMEmitter::ExtendedType::LSL_64, 0);
+  }
+}
+
 void Arm64JITCore::ResetStack() {
   if (SpillSlots == 0) {
     return;
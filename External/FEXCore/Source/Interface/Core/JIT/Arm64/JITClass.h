@@ -42,6 +42,8 @@ public:
                                   FEXCore::Core::DebugData *DebugData,
                                   FEXCore::IR::RegisterAllocationData *RAData, bool GDBEnabled) override;
 
+  [[nodiscard]] void *RelocateJITObjectCode(uint64_t Entry, CodeSerialize::CodeObjectFileSection const *SerializationData) override;
+
   [[nodiscard]] void *MapRegion(void* HostPtr, uint64_t, uint64_t) override { return HostPtr; }
 
   [[nodiscard]] bool NeedsOpDispatch() override { return true; }
@@ -172,6 +174,7 @@ private:
   IR::RegisterAllocationData *RAData;
   FEXCore::Core::DebugData *DebugData;
 
+  void AllocateStack();
   void ResetStack();
   /**
    * @name Relocations
@@ -200,9 +203,18 @@ private:
      * @brief Inserts a guest GPR move relocation
      *
      * @param Reg - The GPR to move the guest RIP in to
-     * @param Constant - The guest RIP that will be relocated
+     * @param GuestEntryOffset - The guest RIP that will be relocated, relative to the block entry
+     * @param GuestRIPSize - 4 to truncate the RIP to 32-bit
+     */
+    void InsertGuestRIPMove(ARMEmitter::Register Reg, int64_t GuestEntryOffset, uint8_t GuestRIPSize);
+
+    /**
+     * @brief Places a guest RIP as a literal in memory at the current cursor
+     *
+     * @param GuestEntryOffset - The guest RIP that will be relocated, relative to the block entry
+     * @param GuestRIPSize - 4 to truncate the RIP to 32-bit
      */
-    void InsertGuestRIPMove(ARMEmitter::Register Reg, uint64_t Constant);
+    void PlaceGuestRIPLiteral(int64_t GuestEntryOffset, uint8_t GuestRIPSize);
 
     /**
      * @brief Inserts a named symbol as a literal in memory
@@ -230,6 +242,7 @@ private:
   /**  @} */
 
   uint32_t SpillSlots{};
+  bool GDBEnabled{};
   /**
   * @brief Current guest RIP entrypoint
   */
@@ -358,9 +371,13 @@ private:
   DEF_OP(CacheLineClear);
   DEF_OP(CacheLineClean);
   DEF_OP(CacheLineZero);
+  DEF_OP(MemSet);
+  DEF_OP(MemCpy);
+  DEF_OP(MemCmp);
 
   ///< Misc ops
   DEF_OP(GuestOpcode);
+  DEF_OP(ResumeEntry);
   DEF_OP(Fence);
   DEF_OP(Break);
   DEF_OP(Phi);
@@ -401,6 +418,10 @@ private:
   DEF_OP(VFSub);
   DEF_OP(VFMul);
   DEF_OP(VFDiv);
+  DEF_OP(VFMLA);
+  DEF_OP(VFMLS);
+  DEF_OP(VFNMLA);
+  DEF_OP(VFNMLS);
   DEF_OP(VFMin);
   DEF_OP(VFMax);
   DEF_OP(VFRecp);
@@ -418,6 +439,7 @@ private:
   DEF_OP(VUnZip);
   DEF_OP(VUnZip2);
   DEF_OP(VBSL);
+  DEF_OP(VPCMPXSTRX);
   DEF_OP(VCMPEQ);
   DEF_OP(VCMPEQZ);
   DEF_OP(VCMPGT);
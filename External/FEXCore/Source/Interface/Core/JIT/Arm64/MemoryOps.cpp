@@ -11,6 +11,8 @@ $end_info$
 #include "Interface/Core/JIT/Arm64/JITClass.h"
 #include <FEXCore/Utils/CompilerDefs.h>
 
+#include <bit>
+
 namespace FEXCore::CPU {
 #define DEF_OP(x) void Arm64JITCore::Op_##x(IR::IROp_Header const *IROp, IR::NodeID Node)
 
@@ -1538,6 +1540,282 @@ DEF_OP(CacheLineZero) {
   }
 }
 
+DEF_OP(MemSet) {
+  const auto Op = IROp->C<IR::IROp_MemSet>();
+  const int32_t Size = Op->Size;
+
+  const auto MemReg = GetReg(Op->Addr.ID());
+  const auto Value = GetReg(Op->Value.ID());
+  const auto Length = GetReg(Op->Length.ID());
+  const auto Direction = GetReg(Op->Direction.ID());
+
+  const auto SubRegSize =
+    Size == 1 ? ARMEmitter::SubRegSize::i8Bit :
+    Size == 2 ? ARMEmitter::SubRegSize::i16Bit :
+    Size == 4 ? ARMEmitter::SubRegSize::i32Bit : ARMEmitter::SubRegSize::i64Bit;
+
+  ARMEmitter::ForwardLabel AddrDone;
+  ARMEmitter::BackwardLabel Loop32;
+  ARMEmitter::ForwardLabel Tail;
+  ARMEmitter::BackwardLabel TailLoop;
+  ARMEmitter::ForwardLabel Done;
+
+  // TMP1 = Address, TMP2 = Remaining bytes
+  lsl(ARMEmitter::Size::i64Bit, TMP2, Length, std::countr_zero(static_cast<uint32_t>(Size)));
+  mov(TMP1, MemReg.X());
+
+  // The stores may happen in any order, so a downwards walk fills the same range upwards
+  cbz(ARMEmitter::Size::i64Bit, Direction, &AddrDone);
+  sub(ARMEmitter::Size::i64Bit, TMP1, TMP1, TMP2);
+  add(ARMEmitter::Size::i64Bit, TMP1, TMP1, Size);
+  Bind(&AddrDone);
+
+  if (Op->IsTSO) {
+    // Earlier stores need to be visible before any of ours
+    dmb(FEXCore::ARMEmitter::BarrierScope::ISH);
+  }
+
+  dup(SubRegSize, VTMP1.Q(), Value);
+
+  cmp(ARMEmitter::Size::i64Bit, TMP2, 32);
+  b(ARMEmitter::Condition::CC_LO, &Tail);
+
+  Bind(&Loop32);
+  stp<ARMEmitter::IndexType::POST>(VTMP1.Q(), VTMP1.Q(), TMP1, 32);
+  sub(ARMEmitter::Size::i64Bit, TMP2, TMP2, 32);
+  cmp(ARMEmitter::Size::i64Bit, TMP2, 32);
+  b(ARMEmitter::Condition::CC_HS, &Loop32);
+
+  Bind(&Tail);
+  cbz(ARMEmitter::Size::i64Bit, TMP2, &Done);
+
+  Bind(&TailLoop);
+  switch (Size) {
+    case 1:
+      strb<ARMEmitter::IndexType::POST>(Value, TMP1, 1);
+      break;
+    case 2:
+      strh<ARMEmitter::IndexType::POST>(Value, TMP1, 2);
+      break;
+    case 4:
+      str<ARMEmitter::IndexType::POST>(Value.W(), TMP1, 4);
+      break;
+    case 8:
+      str<ARMEmitter::IndexType::POST>(Value.X(), TMP1, 8);
+      break;
+    default:
+      LOGMAN_MSG_A_FMT("Unhandled MemSet size: {}", Size);
+      break;
+  }
+  sub(ARMEmitter::Size::i64Bit, TMP2, TMP2, Size);
+  cbnz(ARMEmitter::Size::i64Bit, TMP2, &TailLoop);
+
+  Bind(&Done);
+  if (Op->IsTSO) {
+    dmb(FEXCore::ARMEmitter::BarrierScope::ISH);
+  }
+}
+
+DEF_OP(MemCpy) {
+  const auto Op = IROp->C<IR::IROp_MemCpy>();
+  const int32_t Size = Op->Size;
+
+  const auto Dest = GetReg(Op->Dest.ID());
+  const auto Src = GetReg(Op->Src.ID());
+  const auto Length = GetReg(Op->Length.ID());
+  const auto Direction = GetReg(Op->Direction.ID());
+
+  ARMEmitter::ForwardLabel AddrDone;
+  ARMEmitter::BackwardLabel Loop32;
+  ARMEmitter::ForwardLabel Tail;
+  ARMEmitter::BackwardLabel TailLoop;
+  ARMEmitter::ForwardLabel Done;
+
+  // TMP1 = Dest, TMP2 = Src, TMP3 = Remaining bytes, TMP4 = Tail element
+  lsl(ARMEmitter::Size::i64Bit, TMP3, Length, std::countr_zero(static_cast<uint32_t>(Size)));
+  mov(TMP1, Dest.X());
+  mov(TMP2, Src.X());
+
+  // The ranges don't overlap, so a downwards walk copies the same ranges upwards
+  cbz(ARMEmitter::Size::i64Bit, Direction, &AddrDone);
+  sub(ARMEmitter::Size::i64Bit, TMP1, TMP1, TMP3);
+  add(ARMEmitter::Size::i64Bit, TMP1, TMP1, Size);
+  sub(ARMEmitter::Size::i64Bit, TMP2, TMP2, TMP3);
+  add(ARMEmitter::Size::i64Bit, TMP2, TMP2, Size);
+  Bind(&AddrDone);
+
+  if (Op->IsTSO) {
+    // Earlier stores need to be visible before any of ours
+    dmb(FEXCore::ARMEmitter::BarrierScope::ISH);
+  }
+
+  cmp(ARMEmitter::Size::i64Bit, TMP3, 32);
+  b(ARMEmitter::Condition::CC_LO, &Tail);
+
+  Bind(&Loop32);
+  ldp<ARMEmitter::IndexType::POST>(VTMP1.Q(), VTMP2.Q(), TMP2, 32);
+  stp<ARMEmitter::IndexType::POST>(VTMP1.Q(), VTMP2.Q(), TMP1, 32);
+  sub(ARMEmitter::Size::i64Bit, TMP3, TMP3, 32);
+  cmp(ARMEmitter::Size::i64Bit, TMP3, 32);
+  b(ARMEmitter::Condition::CC_HS, &Loop32);
+
+  Bind(&Tail);
+  cbz(ARMEmitter::Size::i64Bit, TMP3, &Done);
+
+  Bind(&TailLoop);
+  switch (Size) {
+    case 1:
+      ldrb<ARMEmitter::IndexType::POST>(TMP4, TMP2, 1);
+      strb<ARMEmitter::IndexType::POST>(TMP4, TMP1, 1);
+      break;
+    case 2:
+      ldrh<ARMEmitter::IndexType::POST>(TMP4, TMP2, 2);
+      strh<ARMEmitter::IndexType::POST>(TMP4, TMP1, 2);
+      break;
+    case 4:
+      ldr<ARMEmitter::IndexType::POST>(TMP4.W(), TMP2, 4);
+      str<ARMEmitter::IndexType::POST>(TMP4.W(), TMP1, 4);
+      break;
+    case 8:
+      ldr<ARMEmitter::IndexType::POST>(TMP4, TMP2, 8);
+      str<ARMEmitter::IndexType::POST>(TMP4, TMP1, 8);
+      break;
+    default:
+      LOGMAN_MSG_A_FMT("Unhandled MemCpy size: {}", Size);
+      break;
+  }
+  sub(ARMEmitter::Size::i64Bit, TMP3, TMP3, Size);
+  cbnz(ARMEmitter::Size::i64Bit, TMP3, &TailLoop);
+
+  Bind(&Done);
+  if (Op->IsTSO) {
+    dmb(FEXCore::ARMEmitter::BarrierScope::ISH);
+  }
+}
+
+DEF_OP(MemCmp) {
+  const auto Op = IROp->C<IR::IROp_MemCmp>();
+  const int32_t Size = Op->Size;
+
+  const auto Dst = GetReg(Node);
+  const auto Src1 = GetReg(Op->Src1.ID());
+  const auto Src2 = GetReg(Op->Src2.ID());
+  const auto Length = GetReg(Op->Length.ID());
+  const auto Direction = GetReg(Op->Direction.ID());
+
+  ARMEmitter::ForwardLabel Done;
+
+  // TMP1 = Src1, TMP2 = Src2, TMP3 = Remaining elements, TMP4 = Element difference
+  mov(TMP1, Src1.X());
+  mov(TMP2, Src2.X());
+  mov(TMP3, Length.X());
+
+  if (Op->IsTSO) {
+    // Loads can't be satisfied before earlier loads and stores to other addresses
+    dmb(FEXCore::ARMEmitter::BarrierScope::ISH);
+  }
+
+  // Loads the next element pair and leaves their difference in TMP4, one element is consumed
+  auto CompareElement = [&](int32_t Step) {
+    switch (Size) {
+      case 1:
+        ldrb<ARMEmitter::IndexType::POST>(VTMP1, TMP1, Step);
+        ldrb<ARMEmitter::IndexType::POST>(VTMP2, TMP2, Step);
+        break;
+      case 2:
+        ldrh<ARMEmitter::IndexType::POST>(VTMP1, TMP1, Step);
+        ldrh<ARMEmitter::IndexType::POST>(VTMP2, TMP2, Step);
+        break;
+      case 4:
+        ldr<ARMEmitter::IndexType::POST>(VTMP1.S(), TMP1, Step);
+        ldr<ARMEmitter::IndexType::POST>(VTMP2.S(), TMP2, Step);
+        break;
+      case 8:
+        ldr<ARMEmitter::IndexType::POST>(VTMP1.D(), TMP1, Step);
+        ldr<ARMEmitter::IndexType::POST>(VTMP2.D(), TMP2, Step);
+        break;
+      default:
+        LOGMAN_MSG_A_FMT("Unhandled MemCmp size: {}", Size);
+        break;
+    }
+
+    // Scalar loads zero the rest of the register
+    eor(VTMP1.D(), VTMP1.D(), VTMP2.D());
+    fmov(ARMEmitter::Size::i64Bit, TMP4, VTMP1.D());
+    sub(ARMEmitter::Size::i64Bit, TMP3, TMP3, 1);
+  };
+
+  // Compares one element pair at a time until the repeat ends
+  auto CompareElements = [&](int32_t Step) {
+    ARMEmitter::BackwardLabel Loop;
+    Bind(&Loop);
+    cbz(ARMEmitter::Size::i64Bit, TMP3, &Done);
+
+    CompareElement(Step);
+
+    if (Op->RepeatWhileEqual) {
+      cbz(ARMEmitter::Size::i64Bit, TMP4, &Loop);
+    }
+    else {
+      cbnz(ARMEmitter::Size::i64Bit, TMP4, &Loop);
+    }
+    b(&Done);
+  };
+
+  if (Op->RepeatWhileEqual) {
+    // Upwards walks skip over equal 16 byte blocks, the element loop finds the exact element in a mismatching one.
+    // The guest only touches memory up to the first mismatch, which can sit right before an unmapped page.
+    // So a block is only loaded whole if neither side of it crosses a page, otherwise one element is compared
+    ARMEmitter::ForwardLabel Elements;
+    ARMEmitter::ForwardLabel SingleElement;
+    ARMEmitter::BackwardLabel Loop16;
+    const uint32_t BlockElements = 16 / Size;
+
+    cbnz(ARMEmitter::Size::i64Bit, Direction, &Elements);
+
+    Bind(&Loop16);
+    cmp(ARMEmitter::Size::i64Bit, TMP3, BlockElements);
+    b(ARMEmitter::Condition::CC_LO, &Elements);
+    and_(ARMEmitter::Size::i64Bit, TMP4, TMP1, 0xFFF);
+    cmp(ARMEmitter::Size::i64Bit, TMP4, 0xFF0);
+    b(ARMEmitter::Condition::CC_HI, &SingleElement);
+    and_(ARMEmitter::Size::i64Bit, TMP4, TMP2, 0xFFF);
+    cmp(ARMEmitter::Size::i64Bit, TMP4, 0xFF0);
+    b(ARMEmitter::Condition::CC_HI, &SingleElement);
+    ldr(VTMP1.Q(), TMP1, 0);
+    ldr(VTMP2.Q(), TMP2, 0);
+    cmeq(ARMEmitter::SubRegSize::i8Bit, VTMP1.Q(), VTMP1.Q(), VTMP2.Q());
+    uminv(ARMEmitter::SubRegSize::i8Bit, VTMP1.Q(), VTMP1.Q());
+    umov<ARMEmitter::SubRegSize::i8Bit>(TMP4, VTMP1, 0);
+    cmp(ARMEmitter::Size::i32Bit, TMP4, 0xFF);
+    b(ARMEmitter::Condition::CC_NE, &Elements);
+    add(ARMEmitter::Size::i64Bit, TMP1, TMP1, 16);
+    add(ARMEmitter::Size::i64Bit, TMP2, TMP2, 16);
+    sub(ARMEmitter::Size::i64Bit, TMP3, TMP3, BlockElements);
+    b(&Loop16);
+
+    // Steps towards the page boundary, the 16 byte blocks resume once both sides are past it
+    Bind(&SingleElement);
+    CompareElement(Size);
+    cbz(ARMEmitter::Size::i64Bit, TMP4, &Loop16);
+    b(&Done);
+
+    Bind(&Elements);
+  }
+
+  ARMEmitter::ForwardLabel Downwards;
+  cbnz(ARMEmitter::Size::i64Bit, Direction, &Downwards);
+  CompareElements(Size);
+  Bind(&Downwards);
+  CompareElements(-Size);
+
+  Bind(&Done);
+  if (Op->IsTSO) {
+    dmb(FEXCore::ARMEmitter::BarrierScope::ISH);
+  }
+  sub(ARMEmitter::Size::i64Bit, Dst, Length, TMP3);
+}
+
 #undef DEF_OP
 }
 
@@ -18,6 +18,29 @@ DEF_OP(GuestOpcode) {
   DebugData->GuestOpcodes.push_back({Op->GuestEntryOffset, GetCursorAddress<uint8_t*>() - GuestEntry});
 }
 
+DEF_OP(ResumeEntry) {
+  auto Op = IROp->C<IR::IROp_ResumeEntry>();
+
+  // Entering here skips the GDB pause check at the top of the function
+  if (!DebugData || GDBEnabled) {
+    return;
+  }
+
+  // The dispatcher enters through the same path as the top of the function, so the spill slots need setting up
+  // Branches from inside the function already have them and skip over it
+  ARMEmitter::ForwardLabel BlockCode;
+  if (SpillSlots) {
+    b(&BlockCode);
+  }
+
+  DebugData->ResumeEntries.push_back({Op->GuestEntryOffset, GetCursorAddress<uint8_t*>() - GuestEntry});
+
+  if (SpillSlots) {
+    AllocateStack();
+    Bind(&BlockCode);
+  }
+}
+
 DEF_OP(Fence) {
   auto Op = IROp->C<IR::IROp_Fence>();
   switch (Op->Fence) {
@@ -746,6 +746,250 @@ DEF_OP(VFDiv) {
   }
 }
 
+DEF_OP(VFMLA) {
+  const auto Op = IROp->C<IR::IROp_VFMLA>();
+  const auto OpSize = IROp->Size;
+
+  const auto ElementSize = Op->Header.ElementSize;
+  const auto IsScalar = ElementSize == OpSize;
+  const auto Is256Bit = OpSize == Core::CPUState::XMM_AVX_REG_SIZE;
+
+  const auto Dst = GetVReg(Node);
+  const auto Vector1 = GetVReg(Op->Vector1.ID());
+  const auto Vector2 = GetVReg(Op->Vector2.ID());
+  const auto Addend = GetVReg(Op->Addend.ID());
+
+  LOGMAN_THROW_AA_FMT(ElementSize == 2 || ElementSize == 4 || ElementSize == 8, "Invalid size");
+  const auto SubRegSize =
+    ElementSize == 2 ? ARMEmitter::SubRegSize::i16Bit :
+    ElementSize == 4 ? ARMEmitter::SubRegSize::i32Bit :
+    ElementSize == 8 ? ARMEmitter::SubRegSize::i64Bit : ARMEmitter::SubRegSize::i8Bit;
+
+  if (IsScalar) {
+    switch (ElementSize) {
+      case 2: {
+        fmadd(Dst.H(), Vector1.H(), Vector2.H(), Addend.H());
+        break;
+      }
+      case 4: {
+        fmadd(Dst.S(), Vector1.S(), Vector2.S(), Addend.S());
+        break;
+      }
+      case 8: {
+        fmadd(Dst.D(), Vector1.D(), Vector2.D(), Addend.D());
+        break;
+      }
+      default:
+        LOGMAN_MSG_A_FMT("Unknown Element Size: {}", ElementSize);
+        break;
+    }
+    return;
+  }
+
+  // The vector forms accumulate in to the destination, so only use it directly when it doesn't alias a multiplicand.
+  const auto Tmp = (Dst.Idx() == Vector1.Idx() || Dst.Idx() == Vector2.Idx()) ? VTMP1 : Dst;
+
+  if (HostSupportsSVE && Is256Bit) {
+    const auto Mask = PRED_TMP_32B.Merging();
+
+    movprfx(Tmp.Z(), Addend.Z());
+    fmla(SubRegSize, Tmp.Z(), Mask, Vector1.Z(), Vector2.Z());
+    if (Tmp.Idx() != Dst.Idx()) {
+      mov(Dst.Z(), Tmp.Z());
+    }
+  } else {
+    if (Tmp.Idx() != Addend.Idx()) {
+      mov(Tmp.Q(), Addend.Q());
+    }
+    fmla(SubRegSize, Tmp.Q(), Vector1.Q(), Vector2.Q());
+    if (Tmp.Idx() != Dst.Idx()) {
+      mov(Dst.Q(), Tmp.Q());
+    }
+  }
+}
+
+DEF_OP(VFMLS) {
+  const auto Op = IROp->C<IR::IROp_VFMLS>();
+  const auto OpSize = IROp->Size;
+
+  const auto ElementSize = Op->Header.ElementSize;
+  const auto IsScalar = ElementSize == OpSize;
+  const auto Is256Bit = OpSize == Core::CPUState::XMM_AVX_REG_SIZE;
+
+  const auto Dst = GetVReg(Node);
+  const auto Vector1 = GetVReg(Op->Vector1.ID());
+  const auto Vector2 = GetVReg(Op->Vector2.ID());
+  const auto Addend = GetVReg(Op->Addend.ID());
+
+  LOGMAN_THROW_AA_FMT(ElementSize == 2 || ElementSize == 4 || ElementSize == 8, "Invalid size");
+  const auto SubRegSize =
+    ElementSize == 2 ? ARMEmitter::SubRegSize::i16Bit :
+    ElementSize == 4 ? ARMEmitter::SubRegSize::i32Bit :
+    ElementSize == 8 ? ARMEmitter::SubRegSize::i64Bit : ARMEmitter::SubRegSize::i8Bit;
+
+  if (IsScalar) {
+    switch (ElementSize) {
+      case 2: {
+        fnmsub(Dst.H(), Vector1.H(), Vector2.H(), Addend.H());
+        break;
+      }
+      case 4: {
+        fnmsub(Dst.S(), Vector1.S(), Vector2.S(), Addend.S());
+        break;
+      }
+      case 8: {
+        fnmsub(Dst.D(), Vector1.D(), Vector2.D(), Addend.D());
+        break;
+      }
+      default:
+        LOGMAN_MSG_A_FMT("Unknown Element Size: {}", ElementSize);
+        break;
+    }
+    return;
+  }
+
+  // The vector forms accumulate in to the destination, so only use it directly when it doesn't alias a multiplicand.
+  const auto Tmp = (Dst.Idx() == Vector1.Idx() || Dst.Idx() == Vector2.Idx()) ? VTMP1 : Dst;
+
+  if (HostSupportsSVE && Is256Bit) {
+    const auto Mask = PRED_TMP_32B.Merging();
+
+    movprfx(Tmp.Z(), Addend.Z());
+    fnmls(SubRegSize, Tmp.Z(), Mask, Vector1.Z(), Vector2.Z());
+    if (Tmp.Idx() != Dst.Idx()) {
+      mov(Dst.Z(), Tmp.Z());
+    }
+  } else {
+    fneg(SubRegSize, Tmp.Q(), Addend.Q());
+    fmla(SubRegSize, Tmp.Q(), Vector1.Q(), Vector2.Q());
+    if (Tmp.Idx() != Dst.Idx()) {
+      mov(Dst.Q(), Tmp.Q());
+    }
+  }
+}
+
+DEF_OP(VFNMLA) {
+  const auto Op = IROp->C<IR::IROp_VFNMLA>();
+  const auto OpSize = IROp->Size;
+
+  const auto ElementSize = Op->Header.ElementSize;
+  const auto IsScalar = ElementSize == OpSize;
+  const auto Is256Bit = OpSize == Core::CPUState::XMM_AVX_REG_SIZE;
+
+  const auto Dst = GetVReg(Node);
+  const auto Vector1 = GetVReg(Op->Vector1.ID());
+  const auto Vector2 = GetVReg(Op->Vector2.ID());
+  const auto Addend = GetVReg(Op->Addend.ID());
+
+  LOGMAN_THROW_AA_FMT(ElementSize == 2 || ElementSize == 4 || ElementSize == 8, "Invalid size");
+  const auto SubRegSize =
+    ElementSize == 2 ? ARMEmitter::SubRegSize::i16Bit :
+    ElementSize == 4 ? ARMEmitter::SubRegSize::i32Bit :
+    ElementSize == 8 ? ARMEmitter::SubRegSize::i64Bit : ARMEmitter::SubRegSize::i8Bit;
+
+  if (IsScalar) {
+    switch (ElementSize) {
+      case 2: {
+        fmsub(Dst.H(), Vector1.H(), Vector2.H(), Addend.H());
+        break;
+      }
+      case 4: {
+        fmsub(Dst.S(), Vector1.S(), Vector2.S(), Addend.S());
+        break;
+      }
+      case 8: {
+        fmsub(Dst.D(), Vector1.D(), Vector2.D(), Addend.D());
+        break;
+      }
+      default:
+        LOGMAN_MSG_A_FMT("Unknown Element Size: {}", ElementSize);
+        break;
+    }
+    return;
+  }
+
+  // The vector forms accumulate in to the destination, so only use it directly when it doesn't alias a multiplicand.
+  const auto Tmp = (Dst.Idx() == Vector1.Idx() || Dst.Idx() == Vector2.Idx()) ? VTMP1 : Dst;
+
+  if (HostSupportsSVE && Is256Bit) {
+    const auto Mask = PRED_TMP_32B.Merging();
+
+    movprfx(Tmp.Z(), Addend.Z());
+    fmls(SubRegSize, Tmp.Z(), Mask, Vector1.Z(), Vector2.Z());
+    if (Tmp.Idx() != Dst.Idx()) {
+      mov(Dst.Z(), Tmp.Z());
+    }
+  } else {
+    if (Tmp.Idx() != Addend.Idx()) {
+      mov(Tmp.Q(), Addend.Q());
+    }
+    fmls(SubRegSize, Tmp.Q(), Vector1.Q(), Vector2.Q());
+    if (Tmp.Idx() != Dst.Idx()) {
+      mov(Dst.Q(), Tmp.Q());
+    }
+  }
+}
+
+DEF_OP(VFNMLS) {
+  const auto Op = IROp->C<IR::IROp_VFNMLS>();
+  const auto OpSize = IROp->Size;
+
+  const auto ElementSize = Op->Header.ElementSize;
+  const auto IsScalar = ElementSize == OpSize;
+  const auto Is256Bit = OpSize == Core::CPUState::XMM_AVX_REG_SIZE;
+
+  const auto Dst = GetVReg(Node);
+  const auto Vector1 = GetVReg(Op->Vector1.ID());
+  const auto Vector2 = GetVReg(Op->Vector2.ID());
+  const auto Addend = GetVReg(Op->Addend.ID());
+
+  LOGMAN_THROW_AA_FMT(ElementSize == 2 || ElementSize == 4 || ElementSize == 8, "Invalid size");
+  const auto SubRegSize =
+    ElementSize == 2 ? ARMEmitter::SubRegSize::i16Bit :
+    ElementSize == 4 ? ARMEmitter::SubRegSize::i32Bit :
+    ElementSize == 8 ? ARMEmitter::SubRegSize::i64Bit : ARMEmitter::SubRegSize::i8Bit;
+
+  if (IsScalar) {
+    switch (ElementSize) {
+      case 2: {
+        fnmadd(Dst.H(), Vector1.H(), Vector2.H(), Addend.H());
+        break;
+      }
+      case 4: {
+        fnmadd(Dst.S(), Vector1.S(), Vector2.S(), Addend.S());
+        break;
+      }
+      case 8: {
+        fnmadd(Dst.D(), Vector1.D(), Vector2.D(), Addend.D());
+        break;
+      }
+      default:
+        LOGMAN_MSG_A_FMT("Unknown Element Size: {}", ElementSize);
+        break;
+    }
+    return;
+  }
+
+  // The vector forms accumulate in to the destination, so only use it directly when it doesn't alias a multiplicand.
+  const auto Tmp = (Dst.Idx() == Vector1.Idx() || Dst.Idx() == Vector2.Idx()) ? VTMP1 : Dst;
+
+  if (HostSupportsSVE && Is256Bit) {
+    const auto Mask = PRED_TMP_32B.Merging();
+
+    movprfx(Tmp.Z(), Addend.Z());
+    fnmla(SubRegSize, Tmp.Z(), Mask, Vector1.Z(), Vector2.Z());
+    if (Tmp.Idx() != Dst.Idx()) {
+      mov(Dst.Z(), Tmp.Z());
+    }
+  } else {
+    fneg(SubRegSize, Tmp.Q(), Addend.Q());
+    fmls(SubRegSize, Tmp.Q(), Vector1.Q(), Vector2.Q());
+    if (Tmp.Idx() != Dst.Idx()) {
+      mov(Dst.Q(), Tmp.Q());
+    }
+  }
+}
+
 DEF_OP(VFMin) {
   const auto Op = IROp->C<IR::IROp_VFMin>();
   const auto OpSize = IROp->Size;
@@ -1440,6 +1684,140 @@ DEF_OP(VBSL) {
   }
 }
 
+DEF_OP(VPCMPXSTRX) {
+  const auto Op = IROp->C<IR::IROp_VPCMPXSTRX>();
+  const auto Control = Op->Control;
+
+  const auto Dst = GetReg(Node);
+  const auto LHS = GetVReg(Op->LHS.ID());
+  const auto RHS = GetVReg(Op->RHS.ID());
+  const auto LHSLength = GetReg(Op->LHSLength.ID());
+  const auto RHSLength = GetReg(Op->RHSLength.ID());
+
+  const bool IsWord = (Control & 1) != 0;
+  const bool IsSigned = (Control & 2) != 0;
+  const uint32_t ElementSize = IsWord ? 2 : 1;
+  const uint32_t NumElements = 16 / ElementSize;
+  const auto SubRegSize = IsWord ? ARMEmitter::SubRegSize::i16Bit : ARMEmitter::SubRegSize::i8Bit;
+
+  // VTMP1 = Valid RHS elements, VTMP2 = IntRes1, VTMP3/VTMP4 = Scratch
+  const auto RHSValid = VTMP1.Q();
+  const auto Result = VTMP2.Q();
+
+  // Lanes below the length are valid
+  LoadConstant(ARMEmitter::Size::i64Bit, TMP1, IsWord ? 0x0003'0002'0001'0000ULL : 0x0706'0504'0302'0100ULL);
+  LoadConstant(ARMEmitter::Size::i64Bit, TMP2, IsWord ? 0x0007'0006'0005'0004ULL : 0x0F0E'0D0C'0B0A'0908ULL);
+  ins(ARMEmitter::SubRegSize::i64Bit, VTMP3, 0, TMP1);
+  ins(ARMEmitter::SubRegSize::i64Bit, VTMP3, 1, TMP2);
+  dup(SubRegSize, RHSValid, RHSLength);
+  cmhi(SubRegSize, RHSValid, RHSValid, VTMP3.Q());
+
+  // Walking the LHS elements stops at the LHS length, invalid LHS elements never change the result
+  ARMEmitter::ForwardLabel Done;
+
+  switch ((Control >> 2) & 0b11) {
+    case 0b00: {
+      // Equal any: Each RHS element is compared against every LHS element
+      eor(Result, Result, Result);
+      for (uint32_t i = 0; i < NumElements; ++i) {
+        cmp(ARMEmitter::Size::i64Bit, LHSLength, i);
+        b(ARMEmitter::Condition::CC_LS, &Done);
+        dup(SubRegSize, VTMP3.Q(), LHS.Q(), i);
+        cmeq(SubRegSize, VTMP3.Q(), VTMP3.Q(), RHS.Q());
+        orr(Result, Result, VTMP3.Q());
+      }
+      Bind(&Done);
+      and_(Result, Result, RHSValid);
+      break;
+    }
+    case 0b01: {
+      // Ranges: Each RHS element is checked against every pair of LHS elements
+      eor(Result, Result, Result);
+      for (uint32_t i = 0; i < NumElements; i += 2) {
+        cmp(ARMEmitter::Size::i64Bit, LHSLength, i + 1);
+        b(ARMEmitter::Condition::CC_LS, &Done);
+        dup(SubRegSize, VTMP3.Q(), LHS.Q(), i);
+        dup(SubRegSize, VTMP4.Q(), LHS.Q(), i + 1);
+        if (IsSigned) {
+          cmge(SubRegSize, VTMP3.Q(), RHS.Q(), VTMP3.Q());
+          cmge(SubRegSize, VTMP4.Q(), VTMP4.Q(), RHS.Q());
+        }
+        else {
+          cmhs(SubRegSize, VTMP3.Q(), RHS.Q(), VTMP3.Q());
+          cmhs(SubRegSize, VTMP4.Q(), VTMP4.Q(), RHS.Q());
+        }
+        and_(VTMP3.Q(), VTMP3.Q(), VTMP4.Q());
+        orr(Result, Result, VTMP3.Q());
+      }
+      Bind(&Done);
+      and_(Result, Result, RHSValid);
+      break;
+    }
+    case 0b10: {
+      // Equal each: Elements compare in place, a pair of invalid elements matches and a single invalid element doesn't
+      dup(SubRegSize, VTMP4.Q(), LHSLength);
+      cmhi(SubRegSize, VTMP4.Q(), VTMP4.Q(), VTMP3.Q());
+      cmeq(SubRegSize, Result, LHS.Q(), RHS.Q());
+      and_(VTMP3.Q(), VTMP4.Q(), RHSValid);
+      orr(VTMP4.Q(), VTMP4.Q(), RHSValid);
+      and_(Result, Result, VTMP3.Q());
+      orn(Result, Result, VTMP4.Q());
+      break;
+    }
+    case 0b11: {
+      // Equal ordered: Every RHS element starts a substring match of the LHS
+      // LHS element k is compared against the RHS shifted down by k elements, lanes shifted past the end always match
+      movi(ARMEmitter::SubRegSize::i8Bit, VTMP4.Q(), 0xFF);
+      mov(Result, VTMP4.Q());
+      for (uint32_t k = 0; k < NumElements; ++k) {
+        cmp(ARMEmitter::Size::i64Bit, LHSLength, k);
+        b(ARMEmitter::Condition::CC_LS, &Done);
+        dup(SubRegSize, VTMP3.Q(), LHS.Q(), k);
+        cmeq(SubRegSize, VTMP3.Q(), VTMP3.Q(), RHS.Q());
+        and_(VTMP3.Q(), VTMP3.Q(), RHSValid);
+        if (k != 0) {
+          ext(VTMP3.Q(), VTMP3.Q(), VTMP4.Q(), k * ElementSize);
+        }
+        and_(Result, Result, VTMP3.Q());
+      }
+      Bind(&Done);
+      break;
+    }
+  }
+
+  switch ((Control >> 4) & 0b11) {
+    case 0b01:
+      // Negative polarity
+      mvn(ARMEmitter::SubRegSize::i8Bit, Result, Result);
+      break;
+    case 0b11:
+      // Masked negative polarity only inverts the valid RHS elements
+      eor(Result, Result, RHSValid);
+      break;
+    default:
+      break;
+  }
+
+  // Gather one bit per element, each element keeps its own bit and a horizontal add combines them
+  if (IsWord) {
+    LoadConstant(ARMEmitter::Size::i64Bit, TMP1, 0x0008'0004'0002'0001ULL);
+    LoadConstant(ARMEmitter::Size::i64Bit, TMP2, 0x0080'0040'0020'0010ULL);
+    ins(ARMEmitter::SubRegSize::i64Bit, VTMP3, 0, TMP1);
+    ins(ARMEmitter::SubRegSize::i64Bit, VTMP3, 1, TMP2);
+    and_(Result, Result, VTMP3.Q());
+  }
+  else {
+    // The upper eight bytes are interleaved with the lower eight so each 16-bit lane holds both halves of the mask
+    LoadConstant(ARMEmitter::Size::i64Bit, TMP1, 0x8040'2010'0804'0201ULL);
+    dup(ARMEmitter::SubRegSize::i64Bit, VTMP3.Q(), TMP1);
+    and_(Result, Result, VTMP3.Q());
+    ext(VTMP3.Q(), Result, Result, 8);
+    zip1(ARMEmitter::SubRegSize::i8Bit, Result, Result, VTMP3.Q());
+  }
+  addv(ARMEmitter::SubRegSize::i16Bit, Result, Result);
+  umov<ARMEmitter::SubRegSize::i16Bit>(Dst, VTMP2, 0);
+}
+
 DEF_OP(VCMPEQ) {
   const auto Op = IROp->C<IR::IROp_VCMPEQ>();
   const auto OpSize = IROp->Size;
@@ -2012,11 +2390,88 @@ DEF_OP(VFCMPUNO) {
 }
 
 DEF_OP(VUShl) {
-  LOGMAN_MSG_A_FMT("Unimplemented");
+  const auto Op = IROp->C<IR::IROp_VUShl>();
+  const auto OpSize = IROp->Size;
+
+  const auto ElementSize = IROp->ElementSize;
+  const auto Is256Bit = OpSize == Core::CPUState::XMM_AVX_REG_SIZE;
+  const auto MaxShift = (ElementSize * 8) - 1;
+
+  const auto Dst = GetVReg(Node);
+  const auto ShiftVector = GetVReg(Op->ShiftVector.ID());
+  const auto Vector = GetVReg(Op->Vector.ID());
+
+  LOGMAN_THROW_AA_FMT(ElementSize == 1 || ElementSize == 2 || ElementSize == 4 || ElementSize == 8, "Invalid size");
+  const auto SubRegSize =
+    ElementSize == 1 ? ARMEmitter::SubRegSize::i8Bit :
+    ElementSize == 2 ? ARMEmitter::SubRegSize::i16Bit :
+    ElementSize == 4 ? ARMEmitter::SubRegSize::i32Bit :
+    ElementSize == 8 ? ARMEmitter::SubRegSize::i64Bit : ARMEmitter::SubRegSize::i8Bit;
+
+  if (HostSupportsSVE && Is256Bit) {
+    const auto Mask = PRED_TMP_32B.Merging();
+
+    // SVE LSL treats the whole shift element as unsigned, so shifts
+    // past the element size already produce zero like x86 does.
+    movprfx(VTMP1.Z(), Vector.Z());
+    lsl(SubRegSize, VTMP1.Z(), Mask, VTMP1.Z(), ShiftVector.Z());
+    mov(Dst.Z(), VTMP1.Z());
+  } else {
+    // USHL only looks at the bottom byte of each shift element,
+    // so anything larger than the element size is cleared separately.
+    if (ElementSize == 8) {
+      LoadConstant(ARMEmitter::Size::i64Bit, TMP1, MaxShift);
+      dup(SubRegSize, VTMP1.Q(), TMP1.R());
+    } else {
+      movi(SubRegSize, VTMP1.Q(), MaxShift);
+    }
+    cmhi(SubRegSize, VTMP1.Q(), ShiftVector.Q(), VTMP1.Q());
+
+    ushl(SubRegSize, VTMP2.Q(), Vector.Q(), ShiftVector.Q());
+    bic(Dst.Q(), VTMP2.Q(), VTMP1.Q());
+  }
 }
 
 DEF_OP(VUShr) {
-  LOGMAN_MSG_A_FMT("Unimplemented");
+  const auto Op = IROp->C<IR::IROp_VUShr>();
+  const auto OpSize = IROp->Size;
+
+  const auto ElementSize = IROp->ElementSize;
+  const auto Is256Bit = OpSize == Core::CPUState::XMM_AVX_REG_SIZE;
+  const auto MaxShift = (ElementSize * 8) - 1;
+
+  const auto Dst = GetVReg(Node);
+  const auto ShiftVector = GetVReg(Op->ShiftVector.ID());
+  const auto Vector = GetVReg(Op->Vector.ID());
+
+  LOGMAN_THROW_AA_FMT(ElementSize == 1 || ElementSize == 2 || ElementSize == 4 || ElementSize == 8, "Invalid size");
+  const auto SubRegSize =
+    ElementSize == 1 ? ARMEmitter::SubRegSize::i8Bit :
+    ElementSize == 2 ? ARMEmitter::SubRegSize::i16Bit :
+    ElementSize == 4 ? ARMEmitter::SubRegSize::i32Bit :
+    ElementSize == 8 ? ARMEmitter::SubRegSize::i64Bit : ARMEmitter::SubRegSize::i8Bit;
+
+  if (HostSupportsSVE && Is256Bit) {
+    const auto Mask = PRED_TMP_32B.Merging();
+
+    movprfx(VTMP1.Z(), Vector.Z());
+    lsr(SubRegSize, VTMP1.Z(), Mask, VTMP1.Z(), ShiftVector.Z());
+    mov(Dst.Z(), VTMP1.Z());
+  } else {
+    if (ElementSize == 8) {
+      LoadConstant(ARMEmitter::Size::i64Bit, TMP1, MaxShift);
+      dup(SubRegSize, VTMP1.Q(), TMP1.R());
+    } else {
+      movi(SubRegSize, VTMP1.Q(), MaxShift);
+    }
+    cmhi(SubRegSize, VTMP1.Q(), ShiftVector.Q(), VTMP1.Q());
+
+    // Need to invert shift values to perform a right shift with USHL
+    // (USHR only has an immediate variant).
+    neg(SubRegSize, VTMP2.Q(), ShiftVector.Q());
+    ushl(SubRegSize, VTMP2.Q(), Vector.Q(), VTMP2.Q());
+    bic(Dst.Q(), VTMP2.Q(), VTMP1.Q());
+  }
 }
 
 DEF_OP(VSShr) {
@@ -44,14 +44,7 @@ DEF_OP(Constant) {
 DEF_OP(EntrypointOffset) {
   auto Op = IROp->C<IR::IROp_EntrypointOffset>();
 
-  auto Constant = Entry + Op->Offset;
-  uint64_t Mask = ~0ULL;
-  uint8_t OpSize = IROp->Size;
-  if (OpSize == 4) {
-    Mask = 0xFFFF'FFFFULL;
-  }
-
-  mov(GetDst<RA_64>(Node), Constant & Mask);
+  InsertGuestRIPMove(GetDst<RA_64>(Node), Op->Offset, IROp->Size);
 }
 
 DEF_OP(InlineConstant) {
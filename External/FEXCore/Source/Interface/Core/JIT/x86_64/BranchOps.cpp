@@ -83,18 +83,22 @@ DEF_OP(ExitFunction) {
 
   uint64_t NewRIP;
 
-  if (IsInlineConstant(Op->NewRIP, &NewRIP) || IsInlineEntrypointOffset(Op->NewRIP, &NewRIP)) {
-    Label l_BranchHost;
-    Label l_BranchGuest;
+  const bool IsEntrypointOffset = IsInlineEntrypointOffset(Op->NewRIP, &NewRIP);
+  if (IsInlineConstant(Op->NewRIP, &NewRIP) || IsEntrypointOffset) {
+    auto BranchHost = InsertNamedSymbolLiteral(FEXCore::CPU::RelocNamedSymbolLiteral::NamedSymbol::SYMBOL_LITERAL_EXITFUNCTION_LINKER);
 
-    lea(rax, ptr[rip + l_BranchHost]);
+    lea(rax, ptr[rip + BranchHost.Offset]);
     jmp(qword[rax]);
 
-    L(l_BranchHost);
-    //FEX_TODO(this is not per thread)
-    dq(ThreadState->CurrentFrame->Pointers.Common.ExitFunctionLinker);
-    L(l_BranchGuest);
-    dq(NewRIP);
+    PlaceNamedSymbolLiteral(BranchHost);
+
+    if (IsEntrypointOffset) {
+      auto InlineOp = IR->GetOp<IR::IROp_InlineEntrypointOffset>(Op->NewRIP);
+      PlaceGuestRIPLiteral(InlineOp->Offset, InlineOp->Header.Size);
+    }
+    else {
+      dq(NewRIP);
+    }
   } else {
     Xbyak::Reg RipReg = GetSrc<RA_64>(Op->NewRIP.ID());
 
@@ -216,18 +220,41 @@ DEF_OP(Thunk) {
   if (NumPush & 1)
     sub(rsp, 8); // Align
 
-  mov(rdi, GetSrc<RA_64>(Op->ArgPtr.ID()));
-
-  auto thunkFn = ThreadState->CTX->ThunkHandler->LookupThunk(Op->ThunkNameHash);
-
-  mov(rax, reinterpret_cast<uintptr_t>(thunkFn));
-  call(rax);
+  // Sources may live in the argument registers, so go through the stack
+  // {rdi, rsi, rdx, rcx, r8, r9}
+  push(GetSrc<RA_64>(Op->ArgPtr.ID()));
+  push(GetSrc<RA_64>(Op->Arg1.ID()));
+  push(GetSrc<RA_64>(Op->Arg2.ID()));
+  push(GetSrc<RA_64>(Op->Arg3.ID()));
+  push(GetSrc<RA_64>(Op->Arg4.ID()));
+  push(GetSrc<RA_64>(Op->Arg5.ID()));
+  pop(r9);
+  pop(r8);
+  pop(rcx);
+  pop(rdx);
+  pop(rsi);
+  pop(rdi);
+
+  // Bound once at compile time, the relocation rebinds it when the code is loaded from a cache
+  InsertNamedThunkRelocation(rax, Op->ThunkNameHash);
+  if (CTX->Config.TSOPageTracking) {
+    // CallThunk gets the host function as its seventh argument, on the stack
+    sub(rsp, 8); // Align
+    push(rax);
+    call(qword [STATE + offsetof(FEXCore::Core::CpuStateFrame, Pointers.Common.CallThunkFunc)]);
+    add(rsp, 16);
+  }
+  else {
+    call(rax);
+  }
 
   if (NumPush & 1)
     add(rsp, 8); // Align
 
   for (uint32_t i = RA64.size(); i > 0; --i)
     pop(RA64[i - 1]);
+
+  mov(GetDst<RA_64>(Node), rax);
 }
 
 DEF_OP(ValidateCode) {
@@ -237,7 +264,7 @@ DEF_OP(ValidateCode) {
   int idx = 0;
 
   xor_(GetDst<RA_64>(Node), GetDst<RA_64>(Node));
-  mov(rax, Entry + Op->Offset);
+  InsertGuestRIPMove(rax, Op->Offset, 8);
   mov(rbx, 1);
   while (len >= 4) {
     cmp(dword[rax + idx], *(const uint32_t*)(OldCode + idx));
@@ -270,7 +297,7 @@ DEF_OP(ThreadRemoveCodeEntry) {
     sub(rsp, 8); // Align
 
   mov(rdi, STATE);
-  mov(rax, Entry); // imm64 move
+  InsertGuestRIPMove(rax, 0, 8);
   mov(rsi, rax);
 
   call(qword [STATE + offsetof(FEXCore::Core::CpuStateFrame, Pointers.Common.ThreadRemoveCodeEntryFromJIT)]);
@@ -297,6 +297,24 @@ DEF_OP(Vector_FToF) {
       }
       break;
     }
+    case 0x0402: { // Float <- Half
+      if (Is256Bit) {
+        vcvtph2ps(ToYMM(Dst), Vector);
+      } else {
+        vcvtph2ps(Dst, Vector);
+      }
+      break;
+    }
+    case 0x0204: { // Half <- Float
+      // Rounding follows MXCSR.RC
+      constexpr uint8_t UseMXCSR = 0b100;
+      if (Is256Bit) {
+        vcvtps2ph(Dst, ToYMM(Vector), UseMXCSR);
+      } else {
+        vcvtps2ph(Dst, Vector, UseMXCSR);
+      }
+      break;
+    }
     default:
       LOGMAN_MSG_A_FMT("Unknown Vector_FToF conversion type : 0x{:04x}", Conv);
       break;
@@ -12,6 +12,7 @@ $end_info$
 #include <FEXCore/Utils/LogManager.h>
 
 #include <array>
+#include <bit>
 #include <stddef.h>
 #include <stdint.h>
 #include <xbyak/xbyak.h>
@@ -803,6 +804,129 @@ DEF_OP(CacheLineZero) {
   }
 }
 
+DEF_OP(MemSet) {
+  const auto Op = IROp->C<IR::IROp_MemSet>();
+  const auto Size = Op->Size;
+
+  const auto MemReg = GetSrc<RA_64>(Op->Addr.ID());
+  const auto Value = GetSrc<RA_64>(Op->Value.ID());
+  const auto Length = GetSrc<RA_64>(Op->Length.ID());
+  const auto Direction = GetSrc<RA_64>(Op->Direction.ID());
+
+  // rep stos takes the address in rdi, the count in rcx and the value in rax
+  mov(TMP4, MemReg);
+  mov(TMP2, Length);
+  mov(TMP1, Value);
+
+  // The stores may happen in any order, so a downwards walk fills the same range upwards
+  Label AddrDone;
+  test(Direction, Direction);
+  jz(AddrDone);
+    lea(TMP3, ptr [TMP2 * Size - Size]);
+    sub(TMP4, TMP3);
+  L(AddrDone);
+
+  rep();
+  switch (Size) {
+    case 1: stosb(); break;
+    case 2: stosw(); break;
+    case 4: stosd(); break;
+    case 8: stosq(); break;
+    default: LOGMAN_MSG_A_FMT("Unhandled MemSet size: {}", Size); break;
+  }
+}
+
+DEF_OP(MemCpy) {
+  const auto Op = IROp->C<IR::IROp_MemCpy>();
+  const auto Size = Op->Size;
+
+  const auto Dest = GetSrc<RA_64>(Op->Dest.ID());
+  const auto Src = GetSrc<RA_64>(Op->Src.ID());
+  const auto Length = GetSrc<RA_64>(Op->Length.ID());
+  const auto Direction = GetSrc<RA_64>(Op->Direction.ID());
+
+  // rep movs takes the addresses in rdi and rsi and the count in rcx
+  mov(TMP4, Dest);
+  mov(TMP1, Src);
+  mov(TMP2, Length);
+
+  // The ranges don't overlap, so a downwards walk copies the same ranges upwards
+  Label AddrDone;
+  test(Direction, Direction);
+  jz(AddrDone);
+    lea(TMP3, ptr [TMP2 * Size - Size]);
+    sub(TMP4, TMP3);
+    sub(TMP1, TMP3);
+  L(AddrDone);
+
+  // Copy bytes, with ERMS this is the fastest form regardless of alignment
+  if (Size != 1) {
+    shl(TMP2, std::countr_zero(static_cast<uint32_t>(Size)));
+  }
+
+  // rsi is allocatable, keep it alive in TMP3
+  mov(TMP3, rsi);
+  mov(rsi, TMP1);
+  rep();
+  movsb();
+  mov(rsi, TMP3);
+}
+
+DEF_OP(MemCmp) {
+  const auto Op = IROp->C<IR::IROp_MemCmp>();
+  const auto Size = Op->Size;
+
+  const auto Src1 = GetSrc<RA_64>(Op->Src1.ID());
+  const auto Src2 = GetSrc<RA_64>(Op->Src2.ID());
+  const auto Length = GetSrc<RA_64>(Op->Length.ID());
+  const auto Direction = GetSrc<RA_64>(Op->Direction.ID());
+
+  // rep cmps takes the addresses in rdi and rsi and the count in rcx
+  mov(TMP4, Src2);
+  mov(TMP2, Length);
+  mov(TMP1, Direction);
+
+  // rsi is allocatable, keep it alive in TMP3
+  mov(TMP3, rsi);
+  mov(rsi, Src1);
+
+  auto CompareElements = [&]() {
+    if (Op->RepeatWhileEqual) {
+      repe();
+    }
+    else {
+      repne();
+    }
+
+    switch (Size) {
+      case 1: cmpsb(); break;
+      case 2: cmpsw(); break;
+      case 4: cmpsd(); break;
+      case 8: cmpsq(); break;
+      default: LOGMAN_MSG_A_FMT("Unhandled MemCmp size: {}", Size); break;
+    }
+  };
+
+  Label Downwards;
+  Label Compared;
+  test(TMP1, TMP1);
+  jnz(Downwards);
+    CompareElements();
+    jmp(Compared);
+  L(Downwards);
+    std();
+    CompareElements();
+    cld();
+  L(Compared);
+
+  mov(rsi, TMP3);
+
+  // rcx is left with the number of elements that weren't compared
+  const auto Dst = GetDst<RA_64>(Node);
+  mov(Dst, Length);
+  sub(Dst, TMP2);
+}
+
 #undef DEF_OP
 void X86JITCore::RegisterMemoryHandlers() {
 #define REGISTER_OP(op, x) OpHandlers[FEXCore::IR::IROps::OP_##op] = &X86JITCore::Op_##x
@@ -823,6 +947,9 @@ void X86JITCore::RegisterMemoryHandlers() {
   REGISTER_OP(CACHELINECLEAR,      CacheLineClear);
   REGISTER_OP(CACHELINECLEAN,      CacheLineClean);
   REGISTER_OP(CACHELINEZERO,       CacheLineZero);
+  REGISTER_OP(MEMSET,              MemSet);
+  REGISTER_OP(MEMCPY,              MemCpy);
+  REGISTER_OP(MEMCMP,              MemCmp);
 #undef REGISTER_OP
 }
 }
@@ -168,6 +168,7 @@ void X86JITCore::RegisterMiscHandlers() {
   REGISTER_OP(BEGINBLOCK, NoOp);
   REGISTER_OP(ENDBLOCK,   NoOp);
   REGISTER_OP(GUESTOPCODE, GuestOpcode);
+  REGISTER_OP(RESUMEENTRY, NoOp);
   REGISTER_OP(FENCE,      Fence);
   REGISTER_OP(BREAK,      Break);
   REGISTER_OP(PHI,        NoOp);
@@ -1026,6 +1026,266 @@ DEF_OP(VFDiv) {
   }
 }
 
+DEF_OP(VFMLA) {
+  const auto Op = IROp->C<IR::IROp_VFMLA>();
+  const auto OpSize = IROp->Size;
+
+  const auto ElementSize = Op->Header.ElementSize;
+  const auto Is256Bit = OpSize == Core::CPUState::XMM_AVX_REG_SIZE;
+  const auto IsScalar = ElementSize == OpSize;
+
+  const auto Dst = GetDst(Node);
+  const auto Vector1 = GetSrc(Op->Vector1.ID());
+  const auto Vector2 = GetSrc(Op->Vector2.ID());
+  const auto Addend = GetSrc(Op->Addend.ID());
+
+  // The 231 form accumulates in to the addend register, work in a temporary so no source gets clobbered.
+  if (Is256Bit) {
+    vmovapd(ToYMM(xmm0), ToYMM(Addend));
+  } else {
+    vmovapd(xmm0, Addend);
+  }
+
+  if (IsScalar) {
+    switch (ElementSize) {
+      case 4: {
+        vfmadd231ss(xmm0, Vector1, Vector2);
+        break;
+      }
+      case 8: {
+        vfmadd231sd(xmm0, Vector1, Vector2);
+        break;
+      }
+      default:
+        LOGMAN_MSG_A_FMT("Unknown Element Size: {}", ElementSize);
+        break;
+    }
+  } else {
+    switch (ElementSize) {
+      case 4: {
+        if (Is256Bit) {
+          vfmadd231ps(ToYMM(xmm0), ToYMM(Vector1), ToYMM(Vector2));
+        } else {
+          vfmadd231ps(xmm0, Vector1, Vector2);
+        }
+        break;
+      }
+      case 8: {
+        if (Is256Bit) {
+          vfmadd231pd(ToYMM(xmm0), ToYMM(Vector1), ToYMM(Vector2));
+        } else {
+          vfmadd231pd(xmm0, Vector1, Vector2);
+        }
+        break;
+      }
+      default:
+        LOGMAN_MSG_A_FMT("Unknown Element Size: {}", ElementSize);
+        break;
+    }
+  }
+
+  if (Is256Bit) {
+    vmovapd(ToYMM(Dst), ToYMM(xmm0));
+  } else {
+    vmovapd(Dst, xmm0);
+  }
+}
+
+DEF_OP(VFMLS) {
+  const auto Op = IROp->C<IR::IROp_VFMLS>();
+  const auto OpSize = IROp->Size;
+
+  const auto ElementSize = Op->Header.ElementSize;
+  const auto Is256Bit = OpSize == Core::CPUState::XMM_AVX_REG_SIZE;
+  const auto IsScalar = ElementSize == OpSize;
+
+  const auto Dst = GetDst(Node);
+  const auto Vector1 = GetSrc(Op->Vector1.ID());
+  const auto Vector2 = GetSrc(Op->Vector2.ID());
+  const auto Addend = GetSrc(Op->Addend.ID());
+
+  // The 231 form accumulates in to the addend register, work in a temporary so no source gets clobbered.
+  if (Is256Bit) {
+    vmovapd(ToYMM(xmm0), ToYMM(Addend));
+  } else {
+    vmovapd(xmm0, Addend);
+  }
+
+  if (IsScalar) {
+    switch (ElementSize) {
+      case 4: {
+        vfmsub231ss(xmm0, Vector1, Vector2);
+        break;
+      }
+      case 8: {
+        vfmsub231sd(xmm0, Vector1, Vector2);
+        break;
+      }
+      default:
+        LOGMAN_MSG_A_FMT("Unknown Element Size: {}", ElementSize);
+        break;
+    }
+  } else {
+    switch (ElementSize) {
+      case 4: {
+        if (Is256Bit) {
+          vfmsub231ps(ToYMM(xmm0), ToYMM(Vector1), ToYMM(Vector2));
+        } else {
+          vfmsub231ps(xmm0, Vector1, Vector2);
+        }
+        break;
+      }
+      case 8: {
+        if (Is256Bit) {
+          vfmsub231pd(ToYMM(xmm0), ToYMM(Vector1), ToYMM(Vector2));
+        } else {
+          vfmsub231pd(xmm0, Vector1, Vector2);
+        }
+        break;
+      }
+      default:
+        LOGMAN_MSG_A_FMT("Unknown Element Size: {}", ElementSize);
+        break;
+    }
+  }
+
+  if (Is256Bit) {
+    vmovapd(ToYMM(Dst), ToYMM(xmm0));
+  } else {
+    vmovapd(Dst, xmm0);
+  }
+}
+
+DEF_OP(VFNMLA) {
+  const auto Op = IROp->C<IR::IROp_VFNMLA>();
+  const auto OpSize = IROp->Size;
+
+  const auto ElementSize = Op->Header.ElementSize;
+  const auto Is256Bit = OpSize == Core::CPUState::XMM_AVX_REG_SIZE;
+  const auto IsScalar = ElementSize == OpSize;
+
+  const auto Dst = GetDst(Node);
+  const auto Vector1 = GetSrc(Op->Vector1.ID());
+  const auto Vector2 = GetSrc(Op->Vector2.ID());
+  const auto Addend = GetSrc(Op->Addend.ID());
+
+  // The 231 form accumulates in to the addend register, work in a temporary so no source gets clobbered.
+  if (Is256Bit) {
+    vmovapd(ToYMM(xmm0), ToYMM(Addend));
+  } else {
+    vmovapd(xmm0, Addend);
+  }
+
+  if (IsScalar) {
+    switch (ElementSize) {
+      case 4: {
+        vfnmadd231ss(xmm0, Vector1, Vector2);
+        break;
+      }
+      case 8: {
+        vfnmadd231sd(xmm0, Vector1, Vector2);
+        break;
+      }
+      default:
+        LOGMAN_MSG_A_FMT("Unknown Element Size: {}", ElementSize);
+        break;
+    }
+  } else {
+    switch (ElementSize) {
+      case 4: {
+        if (Is256Bit) {
+          vfnmadd231ps(ToYMM(xmm0), ToYMM(Vector1), ToYMM(Vector2));
+        } else {
+          vfnmadd231ps(xmm0, Vector1, Vector2);
+        }
+        break;
+      }
+      case 8: {
+        if (Is256Bit) {
+          vfnmadd231pd(ToYMM(xmm0), ToYMM(Vector1), ToYMM(Vector2));
+        } else {
+          vfnmadd231pd(xmm0, Vector1, Vector2);
+        }
+        break;
+      }
+      default:
+        LOGMAN_MSG_A_FMT("Unknown Element Size: {}", ElementSize);
+        break;
+    }
+  }
+
+  if (Is256Bit) {
+    vmovapd(ToYMM(Dst), ToYMM(xmm0));
+  } else {
+    vmovapd(Dst, xmm0);
+  }
+}
+
+DEF_OP(VFNMLS) {
+  const auto Op = IROp->C<IR::IROp_VFNMLS>();
+  const auto OpSize = IROp->Size;
+
+  const auto ElementSize = Op->Header.ElementSize;
+  const auto Is256Bit = OpSize == Core::CPUState::XMM_AVX_REG_SIZE;
+  const auto IsScalar = ElementSize == OpSize;
+
+  const auto Dst = GetDst(Node);
+  const auto Vector1 = GetSrc(Op->Vector1.ID());
+  const auto Vector2 = GetSrc(Op->Vector2.ID());
+  const auto Addend = GetSrc(Op->Addend.ID());
+
+  // The 231 form accumulates in to the addend register, work in a temporary so no source gets clobbered.
+  if (Is256Bit) {
+    vmovapd(ToYMM(xmm0), ToYMM(Addend));
+  } else {
+    vmovapd(xmm0, Addend);
+  }
+
+  if (IsScalar) {
+    switch (ElementSize) {
+      case 4: {
+        vfnmsub231ss(xmm0, Vector1, Vector2);
+        break;
+      }
+      case 8: {
+        vfnmsub231sd(xmm0, Vector1, Vector2);
+        break;
+      }
+      default:
+        LOGMAN_MSG_A_FMT("Unknown Element Size: {}", ElementSize);
+        break;
+    }
+  } else {
+    switch (ElementSize) {
+      case 4: {
+        if (Is256Bit) {
+          vfnmsub231ps(ToYMM(xmm0), ToYMM(Vector1), ToYMM(Vector2));
+        } else {
+          vfnmsub231ps(xmm0, Vector1, Vector2);
+        }
+        break;
+      }
+      case 8: {
+        if (Is256Bit) {
+          vfnmsub231pd(ToYMM(xmm0), ToYMM(Vector1), ToYMM(Vector2));
+        } else {
+          vfnmsub231pd(xmm0, Vector1, Vector2);
+        }
+        break;
+      }
+      default:
+        LOGMAN_MSG_A_FMT("Unknown Element Size: {}", ElementSize);
+        break;
+    }
+  }
+
+  if (Is256Bit) {
+    vmovapd(ToYMM(Dst), ToYMM(xmm0));
+  } else {
+    vmovapd(Dst, xmm0);
+  }
+}
+
 DEF_OP(VFMin) {
   const auto Op = IROp->C<IR::IROp_VFMin>();
   const auto OpSize = IROp->Size;
@@ -1981,6 +2241,17 @@ DEF_OP(VBSL) {
   }
 }
 
+DEF_OP(VPCMPXSTRX) {
+  const auto Op = IROp->C<IR::IROp_VPCMPXSTRX>();
+
+  // The lengths are already saturated, so the 32-bit lengths of the host instruction are enough
+  // Bit 6 of the control is clear so xmm0 receives IntRes2 as a bit mask
+  mov(eax, GetSrc<RA_32>(Op->LHSLength.ID()));
+  mov(edx, GetSrc<RA_32>(Op->RHSLength.ID()));
+  pcmpestrm(GetSrc(Op->LHS.ID()), GetSrc(Op->RHS.ID()), Op->Control);
+  movd(GetDst<RA_32>(Node), xmm0);
+}
+
 DEF_OP(VCMPEQ) {
   const auto Op = IROp->C<IR::IROp_VCMPEQ>();
   const auto OpSize = IROp->Size;
@@ -2541,11 +2812,57 @@ DEF_OP(VFCMPUNO) {
 }
 
 DEF_OP(VUShl) {
-  LOGMAN_MSG_A_FMT("Unimplemented");
+  const auto Op = IROp->C<IR::IROp_VUShl>();
+  const auto OpSize = IROp->Size;
+  const auto Is256Bit = OpSize == Core::CPUState::XMM_AVX_REG_SIZE;
+
+  const auto ElementSize = IROp->ElementSize;
+  LOGMAN_THROW_AA_FMT(ElementSize == 4 || ElementSize == 8, "VUShl only supports 32-bit and 64-bit elements");
+
+  const auto Dst = GetDst(Node);
+  const auto ShiftVector = GetSrc(Op->ShiftVector.ID());
+  const auto Vector = GetSrc(Op->Vector.ID());
+
+  if (ElementSize == 4) {
+    if (Is256Bit) {
+      vpsllvd(ToYMM(Dst), ToYMM(Vector), ToYMM(ShiftVector));
+    } else {
+      vpsllvd(Dst, Vector, ShiftVector);
+    }
+  } else {
+    if (Is256Bit) {
+      vpsllvq(ToYMM(Dst), ToYMM(Vector), ToYMM(ShiftVector));
+    } else {
+      vpsllvq(Dst, Vector, ShiftVector);
+    }
+  }
 }
 
 DEF_OP(VUShr) {
-  LOGMAN_MSG_A_FMT("Unimplemented");
+  const auto Op = IROp->C<IR::IROp_VUShr>();
+  const auto OpSize = IROp->Size;
+  const auto Is256Bit = OpSize == Core::CPUState::XMM_AVX_REG_SIZE;
+
+  const auto ElementSize = IROp->ElementSize;
+  LOGMAN_THROW_AA_FMT(ElementSize == 4 || ElementSize == 8, "VUShr only supports 32-bit and 64-bit elements");
+
+  const auto Dst = GetDst(Node);
+  const auto ShiftVector = GetSrc(Op->ShiftVector.ID());
+  const auto Vector = GetSrc(Op->Vector.ID());
+
+  if (ElementSize == 4) {
+    if (Is256Bit) {
+      vpsrlvd(ToYMM(Dst), ToYMM(Vector), ToYMM(ShiftVector));
+    } else {
+      vpsrlvd(Dst, Vector, ShiftVector);
+    }
+  } else {
+    if (Is256Bit) {
+      vpsrlvq(ToYMM(Dst), ToYMM(Vector), ToYMM(ShiftVector));
+    } else {
+      vpsrlvq(Dst, Vector, ShiftVector);
+    }
+  }
 }
 
 DEF_OP(VSShr) {
@@ -4288,6 +4605,10 @@ void X86JITCore::RegisterVectorHandlers() {
   REGISTER_OP(VFSUB,             VFSub);
   REGISTER_OP(VFMUL,             VFMul);
   REGISTER_OP(VFDIV,             VFDiv);
+  REGISTER_OP(VFMLA,             VFMLA);
+  REGISTER_OP(VFMLS,             VFMLS);
+  REGISTER_OP(VFNMLA,            VFNMLA);
+  REGISTER_OP(VFNMLS,            VFNMLS);
   REGISTER_OP(VFMIN,             VFMin);
   REGISTER_OP(VFMAX,             VFMax);
   REGISTER_OP(VFRECP,            VFRecp);
@@ -4305,6 +4626,7 @@ void X86JITCore::RegisterVectorHandlers() {
   REGISTER_OP(VUNZIP,            VUnZip);
   REGISTER_OP(VUNZIP2,           VUnZip2);
   REGISTER_OP(VBSL,              VBSL);
+  REGISTER_OP(VPCMPXSTRX,        VPCMPXSTRX);
   REGISTER_OP(VCMPEQ,            VCMPEQ);
   REGISTER_OP(VCMPEQZ,           VCMPEQZ);
   REGISTER_OP(VCMPGT,            VCMPGT);
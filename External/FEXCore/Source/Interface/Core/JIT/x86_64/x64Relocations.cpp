@@ -6,8 +6,11 @@ $end_info$
 */
 #include "Interface/Context/Context.h"
 #include "Interface/Core/JIT/x86_64/JITClass.h"
+#include "Interface/Core/ObjectCache/ObjectCacheService.h"
 #include "Interface/HLE/Thunks/Thunks.h"
 
+#include <cstring>
+
 namespace FEXCore::CPU {
 uint64_t X86JITCore::GetNamedSymbolLiteral(FEXCore::CPU::RelocNamedSymbolLiteral::NamedSymbol Op) {
   switch (Op) {
@@ -66,17 +69,40 @@ void X86JITCore::PlaceNamedSymbolLiteral(NamedSymbolLiteralPair &Lit) {
   Relocations.emplace_back(Lit.MoveABI);
 }
 
+void X86JITCore::InsertNamedThunkRelocation(Xbyak::Reg Reg, const IR::SHA256Sum &Sum) {
+  Relocation MoveABI{};
+  MoveABI.NamedThunkMove.Header.Type = FEXCore::CPU::RelocationTypes::RELOC_NAMED_THUNK_MOVE;
+
+  // Offset is the offset from the entrypoint of the block
+  auto CurrentCursor = getSize();
+  MoveABI.NamedThunkMove.Offset = CurrentCursor - CursorEntry;
+  MoveABI.NamedThunkMove.Symbol = Sum;
+  MoveABI.NamedThunkMove.RegisterIndex = Reg.getIdx();
+
+  uint64_t Pointer = reinterpret_cast<uint64_t>(CTX->ThunkHandler->LookupThunk(Sum));
 
-void X86JITCore::InsertGuestRIPMove(Xbyak::Reg Reg, uint64_t Constant) {
+  if (CTX->Config.CacheObjectCodeCompilation()) {
+    LoadConstantWithPadding(Reg, Pointer);
+  }
+  else {
+    mov(Reg, Pointer);
+  }
+
+  Relocations.emplace_back(MoveABI);
+}
+
+void X86JITCore::InsertGuestRIPMove(Xbyak::Reg Reg, int64_t GuestEntryOffset, uint8_t GuestRIPSize) {
   Relocation MoveABI{};
   MoveABI.GuestRIPMove.Header.Type = FEXCore::CPU::RelocationTypes::RELOC_GUEST_RIP_MOVE;
 
   // Offset is the offset from the entrypoint of the block
   auto CurrentCursor = getSize();
   MoveABI.GuestRIPMove.Offset = CurrentCursor - CursorEntry;
-  MoveABI.GuestRIPMove.GuestRIP = Constant;
+  MoveABI.GuestRIPMove.GuestEntryOffset = GuestEntryOffset;
+  MoveABI.GuestRIPMove.GuestRIPSize = GuestRIPSize;
   MoveABI.GuestRIPMove.RegisterIndex = Reg.getIdx();
 
+  uint64_t Constant = GetRelocatedGuestRIP(Entry, GuestEntryOffset, GuestRIPSize);
   if (CTX->Config.CacheObjectCodeCompilation()) {
     LoadConstantWithPadding(Reg, Constant);
   }
@@ -87,6 +113,20 @@ void X86JITCore::InsertGuestRIPMove(Xbyak::Reg Reg, uint64_t Constant) {
   Relocations.emplace_back(MoveABI);
 }
 
+void X86JITCore::PlaceGuestRIPLiteral(int64_t GuestEntryOffset, uint8_t GuestRIPSize) {
+  Relocation MoveABI{};
+  MoveABI.GuestRIPLiteral.Header.Type = FEXCore::CPU::RelocationTypes::RELOC_GUEST_RIP_LITERAL;
+
+  // Offset is the offset from the entrypoint of the block
+  auto CurrentCursor = getSize();
+  MoveABI.GuestRIPLiteral.Offset = CurrentCursor - CursorEntry;
+  MoveABI.GuestRIPLiteral.GuestEntryOffset = GuestEntryOffset;
+  MoveABI.GuestRIPLiteral.GuestRIPSize = GuestRIPSize;
+
+  dq(GetRelocatedGuestRIP(Entry, GuestEntryOffset, GuestRIPSize));
+  Relocations.emplace_back(MoveABI);
+}
+
 bool X86JITCore::ApplyRelocations(uint64_t GuestEntry, uint64_t CodeEntry, uint64_t CursorEntry, size_t NumRelocations, const char* EntryRelocations) {
   size_t DataIndex{};
   for (size_t j = 0; j < NumRelocations; ++j) {
@@ -107,7 +147,8 @@ bool X86JITCore::ApplyRelocations(uint64_t GuestEntry, uint64_t CodeEntry, uint6
       }
       case FEXCore::CPU::RelocationTypes::RELOC_NAMED_THUNK_MOVE: {
         uint64_t Pointer = reinterpret_cast<uint64_t>(CTX->ThunkHandler->LookupThunk(Reloc->NamedThunkMove.Symbol));
-        if (Pointer == ~0ULL) {
+        if (Pointer == 0) {
+          // The library providing this thunk isn't loaded (yet)
           return false;
         }
 
@@ -117,23 +158,51 @@ bool X86JITCore::ApplyRelocations(uint64_t GuestEntry, uint64_t CodeEntry, uint6
         DataIndex += sizeof(Reloc->NamedThunkMove);
         break;
       }
-      case FEXCore::CPU::RelocationTypes::RELOC_GUEST_RIP_MOVE:
-        // XXX: Reenable once the JIT Object Cache is upstream
-        // XXX: Should spin the relocation list, create a list of guest RIP moves, and ask for them all once, reduces lock contention.
-        uint64_t Pointer = ~0ULL; // EmitterCTX->JITObjectCache->FindRelocatedRIP(Reloc->GuestRIPMove.GuestRIP);
-        if (Pointer == ~0ULL) {
-          return false;
-        }
+      case FEXCore::CPU::RelocationTypes::RELOC_GUEST_RIP_MOVE: {
+        uint64_t Pointer = GetRelocatedGuestRIP(GuestEntry, Reloc->GuestRIPMove.GuestEntryOffset, Reloc->GuestRIPMove.GuestRIPSize);
 
         // Relocation occurs at the cursorEntry + offset relative to that cursor.
         setSize(CursorEntry + Reloc->GuestRIPMove.Offset);
         LoadConstantWithPadding(Xbyak::Reg64(Reloc->GuestRIPMove.RegisterIndex), Pointer);
         DataIndex += sizeof(Reloc->GuestRIPMove);
         break;
+      }
+      case FEXCore::CPU::RelocationTypes::RELOC_GUEST_RIP_LITERAL: {
+        uint64_t Pointer = GetRelocatedGuestRIP(GuestEntry, Reloc->GuestRIPLiteral.GuestEntryOffset, Reloc->GuestRIPLiteral.GuestRIPSize);
+
+        // Relocation occurs at the cursorEntry + offset relative to that cursor.
+        setSize(CursorEntry + Reloc->GuestRIPLiteral.Offset);
+        dq(Pointer);
+        DataIndex += sizeof(Reloc->GuestRIPLiteral);
+        break;
+      }
+      default:
+        return false;
     }
   }
 
   return true;
 }
+
+void *X86JITCore::RelocateJITObjectCode(uint64_t Entry, CodeSerialize::CodeObjectFileSection const *SerializationData) {
+  const auto HostCodeSize = SerializationData->HostCodeSize;
+  if ((getSize() + HostCodeSize) > CurrentCodeBuffer->Size) {
+    CTX->ClearCodeCache(ThreadState);
+  }
+
+  const auto CursorEntry = getSize();
+  auto CodeEntry = getCurr<uint8_t*>();
+  memcpy(CodeEntry, SerializationData->HostCode, HostCodeSize);
+
+  if (!ApplyRelocations(Entry, reinterpret_cast<uint64_t>(CodeEntry), CursorEntry, SerializationData->NumRelocations, SerializationData->Relocations)) {
+    // Leave the cursor where it was, the copied code gets overwritten by the next block
+    setSize(CursorEntry);
+    return nullptr;
+  }
+
+  setSize(CursorEntry + HostCodeSize);
+
+  return CodeEntry;
+}
 }
 
@@ -1,6 +1,7 @@
 #pragma once
 #include <FEXCore/Utils/LogManager.h>
 
+#include <algorithm>
 #include <cstdint>
 #include <functional>
 #include <map>
@@ -69,7 +70,14 @@ public:
     return 0;
   }
 
-  std::map<uint64_t, std::vector<uint64_t>> CodePages;
+  // Part of a guest page covered by a compiled block
+  struct CodePageRange {
+    uint64_t Address;
+    uint16_t Offset;
+    uint16_t Length;
+  };
+
+  std::map<uint64_t, std::vector<CodePageRange>> CodePages;
 
   // Appends Block {Address} to CodePages [Start, Start + Length)
   // Returns true if new pages are marked as containing code
@@ -78,10 +86,14 @@ public:
 
     bool rv = false;
 
-    for (auto CurrentPage = Start >> 12, EndPage = (Start + Length -1) >> 12; CurrentPage <= EndPage; CurrentPage++) {
+    const auto End = Start + Length;
+    for (auto CurrentPage = Start >> 12, EndPage = (End - 1) >> 12; CurrentPage <= EndPage; CurrentPage++) {
       auto &CodePage = CodePages[CurrentPage];
       rv |= CodePage.size() == 0;
-      CodePage.push_back(Address);
+
+      const auto RangeStart = std::max(Start, CurrentPage << 12);
+      const auto RangeEnd = std::min(End, (CurrentPage + 1) << 12);
+      CodePage.push_back({Address, static_cast<uint16_t>(RangeStart & 0xFFF), static_cast<uint16_t>(RangeEnd - RangeStart)});
     }
 
     return rv;
@@ -143,6 +155,23 @@ public:
   }
 
 
+  // Finds the guest entry of the block containing HostCode.
+  // Slow, walks every block. Only meant for fault handling paths.
+  uint64_t FindGuestBlockFromHostCode(uintptr_t HostCode) {
+    std::lock_guard<std::recursive_mutex> lk(WriteLock);
+
+    uint64_t GuestCode{};
+    uintptr_t ClosestHostCode{};
+    for (auto &[Guest, Host] : BlockList) {
+      if (Host <= HostCode && Host > ClosestHostCode) {
+        ClosestHostCode = Host;
+        GuestCode = Guest;
+      }
+    }
+
+    return GuestCode;
+  }
+
   void AddBlockLink(uint64_t GuestDestination, uintptr_t HostLink, const std::function<void()> &delinker) {
     std::lock_guard<std::recursive_mutex> lk(WriteLock);
 
@@ -24,9 +24,6 @@ namespace FEXCore::CodeSerialize {
     // ABI local flag unsafe optimization
     bool ABILocalFlags : 1;
 
-    // ABI no PF unsafe optimization
-    bool ABINoPF : 1;
-
     // Static register allocation enabled
     bool SRA : 1;
 
@@ -42,6 +39,9 @@ namespace FEXCore::CodeSerialize {
     // x87 reduced precision
     bool x87ReducedPrecision : 1;
 
+    // TSO page tracking, thunk calls notify the syscall handler
+    bool TSOPageTracking : 1;
+
     // Padding to remove uninitialized data warning from asan
     // Shows remaining amount of bits available for config
     unsigned _Pad : 18;
@@ -53,12 +53,12 @@ namespace FEXCore::CodeSerialize {
         MultiBlock == other.MultiBlock &&
         TSOEnabled == other.TSOEnabled &&
         ABILocalFlags == other.ABILocalFlags &&
-        ABINoPF == other.ABINoPF &&
         SRA == other.SRA &&
         ParanoidTSO == other.ParanoidTSO &&
         Is64BitMode == other.Is64BitMode &&
         SMCChecks == other.SMCChecks &&
-        x87ReducedPrecision == other.x87ReducedPrecision;
+        x87ReducedPrecision == other.x87ReducedPrecision &&
+        TSOPageTracking == other.TSOPageTracking;
     }
     static uint64_t GetHash(CodeObjectSerializationConfig const &other) {
       // For < 64-bits of data just pack directly
@@ -69,12 +69,12 @@ namespace FEXCore::CodeSerialize {
       Hash <<= 1;  Hash |= other.MultiBlock;
       Hash <<= 1;  Hash |= other.TSOEnabled;
       Hash <<= 1;  Hash |= other.ABILocalFlags;
-      Hash <<= 1;  Hash |= other.ABINoPF;
       Hash <<= 1;  Hash |= other.SRA;
       Hash <<= 1;  Hash |= other.ParanoidTSO;
       Hash <<= 1;  Hash |= other.Is64BitMode;
       Hash <<= 2;  Hash |= other.SMCChecks;
       Hash <<= 1;  Hash |= other.x87ReducedPrecision;
+      Hash <<= 1;  Hash |= other.TSOPageTracking;
       return Hash;
     }
   };
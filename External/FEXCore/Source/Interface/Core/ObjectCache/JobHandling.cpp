@@ -12,7 +12,7 @@
 #include <xxhash.h>
 
 namespace FEXCore::CodeSerialize {
-  void AsyncJobHandler::AsyncAddNamedRegionJob(uintptr_t Base, uintptr_t Size, uintptr_t Offset, const std::string &filename) {
+  void AsyncJobHandler::AsyncAddNamedRegionJob(uintptr_t Base, uintptr_t Size, uintptr_t Offset, const std::string &filename, const std::string &FileIdentity) {
     // This function adds a named region *JOB* to our named region handler
     // This needs to be as fast as possible to keep out of the way of the JIT
 
@@ -25,6 +25,7 @@ namespace FEXCore::CodeSerialize {
         Size,
         Offset,
         filename,
+        FileIdentity,
         NamedRegionHandler->DefaultCodeHeader(Base, Offset)
       );
 
@@ -37,7 +38,8 @@ namespace FEXCore::CodeSerialize {
 
         auto &EntryMap = CodeObjectCacheService->GetEntryMap();
 
-        auto it = EntryMap.emplace(Base, std::move(Entry));
+        // try_emplace leaves Entry alone if there is already a region at Base
+        auto it = EntryMap.try_emplace(Base, std::move(Entry));
         if (!it.second) {
           // This happens when an application overwrites a previous region without unmapping what was there
 
@@ -57,8 +59,11 @@ namespace FEXCore::CodeSerialize {
             CodeObjectCacheService->GetUnrelocatedEntryMap().erase(it.first->second->EntryHeader.OriginalBase);
           }
 
+          // The old entry is done with, it can't be destroyed while locked
+          it.first->second->NamedJobRefCountMutex.unlock();
+
           // Now overwrite the entry in the map
-          it = EntryMap.insert_or_assign(Base, std::move(Entry));
+          it.first->second = std::move(Entry);
           EntryIterator = it.first;
         }
         else {
@@ -122,6 +127,15 @@ namespace FEXCore::CodeSerialize {
   }
 
   void AsyncJobHandler::AsyncAddSerializationJob(std::unique_ptr<SerializationJobData> Data) {
-    // XXX: Actually add serialization job
+    // The block hasn't run yet, so nothing has been backpatched.
+    // Take the copies now, the async thread gets to them after the block has been linked.
+    auto HostCode = reinterpret_cast<uint8_t const*>(Data->HostCodeBegin);
+    Data->HostCode.assign(HostCode, HostCode + Data->HostCodeLength);
+    Data->GuestCodeHash = XXH3_64bits(reinterpret_cast<void const*>(Data->GuestCodeStart), Data->GuestCodeLength);
+
+    // The job no longer references the thread's code buffer
+    Data->HostCodeBegin = nullptr;
+
+    CodeObjectCacheService->AddSerializationWorkItem(std::move(Data));
   }
 }
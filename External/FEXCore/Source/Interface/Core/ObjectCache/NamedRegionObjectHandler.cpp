@@ -3,6 +3,10 @@
 
 #include <FEXCore/Config/Config.h>
 
+#include <fmt/format.h>
+#include <git_version.h>
+#include <unistd.h>
+
 namespace FEXCore::CodeSerialize {
   NamedRegionObjectHandler::NamedRegionObjectHandler(FEXCore::Context::Context *ctx) {
     DefaultSerializationConfig.Cookie = CODE_COOKIE;
@@ -15,25 +19,54 @@ namespace FEXCore::CodeSerialize {
     DefaultSerializationConfig.MultiBlock = ctx->Config.Multiblock;
     DefaultSerializationConfig.TSOEnabled = ctx->Config.TSOEnabled;
     DefaultSerializationConfig.ABILocalFlags = ctx->Config.ABILocalFlags;
-    DefaultSerializationConfig.ABINoPF = ctx->Config.ABINoPF;
     DefaultSerializationConfig.SRA = ctx->Config.StaticRegisterAllocation;
     DefaultSerializationConfig.ParanoidTSO = ctx->Config.ParanoidTSO;
     DefaultSerializationConfig.Is64BitMode = ctx->Config.Is64BitMode;
     DefaultSerializationConfig.SMCChecks = ctx->Config.SMCChecks;
     DefaultSerializationConfig.x87ReducedPrecision = ctx->Config.x87ReducedPrecision;
+    DefaultSerializationConfig.TSOPageTracking = ctx->Config.TSOPageTracking;
+
+    WriteSharedCode = ctx->Config.CacheObjectCodeCompilation() == FEXCore::Config::ConfigObjectCodeHandler::CONFIG_READWRITE;
+  }
+
+  SharedCodeCache *NamedRegionObjectHandler::GetSharedCodeCache(const std::string &FileIdentity) {
+    auto it = SharedCaches.find(FileIdentity);
+    if (it != SharedCaches.end()) {
+      return it->second.get();
+    }
+
+    if (!CodeCacheFDRequester) {
+      return nullptr;
+    }
+
+    // FEXServer only matches the name, so everything that changes the generated code needs to be part of it
+    const auto ConfigHash = CodeObjectSerializationConfig::GetHash(DefaultSerializationConfig);
+    const auto Name = fmt::format("{}-" GIT_SHORT_HASH "-{:x}-{:x}", FileIdentity, CODE_COOKIE, ConfigHash);
+
+    std::unique_ptr<SharedCodeCache> Cache;
+    int FD = CodeCacheFDRequester(Name);
+    if (FD != -1) {
+      Cache = SharedCodeCache::Map(FD, WriteSharedCode, CODE_COOKIE, ConfigHash);
+      close(FD);
+    }
+
+    // Failures get remembered as well so FEXServer isn't asked again for every mapping of the file
+    return SharedCaches.emplace(FileIdentity, std::move(Cache)).first->second.get();
   }
 
   void NamedRegionObjectHandler::AddNamedRegionObject(CodeRegionMapType::iterator Entry, const std::string &base_filename, const std::string &filename, bool Executable) {
-    // XXX: Add named region objects
+    auto &Region = Entry->second;
 
-    // XXX: Until entry loading is complete just claim it is loaded
-    Entry->second->NamedJobRefCountMutex.unlock();
+    if (Executable && !Region->FileIdentity.empty()) {
+      Region->SharedCache = GetSharedCodeCache(Region->FileIdentity);
+    }
+
+    // Loading is complete, code lookups can use the entry now
+    Region->NamedJobRefCountMutex.unlock();
   }
 
   void NamedRegionObjectHandler::RemoveNamedRegionObject(uintptr_t Base, uintptr_t Size, std::unique_ptr<CodeRegionEntry> Entry) {
-    // XXX: Remove named region objects
-
-    // XXX: Until entry loading is complete just claim it is loaded
+    // The shared code cache stays mapped, other regions of the same file might still use it
     Entry->NamedJobRefCountMutex.unlock();
   }
 
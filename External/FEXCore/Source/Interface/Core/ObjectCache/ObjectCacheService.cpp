@@ -3,6 +3,7 @@
 #include <FEXCore/Config/Config.h>
 
 #include <memory>
+#include <xxhash.h>
 
 namespace {
   static void* ThreadHandler(void *Arg) {
@@ -54,9 +55,133 @@ namespace FEXCore::CodeSerialize {
     // XXX: Do code region closure
   }
 
-  CodeObjectFileSection const *CodeObjectSerializeService::FetchCodeObjectFromCache(uint64_t GuestRIP) {
-    // XXX: Actually fetch code objects from cache
-    return nullptr;
+  bool CodeObjectSerializeService::FetchCodeObjectFromCache(uint64_t GuestRIP, uint64_t CodeFlags, std::function<bool(uint64_t Start, uint64_t Length)> const &MarkGuestCode, CodeObjectFileSection *Section) {
+    SharedCodeCache *Cache{};
+    uint64_t RegionBase{};
+    uint64_t RegionSize{};
+    uint64_t RegionOffset{};
+
+    {
+      std::shared_lock lk {EntryMapMutex};
+
+      // Find the region with the highest base at or below GuestRIP
+      auto it = AddressToEntryMap.upper_bound(GuestRIP);
+      if (it == AddressToEntryMap.begin()) {
+        return false;
+      }
+      --it;
+
+      auto &Region = it->second;
+      if (GuestRIP >= Region->Base + Region->Size) {
+        return false;
+      }
+
+      // Still being loaded by the async thread, compile this block normally
+      if (!Region->NamedJobRefCountMutex.try_lock_shared()) {
+        return false;
+      }
+
+      Cache = Region->SharedCache;
+      RegionBase = Region->Base;
+      RegionSize = Region->Size;
+      RegionOffset = Region->Offset;
+      Region->NamedJobRefCountMutex.unlock_shared();
+    }
+
+    if (!Cache) {
+      return false;
+    }
+
+    return Cache->Find(GuestRIP - RegionBase + RegionOffset, [&](SharedCodeCache::GuestCode const &Guest) {
+      if (Guest.Flags != CodeFlags) {
+        return false;
+      }
+
+      const uint64_t Start = GuestRIP + Guest.StartOffset;
+
+      // The guest code needs to be inside of this mapping for it to be safe to read
+      if (Start < RegionBase || Guest.Length > RegionSize || Start - RegionBase > RegionSize - Guest.Length) {
+        return false;
+      }
+
+      // Track the range before reading it, a write after this point invalidates the block
+      if (!MarkGuestCode(Start, Guest.Length)) {
+        return false;
+      }
+      return XXH3_64bits(reinterpret_cast<void const*>(Start), Guest.Length) == Guest.Hash;
+    }, Section);
+  }
+
+  void CodeObjectSerializeService::AddSerializationWorkItem(std::unique_ptr<AsyncJobHandler::SerializationJobData> Data) {
+    {
+      std::unique_lock lk {SerializationQueueMutex};
+      if (SerializationQueue.size() >= MAX_SERIALIZATION_JOBS) {
+        // The async thread is behind, this block just won't be shared
+        return;
+      }
+      SerializationQueue.emplace(std::move(Data));
+    }
+
+    NotifyWork();
+  }
+
+  void CodeObjectSerializeService::HandleSerializationJobs() {
+    while (true) {
+      std::unique_ptr<AsyncJobHandler::SerializationJobData> Job;
+      {
+        std::unique_lock lk {SerializationQueueMutex};
+        if (SerializationQueue.empty()) {
+          return;
+        }
+        Job = std::move(SerializationQueue.front());
+        SerializationQueue.pop();
+      }
+
+      SharedCodeCache *Cache{};
+      uint64_t FileOffset{};
+      {
+        std::shared_lock lk {EntryMapMutex};
+
+        auto it = AddressToEntryMap.upper_bound(Job->GuestRIP);
+        if (it == AddressToEntryMap.begin()) {
+          continue;
+        }
+        --it;
+
+        auto &Region = it->second;
+        if (Job->GuestRIP >= Region->Base + Region->Size ||
+            Job->GuestCodeStart < Region->Base ||
+            Job->GuestCodeStart + Job->GuestCodeLength > Region->Base + Region->Size) {
+          // Not file backed or spans multiple mappings
+          continue;
+        }
+
+        // Named region jobs are handled first, so this only fails if the region is being replaced
+        if (!Region->NamedJobRefCountMutex.try_lock_shared()) {
+          continue;
+        }
+
+        Cache = Region->SharedCache;
+        FileOffset = Job->GuestRIP - Region->Base + Region->Offset;
+        Region->NamedJobRefCountMutex.unlock_shared();
+      }
+
+      if (!Cache) {
+        continue;
+      }
+
+      SharedCodeCache::GuestCode Guest {
+        .StartOffset = static_cast<int64_t>(Job->GuestCodeStart - Job->GuestRIP),
+        .Length = Job->GuestCodeLength,
+        .Hash = Job->GuestCodeHash,
+        .Flags = Job->CodeFlags,
+      };
+
+      // Another process might have compiled the same block in the meantime
+      if (!Cache->Contains(FileOffset, Guest)) {
+        Cache->Insert(FileOffset, Guest, Job->HostCode.data(), Job->HostCode.size(), Job->Relocations);
+      }
+    }
   }
 
   void CodeObjectSerializeService::ExecutionThread() {
@@ -70,7 +195,8 @@ namespace FEXCore::CodeSerialize {
       // Handle named region async jobs first. Highest priority
       NamedRegionHandler.HandleNamedRegionObjectJobs();
 
-      // XXX: Handle code serialization jobs second.
+      // Handle code serialization jobs second.
+      HandleSerializationJobs();
     }
 
     // Do final code region closures on thread shutdown
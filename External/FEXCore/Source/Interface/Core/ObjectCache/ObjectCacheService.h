@@ -2,15 +2,19 @@
 #include "Interface/Context/Context.h"
 #include "Interface/Core/ObjectCache/Relocations.h"
 #include "Interface/Core/ObjectCache/CodeObjectSerializationConfig.h"
+#include "Interface/Core/ObjectCache/SharedCodeCache.h"
 #include "Interface/IR/AOTIR.h"
 
 #include <FEXCore/Utils/Event.h>
 #include <FEXCore/Utils/Threads.h>
 
+#include <functional>
 #include <map>
 #include <memory>
+#include <queue>
 #include <shared_mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <tsl/robin_map.h>
 
@@ -25,6 +29,7 @@ namespace FEXCore::CodeSerialize {
     bool Invalid;
     const CodeSerializationData *Data;
     const char *HostCode;
+    uint64_t HostCodeSize;
     uint64_t NumRelocations;
     const char *Relocations;
   };
@@ -68,6 +73,9 @@ namespace FEXCore::CodeSerialize {
       // Filename of the object
       std::string Filename{};
 
+      // Identifies the file contents, FEXServer shares the compiled code of a file by this
+      std::string FileIdentity{};
+
       CodeObjectSerializationHeader EntryHeader{};
     /**  @} */
 
@@ -108,6 +116,10 @@ namespace FEXCore::CodeSerialize {
         std::vector<CodeObjectFileSection> FileCodeSections;
       /**  @} */
 
+      // The cross-process code cache of this file, owned by the NamedRegionObjectHandler
+      // nullptr if FEXServer didn't give us one
+      SharedCodeCache *SharedCache{};
+
       // This per section map takes the most time to load and needs to be quick
       // This is the map of all code segments for this entry
       tsl::robin_map<uint64_t, CodeObjectFileSection*> SectionLookupMap{};
@@ -121,11 +133,13 @@ namespace FEXCore::CodeSerialize {
       uint64_t Size,
       uint64_t Offset,
       std::string const &Filename,
+      std::string const &FileIdentity,
       CodeObjectSerializationHeader const &DefaultHeader)
       : Base {Base}
       , Size {Size}
       , Offset {Offset}
       , Filename {Filename}
+      , FileIdentity {FileIdentity}
       , EntryHeader {DefaultHeader} {
       }
   };
@@ -145,8 +159,10 @@ namespace FEXCore::CodeSerialize {
       struct SerializationJobData {
         uint64_t GuestRIP;        ///< The RIP for the guest
         // XXX: Support multiblock
+        uint64_t GuestCodeStart;  ///< Start of the guest code the block was compiled from, can be before GuestRIP
         uint64_t GuestCodeLength; ///< The Guest's code length
         uint64_t GuestCodeHash;   ///< Hash of the guest code
+        uint64_t CodeFlags;       ///< SharedCodeCache::FLAG_* the block was compiled with
 
         void *HostCodeBegin;      ///< Host JIT code starting memory address
         size_t HostCodeLength;    ///< Host JIT code length
@@ -162,6 +178,10 @@ namespace FEXCore::CodeSerialize {
         // Relatively small number of entries most of the time
         std::vector<FEXCore::CPU::Relocation> Relocations;
 
+        // Copy of the host code taken when the job is added
+        // The block linker patches the code in place once it runs, so it can't be read later
+        std::vector<uint8_t> HostCode;
+
         /**
          * @name Objects filled in from the Code Object Serialization service when a job is added
          * @{ */
@@ -186,7 +206,7 @@ namespace FEXCore::CodeSerialize {
       /**
        * @name Async job submission functions
        * @{ */
-        void AsyncAddNamedRegionJob(uintptr_t Base, uintptr_t Size, uintptr_t Offset, const std::string &filename);
+        void AsyncAddNamedRegionJob(uintptr_t Base, uintptr_t Size, uintptr_t Offset, const std::string &filename, const std::string &FileIdentity);
         void AsyncRemoveNamedRegionJob(uintptr_t Base, uintptr_t Size);
         void AsyncAddSerializationJob(std::unique_ptr<SerializationJobData> Data);
       /**  @} */
@@ -261,6 +281,10 @@ namespace FEXCore::CodeSerialize {
         return DefaultSerializationConfig;
       }
 
+      void SetCodeCacheFDRequester(std::function<int(const std::string&)> Requester) {
+        CodeCacheFDRequester = std::move(Requester);
+      }
+
     protected:
       friend class AsyncJobHandler;
 
@@ -304,7 +328,7 @@ namespace FEXCore::CodeSerialize {
 
     private:
       // Code version. If the code emission changes then this needs to increment
-      constexpr static uint32_t CODE_VERSION = 0x0;
+      constexpr static uint32_t CODE_VERSION = 0x1;
 
       // Default cookie header for the file header
       constexpr static uint64_t CODE_COOKIE = FEXCore::IR::COOKIE_VERSION("FEXC", CODE_VERSION);
@@ -312,6 +336,19 @@ namespace FEXCore::CodeSerialize {
       // Code serialization config for our current process configuration
       CodeObjectSerializationConfig DefaultSerializationConfig;
 
+      // If this process adds code to the shared code caches
+      bool WriteSharedCode{};
+
+      // Asks FEXServer for the shared code cache memfd of a file
+      std::function<int(const std::string&)> CodeCacheFDRequester;
+
+      // Shared code caches by file identity
+      // Only touched from the async thread, caches are never unmapped while the service is alive
+      // so code regions can keep pointers to them
+      std::unordered_map<std::string, std::unique_ptr<SharedCodeCache>> SharedCaches;
+
+      SharedCodeCache *GetSharedCodeCache(const std::string &FileIdentity);
+
       // Atomic counter for number of jobs in the queue without needing to pull the mutex to check
       std::atomic<uint64_t> NamedWorkQueueJobs{};
 
@@ -364,9 +401,10 @@ namespace FEXCore::CodeSerialize {
          * @param Size - The size of the region
          * @param Offset - The offset from the file
          * @param filename - The filename itself
+         * @param FileIdentity - Identifies the file contents, used to find the cross-process code cache of the file
          */
-        void AsyncAddNamedRegionJob(uintptr_t Base, uintptr_t Size, uintptr_t Offset, const std::string &filename) {
-          AsyncHandler.AsyncAddNamedRegionJob(Base, Size, Offset, filename);
+        void AsyncAddNamedRegionJob(uintptr_t Base, uintptr_t Size, uintptr_t Offset, const std::string &filename, const std::string &FileIdentity) {
+          AsyncHandler.AsyncAddNamedRegionJob(Base, Size, Offset, filename, FileIdentity);
         }
 
         /**
@@ -409,12 +447,21 @@ namespace FEXCore::CodeSerialize {
          * @brief Fetches object code from the Code Object Cache for JIT.
          *
          * @param GuestRIP - Which GuestRIP to search the cache for
+         * @param CodeFlags - SharedCodeCache::FLAG_* the block would be compiled with
+         * @param MarkGuestCode - Called with the guest code range of a candidate before its guest code is checked,
+         *                        so code tracking sees the range before it is read.
+         *                        Returning false rejects the candidate.
+         * @param Section - Data required for the JIT to relocate the Object code.
          *
-         * @return Data required for the JIT to relocate the Object code.
+         * @return true if code was found for the guest code at GuestRIP
          */
-        CodeObjectFileSection const *FetchCodeObjectFromCache(uint64_t GuestRIP);
+        bool FetchCodeObjectFromCache(uint64_t GuestRIP, uint64_t CodeFlags, std::function<bool(uint64_t Start, uint64_t Length)> const &MarkGuestCode, CodeObjectFileSection *Section);
       /**  @} */
 
+      void SetCodeCacheFDRequester(std::function<int(const std::string&)> Requester) {
+        NamedRegionHandler.SetCodeCacheFDRequester(std::move(Requester));
+      }
+
       // Public for threading
       void ExecutionThread();
 
@@ -429,7 +476,7 @@ namespace FEXCore::CodeSerialize {
       void DoCodeRegionClosure(uint64_t Base, CodeRegionEntry *it);
 
       CodeSerializationMutex &GetEntryMapMutex() { return EntryMapMutex; }
-      CodeSerializationMutex &GetUnrelocatedEntryMapMutex() { return EntryMapMutex; }
+      CodeSerializationMutex &GetUnrelocatedEntryMapMutex() { return UnrelocatedEntryMapMutex; }
 
       CodeRegionMapType &GetEntryMap() { return AddressToEntryMap; }
       CodeRegionPtrMapType &GetUnrelocatedEntryMap() { return UnrelocatedAddressToEntryMap; }
@@ -439,6 +486,9 @@ namespace FEXCore::CodeSerialize {
        */
       void NotifyWork() { WorkAvailable.NotifyOne(); }
 
+      void AddSerializationWorkItem(std::unique_ptr<AsyncJobHandler::SerializationJobData> Data);
+      void HandleSerializationJobs();
+
     private:
       FEXCore::Context::Context *CTX;
 
@@ -455,5 +505,10 @@ namespace FEXCore::CodeSerialize {
       // Entry maps
       CodeRegionMapType AddressToEntryMap;
       CodeRegionPtrMapType UnrelocatedAddressToEntryMap;
+
+      // Upper limit of code objects waiting to be serialized, more get dropped
+      constexpr static size_t MAX_SERIALIZATION_JOBS = 4096;
+      std::mutex SerializationQueueMutex;
+      std::queue<std::unique_ptr<AsyncJobHandler::SerializationJobData>> SerializationQueue;
   };
 }
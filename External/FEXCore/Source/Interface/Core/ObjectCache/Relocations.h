@@ -18,6 +18,10 @@ namespace FEXCore::CPU {
     // 64-bit mov on x86-64
     // Aligned to struct RelocGuestRIPMove
     RELOC_GUEST_RIP_MOVE,
+
+    // 8 byte literal in memory for a guest RIP
+    // Aligned to struct RelocGuestRIPLiteral
+    RELOC_GUEST_RIP_LITERAL,
   };
 
   struct RelocationTypeHeader final {
@@ -58,11 +62,27 @@ namespace FEXCore::CPU {
     // GPR index the constant is being moved to
     uint8_t RegisterIndex;
 
+    // Size of the guest RIP, 4 byte RIPs are truncated
+    uint8_t GuestRIPSize;
+
+    // Offset in to the code section to begin the relocation
+    uint64_t Offset{};
+
+    // The RIP that is being moved, relative to the block entry
+    int64_t GuestEntryOffset;
+  };
+
+  struct RelocGuestRIPLiteral final {
+    RelocationTypeHeader Header{};
+
+    // Size of the guest RIP, 4 byte RIPs are truncated
+    uint8_t GuestRIPSize;
+
     // Offset in to the code section to begin the relocation
     uint64_t Offset{};
 
-    // The unrelocated RIP that is being moved
-    uint64_t GuestRIP;
+    // The RIP that is being placed, relative to the block entry
+    int64_t GuestEntryOffset;
   };
 
   union Relocation {
@@ -74,5 +94,28 @@ namespace FEXCore::CPU {
     RelocNamedThunkMove NamedThunkMove;
 
     RelocGuestRIPMove GuestRIPMove;
+
+    RelocGuestRIPLiteral GuestRIPLiteral;
   };
+
+  /**
+   * @brief Returns the size of a relocation when the relocations are stored back to back
+   */
+  inline size_t GetRelocationSize(Relocation const &Reloc) {
+    switch (Reloc.Header.Type) {
+      case RelocationTypes::RELOC_NAMED_SYMBOL_LITERAL: return sizeof(Reloc.NamedSymbolLiteral);
+      case RelocationTypes::RELOC_NAMED_THUNK_MOVE: return sizeof(Reloc.NamedThunkMove);
+      case RelocationTypes::RELOC_GUEST_RIP_MOVE: return sizeof(Reloc.GuestRIPMove);
+      case RelocationTypes::RELOC_GUEST_RIP_LITERAL: return sizeof(Reloc.GuestRIPLiteral);
+    }
+    return sizeof(Reloc);
+  }
+
+  /**
+   * @brief Calculates the guest RIP that a relocation against the block entry points to
+   */
+  inline uint64_t GetRelocatedGuestRIP(uint64_t GuestEntry, int64_t GuestEntryOffset, uint8_t GuestRIPSize) {
+    uint64_t RIP = GuestEntry + GuestEntryOffset;
+    return GuestRIPSize == 4 ? (RIP & 0xFFFF'FFFFULL) : RIP;
+  }
 }
@@ -0,0 +1,144 @@
+#include "Interface/Core/ObjectCache/ObjectCacheService.h"
+#include "Interface/Core/ObjectCache/SharedCodeCache.h"
+
+#include <FEXCore/Utils/Allocator.h>
+#include <FEXCore/Utils/LogManager.h>
+#include <FEXCore/Utils/MathUtils.h>
+
+#include <cstring>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace FEXCore::CodeSerialize {
+  namespace {
+    // Values of the header's Initialized member
+    constexpr uint32_t STATE_EMPTY = 0;
+    constexpr uint32_t STATE_INITIALIZING = 1;
+    constexpr uint32_t STATE_READY = 2;
+  }
+
+  std::unique_ptr<SharedCodeCache> SharedCodeCache::Map(int FD, bool Writable, uint64_t Cookie, uint64_t ConfigHash) {
+    struct stat buf{};
+    if (fstat(FD, &buf) == -1 || buf.st_size < static_cast<off_t>(sizeof(Header) + sizeof(Entry))) {
+      return {};
+    }
+
+    const size_t Size = buf.st_size;
+    const int Prot = Writable ? (PROT_READ | PROT_WRITE) : PROT_READ;
+    auto Base = reinterpret_cast<uint8_t*>(FEXCore::Allocator::mmap(nullptr, Size, Prot, MAP_SHARED, FD, 0));
+    if (Base == MAP_FAILED) {
+      return {};
+    }
+
+    std::unique_ptr<SharedCodeCache> Cache {new SharedCodeCache(Base, Size, Writable)};
+    auto CacheHeader = Cache->GetHeader();
+
+    uint32_t State = CacheHeader->Initialized.load(std::memory_order_acquire);
+    if (State == STATE_EMPTY && Writable &&
+        CacheHeader->Initialized.compare_exchange_strong(State, STATE_INITIALIZING, std::memory_order_acquire)) {
+      // First process to see this memfd, the rest of it is still zero
+      CacheHeader->Cookie = Cookie;
+      CacheHeader->ConfigHash = ConfigHash;
+      CacheHeader->WriteOffset.store(FEXCore::AlignUp(sizeof(Header), 16), std::memory_order_relaxed);
+      CacheHeader->Initialized.store(STATE_READY, std::memory_order_release);
+      State = STATE_READY;
+    }
+
+    // Another process is initializing the header, this only takes a moment
+    for (size_t i = 0; State == STATE_INITIALIZING && i < 1000; ++i) {
+      sched_yield();
+      State = CacheHeader->Initialized.load(std::memory_order_acquire);
+    }
+
+    if (State != STATE_READY ||
+        CacheHeader->Cookie != Cookie ||
+        CacheHeader->ConfigHash != ConfigHash) {
+      return {};
+    }
+
+    return Cache;
+  }
+
+  SharedCodeCache::~SharedCodeCache() {
+    FEXCore::Allocator::munmap(Base, Size);
+  }
+
+  bool SharedCodeCache::Find(uint64_t FileOffset, std::function<bool(GuestCode const&)> const &Validate, CodeObjectFileSection *Section) const {
+    auto Result = FindEntry(FileOffset, [&Validate](Entry const *Current) {
+      return Validate(Current->Guest);
+    });
+
+    if (!Result) {
+      return false;
+    }
+
+    auto HostCode = reinterpret_cast<char const*>(Result + 1);
+    *Section = CodeObjectFileSection {
+      .Serialized = true,
+      .Invalid = false,
+      .Data = nullptr,
+      .HostCode = HostCode,
+      .HostCodeSize = Result->HostCodeSize,
+      .NumRelocations = Result->NumRelocations,
+      .Relocations = HostCode + GetRelocationsOffset(Result->HostCodeSize),
+    };
+    return true;
+  }
+
+  bool SharedCodeCache::Contains(uint64_t FileOffset, GuestCode const &Guest) const {
+    return FindEntry(FileOffset, [&Guest](Entry const *Current) {
+      return Current->Guest.StartOffset == Guest.StartOffset &&
+        Current->Guest.Length == Guest.Length &&
+        Current->Guest.Hash == Guest.Hash &&
+        Current->Guest.Flags == Guest.Flags;
+    }) != nullptr;
+  }
+
+  bool SharedCodeCache::Insert(uint64_t FileOffset, GuestCode const &Guest, uint8_t const *HostCode, uint64_t HostCodeSize,
+    std::vector<FEXCore::CPU::Relocation> const &Relocations) {
+    if (!Writable) {
+      return false;
+    }
+
+    uint64_t RelocationsSize{};
+    for (auto const &Reloc : Relocations) {
+      RelocationsSize += FEXCore::CPU::GetRelocationSize(Reloc);
+    }
+
+    const uint64_t AllocationSize = FEXCore::AlignUp(GetEntrySize(HostCodeSize, RelocationsSize), 16);
+    auto CacheHeader = GetHeader();
+
+    // Once the cache is full the write offset stays past the end
+    const uint64_t Offset = CacheHeader->WriteOffset.fetch_add(AllocationSize, std::memory_order_relaxed);
+    if (Offset > Size || AllocationSize > Size - Offset) {
+      return false;
+    }
+
+    auto NewEntry = reinterpret_cast<Entry*>(Base + Offset);
+    NewEntry->FileOffset = FileOffset;
+    NewEntry->Guest = Guest;
+    NewEntry->HostCodeSize = HostCodeSize;
+    NewEntry->NumRelocations = Relocations.size();
+    NewEntry->RelocationsSize = RelocationsSize;
+
+    auto EntryHostCode = reinterpret_cast<uint8_t*>(NewEntry + 1);
+    memcpy(EntryHostCode, HostCode, HostCodeSize);
+
+    auto EntryRelocations = EntryHostCode + GetRelocationsOffset(HostCodeSize);
+    for (auto const &Reloc : Relocations) {
+      const auto RelocSize = FEXCore::CPU::GetRelocationSize(Reloc);
+      memcpy(EntryRelocations, &Reloc, RelocSize);
+      EntryRelocations += RelocSize;
+    }
+
+    // Publish the entry, the release makes sure the contents are visible before the entry is reachable
+    auto &Bucket = CacheHeader->Buckets[GetBucket(FileOffset)];
+    uint64_t Head = Bucket.load(std::memory_order_relaxed);
+    do {
+      NewEntry->Next.store(Head, std::memory_order_relaxed);
+    } while (!Bucket.compare_exchange_weak(Head, Offset, std::memory_order_release, std::memory_order_relaxed));
+
+    return true;
+  }
+}
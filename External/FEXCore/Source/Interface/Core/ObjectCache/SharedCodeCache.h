@@ -0,0 +1,157 @@
+#pragma once
+#include "Interface/Core/ObjectCache/Relocations.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace FEXCore::CodeSerialize {
+  struct CodeObjectFileSection;
+
+  /**
+   * @brief Compiled code for a single file, living in a memfd that FEXServer shares between processes
+   *
+   * Every process that maps the same file with the same configuration gets the same memfd.
+   * Entries are appended with an atomic bump allocator and then published in to a hash bucket with a CAS,
+   * so neither readers nor writers need a lock. Nothing is ever removed, the cache stops growing once it is full.
+   *
+   * The code is position independent relative to the block entry, the guest RIP relocations get applied when a
+   * process copies an entry in to its own code buffer.
+   */
+  class SharedCodeCache final {
+    public:
+      /**
+       * @brief Maps a code cache memfd
+       *
+       * An empty memfd is initialized, one with a mismatching header is rejected.
+       *
+       * @param FD - The memfd from FEXServer, ownership isn't taken
+       * @param Writable - If this process is allowed to add code
+       * @param Cookie - Code version, must match for the code to be usable
+       * @param ConfigHash - Code generation configuration, must match for the code to be usable
+       *
+       * @return nullptr if the memfd can't be used
+       */
+      static std::unique_ptr<SharedCodeCache> Map(int FD, bool Writable, uint64_t Cookie, uint64_t ConfigHash);
+
+      ~SharedCodeCache();
+
+      // The block was compiled with TSO memory ops
+      constexpr static uint64_t FLAG_TSO = 1 << 0;
+
+      struct GuestCode {
+        // Start of the guest code range the block was compiled from, relative to the block entry
+        int64_t StartOffset;
+        uint64_t Length;
+        uint64_t Hash;
+        // Code generation state that changes while a process runs, FLAG_*
+        uint64_t Flags;
+      };
+
+      /**
+       * @brief Looks up a block by the file offset of its entry
+       *
+       * @param FileOffset - Offset of the block entry in to the mapped file
+       * @param Validate - Returns true if the guest code the entry was compiled from still matches
+       * @param Section - Filled with pointers in to the shared mapping
+       */
+      bool Find(uint64_t FileOffset, std::function<bool(GuestCode const&)> const &Validate, CodeObjectFileSection *Section) const;
+
+      /**
+       * @brief Adds a block to the cache
+       *
+       * @param Relocations - Relocations of the block, they get stored back to back
+       *
+       * @return false if the cache is full or read-only
+       */
+      bool Insert(uint64_t FileOffset, GuestCode const &Guest, uint8_t const *HostCode, uint64_t HostCodeSize,
+        std::vector<FEXCore::CPU::Relocation> const &Relocations);
+
+      /**
+       * @brief Checks if the cache already contains a block for a file offset and guest code
+       */
+      bool Contains(uint64_t FileOffset, GuestCode const &Guest) const;
+
+    private:
+      constexpr static uint64_t NUM_BUCKETS = 16384;
+
+      struct Header {
+        uint64_t Cookie;
+        uint64_t ConfigHash;
+        // Set once the header is fully initialized
+        std::atomic<uint32_t> Initialized;
+        uint32_t Pad;
+        // Offset in the memfd where the next entry gets allocated
+        std::atomic<uint64_t> WriteOffset;
+        // Offset of the first entry in each bucket chain, zero terminates the chain
+        std::atomic<uint64_t> Buckets[NUM_BUCKETS];
+      };
+
+      struct Entry {
+        // Offset of the next entry in the bucket chain
+        std::atomic<uint64_t> Next;
+        uint64_t FileOffset;
+        GuestCode Guest;
+        uint64_t HostCodeSize;
+        uint64_t NumRelocations;
+        uint64_t RelocationsSize;
+        // Followed by the host code and then the relocations
+      };
+
+      static_assert(std::atomic<uint64_t>::is_always_lock_free, "Shared memory atomics need to be lock free");
+      static_assert(sizeof(Entry) % alignof(FEXCore::CPU::Relocation) == 0, "Relocations need to stay aligned");
+
+      SharedCodeCache(uint8_t *Base, size_t Size, bool Writable)
+        : Base {Base}
+        , Size {Size}
+        , Writable {Writable} {}
+
+      Header *GetHeader() const { return reinterpret_cast<Header*>(Base); }
+
+      static uint64_t GetBucket(uint64_t FileOffset) {
+        return (FileOffset ^ (FileOffset >> 14)) % NUM_BUCKETS;
+      }
+
+      static uint64_t GetEntrySize(uint64_t HostCodeSize, uint64_t RelocationsSize) {
+        return sizeof(Entry) + GetRelocationsOffset(HostCodeSize) + RelocationsSize;
+      }
+
+      // Relocations follow the host code, aligned so they can be read in place
+      static uint64_t GetRelocationsOffset(uint64_t HostCodeSize) {
+        return (HostCodeSize + 15) & ~15ULL;
+      }
+
+      /**
+       * @brief Walks a bucket chain
+       *
+       * Another process might still be writing the cache so every entry gets bounds checked.
+       */
+      template<typename Fn>
+      Entry const *FindEntry(uint64_t FileOffset, Fn &&Match) const {
+        auto Offset = GetHeader()->Buckets[GetBucket(FileOffset)].load(std::memory_order_acquire);
+        while (Offset != 0) {
+          if (Offset < sizeof(Header) || Offset > Size - sizeof(Entry)) {
+            return nullptr;
+          }
+
+          auto Current = reinterpret_cast<Entry const*>(Base + Offset);
+          if (Current->FileOffset == FileOffset &&
+              Current->HostCodeSize <= Size &&
+              Current->RelocationsSize <= Size &&
+              Offset + GetEntrySize(Current->HostCodeSize, Current->RelocationsSize) <= Size &&
+              Match(Current)) {
+            return Current;
+          }
+          Offset = Current->Next.load(std::memory_order_acquire);
+        }
+        return nullptr;
+      }
+
+      uint8_t *Base;
+      size_t Size;
+      bool Writable;
+  };
+}
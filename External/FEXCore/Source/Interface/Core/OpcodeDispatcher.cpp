@@ -7,6 +7,7 @@ $end_info$
 
 #include "Interface/Context/Context.h"
 #include "Interface/Core/OpcodeDispatcher.h"
+#include "Interface/HLE/Thunks/Thunks.h"
 
 #include <FEXCore/Config/Config.h>
 #include <FEXCore/Core/Context.h>
@@ -124,19 +125,37 @@ void OpDispatchBuilder::ThunkOp(OpcodeArgs) {
 
   const uint8_t GPRSize = CTX->GetGPRSize();
   uint8_t *sha256 = (uint8_t *)(Op->PC + 2);
+  // The guest stub describes the call after the hash, so the IR only depends on guest code
+  const uint8_t ThunkFlags = sha256[sizeof(SHA256Sum)];
 
   if (CTX->Config.Is64BitMode) {
-    // x86-64 ABI puts the function argument in RDI
-    _Thunk(
+    // x86-64 ABI puts the function arguments in RDI, RSI, RDX, RCX, R8 and R9
+    // Thunks with packed arguments only use RDI, register thunks map all of them to the host ABI
+    auto Result = _Thunk(
       LoadGPRRegister(X86State::REG_RDI),
-      *reinterpret_cast<SHA256Sum*>(sha256)
+      LoadGPRRegister(X86State::REG_RSI),
+      LoadGPRRegister(X86State::REG_RDX),
+      LoadGPRRegister(X86State::REG_RCX),
+      LoadGPRRegister(X86State::REG_R8),
+      LoadGPRRegister(X86State::REG_R9),
+      *reinterpret_cast<SHA256Sum*>(sha256),
+      ThunkFlags
     );
+
+    // Only register thunks returning a value define the result, RAX is left alone for the rest
+    if (ThunkFlags & THUNK_FLAG_RESULT) {
+      StoreGPRRegister(X86State::REG_RAX, Result);
+    }
   }
   else {
     // x86 fastcall ABI puts the function argument in ECX
+    // 32-bit guests only use packed arguments
+    auto Zero = _Constant(0);
     _Thunk(
       LoadGPRRegister(X86State::REG_RCX),
-      *reinterpret_cast<SHA256Sum*>(sha256)
+      Zero, Zero, Zero, Zero, Zero,
+      *reinterpret_cast<SHA256Sum*>(sha256),
+      0
     );
   }
 
@@ -3843,26 +3862,25 @@ void OpDispatchBuilder::STOSOp(OpcodeArgs) {
     SetCurrentCodeBlock(LoopTail);
     {
       OrderedNode *Src = LoadSource(GPRClass, Op, Op->Src[0], Op->Flags, -1);
-      OrderedNode *Dest = LoadGPRRegister(X86State::REG_RDI);
+      OrderedNode *TailDest = LoadGPRRegister(X86State::REG_RDI);
 
       // Only ES prefix
-      Dest = AppendSegmentOffset(Dest, 0, FEXCore::X86Tables::DecodeFlags::FLAG_ES_PREFIX, true);
-
-      // Store to memory where RDI points
-      _StoreMemAutoTSO(GPRClass, Size, Dest, Src, Size);
+      OrderedNode *Dest = AppendSegmentOffset(TailDest, 0, FEXCore::X86Tables::DecodeFlags::FLAG_ES_PREFIX, true);
 
       OrderedNode *TailCounter = LoadGPRRegister(X86State::REG_RCX);
-      OrderedNode *TailDest = LoadGPRRegister(X86State::REG_RDI);
+      OrderedNode *Count = GetRepChunkCount(TailCounter, _Constant(REP_CHUNK_SIZE / Size));
+
+      // Store the chunk to memory where RDI points
+      _MemSet(TSOEnabled, Size, Dest, Src, Count, DF);
 
       // Decrement counter
-      TailCounter = _Sub(TailCounter, _Constant(1));
+      TailCounter = _Sub(TailCounter, Count);
 
       // Store the counter so we don't have to deal with PHI here
       StoreGPRRegister(X86State::REG_RCX, TailCounter);
 
-
       // Offset the pointer
-      TailDest = _Add(TailDest, PtrDir);
+      TailDest = _Add(TailDest, _Mul(Count, PtrDir));
       StoreGPRRegister(X86State::REG_RDI, TailDest);
 
       // Jump back to the start, we have more work to do
@@ -3916,31 +3934,35 @@ void OpDispatchBuilder::MOVSOp(OpcodeArgs) {
 
     SetCurrentCodeBlock(LoopTail);
     {
-      OrderedNode *Src = LoadGPRRegister(X86State::REG_RSI);
-      OrderedNode *Dest = LoadGPRRegister(X86State::REG_RDI);
-      Dest = AppendSegmentOffset(Dest, 0, FEXCore::X86Tables::DecodeFlags::FLAG_ES_PREFIX, true);
-      Src = AppendSegmentOffset(Src, Op->Flags, FEXCore::X86Tables::DecodeFlags::FLAG_DS_PREFIX);
-
-      Src = _LoadMemAutoTSO(GPRClass, Size, Src, Size);
+      OrderedNode *TailSrc = LoadGPRRegister(X86State::REG_RSI);
+      OrderedNode *TailDest = LoadGPRRegister(X86State::REG_RDI);
+      OrderedNode *Dest = AppendSegmentOffset(TailDest, 0, FEXCore::X86Tables::DecodeFlags::FLAG_ES_PREFIX, true);
+      OrderedNode *Src = AppendSegmentOffset(TailSrc, Op->Flags, FEXCore::X86Tables::DecodeFlags::FLAG_DS_PREFIX);
 
-      // Store to memory where RDI points
-      _StoreMemAutoTSO(GPRClass, Size, Dest, Src, Size);
+      // Overlapping copies need to see the elements they just wrote and a partially copied chunk can't be repeated,
+      // so those go one element at a time
+      OrderedNode *Distance = _Sub(Dest, Src);
+      Distance = _Select(FEXCore::IR::COND_SLT, Distance, _Constant(0), _Neg(Distance), Distance);
+      OrderedNode *MaxElements = _Select(FEXCore::IR::COND_UGE,
+        Distance, _Constant(REP_CHUNK_SIZE),
+        _Constant(REP_CHUNK_SIZE / Size), _Constant(1));
 
       OrderedNode *TailCounter = LoadGPRRegister(X86State::REG_RCX);
+      OrderedNode *Count = GetRepChunkCount(TailCounter, MaxElements);
+
+      // Copy the chunk from where RSI points to where RDI points
+      _MemCpy(TSOEnabled, Size, Dest, Src, Count, DF);
 
       // Decrement counter
-      TailCounter = _Sub(TailCounter, _Constant(1));
+      TailCounter = _Sub(TailCounter, Count);
 
       // Store the counter so we don't have to deal with PHI here
       StoreGPRRegister(X86State::REG_RCX, TailCounter);
 
-
       // Offset the pointer
-      OrderedNode *TailSrc = LoadGPRRegister(X86State::REG_RSI);
-      OrderedNode *TailDest = LoadGPRRegister(X86State::REG_RDI);
-
-      TailSrc = _Add(TailSrc, PtrDir);
-      TailDest = _Add(TailDest, PtrDir);
+      OrderedNode *Offset = _Mul(Count, PtrDir);
+      TailSrc = _Add(TailSrc, Offset);
+      TailDest = _Add(TailDest, Offset);
       StoreGPRRegister(X86State::REG_RSI, TailSrc);
       StoreGPRRegister(X86State::REG_RDI, TailDest);
 
@@ -4042,16 +4064,25 @@ void OpDispatchBuilder::CMPSOp(OpcodeArgs) {
 
     // Working loop
     {
-      OrderedNode *Dest_RSI = LoadGPRRegister(X86State::REG_RSI);
-      OrderedNode *Dest_RDI = LoadGPRRegister(X86State::REG_RDI);
+      OrderedNode *TailRSI = LoadGPRRegister(X86State::REG_RSI);
+      OrderedNode *TailRDI = LoadGPRRegister(X86State::REG_RDI);
 
       // Only ES prefix
-      Dest_RDI = AppendSegmentOffset(Dest_RDI, 0, FEXCore::X86Tables::DecodeFlags::FLAG_ES_PREFIX, true);
+      OrderedNode *Dest_RDI = AppendSegmentOffset(TailRDI, 0, FEXCore::X86Tables::DecodeFlags::FLAG_ES_PREFIX, true);
       // Default DS prefix
-      Dest_RSI = AppendSegmentOffset(Dest_RSI, Op->Flags, FEXCore::X86Tables::DecodeFlags::FLAG_DS_PREFIX);
+      OrderedNode *Dest_RSI = AppendSegmentOffset(TailRSI, Op->Flags, FEXCore::X86Tables::DecodeFlags::FLAG_DS_PREFIX);
+
+      OrderedNode *TailCounter = LoadGPRRegister(X86State::REG_RCX);
+      OrderedNode *Count = GetRepChunkCount(TailCounter, _Constant(REP_CHUNK_SIZE / Size));
 
-      auto Src1 = _LoadMemAutoTSO(GPRClass, Size, Dest_RDI, Size);
-      auto Src2 = _LoadMem(GPRClass, Size, Dest_RSI, Size);
+      // Walk the chunk up to and including the element pair that ends the repeat
+      OrderedNode *Compared = _MemCmp(TSOEnabled, Size, Dest_RDI, Dest_RSI, Count, DF, REPE);
+      OrderedNode *Offset = _Mul(Compared, PtrDir);
+
+      // Flags come from the last element pair compared
+      OrderedNode *LastOffset = _Sub(Offset, PtrDir);
+      auto Src1 = _LoadMemAutoTSO(GPRClass, Size, _Add(Dest_RDI, LastOffset), Size);
+      auto Src2 = _LoadMemAutoTSO(GPRClass, Size, _Add(Dest_RSI, LastOffset), Size);
 
       OrderedNode* Result = _Sub(Src2, Src1);
       if (Size < 4)
@@ -4062,21 +4093,19 @@ void OpDispatchBuilder::CMPSOp(OpcodeArgs) {
       // Calculate flags early.
       CalculateDeferredFlags();
 
-      OrderedNode *TailCounter = LoadGPRRegister(X86State::REG_RCX);
-
       // Decrement counter
-      TailCounter = _Sub(TailCounter, _Constant(1));
+      TailCounter = _Sub(TailCounter, Compared);
 
       // Store the counter so we don't have to deal with PHI here
       StoreGPRRegister(X86State::REG_RCX, TailCounter);
 
       // Offset the pointer
-      Dest_RDI = _Add(Dest_RDI, PtrDir);
-      StoreGPRRegister(X86State::REG_RDI, Dest_RDI);
+      TailRDI = _Add(TailRDI, Offset);
+      StoreGPRRegister(X86State::REG_RDI, TailRDI);
 
       // Offset second pointer
-      Dest_RSI = _Add(Dest_RSI, PtrDir);
-      StoreGPRRegister(X86State::REG_RSI, Dest_RSI);
+      TailRSI = _Add(TailRSI, Offset);
+      StoreGPRRegister(X86State::REG_RSI, TailRSI);
 
       OrderedNode *ZF = GetRFLAG(FEXCore::X86State::RFLAG_ZF_LOC);
       InternalCondJump = _CondJump(ZF, {REPE ? COND_NEQ : COND_EQ});
@@ -4798,6 +4827,10 @@ void OpDispatchBuilder::Finalize() {
     SetCurrentCodeBlock(Handler.second.BlockEntry);
     _ExitFunction(_EntrypointOffset(Handler.first - Entry, GPRSize));
   }
+
+#ifndef FEX_DISABLE_TELEMETRY
+  FlushFlagTelemetry();
+#endif
 }
 
 uint8_t OpDispatchBuilder::GetDstSize(X86Tables::DecodedOp Op) const {
@@ -5331,14 +5364,12 @@ void OpDispatchBuilder::StoreResult(FEXCore::IR::RegisterClassType Class, FEXCor
 }
 
 OpDispatchBuilder::OpDispatchBuilder(FEXCore::Context::Context *ctx)
-  : IREmitter {ctx->OpDispatcherAllocator}
-  , CTX {ctx} {
+  : CTX {ctx} {
   ResetWorkingList();
   InstallHostSpecificOpcodeHandlers();
 }
-OpDispatchBuilder::OpDispatchBuilder(FEXCore::Utils::IntrusivePooledAllocator &Allocator)
-  : IREmitter {Allocator}
-  , CTX {nullptr} {
+OpDispatchBuilder::OpDispatchBuilder()
+  : CTX {nullptr} {
 }
 
 void OpDispatchBuilder::ResetWorkingList() {
@@ -5348,6 +5379,10 @@ void OpDispatchBuilder::ResetWorkingList() {
   DecodeFailure = false;
   ShouldDump = false;
   CurrentCodeBlock = nullptr;
+#ifndef FEX_DISABLE_TELEMETRY
+  FlagReads.fill(0);
+  FlagWrites.fill(0);
+#endif
 }
 
 void OpDispatchBuilder::UnhandledOp(OpcodeArgs) {
@@ -5946,6 +5981,10 @@ void OpDispatchBuilder::InstallHostSpecificOpcodeHandlers() {
     {OPD(1, 0b01, 0x6F), 1, &OpDispatchBuilder::VMOVAPS_VMOVAPD_Op},
     {OPD(1, 0b10, 0x6F), 1, &OpDispatchBuilder::VMOVUPS_VMOVUPD_Op},
 
+    {OPD(1, 0b01, 0x70), 1, &OpDispatchBuilder::VPERMILImmOp<4>},
+    {OPD(1, 0b10, 0x70), 1, &OpDispatchBuilder::VPSHUFWOp<false>},
+    {OPD(1, 0b11, 0x70), 1, &OpDispatchBuilder::VPSHUFWOp<true>},
+
     {OPD(1, 0b01, 0x74), 1, &OpDispatchBuilder::AVXVectorALUOp<IR::OP_VCMPEQ, 1>},
     {OPD(1, 0b01, 0x75), 1, &OpDispatchBuilder::AVXVectorALUOp<IR::OP_VCMPEQ, 2>},
     {OPD(1, 0b01, 0x76), 1, &OpDispatchBuilder::AVXVectorALUOp<IR::OP_VCMPEQ, 4>},
@@ -5977,7 +6016,7 @@ void OpDispatchBuilder::InstallHostSpecificOpcodeHandlers() {
     {OPD(1, 0b01, 0xD4), 1, &OpDispatchBuilder::AVXVectorALUOp<IR::OP_VADD, 8>},
     {OPD(1, 0b01, 0xD5), 1, &OpDispatchBuilder::AVXVectorALUOp<IR::OP_VSMUL, 2>},
     {OPD(1, 0b01, 0xD6), 1, &OpDispatchBuilder::MOVQOp},
-    {OPD(1, 0b01, 0xD7), 1, &OpDispatchBuilder::UnimplementedOp},
+    {OPD(1, 0b01, 0xD7), 1, &OpDispatchBuilder::VPMOVMSKBOp},
 
     {OPD(1, 0b01, 0xD8), 1, &OpDispatchBuilder::AVXVectorALUOp<IR::OP_VUQSUB, 1>},
     {OPD(1, 0b01, 0xD9), 1, &OpDispatchBuilder::AVXVectorALUOp<IR::OP_VUQSUB, 2>},
@@ -6015,6 +6054,7 @@ void OpDispatchBuilder::InstallHostSpecificOpcodeHandlers() {
     {OPD(1, 0b01, 0xF2), 1, &OpDispatchBuilder::VPSLLOp<4>},
     {OPD(1, 0b01, 0xF3), 1, &OpDispatchBuilder::VPSLLOp<8>},
     {OPD(1, 0b01, 0xF4), 1, &OpDispatchBuilder::VPMULLOp<4, false>},
+    {OPD(1, 0b01, 0xF5), 1, &OpDispatchBuilder::VPMADDWDOp},
     {OPD(1, 0b01, 0xF7), 1, &OpDispatchBuilder::MASKMOVOp},
 
     {OPD(1, 0b01, 0xF8), 1, &OpDispatchBuilder::AVXVectorALUOp<IR::OP_VSUB, 1>},
@@ -6025,9 +6065,12 @@ void OpDispatchBuilder::InstallHostSpecificOpcodeHandlers() {
     {OPD(1, 0b01, 0xFD), 1, &OpDispatchBuilder::AVXVectorALUOp<IR::OP_VADD, 2>},
     {OPD(1, 0b01, 0xFE), 1, &OpDispatchBuilder::AVXVectorALUOp<IR::OP_VADD, 4>},
 
+    {OPD(2, 0b01, 0x00), 1, &OpDispatchBuilder::VPSHUFBOp},
     {OPD(2, 0b01, 0x01), 1, &OpDispatchBuilder::VHADDPOp<IR::OP_VADDP, 2>},
     {OPD(2, 0b01, 0x02), 1, &OpDispatchBuilder::VHADDPOp<IR::OP_VADDP, 4>},
 
+    {OPD(2, 0b01, 0x04), 1, &OpDispatchBuilder::VPMADDUBSWOp},
+
     {OPD(2, 0b01, 0x05), 1, &OpDispatchBuilder::VPHSUBOp<2>},
     {OPD(2, 0b01, 0x06), 1, &OpDispatchBuilder::VPHSUBOp<4>},
 
@@ -6036,6 +6079,8 @@ void OpDispatchBuilder::InstallHostSpecificOpcodeHandlers() {
     {OPD(2, 0b01, 0x0A), 1, &OpDispatchBuilder::VPSIGN<4>},
     {OPD(2, 0b01, 0x0B), 1, &OpDispatchBuilder::VPMULHRSWOp},
 
+    {OPD(2, 0b01, 0x16), 1, &OpDispatchBuilder::VPERMDOp},
+
     {OPD(2, 0b01, 0x18), 1, &OpDispatchBuilder::VBROADCASTOp<4>},
     {OPD(2, 0b01, 0x19), 1, &OpDispatchBuilder::VBROADCASTOp<8>},
     {OPD(2, 0b01, 0x1A), 1, &OpDispatchBuilder::VBROADCASTOp<16>},
@@ -6061,7 +6106,7 @@ void OpDispatchBuilder::InstallHostSpecificOpcodeHandlers() {
     {OPD(2, 0b01, 0x33), 1, &OpDispatchBuilder::AVXExtendVectorElements<2, 4, false>},
     {OPD(2, 0b01, 0x34), 1, &OpDispatchBuilder::AVXExtendVectorElements<2, 8, false>},
     {OPD(2, 0b01, 0x35), 1, &OpDispatchBuilder::AVXExtendVectorElements<4, 8, false>},
-
+    {OPD(2, 0b01, 0x36), 1, &OpDispatchBuilder::VPERMDOp},
     {OPD(2, 0b01, 0x37), 1, &OpDispatchBuilder::AVXVectorALUOp<IR::OP_VCMPGT, 8>},
     {OPD(2, 0b01, 0x38), 1, &OpDispatchBuilder::AVXVectorALUOp<IR::OP_VSMIN, 1>},
     {OPD(2, 0b01, 0x39), 1, &OpDispatchBuilder::AVXVectorALUOp<IR::OP_VSMIN, 4>},
@@ -6074,7 +6119,9 @@ void OpDispatchBuilder::InstallHostSpecificOpcodeHandlers() {
 
     {OPD(2, 0b01, 0x40), 1, &OpDispatchBuilder::AVXVectorALUOp<IR::OP_VSMUL, 4>},
     {OPD(2, 0b01, 0x41), 1, &OpDispatchBuilder::VPHMINPOSUWOp},
+    {OPD(2, 0b01, 0x45), 1, &OpDispatchBuilder::VPSxLVOp<true>},
     {OPD(2, 0b01, 0x46), 1, &OpDispatchBuilder::VPSRAVDOp},
+    {OPD(2, 0b01, 0x47), 1, &OpDispatchBuilder::VPSxLVOp<false>},
 
     {OPD(2, 0b01, 0x58), 1, &OpDispatchBuilder::VBROADCASTOp<4>},
     {OPD(2, 0b01, 0x59), 1, &OpDispatchBuilder::VBROADCASTOp<8>},
@@ -6083,6 +6130,11 @@ void OpDispatchBuilder::InstallHostSpecificOpcodeHandlers() {
     {OPD(2, 0b01, 0x78), 1, &OpDispatchBuilder::VBROADCASTOp<1>},
     {OPD(2, 0b01, 0x79), 1, &OpDispatchBuilder::VBROADCASTOp<2>},
 
+    {OPD(2, 0b01, 0x90), 1, &OpDispatchBuilder::VPGATHEROp<4>},
+    {OPD(2, 0b01, 0x91), 1, &OpDispatchBuilder::VPGATHEROp<8>},
+    {OPD(2, 0b01, 0x92), 1, &OpDispatchBuilder::VPGATHEROp<4>},
+    {OPD(2, 0b01, 0x93), 1, &OpDispatchBuilder::VPGATHEROp<8>},
+
     {OPD(2, 0b01, 0xDB), 1, &OpDispatchBuilder::VAESIMCOp},
     {OPD(2, 0b01, 0xDC), 1, &OpDispatchBuilder::VAESEncOp},
     {OPD(2, 0b01, 0xDD), 1, &OpDispatchBuilder::VAESEncLastOp},
@@ -6091,6 +6143,7 @@ void OpDispatchBuilder::InstallHostSpecificOpcodeHandlers() {
 
     {OPD(3, 0b01, 0x00), 1, &OpDispatchBuilder::VPERMQOp},
     {OPD(3, 0b01, 0x01), 1, &OpDispatchBuilder::VPERMQOp},
+    {OPD(3, 0b01, 0x02), 1, &OpDispatchBuilder::VPBLENDDOp},
     {OPD(3, 0b01, 0x04), 1, &OpDispatchBuilder::VPERMILImmOp<4>},
     {OPD(3, 0b01, 0x05), 1, &OpDispatchBuilder::VPERMILImmOp<8>},
     {OPD(3, 0b01, 0x06), 1, &OpDispatchBuilder::VPERM2Op},
@@ -6105,10 +6158,12 @@ void OpDispatchBuilder::InstallHostSpecificOpcodeHandlers() {
     {OPD(3, 0b01, 0x17), 1, &OpDispatchBuilder::PExtrOp<4>},
 
     {OPD(3, 0b01, 0x18), 1, &OpDispatchBuilder::VINSERTOp},
+    {OPD(3, 0b01, 0x19), 1, &OpDispatchBuilder::VEXTRACT128Op},
 
     {OPD(3, 0b01, 0x21), 1, &OpDispatchBuilder::VINSERTPSOp},
 
     {OPD(3, 0b01, 0x38), 1, &OpDispatchBuilder::VINSERTOp},
+    {OPD(3, 0b01, 0x39), 1, &OpDispatchBuilder::VEXTRACT128Op},
 
     {OPD(3, 0b01, 0x40), 1, &OpDispatchBuilder::VDPPOp<4>},
     {OPD(3, 0b01, 0x41), 1, &OpDispatchBuilder::VDPPOp<8>},
@@ -6117,6 +6172,47 @@ void OpDispatchBuilder::InstallHostSpecificOpcodeHandlers() {
 
     {OPD(3, 0b01, 0xDF), 1, &OpDispatchBuilder::VAESKeyGenAssistOp},
   };
+
+  // VEX.W selects between the PS/PD and SS/SD forms
+  static constexpr std::tuple<uint16_t, uint8_t, FEXCore::X86Tables::OpDispatchPtr> VEX_FMA[] = {
+    {OPD(2, 0b01, 0x96), 1, &OpDispatchBuilder::VFMAddSubOp<true, 1, 3, 2>},
+    {OPD(2, 0b01, 0x97), 1, &OpDispatchBuilder::VFMAddSubOp<false, 1, 3, 2>},
+    {OPD(2, 0b01, 0x98), 1, &OpDispatchBuilder::VFMAOp<IR::OP_VFMLA, false, 1, 3, 2>},
+    {OPD(2, 0b01, 0x99), 1, &OpDispatchBuilder::VFMAOp<IR::OP_VFMLA, true, 1, 3, 2>},
+    {OPD(2, 0b01, 0x9A), 1, &OpDispatchBuilder::VFMAOp<IR::OP_VFMLS, false, 1, 3, 2>},
+    {OPD(2, 0b01, 0x9B), 1, &OpDispatchBuilder::VFMAOp<IR::OP_VFMLS, true, 1, 3, 2>},
+    {OPD(2, 0b01, 0x9C), 1, &OpDispatchBuilder::VFMAOp<IR::OP_VFNMLA, false, 1, 3, 2>},
+    {OPD(2, 0b01, 0x9D), 1, &OpDispatchBuilder::VFMAOp<IR::OP_VFNMLA, true, 1, 3, 2>},
+    {OPD(2, 0b01, 0x9E), 1, &OpDispatchBuilder::VFMAOp<IR::OP_VFNMLS, false, 1, 3, 2>},
+    {OPD(2, 0b01, 0x9F), 1, &OpDispatchBuilder::VFMAOp<IR::OP_VFNMLS, true, 1, 3, 2>},
+
+    {OPD(2, 0b01, 0xA6), 1, &OpDispatchBuilder::VFMAddSubOp<true, 2, 1, 3>},
+    {OPD(2, 0b01, 0xA7), 1, &OpDispatchBuilder::VFMAddSubOp<false, 2, 1, 3>},
+    {OPD(2, 0b01, 0xA8), 1, &OpDispatchBuilder::VFMAOp<IR::OP_VFMLA, false, 2, 1, 3>},
+    {OPD(2, 0b01, 0xA9), 1, &OpDispatchBuilder::VFMAOp<IR::OP_VFMLA, true, 2, 1, 3>},
+    {OPD(2, 0b01, 0xAA), 1, &OpDispatchBuilder::VFMAOp<IR::OP_VFMLS, false, 2, 1, 3>},
+    {OPD(2, 0b01, 0xAB), 1, &OpDispatchBuilder::VFMAOp<IR::OP_VFMLS, true, 2, 1, 3>},
+    {OPD(2, 0b01, 0xAC), 1, &OpDispatchBuilder::VFMAOp<IR::OP_VFNMLA, false, 2, 1, 3>},
+    {OPD(2, 0b01, 0xAD), 1, &OpDispatchBuilder::VFMAOp<IR::OP_VFNMLA, true, 2, 1, 3>},
+    {OPD(2, 0b01, 0xAE), 1, &OpDispatchBuilder::VFMAOp<IR::OP_VFNMLS, false, 2, 1, 3>},
+    {OPD(2, 0b01, 0xAF), 1, &OpDispatchBuilder::VFMAOp<IR::OP_VFNMLS, true, 2, 1, 3>},
+
+    {OPD(2, 0b01, 0xB6), 1, &OpDispatchBuilder::VFMAddSubOp<true, 2, 3, 1>},
+    {OPD(2, 0b01, 0xB7), 1, &OpDispatchBuilder::VFMAddSubOp<false, 2, 3, 1>},
+    {OPD(2, 0b01, 0xB8), 1, &OpDispatchBuilder::VFMAOp<IR::OP_VFMLA, false, 2, 3, 1>},
+    {OPD(2, 0b01, 0xB9), 1, &OpDispatchBuilder::VFMAOp<IR::OP_VFMLA, true, 2, 3, 1>},
+    {OPD(2, 0b01, 0xBA), 1, &OpDispatchBuilder::VFMAOp<IR::OP_VFMLS, false, 2, 3, 1>},
+    {OPD(2, 0b01, 0xBB), 1, &OpDispatchBuilder::VFMAOp<IR::OP_VFMLS, true, 2, 3, 1>},
+    {OPD(2, 0b01, 0xBC), 1, &OpDispatchBuilder::VFMAOp<IR::OP_VFNMLA, false, 2, 3, 1>},
+    {OPD(2, 0b01, 0xBD), 1, &OpDispatchBuilder::VFMAOp<IR::OP_VFNMLA, true, 2, 3, 1>},
+    {OPD(2, 0b01, 0xBE), 1, &OpDispatchBuilder::VFMAOp<IR::OP_VFNMLS, false, 2, 3, 1>},
+    {OPD(2, 0b01, 0xBF), 1, &OpDispatchBuilder::VFMAOp<IR::OP_VFNMLS, true, 2, 3, 1>},
+  };
+
+  static constexpr std::tuple<uint16_t, uint8_t, FEXCore::X86Tables::OpDispatchPtr> VEX_F16C[] = {
+    {OPD(2, 0b01, 0x13), 1, &OpDispatchBuilder::VCVTPH2PSOp},
+    {OPD(3, 0b01, 0x1D), 1, &OpDispatchBuilder::VCVTPS2PHOp},
+  };
 #undef OPD
 
 #define OPD(group, pp, opcode) (((group - X86Tables::TYPE_VEX_GROUP_12) << 4) | (pp << 3) | (opcode))
@@ -6172,6 +6268,14 @@ void OpDispatchBuilder::InstallHostSpecificOpcodeHandlers() {
   if (CTX->HostFeatures.SupportsAVX) {
     InstallToTable(FEXCore::X86Tables::VEXTableOps, AVXTable);
     InstallToTable(FEXCore::X86Tables::VEXTableGroupOps, VEXTableGroupOps);
+
+    if (CTX->HostFeatures.SupportsFMA) {
+      InstallToTable(FEXCore::X86Tables::VEXTableOps, VEX_FMA);
+    }
+
+    if (CTX->HostFeatures.SupportsF16C) {
+      InstallToTable(FEXCore::X86Tables::VEXTableOps, VEX_F16C);
+    }
   }
 
   if (CTX->HostFeatures.SupportsPMULL_128Bit) {
@@ -7404,6 +7508,15 @@ constexpr uint16_t PF_F2 = 3;
     {OPD(0, PF_3A_66,   0x41), 1, &OpDispatchBuilder::DPPOp<8>},
     {OPD(0, PF_3A_66,   0x42), 1, &OpDispatchBuilder::MPSADBWOp},
 
+    {OPD(0, PF_3A_66,   0x60), 1, &OpDispatchBuilder::PCMPESTRMOp},
+    {OPD(1, PF_3A_66,   0x60), 1, &OpDispatchBuilder::PCMPESTRMOp},
+    {OPD(0, PF_3A_66,   0x61), 1, &OpDispatchBuilder::PCMPESTRIOp},
+    {OPD(1, PF_3A_66,   0x61), 1, &OpDispatchBuilder::PCMPESTRIOp},
+    {OPD(0, PF_3A_66,   0x62), 1, &OpDispatchBuilder::PCMPISTRMOp},
+    {OPD(1, PF_3A_66,   0x62), 1, &OpDispatchBuilder::PCMPISTRMOp},
+    {OPD(0, PF_3A_66,   0x63), 1, &OpDispatchBuilder::PCMPISTRIOp},
+    {OPD(1, PF_3A_66,   0x63), 1, &OpDispatchBuilder::PCMPISTRIOp},
+
     {OPD(0, PF_3A_NONE, 0xCC), 1, &OpDispatchBuilder::SHA1RNDS4Op},
   };
 #undef PF_3A_NONE
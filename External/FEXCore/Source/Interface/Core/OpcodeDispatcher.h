@@ -13,6 +13,7 @@
 
 #include <FEXCore/Utils/LogManager.h>
 
+#include <array>
 #include <cstdint>
 #include <fmt/format.h>
 #include <map>
@@ -150,7 +151,7 @@ public:
   }
 
   OpDispatchBuilder(FEXCore::Context::Context *ctx);
-  OpDispatchBuilder(FEXCore::Utils::IntrusivePooledAllocator &Allocator);
+  OpDispatchBuilder();
 
   void ResetWorkingList();
   void ResetDecodeFailure() { NeedsBlockEnd = DecodeFailure = false; }
@@ -440,9 +441,20 @@ public:
   template <size_t ElementSize>
   void VBROADCASTOp(OpcodeArgs);
 
+  void VCVTPH2PSOp(OpcodeArgs);
+  void VCVTPS2PHOp(OpcodeArgs);
+
+  void VEXTRACT128Op(OpcodeArgs);
+
   template <size_t ElementSize>
   void VDPPOp(OpcodeArgs);
 
+  template <IROps IROp, bool Scalar, uint8_t Src1Idx, uint8_t Src2Idx, uint8_t AddendIdx>
+  void VFMAOp(OpcodeArgs);
+
+  template <bool AddSub, uint8_t Src1Idx, uint8_t Src2Idx, uint8_t AddendIdx>
+  void VFMAddSubOp(OpcodeArgs);
+
   template <IROps IROp, size_t ElementSize>
   void VHADDPOp(OpcodeArgs);
 
@@ -467,17 +479,28 @@ public:
   template <size_t ElementSize>
   void VPACKUSOp(OpcodeArgs);
 
+  void VPBLENDDOp(OpcodeArgs);
+
   void VPERM2Op(OpcodeArgs);
+  void VPERMDOp(OpcodeArgs);
   void VPERMQOp(OpcodeArgs);
 
   template <size_t ElementSize>
   void VPERMILImmOp(OpcodeArgs);
 
+  template <size_t AddrElementSize>
+  void VPGATHEROp(OpcodeArgs);
+
   void VPHMINPOSUWOp(OpcodeArgs);
 
   template <size_t ElementSize>
   void VPHSUBOp(OpcodeArgs);
 
+  void VPMADDUBSWOp(OpcodeArgs);
+  void VPMADDWDOp(OpcodeArgs);
+
+  void VPMOVMSKBOp(OpcodeArgs);
+
   void VPMULHRSWOp(OpcodeArgs);
 
   template <bool Signed>
@@ -492,6 +515,11 @@ public:
   template <size_t ElementSize>
   void VPSLLIOp(OpcodeArgs);
 
+  void VPSHUFBOp(OpcodeArgs);
+
+  template <bool Low>
+  void VPSHUFWOp(OpcodeArgs);
+
   template <size_t ElementSize>
   void VPSRAOp(OpcodeArgs);
 
@@ -500,6 +528,9 @@ public:
 
   void VPSRAVDOp(OpcodeArgs);
 
+  template <bool Right>
+  void VPSxLVOp(OpcodeArgs);
+
   template <size_t ElementSize>
   void VPSRLDOp(OpcodeArgs);
   void VPSRLDQOp(OpcodeArgs);
@@ -732,6 +763,10 @@ public:
   void DPPOp(OpcodeArgs);
 
   void MPSADBWOp(OpcodeArgs);
+  void PCMPESTRMOp(OpcodeArgs);
+  void PCMPESTRIOp(OpcodeArgs);
+  void PCMPISTRMOp(OpcodeArgs);
+  void PCMPISTRIOp(OpcodeArgs);
   void PCLMULQDQOp(OpcodeArgs);
   void VPCLMULQDQOp(OpcodeArgs);
 
@@ -745,6 +780,7 @@ public:
   OrderedNode *GetPackedRFLAG(bool Lower8);
 
   void SetMultiblock(bool _Multiblock) { Multiblock = _Multiblock; }
+  void SetTSOEnabled(bool _TSOEnabled) { TSOEnabled = _TSOEnabled; }
 
   bool HandledLock = false;
 private:
@@ -762,7 +798,15 @@ private:
   void AVXVectorScalarALUOpImpl(OpcodeArgs, IROps IROp, size_t ElementSize);
   void AVXVectorUnaryOpImpl(OpcodeArgs, IROps IROp, size_t ElementSize, bool Scalar);
 
+  std::array<OrderedNode*, 3> LoadVFMAOperands(OpcodeArgs, size_t Size, size_t ElementSize, bool Scalar);
+  void VFMAImpl(OpcodeArgs, IROps IROp, bool Scalar, uint8_t Src1Idx, uint8_t Src2Idx, uint8_t AddendIdx);
+  void VFMAddSubImpl(OpcodeArgs, bool AddSub, uint8_t Src1Idx, uint8_t Src2Idx, uint8_t AddendIdx);
+
   OrderedNode* AESKeyGenAssistImpl(OpcodeArgs);
+
+  OrderedNode* PCMPXSTRXExplicitLength(OpcodeArgs, uint32_t GPR, uint32_t NumElements);
+  OrderedNode* PCMPXSTRXImplicitLength(OrderedNode *Src, uint32_t ElementSize);
+  void PCMPXSTRXOpImpl(OpcodeArgs, bool IsExplicit, bool IsMask);
   OrderedNode* AESIMCImpl(OpcodeArgs);
 
   OrderedNode* DPPOpImpl(OpcodeArgs, const X86Tables::DecodedOperand& Src1,
@@ -787,6 +831,12 @@ private:
   OrderedNode* PHSUBOpImpl(OpcodeArgs, const X86Tables::DecodedOperand& Src1,
                            const X86Tables::DecodedOperand& Src2, size_t ElementSize);
 
+  OrderedNode* PMADDUBSWOpImpl(OpcodeArgs, OrderedNode *Src1, OrderedNode *Src2);
+
+  OrderedNode* PMADDWDOpImpl(OpcodeArgs, OrderedNode *Src1, OrderedNode *Src2);
+
+  OrderedNode* PMOVMSKBOpImpl(OpcodeArgs, OrderedNode *Src);
+
   OrderedNode* PMULHRSWOpImpl(OpcodeArgs, OrderedNode *Src1, OrderedNode *Src2);
 
   OrderedNode* PMULHWOpImpl(OpcodeArgs, bool Signed,
@@ -869,19 +919,39 @@ private:
 
   template<unsigned BitOffset>
   void SetRFLAG(OrderedNode *Value) {
-    flagsOp = SelectionFlag::Nothing;
-    _StoreFlag(_Bfe(1, 0, Value), BitOffset);
+    SetRFLAG(Value, BitOffset);
   }
 
-  void SetRFLAG(OrderedNode *Value, unsigned BitOffset) {
-    flagsOp = SelectionFlag::Nothing;
-    _StoreFlag(_Bfe(1, 0, Value), BitOffset);
+  void SetRFLAG(OrderedNode *Value, unsigned BitOffset);
+  OrderedNode *GetRFLAG(unsigned BitOffset);
+
+  /**
+   * @name Lazy PF and AF calculation.
+   *
+   * PF and AF are rarely consumed, so their flag slots hold what the flags are calculated from instead of the bits.
+   * The PF slot holds a byte that has even parity when PF is set.
+   * The AF slot holds a value that has AF in bit 4 once xor'd with the PF slot.
+   * GetRFLAG and SetRFLAG convert to and from the bits, so only PUSHF, LAHF, JP and friends pay for the calculation.
+   * @{ */
+
+  // Stores the result that PF is calculated from
+  // AF is relative to this so must be stored after it
+  void SetPFRaw(OrderedNode *Res);
+  // Stores the value that AF is calculated from, relative to the last PF store
+  void SetAFRaw(OrderedNode *Value);
+
+  OrderedNode *LoadPFRaw() {
+    return _LoadFlag(X86State::RFLAG_PF_LOC);
   }
 
-  OrderedNode *GetRFLAG(unsigned BitOffset) {
-    return _LoadFlag(BitOffset);
+  OrderedNode *LoadAFRaw() {
+    return _LoadFlag(X86State::RFLAG_AF_LOC);
   }
 
+  // Clears both PF and AF, which a lot of instructions leave undefined
+  void ZeroPFAF();
+  /**  @} */
+
   OrderedNode *SelectCC(uint8_t OP, OrderedNode *TrueValue, OrderedNode *FalseValue);
 
   /**
@@ -1422,21 +1492,41 @@ private:
     return !Op->Dest.IsGPR();
   }
 
+  // REP string ops hand at most this many bytes at a time to the bulk memory ops.
+  // RCX, RSI and RDI are written back after every chunk, so a fault only repeats the chunk it happened in.
+  constexpr static uint64_t REP_CHUNK_SIZE = 4096;
+
+  // Number of elements the next chunk of a REP string op covers
+  OrderedNode *GetRepChunkCount(OrderedNode *Counter, OrderedNode *MaxElements) {
+    return _Select(FEXCore::IR::COND_ULT, Counter, MaxElements, Counter, MaxElements);
+  }
+
   void CreateJumpBlocks(std::vector<FEXCore::Frontend::Decoder::DecodedBlocks> const *Blocks);
   bool BlockSetRIP {false};
 
+#ifndef FEX_DISABLE_TELEMETRY
+  // Per compile count of the CF, PF, AF, ZF, SF and OF accesses the guest code does
+  // Flushed in to telemetry once the compile is finalized
+  std::array<uint32_t, 6> FlagReads{};
+  std::array<uint32_t, 6> FlagWrites{};
+  void CountFlagAccess(std::array<uint32_t, 6> &Counts, unsigned BitOffset);
+  void FlushFlagTelemetry();
+#endif
+
   bool Multiblock{};
+  // Whether the current compilation unit uses TSO memory operations
+  bool TSOEnabled{};
   uint64_t Entry;
 
   OrderedNode* _StoreMemAutoTSO(FEXCore::IR::RegisterClassType Class, uint8_t Size, OrderedNode *Addr, OrderedNode *Value, uint8_t Align = 1) {
-    if (CTX->IsTSOEnabled())
+    if (TSOEnabled)
       return _StoreMemTSO(Class, Size, Value, Addr, Invalid(), Align, MEM_OFFSET_SXTX, 1);
     else
       return _StoreMem(Class, Size, Value, Addr, Invalid(), Align, MEM_OFFSET_SXTX, 1);
   }
 
   OrderedNode* _LoadMemAutoTSO(FEXCore::IR::RegisterClassType Class, uint8_t Size, OrderedNode *ssa0, uint8_t Align = 1) {
-    if (CTX->IsTSOEnabled())
+    if (TSOEnabled)
       return _LoadMemTSO(Class, Size, ssa0, Invalid(), Align, MEM_OFFSET_SXTX, 1);
     else
       return _LoadMem(Class, Size, ssa0, Invalid(), Align, MEM_OFFSET_SXTX, 1);
@@ -12,6 +12,7 @@ $end_info$
 #include <FEXCore/Config/Config.h>
 #include <FEXCore/Debug/X86Tables.h>
 #include <FEXCore/Utils/LogManager.h>
+#include <FEXCore/Utils/Telemetry.h>
 #include <FEXCore/IR/IR.h>
 
 #include <array>
@@ -72,7 +73,7 @@ OrderedNode *OpDispatchBuilder::GetPackedRFLAG(bool Lower8) {
 
   for (size_t i = 0; i < NumFlags; ++i) {
     const auto FlagOffset = FlagOffsets[i];
-    OrderedNode *Flag = _LoadFlag(FlagOffset);
+    OrderedNode *Flag = GetRFLAG(FlagOffset);
     Flag = _Bfe(4, 32, 0, Flag);
     Flag = _Lshl(Flag, _Constant(FlagOffset));
     Original = _Or(Original, Flag);
@@ -80,6 +81,98 @@ OrderedNode *OpDispatchBuilder::GetPackedRFLAG(bool Lower8) {
   return Original;
 }
 
+void OpDispatchBuilder::SetRFLAG(OrderedNode *Value, unsigned BitOffset) {
+  flagsOp = SelectionFlag::Nothing;
+#ifndef FEX_DISABLE_TELEMETRY
+  CountFlagAccess(FlagWrites, BitOffset);
+#endif
+  Value = _Bfe(1, 0, Value);
+
+  if (BitOffset == X86State::RFLAG_PF_LOC) {
+    // AF is stored relative to PF, so it needs to be stored again to keep its value
+    auto OldPFRaw = LoadPFRaw();
+    auto AF = _Bfe(1, 4, _Xor(LoadAFRaw(), OldPFRaw));
+
+    // A single set bit has odd parity, so store the inverse
+    auto PFRaw = _Xor(Value, _Constant(1));
+    _StoreFlag(PFRaw, X86State::RFLAG_PF_LOC);
+    _StoreFlag(_Xor(_Lshl(AF, _Constant(4)), PFRaw), X86State::RFLAG_AF_LOC);
+  }
+  else if (BitOffset == X86State::RFLAG_AF_LOC) {
+    _StoreFlag(_Xor(_Lshl(Value, _Constant(4)), LoadPFRaw()), X86State::RFLAG_AF_LOC);
+  }
+  else {
+    _StoreFlag(Value, BitOffset);
+  }
+}
+
+OrderedNode *OpDispatchBuilder::GetRFLAG(unsigned BitOffset) {
+#ifndef FEX_DISABLE_TELEMETRY
+  CountFlagAccess(FlagReads, BitOffset);
+#endif
+
+  if (BitOffset == X86State::RFLAG_PF_LOC) {
+    // The raw PF value might be forwarded from a full sized store, only the lower byte counts
+    auto Parity = _Popcount(_And(LoadPFRaw(), _Constant(0xFF)));
+    return _Bfe(1, 0, _Xor(Parity, _Constant(1)));
+  }
+  else if (BitOffset == X86State::RFLAG_AF_LOC) {
+    return _Bfe(1, 4, _Xor(LoadAFRaw(), LoadPFRaw()));
+  }
+
+  return _LoadFlag(BitOffset);
+}
+
+void OpDispatchBuilder::SetPFRaw(OrderedNode *Res) {
+  flagsOp = SelectionFlag::Nothing;
+#ifndef FEX_DISABLE_TELEMETRY
+  CountFlagAccess(FlagWrites, X86State::RFLAG_PF_LOC);
+#endif
+  _StoreFlag(Res, X86State::RFLAG_PF_LOC);
+}
+
+void OpDispatchBuilder::SetAFRaw(OrderedNode *Value) {
+  flagsOp = SelectionFlag::Nothing;
+#ifndef FEX_DISABLE_TELEMETRY
+  CountFlagAccess(FlagWrites, X86State::RFLAG_AF_LOC);
+#endif
+  _StoreFlag(Value, X86State::RFLAG_AF_LOC);
+}
+
+void OpDispatchBuilder::ZeroPFAF() {
+  // Odd parity clears PF, and matching values clear AF
+  auto OneConst = _Constant(1);
+  SetPFRaw(OneConst);
+  SetAFRaw(OneConst);
+}
+
+#ifndef FEX_DISABLE_TELEMETRY
+void OpDispatchBuilder::CountFlagAccess(std::array<uint32_t, 6> &Counts, unsigned BitOffset) {
+  switch (BitOffset) {
+    case X86State::RFLAG_CF_LOC: Counts[0]++; break;
+    case X86State::RFLAG_PF_LOC: Counts[1]++; break;
+    case X86State::RFLAG_AF_LOC: Counts[2]++; break;
+    case X86State::RFLAG_ZF_LOC: Counts[3]++; break;
+    case X86State::RFLAG_SF_LOC: Counts[4]++; break;
+    case X86State::RFLAG_OF_LOC: Counts[5]++; break;
+    default: break;
+  }
+}
+
+void OpDispatchBuilder::FlushFlagTelemetry() {
+  // Reads and writes are interleaved per flag in the telemetry types
+  for (size_t i = 0; i < FlagReads.size(); ++i) {
+    const auto ReadType = static_cast<FEXCore::Telemetry::TelemetryType>(FEXCore::Telemetry::TYPE_CF_READS + i * 2);
+    const auto WriteType = static_cast<FEXCore::Telemetry::TelemetryType>(ReadType + 1);
+    FEXCore::Telemetry::GetObject(ReadType) += FlagReads[i];
+    FEXCore::Telemetry::GetObject(WriteType) += FlagWrites[i];
+  }
+
+  FlagReads.fill(0);
+  FlagWrites.fill(0);
+}
+#endif
+
 void OpDispatchBuilder::CalculateDeferredFlags(uint32_t FlagsToCalculateMask) {
   if (CurrentDeferredFlags.Type == FlagsGenerationType::TYPE_NONE) {
     // Nothing to do
@@ -262,13 +355,6 @@ void OpDispatchBuilder::CalculateDeferredFlags(uint32_t FlagsToCalculateMask) {
 
 void OpDispatchBuilder::CalculcateFlags_ADC(uint8_t SrcSize, OrderedNode *Res, OrderedNode *Src1, OrderedNode *Src2, OrderedNode *CF) {
   auto Size = SrcSize * 8;
-  // AF
-  {
-    OrderedNode *AFRes = _Xor(_Xor(Src1, Src2), Res);
-    AFRes = _Bfe(1, 4, AFRes);
-    SetRFLAG<FEXCore::X86State::RFLAG_AF_LOC>(AFRes);
-  }
-
   // SF
   {
     auto SignBitConst = _Constant(Size - 1);
@@ -277,15 +363,10 @@ void OpDispatchBuilder::CalculcateFlags_ADC(uint8_t SrcSize, OrderedNode *Res, O
     SetRFLAG<FEXCore::X86State::RFLAG_SF_LOC>(LshrOp);
   }
 
-  // PF
-  if (!CTX->Config.ABINoPF) {
-    auto PopCountOp = _Popcount(_And(Res, _Constant(0xFF)));
-
-    auto XorOp = _Xor(PopCountOp, _Constant(1));
-    SetRFLAG<FEXCore::X86State::RFLAG_PF_LOC>(XorOp);
-  } else {
-    _InvalidateFlags(1UL << FEXCore::X86State::RFLAG_PF_LOC);
-  }
+  // PF/AF
+  // Calculated lazily, AF is bit 4 of Src1 ^ Src2 ^ Res
+  SetPFRaw(Res);
+  SetAFRaw(_Xor(Src1, Src2));
 
   // ZF
   {
@@ -333,13 +414,6 @@ void OpDispatchBuilder::CalculcateFlags_ADC(uint8_t SrcSize, OrderedNode *Res, O
 }
 
 void OpDispatchBuilder::CalculcateFlags_SBB(uint8_t SrcSize, OrderedNode *Res, OrderedNode *Src1, OrderedNode *Src2, OrderedNode *CF) {
-  // AF
-  {
-    OrderedNode *AFRes = _Xor(_Xor(Src1, Src2), Res);
-    AFRes = _Bfe(1, 4, AFRes);
-    SetRFLAG<FEXCore::X86State::RFLAG_AF_LOC>(AFRes);
-  }
-
   // SF
   {
     auto SignBitConst = _Constant(SrcSize * 8 - 1);
@@ -348,15 +422,10 @@ void OpDispatchBuilder::CalculcateFlags_SBB(uint8_t SrcSize, OrderedNode *Res, O
     SetRFLAG<FEXCore::X86State::RFLAG_SF_LOC>(LshrOp);
   }
 
-  // PF
-  if (!CTX->Config.ABINoPF) {
-    auto PopCountOp = _Popcount(_And(Res, _Constant(0xFF)));
-
-    auto XorOp = _Xor(PopCountOp, _Constant(1));
-    SetRFLAG<FEXCore::X86State::RFLAG_PF_LOC>(XorOp);
-  } else {
-    _InvalidateFlags(1UL << FEXCore::X86State::RFLAG_PF_LOC);
-  }
+  // PF/AF
+  // Calculated lazily, AF is bit 4 of Src1 ^ Src2 ^ Res
+  SetPFRaw(Res);
+  SetAFRaw(_Xor(Src1, Src2));
 
   // ZF
   {
@@ -403,13 +472,6 @@ void OpDispatchBuilder::CalculcateFlags_SBB(uint8_t SrcSize, OrderedNode *Res, O
 }
 
 void OpDispatchBuilder::CalculcateFlags_SUB(uint8_t SrcSize, OrderedNode *Res, OrderedNode *Src1, OrderedNode *Src2, bool UpdateCF) {
-  // AF
-  {
-    OrderedNode *AFRes = _Xor(_Xor(Src1, Src2), Res);
-    AFRes = _Bfe(1, 4, AFRes);
-    SetRFLAG<FEXCore::X86State::RFLAG_AF_LOC>(AFRes);
-  }
-
   // SF
   {
     auto SignBitConst = _Constant(SrcSize * 8 - 1);
@@ -418,15 +480,10 @@ void OpDispatchBuilder::CalculcateFlags_SUB(uint8_t SrcSize, OrderedNode *Res, O
     SetRFLAG<FEXCore::X86State::RFLAG_SF_LOC>(LshrOp);
   }
 
-  // PF
-  if (!CTX->Config.ABINoPF) {
-    auto EightBitMask = _Constant(0xFF);
-    auto PopCountOp = _Popcount(_And(Res, EightBitMask));
-    auto XorOp = _Xor(PopCountOp, _Constant(1));
-    SetRFLAG<FEXCore::X86State::RFLAG_PF_LOC>(XorOp);
-  } else {
-    _InvalidateFlags(1UL << FEXCore::X86State::RFLAG_PF_LOC);
-  }
+  // PF/AF
+  // Calculated lazily, AF is bit 4 of Src1 ^ Src2 ^ Res
+  SetPFRaw(Res);
+  SetAFRaw(_Xor(Src1, Src2));
 
   // ZF
   {
@@ -460,13 +517,6 @@ void OpDispatchBuilder::CalculcateFlags_SUB(uint8_t SrcSize, OrderedNode *Res, O
 }
 
 void OpDispatchBuilder::CalculcateFlags_ADD(uint8_t SrcSize, OrderedNode *Res, OrderedNode *Src1, OrderedNode *Src2, bool UpdateCF) {
-  // AF
-  {
-    OrderedNode *AFRes = _Xor(_Xor(Src1, Src2), Res);
-    AFRes = _Bfe(1, 4, AFRes);
-    SetRFLAG<FEXCore::X86State::RFLAG_AF_LOC>(AFRes);
-  }
-
   // SF
   {
     auto SignBitConst = _Constant(SrcSize * 8 - 1);
@@ -475,15 +525,10 @@ void OpDispatchBuilder::CalculcateFlags_ADD(uint8_t SrcSize, OrderedNode *Res, O
     SetRFLAG<FEXCore::X86State::RFLAG_SF_LOC>(LshrOp);
   }
 
-  // PF
-  if (!CTX->Config.ABINoPF) {
-    auto EightBitMask = _Constant(0xFF);
-    auto PopCountOp = _Popcount(_And(Res, EightBitMask));
-    auto XorOp = _Xor(PopCountOp, _Constant(1));
-    SetRFLAG<FEXCore::X86State::RFLAG_PF_LOC>(XorOp);
-  } else {
-    _InvalidateFlags(1UL << FEXCore::X86State::RFLAG_PF_LOC);
-  }
+  // PF/AF
+  // Calculated lazily, AF is bit 4 of Src1 ^ Src2 ^ Res
+  SetPFRaw(Res);
+  SetAFRaw(_Xor(Src1, Src2));
 
   // ZF
   {
@@ -531,8 +576,7 @@ void OpDispatchBuilder::CalculcateFlags_MUL(uint8_t SrcSize, OrderedNode *Res, O
   // PF/AF/ZF/SF
   // Undefined
   {
-    SetRFLAG<FEXCore::X86State::RFLAG_PF_LOC>(_Constant(0));
-    SetRFLAG<FEXCore::X86State::RFLAG_AF_LOC>(_Constant(0));
+    ZeroPFAF();
     SetRFLAG<FEXCore::X86State::RFLAG_ZF_LOC>(_Constant(0));
     SetRFLAG<FEXCore::X86State::RFLAG_SF_LOC>(_Constant(0));
   }
@@ -555,9 +599,8 @@ void OpDispatchBuilder::CalculcateFlags_UMUL(OrderedNode *High) {
   // AF/SF/PF/ZF
   // Undefined
   {
-    SetRFLAG<FEXCore::X86State::RFLAG_AF_LOC>(_Constant(0));
+    ZeroPFAF();
     SetRFLAG<FEXCore::X86State::RFLAG_SF_LOC>(_Constant(0));
-    SetRFLAG<FEXCore::X86State::RFLAG_PF_LOC>(_Constant(0));
     SetRFLAG<FEXCore::X86State::RFLAG_ZF_LOC>(_Constant(0));
   }
 
@@ -574,13 +617,6 @@ void OpDispatchBuilder::CalculcateFlags_UMUL(OrderedNode *High) {
 }
 
 void OpDispatchBuilder::CalculcateFlags_Logical(uint8_t SrcSize, OrderedNode *Res, OrderedNode *Src1, OrderedNode *Src2) {
-  // AF
-  {
-    // Undefined
-    // Set to zero anyway
-    SetRFLAG<FEXCore::X86State::RFLAG_AF_LOC>(_Constant(0));
-  }
-
   // SF
   {
     auto SignBitConst = _Constant(SrcSize * 8 - 1);
@@ -589,15 +625,10 @@ void OpDispatchBuilder::CalculcateFlags_Logical(uint8_t SrcSize, OrderedNode *Re
     SetRFLAG<FEXCore::X86State::RFLAG_SF_LOC>(LshrOp);
   }
 
-  // PF
-  if (!CTX->Config.ABINoPF) {
-    auto EightBitMask = _Constant(0xFF);
-    auto PopCountOp = _Popcount(_And(Res, EightBitMask));
-    auto XorOp = _Xor(PopCountOp, _Constant(1));
-    SetRFLAG<FEXCore::X86State::RFLAG_PF_LOC>(XorOp);
-  } else {
-    _InvalidateFlags(1UL << FEXCore::X86State::RFLAG_PF_LOC);
-  }
+  // PF/AF
+  // AF is undefined, zero it anyway by calculating it from the same value as PF
+  SetPFRaw(Res);
+  SetAFRaw(Res);
 
   // ZF
   {
@@ -628,21 +659,15 @@ void OpDispatchBuilder::CalculcateFlags_ShiftLeft(uint8_t SrcSize, OrderedNode *
     COND_FLAG_SET(Src2, RFLAG_CF_LOC, LastBit);
   }
 
-  // PF
-  if (!CTX->Config.ABINoPF) {
-    auto EightBitMask = _Constant(0xFF);
-    auto PopCountOp = _Popcount(_And(Res, EightBitMask));
-    auto XorOp = _Xor(PopCountOp, _Constant(1));
-    COND_FLAG_SET(Src2, RFLAG_PF_LOC, XorOp);
-  } else {
-    _InvalidateFlags(1UL << FEXCore::X86State::RFLAG_PF_LOC);
-  }
-
-  // AF
+  // PF/AF
   {
-    // Undefined
-    // Set to zero anyway
-    COND_FLAG_SET(Src2, RFLAG_AF_LOC, _Constant(0));
+    // AF is undefined, zero it anyway by calculating it from the same value as PF
+    // Both raw values need to be selected before either is stored
+    auto ZeroConst = _Constant(0);
+    auto PFRaw = _Select(FEXCore::IR::COND_EQ, Src2, ZeroConst, LoadPFRaw(), Res);
+    auto AFRaw = _Select(FEXCore::IR::COND_EQ, Src2, ZeroConst, LoadAFRaw(), Res);
+    SetPFRaw(PFRaw);
+    SetAFRaw(AFRaw);
   }
 
   // ZF
@@ -676,21 +701,15 @@ void OpDispatchBuilder::CalculcateFlags_ShiftRight(uint8_t SrcSize, OrderedNode
     COND_FLAG_SET(Src2, RFLAG_CF_LOC, LastBit);
   }
 
-  // PF
-  if (!CTX->Config.ABINoPF) {
-    auto EightBitMask = _Constant(0xFF);
-    auto PopCountOp = _Popcount(_And(Res, EightBitMask));
-    auto XorOp = _Xor(PopCountOp, _Constant(1));
-    COND_FLAG_SET(Src2, RFLAG_PF_LOC, XorOp);
-  } else {
-    _InvalidateFlags(1UL << FEXCore::X86State::RFLAG_PF_LOC);
-  }
-
-  // AF
+  // PF/AF
   {
-    // Undefined
-    // Set to zero anyway
-    COND_FLAG_SET(Src2, RFLAG_AF_LOC, _Constant(0));
+    // AF is undefined, zero it anyway by calculating it from the same value as PF
+    // Both raw values need to be selected before either is stored
+    auto ZeroConst = _Constant(0);
+    auto PFRaw = _Select(FEXCore::IR::COND_EQ, Src2, ZeroConst, LoadPFRaw(), Res);
+    auto AFRaw = _Select(FEXCore::IR::COND_EQ, Src2, ZeroConst, LoadAFRaw(), Res);
+    SetPFRaw(PFRaw);
+    SetAFRaw(AFRaw);
   }
 
   // ZF
@@ -724,21 +743,15 @@ void OpDispatchBuilder::CalculcateFlags_SignShiftRight(uint8_t SrcSize, OrderedN
     COND_FLAG_SET(Src2, RFLAG_CF_LOC, LastBit);
   }
 
-  // PF
-  if (!CTX->Config.ABINoPF) {
-    auto EightBitMask = _Constant(0xFF);
-    auto PopCountOp = _Popcount(_And(Res, EightBitMask));
-    auto XorOp = _Xor(PopCountOp, _Constant(1));
-    COND_FLAG_SET(Src2, RFLAG_PF_LOC, XorOp);
-  } else {
-    _InvalidateFlags(1UL << FEXCore::X86State::RFLAG_PF_LOC);
-  }
-
-  // AF
+  // PF/AF
   {
-    // Undefined
-    // Set to zero anyway
-    COND_FLAG_SET(Src2, RFLAG_AF_LOC, _Constant(0));
+    // AF is undefined, zero it anyway by calculating it from the same value as PF
+    // Both raw values need to be selected before either is stored
+    auto ZeroConst = _Constant(0);
+    auto PFRaw = _Select(FEXCore::IR::COND_EQ, Src2, ZeroConst, LoadPFRaw(), Res);
+    auto AFRaw = _Select(FEXCore::IR::COND_EQ, Src2, ZeroConst, LoadAFRaw(), Res);
+    SetPFRaw(PFRaw);
+    SetAFRaw(AFRaw);
   }
 
   // ZF
@@ -776,22 +789,10 @@ void OpDispatchBuilder::CalculcateFlags_ShiftLeftImmediate(uint8_t SrcSize, Orde
     SetRFLAG<FEXCore::X86State::RFLAG_CF_LOC>(_Bfe(1, OpSize - Shift, Src1));
   }
 
-  // PF
-  if (!CTX->Config.ABINoPF) {
-    auto EightBitMask = _Constant(0xFF);
-    auto PopCountOp = _Popcount(_And(Res, EightBitMask));
-    auto XorOp = _Xor(PopCountOp, _Constant(1));
-    SetRFLAG<FEXCore::X86State::RFLAG_PF_LOC>(XorOp);
-  } else {
-    _InvalidateFlags(1UL << FEXCore::X86State::RFLAG_PF_LOC);
-  }
-
-  // AF
-  {
-    // Undefined
-    // Set to zero anyway
-    SetRFLAG<FEXCore::X86State::RFLAG_AF_LOC>(_Constant(0));
-  }
+  // PF/AF
+  // AF is undefined, zero it anyway by calculating it from the same value as PF
+  SetPFRaw(Res);
+  SetAFRaw(Res);
 
   // ZF
   {
@@ -825,22 +826,10 @@ void OpDispatchBuilder::CalculcateFlags_SignShiftRightImmediate(uint8_t SrcSize,
     SetRFLAG<FEXCore::X86State::RFLAG_CF_LOC>(_Bfe(1, Shift-1, Src1));
   }
 
-  // PF
-  if (!CTX->Config.ABINoPF) {
-    auto EightBitMask = _Constant(0xFF);
-    auto PopCountOp = _Popcount(_And(Res, EightBitMask));
-    auto XorOp = _Xor(PopCountOp, _Constant(1));
-    SetRFLAG<FEXCore::X86State::RFLAG_PF_LOC>(XorOp);
-  } else {
-    _InvalidateFlags(1UL << FEXCore::X86State::RFLAG_PF_LOC);
-  }
-
-  // AF
-  {
-    // Undefined
-    // Set to zero anyway
-    SetRFLAG<FEXCore::X86State::RFLAG_AF_LOC>(_Constant(0));
-  }
+  // PF/AF
+  // AF is undefined, zero it anyway by calculating it from the same value as PF
+  SetPFRaw(Res);
+  SetAFRaw(Res);
 
   // ZF
   {
@@ -876,22 +865,10 @@ void OpDispatchBuilder::CalculcateFlags_ShiftRightImmediate(uint8_t SrcSize, Ord
     SetRFLAG<FEXCore::X86State::RFLAG_CF_LOC>(_Bfe(1, Shift-1, Src1));
   }
 
-  // PF
-  if (!CTX->Config.ABINoPF) {
-    auto EightBitMask = _Constant(0xFF);
-    auto PopCountOp = _Popcount(_And(Res, EightBitMask));
-    auto XorOp = _Xor(PopCountOp, _Constant(1));
-    SetRFLAG<FEXCore::X86State::RFLAG_PF_LOC>(XorOp);
-  } else {
-    _InvalidateFlags(1UL << FEXCore::X86State::RFLAG_PF_LOC);
-  }
-
-  // AF
-  {
-    // Undefined
-    // Set to zero anyway
-    SetRFLAG<FEXCore::X86State::RFLAG_AF_LOC>(_Constant(0));
-  }
+  // PF/AF
+  // AF is undefined, zero it anyway by calculating it from the same value as PF
+  SetPFRaw(Res);
+  SetAFRaw(Res);
 
   // ZF
   {
@@ -1035,10 +1012,13 @@ void OpDispatchBuilder::CalculcateFlags_FCMP(uint8_t SrcSize, OrderedNode *Res,
 
   SetRFLAG<FEXCore::X86State::RFLAG_CF_LOC>(HostFlag_CF);
   SetRFLAG<FEXCore::X86State::RFLAG_ZF_LOC>(HostFlag_ZF);
-  SetRFLAG<FEXCore::X86State::RFLAG_PF_LOC>(HostFlag_Unordered);
+
+  // PF is set when unordered and AF is cleared
+  auto PFRaw = _Xor(_Bfe(1, 0, HostFlag_Unordered), _Constant(1));
+  SetPFRaw(PFRaw);
+  SetAFRaw(PFRaw);
 
   auto ZeroConst = _Constant(0);
-  SetRFLAG<FEXCore::X86State::RFLAG_AF_LOC>(ZeroConst);
   SetRFLAG<FEXCore::X86State::RFLAG_SF_LOC>(ZeroConst);
   SetRFLAG<FEXCore::X86State::RFLAG_OF_LOC>(ZeroConst);
 }
@@ -1057,16 +1037,9 @@ void OpDispatchBuilder::CalculcateFlags_BEXTR(OrderedNode *Src) {
   // Every other flag is considered undefined after a
   // BEXTR instruction, but we opt to reliably clear them.
   //
-  SetRFLAG<X86State::RFLAG_AF_LOC>(_Constant(0));
+  ZeroPFAF();
   SetRFLAG<X86State::RFLAG_SF_LOC>(_Constant(0));
 
-  // PF
-  if (CTX->Config.ABINoPF) {
-    _InvalidateFlags(1UL << X86State::RFLAG_PF_LOC);
-  } else {
-    SetRFLAG<X86State::RFLAG_PF_LOC>(_Constant(0));
-  }
-
   // ZF
   auto ZeroOp = _Select(IR::COND_EQ,
                         Src, _Constant(0),
@@ -1090,12 +1063,7 @@ void OpDispatchBuilder::CalculcateFlags_BLSI(uint8_t SrcSize, OrderedNode *Src)
   auto One = _Constant(1);
 
   SetRFLAG<X86State::RFLAG_OF_LOC>(Zero);
-  SetRFLAG<X86State::RFLAG_AF_LOC>(Zero);
-  if (CTX->Config.ABINoPF) {
-    _InvalidateFlags(1UL << X86State::RFLAG_PF_LOC);
-  } else {
-    SetRFLAG<X86State::RFLAG_PF_LOC>(Zero);
-  }
+  ZeroPFAF();
 
   // ZF
   {
@@ -1130,12 +1098,7 @@ void OpDispatchBuilder::CalculcateFlags_BLSMSK(OrderedNode *Src) {
 
   SetRFLAG<X86State::RFLAG_ZF_LOC>(Zero);
   SetRFLAG<X86State::RFLAG_OF_LOC>(Zero);
-  SetRFLAG<X86State::RFLAG_AF_LOC>(Zero);
-  if (CTX->Config.ABINoPF) {
-    _InvalidateFlags(1UL << X86State::RFLAG_PF_LOC);
-  } else {
-    SetRFLAG<X86State::RFLAG_PF_LOC>(Zero);
-  }
+  ZeroPFAF();
 
   auto CFOp = _Select(IR::COND_EQ,
                       Src, Zero,
@@ -1149,12 +1112,7 @@ void OpDispatchBuilder::CalculcateFlags_BLSR(uint8_t SrcSize, OrderedNode *Resul
   auto One = _Constant(1);
 
   SetRFLAG<X86State::RFLAG_OF_LOC>(Zero);
-  SetRFLAG<X86State::RFLAG_AF_LOC>(Zero);
-  if (CTX->Config.ABINoPF) {
-    _InvalidateFlags(1UL << X86State::RFLAG_PF_LOC);
-  } else {
-    SetRFLAG<X86State::RFLAG_PF_LOC>(Zero);
-  }
+  ZeroPFAF();
 
   // ZF
   {
@@ -1190,8 +1148,7 @@ void OpDispatchBuilder::CalculcateFlags_POPCOUNT(OrderedNode *Src) {
 
   // Set flags
   SetRFLAG<FEXCore::X86State::RFLAG_CF_LOC>(Zero);
-  SetRFLAG<FEXCore::X86State::RFLAG_PF_LOC>(Zero);
-  SetRFLAG<FEXCore::X86State::RFLAG_AF_LOC>(Zero);
+  ZeroPFAF();
   SetRFLAG<FEXCore::X86State::RFLAG_ZF_LOC>(ZFResult);
   SetRFLAG<FEXCore::X86State::RFLAG_SF_LOC>(Zero);
   SetRFLAG<FEXCore::X86State::RFLAG_OF_LOC>(Zero);
@@ -1205,12 +1162,7 @@ void OpDispatchBuilder::CalculcateFlags_BZHI(uint8_t SrcSize, OrderedNode *Resul
   auto One = _Constant(1);
 
   SetRFLAG<X86State::RFLAG_OF_LOC>(Zero);
-  SetRFLAG<X86State::RFLAG_AF_LOC>(Zero);
-  if (CTX->Config.ABINoPF) {
-    _InvalidateFlags(1UL << X86State::RFLAG_PF_LOC);
-  } else {
-    SetRFLAG<X86State::RFLAG_PF_LOC>(Zero);
-  }
+  ZeroPFAF();
 
   // ZF
   {
@@ -1283,8 +1235,7 @@ void OpDispatchBuilder::CalculcateFlags_RDRAND(OrderedNode *Src) {
   SetRFLAG<X86State::RFLAG_OF_LOC>(ZeroConst);
   SetRFLAG<X86State::RFLAG_SF_LOC>(ZeroConst);
   SetRFLAG<X86State::RFLAG_ZF_LOC>(ZeroConst);
-  SetRFLAG<X86State::RFLAG_AF_LOC>(ZeroConst);
-  SetRFLAG<X86State::RFLAG_PF_LOC>(ZeroConst);
+  ZeroPFAF();
   SetRFLAG<FEXCore::X86State::RFLAG_CF_LOC>(Src);
 }
 
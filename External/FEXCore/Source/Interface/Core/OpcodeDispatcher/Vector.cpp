@@ -15,6 +15,7 @@ $end_info$
 #include <FEXCore/IR/IR.h>
 #include <FEXCore/Utils/LogManager.h>
 
+#include <algorithm>
 #include <array>
 #include <bit>
 #include <cstdint>
@@ -845,9 +846,7 @@ void OpDispatchBuilder::MOVMSKOp<4>(OpcodeArgs);
 template
 void OpDispatchBuilder::MOVMSKOp<8>(OpcodeArgs);
 
-void OpDispatchBuilder::MOVMSKOpOne(OpcodeArgs) {
-  OrderedNode *Src = LoadSource(FPRClass, Op, Op->Src[0], Op->Flags, -1);
-
+OrderedNode* OpDispatchBuilder::PMOVMSKBOpImpl(OpcodeArgs, OrderedNode *Src) {
   //TODO: We could remove this VCastFromGOR + VInsGPR pair if we had a VDUPFromGPR instruction that maps directly to AArch64.
   auto M = _Constant(0x80'40'20'10'08'04'02'01ULL);
   OrderedNode *VMask = _VCastFromGPR(16, 8, M);
@@ -861,7 +860,29 @@ void OpDispatchBuilder::MOVMSKOpOne(OpcodeArgs) {
   auto VAdd2 = _VAddP(8, 1, VAdd1, VAdd1);
   auto VAdd3 = _VAddP(8, 1, VAdd2, VAdd2);
 
-  StoreResult(GPRClass, Op, _VExtractToGPR(16, 2, VAdd3, 0), -1);
+  return _VExtractToGPR(16, 2, VAdd3, 0);
+}
+
+void OpDispatchBuilder::MOVMSKOpOne(OpcodeArgs) {
+  OrderedNode *Src = LoadSource(FPRClass, Op, Op->Src[0], Op->Flags, -1);
+  StoreResult(GPRClass, Op, PMOVMSKBOpImpl(Op, Src), -1);
+}
+
+void OpDispatchBuilder::VPMOVMSKBOp(OpcodeArgs) {
+  const auto SrcSize = GetSrcSize(Op);
+  const auto Is128Bit = SrcSize == Core::CPUState::XMM_SSE_REG_SIZE;
+
+  OrderedNode *Src = LoadSource(FPRClass, Op, Op->Src[0], Op->Flags, -1);
+  OrderedNode *Result = PMOVMSKBOpImpl(Op, Src);
+
+  if (!Is128Bit) {
+    // Move the upper lane down and gather its mask into bits [31:16]
+    OrderedNode *Upper = _VInsElement(SrcSize, 16, 0, 1, Src, Src);
+    OrderedNode *UpperMask = PMOVMSKBOpImpl(Op, Upper);
+    Result = _Or(Result, _Lshl(UpperMask, _Constant(16)));
+  }
+
+  StoreResult(GPRClass, Op, Result, -1);
 }
 
 template<size_t ElementSize>
@@ -1025,6 +1046,65 @@ void OpDispatchBuilder::PSHUFDOp<2, true, true>(OpcodeArgs);
 template
 void OpDispatchBuilder::PSHUFDOp<4, false, true>(OpcodeArgs);
 
+void OpDispatchBuilder::VPSHUFBOp(OpcodeArgs) {
+  const auto SrcSize = GetSrcSize(Op);
+  const auto Is128Bit = SrcSize == Core::CPUState::XMM_SSE_REG_SIZE;
+
+  OrderedNode *Src1 = LoadSource(FPRClass, Op, Op->Src[0], Op->Flags, -1);
+  OrderedNode *Src2 = LoadSource(FPRClass, Op, Op->Src[1], Op->Flags, -1);
+
+  // Same masking as PSHUFB, bit 7 zeroes the element and bits [3:0] select within the lane
+  OrderedNode *Indices = _VAnd(SrcSize, 1, Src2, _VectorImm(SrcSize, 1, 0b1000'1111));
+
+  if (!Is128Bit) {
+    // The 256-bit variant shuffles each 128-bit lane independently, so offset
+    // the upper lane's indices to select from the upper half of the table.
+    OrderedNode *LaneOffset = _VInsElement(SrcSize, 16, 1, 0, _VectorZero(SrcSize), _VectorImm(SrcSize, 1, 0x10));
+    Indices = _VOr(SrcSize, 1, Indices, LaneOffset);
+  }
+
+  OrderedNode *Result = _VTBL1(SrcSize, Src1, Indices);
+  if (Is128Bit) {
+    Result = _VMov(16, Result);
+  }
+
+  StoreResult(FPRClass, Op, Result, -1);
+}
+
+template <bool Low>
+void OpDispatchBuilder::VPSHUFWOp(OpcodeArgs) {
+  const auto DstSize = GetDstSize(Op);
+  const auto Is128Bit = DstSize == Core::CPUState::XMM_SSE_REG_SIZE;
+
+  LOGMAN_THROW_A_FMT(Op->Src[1].IsLiteral(), "Src1 needs to be literal here");
+  const auto Shuffle = Op->Src[1].Data.Literal.Value & 0xFF;
+
+  OrderedNode *Src = LoadSource(FPRClass, Op, Op->Src[0], Op->Flags, -1);
+  OrderedNode *Result = Src;
+
+  // Shuffles four words of each 128-bit lane, the other four are copied through
+  const auto NumLanes = DstSize / Core::CPUState::XMM_SSE_REG_SIZE;
+  for (size_t Lane = 0; Lane < NumLanes; ++Lane) {
+    const auto BaseElement = Lane * 8 + (Low ? 0 : 4);
+
+    for (size_t Element = 0; Element < 4; ++Element) {
+      const auto SrcIndex = (Shuffle >> (Element * 2)) & 0b11;
+      Result = _VInsElement(DstSize, 2, BaseElement + Element, BaseElement + SrcIndex, Result, Src);
+    }
+  }
+
+  if (Is128Bit) {
+    Result = _VMov(16, Result);
+  }
+
+  StoreResult(FPRClass, Op, Result, -1);
+}
+
+template
+void OpDispatchBuilder::VPSHUFWOp<false>(OpcodeArgs);
+template
+void OpDispatchBuilder::VPSHUFWOp<true>(OpcodeArgs);
+
 template<size_t ElementSize>
 void OpDispatchBuilder::SHUFOp(OpcodeArgs) {
   static_assert(ElementSize != 0);
@@ -1719,6 +1799,35 @@ void OpDispatchBuilder::VPSRAVDOp(OpcodeArgs) {
   StoreResult(FPRClass, Op, Result, -1);
 }
 
+template <bool Right>
+void OpDispatchBuilder::VPSxLVOp(OpcodeArgs) {
+  const auto SrcSize = GetSrcSize(Op);
+  const auto Is128Bit = SrcSize == Core::CPUState::XMM_SSE_REG_SIZE;
+  const auto ElementSize = (Op->Flags & X86Tables::DecodeFlags::FLAG_OPTION_AVX_W) ? 8 : 4;
+
+  OrderedNode *Vector = LoadSource(FPRClass, Op, Op->Src[0], Op->Flags, -1);
+  OrderedNode *ShiftVector = LoadSource(FPRClass, Op, Op->Src[1], Op->Flags, -1);
+
+  // Shift amounts at or above the element width produce zero, which VUShl/VUShr already guarantee
+  OrderedNode *Result{};
+  if constexpr (Right) {
+    Result = _VUShr(SrcSize, ElementSize, Vector, ShiftVector);
+  } else {
+    Result = _VUShl(SrcSize, ElementSize, Vector, ShiftVector);
+  }
+
+  if (Is128Bit) {
+    Result = _VMov(16, Result);
+  }
+
+  StoreResult(FPRClass, Op, Result, -1);
+}
+
+template
+void OpDispatchBuilder::VPSxLVOp<false>(OpcodeArgs);
+template
+void OpDispatchBuilder::VPSxLVOp<true>(OpcodeArgs);
+
 void OpDispatchBuilder::MOVDDUPOp(OpcodeArgs) {
   OrderedNode *Src = LoadSource(FPRClass, Op, Op->Src[0], Op->Flags, -1);
   OrderedNode *Res = _VDupElement(16, GetSrcSize(Op), Src, 0);
@@ -1949,6 +2058,54 @@ void OpDispatchBuilder::Vector_CVT_Float_To_Float<4, 8>(OpcodeArgs);
 template
 void OpDispatchBuilder::Vector_CVT_Float_To_Float<8, 4>(OpcodeArgs);
 
+void OpDispatchBuilder::VCVTPH2PSOp(OpcodeArgs) {
+  const auto DstSize = GetDstSize(Op);
+  const auto Is128Bit = DstSize == Core::CPUState::XMM_SSE_REG_SIZE;
+
+  // Half the destination size worth of source elements
+  OrderedNode *Src = LoadSource_WithOpSize(FPRClass, Op, Op->Src[0], DstSize / 2, Op->Flags, -1);
+  OrderedNode *Result = _Vector_FToF(DstSize, 4, Src, 2);
+
+  if (Is128Bit) {
+    Result = _VMov(16, Result);
+  }
+  StoreResult(FPRClass, Op, Result, -1);
+}
+
+void OpDispatchBuilder::VCVTPS2PHOp(OpcodeArgs) {
+  const auto SrcSize = GetSrcSize(Op);
+  const auto StoreSize = SrcSize / 2;
+
+  LOGMAN_THROW_A_FMT(Op->Src[1].IsLiteral(), "Src1 needs to be literal here");
+  const auto Mode = Op->Src[1].Data.Literal.Value;
+
+  OrderedNode *Src = LoadSource(FPRClass, Op, Op->Src[0], Op->Flags, -1);
+
+  // Bit 2 selects MXCSR.RC, otherwise the immediate supplies the rounding mode for just this instruction.
+  const bool UseMXCSR = (Mode & 0b100) != 0;
+  OrderedNode *SavedRoundMode{};
+  if (!UseMXCSR) {
+    SavedRoundMode = _GetRoundingMode();
+    // Keep the flush to zero bit
+    OrderedNode *NewRoundMode = _Or(_And(SavedRoundMode, _Constant(0b100)), _Constant(Mode & 0b11));
+    _SetRoundingMode(NewRoundMode);
+  }
+
+  OrderedNode *Result = _Vector_FToF(SrcSize, 2, Src, 4);
+  // Only the converted elements are kept, the rest of a register destination is zeroed
+  Result = _VMov(StoreSize, Result);
+
+  if (!UseMXCSR) {
+    _SetRoundingMode(SavedRoundMode);
+  }
+
+  if (Op->Dest.IsGPR()) {
+    StoreResult_WithOpSize(FPRClass, Op, Op->Dest, Result, Core::CPUState::XMM_SSE_REG_SIZE, -1);
+  } else {
+    StoreResult_WithOpSize(FPRClass, Op, Op->Dest, Result, StoreSize, -1);
+  }
+}
+
 template<size_t SrcElementSize, bool Widen>
 void OpDispatchBuilder::MMX_To_XMM_Vector_CVT_Int_To_Float(OpcodeArgs) {
   OrderedNode *Src = LoadSource(FPRClass, Op, Op->Src[0], Op->Flags, -1);
@@ -2608,6 +2765,141 @@ void OpDispatchBuilder::VADDSUBPOp<4>(OpcodeArgs);
 template
 void OpDispatchBuilder::VADDSUBPOp<8>(OpcodeArgs);
 
+std::array<OrderedNode*, 3> OpDispatchBuilder::LoadVFMAOperands(OpcodeArgs, size_t Size, size_t ElementSize, bool Scalar) {
+  // FMA operands are numbered as in the mnemonic: 1 = ModRM.reg, 2 = VEX.vvvv, 3 = ModRM.rm
+  // Only the rm operand can be memory, where the scalar forms only read a single element.
+  return {
+    LoadSource_WithOpSize(FPRClass, Op, Op->Dest, Size, Op->Flags, -1),
+    LoadSource_WithOpSize(FPRClass, Op, Op->Src[0], Size, Op->Flags, -1),
+    LoadSource_WithOpSize(FPRClass, Op, Op->Src[1], Scalar ? ElementSize : Size, Op->Flags, -1),
+  };
+}
+
+void OpDispatchBuilder::VFMAImpl(OpcodeArgs, IROps IROp, bool Scalar, uint8_t Src1Idx, uint8_t Src2Idx, uint8_t AddendIdx) {
+  // Scalar forms ignore VEX.L
+  const auto Size = Scalar ? Core::CPUState::XMM_SSE_REG_SIZE : GetDstSize(Op);
+  const auto Is128Bit = Size == Core::CPUState::XMM_SSE_REG_SIZE;
+  const auto ElementSize = (Op->Flags & X86Tables::DecodeFlags::FLAG_OPTION_AVX_W) ? 8 : 4;
+
+  const auto Sources = LoadVFMAOperands(Op, Size, ElementSize, Scalar);
+
+  // If OpSize == ElementSize then it only does the lower scalar op
+  auto FMAOp = _VFMLA(Scalar ? ElementSize : Size, ElementSize,
+                      Sources[Src1Idx - 1], Sources[Src2Idx - 1], Sources[AddendIdx - 1]);
+  // Overwrite our IR's op type
+  FMAOp.first->Header.Op = IROp;
+
+  OrderedNode *Result = FMAOp;
+  if (Scalar) {
+    // Upper elements come from the first operand
+    Result = _VInsElement(Size, ElementSize, 0, 0, Sources[0], Result);
+  }
+
+  if (Is128Bit) {
+    Result = _VMov(16, Result);
+  }
+  StoreResult(FPRClass, Op, Result, -1);
+}
+
+template<IROps IROp, bool Scalar, uint8_t Src1Idx, uint8_t Src2Idx, uint8_t AddendIdx>
+void OpDispatchBuilder::VFMAOp(OpcodeArgs) {
+  VFMAImpl(Op, IROp, Scalar, Src1Idx, Src2Idx, AddendIdx);
+}
+
+template
+void OpDispatchBuilder::VFMAOp<IR::OP_VFMLA, false, 1, 3, 2>(OpcodeArgs);
+template
+void OpDispatchBuilder::VFMAOp<IR::OP_VFMLA, true, 1, 3, 2>(OpcodeArgs);
+template
+void OpDispatchBuilder::VFMAOp<IR::OP_VFMLS, false, 1, 3, 2>(OpcodeArgs);
+template
+void OpDispatchBuilder::VFMAOp<IR::OP_VFMLS, true, 1, 3, 2>(OpcodeArgs);
+template
+void OpDispatchBuilder::VFMAOp<IR::OP_VFNMLA, false, 1, 3, 2>(OpcodeArgs);
+template
+void OpDispatchBuilder::VFMAOp<IR::OP_VFNMLA, true, 1, 3, 2>(OpcodeArgs);
+template
+void OpDispatchBuilder::VFMAOp<IR::OP_VFNMLS, false, 1, 3, 2>(OpcodeArgs);
+template
+void OpDispatchBuilder::VFMAOp<IR::OP_VFNMLS, true, 1, 3, 2>(OpcodeArgs);
+template
+void OpDispatchBuilder::VFMAOp<IR::OP_VFMLA, false, 2, 1, 3>(OpcodeArgs);
+template
+void OpDispatchBuilder::VFMAOp<IR::OP_VFMLA, true, 2, 1, 3>(OpcodeArgs);
+template
+void OpDispatchBuilder::VFMAOp<IR::OP_VFMLS, false, 2, 1, 3>(OpcodeArgs);
+template
+void OpDispatchBuilder::VFMAOp<IR::OP_VFMLS, true, 2, 1, 3>(OpcodeArgs);
+template
+void OpDispatchBuilder::VFMAOp<IR::OP_VFNMLA, false, 2, 1, 3>(OpcodeArgs);
+template
+void OpDispatchBuilder::VFMAOp<IR::OP_VFNMLA, true, 2, 1, 3>(OpcodeArgs);
+template
+void OpDispatchBuilder::VFMAOp<IR::OP_VFNMLS, false, 2, 1, 3>(OpcodeArgs);
+template
+void OpDispatchBuilder::VFMAOp<IR::OP_VFNMLS, true, 2, 1, 3>(OpcodeArgs);
+template
+void OpDispatchBuilder::VFMAOp<IR::OP_VFMLA, false, 2, 3, 1>(OpcodeArgs);
+template
+void OpDispatchBuilder::VFMAOp<IR::OP_VFMLA, true, 2, 3, 1>(OpcodeArgs);
+template
+void OpDispatchBuilder::VFMAOp<IR::OP_VFMLS, false, 2, 3, 1>(OpcodeArgs);
+template
+void OpDispatchBuilder::VFMAOp<IR::OP_VFMLS, true, 2, 3, 1>(OpcodeArgs);
+template
+void OpDispatchBuilder::VFMAOp<IR::OP_VFNMLA, false, 2, 3, 1>(OpcodeArgs);
+template
+void OpDispatchBuilder::VFMAOp<IR::OP_VFNMLA, true, 2, 3, 1>(OpcodeArgs);
+template
+void OpDispatchBuilder::VFMAOp<IR::OP_VFNMLS, false, 2, 3, 1>(OpcodeArgs);
+template
+void OpDispatchBuilder::VFMAOp<IR::OP_VFNMLS, true, 2, 3, 1>(OpcodeArgs);
+
+void OpDispatchBuilder::VFMAddSubImpl(OpcodeArgs, bool AddSub, uint8_t Src1Idx, uint8_t Src2Idx, uint8_t AddendIdx) {
+  const auto Size = GetDstSize(Op);
+  const auto Is128Bit = Size == Core::CPUState::XMM_SSE_REG_SIZE;
+  const auto ElementSize = (Op->Flags & X86Tables::DecodeFlags::FLAG_OPTION_AVX_W) ? 8 : 4;
+
+  const auto Sources = LoadVFMAOperands(Op, Size, ElementSize, false);
+  OrderedNode *Src1 = Sources[Src1Idx - 1];
+  OrderedNode *Src2 = Sources[Src2Idx - 1];
+  OrderedNode *Addend = Sources[AddendIdx - 1];
+
+  OrderedNode *ResAdd = _VFMLA(Size, ElementSize, Src1, Src2, Addend);
+  OrderedNode *ResSub = _VFMLS(Size, ElementSize, Src1, Src2, Addend);
+
+  // FMADDSUB: Even elements are the sub result, odd elements are the add result
+  // FMSUBADD: The other way around
+  OrderedNode *Even = AddSub ? ResSub : ResAdd;
+  OrderedNode *Odd = AddSub ? ResAdd : ResSub;
+  OrderedNode *UnzipEven = _VUnZip(Size, ElementSize, Even, Even);
+  OrderedNode *UnzipOdd = _VUnZip2(Size, ElementSize, Odd, Odd);
+  OrderedNode *Result = _VZip(Size, ElementSize, UnzipEven, UnzipOdd);
+
+  if (Is128Bit) {
+    Result = _VMov(16, Result);
+  }
+  StoreResult(FPRClass, Op, Result, -1);
+}
+
+template<bool AddSub, uint8_t Src1Idx, uint8_t Src2Idx, uint8_t AddendIdx>
+void OpDispatchBuilder::VFMAddSubOp(OpcodeArgs) {
+  VFMAddSubImpl(Op, AddSub, Src1Idx, Src2Idx, AddendIdx);
+}
+
+template
+void OpDispatchBuilder::VFMAddSubOp<true, 1, 3, 2>(OpcodeArgs);
+template
+void OpDispatchBuilder::VFMAddSubOp<false, 1, 3, 2>(OpcodeArgs);
+template
+void OpDispatchBuilder::VFMAddSubOp<true, 2, 1, 3>(OpcodeArgs);
+template
+void OpDispatchBuilder::VFMAddSubOp<false, 2, 1, 3>(OpcodeArgs);
+template
+void OpDispatchBuilder::VFMAddSubOp<true, 2, 3, 1>(OpcodeArgs);
+template
+void OpDispatchBuilder::VFMAddSubOp<false, 2, 3, 1>(OpcodeArgs);
+
 void OpDispatchBuilder::PFNACCOp(OpcodeArgs) {
   auto Size = GetSrcSize(Op);
 
@@ -2746,7 +3038,7 @@ void OpDispatchBuilder::VPFCMPOp<1>(OpcodeArgs);
 template
 void OpDispatchBuilder::VPFCMPOp<2>(OpcodeArgs);
 
-void OpDispatchBuilder::PMADDWD(OpcodeArgs) {
+OrderedNode* OpDispatchBuilder::PMADDWDOpImpl(OpcodeArgs, OrderedNode *Src1, OrderedNode *Src2) {
   // This is a pretty curious operation
   // Does two MADD operations across 4 16bit signed integers and accumulates to 32bit integers in the destination
   //
@@ -2757,9 +3049,6 @@ void OpDispatchBuilder::PMADDWD(OpcodeArgs) {
 
   auto Size = GetSrcSize(Op);
 
-  OrderedNode *Src1 = LoadSource(FPRClass, Op, Op->Dest, Op->Flags, -1);
-  OrderedNode *Src2 = LoadSource(FPRClass, Op, Op->Src[0], Op->Flags, -1);
-
   if (Size == 8) {
     Size <<= 1;
   }
@@ -2774,11 +3063,32 @@ void OpDispatchBuilder::PMADDWD(OpcodeArgs) {
   auto Res_H = _VSMul(Size, 4, Src1_H, Src2_H); // [79:64], [95:80], [111:96], [127:112] : Original elements
 
   // [15:0 ] + [31:16], [32:47 ] + [63:48  ], [79:64] + [95:80], [111:96] + [127:112]
-  auto Res = _VAddP(Size, 4, Res_L, Res_H);
-  StoreResult(FPRClass, Op, Res, -1);
+  return _VAddP(Size, 4, Res_L, Res_H);
 }
 
-void OpDispatchBuilder::PMADDUBSW(OpcodeArgs) {
+void OpDispatchBuilder::PMADDWD(OpcodeArgs) {
+  OrderedNode *Src1 = LoadSource(FPRClass, Op, Op->Dest, Op->Flags, -1);
+  OrderedNode *Src2 = LoadSource(FPRClass, Op, Op->Src[0], Op->Flags, -1);
+  OrderedNode *Result = PMADDWDOpImpl(Op, Src1, Src2);
+
+  StoreResult(FPRClass, Op, Result, -1);
+}
+
+void OpDispatchBuilder::VPMADDWDOp(OpcodeArgs) {
+  const auto DstSize = GetDstSize(Op);
+  const auto Is128Bit = DstSize == Core::CPUState::XMM_SSE_REG_SIZE;
+
+  OrderedNode *Src1 = LoadSource(FPRClass, Op, Op->Src[0], Op->Flags, -1);
+  OrderedNode *Src2 = LoadSource(FPRClass, Op, Op->Src[1], Op->Flags, -1);
+  OrderedNode *Result = PMADDWDOpImpl(Op, Src1, Src2);
+
+  if (Is128Bit) {
+    Result = _VMov(16, Result);
+  }
+  StoreResult(FPRClass, Op, Result, -1);
+}
+
+OrderedNode* OpDispatchBuilder::PMADDUBSWOpImpl(OpcodeArgs, OrderedNode *Src1, OrderedNode *Src2) {
   // This is a pretty curious operation
   // Does four MADD operations across 8 8bit signed and unsigned integers and accumulates to 16bit integers in the destination WITH saturation
   //
@@ -2788,10 +3098,7 @@ void OpDispatchBuilder::PMADDUBSW(OpcodeArgs) {
   //    mm1[47:32] = SaturateSigned16(((s8)mm2[47:40] * (u8)mm1[47:40]) + ((s8)mm2[39:32] * (u8)mm1[39:32]))
   //    mm1[63:48] = SaturateSigned16(((s8)mm2[63:56] * (u8)mm1[63:56]) + ((s8)mm2[55:48] * (u8)mm1[55:48]))
   // Extends to larger registers
-  auto Size = GetSrcSize(Op);
-
-  OrderedNode *Src1 = LoadSource(FPRClass, Op, Op->Dest, Op->Flags, -1);
-  OrderedNode *Src2 = LoadSource(FPRClass, Op, Op->Src[0], Op->Flags, -1);
+  const auto Size = GetSrcSize(Op);
 
   if (Size == 8) {
     // 64bit is more efficient
@@ -2809,8 +3116,7 @@ void OpDispatchBuilder::PMADDUBSW(OpcodeArgs) {
     auto ResAdd = _VAddP(Size * 2, 4, ResMul_L, ResMul_H);
 
     // Add saturate back down to 16bit
-    OrderedNode *Res = _VSQXTN(Size * 2, 4, ResAdd);
-    StoreResult(FPRClass, Op, Res, -1);
+    return _VSQXTN(Size * 2, 4, ResAdd);
   }
   else {
     // Src1 is unsigned
@@ -2833,10 +3139,30 @@ void OpDispatchBuilder::PMADDUBSW(OpcodeArgs) {
 
     // Add saturate back down to 16bit
     OrderedNode *Res = _VSQXTN(Size, 4, ResAdd_L);
-    Res = _VSQXTN2(Size, 4, Res, ResAdd_H);
+    return _VSQXTN2(Size, 4, Res, ResAdd_H);
+  }
+}
 
-    StoreResult(FPRClass, Op, Res, -1);
+void OpDispatchBuilder::PMADDUBSW(OpcodeArgs) {
+  OrderedNode *Src1 = LoadSource(FPRClass, Op, Op->Dest, Op->Flags, -1);
+  OrderedNode *Src2 = LoadSource(FPRClass, Op, Op->Src[0], Op->Flags, -1);
+  OrderedNode *Result = PMADDUBSWOpImpl(Op, Src1, Src2);
+
+  StoreResult(FPRClass, Op, Result, -1);
+}
+
+void OpDispatchBuilder::VPMADDUBSWOp(OpcodeArgs) {
+  const auto DstSize = GetDstSize(Op);
+  const auto Is128Bit = DstSize == Core::CPUState::XMM_SSE_REG_SIZE;
+
+  OrderedNode *Src1 = LoadSource(FPRClass, Op, Op->Src[0], Op->Flags, -1);
+  OrderedNode *Src2 = LoadSource(FPRClass, Op, Op->Src[1], Op->Flags, -1);
+  OrderedNode *Result = PMADDUBSWOpImpl(Op, Src1, Src2);
+
+  if (Is128Bit) {
+    Result = _VMov(16, Result);
   }
+  StoreResult(FPRClass, Op, Result, -1);
 }
 
 OrderedNode* OpDispatchBuilder::PMULHWOpImpl(OpcodeArgs, bool Signed,
@@ -3480,10 +3806,9 @@ void OpDispatchBuilder::PTestOp(OpcodeArgs) {
   SetRFLAG<FEXCore::X86State::RFLAG_ZF_LOC>(Test1);
   SetRFLAG<FEXCore::X86State::RFLAG_CF_LOC>(Test2);
 
-  SetRFLAG<FEXCore::X86State::RFLAG_AF_LOC>(ZeroConst);
   SetRFLAG<FEXCore::X86State::RFLAG_SF_LOC>(ZeroConst);
   SetRFLAG<FEXCore::X86State::RFLAG_OF_LOC>(ZeroConst);
-  SetRFLAG<FEXCore::X86State::RFLAG_PF_LOC>(ZeroConst);
+  ZeroPFAF();
 }
 
 OrderedNode* OpDispatchBuilder::PHMINPOSUWOpImpl(OpcodeArgs) {
@@ -3696,6 +4021,134 @@ void OpDispatchBuilder::MPSADBWOp(OpcodeArgs) {
   StoreResult(FPRClass, Op, Result, -1);
 }
 
+OrderedNode* OpDispatchBuilder::PCMPXSTRXExplicitLength(OpcodeArgs, uint32_t GPR, uint32_t NumElements) {
+  // REX.W selects between EAX/EDX and RAX/RDX
+  const bool Is64Bit = (Op->Flags & X86Tables::DecodeFlags::FLAG_REX_WIDENING) != 0;
+
+  OrderedNode *Length = LoadGPRRegister(GPR);
+  if (!Is64Bit) {
+    Length = _Sbfe(32, 0, Length);
+  }
+
+  // The length is the absolute value of the register, saturated to the number of elements
+  auto ZeroConst = _Constant(0);
+  auto NumElementsConst = _Constant(NumElements);
+  Length = _Select(FEXCore::IR::COND_SLT, Length, ZeroConst, _Neg(Length), Length);
+  return _Select(FEXCore::IR::COND_UGT, Length, NumElementsConst, NumElementsConst, Length);
+}
+
+OrderedNode* OpDispatchBuilder::PCMPXSTRXImplicitLength(OrderedNode *Src, uint32_t ElementSize) {
+  // The length is the index of the first null element, or the number of elements if there isn't one
+  OrderedNode *Nulls = _VCMPEQZ(16, ElementSize, Src);
+  OrderedNode *Lower = _VExtractToGPR(16, 8, Nulls, 0);
+  OrderedNode *Upper = _VExtractToGPR(16, 8, Nulls, 1);
+
+  auto ZeroConst = _Constant(0);
+  OrderedNode *UpperBit = _Select(FEXCore::IR::COND_EQ, Upper, ZeroConst,
+    _Constant(128), _Add(_FindLSB(Upper), _Constant(64)));
+  OrderedNode *FirstBit = _Select(FEXCore::IR::COND_EQ, Lower, ZeroConst,
+    UpperBit, _FindLSB(Lower));
+
+  return _Lshr(FirstBit, _Constant(ElementSize == 1 ? 3 : 4));
+}
+
+void OpDispatchBuilder::PCMPXSTRXOpImpl(OpcodeArgs, bool IsExplicit, bool IsMask) {
+  // Invalidate deferred flags early
+  InvalidateDeferredFlags();
+
+  LOGMAN_THROW_A_FMT(Op->Src[1].IsLiteral(), "Control needs to be literal here");
+  const auto Control = static_cast<uint8_t>(Op->Src[1].Data.Literal.Value);
+
+  // Control[0] selects words over bytes, Control[1] selects signed elements
+  const uint32_t ElementSize = (Control & 1) ? 2 : 1;
+  const uint32_t NumElements = 16 / ElementSize;
+
+  OrderedNode *LHS = LoadSource(FPRClass, Op, Op->Dest, Op->Flags, -1);
+  OrderedNode *RHS = LoadSource(FPRClass, Op, Op->Src[0], Op->Flags, -1);
+
+  OrderedNode *LHSLength{};
+  OrderedNode *RHSLength{};
+  if (IsExplicit) {
+    LHSLength = PCMPXSTRXExplicitLength(Op, X86State::REG_RAX, NumElements);
+    RHSLength = PCMPXSTRXExplicitLength(Op, X86State::REG_RDX, NumElements);
+  }
+  else {
+    LHSLength = PCMPXSTRXImplicitLength(LHS, ElementSize);
+    RHSLength = PCMPXSTRXImplicitLength(RHS, ElementSize);
+  }
+
+  // Control[6] only changes how the result is written out, the comparison doesn't care
+  OrderedNode *IntRes2 = _VPCMPXSTRX(LHS, RHS, LHSLength, RHSLength, Control & 0x3F);
+
+  if (IsMask) {
+    OrderedNode *Result{};
+    if (Control & 0x40) {
+      // Expand each bit of IntRes2 to a full element mask
+      OrderedNode *MaskVector = _VCastFromGPR(16, 2, IntRes2);
+      OrderedNode *ElementBits{};
+      if (ElementSize == 1) {
+        // Lower eight bytes test the lower byte of the mask, upper eight bytes the upper byte
+        MaskVector = _VInsElement(16, 8, 1, 0,
+          _VDupElement(16, 1, MaskVector, 0),
+          _VDupElement(16, 1, MaskVector, 1));
+        ElementBits = _VDupElement(16, 8, _VCastFromGPR(16, 8, _Constant(0x80402010'08040201ULL)), 0);
+      }
+      else {
+        MaskVector = _VDupElement(16, 2, MaskVector, 0);
+        ElementBits = _VInsGPR(16, 8, 1,
+          _VCastFromGPR(16, 8, _Constant(0x0008'0004'0002'0001ULL)),
+          _Constant(0x0080'0040'0020'0010ULL));
+      }
+      Result = _VCMPEQ(16, ElementSize, _VAnd(16, 1, MaskVector, ElementBits), ElementBits);
+    }
+    else {
+      Result = _VCastFromGPR(16, 4, IntRes2);
+    }
+
+    // Like other 128-bit results this clears the upper bits of YMM0
+    StoreXMMRegister(0, _VMov(16, Result));
+  }
+  else {
+    // Control[6] selects the most significant set bit over the least significant one
+    // ECX is the number of elements when no bit is set
+    auto NumElementsConst = _Constant(NumElements);
+    OrderedNode *Index{};
+    if (Control & 0x40) {
+      Index = _Select(FEXCore::IR::COND_EQ, IntRes2, _Constant(0), NumElementsConst, _FindMSB(IntRes2));
+    }
+    else {
+      Index = _FindLSB(_Or(IntRes2, _Constant(1U << NumElements)));
+    }
+    StoreGPRRegister(X86State::REG_RCX, Index);
+  }
+
+  auto ZeroConst = _Constant(0);
+  auto OneConst = _Constant(1);
+  auto NumElementsConst = _Constant(NumElements);
+
+  SetRFLAG<FEXCore::X86State::RFLAG_CF_LOC>(_Select(FEXCore::IR::COND_NEQ, IntRes2, ZeroConst, OneConst, ZeroConst));
+  SetRFLAG<FEXCore::X86State::RFLAG_ZF_LOC>(_Select(FEXCore::IR::COND_ULT, RHSLength, NumElementsConst, OneConst, ZeroConst));
+  SetRFLAG<FEXCore::X86State::RFLAG_SF_LOC>(_Select(FEXCore::IR::COND_ULT, LHSLength, NumElementsConst, OneConst, ZeroConst));
+  SetRFLAG<FEXCore::X86State::RFLAG_OF_LOC>(IntRes2);
+  ZeroPFAF();
+}
+
+void OpDispatchBuilder::PCMPESTRMOp(OpcodeArgs) {
+  PCMPXSTRXOpImpl(Op, true, true);
+}
+
+void OpDispatchBuilder::PCMPESTRIOp(OpcodeArgs) {
+  PCMPXSTRXOpImpl(Op, true, false);
+}
+
+void OpDispatchBuilder::PCMPISTRMOp(OpcodeArgs) {
+  PCMPXSTRXOpImpl(Op, false, true);
+}
+
+void OpDispatchBuilder::PCMPISTRIOp(OpcodeArgs) {
+  PCMPXSTRXOpImpl(Op, false, false);
+}
+
 void OpDispatchBuilder::VINSERTOp(OpcodeArgs) {
   const auto DstSize = GetDstSize(Op);
   OrderedNode *Src1 = LoadSource(FPRClass, Op, Op->Src[0], Op->Flags, -1);
@@ -3709,6 +4162,45 @@ void OpDispatchBuilder::VINSERTOp(OpcodeArgs) {
   StoreResult(FPRClass, Op, Result, -1);
 }
 
+void OpDispatchBuilder::VEXTRACT128Op(OpcodeArgs) {
+  const auto SrcSize = GetSrcSize(Op);
+  OrderedNode *Src = LoadSource(FPRClass, Op, Op->Src[0], Op->Flags, -1);
+
+  LOGMAN_THROW_A_FMT(Op->Src[1].IsLiteral(), "Src1 needs to be literal here");
+  const auto Selector = Op->Src[1].Data.Literal.Value & 1;
+
+  OrderedNode *Result = Src;
+  if (Selector != 0) {
+    Result = _VInsElement(SrcSize, 16, 0, 1, _VectorZero(SrcSize), Src);
+  }
+
+  StoreResult_WithOpSize(FPRClass, Op, Op->Dest, Result, 16, -1);
+}
+
+void OpDispatchBuilder::VPBLENDDOp(OpcodeArgs) {
+  const auto DstSize = GetDstSize(Op);
+  const auto Is128Bit = DstSize == Core::CPUState::XMM_SSE_REG_SIZE;
+
+  OrderedNode *Src1 = LoadSource(FPRClass, Op, Op->Src[0], Op->Flags, -1);
+  OrderedNode *Src2 = LoadSource(FPRClass, Op, Op->Src[1], Op->Flags, -1);
+
+  LOGMAN_THROW_A_FMT(Op->Src[2].IsLiteral(), "Src2 needs to be literal here");
+  const auto Selector = Op->Src[2].Data.Literal.Value;
+
+  OrderedNode *Result = Src1;
+  for (size_t i = 0; i < DstSize / 4; i++) {
+    if ((Selector >> i) & 1) {
+      Result = _VInsElement(DstSize, 4, i, i, Result, Src2);
+    }
+  }
+
+  if (Is128Bit) {
+    Result = _VMov(16, Result);
+  }
+
+  StoreResult(FPRClass, Op, Result, -1);
+}
+
 void OpDispatchBuilder::VPERM2Op(OpcodeArgs) {
   const auto DstSize = GetDstSize(Op);
   OrderedNode *Src1 = LoadSource(FPRClass, Op, Op->Src[0], Op->Flags, -1);
@@ -3741,6 +4233,29 @@ void OpDispatchBuilder::VPERM2Op(OpcodeArgs) {
   StoreResult(FPRClass, Op, Result, -1);
 }
 
+void OpDispatchBuilder::VPERMDOp(OpcodeArgs) {
+  const auto DstSize = GetDstSize(Op);
+
+  OrderedNode *Indices = LoadSource(FPRClass, Op, Op->Src[0], Op->Flags, -1);
+  OrderedNode *Src = LoadSource(FPRClass, Op, Op->Src[1], Op->Flags, -1);
+
+  // Turn each dword index into the four byte indices of that dword so the
+  // whole permute is a single table lookup across the 256-bit register.
+  //
+  // Byte offset of the selected dword, replicated into every byte of the element
+  OrderedNode *ByteIndices = _VAnd(DstSize, 4, Indices, _VectorImm(DstSize, 4, 0b111));
+  ByteIndices = _VShlI(DstSize, 4, ByteIndices, 2);
+  ByteIndices = _VUMul(DstSize, 4, ByteIndices, _VectorImm(DstSize, 1, 1));
+
+  // Then offset each byte by its position within the dword
+  OrderedNode *ByteOffsets = _VCastFromGPR(DstSize, 4, _Constant(0x03'02'01'00));
+  ByteOffsets = _VDupElement(DstSize, 4, ByteOffsets, 0);
+  ByteIndices = _VAdd(DstSize, 1, ByteIndices, ByteOffsets);
+
+  OrderedNode *Result = _VTBL1(DstSize, Src, ByteIndices);
+  StoreResult(FPRClass, Op, Result, -1);
+}
+
 void OpDispatchBuilder::VPERMQOp(OpcodeArgs) {
   const auto DstSize = GetDstSize(Op);
   OrderedNode *Src = LoadSource(FPRClass, Op, Op->Src[0], Op->Flags, -1);
@@ -3821,4 +4336,84 @@ void OpDispatchBuilder::VPERMILImmOp<4>(OpcodeArgs);
 template
 void OpDispatchBuilder::VPERMILImmOp<8>(OpcodeArgs);
 
+template <size_t AddrElementSize>
+void OpDispatchBuilder::VPGATHEROp(OpcodeArgs) {
+  const auto Size = GetDstSize(Op);
+  const auto ElementSize = (Op->Flags & X86Tables::DecodeFlags::FLAG_OPTION_AVX_W) ? 8 : 4;
+  const auto NumElements = Size / std::max<size_t>(AddrElementSize, ElementSize);
+
+  const uint8_t GPRSize = CTX->GetGPRSize();
+  const uint32_t AddrSize = (Op->Flags & X86Tables::DecodeFlags::FLAG_ADDRESS_SIZE) != 0 ? (GPRSize >> 1) : GPRSize;
+
+  LOGMAN_THROW_A_FMT(Op->Src[1].IsSIB(), "Gathers need a VSIB memory operand");
+  const auto &VSIB = Op->Src[1].Data.SIB;
+
+  // The decoder maps the SIB index to a GPR, which doesn't exist for index 0b100.
+  // Pull the vector index register straight out of the SIB byte instead.
+  X86Tables::SIBDecoded SIB;
+  SIB.Hex = Op->SIB;
+  const auto IndexReg = SIB.index | ((Op->Flags & X86Tables::DecodeFlags::FLAG_REX_XGPR_X) ? 0b1000 : 0);
+  const auto DestReg = Op->Dest.Data.GPR.GPR - FEXCore::X86State::REG_XMM_0;
+  const auto MaskReg = Op->Src[0].Data.GPR.GPR - FEXCore::X86State::REG_XMM_0;
+
+  constexpr auto AVXRegSize = Core::CPUState::XMM_AVX_REG_SIZE;
+
+  for (size_t i = 0; i < NumElements; ++i) {
+    // Only elements with the mask sign bit set get loaded
+    OrderedNode *MaskElement = _VExtractToGPR(AVXRegSize, ElementSize, LoadXMMRegister(MaskReg), i);
+    auto CondJump = _CondJump(_Bfe(1, ElementSize * 8 - 1, MaskElement), {COND_EQ});
+
+    auto LoadBlock = CreateNewCodeBlockAfter(GetCurrentBlock());
+    SetFalseJumpTarget(CondJump, LoadBlock);
+    SetCurrentCodeBlock(LoadBlock);
+
+    OrderedNode *Address = _VExtractToGPR(AVXRegSize, AddrElementSize, LoadXMMRegister(IndexReg), i);
+    if constexpr (AddrElementSize == 4) {
+      Address = _Sbfe(32, 0, Address);
+    }
+
+    if (VSIB.Scale != 1) {
+      Address = _Mul(Address, _Constant(GPRSize * 8, VSIB.Scale));
+    }
+    if (VSIB.Base != FEXCore::X86State::REG_INVALID) {
+      Address = _Add(Address, LoadGPRRegister(VSIB.Base, GPRSize));
+    }
+    if (VSIB.Offset) {
+      Address = _Add(Address, _Constant(GPRSize * 8, VSIB.Offset));
+    }
+    if (AddrSize < GPRSize) {
+      Address = _Bfe(GPRSize, AddrSize * 8, 0, Address);
+    }
+    Address = AppendSegmentOffset(Address, Op->Flags);
+
+    OrderedNode *Element = _LoadMem(FPRClass, ElementSize, Address, ElementSize);
+
+    // Commit each element and clear its mask bit as we go. If a later element
+    // faults, the guest sees the partial progress exactly like hardware and
+    // resumes the gather with only the remaining elements.
+    StoreXMMRegister(DestReg, _VInsElement(AVXRegSize, ElementSize, i, 0, LoadXMMRegister(DestReg), Element));
+    StoreXMMRegister(MaskReg, _VInsElement(AVXRegSize, ElementSize, i, 0, LoadXMMRegister(MaskReg), _VectorZero(16)));
+
+    auto Jump = _Jump();
+    auto NextBlock = CreateNewCodeBlockAfter(LoadBlock);
+    SetJumpTarget(Jump, NextBlock);
+    SetTrueJumpTarget(CondJump, NextBlock);
+    SetCurrentCodeBlock(NextBlock);
+  }
+
+  // Elements past the gathered ones are zeroed, as is the whole mask on completion
+  OrderedNode *Result = LoadXMMRegister(DestReg);
+  const auto ResultSize = NumElements * ElementSize;
+  if (ResultSize != AVXRegSize) {
+    Result = _VMov(ResultSize, Result);
+  }
+  StoreXMMRegister(DestReg, Result);
+  StoreXMMRegister(MaskReg, _VectorZero(AVXRegSize));
+}
+
+template
+void OpDispatchBuilder::VPGATHEROp<4>(OpcodeArgs);
+template
+void OpDispatchBuilder::VPGATHEROp<8>(OpcodeArgs);
+
 }
@@ -14,8 +14,9 @@ $end_info$
 namespace FEXCore::X86Tables {
 using namespace InstFlags;
 
-void InitializeBaseTables(Context::OperatingMode Mode) {
-  static constexpr U8U8InfoStruct BaseOpTable[] = {
+namespace {
+constexpr X86InstInfoTable<MAX_PRIMARY_TABLE_SIZE> GenerateBaseTable(Context::OperatingMode Mode) {
+  constexpr U8U8InfoStruct BaseOpTable[] = {
     // Prefixes
     // Operand size overide
     {0x66, 1, X86InstInfo{"",      TYPE_PREFIX, FLAGS_NONE,        0, nullptr}},
@@ -234,7 +235,7 @@ void InitializeBaseTables(Context::OperatingMode Mode) {
     {0xC4, 2, X86InstInfo{"",   TYPE_VEX_TABLE_PREFIX, FLAGS_NONE, 0, nullptr}},
   };
 
-  static constexpr U8U8InfoStruct BaseOpTable_64[] = {
+  constexpr U8U8InfoStruct BaseOpTable_64[] = {
     {0x06, 2, X86InstInfo{"[INV]",  TYPE_INVALID, FLAGS_NONE,                                                                     0, nullptr}},
     {0x0E, 1, X86InstInfo{"[INV]",  TYPE_INVALID, FLAGS_NONE,                                                                     0, nullptr}},
     {0x16, 2, X86InstInfo{"[INV]",  TYPE_INVALID, FLAGS_NONE,                                                                     0, nullptr}},
@@ -258,7 +259,7 @@ void InitializeBaseTables(Context::OperatingMode Mode) {
     {0xEA, 1, X86InstInfo{"[INV]",  TYPE_INVALID, FLAGS_NONE,                                                                                                      0, nullptr}},
   };
 
-  static constexpr U8U8InfoStruct BaseOpTable_32[] = {
+  constexpr U8U8InfoStruct BaseOpTable_32[] = {
     {0x06, 1, X86InstInfo{"PUSH ES",  TYPE_INST, GenFlagsSrcSize(SIZE_16BIT) | FLAGS_DEBUG_MEM_ACCESS,            0, nullptr}},
     {0x07, 1, X86InstInfo{"POP ES",   TYPE_INST, GenFlagsSizes(SIZE_16BIT, SIZE_DEF) | FLAGS_DEBUG_MEM_ACCESS,    0, nullptr}},
     {0x0E, 1, X86InstInfo{"PUSH CS",  TYPE_INST, GenFlagsSrcSize(SIZE_16BIT) | FLAGS_DEBUG_MEM_ACCESS,            0, nullptr}},
@@ -288,14 +289,28 @@ void InitializeBaseTables(Context::OperatingMode Mode) {
     {0xEA, 1, X86InstInfo{"JMPF",   TYPE_INST, FLAGS_NONE,                                                        0, nullptr}},
   };
 
-  GenerateTable(&BaseOps.at(0), BaseOpTable, std::size(BaseOpTable));
+  X86InstInfoTable<MAX_PRIMARY_TABLE_SIZE> Table{};
+  GenerateTable(&Table.at(0), BaseOpTable, std::size(BaseOpTable));
 
   if (Mode == Context::MODE_64BIT) {
-    GenerateTable(&BaseOps.at(0), BaseOpTable_64, std::size(BaseOpTable_64));
+    GenerateTable(&Table.at(0), BaseOpTable_64, std::size(BaseOpTable_64));
   }
   else {
-    GenerateTable(&BaseOps.at(0), BaseOpTable_32, std::size(BaseOpTable_32));
+    GenerateTable(&Table.at(0), BaseOpTable_32, std::size(BaseOpTable_32));
   }
+
+  return Table;
 }
+
+constexpr auto Table_64 = GenerateBaseTable(Context::MODE_64BIT);
+constexpr auto Table_32 = GenerateBaseTable(Context::MODE_32BIT);
 }
 
+constinit std::array<X86InstInfo, MAX_PRIMARY_TABLE_SIZE> BaseOps = Table_64;
+
+void InitializeBaseTables(Context::OperatingMode Mode) {
+  if (Mode == Context::MODE_32BIT) {
+    BaseOps = Table_32;
+  }
+}
+}
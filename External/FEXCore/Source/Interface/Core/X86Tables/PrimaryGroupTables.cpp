@@ -14,7 +14,8 @@ $end_info$
 namespace FEXCore::X86Tables {
 using namespace InstFlags;
 
-void InitializePrimaryGroupTables(Context::OperatingMode Mode) {
+namespace {
+constexpr X86InstInfoTable<MAX_INST_GROUP_TABLE_SIZE> GeneratePrimaryGroupTable(Context::OperatingMode Mode) {
 #define OPD(group, prefix, Reg) (((group - FEXCore::X86Tables::TYPE_GROUP_1) << 6) | (prefix) << 3 | (Reg))
   const U16U8InfoStruct PrimaryGroupOpTable[] = {
     // GROUP_1 | 0x80 | reg
@@ -163,13 +164,28 @@ void InitializePrimaryGroupTables(Context::OperatingMode Mode) {
 
 #undef OPD
 
-  GenerateTable(&PrimaryInstGroupOps.at(0), PrimaryGroupOpTable, std::size(PrimaryGroupOpTable));
+  X86InstInfoTable<MAX_INST_GROUP_TABLE_SIZE> Table{};
+  GenerateTable(&Table.at(0), PrimaryGroupOpTable, std::size(PrimaryGroupOpTable));
+
   if (Mode == Context::MODE_64BIT) {
-    GenerateTable(&PrimaryInstGroupOps.at(0), PrimaryGroupOpTable_64, std::size(PrimaryGroupOpTable_64));
+    GenerateTable(&Table.at(0), PrimaryGroupOpTable_64, std::size(PrimaryGroupOpTable_64));
   }
   else {
-    GenerateTable(&PrimaryInstGroupOps.at(0), PrimaryGroupOpTable_32, std::size(PrimaryGroupOpTable_32));
+    GenerateTable(&Table.at(0), PrimaryGroupOpTable_32, std::size(PrimaryGroupOpTable_32));
   }
+
+  return Table;
+}
+
+constexpr auto Table_64 = GeneratePrimaryGroupTable(Context::MODE_64BIT);
+constexpr auto Table_32 = GeneratePrimaryGroupTable(Context::MODE_32BIT);
 }
 
+constinit std::array<X86InstInfo, MAX_INST_GROUP_TABLE_SIZE> PrimaryInstGroupOps = Table_64;
+
+void InitializePrimaryGroupTables(Context::OperatingMode Mode) {
+  if (Mode == Context::MODE_32BIT) {
+    PrimaryInstGroupOps = Table_32;
+  }
+}
 }
@@ -12,10 +12,11 @@ $end_info$
 namespace FEXCore::X86Tables {
 using namespace InstFlags;
 
-void InitializeX87Tables() {
+namespace {
+constexpr X86InstInfoTable<MAX_X87_TABLE_SIZE> GenerateX87Table() {
 #define OPD(op, modrmop) (((op - 0xD8) << 8) | modrmop)
 #define OPDReg(op, reg) (((op - 0xD8) << 8) | (reg << 3))
-  static constexpr U16U8InfoStruct X87OpTable[] = {
+  constexpr U16U8InfoStruct X87OpTable[] = {
     // 0xD8
     {OPDReg(0xD8, 0), 1, X86InstInfo{"FADD",  TYPE_X87, FLAGS_MODRM, 0, nullptr}},
     {OPDReg(0xD8, 1), 1, X86InstInfo{"FMUL",  TYPE_X87, FLAGS_MODRM, 0, nullptr}},
@@ -263,6 +264,11 @@ void InitializeX87Tables() {
 #undef OPD
 #undef OPDReg
 
-  GenerateX87Table(&X87Ops.at(0), X87OpTable, std::size(X87OpTable));
+  X86InstInfoTable<MAX_X87_TABLE_SIZE> Table{};
+  GenerateX87Table(&Table.at(0), X87OpTable, std::size(X87OpTable));
+  return Table;
 }
 }
+
+constinit std::array<X86InstInfo, MAX_X87_TABLE_SIZE> X87Ops = GenerateX87Table();
+}
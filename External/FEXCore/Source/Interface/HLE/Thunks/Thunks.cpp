@@ -8,6 +8,7 @@ $end_info$
 #include <FEXCore/Config/Config.h>
 #include <FEXCore/Core/CoreState.h>
 #include <FEXCore/Debug/InternalThreadState.h>
+#include <FEXCore/HLE/SyscallHandler.h>
 #include <FEXCore/Utils/LogManager.h>
 #include <FEXCore/IR/IR.h>
 #include <FEXCore/IR/IREmitter.h>
@@ -19,6 +20,8 @@ $end_info$
 
 #include <Interface/Context/Context.h>
 #include "FEXCore/Core/X86Enums.h"
+#include <array>
+#include <atomic>
 #include <malloc.h>
 #include <mutex>
 #include <unordered_map>
@@ -45,7 +48,7 @@ static __attribute__((aligned(16), naked, section("HostToGuestTrampolineTemplate
     "jmpq *0f(%rip) \n"
     ".align 8 \n"
     "0: \n"
-    ".quad 0, 0, 0, 0 \n" // TrampolineInstanceInfo
+    ".quad 0, 0, 0, 0, 0, 0 \n" // TrampolineInstanceInfo
   );
 #elif defined(_M_ARM_64)
   asm(
@@ -56,7 +59,7 @@ static __attribute__((aligned(16), naked, section("HostToGuestTrampolineTemplate
     // NOTE: GCC over-aligns to a full page when using .align directives on ARM (last tested on GCC 11.2)
     "nop \n"
     "0: \n"
-    ".quad 0, 0, 0, 0 \n" // TrampolineInstanceInfo
+    ".quad 0, 0, 0, 0, 0, 0 \n" // TrampolineInstanceInfo
   );
 #else
 #error Unsupported host architecture
@@ -74,6 +77,10 @@ namespace FEXCore {
       uintptr_t CallCallback;
       uintptr_t GuestUnpacker;
       uintptr_t GuestTarget;
+      // Zero if the guest ABI doesn't pass arguments in registers
+      uintptr_t CallCallbackWithRegisters;
+      // Zero if the guest didn't provide a register variant of GuestUnpacker for this signature
+      uintptr_t GuestRegisterUnpacker;
     };
 
     // Opaque type pointing to an instance of HostToGuestTrampolineTemplate and its
@@ -111,6 +118,33 @@ namespace FEXCore {
 
     HostToGuestTrampolinePtr* MakeHostTrampolineForGuestFunction(void* HostPacker, uintptr_t GuestTarget, uintptr_t GuestUnpacker);
 
+    /**
+     * Per-thread direct-mapped caches of resolved thunks and host trampolines.
+     *
+     * Thunks are looked up every time a block containing a thunk is compiled or relocated (and on every call in the
+     * interpreter), and a trampoline is looked up every time a callback is passed to the host. Both maps only ever
+     * grow, so resolving each key once per thread avoids taking ThunksMutex and hashing the key on later lookups.
+     *
+     * Thunk entries can be rebound when a library is loaded again, so they are tagged with ThunksGeneration.
+     * Misses are never cached since the library providing a thunk may be loaded later.
+     */
+    static std::atomic<uint64_t> ThunksGeneration {1};
+
+    struct ThunkBinding {
+      IR::SHA256Sum Sum;
+      ThunkedFunction* Fn;
+      uint64_t Generation;
+    };
+
+    struct TrampolineBinding {
+      GuestcallInfo Info;
+      HostToGuestTrampolinePtr* Trampoline;
+    };
+
+    static thread_local std::array<ThunkBinding, 64> ThunkBindings;
+    // Indexed by the top 6 bits of a multiplicative hash
+    static thread_local std::array<TrampolineBinding, 64> TrampolineBindings;
+
     struct ThunkHandler_impl final: public ThunkHandler {
         std::shared_mutex ThunksMutex;
 
@@ -162,6 +196,26 @@ namespace FEXCore {
           Thread->CTX->HandleCallback(Thread, (uintptr_t)callback);
         }
 
+        /*
+          Calls a guest function with up to five integer arguments through the register variant of its guest unpacker.
+          Only used for 64-bit guests, the guest target goes to RDI and the arguments to the following argument registers.
+          The result is read from RAX. All of these are caller saved in the guest ABI, like for CallCallback.
+        */
+        static uint64_t CallCallbackWithRegisters(uintptr_t GuestRegisterUnpacker, uintptr_t GuestTarget, const uint64_t *Args, size_t NumArgs) {
+          constexpr X86State::X86Reg ArgumentRegisters[] = {
+            X86State::REG_RSI, X86State::REG_RDX, X86State::REG_RCX, X86State::REG_R8, X86State::REG_R9,
+          };
+
+          auto &State = Thread->CurrentFrame->State;
+          State.gregs[X86State::REG_RDI] = GuestTarget;
+          for (size_t i = 0; i < NumArgs; ++i) {
+            State.gregs[ArgumentRegisters[i]] = Args[i];
+          }
+
+          Thread->CTX->HandleCallback(Thread, GuestRegisterUnpacker);
+          return State.gregs[X86State::REG_RAX];
+        }
+
         /**
          * Instructs the Core to redirect calls to functions at the given
          * address to another function. The original callee address is passed
@@ -237,10 +291,20 @@ namespace FEXCore {
             struct ArgsRV_t {
                 uintptr_t GuestUnpacker;
                 uintptr_t GuestTarget;
+                uintptr_t GuestRegisterUnpacker; // Optional, see CallCallbackWithRegisters
                 uintptr_t rv; // Pointer to host trampoline + TrampolineInstanceInfo
             } *args = reinterpret_cast<ArgsRV_t*>(ArgsRV);
 
-            args->rv = (uintptr_t)MakeHostTrampolineForGuestFunction(nullptr, args->GuestTarget, args->GuestUnpacker);
+            auto Trampoline = MakeHostTrampolineForGuestFunction(nullptr, args->GuestTarget, args->GuestUnpacker);
+
+            // Trampolines created host-side don't know the register unpacker. It only depends on the signature
+            // of GuestUnpacker, so every guest allocating a trampoline for the same pair passes the same one.
+            auto &Info = GetInstanceInfo(Trampoline);
+            if (Info.CallCallbackWithRegisters && args->GuestRegisterUnpacker) {
+                Info.GuestRegisterUnpacker = args->GuestRegisterUnpacker;
+            }
+
+            args->rv = (uintptr_t)Trampoline;
         }
 
         /**
@@ -310,6 +374,7 @@ namespace FEXCore {
                 }
 
                 LogMan::Msg::DFmt("Loaded {} syms", i);
+                ThunksGeneration.fetch_add(1, std::memory_order_release);
             }
         }
 
@@ -331,16 +396,26 @@ namespace FEXCore {
         }
 
         ThunkedFunction* LookupThunk(const IR::SHA256Sum &sha256) override {
+            const auto Generation = ThunksGeneration.load(std::memory_order_acquire);
+            auto &Binding = ThunkBindings[TruncatingSHA256Hash{}(sha256) % ThunkBindings.size()];
+            if (Binding.Generation == Generation && Binding.Sum == sha256) {
+                return Binding.Fn;
+            }
 
-            std::shared_lock lk(ThunksMutex);
+            ThunkedFunction* Fn {};
+            {
+                std::shared_lock lk(ThunksMutex);
 
-            auto it = Thunks.find(sha256);
+                auto it = Thunks.find(sha256);
+                if (it != Thunks.end()) {
+                    Fn = it->second;
+                }
+            }
 
-            if (it != Thunks.end()) {
-                return it->second;
-            } else {
-                return nullptr;
+            if (Fn) {
+                Binding = { sha256, Fn, Generation };
             }
+            return Fn;
         }
 
         void RegisterTLSState(FEXCore::Core::InternalThreadState *Thread) override {
@@ -348,9 +423,11 @@ namespace FEXCore {
         }
 
         void AppendThunkDefinitions(std::vector<FEXCore::IR::ThunkDefinition> const& Definitions) override {
+          std::lock_guard lk(ThunksMutex);
           for (auto & Definition : Definitions) {
             Thunks.emplace(Definition.Sum, Definition.ThunkFunction);
           }
+          ThunksGeneration.fetch_add(1, std::memory_order_release);
         }
     };
 
@@ -358,6 +435,17 @@ namespace FEXCore {
       return new ThunkHandler_impl();
     }
 
+    uint64_t CallThunk(uint64_t ArgPtr, uint64_t Arg1, uint64_t Arg2, uint64_t Arg3, uint64_t Arg4, uint64_t Arg5, ThunkedFunction *Fn) {
+      // Same as the JITs calling it directly, passing all six arguments and reading the result register is harmless for every thunk
+      using RegisterThunkFn = uint64_t(uint64_t, uint64_t, uint64_t, uint64_t, uint64_t, uint64_t);
+
+      auto SyscallHandler = Thread->CTX->SyscallHandler;
+      SyscallHandler->ThunkCallEnter();
+      const auto Result = reinterpret_cast<RegisterThunkFn*>(Fn)(ArgPtr, Arg1, Arg2, Arg3, Arg4, Arg5);
+      SyscallHandler->ThunkCallExit();
+      return Result;
+    }
+
     /**
      * Generates a host-callable trampoline to call guest functions via the host ABI.
      *
@@ -390,12 +478,21 @@ namespace FEXCore {
 
       const GuestcallInfo gci = { GuestUnpacker, GuestTarget };
 
+      // Trampolines are never freed, so a binding stays valid once it has been resolved
+      // Function addresses are aligned, so mix the bits before picking an entry
+      const auto BindingIndex = (GuestcallInfoHash{}(gci) * 0x9E3779B97F4A7C15ULL) >> 58;
+      auto &Binding = TrampolineBindings[BindingIndex];
+      if (Binding.Trampoline && Binding.Info == gci) {
+        return Binding.Trampoline;
+      }
+
       // Try first with shared_lock
       {
         std::shared_lock lk(ThunkHandler->ThunksMutex);
 
         auto found = ThunkHandler->GuestcallToHostTrampoline.find(gci);
         if (found != ThunkHandler->GuestcallToHostTrampoline.end()) {
+          Binding = { gci, found->second };
           return found->second;
         }
       }
@@ -432,10 +529,13 @@ namespace FEXCore {
           .HostPacker = HostPacker,
           .CallCallback = (uintptr_t)&ThunkHandler_impl::CallCallback,
           .GuestUnpacker = GuestUnpacker,
-          .GuestTarget = GuestTarget
+          .GuestTarget = GuestTarget,
+          .CallCallbackWithRegisters = CTX->Config.Is64BitMode ? (uintptr_t)&ThunkHandler_impl::CallCallbackWithRegisters : 0,
+          .GuestRegisterUnpacker = 0,
       };
 
       ThunkHandler->GuestcallToHostTrampoline[gci] = HostTrampoline;
+      Binding = { gci, HostTrampoline };
       return HostTrampoline;
     }
 
@@ -23,8 +23,21 @@ namespace FEXCore::IR {
 }
 
 namespace FEXCore {
+    // Thunks with packed arguments take a pointer to them in guest memory.
+    // Register thunks are called with the guest's six integer argument registers and
+    // return an integer, which works through this type since OP_THUNK always passes all of them.
     typedef void ThunkedFunction(void* ArgsRv);
 
+    // Guest stubs for OP_THUNK are `0F 3F`, followed by the SHA256 of the thunk name and a byte of these flags.
+    // They are emitted by the guest thunk libraries (see ThunkLibs/include/common/Guest.h), so the IR of a thunk
+    // only depends on guest code and not on whether the host library is loaded yet.
+    enum ThunkFlags : uint8_t {
+      // Arguments are in the guest argument registers instead of packed in guest memory
+      THUNK_FLAG_REGISTERS = 1 << 0,
+      // The host function returns an integer, which is stored to RAX
+      THUNK_FLAG_RESULT    = 1 << 1,
+    };
+
     class ThunkHandler {
     public:
         virtual ThunkedFunction* LookupThunk(const IR::SHA256Sum &sha256) = 0;
@@ -35,4 +48,8 @@ namespace FEXCore {
 
         virtual void AppendThunkDefinitions(std::vector<FEXCore::IR::ThunkDefinition> const& Definitions) = 0;
     };
+
+    // Calls a thunked host function with OP_THUNK's arguments, between the syscall handler's ThunkCallEnter and ThunkCallExit.
+    // Used by the backends instead of calling the function directly when TSO page tracking is enabled.
+    uint64_t CallThunk(uint64_t ArgPtr, uint64_t Arg1, uint64_t Arg2, uint64_t Arg3, uint64_t Arg4, uint64_t Arg5, ThunkedFunction *Fn);
 };
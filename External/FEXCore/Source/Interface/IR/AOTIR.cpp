@@ -379,8 +379,9 @@ namespace FEXCore::IR {
       // append optimization flags to the fileid
       fileid += (CTX->Config.SMCChecks == FEXCore::Config::CONFIG_SMC_FULL) ? "S" : "s";
       fileid += CTX->Config.TSOEnabled ? "T" : "t";
+      fileid += CTX->Config.TSORelaxPrivateAccesses ? "R" : "r";
+      fileid += CTX->Config.TSOPageTracking ? "W" : "w";
       fileid += CTX->Config.ABILocalFlags ? "L" : "l";
-      fileid += CTX->Config.ABINoPF ? "p" : "P";
 
       std::unique_lock lk(AOTIRCacheLock);
 
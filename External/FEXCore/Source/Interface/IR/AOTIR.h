@@ -37,7 +37,7 @@ namespace FEXCore::IR {
 
     return Cookie;
   };
-  constexpr static uint32_t AOTIR_VERSION = 0x0000'00004;
+  constexpr static uint32_t AOTIR_VERSION = 0x0000'00008;
   constexpr static uint64_t AOTIR_COOKIE = COOKIE_VERSION("FEXI", AOTIR_VERSION);
 
   struct AOTIRInlineEntry {
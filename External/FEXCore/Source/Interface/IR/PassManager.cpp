@@ -21,6 +21,12 @@ void PassManager::AddDefaultPasses(FEXCore::Context::Context *ctx, bool InlineCo
   FEX_CONFIG_OPT(DisablePasses, O0);
 
   if (!DisablePasses()) {
+    if (ctx->Config.TSORelaxPrivateAccesses) {
+      // This needs to run before RCLSE
+      // Classification relies on GPR and segment base loads not having been forwarded yet
+      InsertPass(CreateTSOAccessClassification());
+    }
+
     InsertPass(CreateContextLoadStoreElimination(ctx->HostFeatures.SupportsAVX));
 
     if (Is64BitMode()) {
@@ -41,7 +47,7 @@ void PassManager::AddDefaultPasses(FEXCore::Context::Context *ctx, bool InlineCo
 
   // If the IR is compacted post-RA then the node indexing gets messed up and the backend isn't able to find the register assigned to a node
   // Compact before IR, don't worry about RA generating spills/fills
-  InsertPass(CreateIRCompaction(ctx->OpDispatcherAllocator), "Compaction");
+  InsertPass(CreateIRCompaction(), "Compaction");
 }
 
 void PassManager::AddDefaultValidationPasses() {
@@ -74,4 +80,10 @@ bool PassManager::Run(IREmitter *IREmit) {
   return Changed;
 }
 
+void PassManager::ReleaseMemory() {
+  for (auto const &Pass : Passes) {
+    Pass->ReleaseMemory();
+  }
+}
+
 }
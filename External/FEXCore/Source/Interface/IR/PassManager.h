@@ -29,6 +29,9 @@ public:
   virtual ~Pass() = default;
   virtual bool Run(IREmitter *IREmit) = 0;
 
+  // Gives back memory the pass keeps around between compiles
+  virtual void ReleaseMemory() {}
+
   void RegisterPassManager(PassManager *_Manager) {
     Manager = _Manager;
   }
@@ -55,6 +58,7 @@ public:
   void InsertRegisterAllocationPass(bool OptimizeSRA, bool SupportsAVX);
 
   bool Run(IREmitter *IREmit);
+  void ReleaseMemory();
 
   void RegisterExitHandler(ShouldExitHandler Handler) {
     ExitHandler = std::move(Handler);
@@ -32,8 +32,11 @@ static_assert(sizeof(RemapNode) == 4);
 
 class IRCompaction final : public FEXCore::IR::Pass {
 public:
-  IRCompaction(FEXCore::Utils::IntrusivePooledAllocator &Allocator);
+  IRCompaction();
   bool Run(IREmitter *IREmit) override;
+  void ReleaseMemory() override {
+    LocalBuilder.ReleaseArena();
+  }
 
 private:
   static constexpr size_t AlignSize = 0x2000;
@@ -47,16 +50,13 @@ private:
   std::vector<CodeBlockData> GeneratedCodeBlocks{};
 };
 
-IRCompaction::IRCompaction(FEXCore::Utils::IntrusivePooledAllocator &Allocator)
-  : LocalBuilder {Allocator} {
+IRCompaction::IRCompaction() {
   OldToNewRemap.resize(AlignSize);
 }
 
 bool IRCompaction::Run(IREmitter *IREmit) {
   FEXCORE_PROFILE_SCOPED("PassManager::IRCompaction");
 
-  LocalBuilder.ReownOrClaimBuffer();
-
   auto CurrentIR = IREmit->ViewIR();
   uint32_t NodeCount = CurrentIR.GetSSACount();
 
@@ -216,12 +216,13 @@ bool IRCompaction::Run(IREmitter *IREmit) {
 
   IREmit->CopyData(LocalBuilder);
 
-  LocalBuilder.DelayedDisownBuffer();
+  // The compacted copy now lives in the caller's arena
+  LocalBuilder.TrimArena();
   return true;
 }
 
-std::unique_ptr<FEXCore::IR::Pass> CreateIRCompaction(FEXCore::Utils::IntrusivePooledAllocator &Allocator) {
-  return std::make_unique<IRCompaction>(Allocator);
+std::unique_ptr<FEXCore::IR::Pass> CreateIRCompaction() {
+  return std::make_unique<IRCompaction>();
 }
 
 }
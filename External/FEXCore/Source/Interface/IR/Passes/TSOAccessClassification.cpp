@@ -0,0 +1,212 @@
+/*
+$info$
+tags: ir|opts
+desc: Relaxes TSO memory accesses that are classified as thread-private
+$end_info$
+*/
+
+#include "Interface/IR/PassManager.h"
+
+#include <FEXCore/Core/CoreState.h>
+#include <FEXCore/Core/X86Enums.h>
+#include <FEXCore/IR/IR.h>
+#include <FEXCore/IR/IREmitter.h>
+#include <FEXCore/IR/IntrusiveIRList.h>
+#include <FEXCore/Utils/Profiler.h>
+
+#include <cstddef>
+#include <memory>
+#include <stdint.h>
+
+namespace FEXCore::IR {
+
+// Classifies LoadMemTSO/StoreMemTSO addresses before context load/store elimination runs.
+// At that point every guest GPR read is still a LoadRegister and every segment base is still a LoadContext,
+// so the address expression can be matched directly against what the OpDispatcher emitted.
+//
+// Accesses that are considered thread-private:
+// - Stack accesses: RSP plus or minus a constant displacement.
+//   RBP is only a frame pointer if the block set it from RSP earlier on. Code built with -fomit-frame-pointer
+//   uses it as a general purpose register, which may point to shared memory.
+// - TLS accesses: The FS or GS segment base plus a constant displacement.
+//   An index register could hold the offset of any address from the segment base.
+//
+// In 32-bit mode every address gets a segment base added. The flat ES/CS/SS/DS bases are looked through
+// since they don't change which memory a stack access touches.
+//
+// These accesses get converted to regular LoadMem/StoreMem which have identical layouts.
+class TSOAccessClassification final : public FEXCore::IR::Pass {
+public:
+  bool Run(IREmitter *IREmit) override;
+private:
+  bool IsStackFrameBase(IREmitter *IREmit, OrderedNodeWrapper Arg) const;
+  bool IsTLSBase(IREmitter *IREmit, OrderedNodeWrapper Arg) const;
+  bool IsFlatSegmentBase(IREmitter *IREmit, OrderedNodeWrapper Arg) const;
+  bool IsStackAddress(IREmitter *IREmit, OrderedNodeWrapper Addr, uint32_t Depth) const;
+  bool IsThreadPrivateAddress(IREmitter *IREmit, OrderedNodeWrapper Addr) const;
+
+  // Matching depth is bounded, the OpDispatcher never nests address calculation deeply.
+  constexpr static uint32_t MaxDepth = 4;
+
+  // Set while RBP holds a stack address that was computed from RSP in the current block
+  bool RBPIsFramePointer{};
+};
+
+bool TSOAccessClassification::IsStackFrameBase(IREmitter *IREmit, OrderedNodeWrapper Arg) const {
+  auto IROp = IREmit->GetOpHeader(Arg);
+  if (IROp->Op != OP_LOADREGISTER) {
+    return false;
+  }
+
+  auto Op = IROp->C<IR::IROp_LoadRegister>();
+  if (Op->Class != GPRClass) {
+    return false;
+  }
+
+  return Op->Offset == offsetof(FEXCore::Core::CPUState, gregs[FEXCore::X86State::REG_RSP]) ||
+    (RBPIsFramePointer && Op->Offset == offsetof(FEXCore::Core::CPUState, gregs[FEXCore::X86State::REG_RBP]));
+}
+
+bool TSOAccessClassification::IsTLSBase(IREmitter *IREmit, OrderedNodeWrapper Arg) const {
+  auto IROp = IREmit->GetOpHeader(Arg);
+  if (IROp->Op != OP_LOADCONTEXT) {
+    return false;
+  }
+
+  auto Op = IROp->C<IR::IROp_LoadContext>();
+  return Op->Offset == offsetof(FEXCore::Core::CPUState, fs_cached) ||
+         Op->Offset == offsetof(FEXCore::Core::CPUState, gs_cached);
+}
+
+bool TSOAccessClassification::IsFlatSegmentBase(IREmitter *IREmit, OrderedNodeWrapper Arg) const {
+  auto IROp = IREmit->GetOpHeader(Arg);
+  if (IROp->Op != OP_LOADCONTEXT) {
+    return false;
+  }
+
+  auto Op = IROp->C<IR::IROp_LoadContext>();
+  return Op->Offset == offsetof(FEXCore::Core::CPUState, es_cached) ||
+         Op->Offset == offsetof(FEXCore::Core::CPUState, cs_cached) ||
+         Op->Offset == offsetof(FEXCore::Core::CPUState, ss_cached) ||
+         Op->Offset == offsetof(FEXCore::Core::CPUState, ds_cached);
+}
+
+bool TSOAccessClassification::IsStackAddress(IREmitter *IREmit, OrderedNodeWrapper Addr, uint32_t Depth) const {
+  if (Depth > MaxDepth) {
+    return false;
+  }
+
+  if (IsStackFrameBase(IREmit, Addr)) {
+    return true;
+  }
+
+  auto IROp = IREmit->GetOpHeader(Addr);
+  switch (IROp->Op) {
+    case OP_ADD: {
+      // 32-bit segment base: Classify the address it was added to
+      if (IsFlatSegmentBase(IREmit, IROp->Args[1])) {
+        return IsStackAddress(IREmit, IROp->Args[0], Depth + 1);
+      }
+      if (IsFlatSegmentBase(IREmit, IROp->Args[0])) {
+        return IsStackAddress(IREmit, IROp->Args[1], Depth + 1);
+      }
+
+      // Only a constant displacement from the frame.
+      // An index register could be pointing anywhere.
+      uint64_t Constant;
+      if (IREmit->IsValueConstant(IROp->Args[1], &Constant)) {
+        return IsStackAddress(IREmit, IROp->Args[0], Depth + 1);
+      }
+      if (IREmit->IsValueConstant(IROp->Args[0], &Constant)) {
+        return IsStackAddress(IREmit, IROp->Args[1], Depth + 1);
+      }
+      return false;
+    }
+    case OP_SUB: {
+      // Negative displacements once they have been canonicalized to a subtract
+      uint64_t Constant;
+      if (IREmit->IsValueConstant(IROp->Args[1], &Constant)) {
+        return IsStackAddress(IREmit, IROp->Args[0], Depth + 1);
+      }
+      return false;
+    }
+    case OP_BFE: {
+      // 32-bit address size truncation
+      auto Op = IROp->C<IR::IROp_Bfe>();
+      if (Op->lsb == 0) {
+        return IsStackAddress(IREmit, Op->Header.Args[0], Depth + 1);
+      }
+      return false;
+    }
+    default:
+      return false;
+  }
+}
+
+bool TSOAccessClassification::IsThreadPrivateAddress(IREmitter *IREmit, OrderedNodeWrapper Addr) const {
+  // FS/GS relative: The thread's TLS base plus a constant displacement
+  if (IsTLSBase(IREmit, Addr)) {
+    return true;
+  }
+
+  auto IROp = IREmit->GetOpHeader(Addr);
+  if (IROp->Op == OP_ADD) {
+    uint64_t Constant;
+    if ((IsTLSBase(IREmit, IROp->Args[0]) && IREmit->IsValueConstant(IROp->Args[1], &Constant)) ||
+        (IsTLSBase(IREmit, IROp->Args[1]) && IREmit->IsValueConstant(IROp->Args[0], &Constant))) {
+      return true;
+    }
+  }
+
+  return IsStackAddress(IREmit, Addr, 0);
+}
+
+bool TSOAccessClassification::Run(IREmitter *IREmit) {
+  FEXCORE_PROFILE_SCOPED("PassManager::TSOAccessClassification");
+
+  bool Changed = false;
+  auto CurrentIR = IREmit->ViewIR();
+
+  for (auto [BlockNode, BlockHeader] : CurrentIR.GetBlocks()) {
+    // Other blocks may be entered with any value in RBP
+    RBPIsFramePointer = false;
+
+    for (auto [CodeNode, IROp] : CurrentIR.GetCode(BlockNode)) {
+      if (IROp->Op == OP_LOADMEMTSO) {
+        auto Op = IROp->CW<IR::IROp_LoadMemTSO>();
+        if (Op->Offset.IsInvalid() &&
+            IsThreadPrivateAddress(IREmit, Op->Addr)) {
+          // LoadMem and LoadMemTSO share the same layout
+          IROp->Op = OP_LOADMEM;
+          Changed = true;
+        }
+      }
+      else if (IROp->Op == OP_STOREMEMTSO) {
+        auto Op = IROp->CW<IR::IROp_StoreMemTSO>();
+        if (Op->Offset.IsInvalid() &&
+            IsThreadPrivateAddress(IREmit, Op->Addr)) {
+          // StoreMem and StoreMemTSO share the same layout
+          IROp->Op = OP_STOREMEM;
+          Changed = true;
+        }
+      }
+      else if (IROp->Op == OP_STOREREGISTER) {
+        // Frame setup (mov rbp, rsp) makes RBP a frame pointer for the rest of the block, any other write ends that
+        auto Op = IROp->C<IR::IROp_StoreRegister>();
+        if (Op->Class == GPRClass &&
+            Op->Offset == offsetof(FEXCore::Core::CPUState, gregs[FEXCore::X86State::REG_RBP])) {
+          // Partial writes are a Bfi of the old value, which never matches
+          RBPIsFramePointer = IsStackAddress(IREmit, Op->Value, 0);
+        }
+      }
+    }
+  }
+
+  return Changed;
+}
+
+std::unique_ptr<FEXCore::IR::Pass> CreateTSOAccessClassification() {
+  return std::make_unique<TSOAccessClassification>();
+}
+
+}
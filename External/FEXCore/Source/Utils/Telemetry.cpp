@@ -22,6 +22,20 @@ namespace FEXCore::Telemetry {
     "32bit CAS Tear",
     "64bit CAS Tear",
     "128bit CAS Tear",
+    "CF reads",
+    "CF writes",
+    "PF reads",
+    "PF writes",
+    "AF reads",
+    "AF writes",
+    "ZF reads",
+    "ZF writes",
+    "SF reads",
+    "SF writes",
+    "OF reads",
+    "OF writes",
+    "Peak IR memory per compile",
+    "IR arena trims",
   };
   void Initialize() {
     auto DataDirectory = Config::GetDataDirectory();
@@ -14,6 +14,7 @@
 #include <set>
 #include <mutex>
 #include <shared_mutex>
+#include <vector>
 
 namespace FEXCore {
   class CodeLoader;
@@ -69,6 +70,14 @@ namespace FEXCore::Context {
       std::unique_lock<std::shared_mutex> lock;
   };
 
+  /**
+   * @brief A guest function's code range, [Start, End)
+   */
+  struct FunctionRange {
+    uint64_t Start;
+    uint64_t End;
+  };
+
   using CustomCPUFactoryType = std::function<std::unique_ptr<FEXCore::CPU::CPUBackend> (FEXCore::Context::Context*, FEXCore::Core::InternalThreadState *Thread)>;
 
   using ExitHandler = std::function<void(uint64_t ThreadId, FEXCore::Context::ExitReason)>;
@@ -274,10 +283,81 @@ namespace FEXCore::Context {
   FEX_DEFAULT_VISIBILITY void SetAOTIRRenamer(FEXCore::Context::Context *CTX, std::function<void(const std::string&)> CacheRenamer);
 
   FEX_DEFAULT_VISIBILITY void FinalizeAOTIRCache(FEXCore::Context::Context *CTX);
+
+  /**
+   * @name Code object cache
+   *
+   * Only does something when CacheObjectCodeCompilation is enabled
+   * @{ */
+  /**
+   * @brief Sets the function that returns the memfd of the cross-process code cache for a file
+   *
+   * Called from an FEXCore owned thread. Returns -1 if there is no cache for the file.
+   */
+  FEX_DEFAULT_VISIBILITY void SetCodeCacheFDRequester(FEXCore::Context::Context *CTX, std::function<int(const std::string&)> Requester);
+
+  /**
+   * @brief Tells the code object cache about an executable file mapping
+   *
+   * @param FileIdentity - Uniquely identifies the contents of the file, code compiled for one process is reused by
+   *                       other processes mapping a file with the same identity
+   */
+  FEX_DEFAULT_VISIBILITY void AddNamedRegion(FEXCore::Context::Context *CTX, uintptr_t Base, uintptr_t Size, uintptr_t Offset, const std::string &Filename, const std::string &FileIdentity);
+  FEX_DEFAULT_VISIBILITY void RemoveNamedRegion(FEXCore::Context::Context *CTX, uintptr_t Base, uintptr_t Size);
+  /**  @} */
   FEX_DEFAULT_VISIBILITY void WriteFilesWithCode(FEXCore::Context::Context *CTX, std::function<void(const std::string& fileid, const std::string& filename)> Writer);
   FEX_DEFAULT_VISIBILITY void InvalidateGuestCodeRange(FEXCore::Context::Context *CTX, uint64_t Start, uint64_t Length);
   FEX_DEFAULT_VISIBILITY void InvalidateGuestCodeRange(FEXCore::Context::Context *CTX, uint64_t Start, uint64_t Length, std::function<void(uint64_t start, uint64_t Length)> callback);
   FEX_DEFAULT_VISIBILITY void MarkMemoryShared(FEXCore::Context::Context *CTX);
+  FEX_DEFAULT_VISIBILITY void MarkMemorySharedByThreads(FEXCore::Context::Context *CTX);
+  FEX_DEFAULT_VISIBILITY bool IsTSOPageTrackingActive(FEXCore::Context::Context *CTX);
+  FEX_DEFAULT_VISIBILITY uint64_t FindGuestBlockFromHostPC(FEXCore::Core::InternalThreadState *Thread, uintptr_t HostPC);
+  FEX_DEFAULT_VISIBILITY void MarkBlockRequiresTSO(FEXCore::Context::Context *CTX, uint64_t GuestRIP);
+
+  /**
+   * @brief Checks if any compiled block, on any thread, covers part of the guest range
+   *
+   * Takes no locks and doesn't allocate, safe to call from a signal handler.
+   * Precise to 64 bytes, ranges it can't account for are reported as code.
+   */
+  FEX_DEFAULT_VISIBILITY bool IsGuestCodeInRange(FEXCore::Context::Context *CTX, uint64_t Start, uint64_t Length);
+
+  /**
+   * @brief Makes code on a guest page validate itself on every run
+   *
+   * For pages where mprotect based SMC tracking keeps thrashing.
+   * Only affects code compiled after this call.
+   */
+  FEX_DEFAULT_VISIBILITY void MarkGuestCodePageValidated(FEXCore::Context::Context *CTX, uint64_t PageBase);
+  FEX_DEFAULT_VISIBILITY bool IsGuestCodePageValidated(FEXCore::Context::Context *CTX, uint64_t PageBase);
+  FEX_DEFAULT_VISIBILITY void ClearGuestCodePagesValidated(FEXCore::Context::Context *CTX, uint64_t Start, uint64_t Length);
+
+  /**
+   * @brief Performs the store that faulted in a host signal handler and steps over it
+   *
+   * Lets a write to a protected page go through without unprotecting it.
+   * Write is called with the store's target, data and whether it has release semantics,
+   * and returns if it was performed.
+   *
+   * @return false if the store wasn't decodable or Write failed, the instruction is left as is
+   */
+  FEX_DEFAULT_VISIBILITY bool EmulateFaultingStore(void *ucontext, std::function<bool(uint64_t Addr, void const *Data, size_t Size, bool Release)> const &Write);
+
+  /**
+   * @brief Registers guest function bounds for MultiblockFunctions compilation
+   *
+   * Code compiled from an entrypoint inside one of these functions may cover the whole function.
+   * Ranges that overlap already registered ranges replace them.
+   */
+  FEX_DEFAULT_VISIBILITY void AddFunctionRanges(FEXCore::Context::Context *CTX, std::vector<FunctionRange> const &Ranges);
+  FEX_DEFAULT_VISIBILITY void RemoveFunctionRanges(FEXCore::Context::Context *CTX, uint64_t Base, uint64_t Size);
+
+  /**
+   * @brief Gives back the memory a thread keeps around for compiling
+   *
+   * For when the thread is about to block. The next compile on the thread faults the memory back in.
+   */
+  FEX_DEFAULT_VISIBILITY void ReleaseCompileMemory(FEXCore::Core::InternalThreadState *Thread);
 
   FEX_DEFAULT_VISIBILITY void ConfigureAOTGen(FEXCore::Core::InternalThreadState *Thread, std::set<uint64_t> *ExternalBranches, uint64_t SectionMaxAddress);
   FEX_DEFAULT_VISIBILITY CustomIRResult AddCustomIREntrypoint(FEXCore::Context::Context *CTX, uintptr_t Entrypoint, std::function<void(uintptr_t Entrypoint, FEXCore::IR::IREmitter *)> Handler, void *Creator = nullptr, void *Data = nullptr);
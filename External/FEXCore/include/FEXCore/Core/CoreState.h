@@ -3,8 +3,10 @@
 #include <FEXCore/HLE/Linux/ThreadManagement.h>
 #include <FEXCore/Utils/CompilerDefs.h>
 #include <FEXCore/Core/CPUBackend.h>
+#include <FEXCore/Core/X86Enums.h>
 
 #include <atomic>
+#include <bit>
 #include <cstddef>
 #include <stdint.h>
 #include <string_view>
@@ -63,6 +65,35 @@ namespace FEXCore::Core {
     static constexpr size_t NUM_GPRS = sizeof(gregs) / GPR_REG_SIZE;
     static constexpr size_t NUM_XMMS = sizeof(xmm) / XMM_AVX_REG_SIZE;
     static constexpr size_t NUM_MMS = sizeof(mm) / MM_REG_SIZE;
+
+    // The flags array holds EFLAGS broken out one bit per byte, except for PF and AF.
+    // Those hold what the flags are calculated from instead, and only get calculated when read.
+    // PF is set when the PF byte has even parity, AF is bit 4 of the AF byte xor'd with the PF byte.
+    // Always go through these when converting between EFLAGS and the flags array.
+    uint32_t GetPackedEFLAGS() const {
+      uint32_t EFLAGS{};
+      for (size_t i = 0; i < NUM_EFLAG_BITS; ++i) {
+        EFLAGS |= static_cast<uint32_t>(flags[i] & 1) << i;
+      }
+
+      const uint8_t PFRaw = flags[X86State::RFLAG_PF_LOC];
+      const uint8_t AFRaw = flags[X86State::RFLAG_AF_LOC];
+      EFLAGS &= ~((1U << X86State::RFLAG_PF_LOC) | (1U << X86State::RFLAG_AF_LOC));
+      EFLAGS |= static_cast<uint32_t>((std::popcount(PFRaw) & 1) ^ 1) << X86State::RFLAG_PF_LOC;
+      EFLAGS |= static_cast<uint32_t>(((AFRaw ^ PFRaw) >> 4) & 1) << X86State::RFLAG_AF_LOC;
+      return EFLAGS;
+    }
+
+    void SetPackedEFLAGS(uint32_t EFLAGS) {
+      for (size_t i = 0; i < NUM_EFLAG_BITS; ++i) {
+        flags[i] = (EFLAGS >> i) & 1;
+      }
+
+      // A single set bit has odd parity
+      const uint8_t PFRaw = flags[X86State::RFLAG_PF_LOC] ^ 1;
+      flags[X86State::RFLAG_PF_LOC] = PFRaw;
+      flags[X86State::RFLAG_AF_LOC] = (flags[X86State::RFLAG_AF_LOC] << 4) ^ PFRaw;
+    }
   };
   static_assert(offsetof(CPUState, xmm) % 32 == 0, "xmm needs to be 256-bit aligned!");
   static_assert(offsetof(CPUState, mm) % 16 == 0, "mm needs to be 128-bit aligned!");
@@ -141,6 +172,7 @@ namespace FEXCore::Core {
       uint64_t CPUIDFunction{};
       uint64_t SyscallHandlerObj{};
       uint64_t SyscallHandlerFunc{};
+      uint64_t CallThunkFunc{};
       uint64_t ExitFunctionLink{};
 
       uint64_t FallbackHandlerPointers[FallbackHandlerIndex::OPINDEX_MAX];
@@ -24,6 +24,9 @@ class HostFeatures final {
     bool Supports3DNow{};
     bool SupportsSSE4A{};
     bool SupportsAVX{};
+    bool SupportsAVX2{};
+    bool SupportsFMA{};
+    bool SupportsF16C{};
     bool SupportsSHA{};
     bool SupportsBMI1{};
     bool SupportsBMI2{};
@@ -51,6 +51,11 @@ namespace FEXCore::Core {
     ptrdiff_t HostEntryOffset;
   };
 
+  struct DebugDataResumeEntry {
+    uint64_t GuestEntryOffset;
+    ptrdiff_t HostEntryOffset;
+  };
+
   /**
    * @brief Contains debug data for a block of code for later debugger analysis
    *
@@ -60,6 +65,7 @@ namespace FEXCore::Core {
     uint64_t HostCodeSize; ///< The size of the code generated in the host JIT
     std::vector<DebugDataSubblock> Subblocks;
     std::vector<DebugDataGuestOpcode> GuestOpcodes;
+    std::vector<DebugDataResumeEntry> ResumeEntries; ///< Blocks past the entry that the dispatcher can enter directly
     std::vector<FEXCore::CPU::Relocation> *Relocations;
   };
 
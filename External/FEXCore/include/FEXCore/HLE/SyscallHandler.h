@@ -82,6 +82,11 @@ namespace FEXCore::HLE {
     virtual void MarkGuestExecutableRange(uint64_t Start, uint64_t Length) { }
     virtual AOTIRCacheEntryLookupResult LookupAOTIRCacheEntry(uint64_t GuestAddr) = 0;
 
+    // Called around thunked host functions when TSO page tracking is enabled.
+    // Host code accesses guest memory directly and through the kernel, like a syscall does.
+    virtual void ThunkCallEnter() { }
+    virtual void ThunkCallExit() { }
+
     virtual SourcecodeResolver *GetSourcecodeResolver() { return nullptr; }
   protected:
     SyscallOSABI OSABI;
@@ -4,6 +4,7 @@
 #include <FEXCore/IR/IR.h>
 
 #include <FEXCore/Utils/LogManager.h>
+#include <FEXHeaderUtils/TypeDefines.h>
 
 #include <algorithm>
 #include <new>
@@ -20,20 +21,40 @@ friend class FEXCore::IR::Pass;
 friend class FEXCore::IR::PassManager;
 
   public:
-    IREmitter(FEXCore::Utils::IntrusivePooledAllocator &ThreadAllocator)
-      : DualListData {ThreadAllocator, 8 * 1024 * 1024} {
-      ReownOrClaimBuffer();
+    IREmitter()
+      : DualListData {8 * 1024 * 1024, 512 * 1024} {
       ResetWorkingList();
     }
 
-    void ReownOrClaimBuffer() {
-      DualListData.ReownOrClaimBuffer();
+    /**
+     * @brief Releases arena memory past the retained size once the current IR is done with
+     *
+     * @return true if any memory was released
+     */
+    bool TrimArena() {
+      const bool Released = DualListData.Trim();
+      ResetWorkingList();
+      return Released;
     }
 
-    void DelayedDisownBuffer() {
-      DualListData.DelayedDisownBuffer();
+    /**
+     * @brief Releases the retained arena memory as well, for when the thread stops compiling
+     *
+     * Keeps the first page since resetting the working list writes to it straight away.
+     *
+     * @return true if any memory was released
+     */
+    bool ReleaseArena() {
+      const bool Released = DualListData.Trim(FHU::FEX_PAGE_SIZE);
+      ResetWorkingList();
+      return Released;
     }
 
+    /**
+     * @brief Peak IR memory used since the last trim, in bytes
+     */
+    size_t GetPeakIRSize() const { return DualListData.PeakSize(); }
+
     IRListView ViewIR() { return IRListView(&DualListData, false); }
     IRListView *CreateIRCopy() { return new IRListView(&DualListData, true); }
     void ResetWorkingList();
@@ -351,7 +372,7 @@ friend class FEXCore::IR::PassManager;
     OrderedNode *CurrentWriteCursor = nullptr;
 
     // These could be combined with a little bit of work to be more efficient with memory usage. Isn't a big deal
-    DualIntrusiveAllocatorThreadPool DualListData;
+    DualIntrusiveAllocatorArena DualListData;
 
     OrderedNode *InvalidNode;
     OrderedNode *CurrentCodeBlock{};
@@ -3,8 +3,9 @@
 #include "FEXCore/IR/IR.h"
 #include <FEXCore/Utils/Allocator.h>
 #include <FEXCore/Utils/LogManager.h>
-#include <FEXCore/Utils/ThreadPoolAllocator.h>
+#include <FEXHeaderUtils/TypeDefines.h>
 
+#include <algorithm>
 #include <cassert>
 #include <cstddef>
 #include <cstring>
@@ -12,6 +13,7 @@
 #include <vector>
 #include <istream>
 #include <ostream>
+#include <sys/mman.h>
 
 namespace FEXCore::IR {
 /**
@@ -60,13 +62,27 @@ class DualIntrusiveAllocator {
     [[nodiscard]] uintptr_t DataBegin() const { return Data; }
     [[nodiscard]] uintptr_t ListBegin() const { return List; }
 
-    void Reset() { DataCurrentOffset = 0; ListCurrentOffset = 0; }
+    /**
+     * @brief Highest data + list usage seen since the last trim
+     *
+     * Usage is sampled on Reset and CopyData, so this covers every completed compile.
+     */
+    [[nodiscard]] size_t PeakSize() const {
+      return std::max(PeakDataSize, DataCurrentOffset) + std::max(PeakListSize, ListCurrentOffset);
+    }
+
+    void Reset() {
+      UpdatePeak();
+      DataCurrentOffset = 0;
+      ListCurrentOffset = 0;
+    }
 
     void CopyData(DualIntrusiveAllocator const &rhs) {
       DataCurrentOffset = rhs.DataCurrentOffset;
       ListCurrentOffset = rhs.ListCurrentOffset;
       memcpy(reinterpret_cast<void*>(Data), reinterpret_cast<void*>(rhs.Data), DataCurrentOffset);
       memcpy(reinterpret_cast<void*>(List), reinterpret_cast<void*>(rhs.List), ListCurrentOffset);
+      UpdatePeak();
     }
 
   protected:
@@ -79,6 +95,13 @@ class DualIntrusiveAllocator {
     size_t DataCurrentOffset {0};
     size_t ListCurrentOffset {0};
     size_t MemorySize;
+    size_t PeakDataSize {0};
+    size_t PeakListSize {0};
+
+    void UpdatePeak() {
+      PeakDataSize = std::max(PeakDataSize, DataCurrentOffset);
+      PeakListSize = std::max(PeakListSize, ListCurrentOffset);
+    }
 };
 
 class DualIntrusiveAllocatorMalloc final : public DualIntrusiveAllocator {
@@ -94,30 +117,85 @@ class DualIntrusiveAllocatorMalloc final : public DualIntrusiveAllocator {
     }
 };
 
-class DualIntrusiveAllocatorThreadPool final : public DualIntrusiveAllocator {
+/**
+ * @brief Per-thread arena backing an IREmitter
+ *
+ * The full size is reserved up front with MAP_NORESERVE so only pages that IR actually gets
+ * written to are backed. Each arena is owned by a single emitter so allocating from it never
+ * needs to synchronize with other compiling threads.
+ *
+ * Growth is bounded by the reservation. `Trim` hands back everything past `RetainedSize` that
+ * a large compile touched, so a single huge block doesn't pin its memory for the thread's lifetime.
+ * Trimming with a smaller size also gives back the retained pages, for when the thread stops compiling.
+ */
+class DualIntrusiveAllocatorArena final : public DualIntrusiveAllocator {
   public:
-    DualIntrusiveAllocatorThreadPool(FEXCore::Utils::IntrusivePooledAllocator &ThreadAllocator, size_t Size)
+    DualIntrusiveAllocatorArena(size_t Size, size_t RetainedSize)
       : DualIntrusiveAllocator {Size}
-      , PoolObject{ThreadAllocator, Size * 2} {
-      // Claim a buffer on allocation
-      PoolObject.ReownOrClaimBuffer();
+      , RetainedSize {std::min(RetainedSize, Size)} {
+      void *Ptr = FEXCore::Allocator::mmap(nullptr, Size * 2, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+      LOGMAN_THROW_A_FMT(Ptr != MAP_FAILED, "Couldn't reserve IR arena of {} bytes", Size * 2);
+      Data = reinterpret_cast<uintptr_t>(Ptr);
+      List = Data + Size;
     }
 
-    ~DualIntrusiveAllocatorThreadPool() {
-      PoolObject.UnclaimBuffer();
+    ~DualIntrusiveAllocatorArena() {
+      FEXCore::Allocator::munmap(reinterpret_cast<void*>(Data), MemorySize * 2);
     }
 
-    void ReownOrClaimBuffer() {
-      Data = PoolObject.ReownOrClaimBuffer();
-      List = Data + MemorySize;
+    /**
+     * @brief Returns the pages touched past the retained size back to the kernel
+     *
+     * Must only be called once the current IR is no longer needed. Resets the peak tracking.
+     *
+     * @return true if any memory was released
+     */
+    bool Trim() {
+      return Trim(RetainedSize);
     }
 
-    void DelayedDisownBuffer() {
-      PoolObject.DelayedDisownBuffer();
+    /**
+     * @brief Returns the pages touched past Retain back to the kernel
+     *
+     * Pages kept by earlier trims count as touched, so a Retain below the retained size releases them too.
+     *
+     * @return true if any memory was released
+     */
+    bool Trim(size_t Retain) {
+      UpdatePeak();
+      TouchedDataSize = std::max(TouchedDataSize, PeakDataSize);
+      TouchedListSize = std::max(TouchedListSize, PeakListSize);
+      bool Released = TrimRegion(Data, &TouchedDataSize, Retain) | TrimRegion(List, &TouchedListSize, Retain);
+      DataCurrentOffset = 0;
+      ListCurrentOffset = 0;
+      PeakDataSize = 0;
+      PeakListSize = 0;
+      return Released;
     }
 
+    [[nodiscard]] size_t GetRetainedSize() const { return RetainedSize; }
+
   private:
-    Utils::FixedSizePooledAllocation<uintptr_t, 5000, 500> PoolObject;
+    bool TrimRegion(uintptr_t Base, size_t *Touched, size_t Retain) {
+      if (*Touched <= Retain) {
+        return false;
+      }
+
+      const size_t Begin = (Retain + FHU::FEX_PAGE_SIZE - 1) & FHU::FEX_PAGE_MASK;
+      const size_t End = (*Touched + FHU::FEX_PAGE_SIZE - 1) & FHU::FEX_PAGE_MASK;
+      *Touched = std::min(*Touched, Begin);
+      if (End <= Begin) {
+        return false;
+      }
+
+      ::madvise(reinterpret_cast<void*>(Base + Begin), End - Begin, MADV_DONTNEED);
+      return true;
+    }
+
+    size_t RetainedSize;
+    // Bytes that can still be backed by pages, kept across trims
+    size_t TouchedDataSize {0};
+    size_t TouchedListSize {0};
 };
 
 class IRListView final {
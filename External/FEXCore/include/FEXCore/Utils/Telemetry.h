@@ -19,8 +19,16 @@ namespace FEXCore::Telemetry {
       uint64_t operator*() const { return Data; }
       void operator=(uint64_t Value) { Data = Value; }
       void operator|=(uint64_t Value) { Data |= Value; }
+      void operator+=(uint64_t Value) { Data += Value; }
       void operator++(int) { Data++; }
 
+      void Max(uint64_t Value) {
+        uint64_t Current = Data.load(std::memory_order_relaxed);
+        while (Current < Value &&
+               !Data.compare_exchange_weak(Current, Value, std::memory_order_relaxed)) {
+        }
+      }
+
       std::atomic<uint64_t> *GetAddr() { return &Data; }
 
     private:
@@ -36,6 +44,21 @@ namespace FEXCore::Telemetry {
     TYPE_CAS_32BIT_TEAR,
     TYPE_CAS_64BIT_TEAR,
     TYPE_CAS_128BIT_TEAR,
+    // Flag accesses in translated code, reads and writes interleaved per flag
+    TYPE_CF_READS,
+    TYPE_CF_WRITES,
+    TYPE_PF_READS,
+    TYPE_PF_WRITES,
+    TYPE_AF_READS,
+    TYPE_AF_WRITES,
+    TYPE_ZF_READS,
+    TYPE_ZF_WRITES,
+    TYPE_SF_READS,
+    TYPE_SF_WRITES,
+    TYPE_OF_READS,
+    TYPE_OF_WRITES,
+    TYPE_IR_PEAK_MEMORY,
+    TYPE_IR_ARENA_TRIMS,
     TYPE_LAST,
   };
 
@@ -55,6 +78,7 @@ namespace FEXCore::Telemetry {
 #define FEXCORE_TELEMETRY_SET(Name, Value) Name = Value
 #define FEXCORE_TELEMETRY_OR(Name, Value) Name |= Value
 #define FEXCORE_TELEMETRY_INC(Name) Name++
+#define FEXCORE_TELEMETRY_MAX(Name, Value) Name.Max(Value)
 
 // Returns a pointer to std::atomic<uint64_t>. Can be useful if you are attempting to JIT telemetry accesses for debug purposes
 // Not recommended to do telemetry inside JIT code in production code
@@ -69,6 +93,7 @@ namespace FEXCore::Telemetry {
 #define FEXCORE_TELEMETRY_SET(Name, Value) do {} while(0)
 #define FEXCORE_TELEMETRY_OR(Name, Value) do {} while(0)
 #define FEXCORE_TELEMETRY_INC(Name) do {} while(0)
+#define FEXCORE_TELEMETRY_MAX(Name, Value) do {} while(0)
 #define FEXCORE_TELEMETRY_Addr(Name) reinterpret_cast<std::atomic<uint64_t>*>(nullptr)
 #endif
 }
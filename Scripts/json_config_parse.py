@@ -73,6 +73,8 @@ class HostFeatures(Flag) :
     FEATURE_BMI1   = (1 << 6)
     FEATURE_BMI2   = (1 << 7)
     FEATURE_CLWB   = (1 << 8)
+    FEATURE_FMA    = (1 << 9)
+    FEATURE_F16C   = (1 << 10)
 
 RegStringLookup = {
     "NONE":  Regs.REG_NONE,
@@ -145,6 +147,8 @@ HostFeaturesLookup = {
     "BMI1"   : HostFeatures.FEATURE_BMI1,
     "BMI2"   : HostFeatures.FEATURE_BMI2,
     "CLWB"   : HostFeatures.FEATURE_CLWB,
+    "FMA"    : HostFeatures.FEATURE_FMA,
+    "F16C"   : HostFeatures.FEATURE_F16C,
 }
 
 def parse_hexstring(s):
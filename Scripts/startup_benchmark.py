@@ -0,0 +1,58 @@
+#!/usr/bin/python3
+import os
+import statistics
+import subprocess
+import sys
+import time
+
+# Args: <FexExecutable> [<Runs>] [-- <Guest> <GuestArgs>...]
+# Times how long FEX takes to start, run and tear down a trivial guest. /bin/true by default.
+
+if (len(sys.argv) < 2):
+    print("Usage: {} <FexExecutable> [<Runs>] [-- <Guest> <GuestArgs>...]".format(sys.argv[0]))
+    sys.exit(1)
+
+fexecutable = sys.argv[1]
+runs = 100
+guest = ["/bin/true"]
+
+Args = sys.argv[2:]
+if "--" in Args:
+    Split = Args.index("--")
+    guest = Args[Split + 1:]
+    Args = Args[:Split]
+
+if len(Args) > 0:
+    runs = int(Args[0])
+
+RunnerArgs = [fexecutable]
+
+ROOTFS_ENV = os.getenv("ROOTFS")
+if ROOTFS_ENV != None:
+    RunnerArgs.append("-R")
+    RunnerArgs.append(ROOTFS_ENV)
+
+RunnerArgs.append("--")
+RunnerArgs.extend(guest)
+
+# One untimed run so the binaries are in the page cache
+Process = subprocess.run(RunnerArgs)
+if Process.returncode != 0:
+    print("Guest failed with", Process.returncode)
+    sys.exit(1)
+
+Times = []
+for Run in range(runs):
+    Start = time.perf_counter()
+    Process = subprocess.run(RunnerArgs)
+    Times.append((time.perf_counter() - Start) * 1000.0)
+
+    if Process.returncode != 0:
+        print("Guest failed with", Process.returncode)
+        sys.exit(1)
+
+print("{}: {} runs".format(" ".join(guest), runs))
+print("  min:    {:8.2f} ms".format(min(Times)))
+print("  median: {:8.2f} ms".format(statistics.median(Times)))
+print("  mean:   {:8.2f} ms".format(statistics.mean(Times)))
+print("  max:    {:8.2f} ms".format(max(Times)))
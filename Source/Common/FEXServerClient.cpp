@@ -1,13 +1,22 @@
 #include "Common/Config.h"
 #include "Common/FEXServerClient.h"
+#include "Common/FileFormatCheck.h"
 
 #include <FEXCore/Utils/CompilerDefs.h>
 #include <FEXCore/Utils/LogManager.h>
+#include <FEXCore/Utils/MathUtils.h>
 #include <FEXCore/Utils/NetStream.h>
+#include <FEXCore/Utils/Threads.h>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <fcntl.h>
 #include <filesystem>
+#include <linux/futex.h>
 #include <linux/limits.h>
+#include <pthread.h>
+#include <sched.h>
 #include <unistd.h>
 #include <string>
 #include <sys/poll.h>
@@ -15,12 +24,69 @@
 #include <sys/signal.h>
 #include <sys/socket.h>
 #include <sys/stat.h>
+#include <sys/syscall.h>
 #include <sys/types.h>
 #include <sys/un.h>
 #include <sys/uio.h>
 #include <thread>
+#include <vector>
 
 namespace FEXServerClient {
+  static int ReceiveFDPacket(int ServerSocket) {
+    // Wait for success response with SCM_RIGHTS
+    FEXServerResultPacket Res{};
+    struct iovec iov {
+      .iov_base = &Res,
+      .iov_len = sizeof(Res),
+    };
+
+    struct msghdr msg {
+      .msg_name = nullptr,
+      .msg_namelen = 0,
+      .msg_iov = &iov,
+      .msg_iovlen = 1,
+    };
+
+    // Setup the ancillary buffer. This is where we will be getting pipe FDs
+    // We only need 4 bytes for the FD
+    constexpr size_t CMSG_SIZE = CMSG_SPACE(sizeof(int));
+    union AncillaryBuffer {
+      struct cmsghdr Header;
+      uint8_t Buffer[CMSG_SIZE];
+    };
+    AncillaryBuffer AncBuf{};
+
+    // Now link to our ancilllary buffer
+    msg.msg_control = AncBuf.Buffer;
+    msg.msg_controllen = CMSG_SIZE;
+
+    ssize_t DataResult = recvmsg(ServerSocket, &msg, 0);
+    if (DataResult > 0) {
+      // Now that we have the data, we can extract the FD from the ancillary buffer
+      struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+
+      // Do some error checking
+      if (cmsg == nullptr ||
+          cmsg->cmsg_len != CMSG_LEN(sizeof(int)) ||
+          cmsg->cmsg_level != SOL_SOCKET ||
+          cmsg->cmsg_type != SCM_RIGHTS) {
+        // Couldn't get a socket
+      }
+      else {
+        // Check for Success.
+        // If type error was returned then the FEXServer doesn't have a log to pipe in to
+        if (Res.Header.Type == PacketType::TYPE_SUCCESS) {
+          // Now that we know the cmsg is sane, read the FD
+          int NewFD{};
+          memcpy(&NewFD, CMSG_DATA(cmsg), sizeof(NewFD));
+          return NewFD;
+        }
+      }
+    }
+
+    return -1;
+  }
+
   int RequestPIDFDPacket(int ServerSocket, PacketType Type) {
     FEXServerRequestPacket Req {
       .Header {
@@ -30,63 +96,14 @@ namespace FEXServerClient {
 
     int Result = write(ServerSocket, &Req, sizeof(Req.BasicRequest));
     if (Result != -1) {
-      // Wait for success response with SCM_RIGHTS
-
-      FEXServerResultPacket Res{};
-      struct iovec iov {
-        .iov_base = &Res,
-        .iov_len = sizeof(Res),
-      };
-
-      struct msghdr msg {
-        .msg_name = nullptr,
-        .msg_namelen = 0,
-        .msg_iov = &iov,
-        .msg_iovlen = 1,
-      };
-
-      // Setup the ancillary buffer. This is where we will be getting pipe FDs
-      // We only need 4 bytes for the FD
-      constexpr size_t CMSG_SIZE = CMSG_SPACE(sizeof(int));
-      union AncillaryBuffer {
-        struct cmsghdr Header;
-        uint8_t Buffer[CMSG_SIZE];
-      };
-      AncillaryBuffer AncBuf{};
-
-      // Now link to our ancilllary buffer
-      msg.msg_control = AncBuf.Buffer;
-      msg.msg_controllen = CMSG_SIZE;
-
-      ssize_t DataResult = recvmsg(ServerSocket, &msg, 0);
-      if (DataResult > 0) {
-        // Now that we have the data, we can extract the FD from the ancillary buffer
-        struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
-
-        // Do some error checking
-        if (cmsg == nullptr ||
-            cmsg->cmsg_len != CMSG_LEN(sizeof(int)) ||
-            cmsg->cmsg_level != SOL_SOCKET ||
-            cmsg->cmsg_type != SCM_RIGHTS) {
-          // Couldn't get a socket
-        }
-        else {
-          // Check for Success.
-          // If type error was returned then the FEXServer doesn't have a log to pipe in to
-          if (Res.Header.Type == PacketType::TYPE_SUCCESS) {
-            // Now that we know the cmsg is sane, read the FD
-            int NewFD{};
-            memcpy(&NewFD, CMSG_DATA(cmsg), sizeof(NewFD));
-            return NewFD;
-          }
-        }
-      }
+      return ReceiveFDPacket(ServerSocket);
     }
 
     return -1;
   }
 
   static int ServerFD {-1};
+  static std::string RootFSImagePath{};
 
   std::string GetServerLockFolder() {
     return FEXCore::Config::GetDataDirectory() + "Server/";
@@ -143,6 +160,10 @@ namespace FEXServerClient {
     return fmt::format("{}.FEXServer.Socket", ::geteuid());
   }
 
+  std::string const &GetRootFSImagePath() {
+    return RootFSImagePath;
+  }
+
   int GetServerFD() {
     return ServerFD;
   }
@@ -190,6 +211,13 @@ namespace FEXServerClient {
     if (FEXCore::Config::FindContainer() != "pressure-vessel") {
       std::string RootFSPath = FEXServerClient::RequestRootFSPath(ServerFD);
 
+      // Remember the image if FEXServer mounted one for us, so it can be read without going through the mount
+      FEX_CONFIG_OPT(ImagePath, ROOTFS);
+      if (!RootFSPath.empty() && RootFSPath != ImagePath() &&
+          (FEX::FormatCheck::IsSquashFS(ImagePath()) || FEX::FormatCheck::IsEroFS(ImagePath()))) {
+        RootFSImagePath = ImagePath();
+      }
+
       //// If everything has passed then we can now update the rootfs path
       FEXCore::Config::EraseSet(FEXCore::Config::CONFIG_ROOTFS, RootFSPath);
     }
@@ -319,6 +347,61 @@ namespace FEXServerClient {
     return RequestPIDFDPacket(ServerSocket, PacketType::TYPE_GET_PID_FD);
   }
 
+  int RequestCodeCacheFD(int ServerSocket, std::string const &Name) {
+    FEXServerRequestPacket Req {
+      .CodeCache {
+        .Header {
+          .Type = PacketType::TYPE_GET_CODE_CACHE_FD,
+        },
+        .Length = Name.size(),
+      },
+    };
+
+    iovec iov[2] {
+      {
+        .iov_base = &Req,
+        .iov_len = sizeof(Req.CodeCache),
+      },
+      {
+        .iov_base = const_cast<char*>(Name.data()),
+        .iov_len = Name.size(),
+      },
+    };
+
+    ssize_t Result = writev(ServerSocket, iov, 2);
+    if (Result != -1) {
+      return ReceiveFDPacket(ServerSocket);
+    }
+
+    return -1;
+  }
+
+  static int CodeCacheServerFD {-1};
+  static bool CodeCacheConnectionAttempted {};
+
+  int RequestCodeCacheFD(std::string const &Name) {
+    if (!CodeCacheConnectionAttempted) {
+      CodeCacheConnectionAttempted = true;
+      CodeCacheServerFD = ConnectToServer(ConnectionOption::NoPrintConnectionError);
+    }
+
+    if (CodeCacheServerFD == -1) {
+      return -1;
+    }
+
+    return RequestCodeCacheFD(CodeCacheServerFD, Name);
+  }
+
+  void CleanupCodeCacheConnectionAfterFork() {
+    // The socket is shared with the parent, requests from both would mix up their replies
+    if (CodeCacheServerFD != -1) {
+      close(CodeCacheServerFD);
+    }
+
+    CodeCacheServerFD = -1;
+    CodeCacheConnectionAttempted = false;
+  }
+
   /**  @} */
 
   /**
@@ -350,5 +433,435 @@ namespace FEXServerClient {
   void AssertHandler(int FD, char const *Message) {
     MsgHandler(FD, LogMan::DebugLevels::ASSERT, Message);
   }
+
+  namespace {
+    constexpr size_t LOG_RING_SIZE = 32 * 1024;
+    // Records start with their size, this one marks the rest of the ring as unused
+    constexpr uint32_t LOG_RING_WRAP = ~0U;
+    // Writes up to PIPE_BUF are atomic
+    // Forked children share the log pipe so a batch must not get any larger than that
+    constexpr size_t LOG_MAX_BATCH_SIZE = PIPE_BUF;
+    constexpr size_t LOG_MAX_BATCH_RECORDS = 64;
+
+    struct LogRecordHeader {
+      uint32_t Size;
+      uint32_t Pad;
+    };
+
+    /**
+     * @brief Single producer single consumer ring of log packets
+     *
+     * Only the owning thread writes records, only the logging thread reads them.
+     * Offsets only ever grow, the position in the ring is the offset modulo the ring size.
+     */
+    struct LogRing {
+      std::atomic<uint64_t> WriteOffset{};
+      std::atomic<uint64_t> ReadOffset{};
+      // Cleared when the owning thread exits so the ring can be reused
+      std::atomic<bool> Owned{};
+      LogRing *Next{};
+      alignas(8) uint8_t Data[LOG_RING_SIZE];
+    };
+
+    int AsyncLogFD {-1};
+    std::atomic<bool> AsyncLoggingActive{};
+    std::atomic<bool> AsyncLoggingShutdown{};
+    std::unique_ptr<FEXCore::Threads::Thread> AsyncLogThread{};
+    // Rings are only ever added, except after a fork when the child throws them all away
+    std::atomic<LogRing*> LogRings{};
+    std::atomic<uint64_t> LogRingGeneration{};
+    // Futex word, set while the logging thread is waiting for work
+    std::atomic<uint32_t> LogThreadSleeping{};
+    std::atomic<uint64_t> DroppedMessages{};
+
+    struct LogRingOwner {
+      LogRing *Ring{};
+      uint64_t Generation{};
+      // Set while a record is being written
+      // A signal handler that logs at that point can't use the ring
+      bool Writing{};
+
+      ~LogRingOwner() {
+        if (Ring && Generation == LogRingGeneration.load(std::memory_order_relaxed)) {
+          // Whatever is still queued gets written, the next thread that logs reuses the ring
+          Ring->Owned.store(false, std::memory_order_release);
+        }
+      }
+    };
+
+    thread_local LogRingOwner LocalLogRing{};
+
+    LogRing *GetLocalLogRing() {
+      const auto Generation = LogRingGeneration.load(std::memory_order_relaxed);
+      if (LocalLogRing.Ring && LocalLogRing.Generation == Generation) {
+        return LocalLogRing.Ring;
+      }
+
+      LogRing *Ring{};
+
+      // Take over the ring of a thread that exited
+      for (auto Current = LogRings.load(std::memory_order_acquire); Current; Current = Current->Next) {
+        bool Expected = false;
+        if (Current->Owned.compare_exchange_strong(Expected, true, std::memory_order_acquire)) {
+          Ring = Current;
+          break;
+        }
+      }
+
+      if (!Ring) {
+        Ring = new LogRing{};
+        Ring->Owned.store(true, std::memory_order_relaxed);
+
+        auto Head = LogRings.load(std::memory_order_relaxed);
+        do {
+          Ring->Next = Head;
+        } while (!LogRings.compare_exchange_weak(Head, Ring, std::memory_order_release, std::memory_order_relaxed));
+      }
+
+      LocalLogRing.Ring = Ring;
+      LocalLogRing.Generation = Generation;
+      return Ring;
+    }
+
+    void WakeLogThread() {
+      if (LogThreadSleeping.load(std::memory_order_seq_cst)) {
+        LogThreadSleeping.store(0, std::memory_order_relaxed);
+        ::syscall(SYS_futex,
+          &LogThreadSleeping,
+          FUTEX_WAKE | FUTEX_PRIVATE_FLAG,
+          1, // Value
+          nullptr, // Timeout
+          nullptr, // Addr
+          0);
+      }
+    }
+
+    /**
+     * @brief Copies a packet in to the calling thread's ring
+     *
+     * @param Size - Size of the packet
+     * @param Fill - Writes the packet to the pointer it is given
+     *
+     * @return false if the packet needs to be written synchronously instead
+     */
+    template<typename Fn>
+    bool QueueRecord(size_t Size, Fn &&Fill) {
+      const uint64_t Needed = sizeof(LogRecordHeader) + FEXCore::AlignUp(Size, 8);
+      if (!AsyncLoggingActive.load(std::memory_order_relaxed) ||
+          LocalLogRing.Writing ||
+          Needed > LOG_RING_SIZE / 2) {
+        return false;
+      }
+
+      LocalLogRing.Writing = true;
+      auto Ring = GetLocalLogRing();
+
+      uint64_t Write = Ring->WriteOffset.load(std::memory_order_relaxed);
+      const uint64_t Read = Ring->ReadOffset.load(std::memory_order_acquire);
+      uint64_t Position = Write % LOG_RING_SIZE;
+
+      // Records never wrap around the end of the ring
+      const uint64_t Skip = (Position + Needed > LOG_RING_SIZE) ? LOG_RING_SIZE - Position : 0;
+      if (Write + Skip + Needed - Read > LOG_RING_SIZE) {
+        // The logging thread can't keep up, never block the thread that is logging
+        DroppedMessages.fetch_add(1, std::memory_order_relaxed);
+        LocalLogRing.Writing = false;
+        return true;
+      }
+
+      if (Skip) {
+        reinterpret_cast<LogRecordHeader*>(&Ring->Data[Position])->Size = LOG_RING_WRAP;
+        Write += Skip;
+        Position = 0;
+      }
+
+      reinterpret_cast<LogRecordHeader*>(&Ring->Data[Position])->Size = Size;
+      Fill(&Ring->Data[Position + sizeof(LogRecordHeader)]);
+
+      // seq_cst pairs with the logging thread setting LogThreadSleeping before its last check for work
+      Ring->WriteOffset.store(Write + Needed, std::memory_order_seq_cst);
+      LocalLogRing.Writing = false;
+
+      WakeLogThread();
+      return true;
+    }
+
+    template<typename Fn>
+    void QueueOrWriteRecord(size_t Size, Fn &&Fill) {
+      if (!QueueRecord(Size, Fill)) {
+        std::vector<uint8_t> Packet(Size);
+        Fill(Packet.data());
+        write(AsyncLogFD, Packet.data(), Packet.size());
+      }
+    }
+
+    /**
+     * @brief Writes out everything queued in a ring
+     *
+     * @return true if the ring had anything queued
+     */
+    bool DrainLogRing(LogRing *Ring) {
+      uint64_t Read = Ring->ReadOffset.load(std::memory_order_relaxed);
+      const uint64_t Write = Ring->WriteOffset.load(std::memory_order_seq_cst);
+      if (Read == Write) {
+        return false;
+      }
+
+      iovec Batch[LOG_MAX_BATCH_RECORDS];
+      size_t BatchRecords{};
+      size_t BatchSize{};
+
+      while (Read != Write) {
+        const uint64_t Position = Read % LOG_RING_SIZE;
+        const auto Header = reinterpret_cast<LogRecordHeader const*>(&Ring->Data[Position]);
+        if (Header->Size == LOG_RING_WRAP) {
+          Read += LOG_RING_SIZE - Position;
+          continue;
+        }
+
+        if (BatchRecords == LOG_MAX_BATCH_RECORDS ||
+            (BatchRecords != 0 && BatchSize + Header->Size > LOG_MAX_BATCH_SIZE)) {
+          writev(AsyncLogFD, Batch, BatchRecords);
+          BatchRecords = 0;
+          BatchSize = 0;
+
+          // The batch pointed in to the ring, only hand the space back once it was written
+          Ring->ReadOffset.store(Read, std::memory_order_release);
+        }
+
+        Batch[BatchRecords++] = iovec {
+          .iov_base = const_cast<uint8_t*>(&Ring->Data[Position + sizeof(LogRecordHeader)]),
+          .iov_len = Header->Size,
+        };
+        BatchSize += Header->Size;
+        Read += sizeof(LogRecordHeader) + FEXCore::AlignUp(Header->Size, 8);
+      }
+
+      if (BatchRecords) {
+        writev(AsyncLogFD, Batch, BatchRecords);
+      }
+      Ring->ReadOffset.store(Read, std::memory_order_release);
+      return true;
+    }
+
+    bool DrainLogRings() {
+      bool DidWork{};
+      for (auto Ring = LogRings.load(std::memory_order_acquire); Ring; Ring = Ring->Next) {
+        DidWork |= DrainLogRing(Ring);
+      }
+      return DidWork;
+    }
+
+    void *AsyncLogThreadFunc(void *) {
+      char ThreadName[16] = "FEXLogging\0";
+      pthread_setname_np(pthread_self(), ThreadName);
+
+      uint64_t ReportedDrops = DroppedMessages.load(std::memory_order_relaxed);
+      while (true) {
+        bool DidWork = DrainLogRings();
+
+        const uint64_t Drops = DroppedMessages.load(std::memory_order_relaxed);
+        if (Drops != ReportedDrops) {
+          const auto Message = "Dropped " + std::to_string(Drops - ReportedDrops) + " log messages, logging couldn't keep up";
+          MsgHandler(AsyncLogFD, LogMan::DebugLevels::ERROR, Message.c_str());
+          ReportedDrops = Drops;
+        }
+
+        if (DidWork) {
+          continue;
+        }
+
+        if (AsyncLoggingShutdown.load(std::memory_order_relaxed)) {
+          break;
+        }
+
+        // Check one more time after announcing that we are going to sleep
+        LogThreadSleeping.store(1, std::memory_order_seq_cst);
+        if (DrainLogRings()) {
+          LogThreadSleeping.store(0, std::memory_order_relaxed);
+          continue;
+        }
+
+        // The timeout is only a fallback, producers wake us up
+        struct timespec Timeout {
+          .tv_sec = 0,
+          .tv_nsec = 100'000'000,
+        };
+        ::syscall(SYS_futex,
+          &LogThreadSleeping,
+          FUTEX_WAIT | FUTEX_PRIVATE_FLAG,
+          1, // Value
+          &Timeout,
+          nullptr, // Addr
+          0);
+        LogThreadSleeping.store(0, std::memory_order_relaxed);
+      }
+
+      return nullptr;
+    }
+
+    void CreateAsyncLogThread() {
+      AsyncLoggingShutdown = false;
+
+      // The logging thread must never receive guest signals
+      uint64_t OldMask = FEXCore::Threads::SetSignalMask(~0ULL);
+      AsyncLogThread = FEXCore::Threads::Thread::Create(AsyncLogThreadFunc, nullptr);
+      FEXCore::Threads::SetSignalMask(OldMask);
+    }
+  }
+
+  void StartAsyncLogging(int FD) {
+    AsyncLogFD = FD;
+    CreateAsyncLogThread();
+    AsyncLoggingActive = true;
+  }
+
+  void ShutdownAsyncLogging() {
+    if (!AsyncLoggingActive) {
+      return;
+    }
+
+    FlushAsyncLogging();
+    AsyncLoggingActive = false;
+
+    // The thread drains everything that got queued in the meantime before it exits
+    AsyncLoggingShutdown = true;
+    LogThreadSleeping.store(1, std::memory_order_relaxed);
+    WakeLogThread();
+
+    AsyncLogThread->join(nullptr);
+    AsyncLogThread.reset();
+  }
+
+  bool IsAsyncLoggingActive() {
+    return AsyncLoggingActive.load(std::memory_order_relaxed);
+  }
+
+  void FlushAsyncLogging() {
+    if (!AsyncLoggingActive || LocalLogRing.Writing) {
+      return;
+    }
+
+    // Don't hang forever if the server stopped reading
+    const auto Deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+
+    for (auto Ring = LogRings.load(std::memory_order_acquire); Ring; Ring = Ring->Next) {
+      const uint64_t Target = Ring->WriteOffset.load(std::memory_order_acquire);
+      while (Ring->ReadOffset.load(std::memory_order_acquire) < Target) {
+        if (std::chrono::steady_clock::now() > Deadline) {
+          return;
+        }
+
+        WakeLogThread();
+        sched_yield();
+      }
+    }
+  }
+
+  void CleanupAsyncLoggingAfterFork() {
+    if (!AsyncLoggingActive) {
+      return;
+    }
+
+    // The logging thread didn't survive the fork, its thread object can't be joined or destroyed anymore
+    AsyncLogThread.release();
+
+    // Everything still queued is the parent's to write
+    // We are the only thread in the child so the rings can be freed directly
+    auto Ring = LogRings.exchange(nullptr);
+    while (Ring) {
+      auto Next = Ring->Next;
+      delete Ring;
+      Ring = Next;
+    }
+    LogRingGeneration.fetch_add(1);
+    LogThreadSleeping = 0;
+
+    CreateAsyncLogThread();
+  }
+
+  void AsyncMsgHandler(LogMan::DebugLevels Level, char const *Message) {
+    if (Level <= LogMan::DebugLevels::ERROR) {
+      // Errors are commonly followed by a trap (ERROR_AND_DIE_FMT), so write them out before returning.
+      // Everything leading up to the error goes first to keep the order.
+      FlushAsyncLogging();
+      MsgHandler(AsyncLogFD, Level, Message);
+      return;
+    }
+
+    const size_t MsgLen = strlen(Message) + 1;
+
+    QueueOrWriteRecord(sizeof(Logging::PacketMsg) + MsgLen, [&](uint8_t *Data) {
+      Logging::PacketMsg Msg;
+      Msg.Header = Logging::FillHeader(Logging::PacketTypes::TYPE_MSG);
+      Msg.MessageLength = MsgLen;
+      Msg.Level = Level;
+
+      memcpy(Data, &Msg, sizeof(Msg));
+      memcpy(Data + sizeof(Msg), Message, MsgLen);
+    });
+  }
+
+  void AsyncAssertHandler(char const *Message) {
+    // Make sure everything leading up to the assert makes it out first
+    FlushAsyncLogging();
+    AssertHandler(AsyncLogFD, Message);
+  }
+
+  void AsyncFormattedMsg(LogMan::DebugLevels Level, char const *Format, uint64_t const *Args, size_t NumArgs) {
+    NumArgs = std::min(NumArgs, Logging::MAX_FORMAT_ARGS);
+
+    auto GetString = [](uint64_t Arg) -> char const* {
+      auto String = reinterpret_cast<char const*>(Arg);
+      return String ? String : "(null)";
+    };
+
+    // Work out which arguments are strings and need to be copied
+    const size_t FormatLength = strlen(Format) + 1;
+    size_t DataLength = FormatLength;
+    uint32_t StringArgs{};
+    // The guest could change a string while we copy it, only measure it once
+    size_t StringLengths[Logging::MAX_FORMAT_ARGS]{};
+    {
+      char const *Start{};
+      size_t Arg{};
+      for (auto Conversion = Logging::NextConversion(Format, &Start);
+           Conversion && Arg < NumArgs;
+           Conversion = Logging::NextConversion(Conversion + 1, &Start), ++Arg) {
+        if (*Conversion == 's') {
+          StringArgs |= 1U << Arg;
+          StringLengths[Arg] = strnlen(GetString(Args[Arg]), Logging::MAX_FORMAT_STRING_ARG);
+          DataLength += StringLengths[Arg] + 1;
+        }
+      }
+    }
+
+    QueueOrWriteRecord(sizeof(Logging::PacketFormattedMsg) + DataLength, [&](uint8_t *Data) {
+      Logging::PacketFormattedMsg Msg{};
+      Msg.Header = Logging::FillHeader(Logging::PacketTypes::TYPE_FORMATTED_MSG);
+      Msg.DataLength = DataLength;
+      Msg.Level = Level;
+      Msg.NumArgs = NumArgs;
+      memcpy(Msg.Args, Args, NumArgs * sizeof(uint64_t));
+      memcpy(Data, &Msg, sizeof(Msg));
+      Data += sizeof(Msg);
+
+      memcpy(Data, Format, FormatLength);
+      Data += FormatLength;
+
+      for (size_t Arg = 0; Arg < NumArgs; ++Arg) {
+        if (StringArgs & (1U << Arg)) {
+          const size_t Length = StringLengths[Arg];
+          memcpy(Data, GetString(Args[Arg]), Length);
+          Data[Length] = '\0';
+          Data += Length + 1;
+        }
+      }
+    });
+  }
+
+  uint64_t GetDroppedMessageCount() {
+    return DroppedMessages.load(std::memory_order_relaxed);
+  }
   /**  @} */
 }
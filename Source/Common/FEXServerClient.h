@@ -3,6 +3,7 @@
 #include <FEXCore/Utils/LogManager.h>
 #include <FEXHeaderUtils/Syscalls.h>
 
+#include <cstring>
 #include <string>
 
 namespace FEXServerClient {
@@ -12,6 +13,7 @@ namespace FEXServerClient {
     TYPE_GET_LOG_FD,
     TYPE_GET_ROOTFS_PATH,
     TYPE_GET_PID_FD,
+    TYPE_GET_CODE_CACHE_FD,
 
     // Result only
     TYPE_SUCCESS,
@@ -26,6 +28,12 @@ namespace FEXServerClient {
     struct {
       struct Header Header;
     } BasicRequest;
+
+    struct {
+      struct Header Header;
+      size_t Length;
+      char Name[0];
+    } CodeCache;
   };
 
   union FEXServerResultPacket {
@@ -56,6 +64,13 @@ namespace FEXServerClient {
 
   bool SetupClient(char *InterpreterPath);
 
+  /**
+   * @brief The rootfs image that FEXServer mounted for us
+   *
+   * @return Path to the SquashFS or EroFS image, empty if the rootfs isn't an image
+   */
+  std::string const &GetRootFSImagePath();
+
   /**
    * @brief Connect to and start a FEXServer instance if required
    *
@@ -104,6 +119,30 @@ namespace FEXServerClient {
    */
   int RequestPIDFD(int ServerSocket);
 
+  /**
+   * @brief Request a FEXServer to give us the shared code cache memfd for a name
+   *
+   * Every process asking for the same name gets the same memfd.
+   *
+   * @param ServerSocket - Socket to the server
+   * @param Name - Identifies the file and the code configuration
+   *
+   * @return FD for the code cache, -1 on failure
+   */
+  int RequestCodeCacheFD(int ServerSocket, std::string const &Name);
+
+  /**
+   * @brief Same as above over a connection that is only used for code cache requests
+   *
+   * Opened on first use so replies can't interleave with other requests. Only call this from one thread.
+   */
+  int RequestCodeCacheFD(std::string const &Name);
+
+  /**
+   * @brief Drops the code cache connection inherited through fork, the child opens its own on the next request
+   */
+  void CleanupCodeCacheConnectionAfterFork();
+
   /**  @} */
 
   /**
@@ -112,6 +151,8 @@ namespace FEXServerClient {
   namespace Logging {
     enum class PacketTypes : uint32_t {
       TYPE_MSG,
+      // Message that FEXServer formats, see PacketFormattedMsg
+      TYPE_FORMATTED_MSG,
     };
 
     struct PacketHeader {
@@ -129,6 +170,26 @@ namespace FEXServerClient {
       uint32_t Level{};
     };
 
+    constexpr size_t MAX_FORMAT_ARGS = 8;
+    // %s arguments get copied in to the packet, longer strings are cut off
+    constexpr size_t MAX_FORMAT_STRING_ARG = 256;
+
+    /**
+     * @brief printf style message where the formatting is left to FEXServer
+     *
+     * Followed by the null terminated format string and then one null terminated string per %s conversion.
+     * All other conversions take their value from Args in order.
+     */
+    struct PacketFormattedMsg {
+      PacketHeader Header{};
+      // Size of the data following the packet
+      uint32_t DataLength{};
+      uint32_t Level{};
+      uint32_t NumArgs{};
+      uint32_t Pad{};
+      uint64_t Args[MAX_FORMAT_ARGS]{};
+    };
+
     static_assert(sizeof(PacketHeader) == 24, "Wrong size");
 
     [[maybe_unused]]
@@ -147,9 +208,82 @@ namespace FEXServerClient {
 
       return Msg;
     }
+
+    /**
+     * @brief Finds the next conversion in a printf style format string
+     *
+     * Skips over flags, width, precision and length modifiers, `%%` isn't a conversion.
+     *
+     * @param Format - Where to start searching
+     * @param Start - Set to the `%` of the conversion
+     *
+     * @return Pointer to the conversion character, nullptr once the end of the string is reached
+     */
+    [[maybe_unused]]
+    static char const *NextConversion(char const *Format, char const **Start) {
+      for (char const *Current = Format; *Current; ++Current) {
+        if (*Current != '%') {
+          continue;
+        }
+
+        *Start = Current;
+        ++Current;
+        while (*Current && strchr("-+ #0123456789.hlqjztL", *Current)) {
+          ++Current;
+        }
+
+        if (*Current == '\0') {
+          return nullptr;
+        }
+
+        if (*Current != '%') {
+          return Current;
+        }
+      }
+
+      return nullptr;
+    }
   }
 
   void MsgHandler(int FD, LogMan::DebugLevels Level, char const *Message);
   void AssertHandler(int FD, char const *Message);
+
+  // Asynchronous logging
+  // Messages get queued in a per-thread lock-free ring and a background thread batches them in to FEXServer's log pipe.
+  // If a ring is full the message is dropped and counted, logging never blocks the thread that is logging.
+  // Before StartAsyncLogging and after ShutdownAsyncLogging these write synchronously.
+  void StartAsyncLogging(int FD);
+  void ShutdownAsyncLogging();
+  bool IsAsyncLoggingActive();
+
+  /**
+   * @brief Waits until everything queued so far has been written
+   */
+  void FlushAsyncLogging();
+
+  /**
+   * @brief Restarts the logging thread in a forked child
+   *
+   * Messages that were still queued belong to the parent and get discarded.
+   */
+  void CleanupAsyncLoggingAfterFork();
+
+  // Errors and asserts flush the queue and are written synchronously, since they are usually followed by a trap
+  void AsyncMsgHandler(LogMan::DebugLevels Level, char const *Message);
+  void AsyncAssertHandler(char const *Message);
+
+  /**
+   * @brief Queues a printf style message without formatting it
+   *
+   * Integer and pointer arguments are passed raw, the format string and %s arguments are copied.
+   *
+   * @param Args - One argument per conversion in Format
+   */
+  void AsyncFormattedMsg(LogMan::DebugLevels Level, char const *Format, uint64_t const *Args, size_t NumArgs);
+
+  /**
+   * @brief Number of messages that were dropped because a ring was full
+   */
+  uint64_t GetDroppedMessageCount();
   /**  @} */
 }
@@ -708,6 +708,67 @@ void ELFContainer::AddUnwindEntries(UnwindAdder Adder) {
   }
 }
 
+std::vector<ELFContainer::LoadSegment> ELFContainer::GetLoadSegments() const {
+  std::vector<LoadSegment> Segments;
+
+  for (auto const &Header : ProgramHeaders) {
+    const bool Is64Bit = Mode == MODE_64BIT;
+    const uint32_t Type = Is64Bit ? Header._64->p_type : Header._32->p_type;
+
+    if (Type == PT_LOAD) {
+      Segments.push_back({
+        Is64Bit ? Header._64->p_offset : Header._32->p_offset,
+        Is64Bit ? Header._64->p_filesz : Header._32->p_filesz,
+        Is64Bit ? Header._64->p_vaddr : Header._32->p_vaddr,
+      });
+    }
+  }
+
+  return Segments;
+}
+
+std::vector<ELFContainer::RangeType> ELFContainer::GetFunctionRanges(RangeType Range) {
+  auto InRange = [Range](uint64_t Address) {
+    return Address >= Range.first && Address < Range.second;
+  };
+
+  // Function start to its symbol size, zero if only the start is known
+  std::map<uint64_t, uint64_t> Functions;
+
+  AddSymbols([&](ELFSymbol *Sym) {
+    if (InRange(Sym->Address)) {
+      // Aliases share a start, keep the largest size
+      auto &Size = Functions[Sym->Address];
+      Size = std::max(Size, Sym->Size);
+    }
+  });
+
+  // Unwind entries only know where a function starts
+  AddUnwindEntries([&](uintptr_t Entry) {
+    if (InRange(Entry)) {
+      Functions.try_emplace(Entry, 0);
+    }
+  });
+
+  std::vector<RangeType> Ranges;
+  Ranges.reserve(Functions.size());
+
+  for (auto it = Functions.begin(); it != Functions.end(); ++it) {
+    // A function ends at the next function, or at the end of the range
+    auto Next = std::next(it);
+    uint64_t End = Next == Functions.end() ? Range.second : Next->first;
+
+    // Stop earlier if the symbol says so, this keeps padding and data out of the function
+    if (it->second) {
+      End = std::min(End, it->first + it->second);
+    }
+
+    Ranges.emplace_back(it->first, End);
+  }
+
+  return Ranges;
+}
+
 void ELFContainer::PrintHeader() const {
   if (Mode == MODE_32BIT) {
     LogMan::Msg::IFmt("Type: {}", Header._32.e_type);
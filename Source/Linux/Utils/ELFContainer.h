@@ -89,6 +89,24 @@ public:
   using UnwindAdder = std::function<void(uintptr_t)>;
   void AddUnwindEntries(UnwindAdder Adder);
 
+  struct LoadSegment {
+    uint64_t Offset;
+    uint64_t FileSize;
+    uint64_t Address;
+  };
+
+  /**
+   * @brief The file range of each loadable segment and the ELF address it is put at
+   */
+  std::vector<LoadSegment> GetLoadSegments() const;
+
+  /**
+   * @brief Functions starting in the ELF address range [Range.first, Range.second), from symbols and unwind entries
+   *
+   * A function ends at the end of its symbol if the size is known, otherwise at the next function or the end of Range.
+   */
+  std::vector<RangeType> GetFunctionRanges(RangeType Range);
+
   void GetInitLocations(uint64_t GuestELFBase, std::vector<uint64_t> *Locations);
 
 
@@ -114,11 +114,11 @@ void AssertHandler(char const *Message) {
 namespace FEXServerLogging {
   int FEXServerFD{};
   void MsgHandler(LogMan::DebugLevels Level, char const *Message) {
-    FEXServerClient::MsgHandler(FEXServerFD, Level, Message);
+    FEXServerClient::AsyncMsgHandler(Level, Message);
   }
 
   void AssertHandler(char const *Message) {
-    FEXServerClient::AssertHandler(FEXServerFD, Message);
+    FEXServerClient::AsyncAssertHandler(Message);
   }
 }
 
@@ -277,6 +277,7 @@ int main(int argc, char **argv, char **const envp) {
 
       FEXServerLogging::FEXServerFD = FEXServerClient::RequestLogFD(FEXServerClient::GetServerFD());
       if (FEXServerLogging::FEXServerFD != -1) {
+        FEXServerClient::StartAsyncLogging(FEXServerLogging::FEXServerFD);
         LogMan::Throw::InstallHandler(FEXServerLogging::AssertHandler);
         LogMan::Msg::InstallHandler(FEXServerLogging::MsgHandler);
       }
@@ -380,6 +381,11 @@ int main(int argc, char **argv, char **const envp) {
   auto CTX = FEXCore::Context::CreateNewContext();
   FEXCore::Context::InitializeContext(CTX);
 
+  FEXCore::Context::SetCodeCacheFDRequester(CTX, [](const std::string &Name) -> int {
+    // Only ever called from the code cache thread
+    return FEXServerClient::RequestCodeCacheFD(Name);
+  });
+
   auto SignalDelegation = std::make_unique<FEX::HLE::SignalDelegator>();
 
   SignalDelegation->RegisterFrontendHostSignalHandler(SIGILL, [&SignalDelegation](FEXCore::Core::InternalThreadState *Thread, int Signal, void *info, void *ucontext) -> bool {
@@ -509,6 +515,9 @@ int main(int argc, char **argv, char **const envp) {
   FEXCore::Context::DestroyContext(CTX);
 
   FEXCore::Context::ShutdownStaticTables();
+
+  // The logging thread's stack comes from the thread stack pool
+  FEXServerClient::ShutdownAsyncLogging();
   FEXCore::Threads::Shutdown();
 
   Loader.FreeSections();
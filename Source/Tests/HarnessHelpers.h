@@ -138,11 +138,7 @@ namespace FEX::HarnessHelper {
     MatchMask >>= 1;
 
     auto CompactRFlags = [](auto Arg) -> uint32_t {
-      uint32_t Res = 2;
-      for (int i = 0; i < 32; ++i) {
-        Res |= Arg->flags[i] << i;
-      }
-      return Res;
+      return 2 | Arg->GetPackedEFLAGS();
     };
 
     // FLAGS
@@ -386,6 +382,8 @@ namespace FEX::HarnessHelper {
       FEATURE_BMI1   = (1 << 6),
       FEATURE_BMI2   = (1 << 7),
       FEATURE_CLWB   = (1 << 8),
+      FEATURE_FMA    = (1 << 9),
+      FEATURE_F16C   = (1 << 10),
     };
 
     bool Requires3DNow()  const { return BaseConfig.OptionHostFeatures & HostFeatures::FEATURE_3DNOW; }
@@ -397,6 +395,8 @@ namespace FEX::HarnessHelper {
     bool RequiresBMI1()   const { return BaseConfig.OptionHostFeatures & HostFeatures::FEATURE_BMI1; }
     bool RequiresBMI2()   const { return BaseConfig.OptionHostFeatures & HostFeatures::FEATURE_BMI2; }
     bool RequiresCLWB()   const { return BaseConfig.OptionHostFeatures & HostFeatures::FEATURE_CLWB; }
+    bool RequiresFMA()    const { return BaseConfig.OptionHostFeatures & HostFeatures::FEATURE_FMA; }
+    bool RequiresF16C()   const { return BaseConfig.OptionHostFeatures & HostFeatures::FEATURE_F16C; }
 
   private:
     FEX_CONFIG_OPT(ConfigDumpGPRs, DUMPGPRS);
@@ -537,6 +537,8 @@ namespace FEX::HarnessHelper {
     bool RequiresBMI1()   const { return Config.RequiresBMI1(); }
     bool RequiresBMI2()   const { return Config.RequiresBMI2(); }
     bool RequiresCLWB()   const { return Config.RequiresCLWB(); }
+    bool RequiresFMA()    const { return Config.RequiresFMA(); }
+    bool RequiresF16C()   const { return Config.RequiresF16C(); }
 
   private:
     constexpr static uint64_t STACK_SIZE = FHU::FEX_PAGE_SIZE;
@@ -90,7 +90,7 @@ public:
       return;
     }
 
-    ParsedCode = FEXCore::IR::Parse(Allocator, &fp);
+    ParsedCode = FEXCore::IR::Parse(&fp);
 
     if (ParsedCode) {
       EntryRIP = 0x40000;
@@ -140,7 +140,6 @@ private:
   uint64_t EntryRIP{};
   std::unique_ptr<IREmitter> ParsedCode;
 
-  FEXCore::Utils::PooledAllocatorMalloc Allocator;
   FEX::HarnessHelper::ConfigLoader Config;
   constexpr static uint64_t STACK_SIZE = 8 * 1024 * 1024;
 };
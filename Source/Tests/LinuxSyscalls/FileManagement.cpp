@@ -6,6 +6,7 @@ $end_info$
 */
 
 #include "Common/FDUtils.h"
+#include "Common/FEXServerClient.h"
 
 #include "FEXCore/Config/Config.h"
 #include "Tests/LinuxSyscalls/FileManagement.h"
@@ -348,12 +349,77 @@ FileManager::FileManager(FEXCore::Context::Context *ctx)
     }
   }
 
+  if (RootFSImageReader()) {
+    auto const &ImagePath = FEXServerClient::GetRootFSImagePath();
+    if (!ImagePath.empty()) {
+      RootFSImage = FEX::RootFSImage::Image::Open(ImagePath, LDPath());
+    }
+  }
+
   UpdatePID(::getpid());
 }
 
 FileManager::~FileManager() {
 }
 
+FEX::RootFSImage::LookupStatus FileManager::LookupRootFSImage(int dirfd, const char *pathname, bool FollowSymlink, bool RerootSymlinks, FEX::RootFSImage::Inode *Result, std::string *ResolvedPath) {
+  using FEX::RootFSImage::LookupStatus;
+
+  if (!RootFSImage ||
+      !pathname ||
+      pathname[0] == '\0') {
+    return LookupStatus::Unsupported;
+  }
+
+  if (pathname[0] == '/') {
+    if (strcmp(pathname, "/") == 0 || // Root is the host root
+        ThunkOverlays.find(pathname) != ThunkOverlays.end()) { // Overlays replace files in the rootfs
+      return LookupStatus::Unsupported;
+    }
+
+    return RootFSImage->Lookup(pathname, FollowSymlink, RerootSymlinks, Result, ResolvedPath);
+  }
+
+  if (dirfd == AT_FDCWD) {
+    return LookupStatus::Unsupported;
+  }
+
+  // Relative to a directory inside of the mount, the kernel would resolve this through the mount
+  auto DirPath = FEX::get_fdpath(dirfd);
+  if (!DirPath) {
+    return LookupStatus::Unsupported;
+  }
+
+  auto ImagePath = RootFSImage->GetImagePath(*DirPath);
+  if (!ImagePath) {
+    return LookupStatus::Unsupported;
+  }
+
+  std::string Path {*ImagePath};
+  Path += "/";
+  Path += pathname;
+  return RootFSImage->Lookup(Path, FollowSymlink, false, Result, ResolvedPath);
+}
+
+std::optional<int> FileManager::OpenRootFSImage(int dirfd, const char *pathname, uint64_t flags, bool *NotFound) {
+  // Only plain read-only opens of files that exist skip the path emulation
+  constexpr uint64_t UnsupportedFlags = O_ACCMODE | O_CREAT | O_TRUNC | O_PATH | O_DIRECTORY | O_NOFOLLOW | O_TMPFILE | O_DIRECT;
+  *NotFound = false;
+  if (flags & UnsupportedFlags) {
+    return std::nullopt;
+  }
+
+  FEX::RootFSImage::Inode Node;
+  std::string ResolvedPath;
+  auto Status = LookupRootFSImage(dirfd, pathname, true, true, &Node, &ResolvedPath);
+  if (Status != FEX::RootFSImage::LookupStatus::Found) {
+    *NotFound = Status == FEX::RootFSImage::LookupStatus::NotFound;
+    return std::nullopt;
+  }
+
+  return RootFSImage->OpenFile(Node, ResolvedPath, flags);
+}
+
 std::string FileManager::GetEmulatedPath(const char *pathname, bool FollowSymlink) {
   if (!pathname || // If no pathname
       pathname[0] != '/' || // If relative
@@ -413,9 +479,14 @@ uint64_t FileManager::Open(const char *pathname, [[maybe_unused]] int flags, [[m
 
   fd = EmuFD.OpenAt(AT_FDCWD, SelfPath, flags, mode);
   if (fd == -1) {
-    auto Path = GetEmulatedPath(SelfPath, true);
-    if (!Path.empty()) {
-      fd = ::open(Path.c_str(), flags, mode);
+    bool NotInRootFS{};
+    fd = OpenRootFSImage(AT_FDCWD, SelfPath, flags, &NotInRootFS).value_or(-1);
+
+    if (fd == -1 && !NotInRootFS) {
+      auto Path = GetEmulatedPath(SelfPath, true);
+      if (!Path.empty()) {
+        fd = ::open(Path.c_str(), flags, mode);
+      }
     }
 
     if (fd == -1) {
@@ -461,7 +532,14 @@ uint64_t FileManager::Stat(const char *pathname, void *buf) {
   const char *SelfPath = NewPath ? NewPath->c_str() : nullptr;
 
   // Stat follows symlinks
-  auto Path = GetEmulatedPath(SelfPath, true);
+  FEX::RootFSImage::Inode Node;
+  auto Status = LookupRootFSImage(AT_FDCWD, SelfPath, true, true, &Node);
+  if (Status == FEX::RootFSImage::LookupStatus::Found) {
+    RootFSImage->FillStat(Node, reinterpret_cast<struct stat*>(buf));
+    return 0;
+  }
+
+  auto Path = Status == FEX::RootFSImage::LookupStatus::NotFound ? std::string{} : GetEmulatedPath(SelfPath, true);
   if (!Path.empty()) {
     uint64_t Result = ::stat(Path.c_str(), reinterpret_cast<struct stat*>(buf));
     if (Result != -1)
@@ -475,7 +553,14 @@ uint64_t FileManager::Lstat(const char *pathname, void *buf) {
   const char *SelfPath = NewPath ? NewPath->c_str() : nullptr;
 
   // lstat does not follow symlinks
-  auto Path = GetEmulatedPath(SelfPath, false);
+  FEX::RootFSImage::Inode Node;
+  auto Status = LookupRootFSImage(AT_FDCWD, SelfPath, false, false, &Node);
+  if (Status == FEX::RootFSImage::LookupStatus::Found) {
+    RootFSImage->FillStat(Node, reinterpret_cast<struct stat*>(buf));
+    return 0;
+  }
+
+  auto Path = Status == FEX::RootFSImage::LookupStatus::NotFound ? std::string{} : GetEmulatedPath(SelfPath, false);
   if (!Path.empty()) {
     uint64_t Result = ::lstat(Path.c_str(), reinterpret_cast<struct stat*>(buf));
     if (Result != -1)
@@ -490,7 +575,14 @@ uint64_t FileManager::Access(const char *pathname, [[maybe_unused]] int mode) {
   const char *SelfPath = NewPath ? NewPath->c_str() : nullptr;
 
   // Access follows symlinks
-  auto Path = GetEmulatedPath(SelfPath, true);
+  // The image only answers existence checks, permission checks are left to the kernel through the mount
+  FEX::RootFSImage::Inode Node;
+  auto Status = mode != F_OK ? FEX::RootFSImage::LookupStatus::Unsupported : LookupRootFSImage(AT_FDCWD, SelfPath, true, true, &Node);
+  if (Status == FEX::RootFSImage::LookupStatus::Found) {
+    return 0;
+  }
+
+  auto Path = Status == FEX::RootFSImage::LookupStatus::NotFound ? std::string{} : GetEmulatedPath(SelfPath, true);
   if (!Path.empty()) {
     uint64_t Result = ::access(Path.c_str(), mode);
     if (Result != -1)
@@ -504,7 +596,15 @@ uint64_t FileManager::FAccessat(int dirfd, const char *pathname, int mode) {
   auto NewPath = GetSelf(pathname);
   const char *SelfPath = NewPath ? NewPath->c_str() : nullptr;
 
-  auto Path = GetEmulatedPath(SelfPath);
+  // faccessat follows symlinks, but only the kernel resolves the emulated path here
+  // Like Access, only existence checks are answered from the image
+  FEX::RootFSImage::Inode Node;
+  auto Status = mode != F_OK ? FEX::RootFSImage::LookupStatus::Unsupported : LookupRootFSImage(dirfd, SelfPath, true, false, &Node);
+  if (Status == FEX::RootFSImage::LookupStatus::Found) {
+    return 0;
+  }
+
+  auto Path = Status == FEX::RootFSImage::LookupStatus::NotFound ? std::string{} : GetEmulatedPath(SelfPath);
   if (!Path.empty()) {
     uint64_t Result = ::syscall(SYS_faccessat, dirfd, Path.c_str(), mode);
     if (Result != -1)
@@ -518,7 +618,17 @@ uint64_t FileManager::FAccessat2(int dirfd, const char *pathname, int mode, int
   auto NewPath = GetSelf(pathname);
   const char *SelfPath = NewPath ? NewPath->c_str() : nullptr;
 
-  auto Path = GetEmulatedPath(SelfPath, (flags & AT_SYMLINK_NOFOLLOW) == 0);
+  const bool FollowSymlink = (flags & AT_SYMLINK_NOFOLLOW) == 0;
+  // Like Access, only existence checks are answered from the image.
+  // AT_EACCESS only changes which credentials permissions are checked against, the kernel validates the rest.
+  FEX::RootFSImage::Inode Node;
+  auto Status = mode != F_OK || (flags & ~(AT_SYMLINK_NOFOLLOW | AT_EACCESS)) ?
+    FEX::RootFSImage::LookupStatus::Unsupported : LookupRootFSImage(dirfd, SelfPath, FollowSymlink, FollowSymlink, &Node);
+  if (Status == FEX::RootFSImage::LookupStatus::Found) {
+    return 0;
+  }
+
+  auto Path = Status == FEX::RootFSImage::LookupStatus::NotFound ? std::string{} : GetEmulatedPath(SelfPath, FollowSymlink);
   if (!Path.empty()) {
     uint64_t Result = ::syscall(SYSCALL_DEF(faccessat2), dirfd, Path.c_str(), mode, flags);
     if (Result != -1)
@@ -542,7 +652,22 @@ uint64_t FileManager::Readlink(const char *pathname, char *buf, size_t bufsiz) {
     return std::min(bufsiz, App.size());
   }
 
-  auto Path = GetEmulatedPath(pathname);
+  FEX::RootFSImage::Inode Node;
+  auto Status = LookupRootFSImage(AT_FDCWD, pathname, false, false, &Node);
+  if (Status == FEX::RootFSImage::LookupStatus::Found) {
+    std::string Target;
+    if (!S_ISLNK(Node.Mode)) {
+      // This means that the file wasn't a symlink
+      // This is expected behaviour
+      return -EINVAL;
+    }
+    if (RootFSImage->ReadSymlink(Node, &Target)) {
+      memcpy(buf, Target.data(), std::min(bufsiz, Target.size()));
+      return std::min(bufsiz, Target.size());
+    }
+  }
+
+  auto Path = Status == FEX::RootFSImage::LookupStatus::NotFound ? std::string{} : GetEmulatedPath(pathname);
   if (!Path.empty()) {
     uint64_t Result = ::readlink(Path.c_str(), buf, bufsiz);
     if (Result != -1)
@@ -615,7 +740,20 @@ uint64_t FileManager::Readlinkat(int dirfd, const char *pathname, char *buf, siz
     return std::min(bufsiz, App.size());
   }
 
-  Path = GetEmulatedPath(pathname);
+  FEX::RootFSImage::Inode Node;
+  auto Status = LookupRootFSImage(dirfd, pathname, false, false, &Node);
+  if (Status == FEX::RootFSImage::LookupStatus::Found) {
+    std::string Target;
+    if (!S_ISLNK(Node.Mode)) {
+      return -EINVAL;
+    }
+    if (RootFSImage->ReadSymlink(Node, &Target)) {
+      memcpy(buf, Target.data(), std::min(bufsiz, Target.size()));
+      return std::min(bufsiz, Target.size());
+    }
+  }
+
+  Path = Status == FEX::RootFSImage::LookupStatus::NotFound ? std::string{} : GetEmulatedPath(pathname);
   if (!Path.empty()) {
     uint64_t Result = ::readlinkat(dirfd, Path.c_str(), buf, bufsiz);
     if (Result != -1)
@@ -640,9 +778,14 @@ uint64_t FileManager::Openat([[maybe_unused]] int dirfs, const char *pathname, i
 
   fd = EmuFD.OpenAt(dirfs, SelfPath, flags, mode);
   if (fd == -1) {
-    auto Path = GetEmulatedPath(SelfPath, true);
-    if (!Path.empty()) {
-      fd = ::openat(dirfs, Path.c_str(), flags, mode);
+    bool NotInRootFS{};
+    fd = OpenRootFSImage(dirfs, SelfPath, flags, &NotInRootFS).value_or(-1);
+
+    if (fd == -1 && !NotInRootFS) {
+      auto Path = GetEmulatedPath(SelfPath, true);
+      if (!Path.empty()) {
+        fd = ::openat(dirfs, Path.c_str(), flags, mode);
+      }
     }
 
     if (fd == -1)
@@ -665,9 +808,17 @@ uint64_t FileManager::Openat2(int dirfs, const char *pathname, FEX::HLE::open_ho
 
   fd = EmuFD.OpenAt(dirfs, SelfPath, how->flags, how->mode);
   if (fd == -1) {
-    auto Path = GetEmulatedPath(SelfPath, true);
-    if (!Path.empty()) {
-      fd = ::syscall(SYSCALL_DEF(openat2), dirfs, Path.c_str(), how, usize);
+    bool NotInRootFS{};
+    if (how->resolve == 0) {
+      // RESOLVE_* flags restrict the lookup in ways the image doesn't check
+      fd = OpenRootFSImage(dirfs, SelfPath, how->flags, &NotInRootFS).value_or(-1);
+    }
+
+    if (fd == -1 && !NotInRootFS) {
+      auto Path = GetEmulatedPath(SelfPath, true);
+      if (!Path.empty()) {
+        fd = ::syscall(SYSCALL_DEF(openat2), dirfs, Path.c_str(), how, usize);
+      }
     }
 
     if (fd == -1)
@@ -687,7 +838,21 @@ uint64_t FileManager::Statx(int dirfd, const char *pathname, int flags, uint32_t
   auto NewPath = GetSelf(pathname);
   const char *SelfPath = NewPath ? NewPath->c_str() : nullptr;
 
-  auto Path = GetEmulatedPath(SelfPath, (flags & AT_SYMLINK_NOFOLLOW) == 0);
+  const bool FollowSymlink = (flags & AT_SYMLINK_NOFOLLOW) == 0;
+  // The image only has the basic stats. Other fields, forced syncs and invalid arguments go through the kernel.
+  // AT_STATX_DONT_SYNC is fine since the image never changes.
+  const bool ImageCanAnswer =
+    (mask & ~STATX_BASIC_STATS) == 0 &&
+    (flags & ~(AT_SYMLINK_NOFOLLOW | AT_NO_AUTOMOUNT | AT_STATX_DONT_SYNC)) == 0;
+  FEX::RootFSImage::Inode Node;
+  auto Status = !ImageCanAnswer ?
+    FEX::RootFSImage::LookupStatus::Unsupported : LookupRootFSImage(dirfd, SelfPath, FollowSymlink, FollowSymlink, &Node);
+  if (Status == FEX::RootFSImage::LookupStatus::Found) {
+    RootFSImage->FillStat(Node, statxbuf);
+    return 0;
+  }
+
+  auto Path = Status == FEX::RootFSImage::LookupStatus::NotFound ? std::string{} : GetEmulatedPath(SelfPath, FollowSymlink);
   if (!Path.empty()) {
     uint64_t Result = FHU::Syscalls::statx(dirfd, Path.c_str(), flags, mask, statxbuf);
     if (Result != -1)
@@ -723,7 +888,16 @@ uint64_t FileManager::NewFSStatAt(int dirfd, const char *pathname, struct stat *
   auto NewPath = GetSelf(pathname);
   const char *SelfPath = NewPath ? NewPath->c_str() : nullptr;
 
-  auto Path = GetEmulatedPath(SelfPath, (flag & AT_SYMLINK_NOFOLLOW) == 0);
+  const bool FollowSymlink = (flag & AT_SYMLINK_NOFOLLOW) == 0;
+  FEX::RootFSImage::Inode Node;
+  auto Status = (flag & AT_EMPTY_PATH) ?
+    FEX::RootFSImage::LookupStatus::Unsupported : LookupRootFSImage(dirfd, SelfPath, FollowSymlink, FollowSymlink, &Node);
+  if (Status == FEX::RootFSImage::LookupStatus::Found) {
+    RootFSImage->FillStat(Node, buf);
+    return 0;
+  }
+
+  auto Path = Status == FEX::RootFSImage::LookupStatus::NotFound ? std::string{} : GetEmulatedPath(SelfPath, FollowSymlink);
   if (!Path.empty()) {
     uint64_t Result = ::fstatat(dirfd, Path.c_str(), buf, flag);
     if (Result != -1) {
@@ -737,7 +911,18 @@ uint64_t FileManager::NewFSStatAt64(int dirfd, const char *pathname, struct stat
   auto NewPath = GetSelf(pathname);
   const char *SelfPath = NewPath ? NewPath->c_str() : nullptr;
 
-  auto Path = GetEmulatedPath(SelfPath, (flag & AT_SYMLINK_NOFOLLOW) == 0);
+  const bool FollowSymlink = (flag & AT_SYMLINK_NOFOLLOW) == 0;
+  FEX::RootFSImage::Inode Node;
+  auto Status = (flag & AT_EMPTY_PATH) ?
+    FEX::RootFSImage::LookupStatus::Unsupported : LookupRootFSImage(dirfd, SelfPath, FollowSymlink, FollowSymlink, &Node);
+  if (Status == FEX::RootFSImage::LookupStatus::Found) {
+    // stat64 is the same as stat on 64-bit hosts
+    static_assert(sizeof(struct stat64) == sizeof(struct stat));
+    RootFSImage->FillStat(Node, reinterpret_cast<struct stat*>(buf));
+    return 0;
+  }
+
+  auto Path = Status == FEX::RootFSImage::LookupStatus::NotFound ? std::string{} : GetEmulatedPath(SelfPath, FollowSymlink);
   if (!Path.empty()) {
     uint64_t Result = ::fstatat64(dirfd, Path.c_str(), buf, flag);
     if (Result != -1) {
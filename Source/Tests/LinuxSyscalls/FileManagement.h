@@ -10,6 +10,7 @@ $end_info$
 #include <cstdint>
 #include <functional>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <optional>
 #include <stddef.h>
@@ -22,6 +23,7 @@ $end_info$
 #include <unordered_set>
 
 #include "Tests/LinuxSyscalls/EmulatedFiles/EmulatedFiles.h"
+#include "Tests/LinuxSyscalls/RootFSImage/RootFSImage.h"
 
 namespace FEXCore::Context {
 struct Context;
@@ -82,7 +84,17 @@ public:
   std::mutex *GetFDLock() { return &FDLock; }
 
 private:
+  /**
+   * @brief Looks up a path in the rootfs image if it would otherwise be resolved through the image's mount
+   *
+   * Absolute paths are looked up like GetEmulatedPath would resolve them, relative paths only if dirfd is inside of the mount.
+   * LookupStatus::NotFound means the path doesn't exist in the rootfs, so only the host path needs to be checked.
+   */
+  FEX::RootFSImage::LookupStatus LookupRootFSImage(int dirfd, const char *pathname, bool FollowSymlink, bool RerootSymlinks, FEX::RootFSImage::Inode *Result, std::string *ResolvedPath = nullptr);
+  std::optional<int> OpenRootFSImage(int dirfd, const char *pathname, uint64_t flags, bool *NotFound);
+
   FEX::EmulatedFile::EmulatedFDManager EmuFD;
+  std::unique_ptr<FEX::RootFSImage::Image> RootFSImage;
 
   std::mutex FDLock;
   std::map<uint32_t, std::string> FDToNameMap;
@@ -95,6 +107,7 @@ private:
   FEX_CONFIG_OPT(ThunkConfig, THUNKCONFIG);
   FEX_CONFIG_OPT(AppConfigName, APP_CONFIG_NAME);
   FEX_CONFIG_OPT(Is64BitMode, IS64BIT_MODE);
+  FEX_CONFIG_OPT(RootFSImageReader, ROOTFSIMAGEREADER);
   uint32_t CurrentPID{};
 };
 }
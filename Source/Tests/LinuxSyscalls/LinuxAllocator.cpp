@@ -5,7 +5,8 @@
 #include <FEXHeaderUtils/Syscalls.h>
 #include <FEXHeaderUtils/TypeDefines.h>
 
-#include <bitset>
+#include <array>
+#include <bit>
 #include <map>
 #include <linux/mman.h>
 #include <unistd.h>
@@ -18,6 +19,165 @@
 #endif
 
 namespace FEX::HLE {
+// Two level bitmap covering the full 32-bit page range
+// Leaf words hold one bit per page, summary words hold one bit per leaf word.
+// Searches skip over fully used or fully free leaf words 64 at a time through the summaries,
+// so a search touches at most a few hundred words instead of every page in the range.
+class PageBitmap final {
+public:
+  static constexpr uint64_t NumPages = 0x10'0000;
+  static constexpr uint64_t NotFound = ~0ULL;
+
+  PageBitmap() {
+    LeafEmpty.fill(~0ULL);
+  }
+
+  void Set(uint64_t Page, uint64_t Count) {
+    Update<true>(Page, Count);
+  }
+
+  void Reset(uint64_t Page, uint64_t Count) {
+    Update<false>(Page, Count);
+  }
+
+  // First set or clear page in [Page, End), NotFound if none
+  uint64_t FindNextSet(uint64_t Page, uint64_t End) const { return FindNext<true>(Page, End); }
+  uint64_t FindNextClear(uint64_t Page, uint64_t End) const { return FindNext<false>(Page, End); }
+
+  // Last set or clear page in [Begin, Page], NotFound if none
+  uint64_t FindPrevSet(uint64_t Page, uint64_t Begin) const { return FindPrev<true>(Page, Begin); }
+  uint64_t FindPrevClear(uint64_t Page, uint64_t Begin) const { return FindPrev<false>(Page, Begin); }
+
+private:
+  static constexpr uint64_t NumLeaves = NumPages / 64;
+  static constexpr uint64_t NumSummaries = NumLeaves / 64;
+
+  std::array<uint64_t, NumLeaves> Leaves{};
+  // Bit set when the leaf word has every page set
+  std::array<uint64_t, NumSummaries> LeafFull{};
+  // Bit set when the leaf word has every page clear
+  std::array<uint64_t, NumSummaries> LeafEmpty{};
+
+  template<bool Used>
+  void Update(uint64_t Page, uint64_t Count) {
+    const uint64_t End = Page + Count;
+    while (Page < End) {
+      const uint64_t Word = Page / 64;
+      const uint64_t Bit = Page % 64;
+      const uint64_t Bits = std::min<uint64_t>(64 - Bit, End - Page);
+      const uint64_t Mask = (Bits == 64 ? ~0ULL : ((1ULL << Bits) - 1)) << Bit;
+
+      if constexpr (Used) {
+        Leaves[Word] |= Mask;
+      }
+      else {
+        Leaves[Word] &= ~Mask;
+      }
+
+      const uint64_t SummaryBit = 1ULL << (Word % 64);
+      LeafFull[Word / 64] = (LeafFull[Word / 64] & ~SummaryBit) | (Leaves[Word] == ~0ULL ? SummaryBit : 0);
+      LeafEmpty[Word / 64] = (LeafEmpty[Word / 64] & ~SummaryBit) | (Leaves[Word] == 0 ? SummaryBit : 0);
+
+      Page += Bits;
+    }
+  }
+
+  // Bits that match what is being searched for
+  template<bool Set>
+  uint64_t LeafCandidates(uint64_t Word) const {
+    return Set ? Leaves[Word] : ~Leaves[Word];
+  }
+
+  // Leaf words that could contain what is being searched for
+  template<bool Set>
+  uint64_t SummaryCandidates(uint64_t Summary) const {
+    return Set ? ~LeafEmpty[Summary] : ~LeafFull[Summary];
+  }
+
+  // First leaf word in [Word, EndWord) with candidate bits
+  template<bool Set>
+  uint64_t FindNextLeaf(uint64_t Word, uint64_t EndWord) const {
+    if (Word >= EndWord) {
+      return NotFound;
+    }
+
+    uint64_t Summary = Word / 64;
+    uint64_t Bits = SummaryCandidates<Set>(Summary) & (~0ULL << (Word % 64));
+    while (!Bits) {
+      ++Summary;
+      if (Summary * 64 >= EndWord) {
+        return NotFound;
+      }
+      Bits = SummaryCandidates<Set>(Summary);
+    }
+
+    const uint64_t Found = Summary * 64 + std::countr_zero(Bits);
+    return Found < EndWord ? Found : NotFound;
+  }
+
+  // Last leaf word in [BeginWord, Word] with candidate bits
+  template<bool Set>
+  uint64_t FindPrevLeaf(uint64_t Word, uint64_t BeginWord) const {
+    uint64_t Summary = Word / 64;
+    uint64_t Bits = SummaryCandidates<Set>(Summary) & (~0ULL >> (63 - (Word % 64)));
+    while (!Bits) {
+      if (Summary * 64 <= BeginWord) {
+        return NotFound;
+      }
+      --Summary;
+      Bits = SummaryCandidates<Set>(Summary);
+    }
+
+    const uint64_t Found = Summary * 64 + 63 - std::countl_zero(Bits);
+    return Found >= BeginWord ? Found : NotFound;
+  }
+
+  template<bool Set>
+  uint64_t FindNext(uint64_t Page, uint64_t End) const {
+    if (Page >= End) {
+      return NotFound;
+    }
+
+    const uint64_t EndWord = (End + 63) / 64;
+    uint64_t Word = Page / 64;
+    uint64_t Bits = LeafCandidates<Set>(Word) & (~0ULL << (Page % 64));
+    while (!Bits) {
+      Word = FindNextLeaf<Set>(Word + 1, EndWord);
+      if (Word == NotFound) {
+        return NotFound;
+      }
+      Bits = LeafCandidates<Set>(Word);
+    }
+
+    const uint64_t Found = Word * 64 + std::countr_zero(Bits);
+    return Found < End ? Found : NotFound;
+  }
+
+  template<bool Set>
+  uint64_t FindPrev(uint64_t Page, uint64_t Begin) const {
+    if (Page < Begin) {
+      return NotFound;
+    }
+
+    const uint64_t BeginWord = Begin / 64;
+    uint64_t Word = Page / 64;
+    uint64_t Bits = LeafCandidates<Set>(Word) & (~0ULL >> (63 - (Page % 64)));
+    while (!Bits) {
+      if (Word <= BeginWord) {
+        return NotFound;
+      }
+      Word = FindPrevLeaf<Set>(Word - 1, BeginWord);
+      if (Word == NotFound) {
+        return NotFound;
+      }
+      Bits = LeafCandidates<Set>(Word);
+    }
+
+    const uint64_t Found = Word * 64 + 63 - std::countl_zero(Bits);
+    return Found >= Begin ? Found : NotFound;
+  }
+};
+
 class MemAllocator32Bit final : public FEX::HLE::MemAllocator {
 private:
   static constexpr uint64_t BASE_KEY = 16;
@@ -27,11 +187,9 @@ private:
 public:
   MemAllocator32Bit() {
     // First 16 pages are taken by the Linux kernel
-    for (size_t i = 0; i < 16; ++i) {
-      MappedPages.set(i);
-    }
+    MappedPages.Set(0, 16);
     // Take the top page as well
-    MappedPages.set(TOP_KEY);
+    MappedPages.Set(TOP_KEY, 1);
     if (SearchDown) {
       LastScanLocation = TOP_KEY;
       LastKeyLocation = TOP_KEY;
@@ -55,24 +213,20 @@ public:
   // PagesLength is the number of pages
   void SetUsedPages(uint64_t PageAddr, size_t PagesLength) {
     // Set the range as mapped
-    for (size_t i = 0; i < PagesLength; ++i) {
-      MappedPages.set(PageAddr + i);
-    }
+    MappedPages.Set(PageAddr, PagesLength);
   }
 
   // PageAddr is a page already shifted to page index
   // PagesLength is the number of pages
   void SetFreePages(uint64_t PageAddr, size_t PagesLength) {
     // Set the range as unused
-    for (size_t i = 0; i < PagesLength; ++i) {
-      MappedPages.reset(PageAddr + i);
-    }
+    MappedPages.Reset(PageAddr, PagesLength);
   }
 
 private:
   // Set that contains 4k mapped pages
   // This is the full 32bit memory range
-  std::bitset<0x10'0000> MappedPages;
+  PageBitmap MappedPages;
   std::map<uint32_t, int> PageToShm{};
   uint64_t LastScanLocation{};
   uint64_t LastKeyLocation{};
@@ -85,47 +239,42 @@ private:
 };
 
 uint64_t MemAllocator32Bit::FindPageRange(uint64_t Start, size_t Pages) const {
-  // Linear range scan
-  while (Start != TOP_KEY) {
-    bool Free = true;
-    if ((Start + Pages) > TOP_KEY) {
+  // First fit scan upwards from Start
+  while (Start + Pages <= TOP_KEY) {
+    const uint64_t Free = MappedPages.FindNextClear(Start, TOP_KEY);
+    if (Free == PageBitmap::NotFound ||
+        (Free + Pages) > TOP_KEY) {
       return 0;
     }
-    uint64_t Offset = 0;
-    for (; Offset < Pages; ++Offset) {
-      if (MappedPages.test(Start + Offset)) {
-        Free = false;
-        break;
-      }
-    }
 
-    if (Free) {
-      return Start;
+    // Skip past the first used page inside of the candidate range
+    const uint64_t Used = MappedPages.FindNextSet(Free, Free + Pages);
+    if (Used == PageBitmap::NotFound) {
+      return Free;
     }
-    Start += Offset + 1;
+    Start = Used + 1;
   }
 
   return 0;
 }
 
 uint64_t MemAllocator32Bit::FindPageRange_TopDown(uint64_t Start, size_t Pages) const {
-  // Linear range scan
+  // First fit scan downwards from Start, the returned range ends at or below Start
   while (Start >= BASE_KEY &&
          Start <= TOP_KEY) {
-    bool Free = true;
-
-    uint64_t Offset = 0;
-    for (; Offset < Pages; ++Offset) {
-      if (MappedPages.test(Start - Offset)) {
-        Free = false;
-        break;
-      }
+    const uint64_t Top = MappedPages.FindPrevClear(Start, BASE_KEY);
+    if (Top == PageBitmap::NotFound ||
+        (Top + 1) < (BASE_KEY + Pages)) {
+      return 0;
     }
 
-    if (Free) {
-      return Start - Offset;
+    // Skip below the last used page inside of the candidate range
+    const uint64_t Lower = Top + 1 - Pages;
+    const uint64_t Used = MappedPages.FindPrevSet(Top, Lower);
+    if (Used == PageBitmap::NotFound) {
+      return Lower;
     }
-    Start -= Offset + 1;
+    Start = Used - 1;
   }
 
   return 0;
@@ -289,8 +438,6 @@ int MemAllocator32Bit::Munmap(void *addr, size_t length) {
   uintptr_t Addr = reinterpret_cast<uintptr_t>(addr);
   uintptr_t PageAddr = Addr >> FHU::FEX_PAGE_SHIFT;
 
-  uintptr_t PageEnd = PageAddr + PagesLength;
-
   // Both Addr and length must be page aligned
   if (Addr & ~FHU::FEX_PAGE_MASK) {
     return -EINVAL;
@@ -310,20 +457,15 @@ int MemAllocator32Bit::Munmap(void *addr, size_t length) {
     return 0;
   }
 
-  while (PageAddr != PageEnd) {
-    // Always pass to munmap, it may be something allocated we aren't tracking
-    int Result = ::munmap(reinterpret_cast<void*>(PageAddr << FHU::FEX_PAGE_SHIFT), FHU::FEX_PAGE_SIZE);
-    if (Result != 0) {
-      return -errno;
-    }
-
-    if (MappedPages.test(PageAddr)) {
-      MappedPages.reset(PageAddr);
-    }
-
-    ++PageAddr;
+  // Always pass to munmap, it may be something allocated we aren't tracking
+  // Holes in the range are fine for munmap, so the whole range is unmapped at once
+  int Result = ::munmap(reinterpret_cast<void*>(PageAddr << FHU::FEX_PAGE_SHIFT), length);
+  if (Result != 0) {
+    return -errno;
   }
 
+  SetFreePages(PageAddr, PagesLength);
+
   return 0;
 }
 
@@ -371,14 +513,9 @@ void *MemAllocator32Bit::Mremap(void *old_address, size_t old_size, size_t new_s
       }
       else {
         // Scan the region forward from our first region's endd to see if it can be extended
-        bool CanExtend{true};
-
-        for (size_t i = OldPagesLength; i < NewPagesLength; ++i) {
-          if (MappedPages[OldPageAddr + i]) {
-            CanExtend = false;
-            break;
-          }
-        }
+        const uint64_t ExtendEnd = OldPageAddr + NewPagesLength;
+        bool CanExtend = ExtendEnd <= TOP_KEY &&
+          MappedPages.FindNextSet(OldPageAddr + OldPagesLength, ExtendEnd) == PageBitmap::NotFound;
 
         if (CanExtend) {
           void *MappedPtr = ::mremap(old_address, old_size, new_size, flags & ~MREMAP_MAYMOVE);
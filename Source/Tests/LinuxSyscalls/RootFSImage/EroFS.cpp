@@ -0,0 +1,345 @@
+/*
+$info$
+tags: LinuxSyscalls|common
+desc: EroFS image reader
+$end_info$
+*/
+
+#include "Tests/LinuxSyscalls/RootFSImage/RootFSImage.h"
+
+#include <FEXCore/Utils/LogManager.h>
+
+#include <algorithm>
+#include <cstring>
+#include <linux/limits.h>
+#include <sys/stat.h>
+#include <sys/sysmacros.h>
+#include <unistd.h>
+
+namespace FEX::RootFSImage {
+namespace {
+  constexpr uint32_t EROFS_MAGIC = 0xE0F5E1E2;
+  constexpr size_t SUPERBLOCK_OFFSET = 1024;
+
+  struct Superblock {
+    uint32_t Magic;
+    uint32_t Checksum;
+    uint32_t FeatureCompat;
+    uint8_t BlockSizeBits;
+    uint8_t ExtSlots;
+    uint16_t RootNID;
+    uint64_t Inodes;
+    uint64_t BuildTime;
+    uint32_t BuildTimeNSec;
+    uint32_t Blocks;
+    uint32_t MetaBlockAddr;
+    uint32_t XattrBlockAddr;
+    uint8_t UUID[16];
+    uint8_t VolumeName[16];
+    uint32_t FeatureIncompat;
+    // Rest of the superblock isn't needed
+  };
+
+  struct CompactInode {
+    uint16_t Format;
+    uint16_t XattrCount;
+    uint16_t Mode;
+    uint16_t NLink;
+    uint32_t Size;
+    uint32_t Reserved;
+    uint32_t Union;
+    uint32_t Ino;
+    uint16_t UID;
+    uint16_t GID;
+    uint32_t Reserved2;
+  };
+  static_assert(sizeof(CompactInode) == 32);
+
+  struct ExtendedInode {
+    uint16_t Format;
+    uint16_t XattrCount;
+    uint16_t Mode;
+    uint16_t Reserved;
+    uint64_t Size;
+    uint32_t Union;
+    uint32_t Ino;
+    uint32_t UID;
+    uint32_t GID;
+    uint64_t MTime;
+    uint32_t MTimeNSec;
+    uint32_t NLink;
+    uint8_t Reserved2[16];
+  };
+  static_assert(sizeof(ExtendedInode) == 64);
+
+  struct __attribute__((packed)) DirectoryEntry {
+    uint64_t NID;
+    uint16_t NameOffset;
+    uint8_t FileType;
+    uint8_t Reserved;
+  };
+  static_assert(sizeof(DirectoryEntry) == 12);
+
+  enum DataLayout {
+    LAYOUT_FLAT_PLAIN = 0,
+    LAYOUT_COMPRESSED_FULL = 1,
+    LAYOUT_FLAT_INLINE = 2,
+    LAYOUT_COMPRESSED_COMPACT = 3,
+    LAYOUT_CHUNK_BASED = 4,
+  };
+
+  // Format specific inode fields needed after the lookup
+  struct InodeData {
+    DataLayout Layout;
+    uint32_t RawBlockAddr;
+    // Image offset of the tail end packed after the inode
+    uint64_t InlineOffset;
+  };
+
+  class EroFSImage final : public Image {
+    public:
+      EroFSImage(int FD, uint8_t const *Data, size_t DataSize, std::string const &MountPath)
+        : Image(FD, Data, DataSize, MountPath) {}
+
+    protected:
+      bool Initialize() override;
+      bool GetRoot(Inode *Result) override;
+      LookupStatus FindEntry(Inode const &Dir, std::string_view Name, Inode *Result) override;
+      bool ReadSymlinkTarget(Inode const &Node, std::string *Target) override;
+      uint32_t GetBlockSize() const override { return BlockSize; }
+
+    private:
+      bool ReadInode(uint64_t NID, Inode *Result, InodeData *Extra);
+
+      /**
+       * @brief Returns the contents of one block of an uncompressed inode
+       *
+       * @return nullptr if the layout isn't supported or the block is out of bounds
+       */
+      uint8_t const *GetBlock(Inode const &Node, InodeData const &Extra, uint64_t Index, uint32_t *Size) const;
+
+      Superblock SB;
+      uint32_t BlockSize;
+  };
+
+  bool EroFSImage::Initialize() {
+    if (!InBounds(SUPERBLOCK_OFFSET, sizeof(Superblock))) {
+      return false;
+    }
+    memcpy(&SB, Data + SUPERBLOCK_OFFSET, sizeof(SB));
+
+    if (SB.Magic != EROFS_MAGIC || SB.BlockSizeBits < 9 || SB.BlockSizeBits > 16) {
+      return false;
+    }
+    BlockSize = 1U << SB.BlockSizeBits;
+
+    Inode Root;
+    return GetRoot(&Root) && S_ISDIR(Root.Mode);
+  }
+
+  bool EroFSImage::ReadInode(uint64_t NID, Inode *Result, InodeData *Extra) {
+    const uint64_t Offset = uint64_t(SB.MetaBlockAddr) * BlockSize + NID * sizeof(CompactInode);
+    uint16_t Format;
+    if (!InBounds(Offset, sizeof(Format))) {
+      return false;
+    }
+    memcpy(&Format, Data + Offset, sizeof(Format));
+
+    size_t InodeSize;
+    uint16_t XattrCount;
+    uint32_t Union;
+    if (Format & 1) {
+      ExtendedInode Raw;
+      if (!InBounds(Offset, sizeof(Raw))) {
+        return false;
+      }
+      memcpy(&Raw, Data + Offset, sizeof(Raw));
+
+      *Result = Inode {
+        .Number = Raw.Ino,
+        .Mode = Raw.Mode,
+        .UID = Raw.UID,
+        .GID = Raw.GID,
+        .NLink = Raw.NLink,
+        .Size = Raw.Size,
+        .MTime = static_cast<int64_t>(Raw.MTime),
+        .MTimeNSec = Raw.MTimeNSec,
+      };
+      InodeSize = sizeof(Raw);
+      XattrCount = Raw.XattrCount;
+      Union = Raw.Union;
+    }
+    else {
+      CompactInode Raw;
+      if (!InBounds(Offset, sizeof(Raw))) {
+        return false;
+      }
+      memcpy(&Raw, Data + Offset, sizeof(Raw));
+
+      // Compact inodes share the build time
+      *Result = Inode {
+        .Number = Raw.Ino,
+        .Mode = Raw.Mode,
+        .UID = Raw.UID,
+        .GID = Raw.GID,
+        .NLink = Raw.NLink,
+        .Size = Raw.Size,
+        .MTime = static_cast<int64_t>(SB.BuildTime),
+        .MTimeNSec = SB.BuildTimeNSec,
+      };
+      InodeSize = sizeof(Raw);
+      XattrCount = Raw.XattrCount;
+      Union = Raw.Union;
+    }
+
+    Result->Ref = NID;
+    if (S_ISCHR(Result->Mode) || S_ISBLK(Result->Mode)) {
+      // Stored in the kernel's new_encode_dev format
+      Result->RDev = makedev((Union & 0xfff00) >> 8, (Union & 0xff) | ((Union >> 12) & 0xfff00));
+    }
+
+    // The inline xattr area has a 12 byte header followed by 4 byte entries
+    const size_t XattrSize = XattrCount ? 12 + (XattrCount - 1) * 4 : 0;
+
+    *Extra = InodeData {
+      .Layout = static_cast<DataLayout>((Format >> 1) & 7),
+      .RawBlockAddr = Union,
+      .InlineOffset = Offset + InodeSize + XattrSize,
+    };
+    return true;
+  }
+
+  uint8_t const *EroFSImage::GetBlock(Inode const &Node, InodeData const &Extra, uint64_t Index, uint32_t *Size) const {
+    if (Extra.Layout != LAYOUT_FLAT_PLAIN && Extra.Layout != LAYOUT_FLAT_INLINE) {
+      // Compressed and chunk based inodes go through the mount
+      return nullptr;
+    }
+
+    const uint64_t BlockCount = (Node.Size + BlockSize - 1) / BlockSize;
+    if (Index >= BlockCount) {
+      return nullptr;
+    }
+
+    *Size = std::min<uint64_t>(BlockSize, Node.Size - Index * BlockSize);
+
+    uint64_t Offset;
+    if (Extra.Layout == LAYOUT_FLAT_INLINE && Index == BlockCount - 1) {
+      // The last block is packed after the inode
+      Offset = Extra.InlineOffset;
+    }
+    else {
+      Offset = (uint64_t(Extra.RawBlockAddr) + Index) * BlockSize;
+    }
+
+    return InBounds(Offset, *Size) ? Data + Offset : nullptr;
+  }
+
+  bool EroFSImage::GetRoot(Inode *Result) {
+    InodeData Extra;
+    return ReadInode(SB.RootNID, Result, &Extra);
+  }
+
+  LookupStatus EroFSImage::FindEntry(Inode const &Dir, std::string_view Name, Inode *Result) {
+    Inode Node;
+    InodeData Extra;
+    if (!ReadInode(Dir.Ref, &Node, &Extra)) {
+      return LookupStatus::Unsupported;
+    }
+
+    const uint64_t BlockCount = (Node.Size + BlockSize - 1) / BlockSize;
+    for (uint64_t i = 0; i < BlockCount; ++i) {
+      uint32_t Size;
+      auto Block = GetBlock(Node, Extra, i, &Size);
+      if (!Block || Size < sizeof(DirectoryEntry)) {
+        return LookupStatus::Unsupported;
+      }
+
+      // The name offset of the first entry is also the size of the entry array
+      DirectoryEntry First;
+      memcpy(&First, Block, sizeof(First));
+      const size_t EntryCount = First.NameOffset / sizeof(DirectoryEntry);
+      if (EntryCount == 0 || First.NameOffset > Size) {
+        return LookupStatus::Unsupported;
+      }
+
+      auto GetName = [&](size_t Index) -> std::optional<std::string_view> {
+        DirectoryEntry Entry, Next;
+        memcpy(&Entry, Block + Index * sizeof(Entry), sizeof(Entry));
+
+        size_t End = Size;
+        if (Index + 1 < EntryCount) {
+          memcpy(&Next, Block + (Index + 1) * sizeof(Next), sizeof(Next));
+          End = Next.NameOffset;
+        }
+        if (Entry.NameOffset > End || End > Size) {
+          return std::nullopt;
+        }
+
+        // The last name in a block can be padded with zeros
+        auto Name = reinterpret_cast<char const*>(Block + Entry.NameOffset);
+        return std::string_view(Name, strnlen(Name, End - Entry.NameOffset));
+      };
+
+      // Names are sorted within a block and across blocks
+      auto LastName = GetName(EntryCount - 1);
+      if (!LastName) {
+        return LookupStatus::Unsupported;
+      }
+      if (*LastName < Name) {
+        continue;
+      }
+
+      size_t Low = 0, High = EntryCount;
+      while (Low < High) {
+        const size_t Middle = Low + (High - Low) / 2;
+        auto EntryName = GetName(Middle);
+        if (!EntryName) {
+          return LookupStatus::Unsupported;
+        }
+
+        const int Compare = EntryName->compare(Name);
+        if (Compare == 0) {
+          DirectoryEntry Entry;
+          memcpy(&Entry, Block + Middle * sizeof(Entry), sizeof(Entry));
+          InodeData ChildExtra;
+          return ReadInode(Entry.NID, Result, &ChildExtra) ? LookupStatus::Found : LookupStatus::Unsupported;
+        }
+        else if (Compare < 0) {
+          Low = Middle + 1;
+        }
+        else {
+          High = Middle;
+        }
+      }
+
+      return LookupStatus::NotFound;
+    }
+
+    return LookupStatus::NotFound;
+  }
+
+  bool EroFSImage::ReadSymlinkTarget(Inode const &Node, std::string *Target) {
+    Inode Symlink;
+    InodeData Extra;
+    if (!ReadInode(Node.Ref, &Symlink, &Extra) || !S_ISLNK(Symlink.Mode) || Symlink.Size >= PATH_MAX) {
+      return false;
+    }
+
+    Target->clear();
+    const uint64_t BlockCount = (Symlink.Size + BlockSize - 1) / BlockSize;
+    for (uint64_t i = 0; i < BlockCount; ++i) {
+      uint32_t Size;
+      auto Block = GetBlock(Symlink, Extra, i, &Size);
+      if (!Block) {
+        return false;
+      }
+      Target->append(reinterpret_cast<char const*>(Block), Size);
+    }
+    return true;
+  }
+}
+
+  std::unique_ptr<Image> OpenEroFS(int FD, uint8_t const *Data, size_t DataSize, std::string const &MountPath) {
+    return std::make_unique<EroFSImage>(FD, Data, DataSize, MountPath);
+  }
+}
@@ -0,0 +1,313 @@
+/*
+$info$
+tags: LinuxSyscalls|common
+desc: In-process reader for SquashFS and EroFS rootfs images
+$end_info$
+*/
+
+#include "Common/FileFormatCheck.h"
+#include "Tests/LinuxSyscalls/RootFSImage/RootFSImage.h"
+
+#include <FEXCore/Utils/LogManager.h>
+#include <FEXHeaderUtils/ScopedSignalMask.h>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/sysmacros.h>
+#include <unistd.h>
+
+namespace FEX::RootFSImage {
+  // Decompressed metadata and data blocks
+  constexpr size_t BLOCK_CACHE_SIZE = 64 * 1024 * 1024;
+
+  // Same limit as the kernel
+  constexpr size_t MAX_SYMLINK_FOLLOWS = 40;
+
+  BlockCache::Block BlockCache::Find(uint64_t Key) {
+    FHU::ScopedSignalMaskWithMutex lk(Lock);
+    auto it = Blocks.find(Key);
+    if (it == Blocks.end()) {
+      return {};
+    }
+
+    // Move to the front of the LRU
+    LRU.splice(LRU.begin(), LRU, it->second);
+    return it->second->second;
+  }
+
+  void BlockCache::Insert(uint64_t Key, Block Data) {
+    FHU::ScopedSignalMaskWithMutex lk(Lock);
+    if (Blocks.contains(Key)) {
+      // Another thread decompressed the same block in the meantime
+      return;
+    }
+
+    Size += Data->size();
+    LRU.emplace_front(Key, std::move(Data));
+    Blocks.emplace(Key, LRU.begin());
+
+    while (Size > MaxSize && LRU.size() > 1) {
+      auto &Oldest = LRU.back();
+      Size -= Oldest.second->size();
+      Blocks.erase(Oldest.first);
+      LRU.pop_back();
+    }
+  }
+
+  std::unique_ptr<Image> Image::Open(std::string const &ImagePath, std::string const &MountPath) {
+    const bool IsEroFS = FEX::FormatCheck::IsEroFS(ImagePath);
+    if (!IsEroFS && !FEX::FormatCheck::IsSquashFS(ImagePath)) {
+      return {};
+    }
+
+    int FD = open(ImagePath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (FD == -1) {
+      return {};
+    }
+
+    struct stat Buffer{};
+    if (fstat(FD, &Buffer) == -1 || Buffer.st_size <= 0) {
+      close(FD);
+      return {};
+    }
+
+    auto Data = mmap(nullptr, Buffer.st_size, PROT_READ, MAP_PRIVATE, FD, 0);
+    if (Data == MAP_FAILED) {
+      close(FD);
+      return {};
+    }
+
+    auto Result = IsEroFS ?
+      OpenEroFS(FD, reinterpret_cast<uint8_t const*>(Data), Buffer.st_size, MountPath) :
+      OpenSquashFS(FD, reinterpret_cast<uint8_t const*>(Data), Buffer.st_size, MountPath);
+
+    if (!Result || !Result->Initialize() || !Result->MatchesMount()) {
+      LogMan::Msg::DFmt("RootFS image '{}' isn't supported by the in-process reader, using the mount", ImagePath);
+      if (!Result) {
+        munmap(Data, Buffer.st_size);
+        close(FD);
+      }
+      return {};
+    }
+
+    return Result;
+  }
+
+  Image::Image(int FD, uint8_t const *Data, size_t DataSize, std::string const &MountPath)
+    : ImageFD {FD}
+    , Data {Data}
+    , DataSize {DataSize}
+    , Cache {BLOCK_CACHE_SIZE}
+    , MountPath {MountPath} {
+    // Everything reports the device of the mount so it matches the directory FDs opened through it
+    struct stat Buffer{};
+    if (stat(MountPath.c_str(), &Buffer) == 0) {
+      MountDev = Buffer.st_dev;
+    }
+  }
+
+  Image::~Image() {
+    munmap(const_cast<uint8_t*>(Data), DataSize);
+    close(ImageFD);
+  }
+
+  bool Image::MatchesMount() {
+    // FEXServer mounts with use_ino, otherwise FUSE numbers inodes itself and stat wouldn't match fstat of an opened file
+    Inode Root;
+    struct stat Buffer{};
+    if (!GetRoot(&Root) || stat(MountPath.c_str(), &Buffer) != 0 || Buffer.st_ino != Root.Number) {
+      LogMan::Msg::DFmt("RootFS mount '{}' doesn't report the image's inode numbers, using the mount", MountPath);
+      return false;
+    }
+    return true;
+  }
+
+  std::optional<std::string_view> Image::GetImagePath(std::string_view HostPath) const {
+    if (HostPath.size() < MountPath.size() ||
+        HostPath.substr(0, MountPath.size()) != MountPath) {
+      return std::nullopt;
+    }
+
+    auto Path = HostPath.substr(MountPath.size());
+    if (!Path.empty() && Path[0] != '/') {
+      // Only shares a prefix with the mount folder
+      return std::nullopt;
+    }
+    return Path;
+  }
+
+  LookupStatus Image::Lookup(std::string_view Path, bool FollowSymlink, bool RerootSymlinks, Inode *Result, std::string *ResolvedPath) {
+    // Components left to resolve, the next one is at the back
+    std::vector<std::string_view> Pending;
+    // Storage for symlink targets that Pending points in to
+    std::list<std::string> Targets;
+
+    auto PushComponents = [&Pending](std::string_view Path) {
+      size_t End = Path.size();
+      while (End > 0) {
+        size_t Begin = Path.rfind('/', End - 1);
+        Begin = Begin == std::string_view::npos ? 0 : Begin + 1;
+        if (End != Begin) {
+          Pending.emplace_back(Path.substr(Begin, End - Begin));
+        }
+        End = Begin > 0 ? Begin - 1 : 0;
+      }
+    };
+
+    // A trailing slash requires a directory and follows a symlink in the final component
+    const bool MustBeDirectory = !Path.empty() && Path.back() == '/';
+    FollowSymlink |= MustBeDirectory;
+    PushComponents(Path);
+
+    std::vector<Inode> Parents(1);
+    // Names of Parents after the root, points in to Path or Targets
+    std::vector<std::string_view> Names;
+    if (!GetRoot(&Parents.back())) {
+      return LookupStatus::Unsupported;
+    }
+
+    size_t SymlinkFollows{};
+    bool FollowedRelativeSymlink{};
+
+    while (!Pending.empty()) {
+      auto Name = Pending.back();
+      Pending.pop_back();
+
+      if (!S_ISDIR(Parents.back().Mode)) {
+        errno = ENOTDIR;
+        return LookupStatus::NotFound;
+      }
+
+      if (Name == ".") {
+        continue;
+      }
+
+      if (Name == "..") {
+        if (Parents.size() == 1) {
+          // Leaves the mount, the host filesystem is above
+          return LookupStatus::Unsupported;
+        }
+        Parents.pop_back();
+        Names.pop_back();
+        continue;
+      }
+
+      Inode Child;
+      auto Status = FindEntry(Parents.back(), Name, &Child);
+      if (Status != LookupStatus::Found) {
+        if (Status == LookupStatus::NotFound) {
+          errno = ENOENT;
+        }
+        return Status;
+      }
+
+      const bool IsFinal = Pending.empty();
+      if (S_ISLNK(Child.Mode) && (!IsFinal || FollowSymlink)) {
+        if (++SymlinkFollows > MAX_SYMLINK_FOLLOWS) {
+          errno = ELOOP;
+          return LookupStatus::NotFound;
+        }
+
+        auto &Target = Targets.emplace_back();
+        if (!ReadSymlinkTarget(Child, &Target)) {
+          return LookupStatus::Unsupported;
+        }
+
+        if (Target.empty()) {
+          errno = ENOENT;
+          return LookupStatus::NotFound;
+        }
+
+        if (Target[0] == '/') {
+          // Only GetEmulatedPath resolves absolute symlinks inside of the rootfs, and only until a relative one was followed
+          if (!IsFinal || !RerootSymlinks || FollowedRelativeSymlink) {
+            return LookupStatus::Unsupported;
+          }
+          Parents.resize(1);
+          Names.clear();
+        }
+        else if (IsFinal) {
+          FollowedRelativeSymlink = true;
+        }
+
+        PushComponents(Target);
+        continue;
+      }
+
+      Parents.emplace_back(Child);
+      Names.emplace_back(Name);
+    }
+
+    if (MustBeDirectory && !S_ISDIR(Parents.back().Mode)) {
+      errno = ENOTDIR;
+      return LookupStatus::NotFound;
+    }
+
+    *Result = Parents.back();
+    if (ResolvedPath) {
+      ResolvedPath->clear();
+      for (auto Name : Names) {
+        *ResolvedPath += '/';
+        *ResolvedPath += Name;
+      }
+      if (ResolvedPath->empty()) {
+        *ResolvedPath = '/';
+      }
+    }
+    return LookupStatus::Found;
+  }
+
+  void Image::FillStat(Inode const &Node, struct stat *buf) const {
+    *buf = {};
+    buf->st_dev = MountDev;
+    buf->st_ino = Node.Number;
+    buf->st_mode = Node.Mode;
+    buf->st_nlink = Node.NLink;
+    buf->st_uid = Node.UID;
+    buf->st_gid = Node.GID;
+    buf->st_rdev = Node.RDev;
+    buf->st_size = Node.Size;
+    buf->st_blksize = GetBlockSize();
+    buf->st_blocks = (Node.Size + 511) / 512;
+    buf->st_atim.tv_sec = buf->st_mtim.tv_sec = buf->st_ctim.tv_sec = Node.MTime;
+    buf->st_atim.tv_nsec = buf->st_mtim.tv_nsec = buf->st_ctim.tv_nsec = Node.MTimeNSec;
+  }
+
+  void Image::FillStat(Inode const &Node, struct statx *buf) const {
+    *buf = {};
+    buf->stx_mask = STATX_BASIC_STATS;
+    buf->stx_blksize = GetBlockSize();
+    buf->stx_nlink = Node.NLink;
+    buf->stx_uid = Node.UID;
+    buf->stx_gid = Node.GID;
+    buf->stx_mode = Node.Mode;
+    buf->stx_ino = Node.Number;
+    buf->stx_size = Node.Size;
+    buf->stx_blocks = (Node.Size + 511) / 512;
+    buf->stx_atime.tv_sec = buf->stx_mtime.tv_sec = buf->stx_ctime.tv_sec = Node.MTime;
+    buf->stx_atime.tv_nsec = buf->stx_mtime.tv_nsec = buf->stx_ctime.tv_nsec = Node.MTimeNSec;
+    buf->stx_rdev_major = major(Node.RDev);
+    buf->stx_rdev_minor = minor(Node.RDev);
+    buf->stx_dev_major = major(MountDev);
+    buf->stx_dev_minor = minor(MountDev);
+  }
+
+  bool Image::ReadSymlink(Inode const &Node, std::string *Target) {
+    return S_ISLNK(Node.Mode) && ReadSymlinkTarget(Node, Target);
+  }
+
+  std::optional<int> Image::OpenFile(Inode const &Node, std::string const &ResolvedPath, int Flags) {
+    if (!S_ISREG(Node.Mode)) {
+      return std::nullopt;
+    }
+
+    // Every symlink is resolved, so the kernel takes the same path through the mount without leaving it
+    const auto Path = MountPath + ResolvedPath;
+    int FD = open(Path.c_str(), Flags);
+    if (FD == -1) {
+      return std::nullopt;
+    }
+    return FD;
+  }
+}
@@ -0,0 +1,159 @@
+/*
+$info$
+tags: LinuxSyscalls|common
+desc: In-process reader for SquashFS and EroFS rootfs images
+$end_info$
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unordered_map>
+#include <vector>
+
+namespace FEX::RootFSImage {
+  /**
+   * @brief Least recently used cache of decompressed image blocks
+   *
+   * Shared by all threads. Blocks are handed out as shared pointers so an evicted block stays valid while it is in use.
+   */
+  class BlockCache final {
+    public:
+      using Block = std::shared_ptr<const std::vector<uint8_t>>;
+
+      explicit BlockCache(size_t MaxSize)
+        : MaxSize {MaxSize} {}
+
+      Block Find(uint64_t Key);
+      void Insert(uint64_t Key, Block Data);
+
+    private:
+      std::mutex Lock;
+      std::list<std::pair<uint64_t, Block>> LRU;
+      std::unordered_map<uint64_t, decltype(LRU)::iterator> Blocks;
+      size_t Size{};
+      size_t MaxSize;
+  };
+
+  struct Inode {
+    // Format specific location of the inode in the image
+    uint64_t Ref;
+    uint64_t Number;
+    uint32_t Mode;
+    uint32_t UID;
+    uint32_t GID;
+    uint32_t NLink;
+    uint64_t Size;
+    int64_t MTime;
+    uint32_t MTimeNSec;
+    uint64_t RDev;
+  };
+
+  enum class LookupStatus {
+    // The path exists in the image
+    Found,
+    // The path doesn't exist in the image, errno is set
+    NotFound,
+    // The image can't answer this, the path needs to go through the mount
+    Unsupported,
+  };
+
+  /**
+   * @brief A read-only rootfs image that is also mounted through FUSE by FEXServer
+   *
+   * Lookups, stat and readlink are served from the mapped image directly.
+   * Regular files are opened through the mount once the lookup resolved them.
+   * Anything this can't answer the same way the kernel would through the mount returns LookupStatus::Unsupported,
+   * like absolute symlinks in the middle of a path that the kernel resolves against the host root.
+   */
+  class Image {
+    public:
+      /**
+       * @brief Opens a SquashFS or EroFS image
+       *
+       * @param ImagePath - The image file
+       * @param MountPath - Where FEXServer mounted the image
+       *
+       * @return nullptr if the image format or compressor isn't supported
+       */
+      static std::unique_ptr<Image> Open(std::string const &ImagePath, std::string const &MountPath);
+
+      virtual ~Image();
+
+      /**
+       * @brief Resolves a path relative to the image root
+       *
+       * @param Path - Path inside of the image, leading slashes are ignored
+       * @param FollowSymlink - Follow a symlink in the final path component
+       * @param RerootSymlinks - Resolve an absolute symlink in the final component inside of the image, like FileManager::GetEmulatedPath does.
+       *                         Otherwise the kernel would resolve it against the host root.
+       * @param ResolvedPath - If set, receives the path of the result inside of the image with all symlinks resolved
+       */
+      LookupStatus Lookup(std::string_view Path, bool FollowSymlink, bool RerootSymlinks, Inode *Result, std::string *ResolvedPath = nullptr);
+
+      /**
+       * @brief Converts a host path inside of the mount to a path inside of the image
+       *
+       * @return std::nullopt if the path isn't inside of the mount
+       */
+      std::optional<std::string_view> GetImagePath(std::string_view HostPath) const;
+
+      void FillStat(Inode const &Node, struct stat *buf) const;
+      void FillStat(Inode const &Node, struct statx *buf) const;
+
+      bool ReadSymlink(Inode const &Node, std::string *Target);
+
+      /**
+       * @brief Opens a regular file from the image through the mount
+       *
+       * Uses the path the lookup resolved, so the FD has the same path and identity as the file in the mount,
+       * which AOTIR and the code cache key files by.
+       *
+       * @param ResolvedPath - The ResolvedPath from the Lookup of Node
+       *
+       * @return The new FD or std::nullopt if the file needs to go through the regular path
+       */
+      std::optional<int> OpenFile(Inode const &Node, std::string const &ResolvedPath, int Flags);
+
+    protected:
+      Image(int FD, uint8_t const *Data, size_t DataSize, std::string const &MountPath);
+
+      virtual bool Initialize() = 0;
+
+      /**
+       * @name Format specific accessors
+       * @{ */
+      virtual bool GetRoot(Inode *Result) = 0;
+      virtual LookupStatus FindEntry(Inode const &Dir, std::string_view Name, Inode *Result) = 0;
+      virtual bool ReadSymlinkTarget(Inode const &Node, std::string *Target) = 0;
+      virtual uint32_t GetBlockSize() const = 0;
+      /**  @} */
+
+      bool InBounds(uint64_t Offset, uint64_t Size) const {
+        return Offset <= DataSize && Size <= DataSize - Offset;
+      }
+
+      int ImageFD;
+      uint8_t const *Data;
+      size_t DataSize;
+      BlockCache Cache;
+
+    private:
+      // Checks that the mount reports the same inode numbers as the image
+      bool MatchesMount();
+
+      std::string MountPath;
+      dev_t MountDev{};
+  };
+
+  std::unique_ptr<Image> OpenSquashFS(int FD, uint8_t const *Data, size_t DataSize, std::string const &MountPath);
+  std::unique_ptr<Image> OpenEroFS(int FD, uint8_t const *Data, size_t DataSize, std::string const &MountPath);
+}
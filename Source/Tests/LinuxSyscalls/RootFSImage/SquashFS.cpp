@@ -0,0 +1,555 @@
+/*
+$info$
+tags: LinuxSyscalls|common
+desc: SquashFS 4.0 image reader
+$end_info$
+*/
+
+#include "Tests/LinuxSyscalls/RootFSImage/RootFSImage.h"
+
+#include <FEXCore/Utils/LogManager.h>
+
+#include <algorithm>
+#include <cstring>
+#include <linux/limits.h>
+#include <sys/stat.h>
+#include <sys/sysmacros.h>
+#include <unistd.h>
+
+#ifdef HAS_ZLIB
+#include <zlib.h>
+#endif
+#ifdef HAS_LZMA
+#include <lzma.h>
+#endif
+#ifdef HAS_LZ4
+#include <lz4.h>
+#endif
+#ifdef HAS_ZSTD
+#include <zstd.h>
+#endif
+
+namespace FEX::RootFSImage {
+namespace {
+  constexpr uint32_t SQUASHFS_MAGIC = 0x73717368;
+
+  enum Compressor : uint16_t {
+    COMPRESSOR_GZIP = 1,
+    COMPRESSOR_LZMA = 2,
+    COMPRESSOR_LZO = 3,
+    COMPRESSOR_XZ = 4,
+    COMPRESSOR_LZ4 = 5,
+    COMPRESSOR_ZSTD = 6,
+  };
+
+  enum InodeType : uint16_t {
+    INODE_DIR = 1,
+    INODE_FILE,
+    INODE_SYMLINK,
+    INODE_BLKDEV,
+    INODE_CHRDEV,
+    INODE_FIFO,
+    INODE_SOCKET,
+    INODE_LDIR,
+    INODE_LFILE,
+    INODE_LSYMLINK,
+    INODE_LBLKDEV,
+    INODE_LCHRDEV,
+    INODE_LFIFO,
+    INODE_LSOCKET,
+  };
+
+  struct Superblock {
+    uint32_t Magic;
+    uint32_t InodeCount;
+    uint32_t MTime;
+    uint32_t BlockSize;
+    uint32_t FragmentCount;
+    uint16_t Compressor;
+    uint16_t BlockLog;
+    uint16_t Flags;
+    uint16_t IDCount;
+    uint16_t VersionMajor;
+    uint16_t VersionMinor;
+    uint64_t RootInode;
+    uint64_t BytesUsed;
+    uint64_t IDTableStart;
+    uint64_t XattrTableStart;
+    uint64_t InodeTableStart;
+    uint64_t DirectoryTableStart;
+    uint64_t FragmentTableStart;
+    uint64_t ExportTableStart;
+  };
+  static_assert(sizeof(Superblock) == 96);
+
+  struct InodeHeader {
+    uint16_t Type;
+    uint16_t Mode;
+    uint16_t UIDIndex;
+    uint16_t GIDIndex;
+    uint32_t MTime;
+    uint32_t Number;
+  };
+
+  struct DirectoryHeader {
+    uint32_t Count;
+    uint32_t StartBlock;
+    uint32_t InodeNumber;
+  };
+
+  struct DirectoryEntry {
+    uint16_t Offset;
+    int16_t InodeOffset;
+    uint16_t Type;
+    uint16_t NameSize;
+  };
+
+  struct DirectoryIndex {
+    uint32_t Index;
+    uint32_t StartBlock;
+    uint32_t NameSize;
+  };
+
+  constexpr uint32_t METADATA_SIZE = 8192;
+  constexpr uint16_t METADATA_UNCOMPRESSED = 1U << 15;
+  constexpr size_t IDS_PER_BLOCK = METADATA_SIZE / sizeof(uint32_t);
+
+  // Position in the metadata tables, advanced by reads
+  struct MetadataCursor {
+    uint64_t Block;
+    uint32_t Offset;
+  };
+
+  // Format specific inode fields needed after the lookup
+  struct InodeData {
+    uint64_t StartBlock;
+    uint32_t Offset;
+    uint32_t IndexCount;
+    // Directly after the fixed part of the inode
+    MetadataCursor Tail;
+  };
+
+  class SquashFSImage final : public Image {
+    public:
+      SquashFSImage(int FD, uint8_t const *Data, size_t DataSize, std::string const &MountPath)
+        : Image(FD, Data, DataSize, MountPath) {}
+
+    protected:
+      bool Initialize() override;
+      bool GetRoot(Inode *Result) override;
+      LookupStatus FindEntry(Inode const &Dir, std::string_view Name, Inode *Result) override;
+      bool ReadSymlinkTarget(Inode const &Node, std::string *Target) override;
+      uint32_t GetBlockSize() const override { return SB.BlockSize; }
+
+    private:
+      bool Decompress(uint8_t const *Src, size_t SrcSize, std::vector<uint8_t> *Dst);
+      BlockCache::Block ReadMetadataBlock(uint64_t Offset, uint64_t *Next);
+      bool ReadMetadata(MetadataCursor &Cursor, void *Dst, size_t Size);
+      bool ReadInode(uint64_t Ref, Inode *Result, InodeData *Extra);
+
+      Superblock SB;
+      std::vector<uint32_t> IDs;
+  };
+
+  bool SquashFSImage::Initialize() {
+    if (!InBounds(0, sizeof(Superblock))) {
+      return false;
+    }
+    memcpy(&SB, Data, sizeof(SB));
+
+    if (SB.Magic != SQUASHFS_MAGIC ||
+        SB.VersionMajor != 4 ||
+        SB.BlockLog < 12 || SB.BlockLog > 20 ||
+        SB.BlockSize != (1U << SB.BlockLog) ||
+        SB.BytesUsed > DataSize) {
+      return false;
+    }
+
+    switch (SB.Compressor) {
+#ifdef HAS_ZLIB
+      case COMPRESSOR_GZIP:
+#endif
+#ifdef HAS_LZMA
+      case COMPRESSOR_XZ:
+#endif
+#ifdef HAS_LZ4
+      case COMPRESSOR_LZ4:
+#endif
+#ifdef HAS_ZSTD
+      case COMPRESSOR_ZSTD:
+#endif
+        break;
+      default:
+        LogMan::Msg::DFmt("SquashFS compressor {} isn't supported", SB.Compressor);
+        return false;
+    }
+
+    // The ID table is small, keep it decoded
+    IDs.resize(SB.IDCount);
+    for (size_t i = 0; i < SB.IDCount; i += IDS_PER_BLOCK) {
+      uint64_t BlockPointer;
+      const uint64_t PointerOffset = SB.IDTableStart + i / IDS_PER_BLOCK * sizeof(uint64_t);
+      if (!InBounds(PointerOffset, sizeof(BlockPointer))) {
+        return false;
+      }
+      memcpy(&BlockPointer, Data + PointerOffset, sizeof(BlockPointer));
+
+      MetadataCursor Cursor {BlockPointer, 0};
+      const size_t Count = std::min(IDS_PER_BLOCK, SB.IDCount - i);
+      if (!ReadMetadata(Cursor, &IDs[i], Count * sizeof(uint32_t))) {
+        return false;
+      }
+    }
+
+    Inode Root;
+    return GetRoot(&Root) && S_ISDIR(Root.Mode);
+  }
+
+  bool SquashFSImage::Decompress(uint8_t const *Src, size_t SrcSize, std::vector<uint8_t> *Dst) {
+    size_t Size = Dst->size();
+    switch (SB.Compressor) {
+#ifdef HAS_ZLIB
+      case COMPRESSOR_GZIP: {
+        uLongf DstSize = Size;
+        if (uncompress(Dst->data(), &DstSize, Src, SrcSize) != Z_OK) {
+          return false;
+        }
+        Size = DstSize;
+        break;
+      }
+#endif
+#ifdef HAS_LZMA
+      case COMPRESSOR_XZ: {
+        uint64_t MemLimit = UINT64_MAX;
+        size_t InPos{}, OutPos{};
+        if (lzma_stream_buffer_decode(&MemLimit, 0, nullptr, Src, &InPos, SrcSize, Dst->data(), &OutPos, Size) != LZMA_OK) {
+          return false;
+        }
+        Size = OutPos;
+        break;
+      }
+#endif
+#ifdef HAS_LZ4
+      case COMPRESSOR_LZ4: {
+        int Result = LZ4_decompress_safe(reinterpret_cast<char const*>(Src), reinterpret_cast<char*>(Dst->data()), SrcSize, Size);
+        if (Result < 0) {
+          return false;
+        }
+        Size = Result;
+        break;
+      }
+#endif
+#ifdef HAS_ZSTD
+      case COMPRESSOR_ZSTD: {
+        size_t Result = ZSTD_decompress(Dst->data(), Size, Src, SrcSize);
+        if (ZSTD_isError(Result)) {
+          return false;
+        }
+        Size = Result;
+        break;
+      }
+#endif
+      default:
+        return false;
+    }
+
+    Dst->resize(Size);
+    return true;
+  }
+
+  BlockCache::Block SquashFSImage::ReadMetadataBlock(uint64_t Offset, uint64_t *Next) {
+    uint16_t Header;
+    if (!InBounds(Offset, sizeof(Header))) {
+      return {};
+    }
+    memcpy(&Header, Data + Offset, sizeof(Header));
+
+    const uint32_t DiskSize = Header & ~METADATA_UNCOMPRESSED;
+    const uint64_t Start = Offset + sizeof(Header);
+    if (DiskSize > METADATA_SIZE || !InBounds(Start, DiskSize)) {
+      return {};
+    }
+    *Next = Start + DiskSize;
+
+    if (auto Block = Cache.Find(Offset)) {
+      return Block;
+    }
+
+    auto Block = std::make_shared<std::vector<uint8_t>>();
+    if (Header & METADATA_UNCOMPRESSED) {
+      Block->assign(Data + Start, Data + Start + DiskSize);
+    }
+    else {
+      Block->resize(METADATA_SIZE);
+      if (!Decompress(Data + Start, DiskSize, Block.get())) {
+        return {};
+      }
+    }
+
+    Cache.Insert(Offset, Block);
+    return Block;
+  }
+
+  bool SquashFSImage::ReadMetadata(MetadataCursor &Cursor, void *Dst, size_t Size) {
+    auto Out = reinterpret_cast<uint8_t*>(Dst);
+    while (Size > 0) {
+      uint64_t Next;
+      auto Block = ReadMetadataBlock(Cursor.Block, &Next);
+      if (!Block || Cursor.Offset > Block->size()) {
+        return false;
+      }
+
+      const size_t Available = Block->size() - Cursor.Offset;
+      const size_t Copy = std::min(Available, Size);
+      memcpy(Out, Block->data() + Cursor.Offset, Copy);
+      Out += Copy;
+      Size -= Copy;
+      Cursor.Offset += Copy;
+
+      if (Cursor.Offset == Block->size()) {
+        // Continues in the next block
+        Cursor.Block = Next;
+        Cursor.Offset = 0;
+      }
+    }
+    return true;
+  }
+
+  bool SquashFSImage::ReadInode(uint64_t Ref, Inode *Result, InodeData *Extra) {
+    MetadataCursor Cursor {SB.InodeTableStart + (Ref >> 16), static_cast<uint32_t>(Ref & 0xFFFF)};
+
+    InodeHeader Header;
+    if (!ReadMetadata(Cursor, &Header, sizeof(Header)) ||
+        Header.UIDIndex >= IDs.size() || Header.GIDIndex >= IDs.size()) {
+      return false;
+    }
+
+    *Result = Inode {
+      .Ref = Ref,
+      .Number = Header.Number,
+      .Mode = Header.Mode & 07777u,
+      .UID = IDs[Header.UIDIndex],
+      .GID = IDs[Header.GIDIndex],
+      .NLink = 1,
+      .MTime = Header.MTime,
+    };
+    *Extra = InodeData {};
+
+    switch (Header.Type) {
+      case INODE_DIR: {
+        struct {
+          uint32_t StartBlock;
+          uint32_t NLink;
+          uint16_t FileSize;
+          uint16_t Offset;
+          uint32_t Parent;
+        } Dir;
+        if (!ReadMetadata(Cursor, &Dir, sizeof(Dir))) {
+          return false;
+        }
+        Result->Mode |= S_IFDIR;
+        Result->NLink = Dir.NLink;
+        Result->Size = Dir.FileSize;
+        Extra->StartBlock = Dir.StartBlock;
+        Extra->Offset = Dir.Offset;
+        break;
+      }
+      case INODE_LDIR: {
+        struct {
+          uint32_t NLink;
+          uint32_t FileSize;
+          uint32_t StartBlock;
+          uint32_t Parent;
+          uint16_t IndexCount;
+          uint16_t Offset;
+          uint32_t Xattr;
+        } Dir;
+        if (!ReadMetadata(Cursor, &Dir, sizeof(Dir))) {
+          return false;
+        }
+        Result->Mode |= S_IFDIR;
+        Result->NLink = Dir.NLink;
+        Result->Size = Dir.FileSize;
+        Extra->StartBlock = Dir.StartBlock;
+        Extra->Offset = Dir.Offset;
+        Extra->IndexCount = Dir.IndexCount;
+        break;
+      }
+      case INODE_FILE: {
+        struct {
+          uint32_t StartBlock;
+          uint32_t Fragment;
+          uint32_t Offset;
+          uint32_t FileSize;
+        } File;
+        if (!ReadMetadata(Cursor, &File, sizeof(File))) {
+          return false;
+        }
+        Result->Mode |= S_IFREG;
+        Result->Size = File.FileSize;
+        Extra->StartBlock = File.StartBlock;
+        Extra->Offset = File.Offset;
+        break;
+      }
+      case INODE_LFILE: {
+        struct {
+          uint64_t StartBlock;
+          uint64_t FileSize;
+          uint64_t Sparse;
+          uint32_t NLink;
+          uint32_t Fragment;
+          uint32_t Offset;
+          uint32_t Xattr;
+        } File;
+        if (!ReadMetadata(Cursor, &File, sizeof(File))) {
+          return false;
+        }
+        Result->Mode |= S_IFREG;
+        Result->NLink = File.NLink;
+        Result->Size = File.FileSize;
+        Extra->StartBlock = File.StartBlock;
+        Extra->Offset = File.Offset;
+        break;
+      }
+      case INODE_SYMLINK:
+      case INODE_LSYMLINK: {
+        struct {
+          uint32_t NLink;
+          uint32_t TargetSize;
+        } Symlink;
+        if (!ReadMetadata(Cursor, &Symlink, sizeof(Symlink))) {
+          return false;
+        }
+        Result->Mode |= S_IFLNK;
+        Result->NLink = Symlink.NLink;
+        Result->Size = Symlink.TargetSize;
+        break;
+      }
+      case INODE_BLKDEV:
+      case INODE_CHRDEV:
+      case INODE_LBLKDEV:
+      case INODE_LCHRDEV: {
+        struct {
+          uint32_t NLink;
+          uint32_t RDev;
+        } Device;
+        if (!ReadMetadata(Cursor, &Device, sizeof(Device))) {
+          return false;
+        }
+        const bool Block = Header.Type == INODE_BLKDEV || Header.Type == INODE_LBLKDEV;
+        Result->Mode |= Block ? S_IFBLK : S_IFCHR;
+        Result->NLink = Device.NLink;
+        // Stored in the kernel's new_encode_dev format
+        Result->RDev = makedev((Device.RDev & 0xfff00) >> 8, (Device.RDev & 0xff) | ((Device.RDev >> 12) & 0xfff00));
+        break;
+      }
+      case INODE_FIFO:
+      case INODE_SOCKET:
+      case INODE_LFIFO:
+      case INODE_LSOCKET: {
+        uint32_t NLink;
+        if (!ReadMetadata(Cursor, &NLink, sizeof(NLink))) {
+          return false;
+        }
+        const bool FIFO = Header.Type == INODE_FIFO || Header.Type == INODE_LFIFO;
+        Result->Mode |= FIFO ? S_IFIFO : S_IFSOCK;
+        Result->NLink = NLink;
+        break;
+      }
+      default:
+        return false;
+    }
+
+    Extra->Tail = Cursor;
+    return true;
+  }
+
+  bool SquashFSImage::GetRoot(Inode *Result) {
+    InodeData Extra;
+    return ReadInode(SB.RootInode, Result, &Extra);
+  }
+
+  LookupStatus SquashFSImage::FindEntry(Inode const &Dir, std::string_view Name, Inode *Result) {
+    Inode Node;
+    InodeData Extra;
+    if (!ReadInode(Dir.Ref, &Node, &Extra)) {
+      return LookupStatus::Unsupported;
+    }
+
+    // The size includes the implicit . and .. entries
+    if (Node.Size <= 3) {
+      return LookupStatus::NotFound;
+    }
+    const uint64_t ListingSize = Node.Size - 3;
+
+    MetadataCursor Cursor {SB.DirectoryTableStart + Extra.StartBlock, Extra.Offset};
+    uint64_t Consumed{};
+
+    // Large directories have an index of the first name in each metadata block, skip to the last one before the name
+    MetadataCursor IndexCursor = Extra.Tail;
+    for (uint32_t i = 0; i < Extra.IndexCount; ++i) {
+      DirectoryIndex Index;
+      char IndexName[256];
+      if (!ReadMetadata(IndexCursor, &Index, sizeof(Index)) ||
+          Index.NameSize >= sizeof(IndexName) ||
+          !ReadMetadata(IndexCursor, IndexName, Index.NameSize + 1)) {
+        return LookupStatus::Unsupported;
+      }
+
+      if (std::string_view(IndexName, Index.NameSize + 1) > Name) {
+        break;
+      }
+
+      Cursor.Block = SB.DirectoryTableStart + Index.StartBlock;
+      Cursor.Offset = (Extra.Offset + Index.Index) % METADATA_SIZE;
+      Consumed = Index.Index;
+    }
+
+    while (Consumed < ListingSize) {
+      DirectoryHeader Header;
+      if (!ReadMetadata(Cursor, &Header, sizeof(Header)) || Header.Count >= 256) {
+        return LookupStatus::Unsupported;
+      }
+      Consumed += sizeof(Header);
+
+      for (uint32_t i = 0; i <= Header.Count; ++i) {
+        DirectoryEntry Entry;
+        char EntryName[256];
+        if (!ReadMetadata(Cursor, &Entry, sizeof(Entry)) ||
+            Entry.NameSize >= sizeof(EntryName) ||
+            !ReadMetadata(Cursor, EntryName, Entry.NameSize + 1)) {
+          return LookupStatus::Unsupported;
+        }
+        Consumed += sizeof(Entry) + Entry.NameSize + 1;
+
+        const int Compare = std::string_view(EntryName, Entry.NameSize + 1).compare(Name);
+        if (Compare == 0) {
+          const uint64_t Ref = (uint64_t(Header.StartBlock) << 16) | Entry.Offset;
+          return ReadInode(Ref, Result, &Extra) ? LookupStatus::Found : LookupStatus::Unsupported;
+        }
+        else if (Compare > 0) {
+          // Entries are sorted
+          return LookupStatus::NotFound;
+        }
+      }
+    }
+
+    return LookupStatus::NotFound;
+  }
+
+  bool SquashFSImage::ReadSymlinkTarget(Inode const &Node, std::string *Target) {
+    Inode Symlink;
+    InodeData Extra;
+    if (!ReadInode(Node.Ref, &Symlink, &Extra) || !S_ISLNK(Symlink.Mode) || Symlink.Size >= PATH_MAX) {
+      return false;
+    }
+
+    Target->resize(Symlink.Size);
+    return ReadMetadata(Extra.Tail, Target->data(), Symlink.Size);
+  }
+}
+
+  std::unique_ptr<Image> OpenSquashFS(int FD, uint8_t const *Data, size_t DataSize, std::string const &MountPath) {
+    return std::make_unique<SquashFSImage>(FD, Data, DataSize, MountPath);
+  }
+}
@@ -8,6 +8,7 @@ $end_info$
 #include <FEXCore/Core/Context.h>
 #include <FEXCore/Debug/InternalThreadState.h>
 #include "Tests/LinuxSyscalls/SignalDelegator.h"
+#include "Tests/LinuxSyscalls/Syscalls.h"
 
 #include <FEXCore/Core/CoreState.h>
 #include <FEXCore/Core/SignalDelegator.h>
@@ -93,6 +94,9 @@ namespace FEX::HLE {
     // Remove the pending signal
     ThreadData.PendingSignals &= ~(1ULL << (Signal - 1));
 
+    // Setting up the guest frame writes to guest memory, which must not fault on a TSO tracking window
+    FEX::HLE::_SyscallHandler->TSOTrackingDisarm();
+
     // We have an emulation thread pointer, we can now modify its state
     if (Handler.GuestAction.sigaction_handler.handler == SIG_DFL) {
       if (Handler.DefaultBehaviour == DEFAULT_TERM ||
@@ -6,6 +6,7 @@ desc: Glue logic, brk allocations
 $end_info$
 */
 
+#include "Common/FEXServerClient.h"
 #include "Linux/Utils/ELFContainer.h"
 #include "Linux/Utils/ELFParser.h"
 
@@ -306,6 +307,9 @@ uint64_t ExecveHandler(const char *pathname, char* const* argv, char* const* env
   // Kernel does its own checks for file format support for this
   // We can only call execve directly if we both have an interpreter installed AND were ran with the interpreter
   // If the user ran FEX through FEXLoader then we must go down the emulated path
+  // Anything still queued for logging is lost once the process image is replaced
+  FEXServerClient::FlushAsyncLogging();
+
   uint64_t Result{};
   if (FEX::HLE::_SyscallHandler->IsInterpreterInstalled() &&
       FEX::HLE::_SyscallHandler->IsInterpreter() &&
@@ -607,7 +611,7 @@ uint64_t CloneHandler(FEXCore::Core::CpuStateFrame *Frame, FEX::HLE::clone3_args
   };
 
   if (flags & CLONE_VM) {
-    MarkMemoryShared(Frame->Thread->CTX);
+    FEX::HLE::_SyscallHandler->MarkMemorySharedByThreads();
   }
 
   // If there are flags that can't be handled regularly then we need to hand off to the true clone handler
@@ -764,12 +768,14 @@ SyscallHandler::SyscallHandler(FEXCore::Context::Context *_CTX, FEX::HLE::Signal
   GuestKernelVersion = CalculateGuestKernelVersion();
   Alloc32Handler = FEX::HLE::Create32BitAllocator();
 
-  if (SMCChecks == FEXCore::Config::CONFIG_SMC_MTRACK) {
+  if (SMCChecks == FEXCore::Config::CONFIG_SMC_MTRACK || TSOPageTracking()) {
     SignalDelegation->RegisterHostSignalHandler(SIGSEGV, HandleSegfault, true);
   }
 }
 
 SyscallHandler::~SyscallHandler() {
+  TSOTrackingShutdown();
+
   FEXCore::Allocator::munmap(reinterpret_cast<void*>(DataSpace), DataSpaceMaxSize);
 }
 
@@ -803,6 +809,15 @@ uint64_t SyscallHandler::HandleSyscall(FEXCore::Core::CpuStateFrame *Frame, FEXC
   }
 
   auto &Def = Definitions[Args->Argument[0]];
+
+  // Syscalls that don't return would never leave the in-syscall count
+  const bool TSOTrackSyscall = TSOPageTracking() &&
+    Def.NumArgs != 255 &&
+    (Def.Flags & FEXCore::IR::SyscallFlags::NORETURN) != FEXCore::IR::SyscallFlags::NORETURN;
+  if (TSOTrackSyscall) {
+    TSOTrackingHostCallEnter();
+  }
+
   uint64_t Result{};
   switch (Def.NumArgs) {
   case 0: Result = std::invoke(Def.Ptr0, Frame); break;
@@ -819,6 +834,10 @@ uint64_t SyscallHandler::HandleSyscall(FEXCore::Core::CpuStateFrame *Frame, FEXC
     return -1;
   break;
   }
+
+  if (TSOTrackSyscall) {
+    TSOTrackingHostCallExit();
+  }
 #ifdef DEBUG_STRACE
   Strace(Args, Result);
 #endif
@@ -828,6 +847,15 @@ uint64_t SyscallHandler::HandleSyscall(FEXCore::Core::CpuStateFrame *Frame, FEXC
 #ifdef DEBUG_STRACE
 void SyscallHandler::Strace(FEXCore::HLE::SyscallArguments *Args, uint64_t Ret) {
   auto &Def = Definitions[Args->Argument[0]];
+  if (FEXServerClient::IsAsyncLoggingActive() && Def.NumArgs <= 6) {
+    // Leave formatting to FEXServer, this keeps tracing cheap enough to leave on
+    uint64_t TraceArgs[7];
+    memcpy(TraceArgs, &Args->Argument[1], Def.NumArgs * sizeof(uint64_t));
+    TraceArgs[Def.NumArgs] = Ret;
+    FEXServerClient::AsyncFormattedMsg(LogMan::DEBUG, Def.StraceFmt.c_str(), TraceArgs, Def.NumArgs + 1);
+    return;
+  }
+
   switch (Def.NumArgs) {
     case 0: LogMan::Msg::D(Def.StraceFmt.c_str(), Ret); break;
     case 1: LogMan::Msg::D(Def.StraceFmt.c_str(), Args->Argument[1], Ret); break;
@@ -9,13 +9,16 @@ $end_info$
 
 #include "Tests/LinuxSyscalls/FileManagement.h"
 #include "Tests/LinuxSyscalls/LinuxAllocator.h"
+#include "Tests/LinuxSyscalls/VMAMap.h"
 
 #include <FEXCore/Config/Config.h>
 #include <FEXCore/HLE/SyscallHandler.h>
 #include <FEXCore/HLE/SourcecodeResolver.h>
 #include <FEXCore/IR/IR.h>
 #include <FEXCore/Utils/CompilerDefs.h>
+#include <FEXCore/Utils/Threads.h>
 
+#include <atomic>
 #include <mutex>
 #include <shared_mutex>
 
@@ -26,6 +29,9 @@ $end_info$
 #include <vector>
 #include <list>
 #include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
 #ifdef _M_X86_64
 #define SYSCALL_ARCH_NAME x64
 #elif _M_ARM_64
@@ -133,7 +139,8 @@ public:
 
   FEXCore::HLE::SyscallABI GetSyscallABI(uint64_t Syscall) override {
     auto &Def = Definitions.at(Syscall);
-    return {Def.NumArgs, true, Def.HostSyscallNumber};
+    // TSO page tracking needs to see every syscall, inline syscalls would bypass it
+    return {Def.NumArgs, true, TSOPageTracking() ? -1 : Def.HostSyscallNumber};
   }
 
   FEXCore::IR::SyscallFlags  GetSyscallFlags(uint64_t Syscall) const override {
@@ -172,7 +179,12 @@ public:
   FEX_CONFIG_OPT(RootFSPath, ROOTFS);
   FEX_CONFIG_OPT(ThreadsConfig, THREADS);
   FEX_CONFIG_OPT(Is64BitMode, IS64BIT_MODE);
+  FEX_CONFIG_OPT(Multiblock, MULTIBLOCK);
+  FEX_CONFIG_OPT(MultiblockFunctions, MULTIBLOCKFUNCTIONS);
   FEX_CONFIG_OPT(SMCChecks, SMCCHECKS);
+  FEX_CONFIG_OPT(SMCThrashThreshold, SMCTHRASHTHRESHOLD);
+  FEX_CONFIG_OPT(TSOPageTracking, TSOPAGETRACKING);
+  FEX_CONFIG_OPT(TSOPageTrackingInterval, TSOPAGETRACKINGINTERVAL);
 
   uint32_t GetHostKernelVersion() const { return HostKernelVersion; }
   uint32_t GetGuestKernelVersion() const { return GuestKernelVersion; }
@@ -215,6 +227,39 @@ public:
   // AOTIRCacheEntryLookupResult also includes a shared lock guard, so the pointed AOTIRCacheEntry return can be safely used
   FEXCore::HLE::AOTIRCacheEntryLookupResult LookupAOTIRCacheEntry(uint64_t GuestAddr) final override;
 
+  ///// SMC thrash tracking /////
+  // Drops fault counters of unmapped pages and lets them be write protected again
+  void SMCThrashForgetRange(uint64_t Base, uint64_t Size);
+
+  struct SMCThrash {
+    // Held while reading/writing this struct.
+    // Lock order is VMATracking.Mutex then SMCThrash.Mutex
+    std::mutex Mutex;
+
+    // Number of write faults to data next to code, indexed by page aligned address
+    std::unordered_map<uint64_t, uint32_t> PageFaults;
+  } SMCThrash;
+
+  // Held around write protecting guest code pages and around stores the fault handler performs on them,
+  // so a page isn't protected again while such a store is in flight.
+  // Lock order is VMATracking.Mutex then SMCProtectMutex
+  std::mutex SMCProtectMutex;
+
+  ///// TSO page tracking /////
+  // Called around every syscall and thunk call, closes the sampling window so the kernel never accesses a watched page
+  void TSOTrackingHostCallEnter();
+  void TSOTrackingHostCallExit();
+  void ThunkCallEnter() override { TSOTrackingHostCallEnter(); }
+  void ThunkCallExit() override { TSOTrackingHostCallExit(); }
+  // Called when a thread exits. The kernel writes to its robust list and clear_child_tid once the host thread is gone,
+  // so windows stay closed until then.
+  void TSOTrackingThreadExit(uint32_t TID);
+  // Closes the sampling window, signal safe
+  void TSOTrackingDisarm();
+  // Called when a thread sharing the address space is created.
+  // Falls back to process-wide TSO unless TSO page tracking is enabled.
+  void MarkMemorySharedByThreads();
+
   ///// FORK tracking /////
   void LockBeforeFork();
   void UnlockAfterFork();
@@ -327,7 +372,8 @@ private:
     std::shared_mutex Mutex;
     
     // Memory ranges indexed by page aligned starting address
-    std::map<uint64_t, VMAEntry> VMAs;
+    // Insertions and erasures invalidate iterators, see VMAMap
+    VMAMap<VMAEntry> VMAs;
 
     using VMACIterator = decltype(VMAs)::const_iterator;
 
@@ -355,6 +401,92 @@ private:
     void ListPrepend(MappedResource *Resource, VMAEntry *NewVMA);
     static void ListCheckVMALinks(VMAEntry *VMA);
   } VMATracking;
+
+  ///// TSO page tracking /////
+  // Everything the fault handler calls is signal safe, it only uses the preallocated state below
+  static bool HandleTSOTrackingFault(FEXCore::Core::InternalThreadState *Thread, uint64_t FaultAddress, void *ucontext);
+  static void *TSOTrackingSamplerThread(void *Arg);
+  // Mappings that windows protect
+  static bool TSOTrackingIsSampled(const VMAEntry &VMA);
+  // TSOTracking.Mutex must be locked before calling
+  void TSOTrackingArmUnsafe();
+  void TSOTrackingDisarmUnsafe();
+  // Drops sampled state of unmapped pages
+  void TSOTrackingForgetRange(uint64_t Base, uint64_t Size);
+  // Stops the sampler thread and closes the window
+  void TSOTrackingShutdown();
+  // Signal safe
+  void TSOTrackingWakeSampler();
+
+  struct TSOTrackingPage;
+  // Returns nullptr once the table is full
+  TSOTrackingPage *TSOTrackingFindPage(uint64_t Page, bool Insert);
+  // Hands a block to the sampler thread, which marks it as requiring TSO
+  void TSOTrackingQueuePromotion(uint64_t Block);
+  // Sampler thread only
+  void TSOTrackingPromoteQueued();
+
+  struct TSOTrackingPage {
+    // Guest blocks remembered per private page, further blocks get TSO right away
+    constexpr static size_t MaxBlocks = 6;
+
+    // Page aligned address, 0 for a free slot.
+    // Slots are never freed, forgetting a page only resets its state.
+    std::atomic<uint64_t> Page;
+    // First thread to touch the page, 0 if none did yet
+    std::atomic<uint32_t> OwnerTID;
+    std::atomic_bool Shared;
+    // Guest entries of the blocks that touched the page while it was private, 0 for a free slot
+    std::atomic<uint64_t> Blocks[MaxBlocks];
+  };
+
+  struct TSOTracking {
+    // Sampled pages, every block touching a page that doesn't fit gets TSO right away
+    constexpr static size_t MaxPages = 1U << 16;
+    constexpr static size_t MaxPageProbes = 32;
+    constexpr static size_t PromoteQueueSize = 1024;
+
+    // Held by the sampler thread and while closing windows, never by the fault handler.
+    // Lock order is VMATracking.Mutex then TSOTracking.Mutex
+    std::mutex Mutex;
+
+    // Open addressed table of MaxPages entries, allocated when the sampler thread starts.
+    // Written by the fault handler without locks.
+    TSOTrackingPage *Pages{};
+
+    // Protected ranges of the current sampling window, {Base, Top}.
+    // Reserved before arming, so closing a window from a signal handler doesn't allocate or free.
+    std::vector<std::pair<uint64_t, uint64_t>> ArmedRanges;
+
+    // Blocks that need TSO, written by fault handlers and read by the sampler thread.
+    // A slot is 0 until its writer stored the block.
+    std::atomic<uint64_t> PromoteQueue[PromoteQueueSize]{};
+    std::atomic<uint64_t> PromoteWrite{};
+    std::atomic<uint64_t> PromoteRead{};
+    // Set when the queue was full. Dropped blocks can't be recovered, the sampler falls back to process-wide TSO.
+    std::atomic_bool PromoteOverflow{};
+    // Futex the sampler thread waits on between windows, bumped to wake it up early
+    std::atomic<uint32_t> SamplerWake{};
+
+    // Threads that called exit and might still be running on the host
+    std::vector<uint32_t> ExitingTIDs;
+
+    // Number of threads currently inside of a syscall or thunk, sampling windows aren't opened while non-zero
+    std::atomic<uint32_t> ThreadsInHostCalls{};
+    std::atomic_bool Armed{};
+    std::atomic_bool ShuttingDown{};
+
+    std::unique_ptr<FEXCore::Threads::Thread> SamplerThread;
+  } TSOTracking;
+
+  ///// MultiblockFunctions /////
+  // Registers the functions of an executable ELF file mapping
+  void AddMappedFunctionRanges(uintptr_t Base, uintptr_t Size, int fd, off_t Offset, std::string const &FileIdentity);
+
+  struct FileFunctionRanges;
+  std::mutex FileFunctionRangesMutex;
+  // Keyed on the file identity, each file is parsed once however often it gets mapped
+  std::unordered_map<std::string, std::shared_ptr<const FileFunctionRanges>> FileFunctionRangesCache;
 };
 
 uint64_t HandleSyscall(SyscallHandler *Handler, FEXCore::Core::CpuStateFrame *Frame, FEXCore::HLE::SyscallArguments *Args);
@@ -4,6 +4,7 @@ tags: LinuxSyscalls|syscalls-shared
 $end_info$
 */
 
+#include "Common/FEXServerClient.h"
 #include "FEXCore/IR/IR.h"
 #include "Tests/LinuxSyscalls/Syscalls.h"
 #include "Tests/LinuxSyscalls/Syscalls/Thread.h"
@@ -139,6 +140,8 @@ namespace FEX::HLE {
       // Clear all the other threads that are being tracked
       // Frame->Thread is /ONLY/ safe to access when CLONE_THREAD flag is not set
       FEXCore::Context::CleanupAfterFork(CTX, Frame->Thread);
+      FEXServerClient::CleanupAsyncLoggingAfterFork();
+      FEXServerClient::CleanupCodeCacheConnectionAfterFork();
 
       Thread->CurrentFrame->State.gregs[FEXCore::X86State::REG_RAX] = 0;
       Thread->CurrentFrame->State.gregs[FEXCore::X86State::REG_RBX] = 0;
@@ -210,6 +213,8 @@ namespace FEX::HLE {
 
       // Clear all the other threads that are being tracked
       FEXCore::Context::CleanupAfterFork(Thread->CTX, Frame->Thread);
+      FEXServerClient::CleanupAsyncLoggingAfterFork();
+      FEXServerClient::CleanupCodeCacheConnectionAfterFork();
 
       // only a  single thread running so no need to remove anything from the thread array
 
@@ -260,6 +265,17 @@ namespace FEX::HLE {
     }
   }
 
+  void BeforeFutexWait(FEXCore::Core::CpuStateFrame *Frame, int futex_op) {
+    const int cmd = futex_op & FUTEX_CMD_MASK;
+    if (cmd == FUTEX_WAIT ||
+        cmd == FUTEX_LOCK_PI ||
+        cmd == FUTEX_WAIT_BITSET ||
+        cmd == FUTEX_WAIT_REQUEUE_PI) {
+      // Only does work if the thread compiled something since it last released
+      FEXCore::Context::ReleaseCompileMemory(Frame->Thread);
+    }
+  }
+
   void RegisterThread(FEX::HLE::SyscallHandler *Handler) {
     using namespace FEXCore::IR;
 
@@ -287,6 +303,10 @@ namespace FEX::HLE {
     REGISTER_SYSCALL_IMPL_FLAGS(exit, SyscallFlags::OPTIMIZETHROUGH | SyscallFlags::NOSYNCSTATEONENTRY | SyscallFlags::NORETURN,
       [](FEXCore::Core::CpuStateFrame *Frame, int status) -> uint64_t {
       auto Thread = Frame->Thread;
+      // Exit isn't counted as a syscall since it doesn't return.
+      // The kernel accesses guest memory below and through the robust list once the host thread exits.
+      FEX::HLE::_SyscallHandler->TSOTrackingThreadExit(Thread->ThreadManager.GetTID());
+
       if (Thread->ThreadManager.clear_child_tid) {
         std::atomic<uint32_t> *Addr = reinterpret_cast<std::atomic<uint32_t>*>(Thread->ThreadManager.clear_child_tid);
         Addr->store(0);
@@ -564,6 +584,7 @@ namespace FEX::HLE {
     if (Handler->IsHostKernelVersionAtLeast(5, 16, 0)) {
       REGISTER_SYSCALL_IMPL_PASS_FLAGS(futex_waitv, SyscallFlags::OPTIMIZETHROUGH | SyscallFlags::NOSYNCSTATEONENTRY,
         [](FEXCore::Core::CpuStateFrame *Frame, void *waiters, uint32_t nr_futexes, uint32_t flags, struct timespec *timeout, clockid_t clockid) -> uint64_t {
+        FEXCore::Context::ReleaseCompileMemory(Frame->Thread);
         uint64_t Result = ::syscall(SYSCALL_DEF(futex_waitv), waiters, nr_futexes, flags, timeout, clockid);
         SYSCALL_ERRNO();
       });
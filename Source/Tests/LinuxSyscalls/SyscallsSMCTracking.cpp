@@ -7,10 +7,15 @@ $end_info$
 */
 
 #include "Common/FDUtils.h"
+#include "Linux/Utils/ELFContainer.h"
 
+#include <algorithm>
+#include <cstring>
 #include <filesystem>
+#include <fmt/format.h>
 #include <sys/shm.h>
 #include <sys/mman.h>
+#include <unistd.h>
 
 #include "Tests/LinuxSyscalls/Syscalls.h"
 
@@ -44,6 +49,58 @@ auto SyscallHandler::VMAFlags::fromFlags(int Flags) -> VMAFlags {
   };
 }
 
+// Performs a store to a write protected page with its original width and ordering.
+// The page is unprotected only for the duration of the store. Returns false if the store can't be done this way.
+// Raced is set if something else wrote to the page while it was unprotected, that write wasn't seen by SMC tracking
+static bool StoreToProtectedPage(std::mutex &ProtectMutex, uint64_t Addr, void const *Data, size_t Size, bool Release, bool *Raced) {
+  const auto PageBase = FEXCore::AlignDown(Addr, FHU::FEX_PAGE_SIZE);
+  if (Addr + Size > PageBase + FHU::FEX_PAGE_SIZE) {
+    return false;
+  }
+
+  // Keeps MarkGuestExecutableRange from protecting the page again before the store happened
+  FHU::ScopedSignalMaskWithMutex lk(ProtectMutex);
+
+  // Taken while the page is still read only, lives on the signal stack
+  alignas(16) uint8_t Snapshot[FHU::FEX_PAGE_SIZE];
+  memcpy(Snapshot, reinterpret_cast<void const*>(PageBase), FHU::FEX_PAGE_SIZE);
+
+  if (mprotect(reinterpret_cast<void*>(PageBase), FHU::FEX_PAGE_SIZE, PROT_READ | PROT_WRITE) != 0) {
+    return false;
+  }
+
+  const int Order = Release ? __ATOMIC_RELEASE : __ATOMIC_RELAXED;
+  const bool Aligned = (Addr & (Size - 1)) == 0;
+
+  if (Aligned && Size == 1) {
+    __atomic_store_n(reinterpret_cast<uint8_t*>(Addr), *reinterpret_cast<uint8_t const*>(Data), Order);
+  }
+  else if (Aligned && Size == 2) {
+    __atomic_store_n(reinterpret_cast<uint16_t*>(Addr), *reinterpret_cast<uint16_t const*>(Data), Order);
+  }
+  else if (Aligned && Size == 4) {
+    __atomic_store_n(reinterpret_cast<uint32_t*>(Addr), *reinterpret_cast<uint32_t const*>(Data), Order);
+  }
+  else if (Aligned && Size == 8) {
+    __atomic_store_n(reinterpret_cast<uint64_t*>(Addr), *reinterpret_cast<uint64_t const*>(Data), Order);
+  }
+  else {
+    // 128-bit and unaligned stores aren't single-copy atomic as a whole on the host either
+    if (Release) {
+      __atomic_thread_fence(__ATOMIC_RELEASE);
+    }
+    memcpy(reinterpret_cast<void*>(Addr), Data, Size);
+  }
+
+  auto rv = mprotect(reinterpret_cast<void*>(PageBase), FHU::FEX_PAGE_SIZE, PROT_READ);
+  LogMan::Throw::AAFmt(rv == 0, "mprotect({}, {}) failed", PageBase, FHU::FEX_PAGE_SIZE);
+
+  const auto Offset = Addr - PageBase;
+  *Raced = memcmp(Snapshot, reinterpret_cast<void const*>(PageBase), Offset) != 0 ||
+           memcmp(Snapshot + Offset + Size, reinterpret_cast<void const*>(Addr + Size), FHU::FEX_PAGE_SIZE - Offset - Size) != 0;
+  return true;
+}
+
 // SMC interactions
 bool SyscallHandler::HandleSegfault(FEXCore::Core::InternalThreadState *Thread, int Signal, void *info, void *ucontext) {
   auto CTX = Thread->CTX;
@@ -55,6 +112,16 @@ bool SyscallHandler::HandleSegfault(FEXCore::Core::InternalThreadState *Thread,
 
     auto VMATracking = &_SyscallHandler->VMATracking;
 
+    // Write to a page watched by TSO page tracking
+    if (HandleTSOTrackingFault(Thread, FaultAddress, ucontext)) {
+      return true;
+    }
+
+    // Handler is also installed for TSO page tracking only
+    if (_SyscallHandler->SMCChecks != FEXCore::Config::CONFIG_SMC_MTRACK) {
+      return false;
+    }
+
     // If the write spans two pages, they will be flushed one at a time (generating two faults)
     auto Entry = VMATracking->LookupVMAUnsafe(FaultAddress);
 
@@ -89,6 +156,32 @@ bool SyscallHandler::HandleSegfault(FEXCore::Core::InternalThreadState *Thread,
         }
       } while ((VMA = VMA->ResourceNextVMA));
     } else {
+      // Writes that don't touch compiled code are data sharing the page with code.
+      // Those are performed in place where the host store can be emulated, so the code on the page survives.
+      // Once a page thrashed enough, stop protecting it and validate its code on every run instead
+      const auto ThrashThreshold = _SyscallHandler->SMCThrashThreshold();
+      if (ThrashThreshold && !FEXCore::Context::IsGuestCodeInRange(CTX, FaultAddress, 1)) {
+        bool Raced {};
+        const bool Emulated = FEXCore::Context::EmulateFaultingStore(ucontext, [CTX, &Raced](uint64_t Addr, void const *Data, size_t Size, bool Release) {
+          return !FEXCore::Context::IsGuestCodeInRange(CTX, Addr, Size) &&
+                 StoreToProtectedPage(_SyscallHandler->SMCProtectMutex, Addr, Data, Size, Release, &Raced);
+        });
+
+        bool Thrashing{};
+        {
+          FHU::ScopedSignalMaskWithMutex lkThrash(_SyscallHandler->SMCThrash.Mutex);
+          Thrashing = ++_SyscallHandler->SMCThrash.PageFaults[FaultBase] >= ThrashThreshold;
+        }
+
+        if (Thrashing) {
+          FEXCore::Context::MarkGuestCodePageValidated(CTX, FaultBase);
+        }
+        else if (Emulated && !Raced) {
+          return true;
+        }
+        // A racing write may have hit code, the store itself is done and gets stepped over
+      }
+
       FEXCore::Context::InvalidateGuestCodeRange(CTX, FaultBase, FHU::FEX_PAGE_SIZE, [](uintptr_t Start, uintptr_t Length) {
         auto rv = mprotect((void *)Start, Length, PROT_READ | PROT_WRITE);
         LogMan::Throw::AAFmt(rv == 0, "mprotect({}, {}) failed", Start, Length);
@@ -146,21 +239,54 @@ void SyscallHandler::MarkGuestExecutableRange(uint64_t Start, uint64_t Length) {
               const auto MirroredBase = std::max(VMAOffsetBase, OffsetBase);
               const auto MirroredSize = std::min(OffsetTop, VMAOffsetTop) - MirroredBase;
 
+              FHU::ScopedSignalMaskWithMutex lkProtect(SMCProtectMutex);
               auto rv = mprotect((void *)(MirroredBase - VMAOffsetBase + VMABase), MirroredSize, PROT_READ);
               LogMan::Throw::AAFmt(rv == 0, "mprotect({}, {}) failed", MirroredBase, MirroredSize);
             }
           } while ((VMA = VMA->ResourceNextVMA));
 
         } else if (Mapping->second.Prot.Writable) {
-          int rv = mprotect((void *)ProtectBase, ProtectSize, PROT_READ);
-
-          LogMan::Throw::AAFmt(rv == 0, "mprotect({}, {}) failed", ProtectBase, ProtectSize);
+          // Pages that thrashed are left writable, their code is validated instead
+          const auto ProtectTop = ProtectBase + ProtectSize;
+          auto RunBase = ProtectBase;
+
+          for (auto Page = ProtectBase; Page <= ProtectTop; Page += FHU::FEX_PAGE_SIZE) {
+            if (Page == ProtectTop || FEXCore::Context::IsGuestCodePageValidated(CTX, Page)) {
+              if (Page != RunBase) {
+                FHU::ScopedSignalMaskWithMutex lkProtect(SMCProtectMutex);
+                int rv = mprotect((void *)RunBase, Page - RunBase, PROT_READ);
+
+                LogMan::Throw::AAFmt(rv == 0, "mprotect({}, {}) failed", RunBase, Page - RunBase);
+              }
+              RunBase = Page + FHU::FEX_PAGE_SIZE;
+            }
+          }
         }
       }
     }
   }
 }
 
+void SyscallHandler::SMCThrashForgetRange(uint64_t Base, uint64_t Size) {
+  {
+    FHU::ScopedSignalMaskWithMutex lk(SMCThrash.Mutex);
+
+    // Walk whichever is smaller, thrashing pages are rare
+    if (SMCThrash.PageFaults.size() < Size / FHU::FEX_PAGE_SIZE) {
+      std::erase_if(SMCThrash.PageFaults, [Base, Size](auto &Page) {
+        return Page.first >= Base && Page.first < Base + Size;
+      });
+    }
+    else {
+      for (auto Page = Base; Page < Base + Size; Page += FHU::FEX_PAGE_SIZE) {
+        SMCThrash.PageFaults.erase(Page);
+      }
+    }
+  }
+
+  FEXCore::Context::ClearGuestCodePagesValidated(CTX, Base, Size);
+}
+
 // Used for AOT
 FEXCore::HLE::AOTIRCacheEntryLookupResult SyscallHandler::LookupAOTIRCacheEntry(uint64_t GuestAddr) {
   FHU::ScopedSignalMaskWithSharedLock lk(_SyscallHandler->VMATracking.Mutex);
@@ -180,6 +306,65 @@ FEXCore::HLE::AOTIRCacheEntryLookupResult SyscallHandler::LookupAOTIRCacheEntry(
 }
 
 // MMan Tracking
+struct SyscallHandler::FileFunctionRanges {
+  std::vector<ELFLoader::ELFContainer::LoadSegment> Segments;
+  // ELF addresses, sorted by start
+  std::vector<ELFLoader::ELFContainer::RangeType> Ranges;
+};
+
+void SyscallHandler::AddMappedFunctionRanges(uintptr_t Base, uintptr_t Size, int fd, off_t Offset, std::string const &FileIdentity) {
+  std::shared_ptr<const FileFunctionRanges> File;
+  {
+    std::lock_guard lk(FileFunctionRangesMutex);
+    if (auto it = FileFunctionRangesCache.find(FileIdentity); it != FileFunctionRangesCache.end()) {
+      File = it->second;
+    }
+  }
+
+  if (!File) {
+    auto Parsed = std::make_shared<FileFunctionRanges>();
+
+    const auto Type = ELFLoader::ELFContainer::GetELFType(fd);
+    if (Type == ELFLoader::ELFContainer::TYPE_X86_64 || Type == ELFLoader::ELFContainer::TYPE_X86_32) {
+      // Read through the fd, the path it was opened with may point at a different file by now
+      ELFLoader::ELFContainer Container{fmt::format("/proc/self/fd/{}", fd), "", true};
+      if (Container.WasLoaded()) {
+        Parsed->Segments = Container.GetLoadSegments();
+        Parsed->Ranges = Container.GetFunctionRanges({0, ~0ULL});
+      }
+    }
+
+    // Files that aren't x86 ELFs are cached as well, with nothing in them
+    std::lock_guard lk(FileFunctionRangesMutex);
+    File = FileFunctionRangesCache.try_emplace(FileIdentity, std::move(Parsed)).first->second;
+  }
+
+  auto Segment = std::find_if(File->Segments.begin(), File->Segments.end(), [Offset](auto const &Segment) {
+    return static_cast<uint64_t>(Offset) >= Segment.Offset && static_cast<uint64_t>(Offset) < Segment.Offset + Segment.FileSize;
+  });
+  if (Segment == File->Segments.end()) {
+    return;
+  }
+  const uint64_t MappedAddress = Segment->Address + (Offset - Segment->Offset);
+
+  // Symbols and unwind entries are ELF addresses, the mapping puts MappedAddress at Base
+  const uint64_t MappedEnd = MappedAddress + Size;
+  const uint64_t Bias = Base - MappedAddress;
+
+  std::vector<FEXCore::Context::FunctionRange> Ranges;
+  auto it = std::lower_bound(File->Ranges.begin(), File->Ranges.end(), ELFLoader::ELFContainer::RangeType{MappedAddress, 0});
+  for (; it != File->Ranges.end() && it->first < MappedEnd; ++it) {
+    // The file wide ranges can run on past the end of this mapping
+    Ranges.push_back({it->first + Bias, std::min(it->second, MappedEnd) + Bias});
+  }
+
+  LogMan::Msg::DFmt("{}: {} function ranges", FileIdentity, Ranges.size());
+
+  if (!Ranges.empty()) {
+    FEXCore::Context::AddFunctionRanges(CTX, Ranges);
+  }
+}
+
 void SyscallHandler::TrackMmap(uintptr_t Base, uintptr_t Size, int Prot, int Flags, int fd, off_t Offset) {
 	Size = FEXCore::AlignUp(Size, FHU::FEX_PAGE_SIZE);
 
@@ -187,6 +372,10 @@ void SyscallHandler::TrackMmap(uintptr_t Base, uintptr_t Size, int Prot, int Fla
     MarkMemoryShared(CTX);
   }
 
+  // Executable file mappings get a shared code cache, keyed on the file's identity
+  std::string CodeCacheFilename{};
+  std::string CodeCacheIdentity{};
+
   {
     FHU::ScopedSignalMaskWithUniqueLock lk(_SyscallHandler->VMATracking.Mutex);
 
@@ -202,6 +391,12 @@ void SyscallHandler::TrackMmap(uintptr_t Base, uintptr_t Size, int Prot, int Fla
       auto filename = FEX::get_fdpath(fd);
 
       if (filename.has_value()) {
+        if (Prot & PROT_EXEC) {
+          CodeCacheFilename = filename.value();
+          CodeCacheIdentity = fmt::format("{:x}-{:x}-{:x}-{:x}.{:x}",
+            buf.st_dev, buf.st_ino, buf.st_size, buf.st_mtim.tv_sec, buf.st_mtim.tv_nsec);
+        }
+
         auto [Iter, Inserted] = VMATracking.MappedResources.emplace(mrid, MappedResource {nullptr, nullptr, 0});
         Resource = &Iter->second;
 
@@ -222,11 +417,23 @@ void SyscallHandler::TrackMmap(uintptr_t Base, uintptr_t Size, int Prot, int Fla
     }
 
     VMATracking.SetUnsafe(CTX, Resource, Base, Offset, Size, VMAFlags::fromFlags(Flags), VMAProt::fromProt(Prot));
+
+    if (SMCThrashThreshold()) {
+      SMCThrashForgetRange(Base, Size);
+    }
   }
 
   if (SMCChecks != FEXCore::Config::CONFIG_SMC_NONE) {
     FEXCore::Context::InvalidateGuestCodeRange(CTX, (uintptr_t)Base, Size);
   }
+
+  if (!CodeCacheIdentity.empty()) {
+    FEXCore::Context::AddNamedRegion(CTX, Base, Size, Offset, CodeCacheFilename, CodeCacheIdentity);
+
+    if (Multiblock() && MultiblockFunctions()) {
+      AddMappedFunctionRanges(Base, Size, fd, Offset, CodeCacheIdentity);
+    }
+  }
 }
 
 void SyscallHandler::TrackMunmap(uintptr_t Base, uintptr_t Size) {
@@ -236,8 +443,19 @@ void SyscallHandler::TrackMunmap(uintptr_t Base, uintptr_t Size) {
     FHU::ScopedSignalMaskWithUniqueLock lk(_SyscallHandler->VMATracking.Mutex);
 
     VMATracking.ClearUnsafe(CTX, Base, Size);
+
+    if (TSOPageTracking()) {
+      TSOTrackingForgetRange(Base, Size);
+    }
+
+    if (SMCThrashThreshold()) {
+      SMCThrashForgetRange(Base, Size);
+    }
   }
 
+  FEXCore::Context::RemoveNamedRegion(CTX, Base, Size);
+  FEXCore::Context::RemoveFunctionRanges(CTX, Base, Size);
+
   if (SMCChecks != FEXCore::Config::CONFIG_SMC_NONE) {
     FEXCore::Context::InvalidateGuestCodeRange(CTX, (uintptr_t)Base, Size);
   }
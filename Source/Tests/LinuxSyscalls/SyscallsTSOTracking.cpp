@@ -0,0 +1,392 @@
+/*
+$info$
+category: LinuxSyscalls ~ Linux syscall emulation, marshaling and passthrough
+tags: LinuxSyscalls|common
+desc: TSO page tracking
+$end_info$
+*/
+
+#include "Tests/LinuxSyscalls/Syscalls.h"
+
+#include <FEXHeaderUtils/ScopedSignalMask.h>
+#include <FEXHeaderUtils/Syscalls.h>
+#include <FEXHeaderUtils/TypeDefines.h>
+#include <FEXCore/Core/Context.h>
+#include <FEXCore/Debug/InternalThreadState.h>
+#include <FEXCore/Utils/Allocator.h>
+#include <FEXCore/Utils/LogManager.h>
+#include <FEXCore/Utils/MathUtils.h>
+#include <FEXCore/Utils/Threads.h>
+
+#include <bit>
+#include <chrono>
+#include <errno.h>
+#include <linux/futex.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <ucontext.h>
+#include <unistd.h>
+#include <vector>
+
+// TSO page tracking
+//
+// Once a second thread is created, memory is assumed thread-private and code is compiled without TSO.
+// A sampler thread periodically opens a window where every private, writable, non-executable mapping is made inaccessible.
+// Faults during the window record which threads touched each page and the blocks that did it, reads and writes alike.
+// A page touched by two different threads is shared. Every block seen touching it, before or after that point, gets recompiled with TSO.
+// Reads need to be sampled as well, the consumer side of message passing is just as sensitive to ordering as the producer.
+//
+// The fault handler only uses preallocated, lock-free state. It queues blocks that need TSO and the sampler thread recompiles them.
+//
+// The kernel must never access a protected page, it would return EFAULT instead of faulting.
+// Every syscall and thunk call closes the window, and a window is never opened while a thread is inside of one.
+// After a thread exits, the kernel still writes to its robust list, so windows stay closed until the host thread is gone.
+// Inline syscalls are disabled in this mode so that every syscall is seen.
+//
+// This is sampling, so accesses outside of the windows are missed. It trades correctness for performance.
+
+namespace FEX::HLE {
+
+bool SyscallHandler::TSOTrackingIsSampled(const VMAEntry &VMA) {
+  // Shared mappings already cause process-wide TSO.
+  // Executable mappings are left to SMC tracking, which uses the same protection bits.
+  return !VMA.Flags.Shared && VMA.Prot.Writable && !VMA.Prot.Executable;
+}
+
+void SyscallHandler::MarkMemorySharedByThreads() {
+  FEXCore::Context::MarkMemorySharedByThreads(CTX);
+
+  if (!FEXCore::Context::IsTSOPageTrackingActive(CTX)) {
+    return;
+  }
+
+  FHU::ScopedSignalMaskWithMutex lk(TSOTracking.Mutex);
+  if (TSOTracking.SamplerThread) {
+    return;
+  }
+
+  // Zero pages until touched
+  auto Pages = FEXCore::Allocator::mmap(nullptr, sizeof(TSOTrackingPage) * TSOTracking::MaxPages, PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_PRIVATE, -1, 0);
+  LOGMAN_THROW_AA_FMT(Pages != MAP_FAILED, "Couldn't allocate TSO tracking pages");
+  TSOTracking.Pages = reinterpret_cast<TSOTrackingPage*>(Pages);
+
+  // Sampler thread must not receive guest signals
+  uint64_t OldMask = FEXCore::Threads::SetSignalMask(~0ULL);
+  TSOTracking.SamplerThread = FEXCore::Threads::Thread::Create(TSOTrackingSamplerThread, this);
+  FEXCore::Threads::SetSignalMask(OldMask);
+}
+
+void *SyscallHandler::TSOTrackingSamplerThread(void *Arg) {
+  auto Handler = reinterpret_cast<SyscallHandler*>(Arg);
+  auto &Tracking = Handler->TSOTracking;
+  const auto Interval = std::chrono::milliseconds(Handler->TSOPageTrackingInterval());
+  auto NextWindow = std::chrono::steady_clock::now() + Interval;
+
+  while (!Tracking.ShuttingDown.load()) {
+    // Read before draining, blocks queued after this make the wait below return right away
+    const uint32_t Wake = Tracking.SamplerWake.load();
+    Handler->TSOTrackingPromoteQueued();
+
+    if (!FEXCore::Context::IsTSOPageTrackingActive(Handler->CTX)) {
+      // Fell back to process-wide TSO, nothing left to sample
+      FHU::ScopedSignalMaskWithMutex lk(Tracking.Mutex);
+      Handler->TSOTrackingDisarmUnsafe();
+      break;
+    }
+
+    const auto Now = std::chrono::steady_clock::now();
+    if (Now >= NextWindow) {
+      NextWindow = Now + Interval;
+
+      // Alternate between open and closed windows
+      FHU::ScopedSignalMaskWithSharedLock lkVMA(Handler->VMATracking.Mutex);
+      FHU::ScopedSignalMaskWithMutex lk(Tracking.Mutex);
+      if (Tracking.Armed) {
+        Handler->TSOTrackingDisarmUnsafe();
+      }
+      else if (Tracking.ThreadsInHostCalls.load() == 0) {
+        Handler->TSOTrackingArmUnsafe();
+      }
+      continue;
+    }
+
+    const auto Timeout = std::chrono::duration_cast<std::chrono::nanoseconds>(NextWindow - Now).count();
+    const struct timespec ts {
+      .tv_sec = Timeout / 1'000'000'000,
+      .tv_nsec = Timeout % 1'000'000'000,
+    };
+    ::syscall(SYS_futex, &Tracking.SamplerWake, FUTEX_WAIT_PRIVATE, Wake, &ts, nullptr, 0);
+  }
+
+  return nullptr;
+}
+
+void SyscallHandler::TSOTrackingWakeSampler() {
+  ++TSOTracking.SamplerWake;
+  ::syscall(SYS_futex, &TSOTracking.SamplerWake, FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+}
+
+void SyscallHandler::TSOTrackingShutdown() {
+  if (!TSOTracking.SamplerThread) {
+    return;
+  }
+
+  TSOTracking.ShuttingDown = true;
+  TSOTrackingWakeSampler();
+  TSOTracking.SamplerThread->join(nullptr);
+  TSOTrackingDisarm();
+}
+
+void SyscallHandler::TSOTrackingArmUnsafe() {
+  // A thread that exited is gone once the kernel doesn't know its TID anymore
+  std::erase_if(TSOTracking.ExitingTIDs, [](uint32_t TID) {
+    return FHU::Syscalls::tgkill(::getpid(), TID, 0) == -1 && errno == ESRCH;
+  });
+  if (!TSOTracking.ExitingTIDs.empty()) {
+    return;
+  }
+
+  // Room for every range, so disarming never has to allocate
+  TSOTracking.ArmedRanges.reserve(VMATracking.VMAs.size());
+
+  // Publish the window before checking for threads in syscalls.
+  // Syscall entry does the opposite, so either the entering thread sees Armed and waits on the lock to disarm,
+  // or this sees the thread and doesn't open the window.
+  TSOTracking.Armed = true;
+  if (TSOTracking.ThreadsInHostCalls.load() != 0) {
+    TSOTracking.Armed = false;
+    return;
+  }
+
+  for (auto &[Base, VMA] : VMATracking.VMAs) {
+    // Guest code never runs from these mappings, so disarming can't drop SMC write protection
+    if (!TSOTrackingIsSampled(VMA)) {
+      continue;
+    }
+
+    auto rv = mprotect(reinterpret_cast<void*>(Base), VMA.Length, PROT_NONE);
+    if (rv == 0) {
+      TSOTracking.ArmedRanges.emplace_back(Base, Base + VMA.Length);
+    }
+  }
+}
+
+void SyscallHandler::TSOTrackingDisarmUnsafe() {
+  for (auto &[Base, Top] : TSOTracking.ArmedRanges) {
+    auto rv = mprotect(reinterpret_cast<void*>(Base), Top - Base, PROT_READ | PROT_WRITE);
+    LOGMAN_THROW_AA_FMT(rv == 0, "mprotect({}, {}) failed", Base, Top - Base);
+  }
+
+  // Keeps the capacity
+  TSOTracking.ArmedRanges.clear();
+  TSOTracking.Armed = false;
+}
+
+void SyscallHandler::TSOTrackingForgetRange(uint64_t Base, uint64_t Size) {
+  if (!TSOTracking.Pages) {
+    return;
+  }
+
+  auto Forget = [](TSOTrackingPage &State) {
+    State.Shared = false;
+    State.OwnerTID = 0;
+    for (auto &Block : State.Blocks) {
+      Block = 0;
+    }
+  };
+
+  FHU::ScopedSignalMaskWithMutex lk(TSOTracking.Mutex);
+
+  // Walk whichever is smaller, large unmaps usually have few sampled pages
+  if (TSOTracking::MaxPages < Size / FHU::FEX_PAGE_SIZE) {
+    for (size_t i = 0; i < TSOTracking::MaxPages; ++i) {
+      auto &State = TSOTracking.Pages[i];
+      const auto Page = State.Page.load();
+      if (Page && Page >= Base && Page < Base + Size) {
+        Forget(State);
+      }
+    }
+  }
+  else {
+    for (auto Page = Base; Page < Base + Size; Page += FHU::FEX_PAGE_SIZE) {
+      if (auto State = TSOTrackingFindPage(Page, false)) {
+        Forget(*State);
+      }
+    }
+  }
+}
+
+auto SyscallHandler::TSOTrackingFindPage(uint64_t Page, bool Insert) -> TSOTrackingPage* {
+  // Fibonacci hashing of the page number
+  const size_t Hash = ((Page / FHU::FEX_PAGE_SIZE) * 0x9E37'79B9'7F4A'7C15ULL) >> (64 - std::countr_zero(TSOTracking::MaxPages));
+
+  for (size_t i = 0; i < TSOTracking::MaxPageProbes; ++i) {
+    auto &State = TSOTracking.Pages[(Hash + i) % TSOTracking::MaxPages];
+    uint64_t Current = State.Page.load();
+    if (Current == 0) {
+      if (!Insert) {
+        return nullptr;
+      }
+
+      // Claim the free slot, unless another thread just claimed it
+      if (State.Page.compare_exchange_strong(Current, Page) || Current == Page) {
+        return &State;
+      }
+    }
+    else if (Current == Page) {
+      return &State;
+    }
+  }
+
+  return nullptr;
+}
+
+void SyscallHandler::TSOTrackingQueuePromotion(uint64_t Block) {
+  if (!Block) {
+    // Accesses from FEX itself aren't attributed to a block
+    return;
+  }
+
+  auto Write = TSOTracking.PromoteWrite.load();
+  do {
+    if (Write - TSOTracking.PromoteRead.load() >= TSOTracking::PromoteQueueSize) {
+      TSOTracking.PromoteOverflow = true;
+      TSOTrackingWakeSampler();
+      return;
+    }
+  } while (!TSOTracking.PromoteWrite.compare_exchange_weak(Write, Write + 1));
+
+  TSOTracking.PromoteQueue[Write % TSOTracking::PromoteQueueSize].store(Block);
+  TSOTrackingWakeSampler();
+}
+
+void SyscallHandler::TSOTrackingPromoteQueued() {
+  auto Read = TSOTracking.PromoteRead.load();
+  while (Read != TSOTracking.PromoteWrite.load()) {
+    // Zero if the writer claimed the slot but didn't store yet, it wakes the sampler once it did
+    const auto Block = TSOTracking.PromoteQueue[Read % TSOTracking::PromoteQueueSize].exchange(0);
+    if (!Block) {
+      break;
+    }
+
+    TSOTracking.PromoteRead = ++Read;
+    FEXCore::Context::MarkBlockRequiresTSO(CTX, Block);
+  }
+
+  if (TSOTracking.PromoteOverflow.exchange(false)) {
+    // Which blocks need TSO isn't known anymore
+    LogMan::Msg::IFmt("TSO page tracking queue overflowed");
+    FEXCore::Context::MarkMemoryShared(CTX);
+  }
+}
+
+void SyscallHandler::TSOTrackingDisarm() {
+  if (!TSOTracking.Armed) {
+    return;
+  }
+
+  FHU::ScopedSignalMaskWithMutex lk(TSOTracking.Mutex);
+  // The sampler can back out of arming while this was waiting for the lock
+  if (TSOTracking.Armed) {
+    TSOTrackingDisarmUnsafe();
+  }
+}
+
+void SyscallHandler::TSOTrackingHostCallEnter() {
+  // Increment before checking Armed, the sampler sets Armed before checking this
+  ++TSOTracking.ThreadsInHostCalls;
+  TSOTrackingDisarm();
+}
+
+void SyscallHandler::TSOTrackingHostCallExit() {
+  --TSOTracking.ThreadsInHostCalls;
+}
+
+void SyscallHandler::TSOTrackingThreadExit(uint32_t TID) {
+  FHU::ScopedSignalMaskWithMutex lk(TSOTracking.Mutex);
+  if (!TSOTracking.SamplerThread) {
+    return;
+  }
+
+  TSOTracking.ExitingTIDs.emplace_back(TID);
+  if (TSOTracking.Armed) {
+    TSOTrackingDisarmUnsafe();
+  }
+}
+
+bool SyscallHandler::HandleTSOTrackingFault(FEXCore::Core::InternalThreadState *Thread, uint64_t FaultAddress, void *ucontext) {
+  auto Handler = _SyscallHandler;
+  auto &Tracking = Handler->TSOTracking;
+
+  if (!Tracking.Pages) {
+    return false;
+  }
+
+  // Caller holds VMATracking.Mutex.
+  // Sampled mappings are always accessible to the guest, so a fault on one comes from a window.
+  // The window might have been closed again already, this still has to handle it.
+  auto Entry = Handler->VMATracking.LookupVMAUnsafe(FaultAddress);
+  if (Entry == Handler->VMATracking.VMAs.end() || !TSOTrackingIsSampled(Entry->second)) {
+    return false;
+  }
+
+  const auto FaultBase = FEXCore::AlignDown(FaultAddress, FHU::FEX_PAGE_SIZE);
+
+  uint64_t HostPC{};
+  auto &mcontext = reinterpret_cast<ucontext_t*>(ucontext)->uc_mcontext;
+#ifdef _M_ARM_64
+  HostPC = mcontext.pc;
+#else
+  HostPC = mcontext.gregs[REG_RIP];
+#endif
+
+  // Zero for accesses from FEX itself, only the page needs to be accessible again
+  const auto Block = FEXCore::Context::FindGuestBlockFromHostPC(Thread, HostPC);
+  const uint32_t TID = Thread->ThreadManager.GetTID();
+
+  auto State = Handler->TSOTrackingFindPage(FaultBase, true);
+  if (!State) {
+    // Out of space, assume the page is shared
+    Handler->TSOTrackingQueuePromotion(Block);
+  }
+  else {
+    uint32_t Owner = 0;
+    if (State->Shared) {
+      Handler->TSOTrackingQueuePromotion(Block);
+    }
+    else if (!State->OwnerTID.compare_exchange_strong(Owner, TID) && Owner != TID) {
+      // Second thread, the page is shared from now on.
+      // Every block that touched it while it was private needs TSO as well.
+      if (!State->Shared.exchange(true)) {
+        for (auto &PrivateBlock : State->Blocks) {
+          Handler->TSOTrackingQueuePromotion(PrivateBlock.exchange(0));
+        }
+      }
+      Handler->TSOTrackingQueuePromotion(Block);
+    }
+    else if (Block) {
+      bool Recorded = false;
+      for (auto &PrivateBlock : State->Blocks) {
+        uint64_t Expected = 0;
+        if (PrivateBlock.compare_exchange_strong(Expected, Block) || Expected == Block) {
+          Recorded = true;
+          break;
+        }
+      }
+
+      // Also promote if the page became shared after the block was recorded, it might have been missed
+      if (!Recorded || State->Shared) {
+        Handler->TSOTrackingQueuePromotion(Block);
+      }
+    }
+  }
+
+  auto rv = mprotect(reinterpret_cast<void*>(FaultBase), FHU::FEX_PAGE_SIZE, PROT_READ | PROT_WRITE);
+  LOGMAN_THROW_AA_FMT(rv == 0, "mprotect({}, {}) failed", FaultBase, FHU::FEX_PAGE_SIZE);
+
+  return true;
+}
+
+}
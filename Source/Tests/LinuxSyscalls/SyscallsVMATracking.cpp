@@ -231,6 +231,9 @@ void SyscallHandler::VMATracking::ClearUnsafe(FEXCore::Context::Context *CTX, ui
             ListInsertAfter(Current, TrailingPart);
           }
         }
+
+        // Inserting invalidated the iterator
+        CurrentIter = VMAs.find(MapBase);
       }
 
       if (ReplaceAndErase) {
@@ -318,6 +321,9 @@ void SyscallHandler::VMATracking::ChangeUnsafe(uintptr_t Base, uintptr_t Length,
           ListInsertAfter(Current, TrailingMapping);
         }
       }
+
+      // Inserting invalidated the iterator, continue from the original mapping
+      MappingIter = VMAs.find(MapBase);
     }
   }
 }
@@ -0,0 +1,293 @@
+/*
+$info$
+tags: LinuxSyscalls|common
+desc: Ordered address map used for VMA tracking
+$end_info$
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace FEX::HLE {
+// Ordered map from a 64-bit address to a value, with a subset of the std::map interface.
+//
+// Keys are stored sorted in fixed size chunks, and the first key of every chunk is kept in one contiguous array.
+// A lookup is a binary search over the chunk keys followed by a binary search inside of a single chunk,
+// which touches a few cache lines instead of walking a red-black tree with one allocation per node.
+//
+// Values are allocated separately so pointers to them stay valid until they are erased,
+// the intrusive VMA lists depend on this.
+//
+// Unlike std::map, emplace and erase invalidate every iterator except the one returned.
+template<typename T, size_t ChunkSize = 64>
+class VMAMap final {
+public:
+  using key_type = uint64_t;
+  using mapped_type = T;
+  using value_type = std::pair<const key_type, T>;
+
+private:
+  struct Chunk {
+    uint32_t Count{};
+    std::array<key_type, ChunkSize> Keys;
+    std::array<value_type*, ChunkSize> Values;
+  };
+
+  template<bool IsConst>
+  class IteratorBase final {
+  public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = VMAMap::value_type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = std::conditional_t<IsConst, const value_type*, value_type*>;
+    using reference = std::conditional_t<IsConst, const value_type&, value_type&>;
+
+    IteratorBase() = default;
+
+    // iterator -> const_iterator
+    template<bool OtherConst, typename = std::enable_if_t<IsConst && !OtherConst>>
+    IteratorBase(const IteratorBase<OtherConst> &Other)
+      : Map {Other.Map}, ChunkIndex {Other.ChunkIndex}, Slot {Other.Slot} {}
+
+    reference operator*() const { return *Map->Chunks[ChunkIndex]->Values[Slot]; }
+    pointer operator->() const { return Map->Chunks[ChunkIndex]->Values[Slot]; }
+
+    IteratorBase &operator++() {
+      if (++Slot == Map->Chunks[ChunkIndex]->Count) {
+        ++ChunkIndex;
+        Slot = 0;
+      }
+      return *this;
+    }
+
+    IteratorBase &operator--() {
+      if (Slot == 0) {
+        --ChunkIndex;
+        Slot = Map->Chunks[ChunkIndex]->Count - 1;
+      }
+      else {
+        --Slot;
+      }
+      return *this;
+    }
+
+    IteratorBase operator++(int) { auto Prev = *this; ++*this; return Prev; }
+    IteratorBase operator--(int) { auto Prev = *this; --*this; return Prev; }
+
+    template<bool OtherConst>
+    bool operator==(const IteratorBase<OtherConst> &Other) const {
+      return ChunkIndex == Other.ChunkIndex && Slot == Other.Slot;
+    }
+
+    template<bool OtherConst>
+    bool operator!=(const IteratorBase<OtherConst> &Other) const {
+      return !(*this == Other);
+    }
+
+  private:
+    friend class VMAMap;
+    template<bool> friend class IteratorBase;
+
+    using MapType = std::conditional_t<IsConst, const VMAMap, VMAMap>;
+
+    IteratorBase(MapType *Map, size_t ChunkIndex, uint32_t Slot)
+      : Map {Map}, ChunkIndex {ChunkIndex}, Slot {Slot} {}
+
+    MapType *Map{};
+    size_t ChunkIndex{};
+    uint32_t Slot{};
+  };
+
+public:
+  using iterator = IteratorBase<false>;
+  using const_iterator = IteratorBase<true>;
+
+  VMAMap() = default;
+  VMAMap(const VMAMap&) = delete;
+  VMAMap &operator=(const VMAMap&) = delete;
+
+  ~VMAMap() {
+    clear();
+  }
+
+  iterator begin() { return {this, 0, 0}; }
+  iterator end() { return {this, Chunks.size(), 0}; }
+  const_iterator begin() const { return {this, 0, 0}; }
+  const_iterator end() const { return {this, Chunks.size(), 0}; }
+
+  size_t size() const { return Size; }
+  bool empty() const { return Size == 0; }
+
+  void clear() {
+    for (auto &Chunk : Chunks) {
+      for (uint32_t i = 0; i < Chunk->Count; ++i) {
+        delete Chunk->Values[i];
+      }
+    }
+    Chunks.clear();
+    FirstKeys.clear();
+    Size = 0;
+  }
+
+  // First element with a key >= Key
+  iterator lower_bound(key_type Key) { return Bound<false, iterator>(this, Key); }
+  const_iterator lower_bound(key_type Key) const { return Bound<false, const_iterator>(this, Key); }
+
+  // First element with a key > Key
+  iterator upper_bound(key_type Key) { return Bound<true, iterator>(this, Key); }
+  const_iterator upper_bound(key_type Key) const { return Bound<true, const_iterator>(this, Key); }
+
+  iterator find(key_type Key) {
+    auto It = lower_bound(Key);
+    return (It != end() && It->first == Key) ? It : end();
+  }
+
+  const_iterator find(key_type Key) const {
+    auto It = lower_bound(Key);
+    return (It != end() && It->first == Key) ? It : end();
+  }
+
+  template<typename... Args>
+  std::pair<iterator, bool> emplace(key_type Key, Args&&... args) {
+    if (Chunks.empty()) {
+      Chunks.emplace_back(std::make_unique<Chunk>());
+      FirstKeys.emplace_back(Key);
+    }
+
+    size_t ChunkIndex = FindChunk(Key);
+    auto CurrentChunk = Chunks[ChunkIndex].get();
+    uint32_t Slot = std::lower_bound(CurrentChunk->Keys.begin(), CurrentChunk->Keys.begin() + CurrentChunk->Count, Key) - CurrentChunk->Keys.begin();
+
+    if (Slot != CurrentChunk->Count && CurrentChunk->Keys[Slot] == Key) {
+      return {iterator{this, ChunkIndex, Slot}, false};
+    }
+
+    if (CurrentChunk->Count == ChunkSize) {
+      // Split the full chunk in half and insert in to whichever half covers the key
+      SplitChunk(ChunkIndex);
+      if (Slot > ChunkSize / 2) {
+        ++ChunkIndex;
+        Slot -= ChunkSize / 2;
+      }
+      CurrentChunk = Chunks[ChunkIndex].get();
+    }
+
+    std::move_backward(CurrentChunk->Keys.begin() + Slot, CurrentChunk->Keys.begin() + CurrentChunk->Count, CurrentChunk->Keys.begin() + CurrentChunk->Count + 1);
+    std::move_backward(CurrentChunk->Values.begin() + Slot, CurrentChunk->Values.begin() + CurrentChunk->Count, CurrentChunk->Values.begin() + CurrentChunk->Count + 1);
+    CurrentChunk->Keys[Slot] = Key;
+    CurrentChunk->Values[Slot] = new value_type(std::piecewise_construct, std::forward_as_tuple(Key), std::forward_as_tuple(std::forward<Args>(args)...));
+    ++CurrentChunk->Count;
+    ++Size;
+
+    if (Slot == 0) {
+      FirstKeys[ChunkIndex] = Key;
+    }
+
+    return {iterator{this, ChunkIndex, Slot}, true};
+  }
+
+  // Returns the element after the erased one
+  iterator erase(const_iterator Pos) {
+    const size_t ChunkIndex = Pos.ChunkIndex;
+    const uint32_t Slot = Pos.Slot;
+    auto CurrentChunk = Chunks[ChunkIndex].get();
+
+    delete CurrentChunk->Values[Slot];
+    std::move(CurrentChunk->Keys.begin() + Slot + 1, CurrentChunk->Keys.begin() + CurrentChunk->Count, CurrentChunk->Keys.begin() + Slot);
+    std::move(CurrentChunk->Values.begin() + Slot + 1, CurrentChunk->Values.begin() + CurrentChunk->Count, CurrentChunk->Values.begin() + Slot);
+    --CurrentChunk->Count;
+    --Size;
+
+    if (CurrentChunk->Count == 0) {
+      Chunks.erase(Chunks.begin() + ChunkIndex);
+      FirstKeys.erase(FirstKeys.begin() + ChunkIndex);
+      return {this, ChunkIndex, 0};
+    }
+
+    if (Slot == 0) {
+      FirstKeys[ChunkIndex] = CurrentChunk->Keys[0];
+    }
+
+    // Keep chunks dense, pull the next chunk in if everything fits
+    if (ChunkIndex + 1 < Chunks.size() &&
+        CurrentChunk->Count + Chunks[ChunkIndex + 1]->Count <= ChunkSize / 2) {
+      MergeNextChunk(ChunkIndex);
+    }
+
+    if (Slot == CurrentChunk->Count) {
+      return {this, ChunkIndex + 1, 0};
+    }
+    return {this, ChunkIndex, Slot};
+  }
+
+  iterator erase(iterator Pos) {
+    return erase(const_iterator{Pos});
+  }
+
+private:
+  std::vector<std::unique_ptr<Chunk>> Chunks;
+  // First key of every chunk, contiguous so the chunk search stays in a few cache lines
+  std::vector<key_type> FirstKeys;
+  size_t Size{};
+
+  // Chunk that would contain Key, Chunks must not be empty
+  size_t FindChunk(key_type Key) const {
+    auto It = std::upper_bound(FirstKeys.begin(), FirstKeys.end(), Key);
+    return It == FirstKeys.begin() ? 0 : (It - FirstKeys.begin()) - 1;
+  }
+
+  template<bool Upper, typename IteratorType, typename MapType>
+  static IteratorType Bound(MapType *Map, key_type Key) {
+    if (Map->Chunks.empty()) {
+      return Map->end();
+    }
+
+    const size_t ChunkIndex = Map->FindChunk(Key);
+    const auto CurrentChunk = Map->Chunks[ChunkIndex].get();
+    const auto KeysBegin = CurrentChunk->Keys.begin();
+    const auto KeysEnd = KeysBegin + CurrentChunk->Count;
+    const uint32_t Slot = (Upper ? std::upper_bound(KeysBegin, KeysEnd, Key) : std::lower_bound(KeysBegin, KeysEnd, Key)) - KeysBegin;
+
+    if (Slot == CurrentChunk->Count) {
+      return IteratorType{Map, ChunkIndex + 1, 0};
+    }
+    return IteratorType{Map, ChunkIndex, Slot};
+  }
+
+  void SplitChunk(size_t ChunkIndex) {
+    auto CurrentChunk = Chunks[ChunkIndex].get();
+    auto NewChunk = std::make_unique<Chunk>();
+
+    constexpr uint32_t Half = ChunkSize / 2;
+    NewChunk->Count = CurrentChunk->Count - Half;
+    std::copy(CurrentChunk->Keys.begin() + Half, CurrentChunk->Keys.begin() + CurrentChunk->Count, NewChunk->Keys.begin());
+    std::copy(CurrentChunk->Values.begin() + Half, CurrentChunk->Values.begin() + CurrentChunk->Count, NewChunk->Values.begin());
+    CurrentChunk->Count = Half;
+
+    FirstKeys.insert(FirstKeys.begin() + ChunkIndex + 1, NewChunk->Keys[0]);
+    Chunks.insert(Chunks.begin() + ChunkIndex + 1, std::move(NewChunk));
+  }
+
+  void MergeNextChunk(size_t ChunkIndex) {
+    auto CurrentChunk = Chunks[ChunkIndex].get();
+    auto NextChunk = Chunks[ChunkIndex + 1].get();
+
+    std::copy(NextChunk->Keys.begin(), NextChunk->Keys.begin() + NextChunk->Count, CurrentChunk->Keys.begin() + CurrentChunk->Count);
+    std::copy(NextChunk->Values.begin(), NextChunk->Values.begin() + NextChunk->Count, CurrentChunk->Values.begin() + CurrentChunk->Count);
+    CurrentChunk->Count += NextChunk->Count;
+
+    Chunks.erase(Chunks.begin() + ChunkIndex + 1);
+    FirstKeys.erase(FirstKeys.begin() + ChunkIndex + 1);
+  }
+};
+}
@@ -6,6 +6,7 @@ $end_info$
 
 #include "Tests/LinuxSyscalls/SignalDelegator.h"
 #include "Tests/LinuxSyscalls/Syscalls.h"
+#include "Tests/LinuxSyscalls/Syscalls/Thread.h"
 #include "Tests/LinuxSyscalls/x32/Syscalls.h"
 #include "Tests/LinuxSyscalls/x32/Thread.h"
 #include "Tests/LinuxSyscalls/x32/Types.h"
@@ -193,6 +194,7 @@ namespace FEX::HLE::x32 {
         timeout_ptr = &tp64;
       }
 
+      FEX::HLE::BeforeFutexWait(Frame, futex_op);
       uint64_t Result = syscall(SYSCALL_DEF(futex),
         uaddr,
         futex_op,
@@ -179,7 +179,9 @@ int main(int argc, char **argv, char **const envp) {
     (!HostFeatures.SupportsCLZERO && Loader.RequiresCLZERO()) ||
     (!HostFeatures.SupportsBMI1 && Loader.RequiresBMI1()) ||
     (!HostFeatures.SupportsBMI2 && Loader.RequiresBMI2()) ||
-    (!HostFeatures.SupportsCLWB && Loader.RequiresCLWB());
+    (!HostFeatures.SupportsCLWB && Loader.RequiresCLWB()) ||
+    (!HostFeatures.SupportsFMA && Loader.RequiresFMA()) ||
+    (!HostFeatures.SupportsF16C && Loader.RequiresF16C());
 
   if (TestUnsupported) {
     FEXCore::Context::DestroyContext(CTX);
@@ -433,6 +433,10 @@ namespace WebFileFetcher {
     // This is the hash of the file
     std::string Hash;
 
+    // This is the XXFileHash::HashFileChunked hash of the file
+    // Optional, verifying with it is a lot faster
+    std::string ChunkedHash;
+
     // FileType
     enum class FileType {
       TYPE_UNKNOWN,
@@ -569,6 +573,9 @@ namespace WebFileFetcher {
         else if (DataName == "Hash") {
           Target.Hash = json_getValue(DataItem);
         }
+        else if (DataName == "ChunkedHash") {
+          Target.ChunkedHash = json_getValue(DataItem);
+        }
         else if (DataName == "Type") {
           auto DataValue = std::string_view {json_getValue(DataItem)};
           if (DataValue == "squashfs") {
@@ -594,6 +601,18 @@ namespace WebFileFetcher {
 
     return Targets;
   }
+
+  uint64_t GetExpectedHash(const FileTargets &Target) {
+    return std::stoul(Target.ChunkedHash.empty() ? Target.Hash : Target.ChunkedHash, nullptr, 16);
+  }
+
+  // Hashes with the chunked hash when the target has one, it uses all cores
+  std::pair<bool, uint64_t> HashTargetFile(const FileTargets &Target, const std::string &PathName) {
+    if (Target.ChunkedHash.empty()) {
+      return XXFileHash::HashFile(PathName);
+    }
+    return XXFileHash::HashFileChunked(PathName);
+  }
 }
 
 namespace Zenity {
@@ -722,7 +741,7 @@ namespace Zenity {
     std::string RootFS = FEXCore::Config::GetDataDirectory() + "RootFS/";
     auto filename = Target.URL.substr(Target.URL.find_last_of('/') + 1);
     auto PathName = RootFS + filename;
-    uint64_t ExpectedHash = std::stoul(Target.Hash, nullptr, 16);
+    uint64_t ExpectedHash = WebFileFetcher::GetExpectedHash(Target);
 
     std::error_code ec;
     if (std::filesystem::exists(PathName, ec)) {
@@ -736,7 +755,7 @@ namespace Zenity {
         return false;
       }
 
-      auto Res = XXFileHash::HashFile(PathName);
+      auto Res = WebFileFetcher::HashTargetFile(Target, PathName);
       if (Result == 0) {
         if (Res.first == true &&
             Res.second == ExpectedHash) {
@@ -890,7 +909,7 @@ namespace TTY {
     std::string RootFS = FEXCore::Config::GetDataDirectory() + "RootFS/";
     auto filename = Target.URL.substr(Target.URL.find_last_of('/') + 1);
     auto PathName = RootFS + filename;
-    uint64_t ExpectedHash = std::stoul(Target.Hash, nullptr, 16);
+    uint64_t ExpectedHash = WebFileFetcher::GetExpectedHash(Target);
 
     std::error_code ec;
     if (std::filesystem::exists(PathName, ec)) {
@@ -904,7 +923,7 @@ namespace TTY {
         return false;
       }
       fmt::print("Validating RootFS hash...\n");
-      auto Res = XXFileHash::HashFile(PathName);
+      auto Res = WebFileFetcher::HashTargetFile(Target, PathName);
       if (Result == 0) {
         if (Res.first == true &&
             Res.second == ExpectedHash) {
@@ -1090,9 +1109,12 @@ int main(int argc, char **argv, char **const envp) {
   ArgOptions::ParseArguments(argc, argv);
 
   if (ArgOptions::RemainingArgs.size()) {
+    // Both hashes end up in the rootfs JSON
     auto Res = XXFileHash::HashFile(ArgOptions::RemainingArgs[0]);
-    if (Res.first) {
+    auto ChunkedRes = XXFileHash::HashFileChunked(ArgOptions::RemainingArgs[0]);
+    if (Res.first && ChunkedRes.first) {
       fmt::print("{} has hash: {:x}\n", ArgOptions::RemainingArgs[0], Res.second);
+      fmt::print("{} has chunked hash: {:x}\n", ArgOptions::RemainingArgs[0], ChunkedRes.second);
     }
     else {
       fmt::print("Couldn't generate hash for {}\n", ArgOptions::RemainingArgs[0]);
@@ -1154,10 +1176,10 @@ int main(int argc, char **argv, char **const envp) {
         auto ValidateDownload = [&Target, &PathName]() -> std::pair<int32_t, bool> {
           std::error_code ec;
           if (ValidateDownloadSelection(Target)) {
-            uint64_t ExpectedHash = std::stoul(Target.Hash, nullptr, 16);
+            uint64_t ExpectedHash = WebFileFetcher::GetExpectedHash(Target);
 
             if (std::filesystem::exists(PathName, ec)) {
-              auto Res = XXFileHash::HashFile(PathName);
+              auto Res = WebFileFetcher::HashTargetFile(Target, PathName);
               if (Res.first == false ||
                   Res.second != ExpectedHash) {
                 std::string Text = fmt::format("Couldn't hash the rootfs or hash didn't match\n");
@@ -1,8 +1,13 @@
 #include "XXFileHash.h"
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <fcntl.h>
 #include <fmt/format.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <thread>
 #include <unistd.h>
 #include <vector>
 #include <xxhash.h>
@@ -70,4 +75,97 @@ namespace XXFileHash {
     close(fd);
     return {true, Hash};
   }
+
+  std::pair<bool, uint64_t> HashFileChunked(const std::string &Filepath, size_t NumThreads) {
+    int fd = open(Filepath.c_str(), O_RDONLY);
+    if (fd == -1) {
+      return {false, 0};
+    }
+
+    struct stat buf{};
+    if (fstat(fd, &buf) == -1) {
+      close(fd);
+      return {false, 0};
+    }
+
+    const uint64_t Size = buf.st_size;
+    const size_t NumChunks = (Size + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    std::vector<XXH64_hash_t> Hashes(NumChunks);
+
+    uint8_t *Data{};
+    if (Size) {
+      Data = reinterpret_cast<uint8_t*>(mmap(nullptr, Size, PROT_READ, MAP_PRIVATE, fd, 0));
+    }
+    close(fd);
+
+    if (Data == MAP_FAILED) {
+      return {false, 0};
+    }
+
+    if (NumThreads == 0) {
+      NumThreads = std::max(1U, std::thread::hardware_concurrency());
+    }
+    NumThreads = std::min(NumThreads, std::max<size_t>(NumChunks, 1));
+
+    // Threads grab the next chunk as they finish one
+    // Neighbouring threads work on neighbouring chunks so the reads stay mostly sequential
+    std::atomic<size_t> NextChunk{};
+    std::atomic<size_t> ChunksDone{};
+
+    auto HashChunks = [&](bool ShowProgress) {
+      auto Now = std::chrono::high_resolution_clock::now();
+      size_t Chunk;
+      while ((Chunk = NextChunk.fetch_add(1, std::memory_order_relaxed)) < NumChunks) {
+        const uint64_t Offset = Chunk * CHUNK_SIZE;
+        const uint64_t Length = std::min<uint64_t>(CHUNK_SIZE, Size - Offset);
+
+        madvise(Data + Offset, Length, MADV_WILLNEED);
+        Hashes[Chunk] = XXH3_64bits(Data + Offset, Length);
+        // Hashed pages won't be touched again
+        madvise(Data + Offset, Length, MADV_DONTNEED);
+
+        ChunksDone.fetch_add(1, std::memory_order_relaxed);
+
+        if (ShowProgress) {
+          auto Cur = std::chrono::high_resolution_clock::now();
+          auto Dur = Cur - Now;
+          if (Dur >= std::chrono::seconds(5)) {
+            fmt::print("{}% hashed\n", (double)ChunksDone.load(std::memory_order_relaxed) / (double)NumChunks);
+            Now = Cur;
+          }
+        }
+      }
+    };
+
+    std::vector<std::thread> Threads;
+    for (size_t i = 1; i < NumThreads; ++i) {
+      Threads.emplace_back(HashChunks, false);
+    }
+    HashChunks(true);
+
+    for (auto &Thread : Threads) {
+      Thread.join();
+    }
+
+    if (Data) {
+      munmap(Data, Size);
+    }
+
+    // Combine each pair of hashes, an odd one out moves up a level as is
+    while (Hashes.size() > 1) {
+      std::vector<XXH64_hash_t> Parents((Hashes.size() + 1) / 2);
+      for (size_t i = 0; i < Hashes.size() / 2; ++i) {
+        Parents[i] = XXH3_64bits(&Hashes[i * 2], sizeof(XXH64_hash_t) * 2);
+      }
+
+      if (Hashes.size() & 1) {
+        Parents.back() = Hashes.back();
+      }
+      Hashes = std::move(Parents);
+    }
+
+    // Mixing in the size keeps files with the same tree shape apart
+    const XXH64_hash_t Root = Hashes.empty() ? 0 : Hashes[0];
+    return {true, XXH3_64bits_withSeed(&Root, sizeof(Root), Size)};
+  }
 }
@@ -1,7 +1,25 @@
 #pragma once
+#include <cstddef>
+#include <cstdint>
 #include <string>
 
 namespace XXFileHash {
   std::pair<bool, uint64_t> HashFile(const std::string &Filepath);
-}
 
+  // Size of the leaves of the chunked hash
+  constexpr static size_t CHUNK_SIZE = 32 * 1024 * 1024;
+
+  /**
+   * @brief Hashes a file as a tree of chunks
+   *
+   * Every CHUNK_SIZE chunk gets its own XXH3 hash, the chunk hashes are combined pairwise in to a Merkle root
+   * and the root is hashed together with the file size.
+   * Unlike HashFile this doesn't depend on reading the file in order, so all cores can work on it.
+   *
+   * @param Filepath - File to hash
+   * @param NumThreads - Threads to hash with, 0 uses all cores
+   *
+   * @return false if the file couldn't be read
+   */
+  std::pair<bool, uint64_t> HashFileChunked(const std::string &Filepath, size_t NumThreads = 0);
+}
@@ -1,8 +1,11 @@
 #include "Common/FEXServerClient.h"
 
+#include <algorithm>
 #include <atomic>
+#include <cstring>
 #include <mutex>
 #include <poll.h>
+#include <string>
 #include <thread>
 #include <vector>
 
@@ -18,6 +21,130 @@ namespace Logger {
   std::atomic<bool> ShouldShutdown {false};
   std::atomic<int32_t> LoggerThreadTID{};
 
+  // Appends text from a format string, turning %% in to %
+  void AppendFormatText(std::string &Result, char const *Begin, char const *End) {
+    for (char const *Current = Begin; Current < End; ++Current) {
+      Result += *Current;
+      if (Current[0] == '%' && Current + 1 < End && Current[1] == '%') {
+        ++Current;
+      }
+    }
+  }
+
+  /**
+   * @brief Formats a message that a client left unformatted
+   *
+   * Arguments were passed as raw 64-bit values, they get truncated according to the conversion's length modifier.
+   */
+  std::string FormatDeferredMsg(FEXServerClient::Logging::PacketFormattedMsg const *Msg, char const *Data) {
+    char const *DataEnd = Data + Msg->DataLength;
+    char const *Format = Data;
+    const size_t FormatLength = strnlen(Format, Msg->DataLength);
+    if (FormatLength == Msg->DataLength) {
+      // Format string isn't terminated
+      return {};
+    }
+
+    char const *FormatEnd = Format + FormatLength;
+    // The strings for %s conversions follow the format string
+    char const *Strings = FormatEnd + 1;
+
+    std::string Result{};
+    char Buffer[512];
+    size_t Arg{};
+
+    char const *Current = Format;
+    char const *Start{};
+    for (auto Conversion = FEXServerClient::Logging::NextConversion(Current, &Start);
+         Conversion && Conversion < FormatEnd;
+         Conversion = FEXServerClient::Logging::NextConversion(Current, &Start)) {
+      AppendFormatText(Result, Current, Start);
+      Current = Conversion + 1;
+
+      if (Arg >= Msg->NumArgs) {
+        // More conversions than arguments, leave them as they are
+        Result.append(Start, Current);
+        continue;
+      }
+
+      if (*Conversion == 's') {
+        if (Strings < DataEnd) {
+          const size_t Length = strnlen(Strings, DataEnd - Strings);
+          Result.append(Strings, Length);
+          Strings += Length + 1;
+        }
+        ++Arg;
+        continue;
+      }
+
+      // Rebuild the conversion with a fixed length modifier
+      std::string Spec{};
+      bool Wide{};
+      for (char const *Modifier = Start; Modifier < Conversion; ++Modifier) {
+        if (strchr("hlqjztL", *Modifier)) {
+          Wide |= *Modifier != 'h';
+        }
+        else {
+          Spec += *Modifier;
+        }
+      }
+
+      const uint64_t Value = Msg->Args[Arg++];
+      int Written{-1};
+      switch (*Conversion) {
+        case 'd':
+        case 'i':
+          Spec += "ll";
+          Spec += *Conversion;
+          Written = snprintf(Buffer, sizeof(Buffer), Spec.c_str(),
+            Wide ? static_cast<long long>(Value) : static_cast<long long>(static_cast<int32_t>(Value)));
+          break;
+        case 'u':
+        case 'x':
+        case 'X':
+        case 'o':
+          Spec += "ll";
+          Spec += *Conversion;
+          Written = snprintf(Buffer, sizeof(Buffer), Spec.c_str(),
+            Wide ? static_cast<unsigned long long>(Value) : static_cast<unsigned long long>(static_cast<uint32_t>(Value)));
+          break;
+        case 'c':
+          Spec += 'c';
+          Written = snprintf(Buffer, sizeof(Buffer), Spec.c_str(), static_cast<int>(Value));
+          break;
+        case 'p':
+          Spec += 'p';
+          Written = snprintf(Buffer, sizeof(Buffer), Spec.c_str(), reinterpret_cast<void*>(Value));
+          break;
+        case 'e':
+        case 'E':
+        case 'f':
+        case 'F':
+        case 'g':
+        case 'G':
+        case 'a':
+        case 'A': {
+          double Double{};
+          memcpy(&Double, &Value, sizeof(Double));
+          Spec += *Conversion;
+          Written = snprintf(Buffer, sizeof(Buffer), Spec.c_str(), Double);
+          break;
+        }
+        default:
+          // Unknown conversion, print it as is
+          Result.append(Start, Current);
+          break;
+      }
+
+      if (Written > 0) {
+        Result.append(Buffer, std::min<size_t>(Written, sizeof(Buffer) - 1));
+      }
+    }
+
+    AppendFormatText(Result, Current, FormatEnd);
+    return Result;
+  }
+
   void HandleLogData(int Socket) {
     std::vector<uint8_t> Data(1500);
     size_t CurrentRead{};
@@ -46,14 +173,42 @@ namespace Logger {
 
     size_t CurrentOffset{};
     while (CurrentOffset < CurrentRead) {
+      const size_t Remaining = CurrentRead - CurrentOffset;
       FEXServerClient::Logging::PacketHeader *Header = reinterpret_cast<FEXServerClient::Logging::PacketHeader*>(&Data[CurrentOffset]);
-      if (Header->PacketType == FEXServerClient::Logging::PacketTypes::TYPE_MSG) {
+      if (Remaining < sizeof(FEXServerClient::Logging::PacketHeader)) {
+        CurrentOffset = CurrentRead;
+      }
+      else if (Header->PacketType == FEXServerClient::Logging::PacketTypes::TYPE_MSG &&
+          Remaining >= sizeof(FEXServerClient::Logging::PacketMsg)) {
         FEXServerClient::Logging::PacketMsg *Msg = reinterpret_cast<FEXServerClient::Logging::PacketMsg*>(&Data[CurrentOffset]);
+        if (Msg->MessageLength == 0 || Msg->MessageLength > Remaining - sizeof(FEXServerClient::Logging::PacketMsg)) {
+          CurrentOffset = CurrentRead;
+          continue;
+        }
+
+        // Make sure the text is terminated even if the client didn't
         const char *MsgText = reinterpret_cast<const char*>(&Data[CurrentOffset + sizeof(FEXServerClient::Logging::PacketMsg)]);
-        Logging::ClientMsgHandler(Socket, Msg->Header.Timestamp, Msg->Header.PID, Msg->Header.TID, Msg->Level, MsgText);
+        const std::string Text(MsgText, strnlen(MsgText, Msg->MessageLength));
+        Logging::ClientMsgHandler(Socket, Msg->Header.Timestamp, Msg->Header.PID, Msg->Header.TID, Msg->Level, Text.c_str());
 
         CurrentOffset += sizeof(FEXServerClient::Logging::PacketMsg) + Msg->MessageLength;
       }
+      else if (Header->PacketType == FEXServerClient::Logging::PacketTypes::TYPE_FORMATTED_MSG &&
+          Remaining >= sizeof(FEXServerClient::Logging::PacketFormattedMsg)) {
+        auto Msg = reinterpret_cast<FEXServerClient::Logging::PacketFormattedMsg*>(&Data[CurrentOffset]);
+        if (Msg->DataLength == 0 ||
+            Msg->DataLength > Remaining - sizeof(FEXServerClient::Logging::PacketFormattedMsg) ||
+            Msg->NumArgs > FEXServerClient::Logging::MAX_FORMAT_ARGS) {
+          CurrentOffset = CurrentRead;
+          continue;
+        }
+
+        const char *MsgData = reinterpret_cast<const char*>(&Data[CurrentOffset + sizeof(FEXServerClient::Logging::PacketFormattedMsg)]);
+        const auto Text = FormatDeferredMsg(Msg, MsgData);
+        Logging::ClientMsgHandler(Socket, Msg->Header.Timestamp, Msg->Header.PID, Msg->Header.TID, Msg->Level, Text.c_str());
+
+        CurrentOffset += sizeof(FEXServerClient::Logging::PacketFormattedMsg) + Msg->DataLength;
+      }
       else {
         CurrentOffset = CurrentRead;
       }
@@ -5,13 +5,18 @@
 #include "Common/FEXServerClient.h"
 
 #include <atomic>
+#include <deque>
 #include <fcntl.h>
 #include <filesystem>
+#include <linux/limits.h>
 #include <poll.h>
 #include <string>
+#include <sys/mman.h>
 #include <sys/resource.h>
 #include <sys/socket.h>
 #include <sys/un.h>
+#include <unistd.h>
+#include <unordered_map>
 #include <vector>
 
 namespace ProcessPipe {
@@ -28,6 +33,15 @@ namespace ProcessPipe {
   rlimit MaxFDs{};
   std::atomic<size_t> NumFilesOpened{};
 
+  // Shared code caches
+  // The memfds are sparse, only the pages that get code written to them use memory
+  constexpr size_t CODE_CACHE_SIZE = 128 * 1024 * 1024;
+  // Once this many files have a cache the oldest one gets dropped
+  // Processes that already mapped it keep using it
+  constexpr size_t MAX_CODE_CACHES = 256;
+  std::unordered_map<std::string, int> CodeCacheFDs{};
+  std::deque<std::string> CodeCacheOrder{};
+
   size_t GetNumFilesOpen() {
     // Walk /proc/self/fd/ to see how many open files we currently have
     const std::filesystem::path self{"/proc/self/fd/"};
@@ -281,6 +295,40 @@ namespace ProcessPipe {
     sendmsg(Socket, &msg, 0);
   }
 
+  int GetCodeCacheFD(std::string const &Name) {
+    auto it = CodeCacheFDs.find(Name);
+    if (it != CodeCacheFDs.end()) {
+      return it->second;
+    }
+
+    int FD = ::memfd_create("FEXCodeCache", MFD_CLOEXEC);
+    if (FD == -1) {
+      return -1;
+    }
+
+    if (ftruncate(FD, CODE_CACHE_SIZE) == -1) {
+      close(FD);
+      return -1;
+    }
+
+    if (CodeCacheOrder.size() == MAX_CODE_CACHES) {
+      auto Oldest = CodeCacheFDs.find(CodeCacheOrder.front());
+      close(Oldest->second);
+      CodeCacheFDs.erase(Oldest);
+      CodeCacheOrder.pop_front();
+      --NumFilesOpened;
+    }
+
+    CodeCacheFDs.emplace(Name, FD);
+    CodeCacheOrder.emplace_back(Name);
+
+    // Check if we need to increase the FD limit.
+    ++NumFilesOpened;
+    CheckRaiseFDLimit();
+
+    return FD;
+  }
+
   void HandleSocketData(int Socket) {
     std::vector<uint8_t> Data(1500);
     size_t CurrentRead{};
@@ -426,6 +474,32 @@ namespace ProcessPipe {
 
           CurrentOffset += sizeof(FEXServerClient::FEXServerRequestPacket::Header);
           break;
+        }
+        case FEXServerClient::PacketType::TYPE_GET_CODE_CACHE_FD: {
+          const size_t Remaining = CurrentRead - CurrentOffset;
+          if (Remaining < sizeof(Req->CodeCache) ||
+              Req->CodeCache.Length == 0 ||
+              Req->CodeCache.Length > PATH_MAX ||
+              Req->CodeCache.Length > Remaining - sizeof(Req->CodeCache)) {
+            // Truncated packet, consume everything
+            LogMan::Msg::EFmt("[FEXServer] Invalid code cache request");
+            SendEmptyErrorPacket(Socket);
+            CurrentOffset = CurrentRead;
+            break;
+          }
+
+          std::string Name(Req->CodeCache.Name, Req->CodeCache.Length);
+          int FD = GetCodeCacheFD(Name);
+          if (FD == -1) {
+            SendEmptyErrorPacket(Socket);
+          }
+          else {
+            // FD stays open, the next process asking for this cache gets the same memfd
+            SendFDSuccessPacket(Socket, FD);
+          }
+
+          CurrentOffset += sizeof(Req->CodeCache) + Req->CodeCache.Length;
+          break;
         }
           // Invalid
         case FEXServerClient::PacketType::TYPE_ERROR:
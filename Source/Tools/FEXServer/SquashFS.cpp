@@ -130,11 +130,14 @@ namespace SquashFS {
     if (pid == 0) {
       // Child
       close(fds[0]); // Close read side
-      const char *argv[4];
+      // use_ino keeps the image's inode numbers, the in-process rootfs reader reports the same ones
+      const char *argv[6];
       argv[0] = EroFS ? "erofsfuse" : "squashfuse";
-      argv[1] = SquashFS.c_str();
-      argv[2] = MountFolder.c_str();
-      argv[3] = nullptr;
+      argv[1] = "-o";
+      argv[2] = "use_ino";
+      argv[3] = SquashFS.c_str();
+      argv[4] = MountFolder.c_str();
+      argv[5] = nullptr;
 
       // Try and execute {erofsfuse, squashfuse} to mount our rootfs
       if (execvpe(argv[0], (char * const*)argv, environ) == -1) {
@@ -48,6 +48,15 @@ struct ThunkedFunction : FunctionParams {
     // This is implied e.g. for thunks generated for variadic functions
     bool custom_host_impl = false;
 
+    // If true, calls are recorded in the guest and executed on the host at the next flush
+    bool is_batched = false;
+
+    // If true, calls are recorded in the command stream of the first argument
+    bool is_recorded = false;
+
+    // If true, 64-bit guests pass arguments and the return value in registers instead of packing them
+    bool is_register_call = false;
+
     std::string GetOriginalFunctionName() const {
         const std::string suffix = "_internal";
         assert(function_name.length() > suffix.size());
@@ -99,6 +108,8 @@ struct NamespaceInfo {
     bool generate_guest_symtable;
 
     bool indirect_guest_calls;
+
+    bool batch_state_calls;
 };
 
 static std::vector<clang::DeclContext*> decl_contexts;
@@ -127,6 +138,7 @@ struct NamespaceAnnotations {
     std::optional<std::string> load_host_endpoint_via;
     bool generate_guest_symtable = false;
     bool indirect_guest_calls = false;
+    bool batch_state_calls = false;
 };
 
 static NamespaceAnnotations GetNamespaceAnnotations(clang::ASTContext& context, clang::CXXRecordDecl* decl) {
@@ -143,6 +155,8 @@ static NamespaceAnnotations GetNamespaceAnnotations(clang::ASTContext& context,
             ret.generate_guest_symtable = true;
         } else if (annotation == "fexgen::indirect_guest_calls") {
             ret.indirect_guest_calls = true;
+        } else if (annotation == "fexgen::batch_state_calls") {
+            ret.batch_state_calls = true;
         } else {
             throw report_error(base.getSourceRange().getBegin(), "Unknown namespace annotation");
         }
@@ -187,6 +201,10 @@ struct Annotations {
 
     bool returns_guest_pointer = false;
 
+    bool no_batch = false;
+
+    bool record_command = false;
+
     std::optional<clang::QualType> uniform_va_type;
 
     CallbackStrategy callback_strategy = CallbackStrategy::Default;
@@ -208,6 +226,10 @@ static Annotations GetAnnotations(clang::ASTContext& context, clang::CXXRecordDe
             ret.callback_strategy = CallbackStrategy::Guest;
         } else if (annotation == "fexgen::custom_guest_entrypoint") {
             ret.custom_guest_entrypoint = true;
+        } else if (annotation == "fexgen::no_batch") {
+            ret.no_batch = true;
+        } else if (annotation == "fexgen::record_command") {
+            ret.record_command = true;
         } else {
             throw report_error(base.getSourceRange().getBegin(), "Unknown annotation");
         }
@@ -254,6 +276,16 @@ public:
     }
 };
 
+// Handle to an object the host library never exposes the layout of, e.g. a Vulkan command buffer
+static bool IsOpaqueHandle(clang::QualType type) {
+    return type->isPointerType() && type->getPointeeType()->isRecordType() && type->getPointeeType()->isIncompleteType();
+}
+
+// Type identifying the command stream a call with the given first parameter belongs to
+static const clang::Type* GetCommandStreamType(clang::QualType type) {
+    return type.getCanonicalType().getUnqualifiedType().getTypePtr();
+}
+
 class GenerateThunkLibsAction : public clang::ASTFrontendAction {
 public:
     GenerateThunkLibsAction(const std::string& libname, const OutputFilenames&);
@@ -266,6 +298,16 @@ private:
     // Build the internal API representation by processing fex_gen_config and other annotated entities
     void ParseInterface(clang::ASTContext&);
 
+    // Checks if calls with the given parameters are recorded in or flush a command stream
+    bool UsesCommandStream(const std::vector<clang::QualType>& param_types) const {
+        return !param_types.empty() && command_stream_types.count(GetCommandStreamType(param_types[0]));
+    }
+
+    bool UsesCommandStream(const clang::Type* funcptr_type) const {
+        auto funcptr = llvm::dyn_cast<clang::FunctionProtoType>(funcptr_type);
+        return funcptr && UsesCommandStream(funcptr->getParamTypes().vec());
+    }
+
     // Generate helper code for thunk libraries and write them to the output file
     void EmitOutput();
 
@@ -276,6 +318,14 @@ private:
     std::vector<ThunkedFunction> thunks;
     std::vector<ThunkedAPIFunction> thunked_api;
     std::unordered_set<const clang::Type*> funcptr_types;
+    // Signatures of indirectly callable functions, mapped to whether all functions with this signature are batched
+    std::unordered_map<const clang::Type*, bool> batched_funcptr_types;
+    // Signatures of indirectly callable functions, mapped to whether all functions with this signature are recorded
+    std::unordered_map<const clang::Type*, bool> recorded_funcptr_types;
+    // Types of the first parameter of recorded functions, other calls taking these flush the command stream first
+    std::unordered_set<const clang::Type*> command_stream_types;
+    // Signatures of indirectly callable functions that 64-bit guests call with arguments in registers
+    std::unordered_set<const clang::Type*> register_funcptr_types;
     std::optional<unsigned> lib_version;
     std::vector<NamespaceInfo> namespaces;
 };
@@ -339,6 +389,20 @@ void GenerateThunkLibsAction::ExecuteAction() {
     }
 }
 
+// Types passed in a single integer register by both the x86-64 and the host ABI.
+// Must match IsRegisterType in ThunkLibs/include/common/PackedArguments.h, which checks host -> guest callbacks.
+static bool IsRegisterType(clang::ASTContext& context, clang::QualType type) {
+    return (type->isIntegralOrEnumerationType() || type->isPointerType()) && context.getTypeSize(type) <= 64;
+}
+
+// OP_THUNK passes the first six integer argument registers of the guest to the host function
+static bool IsRegisterSignature(clang::ASTContext& context, clang::QualType return_type,
+                                const std::vector<clang::QualType>& param_types, std::size_t max_params) {
+    return param_types.size() <= max_params &&
+           (return_type->isVoidType() || IsRegisterType(context, return_type)) &&
+           std::all_of(param_types.begin(), param_types.end(), [&](clang::QualType type) { return IsRegisterType(context, type); });
+}
+
 void GenerateThunkLibsAction::ParseInterface(clang::ASTContext& context) {
     ErrorReporter report_error { context };
 
@@ -368,7 +432,8 @@ void GenerateThunkLibsAction::ParseInterface(clang::ASTContext& context) {
                                     namespace_decl ? namespace_decl->getNameAsString() : "",
                                     annotations.load_host_endpoint_via.value_or(""),
                                     annotations.generate_guest_symtable,
-                                    annotations.indirect_guest_calls });
+                                    annotations.indirect_guest_calls,
+                                    annotations.batch_state_calls });
             const auto namespace_idx = namespaces.size() - 1;
             const NamespaceInfo& namespace_info = namespaces.back();
 
@@ -470,15 +535,72 @@ void GenerateThunkLibsAction::ParseInterface(clang::ASTContext& context) {
                     data.custom_host_impl = true;
                 }
 
+                if (namespace_info.batch_state_calls && !annotations.no_batch) {
+                    // Arguments must be complete by the time of the call, so anything referring to guest memory is excluded
+                    auto is_batchable_param = [](clang::QualType type) {
+                        return type->isArithmeticType() || type->isEnumeralType();
+                    };
+                    data.is_batched = return_type->isVoidType() && !data.is_variadic &&
+                                      std::all_of(data.param_types.begin(), data.param_types.end(), is_batchable_param);
+                }
+
+                if (annotations.record_command) {
+                    if (data.is_batched) {
+                        throw report_error(decl->getBeginLoc(), "record_command can't be used with batch_state_calls");
+                    }
+                    if (!return_type->isVoidType() || data.is_variadic || !data.callbacks.empty() ||
+                        data.param_types.empty() || !IsOpaqueHandle(data.param_types[0])) {
+                        throw report_error(decl->getBeginLoc(), "record_command requires a function without return value taking a handle as its first parameter");
+                    }
+
+                    // The host reads pointed-to data only at replay, so the guest entrypoint must copy it to the stream
+                    auto is_recordable_param = [](clang::QualType type) {
+                        return type->isArithmeticType() || type->isEnumeralType() || IsOpaqueHandle(type);
+                    };
+                    if (!annotations.custom_guest_entrypoint &&
+                        !std::all_of(data.param_types.begin(), data.param_types.end(), is_recordable_param)) {
+                        throw report_error(decl->getBeginLoc(), "record_command with pointer parameters requires custom_guest_entrypoint");
+                    }
+
+                    data.is_recorded = true;
+                    command_stream_types.insert(GetCommandStreamType(data.param_types[0]));
+                }
+
+                // Guest function pointers must be wrapped in host trampolines by the packer, so callbacks are excluded
+                data.is_register_call = !data.is_batched && !data.is_recorded && data.callbacks.empty() &&
+                                        IsRegisterSignature(context, return_type, data.param_types, 6);
+
                 // For indirect calls, register the function signature as a function pointer type
                 if (namespace_info.indirect_guest_calls) {
-                    funcptr_types.insert(context.getCanonicalType(emitted_function->getFunctionType()));
+                    auto type = context.getCanonicalType(emitted_function->getFunctionType()).getTypePtr();
+                    funcptr_types.insert(type);
+
+                    // Indirect calls only know the signature, so it must be safe to batch all functions sharing it
+                    batched_funcptr_types.try_emplace(type, true).first->second &= data.is_batched;
+
+                    // Indirect calls bypass custom guest entrypoints, which copy the data pointed to
+                    recorded_funcptr_types.try_emplace(type, true).first->second &= data.is_recorded && !annotations.custom_guest_entrypoint;
                 }
 
                 thunks.push_back(std::move(data));
             }
         }
     }
+
+    // Indirect calls pass the host function address as an extra argument.
+    // Libraries with batched calls always go through the batching wrappers instead.
+    const bool has_batched_calls = std::any_of(thunks.begin(), thunks.end(), [](const ThunkedFunction& thunk) { return thunk.is_batched; });
+    auto recorded_thunk = std::find_if(thunks.begin(), thunks.end(), [](const ThunkedFunction& thunk) { return thunk.is_recorded; });
+    if (has_batched_calls && recorded_thunk != thunks.end()) {
+        throw report_error(recorded_thunk->decl->getBeginLoc(), "record_command can't be used in libraries with batch_state_calls");
+    }
+    for (auto* type : funcptr_types) {
+        auto funcptr = llvm::dyn_cast<clang::FunctionProtoType>(type);
+        if (!has_batched_calls && funcptr && !funcptr->isVariadic() && !UsesCommandStream(type) &&
+            IsRegisterSignature(context, funcptr->getReturnType(), funcptr->getParamTypes().vec(), 5)) {
+            register_funcptr_types.insert(type);
+        }
+    }
 }
 
 void GenerateThunkLibsAction::EmitOutput() {
@@ -531,6 +653,42 @@ void GenerateThunkLibsAction::EmitOutput() {
         return fmt::format("{}CBFN{}", function_name, param_index);
     };
 
+    // Identifies a call in a batch, derived from the same hash as the thunk for unbatched calls
+    auto get_batch_id = [&](const std::string& function_name) {
+        auto sha256 = get_sha256(function_name);
+        uint64_t id = 0;
+        for (int i = 0; i < 8; ++i) {
+            id = (id << 8) | sha256[i];
+        }
+        return fmt::format("{:#x}ULL", id);
+    };
+
+    // Thunks taking arguments in registers use a separate entry point, since 32-bit guests need the packed variant
+    auto get_register_thunk_name = [](const std::string& function_name) {
+        return "fexregs_" + function_name;
+    };
+
+    // Flags byte of the guest stub of register thunks, see Guest.h. OP_THUNK only writes RAX if the function returns a value.
+    auto get_register_thunk_flags = [](clang::QualType return_type) {
+        return return_type->isVoidType() ? "0x1" : "0x3";
+    };
+
+    auto is_batched_funcptr = [this](const clang::Type* type) {
+        auto it = batched_funcptr_types.find(type);
+        return it != batched_funcptr_types.end() && it->second;
+    };
+
+    auto is_recorded_funcptr = [this](const clang::Type* type) {
+        auto it = recorded_funcptr_types.find(type);
+        return it != recorded_funcptr_types.end() && it->second;
+    };
+
+    const bool has_batched_calls = std::any_of(thunks.begin(), thunks.end(), [](const ThunkedFunction& thunk) { return thunk.is_batched; });
+    const bool has_recorded_calls = !command_stream_types.empty();
+    const std::string batch_flush_name = "fexbatch_flush";
+    const std::string call_batch = "CallBatch<fexthunks_" + libname + "_" + batch_flush_name + ">";
+    const std::string command_streams = "CommandStreams<fexthunks_" + libname + "_" + batch_flush_name + ">";
+
     // Files used guest-side
     if (!output_filenames.guest.empty()) {
         std::ofstream file(output_filenames.guest);
@@ -542,6 +700,15 @@ void GenerateThunkLibsAction::EmitOutput() {
             auto sha256 = get_sha256(function_name);
             fmt::print( file, "MAKE_THUNK({}, {}, \"{:#02x}\")\n",
                         libname, function_name, fmt::join(sha256, ", "));
+            if (thunk.is_register_call) {
+                fmt::print( file, "MAKE_REGISTER_THUNK({}, {}, \"{:#02x}\", \"{}\")\n",
+                            libname, get_register_thunk_name(function_name), fmt::join(get_sha256(get_register_thunk_name(function_name)), ", "),
+                            get_register_thunk_flags(thunk.return_type));
+            }
+        }
+        if (has_batched_calls || has_recorded_calls) {
+            fmt::print( file, "MAKE_THUNK({}, {}, \"{:#02x}\")\n",
+                        libname, batch_flush_name, fmt::join(get_sha256(batch_flush_name), ", "));
         }
         file << "}\n";
 
@@ -555,8 +722,30 @@ void GenerateThunkLibsAction::EmitOutput() {
             // Thunk used for guest-side calls to host function pointers
             file << "  // " << funcptr_signature << "\n";
             auto funcptr_idx = std::distance(funcptr_types.begin(), type_it);
-            fmt::print( file, "  MAKE_CALLBACK_THUNK(callback_{}, {}, \"{:#02x}\");\n",
-                        funcptr_idx, funcptr_signature, fmt::join(cb_sha256, ", "));
+            if (is_batched_funcptr(type)) {
+                fmt::print( file, "  MAKE_BATCHED_CALLBACK_THUNK(callback_{}, {}, \"{:#02x}\", fexthunks_{}_{}, {});\n",
+                            funcptr_idx, funcptr_signature, fmt::join(cb_sha256, ", "),
+                            libname, batch_flush_name, get_batch_id("fexcallback_" + funcptr_signature));
+            } else if (has_batched_calls) {
+                fmt::print( file, "  MAKE_FLUSHING_CALLBACK_THUNK(callback_{}, {}, \"{:#02x}\", fexthunks_{}_{});\n",
+                            funcptr_idx, funcptr_signature, fmt::join(cb_sha256, ", "), libname, batch_flush_name);
+            } else if (is_recorded_funcptr(type)) {
+                fmt::print( file, "  MAKE_RECORDED_CALLBACK_THUNK(callback_{}, {}, \"{:#02x}\", fexthunks_{}_{}, {});\n",
+                            funcptr_idx, funcptr_signature, fmt::join(cb_sha256, ", "),
+                            libname, batch_flush_name, get_batch_id("fexcallback_" + funcptr_signature));
+            } else if (UsesCommandStream(type)) {
+                fmt::print( file, "  MAKE_STREAM_FLUSHING_CALLBACK_THUNK(callback_{}, {}, \"{:#02x}\", fexthunks_{}_{});\n",
+                            funcptr_idx, funcptr_signature, fmt::join(cb_sha256, ", "), libname, batch_flush_name);
+            } else {
+                fmt::print( file, "  MAKE_CALLBACK_THUNK(callback_{}, {}, \"{:#02x}\");\n",
+                            funcptr_idx, funcptr_signature, fmt::join(cb_sha256, ", "));
+            }
+
+            if (register_funcptr_types.count(type)) {
+                fmt::print( file, "  MAKE_REGISTER_CALLBACK_THUNK(regcallback_{}, {}, \"{:#02x}\", \"{}\");\n",
+                            funcptr_idx, funcptr_signature, fmt::join(get_sha256("fexregcallback_" + funcptr_signature), ", "),
+                            get_register_thunk_flags(llvm::cast<clang::FunctionProtoType>(type)->getReturnType()));
+            }
         }
 
         // Thunks-internal packing functions
@@ -571,6 +760,19 @@ void GenerateThunkLibsAction::EmitOutput() {
             }
             // Using trailing return type as it makes handling function pointer returns much easier
             file << ") -> " << data.return_type.getAsString() << " {\n";
+            if (data.is_register_call) {
+                file << "#if FEX_REGISTER_THUNKS\n";
+                if (has_batched_calls) {
+                    file << "  " << call_batch << "::Flush();\n";
+                }
+                if (UsesCommandStream(data.param_types)) {
+                    file << "  " << command_streams << "::Flush(a_0);\n";
+                }
+                fmt::print( file, "  return CallThunkWithRegisters<fexthunks_{}_{}, {}>({});\n",
+                            libname, get_register_thunk_name(function_name), data.return_type.getAsString(),
+                            format_function_args(data, [](std::size_t idx) { return fmt::format("a_{}", idx); }));
+                file << "#else\n";
+            }
             file << "  struct {\n";
             for (std::size_t idx = 0; idx < data.param_types.size(); ++idx) {
                 auto& type = data.param_types[idx];
@@ -595,10 +797,31 @@ void GenerateThunkLibsAction::EmitOutput() {
                     fmt::print(file, "AllocateHostTrampolineForGuestFunction(a_{});\n", idx);
                 }
             }
-            file << "  fexthunks_" << libname << "_" << function_name << "(&args);\n";
+            if (data.is_batched) {
+                fmt::print(file, "  if (!{}::Append({}, &args, sizeof(args))) {{\n", call_batch, get_batch_id(function_name));
+                file << "    fexthunks_" << libname << "_" << function_name << "(&args);\n";
+                file << "  }\n";
+            } else if (data.is_recorded) {
+                fmt::print(file, "  if (!{}::Append(a_0, {}, &args, sizeof(args))) {{\n", command_streams, get_batch_id(function_name));
+                file << "    fexthunks_" << libname << "_" << function_name << "(&args);\n";
+                file << "  }\n";
+            } else {
+                if (has_batched_calls) {
+                    // Calls recorded earlier must execute first
+                    file << "  " << call_batch << "::Flush();\n";
+                }
+                if (UsesCommandStream(data.param_types)) {
+                    // Calls recorded earlier for the same object must execute first
+                    file << "  " << command_streams << "::Flush(a_0);\n";
+                }
+                file << "  fexthunks_" << libname << "_" << function_name << "(&args);\n";
+            }
             if (!is_void) {
                 file << "  return args.rv;\n";
             }
+            if (data.is_register_call) {
+                file << "#endif\n";
+            }
             file << "}\n";
         }
         file << "}\n";
@@ -730,9 +953,44 @@ void GenerateThunkLibsAction::EmitOutput() {
             }
             file << ");\n";
             file << "}\n";
+
+            // Called by OP_THUNK with the arguments in host registers
+            if (thunk.is_register_call) {
+                file << "static auto fexfn_unpack_" << libname << "_" << get_register_thunk_name(function_name) << "("
+                     << format_function_params(thunk) << ") -> " << thunk.return_type.getAsString() << " {\n";
+                file << "  return " << function_to_call << "("
+                     << format_function_args(thunk, [](std::size_t idx) { return fmt::format("a_{}", idx); }) << ");\n";
+                file << "}\n";
+            }
         }
         file << "}\n";
 
+        // Executes the calls recorded by the guest in order
+        if (has_batched_calls || has_recorded_calls) {
+            file << "static void fexfn_unpack_" << libname << "_" << batch_flush_name << "(BatchedCallRange* args) {\n";
+            file << "  for (auto call = args->Begin; call != args->End; call = call->Next()) {\n";
+            file << "    switch (call->Id) {\n";
+            for (auto& thunk : thunks) {
+                if (thunk.is_batched || thunk.is_recorded) {
+                    fmt::print( file, "    case {}: fexfn_unpack_{}_{}(static_cast<fexfn_packed_args_{}_{}*>(call->Args())); break;\n",
+                                get_batch_id(thunk.function_name), libname, thunk.function_name, libname, thunk.function_name);
+                }
+            }
+            for (auto& type : funcptr_types) {
+                if (is_batched_funcptr(type) || is_recorded_funcptr(type)) {
+                    std::string mangled_name = clang::QualType { type, 0 }.getAsString();
+                    fmt::print( file, "    case {}: CallbackUnpack<{}>::ForIndirectCall(call->Args()); break;\n",
+                                get_batch_id("fexcallback_" + mangled_name), mangled_name);
+                }
+            }
+            file << "    default:\n";
+            file << "      fprintf(stderr, \"FATAL: Unknown batched call %#llx\\n\", static_cast<unsigned long long>(call->Id));\n";
+            file << "      std::abort();\n";
+            file << "    }\n";
+            file << "  }\n";
+            file << "}\n";
+        }
+
         // Endpoints for Guest->Host invocation of API functions
         file << "static ExportEntry exports[] = {\n";
         for (auto& thunk : thunks) {
@@ -740,6 +998,11 @@ void GenerateThunkLibsAction::EmitOutput() {
             auto sha256 = get_sha256(function_name);
             fmt::print( file, "  {{(uint8_t*)\"\\x{:02x}\", (void(*)(void *))&fexfn_unpack_{}_{}}}, // {}:{}\n",
                         fmt::join(sha256, "\\x"), libname, function_name, libname, function_name);
+            if (thunk.is_register_call) {
+                const auto register_name = get_register_thunk_name(function_name);
+                fmt::print( file, "  {{(uint8_t*)\"\\x{:02x}\", (void(*)(void *))&fexfn_unpack_{}_{}}}, // {}:{}\n",
+                            fmt::join(get_sha256(register_name), "\\x"), libname, register_name, libname, register_name);
+            }
         }
 
         // Endpoints for Guest->Host invocation of runtime host-function pointers
@@ -748,6 +1011,14 @@ void GenerateThunkLibsAction::EmitOutput() {
             auto cb_sha256 = get_sha256("fexcallback_" + mangled_name);
             fmt::print( file, "  {{(uint8_t*)\"\\x{:02x}\", (void(*)(void *))&CallbackUnpack<{}>::ForIndirectCall}},\n",
                         fmt::join(cb_sha256, "\\x"), mangled_name);
+            if (register_funcptr_types.count(type)) {
+                fmt::print( file, "  {{(uint8_t*)\"\\x{:02x}\", (void(*)(void *))&CallbackUnpack<{}>::ForIndirectRegisterCall}},\n",
+                            fmt::join(get_sha256("fexregcallback_" + mangled_name), "\\x"), mangled_name);
+            }
+        }
+        if (has_batched_calls || has_recorded_calls) {
+            fmt::print( file, "  {{(uint8_t*)\"\\x{:02x}\", (void(*)(void *))&fexfn_unpack_{}_{}}},\n",
+                        fmt::join(get_sha256(batch_flush_name), "\\x"), libname, batch_flush_name);
         }
         file << "  { nullptr, nullptr }\n";
         file << "};\n";
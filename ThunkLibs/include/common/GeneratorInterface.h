@@ -3,9 +3,25 @@ struct returns_guest_pointer {};
 struct custom_host_impl {};
 struct custom_guest_entrypoint {};
 
+// Opts a function out of batch_state_calls, e.g. because it reads guest memory
+// referenced by earlier calls or because it needs to synchronize with the host.
+struct no_batch {};
+
 struct generate_guest_symtable {};
 struct indirect_guest_calls {};
 
+// Defer calls to functions without return value and with only arithmetic or
+// enum parameters, and execute them on the host in bulk at the next call to
+// any other function of this library.
+struct batch_state_calls {};
+
+// Record calls in a stream belonging to the handle passed as first argument,
+// and execute them on the host in bulk at the next call of this library that
+// takes the same handle but isn't recorded. Parameters other than handles,
+// arithmetic and enum types require a custom_guest_entrypoint that copies the
+// data pointed to in to the stream.
+struct record_command {};
+
 struct callback_annotation_base {
     // Prevent annotating multiple callback strategies
     bool prevent_multiple;
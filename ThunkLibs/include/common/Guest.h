@@ -1,6 +1,13 @@
 #pragma once
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <stdint.h>
+#include <stdlib.h>
 #include <type_traits>
+#include <unordered_map>
+#include <vector>
 
 #include "PackedArguments.h"
 
@@ -18,16 +25,73 @@ template<typename signature>
 THUNK_ABI
 const int (*fexthunks_invoke_callback)(void*);
 
+// Functions that only take and return integers and pointers don't need their arguments packed on 64-bit guests.
+// OP_THUNK passes the guest argument registers to the host function unchanged and stores its result in RAX,
+// so these thunks are called with the original function signature.
+// 32-bit guests pass arguments on the stack and always use packed arguments.
+#if __SIZEOF_POINTER__ == 8
+#define FEX_REGISTER_THUNKS 1
+#else
+#define FEX_REGISTER_THUNKS 0
+#endif
+
+// Register variant of fexthunks_invoke_callback, only available for signatures with at most five arguments
+template<typename signature>
+inline constexpr bool fexthunks_has_register_callback = false;
+
+template<typename signature>
+const int (*fexthunks_invoke_register_callback)(void*);
+
+// Guest stubs for OP_THUNK are `0F 3F`, followed by the SHA256 of the thunk name and a byte of flags.
+// The flags tell FEX how to call the host function, so the code it generates for a stub only depends on the stub:
+//   0x1: Arguments are in the guest argument registers, see FEX_REGISTER_THUNKS
+//   0x2: The host function returns an integer, which is stored to RAX
+// Thunks with packed arguments use no flags.
+
 #ifndef _M_ARM_64
 #define MAKE_THUNK(lib, name, hash) \
   extern "C" __attribute__((visibility("hidden"))) THUNK_ABI int fexthunks_##lib##_##name(void *args); \
-  asm(".text\nfexthunks_" #lib "_" #name ":\n.byte 0xF, 0x3F\n.byte " hash );
+  asm(".text\nfexthunks_" #lib "_" #name ":\n.byte 0xF, 0x3F\n.byte " hash "\n.byte 0" );
 
 #define MAKE_CALLBACK_THUNK(name, signature, hash) \
   extern "C" __attribute__((visibility("hidden"))) THUNK_ABI int fexthunks_##name(void *args); \
-  asm(".text\nfexthunks_" #name ":\n.byte 0xF, 0x3F\n.byte " hash ); \
+  asm(".text\nfexthunks_" #name ":\n.byte 0xF, 0x3F\n.byte " hash "\n.byte 0" ); \
   template<> THUNK_ABI inline constexpr int (*fexthunks_invoke_callback<signature>)(void*) = fexthunks_##name;
 
+#define MAKE_REGISTER_THUNK(lib, name, hash, flags) \
+  extern "C" __attribute__((visibility("hidden"))) int fexthunks_##lib##_##name(void *args); \
+  asm(".text\nfexthunks_" #lib "_" #name ":\n.byte 0xF, 0x3F\n.byte " hash "\n.byte " flags );
+
+#define MAKE_REGISTER_CALLBACK_THUNK(name, signature, hash, flags) \
+  extern "C" __attribute__((visibility("hidden"))) int fexthunks_##name(void *args); \
+  asm(".text\nfexthunks_" #name ":\n.byte 0xF, 0x3F\n.byte " hash "\n.byte " flags ); \
+  template<> inline constexpr int (*fexthunks_invoke_register_callback<signature>)(void*) = fexthunks_##name; \
+  template<> inline constexpr bool fexthunks_has_register_callback<signature> = true;
+
+#define MAKE_BATCHED_CALLBACK_THUNK(name, signature, hash, flush_thunk, id) \
+  extern "C" __attribute__((visibility("hidden"))) THUNK_ABI int fexthunks_##name(void *args); \
+  asm(".text\nfexthunks_" #name ":\n.byte 0xF, 0x3F\n.byte " hash "\n.byte 0" ); \
+  template<> THUNK_ABI inline constexpr int (*fexthunks_invoke_callback<signature>)(void*) = \
+    BatchedCall<fexthunks_##name, flush_thunk, id, typename IndirectCallArgs<signature>::type>;
+
+#define MAKE_FLUSHING_CALLBACK_THUNK(name, signature, hash, flush_thunk) \
+  extern "C" __attribute__((visibility("hidden"))) THUNK_ABI int fexthunks_##name(void *args); \
+  asm(".text\nfexthunks_" #name ":\n.byte 0xF, 0x3F\n.byte " hash "\n.byte 0" ); \
+  template<> THUNK_ABI inline constexpr int (*fexthunks_invoke_callback<signature>)(void*) = \
+    FlushingCall<fexthunks_##name, flush_thunk>;
+
+#define MAKE_RECORDED_CALLBACK_THUNK(name, signature, hash, flush_thunk, id) \
+  extern "C" __attribute__((visibility("hidden"))) THUNK_ABI int fexthunks_##name(void *args); \
+  asm(".text\nfexthunks_" #name ":\n.byte 0xF, 0x3F\n.byte " hash "\n.byte 0" ); \
+  template<> THUNK_ABI inline constexpr int (*fexthunks_invoke_callback<signature>)(void*) = \
+    RecordedCall<fexthunks_##name, flush_thunk, id, typename IndirectCallArgs<signature>::type>;
+
+#define MAKE_STREAM_FLUSHING_CALLBACK_THUNK(name, signature, hash, flush_thunk) \
+  extern "C" __attribute__((visibility("hidden"))) THUNK_ABI int fexthunks_##name(void *args); \
+  asm(".text\nfexthunks_" #name ":\n.byte 0xF, 0x3F\n.byte " hash "\n.byte 0" ); \
+  template<> THUNK_ABI inline constexpr int (*fexthunks_invoke_callback<signature>)(void*) = \
+    StreamFlushingCall<fexthunks_##name, flush_thunk, typename IndirectCallArgs<signature>::type>;
+
 #else
 // We're compiling for IDE integration, so provide a dummy-implementation that just calls an undefined function.
 // The name of that function serves as an error message if this library somehow gets loaded at runtime.
@@ -40,8 +104,316 @@ extern "C" void BROKEN_INSTALL___TRIED_LOADING_AARCH64_BUILD_OF_GUEST_THUNK();
 #define MAKE_CALLBACK_THUNK(name, signature, hash) \
   extern "C" int fexthunks_##name(void *args); \
   template<> inline constexpr int (*fexthunks_invoke_callback<signature>)(void*) = fexthunks_##name;
+#define MAKE_REGISTER_THUNK(lib, name, hash, flags) \
+  MAKE_THUNK(lib, name, hash)
+#define MAKE_REGISTER_CALLBACK_THUNK(name, signature, hash, flags) \
+  extern "C" int fexthunks_##name(void *args); \
+  template<> inline constexpr int (*fexthunks_invoke_register_callback<signature>)(void*) = fexthunks_##name; \
+  template<> inline constexpr bool fexthunks_has_register_callback<signature> = true;
+#define MAKE_BATCHED_CALLBACK_THUNK(name, signature, hash, flush_thunk, id) \
+  MAKE_CALLBACK_THUNK(name, signature, hash)
+#define MAKE_FLUSHING_CALLBACK_THUNK(name, signature, hash, flush_thunk) \
+  MAKE_CALLBACK_THUNK(name, signature, hash)
+#define MAKE_RECORDED_CALLBACK_THUNK(name, signature, hash, flush_thunk, id) \
+  MAKE_CALLBACK_THUNK(name, signature, hash)
+#define MAKE_STREAM_FLUSHING_CALLBACK_THUNK(name, signature, hash, flush_thunk) \
+  MAKE_CALLBACK_THUNK(name, signature, hash)
 #endif
 
+// Per-thread batch of calls that are recorded in guest memory and executed on
+// the host in bulk, by a single invocation of FlushThunk.
+//
+// Only calls without return value or pointer arguments are batched
+// (see fexgen::batch_state_calls), all other calls of the library flush the
+// batch first. Calls made while the batch is being flushed, e.g. from guest
+// callbacks, are executed immediately.
+//
+// Setting FEX_THUNKS_NO_BATCHING in the environment disables batching.
+template<auto FlushThunk>
+class CallBatch {
+  static constexpr size_t Capacity = 64 * 1024;
+
+  struct Buffer {
+    alignas(16) unsigned char Data[Capacity];
+    size_t Used = 0;
+    bool Flushing = false;
+
+    ~Buffer() {
+      // Don't lose calls recorded right before the thread exits
+      Flush();
+    }
+
+    void Flush() {
+      if (Used == 0 || Flushing) {
+        return;
+      }
+
+      Flushing = true;
+      BatchedCallRange Range {
+        reinterpret_cast<BatchedCallHeader*>(Data),
+        reinterpret_cast<BatchedCallHeader*>(Data + Used),
+      };
+      FlushThunk(&Range);
+      Used = 0;
+      Flushing = false;
+    }
+  };
+
+  static inline thread_local std::unique_ptr<Buffer> Current;
+
+  static Buffer* Get() {
+    static const bool Enabled = !getenv("FEX_THUNKS_NO_BATCHING");
+    if (!Current && Enabled) {
+      Current.reset(new Buffer);
+    }
+    return Current.get();
+  }
+
+public:
+  // Returns false if the call must be executed immediately instead
+  static bool Append(uint64_t Id, const void *Args, size_t ArgsSize) {
+    auto Batch = Get();
+    if (!Batch || Batch->Flushing) {
+      return false;
+    }
+
+    const size_t Size = (sizeof(BatchedCallHeader) + ArgsSize + 7) & ~size_t{7};
+    if (Batch->Used + Size > Capacity) {
+      Batch->Flush();
+    }
+
+    auto Call = reinterpret_cast<BatchedCallHeader*>(Batch->Data + Batch->Used);
+    Call->Id = Id;
+    Call->Size = Size;
+    Call->Reserved = 0;
+    __builtin_memcpy(Call->Args(), Args, ArgsSize);
+    Batch->Used += Size;
+    return true;
+  }
+
+  static void Flush() {
+    if (auto Batch = Current.get()) {
+      Batch->Flush();
+    }
+  }
+};
+
+// Streams of calls recorded in guest memory, one per object passed as the
+// first argument (e.g. a Vulkan command buffer). The calls are executed on the
+// host in bulk, by invoking FlushThunk once per block of the stream.
+//
+// Only calls annotated with fexgen::record_command are recorded. Any other
+// call taking the same type of object as its first argument replays the
+// stream of that object first. Unlike CallBatch, streams don't belong to a
+// thread, since an object may be recorded on one thread and finished on
+// another.
+//
+// Guest entrypoints of recorded calls with pointer arguments must Copy the
+// data they point to, since the guest may change it before the replay.
+//
+// Setting FEX_THUNKS_NO_BATCHING in the environment disables recording.
+template<auto FlushThunk>
+class CommandStreams {
+  static constexpr size_t BlockSize = 64 * 1024;
+
+  struct Block {
+    alignas(16) unsigned char Data[BlockSize];
+    size_t Used = 0;
+  };
+
+  struct Stream {
+    // Recorded calls, replayed in order
+    std::vector<std::unique_ptr<Block>> Calls;
+    // Data referenced by the recorded calls, never walked by the host
+    std::vector<std::unique_ptr<Block>> Data;
+    // Data too large for a block
+    std::vector<std::unique_ptr<unsigned char[]>> LargeData;
+    bool Replaying = false;
+
+    void* Allocate(std::vector<std::unique_ptr<Block>>& Blocks, size_t Size) {
+      if (Blocks.empty() || Blocks.back()->Used + Size > BlockSize) {
+        Blocks.emplace_back(new Block);
+      }
+      auto Result = Blocks.back()->Data + Blocks.back()->Used;
+      Blocks.back()->Used += Size;
+      return Result;
+    }
+
+    // Drops all recorded calls, keeping one block of each kind around for the next recording unless Release is set
+    void Reset(bool Release) {
+      Calls.resize(Release ? 0 : std::min<size_t>(Calls.size(), 1));
+      Data.resize(Release ? 0 : std::min<size_t>(Data.size(), 1));
+      LargeData.clear();
+      for (auto& Blocks : { &Calls, &Data }) {
+        for (auto& Block : *Blocks) {
+          Block->Used = 0;
+        }
+      }
+    }
+  };
+
+  static inline std::mutex Mutex;
+  static inline std::unordered_map<const void*, std::unique_ptr<Stream>> Streams;
+
+  // Bumped whenever a stream is erased, which invalidates the lookup cache of every thread.
+  // Handles of destroyed objects may be reused, so a stale cache entry could otherwise match a new object.
+  static inline std::atomic<uint64_t> Generation;
+
+  static inline thread_local const void* CachedKey;
+  static inline thread_local Stream* CachedStream;
+  static inline thread_local uint64_t CachedGeneration;
+
+  static Stream* Get(const void* Key, bool Create) {
+    if (CachedStream && CachedKey == Key && CachedGeneration == Generation.load(std::memory_order_acquire)) {
+      return CachedStream;
+    }
+
+    std::lock_guard lk {Mutex};
+    auto It = Streams.find(Key);
+    if (It == Streams.end()) {
+      if (!Create) {
+        return nullptr;
+      }
+      It = Streams.emplace(Key, new Stream).first;
+    }
+    CachedKey = Key;
+    CachedStream = It->second.get();
+    CachedGeneration = Generation.load(std::memory_order_relaxed);
+    return CachedStream;
+  }
+
+  // Returns the stream calls for Key are recorded to, or nullptr if they must be executed immediately
+  static Stream* GetRecording(const void* Key) {
+    static const bool Enabled = !getenv("FEX_THUNKS_NO_BATCHING");
+    if (!Enabled) {
+      return nullptr;
+    }
+
+    auto Current = Get(Key, true);
+    return Current->Replaying ? nullptr : Current;
+  }
+
+public:
+  // Returns false if the call must be executed immediately instead
+  static bool Append(const void* Key, uint64_t Id, const void *Args, size_t ArgsSize) {
+    auto Current = GetRecording(Key);
+    if (!Current) {
+      return false;
+    }
+
+    const size_t Size = (sizeof(BatchedCallHeader) + ArgsSize + 7) & ~size_t{7};
+    auto Call = reinterpret_cast<BatchedCallHeader*>(Current->Allocate(Current->Calls, Size));
+    Call->Id = Id;
+    Call->Size = Size;
+    Call->Reserved = 0;
+    __builtin_memcpy(Call->Args(), Args, ArgsSize);
+    return true;
+  }
+
+  // Copies data referenced by a call that is about to be recorded, the copy lives until the stream is replayed.
+  // Returns Data itself if the call will be executed immediately.
+  static const void* Copy(const void* Key, const void* Data, size_t Size) {
+    auto Current = GetRecording(Key);
+    if (!Current || !Data || Size == 0) {
+      return Data;
+    }
+
+    void* Result;
+    if (Size > BlockSize / 4) {
+      Result = Current->LargeData.emplace_back(new unsigned char[Size]).get();
+    } else {
+      Result = Current->Allocate(Current->Data, (Size + 15) & ~size_t{15});
+    }
+    __builtin_memcpy(Result, Data, Size);
+    return Result;
+  }
+
+  template<typename T>
+  static const T* Copy(const void* Key, const T* Data, size_t Count) {
+    return static_cast<const T*>(Copy(Key, static_cast<const void*>(Data), Count * sizeof(T)));
+  }
+
+  // Executes the calls recorded for Key on the host
+  static void Flush(const void* Key) {
+    auto Current = Get(Key, false);
+    if (!Current || Current->Calls.empty() || Current->Calls.front()->Used == 0 || Current->Replaying) {
+      return;
+    }
+
+    Current->Replaying = true;
+    for (auto& Block : Current->Calls) {
+      BatchedCallRange Range {
+        reinterpret_cast<BatchedCallHeader*>(Block->Data),
+        reinterpret_cast<BatchedCallHeader*>(Block->Data + Block->Used),
+      };
+      FlushThunk(&Range);
+    }
+    Current->Replaying = false;
+    Current->Reset(false);
+  }
+
+  // Drops the calls recorded for Key without executing them, e.g. because the object was reset.
+  // Release also frees the blocks of the stream, for objects that are reset with their resources released.
+  static void Discard(const void* Key, bool Release) {
+    if (auto Current = Get(Key, false)) {
+      Current->Reset(Release);
+    }
+  }
+
+  // Drops the stream of an object that is destroyed, along with any calls recorded to it
+  static void Erase(const void* Key) {
+    std::lock_guard lk {Mutex};
+    if (Streams.erase(Key)) {
+      Generation.fetch_add(1, std::memory_order_release);
+    }
+    CachedStream = nullptr;
+  }
+};
+
+template<typename>
+struct IndirectCallArgs;
+
+// Layout used by CallHostFunction
+template<typename Result, typename... Args>
+struct IndirectCallArgs<Result(Args...)> {
+  using type = PackedArguments<Result, Args..., uintptr_t>;
+};
+
+template<auto Thunk, auto FlushThunk, uint64_t Id, typename PackedArgs>
+THUNK_ABI int BatchedCall(void *args) {
+  if (CallBatch<FlushThunk>::Append(Id, args, sizeof(PackedArgs))) {
+    return 0;
+  }
+  return Thunk(args);
+}
+
+template<auto Thunk, auto FlushThunk>
+THUNK_ABI int FlushingCall(void *args) {
+  CallBatch<FlushThunk>::Flush();
+  return Thunk(args);
+}
+
+template<auto Thunk, auto FlushThunk, uint64_t Id, typename PackedArgs>
+THUNK_ABI int RecordedCall(void *args) {
+  if (CommandStreams<FlushThunk>::Append(reinterpret_cast<PackedArgs*>(args)->a0, Id, args, sizeof(PackedArgs))) {
+    return 0;
+  }
+  return Thunk(args);
+}
+
+template<auto Thunk, auto FlushThunk, typename PackedArgs>
+THUNK_ABI int StreamFlushingCall(void *args) {
+  CommandStreams<FlushThunk>::Flush(reinterpret_cast<PackedArgs*>(args)->a0);
+  return Thunk(args);
+}
+
+// Calls a register thunk with the original function signature, see FEX_REGISTER_THUNKS
+template<auto Thunk, typename Result, typename... Args>
+inline Result CallThunkWithRegisters(Args... args) {
+  static_assert(sizeof...(Args) <= 6, "Only six arguments are passed in registers");
+  return reinterpret_cast<Result(*)(Args...)>(Thunk)(args...);
+}
+
 // Generated fexfn_pack_ symbols should be hidden by default, but clang does
 // not support aliasing to static functions. Make them regular non-static
 // functions on that compiler instead, hence.
@@ -133,6 +505,13 @@ inline Result CallHostFunction(Args... args) {
   uintptr_t host_addr = 0;
 #endif
 
+#if FEX_REGISTER_THUNKS
+  if constexpr (fexthunks_has_register_callback<Result(Args...)>) {
+    // The host function address is passed in the register after the arguments
+    return CallThunkWithRegisters<fexthunks_invoke_register_callback<Result(Args...)>, Result>(args..., host_addr);
+  }
+#endif
+
   PackedArguments<Result, Args..., uintptr_t> packed_args = {
     args...,
     host_addr
@@ -161,8 +540,11 @@ inline void MakeHostFunctionGuestCallable(THUNK_ABI Result (*host_func)(Args...)
   LinkAddressToFunction((uintptr_t)host_func, (uintptr_t)caller);
 }
 
+// GuestRegisterUnpacker optionally provides a variant of GuestUnpacker that takes GuestTarget and the callback
+// arguments in registers, which the host uses instead of packing the arguments.
 template<typename Target>
-inline Target *AllocateHostTrampolineForGuestFunction(void (*GuestUnpacker)(uintptr_t, void*), Target *GuestTarget) {
+inline Target *AllocateHostTrampolineForGuestFunction(void (*GuestUnpacker)(uintptr_t, void*), Target *GuestTarget,
+                                                      uintptr_t GuestRegisterUnpacker = 0) {
   if (!GuestTarget) {
     return nullptr;
   }
@@ -170,8 +552,9 @@ inline Target *AllocateHostTrampolineForGuestFunction(void (*GuestUnpacker)(uint
   struct {
     uintptr_t GuestUnpacker;
     uintptr_t GuestTarget;
+    uintptr_t GuestRegisterUnpacker;
     uintptr_t rv;
-  } argsrv = { (uintptr_t)GuestUnpacker, (uintptr_t)GuestTarget };
+  } argsrv = { (uintptr_t)GuestUnpacker, (uintptr_t)GuestTarget, GuestRegisterUnpacker };
 
   fexthunks_fex_allocate_host_trampoline_for_guest_function((void*)&argsrv);
 
@@ -189,6 +572,21 @@ struct CallbackUnpack<Result(Args...)> {
         auto args = reinterpret_cast<PackedArguments<Result, Args...>*>(argsv);
         Invoke(callback, *args);
     }
+
+    // Register variant of Unpack, called by the host with cb in RDI and the arguments in the following registers
+    static Result UnpackRegisters(uintptr_t cb, Args... args) {
+        auto callback = reinterpret_cast<Result(*)(Args...)>(cb);
+        return callback(args...);
+    }
+
+    static uintptr_t GetRegisterUnpacker() {
+#if FEX_REGISTER_THUNKS
+        if constexpr (IsRegisterCallbackSignature<Result, Args...>) {
+            return (uintptr_t)&UnpackRegisters;
+        }
+#endif
+        return 0;
+    }
 };
 
 template<typename Result, typename... Args>
@@ -198,7 +596,8 @@ struct CallbackUnpack<Result(*)(Args...)> : CallbackUnpack<Result(Args...)> {
 template<typename Target>
 inline Target *AllocateHostTrampolineForGuestFunction(Target *GuestTarget) {
     return AllocateHostTrampolineForGuestFunction(CallbackUnpack<Target*>::Unpack,
-                                                  GuestTarget);
+                                                  GuestTarget,
+                                                  CallbackUnpack<Target*>::GetRegisterUnpacker());
 }
 
 inline bool IsHostHeapAllocation(void* ptr) {
@@ -95,8 +95,38 @@ struct GuestcallInfo {
   void (*CallCallback)(uintptr_t GuestUnpacker, uintptr_t GuestTarget, void* argsrv);
   uintptr_t GuestUnpacker;
   uintptr_t GuestTarget;
+  // Null if the guest ABI doesn't pass arguments in registers (32-bit guests)
+  uint64_t (*CallCallbackWithRegisters)(uintptr_t GuestRegisterUnpacker, uintptr_t GuestTarget, const uint64_t* Args, size_t NumArgs);
+  // Zero unless the guest allocated this trampoline with a register unpacker, see IsRegisterCallbackSignature
+  uintptr_t GuestRegisterUnpacker;
 };
 
+template<typename T>
+inline uint64_t ToRegister(T Value) {
+  if constexpr (std::is_pointer_v<T>) {
+    return reinterpret_cast<uintptr_t>(Value);
+  } else if constexpr (std::is_enum_v<T>) {
+    return ToRegister(static_cast<std::underlying_type_t<T>>(Value));
+  } else if constexpr (std::is_signed_v<T>) {
+    // Extend like the guest compiler would
+    return static_cast<uint64_t>(static_cast<int64_t>(Value));
+  } else {
+    return static_cast<uint64_t>(Value);
+  }
+}
+
+template<typename T>
+inline T FromRegister(uint64_t Value) {
+  if constexpr (std::is_pointer_v<T>) {
+    return reinterpret_cast<T>(Value);
+  } else if constexpr (std::is_same_v<T, bool>) {
+    // Only the low byte is defined
+    return static_cast<uint8_t>(Value) != 0;
+  } else {
+    return static_cast<T>(Value);
+  }
+}
+
 // Helper macro for reading an internal argument passed through the `r11`
 // host register. This macro must be placed at the very beginning of
 // the function it is used in.
@@ -117,6 +147,19 @@ struct CallbackUnpack<Result(Args...)> {
     GuestcallInfo *guestcall;
     LOAD_INTERNAL_GUESTPTR_VIA_CUSTOM_ABI(guestcall);
 
+    if constexpr (IsRegisterCallbackSignature<Result, Args...>) {
+      // Skip packing the arguments if the guest provided the register variant of its unpacker
+      if (guestcall->CallCallbackWithRegisters && guestcall->GuestRegisterUnpacker) {
+        const uint64_t Registers[sizeof...(Args) + 1] = { ToRegister(args)... };
+        const auto rv = guestcall->CallCallbackWithRegisters(guestcall->GuestRegisterUnpacker, guestcall->GuestTarget, Registers, sizeof...(Args));
+        if constexpr (!std::is_void_v<Result>) {
+          return FromRegister<Result>(rv);
+        } else {
+          return;
+        }
+      }
+    }
+
     PackedArguments<Result, Args...> packed_args = {
       args...
     };
@@ -176,6 +219,12 @@ struct CallbackUnpack<Result(Args...)> {
     auto callback = reinterpret_cast<Result(*)(Args..., uintptr_t)>(cb);
     Invoke(callback, *args);
   }
+
+  // Called by OP_THUNK with the arguments in host registers, followed by the host function address
+  static Result ForIndirectRegisterCall(Args... args, uintptr_t cb) {
+    auto callback = reinterpret_cast<Result(*)(Args...)>(cb);
+    return callback(args...);
+  }
 };
 
 template<typename FuncType>
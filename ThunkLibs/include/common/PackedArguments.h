@@ -196,3 +196,38 @@ void Invoke(Result(*func)(Args...), PackedArguments<Result, Args...>& args) {
         }
     }
 }
+
+// Guest->Host call recorded for deferred execution, immediately followed by its packed arguments.
+// Size covers both the header and the arguments, and keeps the next entry 8-byte aligned.
+struct BatchedCallHeader {
+    uint64_t Id;
+    uint32_t Size;
+    uint32_t Reserved;
+
+    void* Args() {
+        return this + 1;
+    }
+
+    BatchedCallHeader* Next() {
+        return reinterpret_cast<BatchedCallHeader*>(reinterpret_cast<char*>(this) + Size);
+    }
+};
+
+// Argument of the flush thunk generated for libraries with fexgen::batch_state_calls
+struct BatchedCallRange {
+    BatchedCallHeader* Begin;
+    BatchedCallHeader* End;
+};
+
+// Types passed in a single integer register by both the x86-64 guest ABI and the host ABI
+template<typename T>
+struct IsRegisterTypeT : std::bool_constant<(std::is_integral_v<T> || std::is_enum_v<T> || std::is_pointer_v<T>) && sizeof(T) <= 8> {};
+
+template<typename T>
+inline constexpr bool IsRegisterType = IsRegisterTypeT<T>::value;
+
+// Host -> guest callbacks with this signature can pass all arguments and the result in registers.
+// The guest function address goes to the first argument register, which leaves five for the arguments.
+template<typename Result, typename... Args>
+inline constexpr bool IsRegisterCallbackSignature =
+    sizeof...(Args) <= 5 && std::disjunction_v<std::is_void<Result>, IsRegisterTypeT<Result>> && (IsRegisterType<Args> && ...);
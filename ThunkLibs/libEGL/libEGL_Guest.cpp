@@ -23,6 +23,18 @@ extern "C" {
 		// TODO: Fix this HACK
 		return glXGetProcAddress((const GLubyte*)procname);
 	}
+
+	// GL calls batched by the libGL thunks must reach the host before the
+	// context is switched or the frame is presented. Both imply glFlush anyway.
+	EGLBoolean eglMakeCurrent(EGLDisplay dpy, EGLSurface draw, EGLSurface read, EGLContext ctx) {
+		glFlush();
+		return fexfn_pack_eglMakeCurrent(dpy, draw, read, ctx);
+	}
+
+	EGLBoolean eglSwapBuffers(EGLDisplay dpy, EGLSurface surface) {
+		glFlush();
+		return fexfn_pack_eglSwapBuffers(dpy, surface);
+	}
 }
 
 LOAD_LIB(libEGL)
@@ -12,10 +12,10 @@ template<> struct fex_gen_config<eglChooseConfig> {};
 template<> struct fex_gen_config<eglDestroyContext> {};
 template<> struct fex_gen_config<eglDestroySurface> {};
 template<> struct fex_gen_config<eglInitialize> {};
-template<> struct fex_gen_config<eglMakeCurrent> {};
+template<> struct fex_gen_config<eglMakeCurrent> : fexgen::custom_guest_entrypoint {};
 template<> struct fex_gen_config<eglQuerySurface> {};
 template<> struct fex_gen_config<eglSurfaceAttrib> {};
-template<> struct fex_gen_config<eglSwapBuffers> {};
+template<> struct fex_gen_config<eglSwapBuffers> : fexgen::custom_guest_entrypoint {};
 template<> struct fex_gen_config<eglTerminate> {};
 template<> struct fex_gen_config<eglGetError> {};
 template<> struct fex_gen_config<eglCreateContext> {};
@@ -19,9 +19,13 @@ struct fex_gen_config {
 template<> struct fex_gen_config<glXGetProcAddress> : fexgen::custom_guest_entrypoint, fexgen::returns_guest_pointer {};
 
 // Symbols queryable through glXGetProcAddr
+//
+// State-setting calls are batched. Functions that read client memory at call time
+// (e.g. draws from client-side vertex arrays) or that synchronize with the driver
+// must be annotated with fexgen::no_batch.
 namespace internal {
 template<auto>
-struct fex_gen_config : fexgen::generate_guest_symtable, fexgen::indirect_guest_calls {
+struct fex_gen_config : fexgen::generate_guest_symtable, fexgen::indirect_guest_calls, fexgen::batch_state_calls {
 };
 
 template<> struct fex_gen_config<glXQueryCurrentRendererStringMESA> {};
@@ -94,7 +98,7 @@ template<> struct fex_gen_config<glXQueryDrawable> {};
 template<> struct fex_gen_config<glXSelectEvent> {};
 template<> struct fex_gen_config<glXSwapBuffers> {};
 template<> struct fex_gen_config<glXUseXFont> {};
-template<> struct fex_gen_config<glXWaitGL> {};
+template<> struct fex_gen_config<glXWaitGL> : fexgen::no_batch {};
 template<> struct fex_gen_config<glXChooseVisual> {};
 template<> struct fex_gen_config<glXGetVisualFromFBConfig> {};
 
@@ -350,8 +354,8 @@ template<> struct fex_gen_config<glAlphaFuncxOES> {};
 template<> struct fex_gen_config<glAlphaToCoverageDitherControlNV> {};
 template<> struct fex_gen_config<glApplyFramebufferAttachmentCMAAINTEL> {};
 template<> struct fex_gen_config<glApplyTextureEXT> {};
-template<> struct fex_gen_config<glArrayElementEXT> {};
-template<> struct fex_gen_config<glArrayElement> {};
+template<> struct fex_gen_config<glArrayElementEXT> : fexgen::no_batch {};
+template<> struct fex_gen_config<glArrayElement> : fexgen::no_batch {};
 template<> struct fex_gen_config<glArrayObjectATI> {};
 template<> struct fex_gen_config<glAsyncMarkerSGIX> {};
 template<> struct fex_gen_config<glAttachObjectARB> {};
@@ -781,13 +785,13 @@ template<> struct fex_gen_config<glDisableVertexAttribArray> {};
 template<> struct fex_gen_config<glDispatchCompute> {};
 template<> struct fex_gen_config<glDispatchComputeGroupSizeARB> {};
 template<> struct fex_gen_config<glDispatchComputeIndirect> {};
-template<> struct fex_gen_config<glDrawArraysEXT> {};
-template<> struct fex_gen_config<glDrawArrays> {};
+template<> struct fex_gen_config<glDrawArraysEXT> : fexgen::no_batch {};
+template<> struct fex_gen_config<glDrawArrays> : fexgen::no_batch {};
 template<> struct fex_gen_config<glDrawArraysIndirect> {};
-template<> struct fex_gen_config<glDrawArraysInstancedARB> {};
-template<> struct fex_gen_config<glDrawArraysInstancedBaseInstance> {};
-template<> struct fex_gen_config<glDrawArraysInstancedEXT> {};
-template<> struct fex_gen_config<glDrawArraysInstanced> {};
+template<> struct fex_gen_config<glDrawArraysInstancedARB> : fexgen::no_batch {};
+template<> struct fex_gen_config<glDrawArraysInstancedBaseInstance> : fexgen::no_batch {};
+template<> struct fex_gen_config<glDrawArraysInstancedEXT> : fexgen::no_batch {};
+template<> struct fex_gen_config<glDrawArraysInstanced> : fexgen::no_batch {};
 template<> struct fex_gen_config<glDrawBuffer> {};
 template<> struct fex_gen_config<glDrawBuffersARB> {};
 template<> struct fex_gen_config<glDrawBuffersATI> {};
@@ -796,8 +800,8 @@ template<> struct fex_gen_config<glDrawCommandsAddressNV> {};
 template<> struct fex_gen_config<glDrawCommandsNV> {};
 template<> struct fex_gen_config<glDrawCommandsStatesAddressNV> {};
 template<> struct fex_gen_config<glDrawCommandsStatesNV> {};
-template<> struct fex_gen_config<glDrawElementArrayAPPLE> {};
-template<> struct fex_gen_config<glDrawElementArrayATI> {};
+template<> struct fex_gen_config<glDrawElementArrayAPPLE> : fexgen::no_batch {};
+template<> struct fex_gen_config<glDrawElementArrayATI> : fexgen::no_batch {};
 template<> struct fex_gen_config<glDrawElementsBaseVertex> {};
 template<> struct fex_gen_config<glDrawElements> {};
 template<> struct fex_gen_config<glDrawElementsIndirect> {};
@@ -807,12 +811,12 @@ template<> struct fex_gen_config<glDrawElementsInstancedBaseVertexBaseInstance>
 template<> struct fex_gen_config<glDrawElementsInstancedBaseVertex> {};
 template<> struct fex_gen_config<glDrawElementsInstancedEXT> {};
 template<> struct fex_gen_config<glDrawElementsInstanced> {};
-template<> struct fex_gen_config<glDrawMeshArraysSUN> {};
+template<> struct fex_gen_config<glDrawMeshArraysSUN> : fexgen::no_batch {};
 template<> struct fex_gen_config<glDrawMeshTasksIndirectNV> {};
 template<> struct fex_gen_config<glDrawMeshTasksNV> {};
 template<> struct fex_gen_config<glDrawPixels> {};
-template<> struct fex_gen_config<glDrawRangeElementArrayAPPLE> {};
-template<> struct fex_gen_config<glDrawRangeElementArrayATI> {};
+template<> struct fex_gen_config<glDrawRangeElementArrayAPPLE> : fexgen::no_batch {};
+template<> struct fex_gen_config<glDrawRangeElementArrayATI> : fexgen::no_batch {};
 template<> struct fex_gen_config<glDrawRangeElementsBaseVertex> {};
 template<> struct fex_gen_config<glDrawRangeElementsEXT> {};
 template<> struct fex_gen_config<glDrawRangeElements> {};
@@ -888,21 +892,21 @@ template<> struct fex_gen_config<glExtractComponentEXT> {};
 template<> struct fex_gen_config<glFeedbackBuffer> {};
 template<> struct fex_gen_config<glFeedbackBufferxOES> {};
 template<> struct fex_gen_config<glFinalCombinerInputNV> {};
-template<> struct fex_gen_config<glFinish> {};
-template<> struct fex_gen_config<glFinishFenceAPPLE> {};
-template<> struct fex_gen_config<glFinishFenceNV> {};
-template<> struct fex_gen_config<glFinishObjectAPPLE> {};
-template<> struct fex_gen_config<glFinishTextureSUNX> {};
-template<> struct fex_gen_config<glFlush> {};
-template<> struct fex_gen_config<glFlushMappedBufferRangeAPPLE> {};
-template<> struct fex_gen_config<glFlushMappedBufferRange> {};
-template<> struct fex_gen_config<glFlushMappedNamedBufferRangeEXT> {};
-template<> struct fex_gen_config<glFlushMappedNamedBufferRange> {};
-template<> struct fex_gen_config<glFlushPixelDataRangeNV> {};
-template<> struct fex_gen_config<glFlushRasterSGIX> {};
-template<> struct fex_gen_config<glFlushStaticDataIBM> {};
+template<> struct fex_gen_config<glFinish> : fexgen::no_batch {};
+template<> struct fex_gen_config<glFinishFenceAPPLE> : fexgen::no_batch {};
+template<> struct fex_gen_config<glFinishFenceNV> : fexgen::no_batch {};
+template<> struct fex_gen_config<glFinishObjectAPPLE> : fexgen::no_batch {};
+template<> struct fex_gen_config<glFinishTextureSUNX> : fexgen::no_batch {};
+template<> struct fex_gen_config<glFlush> : fexgen::no_batch {};
+template<> struct fex_gen_config<glFlushMappedBufferRangeAPPLE> : fexgen::no_batch {};
+template<> struct fex_gen_config<glFlushMappedBufferRange> : fexgen::no_batch {};
+template<> struct fex_gen_config<glFlushMappedNamedBufferRangeEXT> : fexgen::no_batch {};
+template<> struct fex_gen_config<glFlushMappedNamedBufferRange> : fexgen::no_batch {};
+template<> struct fex_gen_config<glFlushPixelDataRangeNV> : fexgen::no_batch {};
+template<> struct fex_gen_config<glFlushRasterSGIX> : fexgen::no_batch {};
+template<> struct fex_gen_config<glFlushStaticDataIBM> : fexgen::no_batch {};
 template<> struct fex_gen_config<glFlushVertexArrayRangeAPPLE> {};
-template<> struct fex_gen_config<glFlushVertexArrayRangeNV> {};
+template<> struct fex_gen_config<glFlushVertexArrayRangeNV> : fexgen::no_batch {};
 template<> struct fex_gen_config<glFogCoorddEXT> {};
 template<> struct fex_gen_config<glFogCoorddvEXT> {};
 template<> struct fex_gen_config<glFogCoordfEXT> {};
@@ -1404,10 +1408,10 @@ template<> struct fex_gen_config<glImageTransformParameterfHP> {};
 template<> struct fex_gen_config<glImageTransformParameterfvHP> {};
 template<> struct fex_gen_config<glImageTransformParameteriHP> {};
 template<> struct fex_gen_config<glImageTransformParameterivHP> {};
-template<> struct fex_gen_config<glImportMemoryFdEXT> {};
+template<> struct fex_gen_config<glImportMemoryFdEXT> : fexgen::no_batch {};
 template<> struct fex_gen_config<glImportMemoryWin32HandleEXT> {};
 template<> struct fex_gen_config<glImportMemoryWin32NameEXT> {};
-template<> struct fex_gen_config<glImportSemaphoreFdEXT> {};
+template<> struct fex_gen_config<glImportSemaphoreFdEXT> : fexgen::no_batch {};
 template<> struct fex_gen_config<glImportSemaphoreWin32HandleEXT> {};
 template<> struct fex_gen_config<glImportSemaphoreWin32NameEXT> {};
 template<> struct fex_gen_config<glIndexd> {};
@@ -1483,7 +1487,7 @@ template<> struct fex_gen_config<glLoadTransposeMatrixd> {};
 template<> struct fex_gen_config<glLoadTransposeMatrixfARB> {};
 template<> struct fex_gen_config<glLoadTransposeMatrixf> {};
 template<> struct fex_gen_config<glLoadTransposeMatrixxOES> {};
-template<> struct fex_gen_config<glLockArraysEXT> {};
+template<> struct fex_gen_config<glLockArraysEXT> : fexgen::no_batch {};
 template<> struct fex_gen_config<glLogicOp> {};
 template<> struct fex_gen_config<glMakeBufferNonResidentNV> {};
 template<> struct fex_gen_config<glMakeBufferResidentNV> {};
@@ -2253,8 +2257,8 @@ template<> struct fex_gen_config<glShadingRateSampleOrderNV> {};
 template<> struct fex_gen_config<glSharpenTexFuncSGIS> {};
 template<> struct fex_gen_config<glSignalSemaphoreEXT> {};
 template<> struct fex_gen_config<glSignalSemaphoreui64NVX> {};
-template<> struct fex_gen_config<glSignalVkFenceNV> {};
-template<> struct fex_gen_config<glSignalVkSemaphoreNV> {};
+template<> struct fex_gen_config<glSignalVkFenceNV> : fexgen::no_batch {};
+template<> struct fex_gen_config<glSignalVkSemaphoreNV> : fexgen::no_batch {};
 template<> struct fex_gen_config<glSpecializeShaderARB> {};
 template<> struct fex_gen_config<glSpecializeShader> {};
 template<> struct fex_gen_config<glSpriteParameterfSGIX> {};
@@ -3005,7 +3009,7 @@ template<> struct fex_gen_config<glViewportSwizzleNV> {};
 template<> struct fex_gen_config<glWaitSemaphoreEXT> {};
 template<> struct fex_gen_config<glWaitSemaphoreui64NVX> {};
 template<> struct fex_gen_config<glWaitSync> {};
-template<> struct fex_gen_config<glWaitVkSemaphoreNV> {};
+template<> struct fex_gen_config<glWaitVkSemaphoreNV> : fexgen::no_batch {};
 template<> struct fex_gen_config<glWeightbvARB> {};
 template<> struct fex_gen_config<glWeightdvARB> {};
 template<> struct fex_gen_config<glWeightfvARB> {};
@@ -3071,7 +3075,7 @@ template<> struct fex_gen_config<glGetPathTexGenfvNV> {};
 template<> struct fex_gen_config<glBlendEquationSeparateATI> {};
 
 // glx.h
-template<> struct fex_gen_config<glXWaitX> {};
+template<> struct fex_gen_config<glXWaitX> : fexgen::no_batch {};
 template<> struct fex_gen_config<glXBindTexImageARB> {};
 template<> struct fex_gen_config<glXReleaseTexImageARB> {};
 template<> struct fex_gen_config<glXDrawableAttribARB> {};
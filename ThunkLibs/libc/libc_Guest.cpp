@@ -0,0 +1,182 @@
+/*
+$info$
+tags: thunklibs|libc
+desc: Forwards large libc string and memory operations to the host libc
+$end_info$
+*/
+
+#include <dlfcn.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "common/Guest.h"
+
+#include "thunkgen_guest_libc.inl"
+
+// This library is loaded with LD_PRELOAD and interposes the guest libc symbols.
+// <string.h> must not be included here, its C++ overloads conflict with the definitions below.
+//
+// Short calls stay in the guest libc since the guest->host transition costs more than they do.
+// Calls that happen before the host library is loaded, from ld.so or earlier constructors,
+// use the plain loops below.
+
+namespace {
+// Calls below this size stay in the guest
+constexpr size_t MemThunkThreshold = 256;
+// Bytes of a string scanned in the guest before the rest is handed to the host
+constexpr size_t StrScanLength = 64;
+
+struct {
+  decltype(&fexfn_pack_memcpy) memcpy;
+  decltype(&fexfn_pack_memmove) memmove;
+  decltype(&fexfn_pack_memset) memset;
+  decltype(&fexfn_pack_memcmp) memcmp;
+} GuestLibc;
+
+bool HostLoaded = false;
+
+bool Overlaps(const void *dest, const void *src, size_t n) {
+  auto d = reinterpret_cast<uintptr_t>(dest);
+  auto s = reinterpret_cast<uintptr_t>(src);
+  return d < s + n && s < d + n;
+}
+
+void *CopyBytes(void *dest, const void *src, size_t n) {
+  auto d = static_cast<volatile uint8_t*>(dest);
+  auto s = static_cast<const volatile uint8_t*>(src);
+  if (d <= s) {
+    for (size_t i = 0; i < n; ++i) {
+      d[i] = s[i];
+    }
+  }
+  else {
+    for (size_t i = n; i != 0; --i) {
+      d[i - 1] = s[i - 1];
+    }
+  }
+  return dest;
+}
+}
+
+extern "C" {
+void *memcpy(void *dest, const void *src, size_t n) {
+  if (n < MemThunkThreshold && GuestLibc.memcpy) {
+    return GuestLibc.memcpy(dest, src, n);
+  }
+
+  if (!HostLoaded) {
+    return CopyBytes(dest, src, n);
+  }
+
+  // Overlapping memcpy is undefined, but some applications depend on the memmove behaviour of older libcs
+  if (Overlaps(dest, src, n)) {
+    return fexfn_pack_memmove(dest, src, n);
+  }
+
+  return fexfn_pack_memcpy(dest, src, n);
+}
+
+void *memmove(void *dest, const void *src, size_t n) {
+  if (n < MemThunkThreshold && GuestLibc.memmove) {
+    return GuestLibc.memmove(dest, src, n);
+  }
+
+  if (!HostLoaded) {
+    return CopyBytes(dest, src, n);
+  }
+
+  return fexfn_pack_memmove(dest, src, n);
+}
+
+void *memset(void *s, int c, size_t n) {
+  if (n < MemThunkThreshold && GuestLibc.memset) {
+    return GuestLibc.memset(s, c, n);
+  }
+
+  if (!HostLoaded) {
+    auto p = static_cast<volatile uint8_t*>(s);
+    for (size_t i = 0; i < n; ++i) {
+      p[i] = c;
+    }
+    return s;
+  }
+
+  return fexfn_pack_memset(s, c, n);
+}
+
+int memcmp(const void *s1, const void *s2, size_t n) {
+  if (n < MemThunkThreshold && GuestLibc.memcmp) {
+    return GuestLibc.memcmp(s1, s2, n);
+  }
+
+  if (!HostLoaded) {
+    auto p1 = static_cast<const volatile uint8_t*>(s1);
+    auto p2 = static_cast<const volatile uint8_t*>(s2);
+    for (size_t i = 0; i < n; ++i) {
+      if (p1[i] != p2[i]) {
+        return p1[i] < p2[i] ? -1 : 1;
+      }
+    }
+    return 0;
+  }
+
+  return fexfn_pack_memcmp(s1, s2, n);
+}
+
+size_t strlen(const char *s) {
+  // Most strings are short, only hand long ones to the host
+  auto p = reinterpret_cast<const volatile char*>(s);
+  for (size_t i = 0; i < StrScanLength; ++i) {
+    if (p[i] == '\0') {
+      return i;
+    }
+  }
+
+  if (!HostLoaded) {
+    size_t i = StrScanLength;
+    while (p[i] != '\0') {
+      ++i;
+    }
+    return i;
+  }
+
+  return StrScanLength + fexfn_pack_strlen(s + StrScanLength);
+}
+
+char *strchr(const char *s, int c) {
+  const char ch = c;
+  auto p = reinterpret_cast<const volatile char*>(s);
+  for (size_t i = 0; i < StrScanLength; ++i) {
+    if (p[i] == ch) {
+      return const_cast<char*>(s + i);
+    }
+    if (p[i] == '\0') {
+      return nullptr;
+    }
+  }
+
+  if (!HostLoaded) {
+    for (size_t i = StrScanLength;; ++i) {
+      if (p[i] == ch) {
+        return const_cast<char*>(s + i);
+      }
+      if (p[i] == '\0') {
+        return nullptr;
+      }
+    }
+  }
+
+  return fexfn_pack_strchr(s + StrScanLength, c);
+}
+}
+
+static void init_lib() {
+  // The next definitions in lookup order are the guest libc ones
+  GuestLibc.memcpy = reinterpret_cast<decltype(GuestLibc.memcpy)>(dlsym(RTLD_NEXT, "memcpy"));
+  GuestLibc.memmove = reinterpret_cast<decltype(GuestLibc.memmove)>(dlsym(RTLD_NEXT, "memmove"));
+  GuestLibc.memset = reinterpret_cast<decltype(GuestLibc.memset)>(dlsym(RTLD_NEXT, "memset"));
+  GuestLibc.memcmp = reinterpret_cast<decltype(GuestLibc.memcmp)>(dlsym(RTLD_NEXT, "memcmp"));
+  HostLoaded = true;
+}
+
+LOAD_LIB_INIT(libc, init_lib)
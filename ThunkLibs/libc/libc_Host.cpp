@@ -0,0 +1,13 @@
+/*
+$info$
+tags: thunklibs|libc
+desc: Forwards large libc string and memory operations to the host libc
+$end_info$
+*/
+
+#include "common/Host.h"
+#include <dlfcn.h>
+
+#include "thunkgen_host_libc.inl"
+
+EXPORTS(libc)
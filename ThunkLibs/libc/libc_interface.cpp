@@ -0,0 +1,26 @@
+#include <common/GeneratorInterface.h>
+
+#include <stddef.h>
+
+// <string.h> isn't included since C++ overloads strchr, which can't be used as a template argument
+extern "C" {
+void *memcpy(void *dest, const void *src, size_t n);
+void *memmove(void *dest, const void *src, size_t n);
+void *memset(void *s, int c, size_t n);
+int memcmp(const void *s1, const void *s2, size_t n);
+size_t strlen(const char *s);
+char *strchr(const char *s, int c);
+}
+
+template<auto>
+struct fex_gen_config {
+    unsigned version = 6;
+};
+
+// Guest entrypoints keep small calls in the guest, the thunk transition costs more than they do
+template<> struct fex_gen_config<memcpy> : fexgen::custom_guest_entrypoint {};
+template<> struct fex_gen_config<memmove> : fexgen::custom_guest_entrypoint {};
+template<> struct fex_gen_config<memset> : fexgen::custom_guest_entrypoint {};
+template<> struct fex_gen_config<memcmp> : fexgen::custom_guest_entrypoint {};
+template<> struct fex_gen_config<strlen> : fexgen::custom_guest_entrypoint {};
+template<> struct fex_gen_config<strchr> : fexgen::custom_guest_entrypoint {};
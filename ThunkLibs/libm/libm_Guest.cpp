@@ -0,0 +1,106 @@
+/*
+$info$
+tags: thunklibs|libm
+desc: Forwards transcendental math functions to the host libm
+$end_info$
+*/
+
+#include <dlfcn.h>
+#include <errno.h>
+
+#include "common/Guest.h"
+
+#include "thunkgen_guest_libm.inl"
+
+// This library is loaded with LD_PRELOAD and interposes the guest libm symbols.
+// <math.h> must not be included here, its C++ overloads conflict with the definitions below.
+//
+// The host libm only sets the host errno, so errno is derived from the result here.
+// Underflow is only reported for results of zero where that can't be exact.
+// Whether errno is set for subnormal results is implementation-defined.
+
+namespace {
+bool HostLoaded = false;
+
+template<typename T, typename... Args>
+T SetErrno(T Result, bool MayUnderflow, Args... Inputs) {
+  const bool AnyNaN = (__builtin_isnan(Inputs) || ...);
+  const bool AllFinite = (__builtin_isfinite(Inputs) && ...);
+
+  if (__builtin_isnan(Result) && !AnyNaN) {
+    // Domain error
+    errno = EDOM;
+  }
+  else if (__builtin_isinf(Result) && AllFinite) {
+    // Pole error or overflow
+    errno = ERANGE;
+  }
+  else if (MayUnderflow && AllFinite && Result == 0) {
+    // Underflow to zero
+    errno = ERANGE;
+  }
+
+  return Result;
+}
+
+// Calls from constructors that run before this library is loaded go to the guest libm
+template<typename Fn>
+Fn GuestLibm(const char *Name) {
+  return reinterpret_cast<Fn>(dlsym(RTLD_NEXT, Name));
+}
+}
+
+#define MATH_FN_1(name, type, underflow) \
+  extern "C" type name(type x) { \
+    if (!HostLoaded) { \
+      return GuestLibm<type(*)(type)>(#name)(x); \
+    } \
+    return SetErrno(fexfn_pack_##name(x), underflow, x); \
+  }
+
+#define MATH_FN_2(name, type, underflow) \
+  extern "C" type name(type x, type y) { \
+    if (!HostLoaded) { \
+      return GuestLibm<type(*)(type, type)>(#name)(x, y); \
+    } \
+    return SetErrno(fexfn_pack_##name(x, y), underflow, x, y); \
+  }
+
+#define MATH_FN_SINCOS(name, type) \
+  extern "C" void name(type x, type *sinx, type *cosx) { \
+    if (!HostLoaded) { \
+      return GuestLibm<void(*)(type, type*, type*)>(#name)(x, sinx, cosx); \
+    } \
+    fexfn_pack_##name(x, sinx, cosx); \
+    SetErrno(*sinx, false, x); \
+  }
+
+MATH_FN_1(sin, double, false)
+MATH_FN_1(cos, double, false)
+MATH_FN_1(tan, double, false)
+MATH_FN_SINCOS(sincos, double)
+MATH_FN_2(atan2, double, x != 0)
+MATH_FN_1(exp, double, true)
+MATH_FN_1(exp2, double, true)
+MATH_FN_1(log, double, false)
+MATH_FN_1(log2, double, false)
+MATH_FN_1(log10, double, false)
+MATH_FN_2(pow, double, x != 0)
+
+MATH_FN_1(sinf, float, false)
+MATH_FN_1(cosf, float, false)
+MATH_FN_1(tanf, float, false)
+MATH_FN_SINCOS(sincosf, float)
+MATH_FN_2(atan2f, float, x != 0)
+MATH_FN_1(expf, float, true)
+MATH_FN_1(exp2f, float, true)
+MATH_FN_1(logf, float, false)
+MATH_FN_1(log2f, float, false)
+MATH_FN_1(log10f, float, false)
+MATH_FN_2(powf, float, x != 0)
+
+static void init_lib() {
+  HostLoaded = true;
+}
+
+LOAD_LIB_INIT(libm, init_lib)
@@ -0,0 +1,13 @@
+/*
+$info$
+tags: thunklibs|libm
+desc: Forwards transcendental math functions to the host libm
+$end_info$
+*/
+
+#include "common/Host.h"
+#include <dlfcn.h>
+
+#include "thunkgen_host_libm.inl"
+
+EXPORTS(libm)
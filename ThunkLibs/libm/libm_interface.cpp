@@ -0,0 +1,59 @@
+#include <common/GeneratorInterface.h>
+
+// <math.h> isn't included since C++ overloads these, which can't be used as template arguments.
+// long double variants aren't thunked, x87 long double doesn't match the host ABI.
+extern "C" {
+double sin(double);
+double cos(double);
+double tan(double);
+void sincos(double, double *, double *);
+double atan2(double, double);
+double exp(double);
+double exp2(double);
+double log(double);
+double log2(double);
+double log10(double);
+double pow(double, double);
+
+float sinf(float);
+float cosf(float);
+float tanf(float);
+void sincosf(float, float *, float *);
+float atan2f(float, float);
+float expf(float);
+float exp2f(float);
+float logf(float);
+float log2f(float);
+float log10f(float);
+float powf(float, float);
+}
+
+template<auto>
+struct fex_gen_config {
+    unsigned version = 6;
+};
+
+// Guest entrypoints set the guest errno, the host libm only sets the host errno
+template<> struct fex_gen_config<sin> : fexgen::custom_guest_entrypoint {};
+template<> struct fex_gen_config<cos> : fexgen::custom_guest_entrypoint {};
+template<> struct fex_gen_config<tan> : fexgen::custom_guest_entrypoint {};
+template<> struct fex_gen_config<sincos> : fexgen::custom_guest_entrypoint {};
+template<> struct fex_gen_config<atan2> : fexgen::custom_guest_entrypoint {};
+template<> struct fex_gen_config<exp> : fexgen::custom_guest_entrypoint {};
+template<> struct fex_gen_config<exp2> : fexgen::custom_guest_entrypoint {};
+template<> struct fex_gen_config<log> : fexgen::custom_guest_entrypoint {};
+template<> struct fex_gen_config<log2> : fexgen::custom_guest_entrypoint {};
+template<> struct fex_gen_config<log10> : fexgen::custom_guest_entrypoint {};
+template<> struct fex_gen_config<pow> : fexgen::custom_guest_entrypoint {};
+
+template<> struct fex_gen_config<sinf> : fexgen::custom_guest_entrypoint {};
+template<> struct fex_gen_config<cosf> : fexgen::custom_guest_entrypoint {};
+template<> struct fex_gen_config<tanf> : fexgen::custom_guest_entrypoint {};
+template<> struct fex_gen_config<sincosf> : fexgen::custom_guest_entrypoint {};
+template<> struct fex_gen_config<atan2f> : fexgen::custom_guest_entrypoint {};
+template<> struct fex_gen_config<expf> : fexgen::custom_guest_entrypoint {};
+template<> struct fex_gen_config<exp2f> : fexgen::custom_guest_entrypoint {};
+template<> struct fex_gen_config<logf> : fexgen::custom_guest_entrypoint {};
+template<> struct fex_gen_config<log2f> : fexgen::custom_guest_entrypoint {};
+template<> struct fex_gen_config<log10f> : fexgen::custom_guest_entrypoint {};
+template<> struct fex_gen_config<powf> : fexgen::custom_guest_entrypoint {};
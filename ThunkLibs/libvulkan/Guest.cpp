@@ -15,13 +15,124 @@ $end_info$
 #include <cstdio>
 #include <dlfcn.h>
 #include <functional>
+#include <mutex>
 #include <string_view>
 #include <unordered_map>
+#include <unordered_set>
 
 #include "thunkgen_guest_libvulkan.inl"
 
 extern "C" {
 
+using CommandBufferStreams = CommandStreams<fexthunks_libvulkan_fexbatch_flush>;
+
+// Anything left in the stream belongs to a previous use of the command buffer that was reset without being ended
+VkResult vkBeginCommandBuffer(VkCommandBuffer a_0, const VkCommandBufferBeginInfo* a_1) {
+    CommandBufferStreams::Discard(a_0, false);
+    return fexfn_pack_vkBeginCommandBuffer(a_0, a_1);
+}
+
+// Command buffers of each pool, so their streams can be dropped along with the pool
+static std::mutex PoolMutex;
+static std::unordered_map<VkCommandPool, std::unordered_set<VkCommandBuffer>> PoolCommandBuffers;
+
+VkResult vkAllocateCommandBuffers(VkDevice a_0, const VkCommandBufferAllocateInfo* a_1, VkCommandBuffer* a_2) {
+    auto Result = fexfn_pack_vkAllocateCommandBuffers(a_0, a_1, a_2);
+    if (Result == VK_SUCCESS) {
+        std::lock_guard lk {PoolMutex};
+        auto& Buffers = PoolCommandBuffers[a_1->commandPool];
+        Buffers.insert(a_2, a_2 + a_1->commandBufferCount);
+    }
+    return Result;
+}
+
+void vkFreeCommandBuffers(VkDevice a_0, VkCommandPool a_1, uint32_t a_2, const VkCommandBuffer* a_3) {
+    {
+        std::lock_guard lk {PoolMutex};
+        auto Pool = PoolCommandBuffers.find(a_1);
+        for (uint32_t i = 0; i < a_2; ++i) {
+            if (a_3[i]) {
+                CommandBufferStreams::Erase(a_3[i]);
+                if (Pool != PoolCommandBuffers.end()) {
+                    Pool->second.erase(a_3[i]);
+                }
+            }
+        }
+    }
+    fexfn_pack_vkFreeCommandBuffers(a_0, a_1, a_2, a_3);
+}
+
+// Destroying a pool implicitly frees all of its command buffers
+void vkDestroyCommandPool(VkDevice a_0, VkCommandPool a_1, const VkAllocationCallbacks* a_2) {
+    if (a_1) {
+        std::lock_guard lk {PoolMutex};
+        if (auto Pool = PoolCommandBuffers.find(a_1); Pool != PoolCommandBuffers.end()) {
+            for (auto CommandBuffer : Pool->second) {
+                CommandBufferStreams::Erase(CommandBuffer);
+            }
+            PoolCommandBuffers.erase(Pool);
+        }
+    }
+    fexfn_pack_vkDestroyCommandPool(a_0, a_1, a_2);
+}
+
+// Resetting a pool resets all of its command buffers, which only stay allocated
+VkResult vkResetCommandPool(VkDevice a_0, VkCommandPool a_1, VkCommandPoolResetFlags a_2) {
+    {
+        std::lock_guard lk {PoolMutex};
+        if (auto Pool = PoolCommandBuffers.find(a_1); Pool != PoolCommandBuffers.end()) {
+            for (auto CommandBuffer : Pool->second) {
+                CommandBufferStreams::Discard(CommandBuffer, a_2 & VK_COMMAND_POOL_RESET_RELEASE_RESOURCES_BIT);
+            }
+        }
+    }
+    return fexfn_pack_vkResetCommandPool(a_0, a_1, a_2);
+}
+
+// Recorded commands with pointer parameters, the data is copied since the application may reuse it right away
+
+void vkCmdSetViewport(VkCommandBuffer a_0, uint32_t a_1, uint32_t a_2, const VkViewport* a_3) {
+    fexfn_pack_vkCmdSetViewport(a_0, a_1, a_2, CommandBufferStreams::Copy(a_0, a_3, a_2));
+}
+
+void vkCmdSetScissor(VkCommandBuffer a_0, uint32_t a_1, uint32_t a_2, const VkRect2D* a_3) {
+    fexfn_pack_vkCmdSetScissor(a_0, a_1, a_2, CommandBufferStreams::Copy(a_0, a_3, a_2));
+}
+
+void vkCmdSetBlendConstants(VkCommandBuffer a_0, const float a_1[4]) {
+    fexfn_pack_vkCmdSetBlendConstants(a_0, CommandBufferStreams::Copy(a_0, a_1, 4));
+}
+
+void vkCmdBindDescriptorSets(VkCommandBuffer a_0, VkPipelineBindPoint a_1, VkPipelineLayout a_2, uint32_t a_3, uint32_t a_4,
+                             const VkDescriptorSet* a_5, uint32_t a_6, const uint32_t* a_7) {
+    fexfn_pack_vkCmdBindDescriptorSets(a_0, a_1, a_2, a_3, a_4, CommandBufferStreams::Copy(a_0, a_5, a_4),
+                                       a_6, CommandBufferStreams::Copy(a_0, a_7, a_6));
+}
+
+void vkCmdBindVertexBuffers(VkCommandBuffer a_0, uint32_t a_1, uint32_t a_2, const VkBuffer* a_3, const VkDeviceSize* a_4) {
+    fexfn_pack_vkCmdBindVertexBuffers(a_0, a_1, a_2, CommandBufferStreams::Copy(a_0, a_3, a_2), CommandBufferStreams::Copy(a_0, a_4, a_2));
+}
+
+void vkCmdPushConstants(VkCommandBuffer a_0, VkPipelineLayout a_1, VkShaderStageFlags a_2, uint32_t a_3, uint32_t a_4, const void* a_5) {
+    fexfn_pack_vkCmdPushConstants(a_0, a_1, a_2, a_3, a_4, CommandBufferStreams::Copy(a_0, a_5, a_4));
+}
+
+// Functions above are returned by vkGet*ProcAddr instead of the host function, so indirect calls go through them too.
+// These are all core functions, which the host loader dispatches for any device.
+static const std::unordered_map<std::string_view, PFN_vkVoidFunction> GuestEntrypoints = {
+    { "vkBeginCommandBuffer", reinterpret_cast<PFN_vkVoidFunction>(vkBeginCommandBuffer) },
+    { "vkAllocateCommandBuffers", reinterpret_cast<PFN_vkVoidFunction>(vkAllocateCommandBuffers) },
+    { "vkFreeCommandBuffers", reinterpret_cast<PFN_vkVoidFunction>(vkFreeCommandBuffers) },
+    { "vkDestroyCommandPool", reinterpret_cast<PFN_vkVoidFunction>(vkDestroyCommandPool) },
+    { "vkResetCommandPool", reinterpret_cast<PFN_vkVoidFunction>(vkResetCommandPool) },
+    { "vkCmdSetViewport", reinterpret_cast<PFN_vkVoidFunction>(vkCmdSetViewport) },
+    { "vkCmdSetScissor", reinterpret_cast<PFN_vkVoidFunction>(vkCmdSetScissor) },
+    { "vkCmdSetBlendConstants", reinterpret_cast<PFN_vkVoidFunction>(vkCmdSetBlendConstants) },
+    { "vkCmdBindDescriptorSets", reinterpret_cast<PFN_vkVoidFunction>(vkCmdBindDescriptorSets) },
+    { "vkCmdBindVertexBuffers", reinterpret_cast<PFN_vkVoidFunction>(vkCmdBindVertexBuffers) },
+    { "vkCmdPushConstants", reinterpret_cast<PFN_vkVoidFunction>(vkCmdPushConstants) },
+};
+
 // Maps Vulkan API function names to the address of a guest function which is
 // linked to the corresponding host function pointer
 const std::unordered_map<std::string_view, uintptr_t /* guest function address */> HostPtrInvokers =
@@ -46,6 +157,10 @@ constexpr bool stub_unknown_functions = false;
 }
 
 static PFN_vkVoidFunction MakeGuestCallable(const char* origin, PFN_vkVoidFunction func, const char* name) {
+    if (auto Entrypoint = GuestEntrypoints.find(name); Entrypoint != GuestEntrypoints.end()) {
+        return Entrypoint->second;
+    }
+
     auto It = HostPtrInvokers.find(name);
     if (It == HostPtrInvokers.end()) {
         fprintf(stderr, "%s: Unknown Vulkan function at address %p: %s\n", origin, func, name);
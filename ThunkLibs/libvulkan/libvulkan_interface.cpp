@@ -20,6 +20,11 @@ template<auto>
 struct fex_gen_config : fexgen::generate_guest_symtable, fexgen::indirect_guest_calls {
 };
 
+// Commands are recorded in a stream per command buffer and executed on the host
+// by the next call taking the command buffer that isn't recorded, usually
+// vkEndCommandBuffer. Commands with pointer parameters copy the data in their
+// guest entrypoints, so only the frequently used ones are recorded.
+
 template<> struct fex_gen_config<vkCreateInstance> : fexgen::custom_host_impl {};
 template<> struct fex_gen_config<vkDestroyInstance> {};
 template<> struct fex_gen_config<vkEnumeratePhysicalDevices> {};
@@ -107,63 +112,63 @@ template<> struct fex_gen_config<vkCreateRenderPass> {};
 template<> struct fex_gen_config<vkDestroyRenderPass> {};
 template<> struct fex_gen_config<vkGetRenderAreaGranularity> {};
 template<> struct fex_gen_config<vkCreateCommandPool> {};
-template<> struct fex_gen_config<vkDestroyCommandPool> {};
-template<> struct fex_gen_config<vkResetCommandPool> {};
-template<> struct fex_gen_config<vkAllocateCommandBuffers> {};
-template<> struct fex_gen_config<vkFreeCommandBuffers> {};
-template<> struct fex_gen_config<vkBeginCommandBuffer> {};
+template<> struct fex_gen_config<vkDestroyCommandPool> : fexgen::custom_guest_entrypoint {};
+template<> struct fex_gen_config<vkResetCommandPool> : fexgen::custom_guest_entrypoint {};
+template<> struct fex_gen_config<vkAllocateCommandBuffers> : fexgen::custom_guest_entrypoint {};
+template<> struct fex_gen_config<vkFreeCommandBuffers> : fexgen::custom_guest_entrypoint {};
+template<> struct fex_gen_config<vkBeginCommandBuffer> : fexgen::custom_guest_entrypoint {};
 template<> struct fex_gen_config<vkEndCommandBuffer> {};
 template<> struct fex_gen_config<vkResetCommandBuffer> {};
-template<> struct fex_gen_config<vkCmdBindPipeline> {};
-template<> struct fex_gen_config<vkCmdSetViewport> {};
-template<> struct fex_gen_config<vkCmdSetScissor> {};
-template<> struct fex_gen_config<vkCmdSetLineWidth> {};
-template<> struct fex_gen_config<vkCmdSetDepthBias> {};
-template<> struct fex_gen_config<vkCmdSetBlendConstants> {};
-template<> struct fex_gen_config<vkCmdSetDepthBounds> {};
-template<> struct fex_gen_config<vkCmdSetStencilCompareMask> {};
-template<> struct fex_gen_config<vkCmdSetStencilWriteMask> {};
-template<> struct fex_gen_config<vkCmdSetStencilReference> {};
-template<> struct fex_gen_config<vkCmdBindDescriptorSets> {};
-template<> struct fex_gen_config<vkCmdBindIndexBuffer> {};
-template<> struct fex_gen_config<vkCmdBindVertexBuffers> {};
-template<> struct fex_gen_config<vkCmdDraw> {};
-template<> struct fex_gen_config<vkCmdDrawIndexed> {};
-template<> struct fex_gen_config<vkCmdDrawIndirect> {};
-template<> struct fex_gen_config<vkCmdDrawIndexedIndirect> {};
-template<> struct fex_gen_config<vkCmdDispatch> {};
-template<> struct fex_gen_config<vkCmdDispatchIndirect> {};
+template<> struct fex_gen_config<vkCmdBindPipeline> : fexgen::record_command {};
+template<> struct fex_gen_config<vkCmdSetViewport> : fexgen::record_command, fexgen::custom_guest_entrypoint {};
+template<> struct fex_gen_config<vkCmdSetScissor> : fexgen::record_command, fexgen::custom_guest_entrypoint {};
+template<> struct fex_gen_config<vkCmdSetLineWidth> : fexgen::record_command {};
+template<> struct fex_gen_config<vkCmdSetDepthBias> : fexgen::record_command {};
+template<> struct fex_gen_config<vkCmdSetBlendConstants> : fexgen::record_command, fexgen::custom_guest_entrypoint {};
+template<> struct fex_gen_config<vkCmdSetDepthBounds> : fexgen::record_command {};
+template<> struct fex_gen_config<vkCmdSetStencilCompareMask> : fexgen::record_command {};
+template<> struct fex_gen_config<vkCmdSetStencilWriteMask> : fexgen::record_command {};
+template<> struct fex_gen_config<vkCmdSetStencilReference> : fexgen::record_command {};
+template<> struct fex_gen_config<vkCmdBindDescriptorSets> : fexgen::record_command, fexgen::custom_guest_entrypoint {};
+template<> struct fex_gen_config<vkCmdBindIndexBuffer> : fexgen::record_command {};
+template<> struct fex_gen_config<vkCmdBindVertexBuffers> : fexgen::record_command, fexgen::custom_guest_entrypoint {};
+template<> struct fex_gen_config<vkCmdDraw> : fexgen::record_command {};
+template<> struct fex_gen_config<vkCmdDrawIndexed> : fexgen::record_command {};
+template<> struct fex_gen_config<vkCmdDrawIndirect> : fexgen::record_command {};
+template<> struct fex_gen_config<vkCmdDrawIndexedIndirect> : fexgen::record_command {};
+template<> struct fex_gen_config<vkCmdDispatch> : fexgen::record_command {};
+template<> struct fex_gen_config<vkCmdDispatchIndirect> : fexgen::record_command {};
 template<> struct fex_gen_config<vkCmdCopyBuffer> {};
 template<> struct fex_gen_config<vkCmdCopyImage> {};
 template<> struct fex_gen_config<vkCmdBlitImage> {};
 template<> struct fex_gen_config<vkCmdCopyBufferToImage> {};
 template<> struct fex_gen_config<vkCmdCopyImageToBuffer> {};
 template<> struct fex_gen_config<vkCmdUpdateBuffer> {};
-template<> struct fex_gen_config<vkCmdFillBuffer> {};
+template<> struct fex_gen_config<vkCmdFillBuffer> : fexgen::record_command {};
 template<> struct fex_gen_config<vkCmdClearColorImage> {};
 template<> struct fex_gen_config<vkCmdClearDepthStencilImage> {};
 template<> struct fex_gen_config<vkCmdClearAttachments> {};
 template<> struct fex_gen_config<vkCmdResolveImage> {};
-template<> struct fex_gen_config<vkCmdSetEvent> {};
-template<> struct fex_gen_config<vkCmdResetEvent> {};
+template<> struct fex_gen_config<vkCmdSetEvent> : fexgen::record_command {};
+template<> struct fex_gen_config<vkCmdResetEvent> : fexgen::record_command {};
 template<> struct fex_gen_config<vkCmdWaitEvents> {};
 template<> struct fex_gen_config<vkCmdPipelineBarrier> {};
-template<> struct fex_gen_config<vkCmdBeginQuery> {};
-template<> struct fex_gen_config<vkCmdEndQuery> {};
-template<> struct fex_gen_config<vkCmdResetQueryPool> {};
-template<> struct fex_gen_config<vkCmdWriteTimestamp> {};
-template<> struct fex_gen_config<vkCmdCopyQueryPoolResults> {};
-template<> struct fex_gen_config<vkCmdPushConstants> {};
+template<> struct fex_gen_config<vkCmdBeginQuery> : fexgen::record_command {};
+template<> struct fex_gen_config<vkCmdEndQuery> : fexgen::record_command {};
+template<> struct fex_gen_config<vkCmdResetQueryPool> : fexgen::record_command {};
+template<> struct fex_gen_config<vkCmdWriteTimestamp> : fexgen::record_command {};
+template<> struct fex_gen_config<vkCmdCopyQueryPoolResults> : fexgen::record_command {};
+template<> struct fex_gen_config<vkCmdPushConstants> : fexgen::record_command, fexgen::custom_guest_entrypoint {};
 template<> struct fex_gen_config<vkCmdBeginRenderPass> {};
-template<> struct fex_gen_config<vkCmdNextSubpass> {};
-template<> struct fex_gen_config<vkCmdEndRenderPass> {};
+template<> struct fex_gen_config<vkCmdNextSubpass> : fexgen::record_command {};
+template<> struct fex_gen_config<vkCmdEndRenderPass> : fexgen::record_command {};
 template<> struct fex_gen_config<vkCmdExecuteCommands> {};
 template<> struct fex_gen_config<vkEnumerateInstanceVersion> {};
 template<> struct fex_gen_config<vkBindBufferMemory2> {};
 template<> struct fex_gen_config<vkBindImageMemory2> {};
 template<> struct fex_gen_config<vkGetDeviceGroupPeerMemoryFeatures> {};
-template<> struct fex_gen_config<vkCmdSetDeviceMask> {};
-template<> struct fex_gen_config<vkCmdDispatchBase> {};
+template<> struct fex_gen_config<vkCmdSetDeviceMask> : fexgen::record_command {};
+template<> struct fex_gen_config<vkCmdDispatchBase> : fexgen::record_command {};
 template<> struct fex_gen_config<vkEnumeratePhysicalDeviceGroups> {};
 template<> struct fex_gen_config<vkGetImageMemoryRequirements2> {};
 template<> struct fex_gen_config<vkGetBufferMemoryRequirements2> {};
@@ -186,8 +191,8 @@ template<> struct fex_gen_config<vkGetPhysicalDeviceExternalBufferProperties> {}
 template<> struct fex_gen_config<vkGetPhysicalDeviceExternalFenceProperties> {};
 template<> struct fex_gen_config<vkGetPhysicalDeviceExternalSemaphoreProperties> {};
 template<> struct fex_gen_config<vkGetDescriptorSetLayoutSupport> {};
-template<> struct fex_gen_config<vkCmdDrawIndirectCount> {};
-template<> struct fex_gen_config<vkCmdDrawIndexedIndirectCount> {};
+template<> struct fex_gen_config<vkCmdDrawIndirectCount> : fexgen::record_command {};
+template<> struct fex_gen_config<vkCmdDrawIndexedIndirectCount> : fexgen::record_command {};
 template<> struct fex_gen_config<vkCreateRenderPass2> {};
 template<> struct fex_gen_config<vkCmdBeginRenderPass2> {};
 template<> struct fex_gen_config<vkCmdNextSubpass2> {};
@@ -205,10 +210,10 @@ template<> struct fex_gen_config<vkDestroyPrivateDataSlot> {};
 template<> struct fex_gen_config<vkSetPrivateData> {};
 template<> struct fex_gen_config<vkGetPrivateData> {};
 template<> struct fex_gen_config<vkCmdSetEvent2> {};
-template<> struct fex_gen_config<vkCmdResetEvent2> {};
+template<> struct fex_gen_config<vkCmdResetEvent2> : fexgen::record_command {};
 template<> struct fex_gen_config<vkCmdWaitEvents2> {};
 template<> struct fex_gen_config<vkCmdPipelineBarrier2> {};
-template<> struct fex_gen_config<vkCmdWriteTimestamp2> {};
+template<> struct fex_gen_config<vkCmdWriteTimestamp2> : fexgen::record_command {};
 template<> struct fex_gen_config<vkQueueSubmit2> {};
 template<> struct fex_gen_config<vkCmdCopyBuffer2> {};
 template<> struct fex_gen_config<vkCmdCopyImage2> {};
@@ -217,22 +222,22 @@ template<> struct fex_gen_config<vkCmdCopyImageToBuffer2> {};
 template<> struct fex_gen_config<vkCmdBlitImage2> {};
 template<> struct fex_gen_config<vkCmdResolveImage2> {};
 template<> struct fex_gen_config<vkCmdBeginRendering> {};
-template<> struct fex_gen_config<vkCmdEndRendering> {};
-template<> struct fex_gen_config<vkCmdSetCullMode> {};
-template<> struct fex_gen_config<vkCmdSetFrontFace> {};
-template<> struct fex_gen_config<vkCmdSetPrimitiveTopology> {};
+template<> struct fex_gen_config<vkCmdEndRendering> : fexgen::record_command {};
+template<> struct fex_gen_config<vkCmdSetCullMode> : fexgen::record_command {};
+template<> struct fex_gen_config<vkCmdSetFrontFace> : fexgen::record_command {};
+template<> struct fex_gen_config<vkCmdSetPrimitiveTopology> : fexgen::record_command {};
 template<> struct fex_gen_config<vkCmdSetViewportWithCount> {};
 template<> struct fex_gen_config<vkCmdSetScissorWithCount> {};
 template<> struct fex_gen_config<vkCmdBindVertexBuffers2> {};
-template<> struct fex_gen_config<vkCmdSetDepthTestEnable> {};
-template<> struct fex_gen_config<vkCmdSetDepthWriteEnable> {};
-template<> struct fex_gen_config<vkCmdSetDepthCompareOp> {};
-template<> struct fex_gen_config<vkCmdSetDepthBoundsTestEnable> {};
-template<> struct fex_gen_config<vkCmdSetStencilTestEnable> {};
-template<> struct fex_gen_config<vkCmdSetStencilOp> {};
-template<> struct fex_gen_config<vkCmdSetRasterizerDiscardEnable> {};
-template<> struct fex_gen_config<vkCmdSetDepthBiasEnable> {};
-template<> struct fex_gen_config<vkCmdSetPrimitiveRestartEnable> {};
+template<> struct fex_gen_config<vkCmdSetDepthTestEnable> : fexgen::record_command {};
+template<> struct fex_gen_config<vkCmdSetDepthWriteEnable> : fexgen::record_command {};
+template<> struct fex_gen_config<vkCmdSetDepthCompareOp> : fexgen::record_command {};
+template<> struct fex_gen_config<vkCmdSetDepthBoundsTestEnable> : fexgen::record_command {};
+template<> struct fex_gen_config<vkCmdSetStencilTestEnable> : fexgen::record_command {};
+template<> struct fex_gen_config<vkCmdSetStencilOp> : fexgen::record_command {};
+template<> struct fex_gen_config<vkCmdSetRasterizerDiscardEnable> : fexgen::record_command {};
+template<> struct fex_gen_config<vkCmdSetDepthBiasEnable> : fexgen::record_command {};
+template<> struct fex_gen_config<vkCmdSetPrimitiveRestartEnable> : fexgen::record_command {};
 template<> struct fex_gen_config<vkGetDeviceBufferMemoryRequirements> {};
 template<> struct fex_gen_config<vkGetDeviceImageMemoryRequirements> {};
 template<> struct fex_gen_config<vkGetDeviceImageSparseMemoryRequirements> {};
@@ -259,7 +264,7 @@ template<> struct fex_gen_config<vkGetDisplayPlaneCapabilitiesKHR> {};
 template<> struct fex_gen_config<vkCreateDisplayPlaneSurfaceKHR> {};
 template<> struct fex_gen_config<vkCreateSharedSwapchainsKHR> {};
 template<> struct fex_gen_config<vkCmdBeginRenderingKHR> {};
-template<> struct fex_gen_config<vkCmdEndRenderingKHR> {};
+template<> struct fex_gen_config<vkCmdEndRenderingKHR> : fexgen::record_command {};
 template<> struct fex_gen_config<vkGetPhysicalDeviceFeatures2KHR> {};
 template<> struct fex_gen_config<vkGetPhysicalDeviceProperties2KHR> {};
 template<> struct fex_gen_config<vkGetPhysicalDeviceFormatProperties2KHR> {};
@@ -268,8 +273,8 @@ template<> struct fex_gen_config<vkGetPhysicalDeviceQueueFamilyProperties2KHR> {
 template<> struct fex_gen_config<vkGetPhysicalDeviceMemoryProperties2KHR> {};
 template<> struct fex_gen_config<vkGetPhysicalDeviceSparseImageFormatProperties2KHR> {};
 template<> struct fex_gen_config<vkGetDeviceGroupPeerMemoryFeaturesKHR> {};
-template<> struct fex_gen_config<vkCmdSetDeviceMaskKHR> {};
-template<> struct fex_gen_config<vkCmdDispatchBaseKHR> {};
+template<> struct fex_gen_config<vkCmdSetDeviceMaskKHR> : fexgen::record_command {};
+template<> struct fex_gen_config<vkCmdDispatchBaseKHR> : fexgen::record_command {};
 template<> struct fex_gen_config<vkTrimCommandPoolKHR> {};
 template<> struct fex_gen_config<vkEnumeratePhysicalDeviceGroupsKHR> {};
 template<> struct fex_gen_config<vkGetPhysicalDeviceExternalBufferPropertiesKHR> {};
@@ -309,8 +314,8 @@ template<> struct fex_gen_config<vkDestroySamplerYcbcrConversionKHR> {};
 template<> struct fex_gen_config<vkBindBufferMemory2KHR> {};
 template<> struct fex_gen_config<vkBindImageMemory2KHR> {};
 template<> struct fex_gen_config<vkGetDescriptorSetLayoutSupportKHR> {};
-template<> struct fex_gen_config<vkCmdDrawIndirectCountKHR> {};
-template<> struct fex_gen_config<vkCmdDrawIndexedIndirectCountKHR> {};
+template<> struct fex_gen_config<vkCmdDrawIndirectCountKHR> : fexgen::record_command {};
+template<> struct fex_gen_config<vkCmdDrawIndexedIndirectCountKHR> : fexgen::record_command {};
 template<> struct fex_gen_config<vkGetSemaphoreCounterValueKHR> {};
 template<> struct fex_gen_config<vkWaitSemaphoresKHR> {};
 template<> struct fex_gen_config<vkSignalSemaphoreKHR> {};
@@ -329,12 +334,12 @@ template<> struct fex_gen_config<vkGetPipelineExecutablePropertiesKHR> {};
 template<> struct fex_gen_config<vkGetPipelineExecutableStatisticsKHR> {};
 template<> struct fex_gen_config<vkGetPipelineExecutableInternalRepresentationsKHR> {};
 template<> struct fex_gen_config<vkCmdSetEvent2KHR> {};
-template<> struct fex_gen_config<vkCmdResetEvent2KHR> {};
+template<> struct fex_gen_config<vkCmdResetEvent2KHR> : fexgen::record_command {};
 template<> struct fex_gen_config<vkCmdWaitEvents2KHR> {};
 template<> struct fex_gen_config<vkCmdPipelineBarrier2KHR> {};
-template<> struct fex_gen_config<vkCmdWriteTimestamp2KHR> {};
+template<> struct fex_gen_config<vkCmdWriteTimestamp2KHR> : fexgen::record_command {};
 template<> struct fex_gen_config<vkQueueSubmit2KHR> {};
-template<> struct fex_gen_config<vkCmdWriteBufferMarker2AMD> {};
+template<> struct fex_gen_config<vkCmdWriteBufferMarker2AMD> : fexgen::record_command {};
 template<> struct fex_gen_config<vkGetQueueCheckpointData2NV> {};
 template<> struct fex_gen_config<vkCmdCopyBuffer2KHR> {};
 template<> struct fex_gen_config<vkCmdCopyImage2KHR> {};
@@ -342,7 +347,7 @@ template<> struct fex_gen_config<vkCmdCopyBufferToImage2KHR> {};
 template<> struct fex_gen_config<vkCmdCopyImageToBuffer2KHR> {};
 template<> struct fex_gen_config<vkCmdBlitImage2KHR> {};
 template<> struct fex_gen_config<vkCmdResolveImage2KHR> {};
-template<> struct fex_gen_config<vkCmdTraceRaysIndirect2KHR> {};
+template<> struct fex_gen_config<vkCmdTraceRaysIndirect2KHR> : fexgen::record_command {};
 template<> struct fex_gen_config<vkGetDeviceBufferMemoryRequirementsKHR> {};
 template<> struct fex_gen_config<vkGetDeviceImageMemoryRequirementsKHR> {};
 template<> struct fex_gen_config<vkGetDeviceImageSparseMemoryRequirementsKHR> {};
@@ -352,14 +357,14 @@ template<> struct fex_gen_config<vkDebugReportMessageEXT> {};
 template<> struct fex_gen_config<vkDebugMarkerSetObjectTagEXT> {};
 template<> struct fex_gen_config<vkDebugMarkerSetObjectNameEXT> {};
 template<> struct fex_gen_config<vkCmdDebugMarkerBeginEXT> {};
-template<> struct fex_gen_config<vkCmdDebugMarkerEndEXT> {};
+template<> struct fex_gen_config<vkCmdDebugMarkerEndEXT> : fexgen::record_command {};
 template<> struct fex_gen_config<vkCmdDebugMarkerInsertEXT> {};
 template<> struct fex_gen_config<vkCmdBindTransformFeedbackBuffersEXT> {};
 template<> struct fex_gen_config<vkCmdBeginTransformFeedbackEXT> {};
 template<> struct fex_gen_config<vkCmdEndTransformFeedbackEXT> {};
-template<> struct fex_gen_config<vkCmdBeginQueryIndexedEXT> {};
-template<> struct fex_gen_config<vkCmdEndQueryIndexedEXT> {};
-template<> struct fex_gen_config<vkCmdDrawIndirectByteCountEXT> {};
+template<> struct fex_gen_config<vkCmdBeginQueryIndexedEXT> : fexgen::record_command {};
+template<> struct fex_gen_config<vkCmdEndQueryIndexedEXT> : fexgen::record_command {};
+template<> struct fex_gen_config<vkCmdDrawIndirectByteCountEXT> : fexgen::record_command {};
 template<> struct fex_gen_config<vkCreateCuModuleNVX> {};
 template<> struct fex_gen_config<vkCreateCuFunctionNVX> {};
 template<> struct fex_gen_config<vkDestroyCuModuleNVX> {};
@@ -367,12 +372,12 @@ template<> struct fex_gen_config<vkDestroyCuFunctionNVX> {};
 template<> struct fex_gen_config<vkCmdCuLaunchKernelNVX> {};
 template<> struct fex_gen_config<vkGetImageViewHandleNVX> {};
 template<> struct fex_gen_config<vkGetImageViewAddressNVX> {};
-template<> struct fex_gen_config<vkCmdDrawIndirectCountAMD> {};
-template<> struct fex_gen_config<vkCmdDrawIndexedIndirectCountAMD> {};
+template<> struct fex_gen_config<vkCmdDrawIndirectCountAMD> : fexgen::record_command {};
+template<> struct fex_gen_config<vkCmdDrawIndexedIndirectCountAMD> : fexgen::record_command {};
 template<> struct fex_gen_config<vkGetShaderInfoAMD> {};
 template<> struct fex_gen_config<vkGetPhysicalDeviceExternalImageFormatPropertiesNV> {};
 template<> struct fex_gen_config<vkCmdBeginConditionalRenderingEXT> {};
-template<> struct fex_gen_config<vkCmdEndConditionalRenderingEXT> {};
+template<> struct fex_gen_config<vkCmdEndConditionalRenderingEXT> : fexgen::record_command {};
 template<> struct fex_gen_config<vkCmdSetViewportWScalingNV> {};
 template<> struct fex_gen_config<vkReleaseDisplayEXT> {};
 template<> struct fex_gen_config<vkGetPhysicalDeviceSurfaceCapabilities2EXT> {};
@@ -390,7 +395,7 @@ template<> struct fex_gen_config<vkQueueBeginDebugUtilsLabelEXT> {};
 template<> struct fex_gen_config<vkQueueEndDebugUtilsLabelEXT> {};
 template<> struct fex_gen_config<vkQueueInsertDebugUtilsLabelEXT> {};
 template<> struct fex_gen_config<vkCmdBeginDebugUtilsLabelEXT> {};
-template<> struct fex_gen_config<vkCmdEndDebugUtilsLabelEXT> {};
+template<> struct fex_gen_config<vkCmdEndDebugUtilsLabelEXT> : fexgen::record_command {};
 template<> struct fex_gen_config<vkCmdInsertDebugUtilsLabelEXT> {};
 template<> struct fex_gen_config<vkCreateDebugUtilsMessengerEXT> {};
 template<> struct fex_gen_config<vkDestroyDebugUtilsMessengerEXT> {};
@@ -402,7 +407,7 @@ template<> struct fex_gen_config<vkCreateValidationCacheEXT> {};
 template<> struct fex_gen_config<vkDestroyValidationCacheEXT> {};
 template<> struct fex_gen_config<vkMergeValidationCachesEXT> {};
 template<> struct fex_gen_config<vkGetValidationCacheDataEXT> {};
-template<> struct fex_gen_config<vkCmdBindShadingRateImageNV> {};
+template<> struct fex_gen_config<vkCmdBindShadingRateImageNV> : fexgen::record_command {};
 template<> struct fex_gen_config<vkCmdSetViewportShadingRatePaletteNV> {};
 template<> struct fex_gen_config<vkCmdSetCoarseSampleOrderNV> {};
 template<> struct fex_gen_config<vkCreateAccelerationStructureNV> {};
@@ -410,8 +415,8 @@ template<> struct fex_gen_config<vkDestroyAccelerationStructureNV> {};
 template<> struct fex_gen_config<vkGetAccelerationStructureMemoryRequirementsNV> {};
 template<> struct fex_gen_config<vkBindAccelerationStructureMemoryNV> {};
 template<> struct fex_gen_config<vkCmdBuildAccelerationStructureNV> {};
-template<> struct fex_gen_config<vkCmdCopyAccelerationStructureNV> {};
-template<> struct fex_gen_config<vkCmdTraceRaysNV> {};
+template<> struct fex_gen_config<vkCmdCopyAccelerationStructureNV> : fexgen::record_command {};
+template<> struct fex_gen_config<vkCmdTraceRaysNV> : fexgen::record_command {};
 template<> struct fex_gen_config<vkCreateRayTracingPipelinesNV> {};
 template<> struct fex_gen_config<vkGetRayTracingShaderGroupHandlesKHR> {};
 template<> struct fex_gen_config<vkGetRayTracingShaderGroupHandlesNV> {};
@@ -419,12 +424,12 @@ template<> struct fex_gen_config<vkGetAccelerationStructureHandleNV> {};
 template<> struct fex_gen_config<vkCmdWriteAccelerationStructuresPropertiesNV> {};
 template<> struct fex_gen_config<vkCompileDeferredNV> {};
 template<> struct fex_gen_config<vkGetMemoryHostPointerPropertiesEXT> {};
-template<> struct fex_gen_config<vkCmdWriteBufferMarkerAMD> {};
+template<> struct fex_gen_config<vkCmdWriteBufferMarkerAMD> : fexgen::record_command {};
 template<> struct fex_gen_config<vkGetPhysicalDeviceCalibrateableTimeDomainsEXT> {};
 template<> struct fex_gen_config<vkGetCalibratedTimestampsEXT> {};
-template<> struct fex_gen_config<vkCmdDrawMeshTasksNV> {};
-template<> struct fex_gen_config<vkCmdDrawMeshTasksIndirectNV> {};
-template<> struct fex_gen_config<vkCmdDrawMeshTasksIndirectCountNV> {};
+template<> struct fex_gen_config<vkCmdDrawMeshTasksNV> : fexgen::record_command {};
+template<> struct fex_gen_config<vkCmdDrawMeshTasksIndirectNV> : fexgen::record_command {};
+template<> struct fex_gen_config<vkCmdDrawMeshTasksIndirectCountNV> : fexgen::record_command {};
 template<> struct fex_gen_config<vkCmdSetExclusiveScissorNV> {};
 template<> struct fex_gen_config<vkCmdSetCheckpointNV> {};
 template<> struct fex_gen_config<vkGetQueueCheckpointDataNV> {};
@@ -443,24 +448,24 @@ template<> struct fex_gen_config<vkGetPhysicalDeviceToolPropertiesEXT> {};
 template<> struct fex_gen_config<vkGetPhysicalDeviceCooperativeMatrixPropertiesNV> {};
 template<> struct fex_gen_config<vkGetPhysicalDeviceSupportedFramebufferMixedSamplesCombinationsNV> {};
 template<> struct fex_gen_config<vkCreateHeadlessSurfaceEXT> {};
-template<> struct fex_gen_config<vkCmdSetLineStippleEXT> {};
+template<> struct fex_gen_config<vkCmdSetLineStippleEXT> : fexgen::record_command {};
 template<> struct fex_gen_config<vkResetQueryPoolEXT> {};
-template<> struct fex_gen_config<vkCmdSetCullModeEXT> {};
-template<> struct fex_gen_config<vkCmdSetFrontFaceEXT> {};
-template<> struct fex_gen_config<vkCmdSetPrimitiveTopologyEXT> {};
+template<> struct fex_gen_config<vkCmdSetCullModeEXT> : fexgen::record_command {};
+template<> struct fex_gen_config<vkCmdSetFrontFaceEXT> : fexgen::record_command {};
+template<> struct fex_gen_config<vkCmdSetPrimitiveTopologyEXT> : fexgen::record_command {};
 template<> struct fex_gen_config<vkCmdSetViewportWithCountEXT> {};
 template<> struct fex_gen_config<vkCmdSetScissorWithCountEXT> {};
 template<> struct fex_gen_config<vkCmdBindVertexBuffers2EXT> {};
-template<> struct fex_gen_config<vkCmdSetDepthTestEnableEXT> {};
-template<> struct fex_gen_config<vkCmdSetDepthWriteEnableEXT> {};
-template<> struct fex_gen_config<vkCmdSetDepthCompareOpEXT> {};
-template<> struct fex_gen_config<vkCmdSetDepthBoundsTestEnableEXT> {};
-template<> struct fex_gen_config<vkCmdSetStencilTestEnableEXT> {};
-template<> struct fex_gen_config<vkCmdSetStencilOpEXT> {};
+template<> struct fex_gen_config<vkCmdSetDepthTestEnableEXT> : fexgen::record_command {};
+template<> struct fex_gen_config<vkCmdSetDepthWriteEnableEXT> : fexgen::record_command {};
+template<> struct fex_gen_config<vkCmdSetDepthCompareOpEXT> : fexgen::record_command {};
+template<> struct fex_gen_config<vkCmdSetDepthBoundsTestEnableEXT> : fexgen::record_command {};
+template<> struct fex_gen_config<vkCmdSetStencilTestEnableEXT> : fexgen::record_command {};
+template<> struct fex_gen_config<vkCmdSetStencilOpEXT> : fexgen::record_command {};
 template<> struct fex_gen_config<vkGetGeneratedCommandsMemoryRequirementsNV> {};
 template<> struct fex_gen_config<vkCmdPreprocessGeneratedCommandsNV> {};
 template<> struct fex_gen_config<vkCmdExecuteGeneratedCommandsNV> {};
-template<> struct fex_gen_config<vkCmdBindPipelineShaderGroupNV> {};
+template<> struct fex_gen_config<vkCmdBindPipelineShaderGroupNV> : fexgen::record_command {};
 template<> struct fex_gen_config<vkCreateIndirectCommandsLayoutNV> {};
 template<> struct fex_gen_config<vkDestroyIndirectCommandsLayoutNV> {};
 template<> struct fex_gen_config<vkAcquireDrmDisplayEXT> {};
@@ -476,15 +481,15 @@ template<> struct fex_gen_config<vkAcquireWinrtDisplayNV> {};
 template<> struct fex_gen_config<vkGetWinrtDisplayNV> {};
 template<> struct fex_gen_config<vkCmdSetVertexInputEXT> {};
 template<> struct fex_gen_config<vkGetDeviceSubpassShadingMaxWorkgroupSizeHUAWEI> {};
-template<> struct fex_gen_config<vkCmdSubpassShadingHUAWEI> {};
-template<> struct fex_gen_config<vkCmdBindInvocationMaskHUAWEI> {};
+template<> struct fex_gen_config<vkCmdSubpassShadingHUAWEI> : fexgen::record_command {};
+template<> struct fex_gen_config<vkCmdBindInvocationMaskHUAWEI> : fexgen::record_command {};
 template<> struct fex_gen_config<vkGetMemoryRemoteAddressNV> {};
 template<> struct fex_gen_config<vkGetPipelinePropertiesEXT> {};
-template<> struct fex_gen_config<vkCmdSetPatchControlPointsEXT> {};
-template<> struct fex_gen_config<vkCmdSetRasterizerDiscardEnableEXT> {};
-template<> struct fex_gen_config<vkCmdSetDepthBiasEnableEXT> {};
-template<> struct fex_gen_config<vkCmdSetLogicOpEXT> {};
-template<> struct fex_gen_config<vkCmdSetPrimitiveRestartEnableEXT> {};
+template<> struct fex_gen_config<vkCmdSetPatchControlPointsEXT> : fexgen::record_command {};
+template<> struct fex_gen_config<vkCmdSetRasterizerDiscardEnableEXT> : fexgen::record_command {};
+template<> struct fex_gen_config<vkCmdSetDepthBiasEnableEXT> : fexgen::record_command {};
+template<> struct fex_gen_config<vkCmdSetLogicOpEXT> : fexgen::record_command {};
+template<> struct fex_gen_config<vkCmdSetPrimitiveRestartEnableEXT> : fexgen::record_command {};
 template<> struct fex_gen_config<vkCmdSetColorWriteEnableEXT> {};
 template<> struct fex_gen_config<vkCmdDrawMultiEXT> {};
 template<> struct fex_gen_config<vkCmdDrawMultiIndexedEXT> {};
@@ -505,37 +510,37 @@ template<> struct fex_gen_config<vkGetMicromapBuildSizesEXT> {};
 template<> struct fex_gen_config<vkSetDeviceMemoryPriorityEXT> {};
 template<> struct fex_gen_config<vkGetDescriptorSetLayoutHostMappingInfoVALVE> {};
 template<> struct fex_gen_config<vkGetDescriptorSetHostMappingVALVE> {};
-template<> struct fex_gen_config<vkCmdSetTessellationDomainOriginEXT> {};
-template<> struct fex_gen_config<vkCmdSetDepthClampEnableEXT> {};
-template<> struct fex_gen_config<vkCmdSetPolygonModeEXT> {};
-template<> struct fex_gen_config<vkCmdSetRasterizationSamplesEXT> {};
+template<> struct fex_gen_config<vkCmdSetTessellationDomainOriginEXT> : fexgen::record_command {};
+template<> struct fex_gen_config<vkCmdSetDepthClampEnableEXT> : fexgen::record_command {};
+template<> struct fex_gen_config<vkCmdSetPolygonModeEXT> : fexgen::record_command {};
+template<> struct fex_gen_config<vkCmdSetRasterizationSamplesEXT> : fexgen::record_command {};
 template<> struct fex_gen_config<vkCmdSetSampleMaskEXT> {};
-template<> struct fex_gen_config<vkCmdSetAlphaToCoverageEnableEXT> {};
-template<> struct fex_gen_config<vkCmdSetAlphaToOneEnableEXT> {};
-template<> struct fex_gen_config<vkCmdSetLogicOpEnableEXT> {};
+template<> struct fex_gen_config<vkCmdSetAlphaToCoverageEnableEXT> : fexgen::record_command {};
+template<> struct fex_gen_config<vkCmdSetAlphaToOneEnableEXT> : fexgen::record_command {};
+template<> struct fex_gen_config<vkCmdSetLogicOpEnableEXT> : fexgen::record_command {};
 template<> struct fex_gen_config<vkCmdSetColorBlendEnableEXT> {};
 template<> struct fex_gen_config<vkCmdSetColorBlendEquationEXT> {};
 template<> struct fex_gen_config<vkCmdSetColorWriteMaskEXT> {};
-template<> struct fex_gen_config<vkCmdSetRasterizationStreamEXT> {};
-template<> struct fex_gen_config<vkCmdSetConservativeRasterizationModeEXT> {};
-template<> struct fex_gen_config<vkCmdSetExtraPrimitiveOverestimationSizeEXT> {};
-template<> struct fex_gen_config<vkCmdSetDepthClipEnableEXT> {};
-template<> struct fex_gen_config<vkCmdSetSampleLocationsEnableEXT> {};
+template<> struct fex_gen_config<vkCmdSetRasterizationStreamEXT> : fexgen::record_command {};
+template<> struct fex_gen_config<vkCmdSetConservativeRasterizationModeEXT> : fexgen::record_command {};
+template<> struct fex_gen_config<vkCmdSetExtraPrimitiveOverestimationSizeEXT> : fexgen::record_command {};
+template<> struct fex_gen_config<vkCmdSetDepthClipEnableEXT> : fexgen::record_command {};
+template<> struct fex_gen_config<vkCmdSetSampleLocationsEnableEXT> : fexgen::record_command {};
 template<> struct fex_gen_config<vkCmdSetColorBlendAdvancedEXT> {};
-template<> struct fex_gen_config<vkCmdSetProvokingVertexModeEXT> {};
-template<> struct fex_gen_config<vkCmdSetLineRasterizationModeEXT> {};
-template<> struct fex_gen_config<vkCmdSetLineStippleEnableEXT> {};
-template<> struct fex_gen_config<vkCmdSetDepthClipNegativeOneToOneEXT> {};
-template<> struct fex_gen_config<vkCmdSetViewportWScalingEnableNV> {};
+template<> struct fex_gen_config<vkCmdSetProvokingVertexModeEXT> : fexgen::record_command {};
+template<> struct fex_gen_config<vkCmdSetLineRasterizationModeEXT> : fexgen::record_command {};
+template<> struct fex_gen_config<vkCmdSetLineStippleEnableEXT> : fexgen::record_command {};
+template<> struct fex_gen_config<vkCmdSetDepthClipNegativeOneToOneEXT> : fexgen::record_command {};
+template<> struct fex_gen_config<vkCmdSetViewportWScalingEnableNV> : fexgen::record_command {};
 template<> struct fex_gen_config<vkCmdSetViewportSwizzleNV> {};
-template<> struct fex_gen_config<vkCmdSetCoverageToColorEnableNV> {};
-template<> struct fex_gen_config<vkCmdSetCoverageToColorLocationNV> {};
-template<> struct fex_gen_config<vkCmdSetCoverageModulationModeNV> {};
-template<> struct fex_gen_config<vkCmdSetCoverageModulationTableEnableNV> {};
+template<> struct fex_gen_config<vkCmdSetCoverageToColorEnableNV> : fexgen::record_command {};
+template<> struct fex_gen_config<vkCmdSetCoverageToColorLocationNV> : fexgen::record_command {};
+template<> struct fex_gen_config<vkCmdSetCoverageModulationModeNV> : fexgen::record_command {};
+template<> struct fex_gen_config<vkCmdSetCoverageModulationTableEnableNV> : fexgen::record_command {};
 template<> struct fex_gen_config<vkCmdSetCoverageModulationTableNV> {};
-template<> struct fex_gen_config<vkCmdSetShadingRateImageEnableNV> {};
-template<> struct fex_gen_config<vkCmdSetRepresentativeFragmentTestEnableNV> {};
-template<> struct fex_gen_config<vkCmdSetCoverageReductionModeNV> {};
+template<> struct fex_gen_config<vkCmdSetShadingRateImageEnableNV> : fexgen::record_command {};
+template<> struct fex_gen_config<vkCmdSetRepresentativeFragmentTestEnableNV> : fexgen::record_command {};
+template<> struct fex_gen_config<vkCmdSetCoverageReductionModeNV> : fexgen::record_command {};
 template<> struct fex_gen_config<vkGetShaderModuleIdentifierEXT> {};
 template<> struct fex_gen_config<vkGetShaderModuleCreateInfoIdentifierEXT> {};
 template<> struct fex_gen_config<vkGetPhysicalDeviceOpticalFlowImageFormatsNV> {};
@@ -566,10 +571,10 @@ template<> struct fex_gen_config<vkCreateRayTracingPipelinesKHR> {};
 template<> struct fex_gen_config<vkGetRayTracingCaptureReplayShaderGroupHandlesKHR> {};
 template<> struct fex_gen_config<vkCmdTraceRaysIndirectKHR> {};
 template<> struct fex_gen_config<vkGetRayTracingShaderGroupStackSizeKHR> {};
-template<> struct fex_gen_config<vkCmdSetRayTracingPipelineStackSizeKHR> {};
-template<> struct fex_gen_config<vkCmdDrawMeshTasksEXT> {};
-template<> struct fex_gen_config<vkCmdDrawMeshTasksIndirectEXT> {};
-template<> struct fex_gen_config<vkCmdDrawMeshTasksIndirectCountEXT> {};
+template<> struct fex_gen_config<vkCmdSetRayTracingPipelineStackSizeKHR> : fexgen::record_command {};
+template<> struct fex_gen_config<vkCmdDrawMeshTasksEXT> : fexgen::record_command {};
+template<> struct fex_gen_config<vkCmdDrawMeshTasksIndirectEXT> : fexgen::record_command {};
+template<> struct fex_gen_config<vkCmdDrawMeshTasksIndirectCountEXT> : fexgen::record_command {};
 
 // vulkan_xlib_xrandr.h
 template<> struct fex_gen_config<vkAcquireXlibDisplayEXT> {};
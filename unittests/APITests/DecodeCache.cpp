@@ -0,0 +1,144 @@
+#include <catch2/catch.hpp>
+
+#include "DecoderContext.h"
+#include "Interface/Core/Frontend.h"
+
+#include <FEXHeaderUtils/TypeDefines.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <sys/mman.h>
+
+namespace {
+  // A page of straight line code with a handful of different encodings, terminated by a ret
+  struct CodePage {
+    CodePage() {
+      Code = static_cast<uint8_t*>(mmap(nullptr, FHU::FEX_PAGE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+      REQUIRE(Code != MAP_FAILED);
+
+      static constexpr uint8_t Pattern[] = {
+        0x48, 0x01, 0xd8,                   // add rax, rbx
+        0xb9, 0x78, 0x56, 0x34, 0x12,       // mov ecx, 0x12345678
+        0x48, 0x8d, 0x54, 0x88, 0x10,       // lea rdx, [rax + rcx * 4 + 0x10]
+        0x66, 0x0f, 0x6f, 0xc1,             // movdqa xmm0, xmm1
+        0xf3, 0x0f, 0x58, 0x46, 0x08,       // addss xmm0, [rsi + 8]
+        0x48, 0x85, 0xc0,                   // test rax, rax
+      };
+
+      size_t Offset = 0;
+      while (Offset + sizeof(Pattern) + 1 <= FHU::FEX_PAGE_SIZE) {
+        memcpy(&Code[Offset], Pattern, sizeof(Pattern));
+        Offset += sizeof(Pattern);
+        NumInstructions += 6;
+      }
+      Code[Offset] = 0xc3; // ret
+      ++NumInstructions;
+    }
+
+    ~CodePage() {
+      munmap(Code, FHU::FEX_PAGE_SIZE);
+    }
+
+    uint64_t Entry() const {
+      return reinterpret_cast<uint64_t>(Code);
+    }
+
+    uint8_t *Code;
+    uint64_t NumInstructions{};
+  };
+
+  uint64_t Decode(FEXCore::Frontend::Decoder &Decoder, CodePage const &Page) {
+    Decoder.DecodeInstructionsAtEntry(Page.Code, Page.Entry(), [](uint64_t, uint64_t, uint64_t) {});
+
+    uint64_t NumInstructions = 0;
+    for (auto &Block : *Decoder.GetDecodedBlocks()) {
+      NumInstructions += Block.NumInstructions;
+    }
+    return NumInstructions;
+  }
+}
+
+TEST_CASE("DecodeCache - Hit after redecode") {
+  DecoderContext Context;
+  CodePage Page;
+  auto &Cache = Context.CTX->DecodeCache;
+
+  FEXCore::Frontend::Decoder First(Context.CTX);
+  REQUIRE(Decode(First, Page) == Page.NumInstructions);
+
+  auto Stats = Cache.GetStats();
+  CHECK(Stats.Hits == 0);
+  CHECK(Stats.Misses == Page.NumInstructions);
+  CHECK(Stats.Pages == 1);
+  CHECK(Stats.Instructions == Page.NumInstructions);
+
+  std::vector<FEXCore::X86Tables::DecodedInst> Decoded;
+  for (auto &Block : *First.GetDecodedBlocks()) {
+    Decoded.insert(Decoded.end(), Block.DecodedInstructions, Block.DecodedInstructions + Block.NumInstructions);
+  }
+
+  // A second decoder, like another thread would have, gets the same instructions without decoding them
+  FEXCore::Frontend::Decoder Second(Context.CTX);
+  REQUIRE(Decode(Second, Page) == Page.NumInstructions);
+
+  Stats = Cache.GetStats();
+  CHECK(Stats.Hits == Page.NumInstructions);
+  CHECK(Stats.Instructions == Page.NumInstructions);
+
+  size_t Index = 0;
+  for (auto &Block : *Second.GetDecodedBlocks()) {
+    for (size_t i = 0; i < Block.NumInstructions; ++i, ++Index) {
+      CHECK(memcmp(&Block.DecodedInstructions[i], &Decoded[Index], sizeof(FEXCore::X86Tables::DecodedInst)) == 0);
+    }
+  }
+}
+
+TEST_CASE("DecodeCache - Modified page is decoded again") {
+  DecoderContext Context;
+  CodePage Page;
+  auto &Cache = Context.CTX->DecodeCache;
+
+  FEXCore::Frontend::Decoder Decoder(Context.CTX);
+  REQUIRE(Decode(Decoder, Page) == Page.NumInstructions);
+
+  // Change the immediate of the first mov ecx
+  Page.Code[4] = 0xAA;
+  REQUIRE(Decode(Decoder, Page) == Page.NumInstructions);
+
+  auto Stats = Cache.GetStats();
+  CHECK(Stats.Hits == 0);
+  CHECK(Stats.Misses == Page.NumInstructions * 2);
+  CHECK(Stats.Instructions == Page.NumInstructions);
+
+  auto const &Mov = Decoder.GetDecodedBlocks()->front().DecodedInstructions[1];
+  CHECK(Mov.OP == 0xb9);
+  CHECK(Mov.Src[0].Data.Literal.Value == 0x123456AA);
+}
+
+TEST_CASE("DecodeCache - Throughput", "[.][benchmark]") {
+  DecoderContext Context;
+  CodePage Page;
+  auto &Cache = Context.CTX->DecodeCache;
+  FEXCore::Frontend::Decoder Decoder(Context.CTX);
+
+  constexpr size_t Iterations = 2000;
+
+  auto Run = [&](const char *Name, bool ClearCache) {
+    uint64_t Total = 0;
+    auto Start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < Iterations; ++i) {
+      if (ClearCache) {
+        Cache.Clear();
+      }
+      Total += Decode(Decoder, Page);
+    }
+    auto End = std::chrono::high_resolution_clock::now();
+
+    const double Seconds = std::chrono::duration<double>(End - Start).count();
+    printf("%s: %8.2f M instructions/s\n", Name, static_cast<double>(Total) / Seconds / 1e6);
+  };
+
+  Run("decode (cold cache)", true);
+  Run("decode (warm cache)", false);
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "Interface/Context/Context.h"
+
+#include <FEXCore/Config/Config.h>
+#include <FEXCore/Core/Context.h>
+
+#include <initializer_list>
+#include <string_view>
+#include <utility>
+
+// A 64-bit context for tests that drive the frontend directly, Options are set on top of the default config
+struct DecoderContext {
+  using Option = std::pair<FEXCore::Config::ConfigOption, std::string_view>;
+
+  explicit DecoderContext(std::initializer_list<Option> Options = {}) {
+    FEXCore::Config::Initialize();
+    FEXCore::Config::Load();
+    FEXCore::Config::Set(FEXCore::Config::CONFIG_IS64BIT_MODE, "1");
+    for (auto [Key, Value] : Options) {
+      FEXCore::Config::Set(Key, Value);
+    }
+
+    // The x86 tables only get set up once per process
+    [[maybe_unused]] static bool TablesInitialized = [] {
+      FEXCore::Context::InitializeStaticTables(FEXCore::Context::MODE_64BIT);
+      return true;
+    }();
+
+    CTX = FEXCore::Context::CreateNewContext();
+  }
+
+  ~DecoderContext() {
+    FEXCore::Context::DestroyContext(CTX);
+    FEXCore::Config::Shutdown();
+  }
+
+  DecoderContext(DecoderContext const &) = delete;
+  DecoderContext &operator=(DecoderContext const &) = delete;
+
+  FEXCore::Context::Context *CTX;
+};
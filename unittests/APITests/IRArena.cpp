@@ -0,0 +1,113 @@
+#include <catch2/catch.hpp>
+
+#include <FEXCore/IR/IREmitter.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+namespace {
+  // Emits a chain of adds, roughly what a block of simple ALU ops turns in to
+  void EmitBlock(FEXCore::IR::IREmitter &IR, size_t Ops) {
+    IR.ResetWorkingList();
+
+    FEXCore::IR::OrderedNode *Last = IR._Constant(1);
+    for (size_t i = 0; i < Ops; ++i) {
+      Last = IR._Add(Last, IR._Constant(static_cast<int64_t>(i)));
+    }
+  }
+
+  // Large enough to push both halves of the arena past the retained size
+  constexpr size_t LargeBlockOps = 64 * 1024;
+  // Past the first page but inside the retained size
+  constexpr size_t MediumBlockOps = 1024;
+  constexpr size_t SmallBlockOps = 64;
+}
+
+TEST_CASE("IRArena - Peak covers every compile since the last trim") {
+  FEXCore::IR::IREmitter IR;
+
+  EmitBlock(IR, LargeBlockOps);
+  const size_t LargePeak = IR.GetPeakIRSize();
+  CHECK(LargePeak > 0);
+
+  EmitBlock(IR, SmallBlockOps);
+  CHECK(IR.GetPeakIRSize() == LargePeak);
+
+  IR.TrimArena();
+  EmitBlock(IR, SmallBlockOps);
+  CHECK(IR.GetPeakIRSize() < LargePeak);
+}
+
+TEST_CASE("IRArena - Trim only releases past the retained size") {
+  FEXCore::IR::IREmitter IR;
+
+  EmitBlock(IR, SmallBlockOps);
+  CHECK_FALSE(IR.TrimArena());
+
+  EmitBlock(IR, LargeBlockOps);
+  CHECK(IR.TrimArena());
+
+  // The released pages come back zeroed and the arena keeps working
+  EmitBlock(IR, LargeBlockOps);
+  auto View = IR.ViewIR();
+  CHECK(View.GetSSACount() > LargeBlockOps);
+}
+
+TEST_CASE("IRArena - Release gives back the retained pages") {
+  FEXCore::IR::IREmitter IR;
+
+  EmitBlock(IR, MediumBlockOps);
+  CHECK_FALSE(IR.TrimArena());
+  CHECK(IR.ReleaseArena());
+
+  // Nothing was emitted since, so there is nothing left to release
+  CHECK_FALSE(IR.ReleaseArena());
+
+  EmitBlock(IR, MediumBlockOps);
+  auto View = IR.ViewIR();
+  CHECK(View.GetSSACount() > MediumBlockOps);
+  CHECK(IR.ReleaseArena());
+}
+
+// Only measures IR emission and arena trimming, no passes or backend run
+TEST_CASE("IRArena - 64 threads emitting IR at once", "[.][benchmark]") {
+  constexpr size_t NumThreads = 64;
+  constexpr size_t BlocksPerThread = 2000;
+
+  std::atomic<size_t> Peak {};
+  std::vector<std::thread> Threads;
+
+  auto Start = std::chrono::high_resolution_clock::now();
+  for (size_t Thread = 0; Thread < NumThreads; ++Thread) {
+    Threads.emplace_back([&Peak]() {
+      FEXCore::IR::IREmitter IR;
+      size_t LocalPeak {};
+
+      for (size_t i = 0; i < BlocksPerThread; ++i) {
+        // Mostly small blocks with the occasional huge one, like a real guest
+        EmitBlock(IR, (i % 256) == 0 ? LargeBlockOps : SmallBlockOps + (i % 64) * 8);
+        delete IR.CreateIRCopy();
+
+        LocalPeak = std::max(LocalPeak, IR.GetPeakIRSize());
+        IR.TrimArena();
+      }
+
+      size_t Current = Peak.load();
+      while (Current < LocalPeak && !Peak.compare_exchange_weak(Current, LocalPeak)) {
+      }
+    });
+  }
+
+  for (auto &Thread : Threads) {
+    Thread.join();
+  }
+  auto End = std::chrono::high_resolution_clock::now();
+
+  const double Seconds = std::chrono::duration<double>(End - Start).count();
+  printf("%zu threads: %8.2f K blocks emitted/s\n", NumThreads, static_cast<double>(NumThreads * BlocksPerThread) / Seconds / 1e3);
+  printf("Peak IR memory per block: %zu KB\n", Peak.load() / 1024);
+}
@@ -0,0 +1,125 @@
+#include <catch2/catch.hpp>
+
+#include "Interface/Core/Frontend.h"
+#include "Interface/Core/Interpreter/InterpreterOps.h"
+#include "Interface/Core/LookupCache.h"
+#include "Interface/Core/OpcodeDispatcher.h"
+#include "Interface/IR/PassManager.h"
+
+#include <FEXCore/Core/CoreState.h>
+#include <FEXCore/Debug/InternalThreadState.h>
+#include <FEXCore/IR/IREmitter.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+namespace {
+  constexpr uint32_t CounterOffset = offsetof(FEXCore::Core::CPUState, gs_cached);
+  constexpr uint32_t AccumulatorOffset = offsetof(FEXCore::Core::CPUState, fs_cached);
+
+  // A loop of integer ALU ops on context values, roughly what a block of simple guest code turns in to
+  std::unique_ptr<FEXCore::IR::IRListView> EmitLoop(FEXCore::IR::IREmitter &IR, uint64_t Iterations, size_t OpsPerIteration) {
+    using namespace FEXCore::IR;
+    IR.ResetWorkingList();
+
+    auto Header = IR._IRHeader(IR.Invalid(), 2);
+    auto Loop = IR.CreateCodeNode();
+    auto Exit = IR.CreateCodeNode();
+    IR.LinkCodeBlocks(Loop, Exit);
+    Header.first->Blocks = Loop.Node->Wrapped(IR.ViewIR().GetListData());
+
+    IR.SetCurrentCodeBlock(Loop);
+    OrderedNode *Counter = IR._LoadContext(8, GPRClass, CounterOffset);
+    OrderedNode *Value = IR._LoadContext(8, GPRClass, AccumulatorOffset);
+    for (size_t i = 0; i < OpsPerIteration; ++i) {
+      switch (i % 4) {
+        case 0: Value = IR._Add(Value, IR._Constant(i)); break;
+        case 1: Value = IR._Xor(Value, Counter); break;
+        case 2: Value = IR._Sub(Value, IR._Constant(i * 3)); break;
+        case 3: Value = IR._Or(IR._And(Value, IR._Constant(~i)), IR._Constant(i & 0xff)); break;
+      }
+    }
+    IR._StoreContext(8, GPRClass, Value, AccumulatorOffset);
+    OrderedNode *Next = IR._Add(Counter, IR._Constant(1));
+    IR._StoreContext(8, GPRClass, Next, CounterOffset);
+    IR._CondJump(Next, IR._Constant(Iterations), Loop, Exit, {COND_NEQ}, 8);
+
+    return std::unique_ptr<IRListView>(IR.CreateIRCopy());
+  }
+
+  struct Executor {
+    Executor() {
+      Frame = Thread.CurrentFrame;
+      Frame->Thread = &Thread;
+    }
+
+    void Reset() {
+      Frame->State.gs_cached = 0;
+      Frame->State.fs_cached = 0x1234;
+    }
+
+    uint64_t InterpretIR(FEXCore::IR::IRListView const *IR) {
+      Reset();
+      FEXCore::CPU::InterpreterOps::InterpretIR(Frame, IR);
+      return Frame->State.fs_cached;
+    }
+
+    uint64_t InterpretPredecoded(FEXCore::CPU::InterpreterOps::PredecodedFragment const *Fragment) {
+      Reset();
+      FEXCore::CPU::InterpreterOps::InterpretPredecoded(Frame, Fragment);
+      return Frame->State.fs_cached;
+    }
+
+    FEXCore::Core::InternalThreadState Thread{};
+    FEXCore::Core::CpuStateFrame *Frame;
+  };
+
+  struct Predecoded {
+    explicit Predecoded(FEXCore::IR::IRListView const *IR)
+      : Ops(FEXCore::CPU::InterpreterOps::GetMaxPredecodedOps(IR)) {
+      FEXCore::CPU::InterpreterOps::Predecode(&Fragment, Ops.data(), IR);
+    }
+
+    FEXCore::CPU::InterpreterOps::PredecodedFragment Fragment;
+    std::vector<FEXCore::CPU::InterpreterOps::PredecodedOp> Ops;
+  };
+}
+
+TEST_CASE("InterpreterPredecode - Matches the IR walker") {
+  FEXCore::IR::IREmitter IR;
+  auto Loop = EmitLoop(IR, 100, 64);
+  Predecoded Fragment(Loop.get());
+  Executor Exec;
+
+  const uint64_t Expected = Exec.InterpretIR(Loop.get());
+  CHECK(Exec.Frame->State.gs_cached == 100);
+  CHECK(Exec.InterpretPredecoded(&Fragment.Fragment) == Expected);
+  CHECK(Exec.Frame->State.gs_cached == 100);
+}
+
+TEST_CASE("InterpreterPredecode - Executor throughput", "[.][benchmark]") {
+  constexpr uint64_t Iterations = 100000;
+  constexpr size_t OpsPerIteration = 64;
+
+  FEXCore::IR::IREmitter IR;
+  auto Loop = EmitLoop(IR, Iterations, OpsPerIteration);
+  Predecoded Fragment(Loop.get());
+  Executor Exec;
+
+  auto Measure = [&](auto &&Execute) {
+    auto Start = std::chrono::high_resolution_clock::now();
+    Execute();
+    auto End = std::chrono::high_resolution_clock::now();
+    const double Seconds = std::chrono::duration<double>(End - Start).count();
+    // Every iteration also runs the loads, stores, increment and branch
+    return static_cast<double>(Loop->GetSSACount()) * Iterations / Seconds / 1e6;
+  };
+
+  const double Walk = Measure([&] { Exec.InterpretIR(Loop.get()); });
+  const double Predecode = Measure([&] { Exec.InterpretPredecoded(&Fragment.Fragment); });
+  printf("IR walker:   %8.2f M nodes/s\n", Walk);
+  printf("Pre-decoded: %8.2f M nodes/s (%.2fx)\n", Predecode, Predecode / Walk);
+}
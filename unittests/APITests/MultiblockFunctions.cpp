@@ -0,0 +1,141 @@
+#include <catch2/catch.hpp>
+
+#include "DecoderContext.h"
+#include "Interface/Core/Frontend.h"
+
+#include <FEXHeaderUtils/TypeDefines.h>
+
+#include <cstring>
+#include <vector>
+#include <sys/mman.h>
+
+namespace {
+  DecoderContext::Option FunctionMultiblock(bool Enabled) {
+    return {FEXCore::Config::CONFIG_MULTIBLOCKFUNCTIONS, Enabled ? "1" : "0"};
+  }
+
+  // A loop whose back edge branches to before the entrypoint
+  constexpr uint8_t LoopCode[] = {
+    0x48, 0xff, 0xc0,                   // 0x0: inc rax
+    0x48, 0xff, 0xc3,                   // 0x3: inc rbx
+    0x48, 0x39, 0xc8,                   // 0x6: cmp rax, rcx
+    0x75, 0xf5,                         // 0x9: jne 0x0
+    0xc3,                               // 0xb: ret
+  };
+
+  // Calls out of the function in the middle and carries on at the return site
+  constexpr uint8_t CallCode[] = {
+    0x48, 0xff, 0xc0,                   // 0x0: inc rax
+    0xe8, 0x00, 0x01, 0x00, 0x00,       // 0x3: call 0x108
+    0x48, 0xff, 0xc3,                   // 0x8: inc rbx
+    0xc3,                               // 0xb: ret
+  };
+
+  struct GuestFunction {
+    template<size_t N>
+    explicit GuestFunction(uint8_t const (&Function)[N])
+      : Size {N} {
+      Code = static_cast<uint8_t*>(mmap(nullptr, FHU::FEX_PAGE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+      REQUIRE(Code != MAP_FAILED);
+      memcpy(Code, Function, N);
+    }
+
+    ~GuestFunction() {
+      munmap(Code, FHU::FEX_PAGE_SIZE);
+    }
+
+    uint64_t Address(uint64_t Offset) const {
+      return reinterpret_cast<uint64_t>(Code) + Offset;
+    }
+
+    uint8_t *Code;
+    uint64_t Size;
+  };
+
+  struct DecodedEntries {
+    std::vector<uint64_t> Blocks;
+    std::vector<uint64_t> ResumeEntries;
+  };
+
+  DecodedEntries DecodeBlockEntries(FEXCore::Context::Context *CTX, GuestFunction const &Function, uint64_t Offset) {
+    FEXCore::Frontend::Decoder Decoder(CTX);
+    Decoder.DecodeInstructionsAtEntry(Function.Code + Offset, Function.Address(Offset), [](uint64_t, uint64_t, uint64_t) {});
+
+    DecodedEntries Entries;
+    for (auto &Block : *Decoder.GetDecodedBlocks()) {
+      Entries.Blocks.emplace_back(Block.Entry - Function.Address(0));
+      if (Block.IsResumeEntry) {
+        Entries.ResumeEntries.emplace_back(Block.Entry - Function.Address(0));
+      }
+    }
+    return Entries;
+  }
+}
+
+TEST_CASE("MultiblockFunctions - Range lookup") {
+  DecoderContext Context({{FEXCore::Config::CONFIG_MULTIBLOCK, "1"}, FunctionMultiblock(true)});
+  auto CTX = Context.CTX;
+
+  FEXCore::Context::AddFunctionRanges(CTX, {{0x1000, 0x1100}, {0x1100, 0x1200}});
+
+  FEXCore::Context::FunctionRange Range{};
+  REQUIRE(CTX->FindFunctionRange(0x10ff, &Range));
+  CHECK(Range.Start == 0x1000);
+  CHECK(Range.End == 0x1100);
+  REQUIRE(CTX->FindFunctionRange(0x1100, &Range));
+  CHECK(Range.Start == 0x1100);
+  CHECK_FALSE(CTX->FindFunctionRange(0xfff, &Range));
+  CHECK_FALSE(CTX->FindFunctionRange(0x1200, &Range));
+
+  // An overlapping range replaces both
+  FEXCore::Context::AddFunctionRanges(CTX, {{0x1080, 0x1180}});
+  CHECK_FALSE(CTX->FindFunctionRange(0x1000, &Range));
+  REQUIRE(CTX->FindFunctionRange(0x1080, &Range));
+  CHECK(Range.End == 0x1180);
+  CHECK_FALSE(CTX->FindFunctionRange(0x1180, &Range));
+
+  FEXCore::Context::RemoveFunctionRanges(CTX, 0x1000, 0x1000);
+  CHECK_FALSE(CTX->FindFunctionRange(0x1080, &Range));
+}
+
+TEST_CASE("MultiblockFunctions - Backwards branch stays in the unit") {
+  DecoderContext Context({{FEXCore::Config::CONFIG_MULTIBLOCK, "1"}, FunctionMultiblock(true)});
+  GuestFunction Function(LoopCode);
+
+  FEXCore::Context::AddFunctionRanges(Context.CTX, {{Function.Address(0), Function.Address(Function.Size)}});
+
+  // The entry block comes first, the rest are sorted
+  CHECK(DecodeBlockEntries(Context.CTX, Function, 3).Blocks == std::vector<uint64_t>{0x3, 0x0, 0xb});
+}
+
+TEST_CASE("MultiblockFunctions - Plain multiblock stops at the entrypoint") {
+  DecoderContext Context({{FEXCore::Config::CONFIG_MULTIBLOCK, "1"}, FunctionMultiblock(false)});
+  GuestFunction Function(LoopCode);
+
+  FEXCore::Context::AddFunctionRanges(Context.CTX, {{Function.Address(0), Function.Address(Function.Size)}});
+
+  CHECK(DecodeBlockEntries(Context.CTX, Function, 3).Blocks == std::vector<uint64_t>{0x3});
+}
+
+TEST_CASE("MultiblockFunctions - Compiling continues past a call") {
+  DecoderContext Context({{FEXCore::Config::CONFIG_MULTIBLOCK, "1"}, FunctionMultiblock(true)});
+  GuestFunction Function(CallCode);
+
+  FEXCore::Context::AddFunctionRanges(Context.CTX, {{Function.Address(0), Function.Address(Function.Size)}});
+
+  // The call target is outside of the function so it stays an exit
+  auto Entries = DecodeBlockEntries(Context.CTX, Function, 0);
+  CHECK(Entries.Blocks == std::vector<uint64_t>{0x0, 0x8});
+  CHECK(Entries.ResumeEntries == std::vector<uint64_t>{0x8});
+}
+
+TEST_CASE("MultiblockFunctions - Plain multiblock stops at a call") {
+  DecoderContext Context({{FEXCore::Config::CONFIG_MULTIBLOCK, "1"}, FunctionMultiblock(false)});
+  GuestFunction Function(CallCode);
+
+  FEXCore::Context::AddFunctionRanges(Context.CTX, {{Function.Address(0), Function.Address(Function.Size)}});
+
+  auto Entries = DecodeBlockEntries(Context.CTX, Function, 0);
+  CHECK(Entries.Blocks == std::vector<uint64_t>{0x0});
+  CHECK(Entries.ResumeEntries.empty());
+}
@@ -0,0 +1,43 @@
+#include <catch2/catch.hpp>
+
+#include <FEXCore/Core/CoreState.h>
+#include <FEXCore/Core/X86Enums.h>
+
+#include <stdint.h>
+
+namespace {
+  constexpr uint32_t PF = 1U << FEXCore::X86State::RFLAG_PF_LOC;
+  constexpr uint32_t AF = 1U << FEXCore::X86State::RFLAG_AF_LOC;
+}
+
+TEST_CASE("PackedEFLAGS - Round trip") {
+  FEXCore::Core::CPUState State{};
+
+  for (uint32_t EFLAGS = 0; EFLAGS < (1U << (FEXCore::X86State::RFLAG_ID_LOC + 1)); ++EFLAGS) {
+    State.SetPackedEFLAGS(EFLAGS);
+    REQUIRE(State.GetPackedEFLAGS() == EFLAGS);
+  }
+}
+
+TEST_CASE("PackedEFLAGS - Lazy PF and AF") {
+  FEXCore::Core::CPUState State{};
+  State.SetPackedEFLAGS(0);
+
+  const auto SetRaw = [&State](uint8_t Res, uint8_t Src1, uint8_t Src2) {
+    // What an ADD or SUB leaves behind
+    State.flags[FEXCore::X86State::RFLAG_PF_LOC] = Res;
+    State.flags[FEXCore::X86State::RFLAG_AF_LOC] = Src1 ^ Src2;
+  };
+
+  // 0x0f + 0x01: Carry out of bit 3, odd parity
+  SetRaw(0x10, 0x0f, 0x01);
+  CHECK((State.GetPackedEFLAGS() & (PF | AF)) == AF);
+
+  // 0x01 + 0x02: No carry out of bit 3, even parity
+  SetRaw(0x03, 0x01, 0x02);
+  CHECK((State.GetPackedEFLAGS() & (PF | AF)) == PF);
+
+  // 0x10 - 0x01: Borrow in to bit 3, even parity
+  SetRaw(0x0f, 0x10, 0x01);
+  CHECK((State.GetPackedEFLAGS() & (PF | AF)) == (PF | AF));
+}
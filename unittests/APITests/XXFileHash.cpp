@@ -0,0 +1,114 @@
+#include <catch2/catch.hpp>
+#include "Tools/FEXRootFSFetcher/XXFileHash.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fcntl.h>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+  // Temporary file that gets removed again
+  struct TempFile {
+    TempFile() {
+      char Template[] = "/tmp/XXFileHashXXXXXX";
+      FD = mkstemp(Template);
+      Path = Template;
+    }
+
+    ~TempFile() {
+      close(FD);
+      unlink(Path.c_str());
+    }
+
+    // Fills the file with a pattern that doesn't repeat per chunk
+    void Fill(uint64_t Size) {
+      std::vector<uint64_t> Block(1024 * 1024);
+      uint64_t Value = 0x9E3779B97F4A7C15ULL;
+      for (uint64_t Offset = 0; Offset < Size; Offset += Block.size() * sizeof(uint64_t)) {
+        for (auto &Word : Block) {
+          Value ^= Value << 13;
+          Value ^= Value >> 7;
+          Value ^= Value << 17;
+          Word = Value;
+        }
+        const size_t Length = std::min<uint64_t>(Size - Offset, Block.size() * sizeof(uint64_t));
+        REQUIRE(pwrite(FD, Block.data(), Length, Offset) == static_cast<ssize_t>(Length));
+      }
+    }
+
+    int FD;
+    std::string Path;
+  };
+}
+
+TEST_CASE("ChunkedHash - Thread count doesn't change the hash") {
+  TempFile File;
+  File.Fill(XXFileHash::CHUNK_SIZE * 3 + 4097);
+
+  auto Single = XXFileHash::HashFileChunked(File.Path, 1);
+  REQUIRE(Single.first);
+
+  for (size_t Threads : {2, 3, 7, 0}) {
+    auto Multi = XXFileHash::HashFileChunked(File.Path, Threads);
+    REQUIRE(Multi.first);
+    CHECK(Multi.second == Single.second);
+  }
+}
+
+TEST_CASE("ChunkedHash - Detects changes") {
+  TempFile File;
+  File.Fill(XXFileHash::CHUNK_SIZE * 2 + 1);
+  auto Original = XXFileHash::HashFileChunked(File.Path);
+  REQUIRE(Original.first);
+
+  // Flip a byte in the last, partial chunk
+  uint8_t Byte{};
+  const off_t Offset = XXFileHash::CHUNK_SIZE * 2;
+  REQUIRE(pread(File.FD, &Byte, 1, Offset) == 1);
+  Byte ^= 1;
+  REQUIRE(pwrite(File.FD, &Byte, 1, Offset) == 1);
+
+  auto Changed = XXFileHash::HashFileChunked(File.Path);
+  REQUIRE(Changed.first);
+  CHECK(Changed.second != Original.second);
+
+  // Growing the file by a zero byte changes it as well
+  Byte ^= 1;
+  REQUIRE(pwrite(File.FD, &Byte, 1, Offset) == 1);
+  REQUIRE(ftruncate(File.FD, Offset + 2) == 0);
+  auto Grown = XXFileHash::HashFileChunked(File.Path);
+  REQUIRE(Grown.first);
+  CHECK(Grown.second != Original.second);
+}
+
+TEST_CASE("ChunkedHash - Empty and missing files") {
+  TempFile File;
+  auto Empty = XXFileHash::HashFileChunked(File.Path);
+  CHECK(Empty.first);
+
+  auto Missing = XXFileHash::HashFileChunked("/tmp/XXFileHash-does-not-exist");
+  CHECK(!Missing.first);
+}
+
+TEST_CASE("ChunkedHash - 4GiB file", "[.][benchmark]") {
+  TempFile File;
+  File.Fill(4ULL * 1024 * 1024 * 1024);
+
+  auto Time = [&](auto &&Func) {
+    auto Start = std::chrono::high_resolution_clock::now();
+    auto Result = Func();
+    auto End = std::chrono::high_resolution_clock::now();
+    REQUIRE(Result.first);
+    return std::chrono::duration_cast<std::chrono::milliseconds>(End - Start).count();
+  };
+
+  // The file was just written so it is in the page cache for both
+  auto Linear = Time([&]() { return XXFileHash::HashFile(File.Path); });
+  auto Chunked = Time([&]() { return XXFileHash::HashFileChunked(File.Path); });
+
+  printf("HashFile: %lld ms\n", static_cast<long long>(Linear));
+  printf("HashFileChunked: %lld ms\n", static_cast<long long>(Chunked));
+}
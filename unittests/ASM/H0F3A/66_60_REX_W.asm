@@ -0,0 +1,222 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "RDI": "0x80000000800000",
+    "RBP": "0x88100ff00800000",
+    "R8": "0x88100ff088100ff",
+    "R9": "0x800000088100ff",
+    "R10": "0x80000000800000",
+    "R11": "0x88100ff00800000",
+    "R12": "0x88100ff088100ff",
+    "R13": "0x800000088100ff",
+    "R14": "0x80000008810000",
+    "R15": "0x881000008810000",
+    "XMM3": ["0xffffffffffffffff", "0xffffffffffffffff"],
+    "XMM4": ["0x0", "0x0"],
+    "XMM5": ["0xffffffffffffffff", "0xffffffffffffffff"],
+    "XMM6": ["0xffffffffffffffff", "0xffffffffffffffff"]
+  }
+}
+%endif
+
+; pcmpestrm with REX.W and zero lengths
+; Each result is packed in to 32 bits as (RFLAGS & 0x8D5) << 16 | xmm0[31:0], two per register
+
+lea rsi, [rel .data]
+
+movaps xmm1, [rsi + 16 * 0]
+mov rax, 0x0
+mov rdx, 0xffffffff00000000
+
+db 0x66, 0x48, 0x0f, 0x3a, 0x60, 0x4e, 0x10, 0x01 ; pcmpestrm xmm1, [rsi + 16 * 1], 0x01
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+mov rdi, rbx
+
+db 0x66, 0x48, 0x0f, 0x3a, 0x60, 0x4e, 0x10, 0x05 ; pcmpestrm xmm1, [rsi + 16 * 1], 0x05
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+shl rbx, 32
+or rdi, rbx
+
+db 0x66, 0x48, 0x0f, 0x3a, 0x60, 0x4e, 0x10, 0x09 ; pcmpestrm xmm1, [rsi + 16 * 1], 0x09
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+mov rbp, rbx
+
+db 0x66, 0x48, 0x0f, 0x3a, 0x60, 0x4e, 0x10, 0x0d ; pcmpestrm xmm1, [rsi + 16 * 1], 0x0d
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+shl rbx, 32
+or rbp, rbx
+
+db 0x66, 0x48, 0x0f, 0x3a, 0x60, 0x4e, 0x10, 0x11 ; pcmpestrm xmm1, [rsi + 16 * 1], 0x11
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+mov r8, rbx
+
+db 0x66, 0x48, 0x0f, 0x3a, 0x60, 0x4e, 0x10, 0x15 ; pcmpestrm xmm1, [rsi + 16 * 1], 0x15
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+shl rbx, 32
+or r8, rbx
+
+db 0x66, 0x48, 0x0f, 0x3a, 0x60, 0x4e, 0x10, 0x19 ; pcmpestrm xmm1, [rsi + 16 * 1], 0x19
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+mov r9, rbx
+
+db 0x66, 0x48, 0x0f, 0x3a, 0x60, 0x4e, 0x10, 0x1d ; pcmpestrm xmm1, [rsi + 16 * 1], 0x1d
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+shl rbx, 32
+or r9, rbx
+
+db 0x66, 0x48, 0x0f, 0x3a, 0x60, 0x4e, 0x10, 0x21 ; pcmpestrm xmm1, [rsi + 16 * 1], 0x21
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+mov r10, rbx
+
+db 0x66, 0x48, 0x0f, 0x3a, 0x60, 0x4e, 0x10, 0x25 ; pcmpestrm xmm1, [rsi + 16 * 1], 0x25
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+shl rbx, 32
+or r10, rbx
+
+db 0x66, 0x48, 0x0f, 0x3a, 0x60, 0x4e, 0x10, 0x29 ; pcmpestrm xmm1, [rsi + 16 * 1], 0x29
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+mov r11, rbx
+
+db 0x66, 0x48, 0x0f, 0x3a, 0x60, 0x4e, 0x10, 0x2d ; pcmpestrm xmm1, [rsi + 16 * 1], 0x2d
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+shl rbx, 32
+or r11, rbx
+
+db 0x66, 0x48, 0x0f, 0x3a, 0x60, 0x4e, 0x10, 0x31 ; pcmpestrm xmm1, [rsi + 16 * 1], 0x31
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+mov r12, rbx
+
+db 0x66, 0x48, 0x0f, 0x3a, 0x60, 0x4e, 0x10, 0x35 ; pcmpestrm xmm1, [rsi + 16 * 1], 0x35
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+shl rbx, 32
+or r12, rbx
+
+db 0x66, 0x48, 0x0f, 0x3a, 0x60, 0x4e, 0x10, 0x39 ; pcmpestrm xmm1, [rsi + 16 * 1], 0x39
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+mov r13, rbx
+
+db 0x66, 0x48, 0x0f, 0x3a, 0x60, 0x4e, 0x10, 0x3d ; pcmpestrm xmm1, [rsi + 16 * 1], 0x3d
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+shl rbx, 32
+or r13, rbx
+
+db 0x66, 0x48, 0x0f, 0x3a, 0x60, 0x4e, 0x10, 0x51 ; pcmpestrm xmm1, [rsi + 16 * 1], 0x51
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movaps xmm3, xmm0
+mov r14, rbx
+
+db 0x66, 0x48, 0x0f, 0x3a, 0x60, 0x4e, 0x10, 0x65 ; pcmpestrm xmm1, [rsi + 16 * 1], 0x65
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movaps xmm4, xmm0
+shl rbx, 32
+or r14, rbx
+
+db 0x66, 0x48, 0x0f, 0x3a, 0x60, 0x4e, 0x10, 0x79 ; pcmpestrm xmm1, [rsi + 16 * 1], 0x79
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movaps xmm5, xmm0
+mov r15, rbx
+
+db 0x66, 0x48, 0x0f, 0x3a, 0x60, 0x4e, 0x10, 0x4d ; pcmpestrm xmm1, [rsi + 16 * 1], 0x4d
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movaps xmm6, xmm0
+shl rbx, 32
+or r15, rbx
+
+hlt
+
+align 16
+.data:
+db 0x41, 0x00, 0x5a, 0x00, 0x61, 0x00, 0x34, 0x12, 0x00, 0x00, 0x55, 0x55, 0x66, 0x66, 0x77, 0x77
+db 0x61, 0x00, 0x41, 0x00, 0x5a, 0x00, 0x61, 0x00, 0x34, 0x12, 0x30, 0x00, 0x00, 0x00, 0x5a, 0x00
@@ -0,0 +1,222 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "RDI": "0x8c11f3d00c1113c",
+    "RBP": "0xc0000000c1c014",
+    "R8": "0xc1e0c208c1eec3",
+    "R9": "0x8c1ffff08c13feb",
+    "R10": "0x8c11f3d00c1113c",
+    "R11": "0xc0000000c1c014",
+    "R12": "0xc120c208c12ec3",
+    "R13": "0x8c13fff08c1ffeb",
+    "R14": "0x8c1000008c10000",
+    "R15": "0xc0000008c10000",
+    "XMM3": ["0xffff00000000ffff", "0xffffff00ffffff00"],
+    "XMM4": ["0xffffffff00ff", "0xffffffffff"],
+    "XMM5": ["0xffffff00ff00ffff", "0xffffffffffffffff"],
+    "XMM6": ["0x0", "0x0"]
+  }
+}
+%endif
+
+; pcmpestrm with signed bytes, every aggregation and polarity
+; Each result is packed in to 32 bits as (RFLAGS & 0x8D5) << 16 | xmm0[31:0], two per register
+
+lea rsi, [rel .data]
+
+movaps xmm1, [rsi + 16 * 0]
+mov rax, 0xfffffffffffffffa
+mov rdx, 0xe
+
+pcmpestrm xmm1, [rsi + 16 * 1], 0x02
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+mov rdi, rbx
+
+pcmpestrm xmm1, [rsi + 16 * 1], 0x06
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+shl rbx, 32
+or rdi, rbx
+
+pcmpestrm xmm1, [rsi + 16 * 1], 0x0a
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+mov rbp, rbx
+
+pcmpestrm xmm1, [rsi + 16 * 1], 0x0e
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+shl rbx, 32
+or rbp, rbx
+
+pcmpestrm xmm1, [rsi + 16 * 1], 0x12
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+mov r8, rbx
+
+pcmpestrm xmm1, [rsi + 16 * 1], 0x16
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+shl rbx, 32
+or r8, rbx
+
+pcmpestrm xmm1, [rsi + 16 * 1], 0x1a
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+mov r9, rbx
+
+pcmpestrm xmm1, [rsi + 16 * 1], 0x1e
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+shl rbx, 32
+or r9, rbx
+
+pcmpestrm xmm1, [rsi + 16 * 1], 0x22
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+mov r10, rbx
+
+pcmpestrm xmm1, [rsi + 16 * 1], 0x26
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+shl rbx, 32
+or r10, rbx
+
+pcmpestrm xmm1, [rsi + 16 * 1], 0x2a
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+mov r11, rbx
+
+pcmpestrm xmm1, [rsi + 16 * 1], 0x2e
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+shl rbx, 32
+or r11, rbx
+
+pcmpestrm xmm1, [rsi + 16 * 1], 0x32
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+mov r12, rbx
+
+pcmpestrm xmm1, [rsi + 16 * 1], 0x36
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+shl rbx, 32
+or r12, rbx
+
+pcmpestrm xmm1, [rsi + 16 * 1], 0x3a
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+mov r13, rbx
+
+pcmpestrm xmm1, [rsi + 16 * 1], 0x3e
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+shl rbx, 32
+or r13, rbx
+
+pcmpestrm xmm1, [rsi + 16 * 1], 0x52
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movaps xmm3, xmm0
+mov r14, rbx
+
+pcmpestrm xmm1, [rsi + 16 * 1], 0x66
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movaps xmm4, xmm0
+shl rbx, 32
+or r14, rbx
+
+pcmpestrm xmm1, [rsi + 16 * 1], 0x7a
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movaps xmm5, xmm0
+mov r15, rbx
+
+pcmpestrm xmm1, [rsi + 16 * 1], 0x4e
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movaps xmm6, xmm0
+shl rbx, 32
+or r15, rbx
+
+hlt
+
+align 16
+.data:
+db 0xf6, 0x0a, 0x80, 0x9c, 0x05, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a
+db 0xfb, 0x14, 0x80, 0x00, 0x05, 0x0a, 0x0b, 0xf5, 0x9c, 0x9b, 0x01, 0x02, 0xf6, 0x7f, 0x00, 0x03
@@ -0,0 +1,222 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "RDI": "0x8c1002f08c10007",
+    "RBP": "0xc0000008c100c7",
+    "R8": "0xc100d000c100f8",
+    "R9": "0x8c100ff00c10038",
+    "R10": "0x8c1002f08c10007",
+    "R11": "0xc0000008c100c7",
+    "R12": "0xc1001000c10038",
+    "R13": "0x8c1003f00c100f8",
+    "R14": "0x8c1000000c10000",
+    "R15": "0xc0000000c10000",
+    "XMM3": ["0xffff000000000000", "0xffffffffffffffff"],
+    "XMM4": ["0xffffffffffffffff", "0xffff0000"],
+    "XMM5": ["0xffff000000000000", "0xffffffffffffffff"],
+    "XMM6": ["0x0", "0x0"]
+  }
+}
+%endif
+
+; pcmpestrm with signed words, every aggregation and polarity
+; Each result is packed in to 32 bits as (RFLAGS & 0x8D5) << 16 | xmm0[31:0], two per register
+
+lea rsi, [rel .data]
+
+movaps xmm1, [rsi + 16 * 0]
+mov rax, 0x4
+mov rdx, 0x6
+
+pcmpestrm xmm1, [rsi + 16 * 1], 0x03
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+mov rdi, rbx
+
+pcmpestrm xmm1, [rsi + 16 * 1], 0x07
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+shl rbx, 32
+or rdi, rbx
+
+pcmpestrm xmm1, [rsi + 16 * 1], 0x0b
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+mov rbp, rbx
+
+pcmpestrm xmm1, [rsi + 16 * 1], 0x0f
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+shl rbx, 32
+or rbp, rbx
+
+pcmpestrm xmm1, [rsi + 16 * 1], 0x13
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+mov r8, rbx
+
+pcmpestrm xmm1, [rsi + 16 * 1], 0x17
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+shl rbx, 32
+or r8, rbx
+
+pcmpestrm xmm1, [rsi + 16 * 1], 0x1b
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+mov r9, rbx
+
+pcmpestrm xmm1, [rsi + 16 * 1], 0x1f
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+shl rbx, 32
+or r9, rbx
+
+pcmpestrm xmm1, [rsi + 16 * 1], 0x23
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+mov r10, rbx
+
+pcmpestrm xmm1, [rsi + 16 * 1], 0x27
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+shl rbx, 32
+or r10, rbx
+
+pcmpestrm xmm1, [rsi + 16 * 1], 0x2b
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+mov r11, rbx
+
+pcmpestrm xmm1, [rsi + 16 * 1], 0x2f
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+shl rbx, 32
+or r11, rbx
+
+pcmpestrm xmm1, [rsi + 16 * 1], 0x33
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+mov r12, rbx
+
+pcmpestrm xmm1, [rsi + 16 * 1], 0x37
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+shl rbx, 32
+or r12, rbx
+
+pcmpestrm xmm1, [rsi + 16 * 1], 0x3b
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+mov r13, rbx
+
+pcmpestrm xmm1, [rsi + 16 * 1], 0x3f
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+shl rbx, 32
+or r13, rbx
+
+pcmpestrm xmm1, [rsi + 16 * 1], 0x53
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movaps xmm3, xmm0
+mov r14, rbx
+
+pcmpestrm xmm1, [rsi + 16 * 1], 0x67
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movaps xmm4, xmm0
+shl rbx, 32
+or r14, rbx
+
+pcmpestrm xmm1, [rsi + 16 * 1], 0x7b
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movaps xmm5, xmm0
+mov r15, rbx
+
+pcmpestrm xmm1, [rsi + 16 * 1], 0x4f
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movaps xmm6, xmm0
+shl rbx, 32
+or r15, rbx
+
+hlt
+
+align 16
+.data:
+db 0x18, 0xfc, 0xe8, 0x03, 0x00, 0x80, 0xd0, 0x8a, 0x00, 0x00, 0x07, 0x00, 0x07, 0x00, 0x07, 0x00
+db 0x18, 0xfc, 0xe8, 0x03, 0x00, 0x80, 0xe7, 0x03, 0x17, 0xfc, 0x00, 0x00, 0xd0, 0x8a, 0x05, 0x00
@@ -0,0 +1,222 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "RDI": "0x8c1167b00c11678",
+    "RBP": "0xc1000800c1e000",
+    "R8": "0xc1e98408c1e987",
+    "R9": "0x8c1fff708c11fff",
+    "R10": "0x8c1167b00c11678",
+    "R11": "0xc1000800c1e000",
+    "R12": "0xc1098408c10987",
+    "R13": "0x8c11ff708c1ffff",
+    "R14": "0x8c1000008c10000",
+    "R15": "0xc1000008c10000",
+    "XMM3": ["0xff00000000ffffff", "0xffffff00ff0000ff"],
+    "XMM4": ["0xffffffff00ffff", "0xff00ffff00"],
+    "XMM5": ["0xffffffffffffffff", "0xffffffffffffffff"],
+    "XMM6": ["0xff000000", "0x0"]
+  }
+}
+%endif
+
+; pcmpestrm with unsigned bytes, every aggregation and polarity
+; Each result is packed in to 32 bits as (RFLAGS & 0x8D5) << 16 | xmm0[31:0], two per register
+
+lea rsi, [rel .data]
+
+movaps xmm1, [rsi + 16 * 0]
+mov rax, 0x4
+mov rdx, 0xd
+
+pcmpestrm xmm1, [rsi + 16 * 1], 0x00
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+mov rdi, rbx
+
+pcmpestrm xmm1, [rsi + 16 * 1], 0x04
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+shl rbx, 32
+or rdi, rbx
+
+pcmpestrm xmm1, [rsi + 16 * 1], 0x08
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+mov rbp, rbx
+
+pcmpestrm xmm1, [rsi + 16 * 1], 0x0c
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+shl rbx, 32
+or rbp, rbx
+
+pcmpestrm xmm1, [rsi + 16 * 1], 0x10
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+mov r8, rbx
+
+pcmpestrm xmm1, [rsi + 16 * 1], 0x14
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+shl rbx, 32
+or r8, rbx
+
+pcmpestrm xmm1, [rsi + 16 * 1], 0x18
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+mov r9, rbx
+
+pcmpestrm xmm1, [rsi + 16 * 1], 0x1c
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+shl rbx, 32
+or r9, rbx
+
+pcmpestrm xmm1, [rsi + 16 * 1], 0x20
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+mov r10, rbx
+
+pcmpestrm xmm1, [rsi + 16 * 1], 0x24
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+shl rbx, 32
+or r10, rbx
+
+pcmpestrm xmm1, [rsi + 16 * 1], 0x28
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+mov r11, rbx
+
+pcmpestrm xmm1, [rsi + 16 * 1], 0x2c
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+shl rbx, 32
+or r11, rbx
+
+pcmpestrm xmm1, [rsi + 16 * 1], 0x30
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+mov r12, rbx
+
+pcmpestrm xmm1, [rsi + 16 * 1], 0x34
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+shl rbx, 32
+or r12, rbx
+
+pcmpestrm xmm1, [rsi + 16 * 1], 0x38
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+mov r13, rbx
+
+pcmpestrm xmm1, [rsi + 16 * 1], 0x3c
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+shl rbx, 32
+or r13, rbx
+
+pcmpestrm xmm1, [rsi + 16 * 1], 0x50
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movaps xmm3, xmm0
+mov r14, rbx
+
+pcmpestrm xmm1, [rsi + 16 * 1], 0x64
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movaps xmm4, xmm0
+shl rbx, 32
+or r14, rbx
+
+pcmpestrm xmm1, [rsi + 16 * 1], 0x78
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movaps xmm5, xmm0
+mov r15, rbx
+
+pcmpestrm xmm1, [rsi + 16 * 1], 0x4c
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movaps xmm6, xmm0
+shl rbx, 32
+or r15, rbx
+
+hlt
+
+align 16
+.data:
+db 0x61, 0x7a, 0x41, 0x5a, 0x00, 0x71, 0x77, 0x65, 0x72, 0x74, 0x79, 0x75, 0x69, 0x6f, 0x70, 0x00
+db 0x48, 0x69, 0x20, 0x61, 0x7a, 0x41, 0x5a, 0x2c, 0x20, 0x41, 0x5a, 0x20, 0x61, 0x7a, 0x21, 0x00
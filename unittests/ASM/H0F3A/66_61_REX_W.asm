@@ -0,0 +1,202 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "RDI": "0x801000000010001",
+    "RBP": "0x100001000f",
+    "R8": "0x1008010000",
+    "R9": "0x801000008010000",
+    "R10": "0x801000000010001",
+    "R11": "0x100001000f",
+    "R12": "0x1008010000",
+    "R13": "0x801000008010000",
+    "R14": "0x801000f0801000e",
+    "R15": "0x100801000e"
+  }
+}
+%endif
+
+; pcmpestri with REX.W, RAX/RDX lengths differ from EAX/EDX
+; Each result is packed in to 32 bits as (RFLAGS & 0x8D5) << 16 | ecx, two per register
+
+lea rsi, [rel .data]
+
+movaps xmm1, [rsi + 16 * 0]
+mov rax, 0x100000003
+mov rdx, 0xffffffff0000000c
+
+db 0x66, 0x48, 0x0f, 0x3a, 0x61, 0x4e, 0x10, 0x00 ; pcmpestri xmm1, [rsi + 16 * 1], 0x00
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+mov rdi, rbx
+
+db 0x66, 0x48, 0x0f, 0x3a, 0x61, 0x4e, 0x10, 0x04 ; pcmpestri xmm1, [rsi + 16 * 1], 0x04
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+shl rbx, 32
+or rdi, rbx
+
+db 0x66, 0x48, 0x0f, 0x3a, 0x61, 0x4e, 0x10, 0x08 ; pcmpestri xmm1, [rsi + 16 * 1], 0x08
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+mov rbp, rbx
+
+db 0x66, 0x48, 0x0f, 0x3a, 0x61, 0x4e, 0x10, 0x0c ; pcmpestri xmm1, [rsi + 16 * 1], 0x0c
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+shl rbx, 32
+or rbp, rbx
+
+db 0x66, 0x48, 0x0f, 0x3a, 0x61, 0x4e, 0x10, 0x10 ; pcmpestri xmm1, [rsi + 16 * 1], 0x10
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+mov r8, rbx
+
+db 0x66, 0x48, 0x0f, 0x3a, 0x61, 0x4e, 0x10, 0x14 ; pcmpestri xmm1, [rsi + 16 * 1], 0x14
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+shl rbx, 32
+or r8, rbx
+
+db 0x66, 0x48, 0x0f, 0x3a, 0x61, 0x4e, 0x10, 0x18 ; pcmpestri xmm1, [rsi + 16 * 1], 0x18
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+mov r9, rbx
+
+db 0x66, 0x48, 0x0f, 0x3a, 0x61, 0x4e, 0x10, 0x1c ; pcmpestri xmm1, [rsi + 16 * 1], 0x1c
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+shl rbx, 32
+or r9, rbx
+
+db 0x66, 0x48, 0x0f, 0x3a, 0x61, 0x4e, 0x10, 0x20 ; pcmpestri xmm1, [rsi + 16 * 1], 0x20
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+mov r10, rbx
+
+db 0x66, 0x48, 0x0f, 0x3a, 0x61, 0x4e, 0x10, 0x24 ; pcmpestri xmm1, [rsi + 16 * 1], 0x24
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+shl rbx, 32
+or r10, rbx
+
+db 0x66, 0x48, 0x0f, 0x3a, 0x61, 0x4e, 0x10, 0x28 ; pcmpestri xmm1, [rsi + 16 * 1], 0x28
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+mov r11, rbx
+
+db 0x66, 0x48, 0x0f, 0x3a, 0x61, 0x4e, 0x10, 0x2c ; pcmpestri xmm1, [rsi + 16 * 1], 0x2c
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+shl rbx, 32
+or r11, rbx
+
+db 0x66, 0x48, 0x0f, 0x3a, 0x61, 0x4e, 0x10, 0x30 ; pcmpestri xmm1, [rsi + 16 * 1], 0x30
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+mov r12, rbx
+
+db 0x66, 0x48, 0x0f, 0x3a, 0x61, 0x4e, 0x10, 0x34 ; pcmpestri xmm1, [rsi + 16 * 1], 0x34
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+shl rbx, 32
+or r12, rbx
+
+db 0x66, 0x48, 0x0f, 0x3a, 0x61, 0x4e, 0x10, 0x38 ; pcmpestri xmm1, [rsi + 16 * 1], 0x38
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+mov r13, rbx
+
+db 0x66, 0x48, 0x0f, 0x3a, 0x61, 0x4e, 0x10, 0x3c ; pcmpestri xmm1, [rsi + 16 * 1], 0x3c
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+shl rbx, 32
+or r13, rbx
+
+db 0x66, 0x48, 0x0f, 0x3a, 0x61, 0x4e, 0x10, 0x50 ; pcmpestri xmm1, [rsi + 16 * 1], 0x50
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+mov r14, rbx
+
+db 0x66, 0x48, 0x0f, 0x3a, 0x61, 0x4e, 0x10, 0x64 ; pcmpestri xmm1, [rsi + 16 * 1], 0x64
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+shl rbx, 32
+or r14, rbx
+
+db 0x66, 0x48, 0x0f, 0x3a, 0x61, 0x4e, 0x10, 0x78 ; pcmpestri xmm1, [rsi + 16 * 1], 0x78
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+mov r15, rbx
+
+db 0x66, 0x48, 0x0f, 0x3a, 0x61, 0x4e, 0x10, 0x4c ; pcmpestri xmm1, [rsi + 16 * 1], 0x4c
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+shl rbx, 32
+or r15, rbx
+
+hlt
+
+align 16
+.data:
+db 0x61, 0x7a, 0x41, 0x5a, 0x00, 0x71, 0x77, 0x65, 0x72, 0x74, 0x79, 0x75, 0x69, 0x6f, 0x70, 0x00
+db 0x48, 0x69, 0x20, 0x61, 0x7a, 0x41, 0x5a, 0x2c, 0x20, 0x41, 0x5a, 0x20, 0x61, 0x7a, 0x21, 0x00
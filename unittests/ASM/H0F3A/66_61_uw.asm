@@ -0,0 +1,202 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "RDI": "0xc1000108c10000",
+    "RBP": "0xc1000100c10007",
+    "R8": "0x8c1000000c10004",
+    "R9": "0x8c1000008c10000",
+    "R10": "0xc1000108c10000",
+    "R11": "0xc1000100c10007",
+    "R12": "0x8c1000000c10004",
+    "R13": "0x8c1000008c10000",
+    "R14": "0xc1000200c10007",
+    "R15": "0xc1000108c10007"
+  }
+}
+%endif
+
+; pcmpestri with unsigned words, every aggregation and polarity
+; Each result is packed in to 32 bits as (RFLAGS & 0x8D5) << 16 | ecx, two per register
+
+lea rsi, [rel .data]
+
+movaps xmm1, [rsi + 16 * 0]
+mov rax, 0x3
+mov rdx, 0xfffffff9
+
+pcmpestri xmm1, [rsi + 16 * 1], 0x01
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+mov rdi, rbx
+
+pcmpestri xmm1, [rsi + 16 * 1], 0x05
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+shl rbx, 32
+or rdi, rbx
+
+pcmpestri xmm1, [rsi + 16 * 1], 0x09
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+mov rbp, rbx
+
+pcmpestri xmm1, [rsi + 16 * 1], 0x0d
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+shl rbx, 32
+or rbp, rbx
+
+pcmpestri xmm1, [rsi + 16 * 1], 0x11
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+mov r8, rbx
+
+pcmpestri xmm1, [rsi + 16 * 1], 0x15
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+shl rbx, 32
+or r8, rbx
+
+pcmpestri xmm1, [rsi + 16 * 1], 0x19
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+mov r9, rbx
+
+pcmpestri xmm1, [rsi + 16 * 1], 0x1d
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+shl rbx, 32
+or r9, rbx
+
+pcmpestri xmm1, [rsi + 16 * 1], 0x21
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+mov r10, rbx
+
+pcmpestri xmm1, [rsi + 16 * 1], 0x25
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+shl rbx, 32
+or r10, rbx
+
+pcmpestri xmm1, [rsi + 16 * 1], 0x29
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+mov r11, rbx
+
+pcmpestri xmm1, [rsi + 16 * 1], 0x2d
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+shl rbx, 32
+or r11, rbx
+
+pcmpestri xmm1, [rsi + 16 * 1], 0x31
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+mov r12, rbx
+
+pcmpestri xmm1, [rsi + 16 * 1], 0x35
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+shl rbx, 32
+or r12, rbx
+
+pcmpestri xmm1, [rsi + 16 * 1], 0x39
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+mov r13, rbx
+
+pcmpestri xmm1, [rsi + 16 * 1], 0x3d
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+shl rbx, 32
+or r13, rbx
+
+pcmpestri xmm1, [rsi + 16 * 1], 0x51
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+mov r14, rbx
+
+pcmpestri xmm1, [rsi + 16 * 1], 0x65
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+shl rbx, 32
+or r14, rbx
+
+pcmpestri xmm1, [rsi + 16 * 1], 0x79
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+mov r15, rbx
+
+pcmpestri xmm1, [rsi + 16 * 1], 0x4d
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+shl rbx, 32
+or r15, rbx
+
+hlt
+
+align 16
+.data:
+db 0x41, 0x00, 0x5a, 0x00, 0x61, 0x00, 0x34, 0x12, 0x00, 0x00, 0x55, 0x55, 0x66, 0x66, 0x77, 0x77
+db 0x61, 0x00, 0x41, 0x00, 0x5a, 0x00, 0x61, 0x00, 0x34, 0x12, 0x30, 0x00, 0x00, 0x00, 0x5a, 0x00
@@ -0,0 +1,221 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "RDI": "0xc0000000c00000",
+    "RBP": "0x8c1ffff00c18000",
+    "R8": "0x8c1ffff08c1ffff",
+    "R9": "0xc0000008c17fff",
+    "R10": "0xc0000000c00000",
+    "R11": "0x8c1ffff00c18000",
+    "R12": "0x8c17fff08c17fff",
+    "R13": "0xc1800008c1ffff",
+    "R14": "0xc0000008c10000",
+    "R15": "0x8c1000008c10000",
+    "XMM3": ["0xffffffffffffffff", "0xffffffffffffffff"],
+    "XMM4": ["0x0", "0x0"],
+    "XMM5": ["0xffffffffffffffff", "0xffffffffffffffff"],
+    "XMM6": ["0xffffffffffffffff", "0xffffffffffffffff"]
+  }
+}
+%endif
+
+; pcmpistrm with an empty LHS string
+; Each result is packed in to 32 bits as (RFLAGS & 0x8D5) << 16 | xmm0[31:0], two per register
+
+lea rsi, [rel .data]
+
+movaps xmm1, [rsi + 16 * 0]
+movaps xmm2, [rsi + 16 * 1]
+
+pcmpistrm xmm1, xmm2, 0x00
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+mov rdi, rbx
+
+pcmpistrm xmm1, xmm2, 0x04
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+shl rbx, 32
+or rdi, rbx
+
+pcmpistrm xmm1, xmm2, 0x08
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+mov rbp, rbx
+
+pcmpistrm xmm1, xmm2, 0x0c
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+shl rbx, 32
+or rbp, rbx
+
+pcmpistrm xmm1, xmm2, 0x10
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+mov r8, rbx
+
+pcmpistrm xmm1, xmm2, 0x14
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+shl rbx, 32
+or r8, rbx
+
+pcmpistrm xmm1, xmm2, 0x18
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+mov r9, rbx
+
+pcmpistrm xmm1, xmm2, 0x1c
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+shl rbx, 32
+or r9, rbx
+
+pcmpistrm xmm1, xmm2, 0x20
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+mov r10, rbx
+
+pcmpistrm xmm1, xmm2, 0x24
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+shl rbx, 32
+or r10, rbx
+
+pcmpistrm xmm1, xmm2, 0x28
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+mov r11, rbx
+
+pcmpistrm xmm1, xmm2, 0x2c
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+shl rbx, 32
+or r11, rbx
+
+pcmpistrm xmm1, xmm2, 0x30
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+mov r12, rbx
+
+pcmpistrm xmm1, xmm2, 0x34
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+shl rbx, 32
+or r12, rbx
+
+pcmpistrm xmm1, xmm2, 0x38
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+mov r13, rbx
+
+pcmpistrm xmm1, xmm2, 0x3c
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+shl rbx, 32
+or r13, rbx
+
+pcmpistrm xmm1, xmm2, 0x50
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movaps xmm3, xmm0
+mov r14, rbx
+
+pcmpistrm xmm1, xmm2, 0x64
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movaps xmm4, xmm0
+shl rbx, 32
+or r14, rbx
+
+pcmpistrm xmm1, xmm2, 0x78
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movaps xmm5, xmm0
+mov r15, rbx
+
+pcmpistrm xmm1, xmm2, 0x4c
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movaps xmm6, xmm0
+shl rbx, 32
+or r15, rbx
+
+hlt
+
+align 16
+.data:
+db 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+db 0x48, 0x69, 0x20, 0x61, 0x7a, 0x41, 0x5a, 0x2c, 0x20, 0x41, 0x5a, 0x20, 0x61, 0x7a, 0x21, 0x00
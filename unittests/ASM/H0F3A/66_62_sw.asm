@@ -0,0 +1,221 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "RDI": "0x8c1000f08c10007",
+    "RBP": "0xc0000008c100e7",
+    "R8": "0xc100f000c100f8",
+    "R9": "0x8c100ff00c10018",
+    "R10": "0x8c1000f08c10007",
+    "R11": "0xc0000008c100e7",
+    "R12": "0xc1001000c10018",
+    "R13": "0x8c1001f00c100f8",
+    "R14": "0x8c1000000c10000",
+    "R15": "0xc0000000c10000",
+    "XMM3": ["0xffff000000000000", "0xffffffffffffffff"],
+    "XMM4": ["0xffffffffffffffff", "0x0"],
+    "XMM5": ["0xffff000000000000", "0xffffffffffffffff"],
+    "XMM6": ["0x0", "0x0"]
+  }
+}
+%endif
+
+; pcmpistrm with signed words, every aggregation and polarity
+; Each result is packed in to 32 bits as (RFLAGS & 0x8D5) << 16 | xmm0[31:0], two per register
+
+lea rsi, [rel .data]
+
+movaps xmm1, [rsi + 16 * 0]
+movaps xmm2, [rsi + 16 * 1]
+
+pcmpistrm xmm1, xmm2, 0x03
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+mov rdi, rbx
+
+pcmpistrm xmm1, xmm2, 0x07
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+shl rbx, 32
+or rdi, rbx
+
+pcmpistrm xmm1, xmm2, 0x0b
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+mov rbp, rbx
+
+pcmpistrm xmm1, xmm2, 0x0f
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+shl rbx, 32
+or rbp, rbx
+
+pcmpistrm xmm1, xmm2, 0x13
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+mov r8, rbx
+
+pcmpistrm xmm1, xmm2, 0x17
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+shl rbx, 32
+or r8, rbx
+
+pcmpistrm xmm1, xmm2, 0x1b
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+mov r9, rbx
+
+pcmpistrm xmm1, xmm2, 0x1f
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+shl rbx, 32
+or r9, rbx
+
+pcmpistrm xmm1, xmm2, 0x23
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+mov r10, rbx
+
+pcmpistrm xmm1, xmm2, 0x27
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+shl rbx, 32
+or r10, rbx
+
+pcmpistrm xmm1, xmm2, 0x2b
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+mov r11, rbx
+
+pcmpistrm xmm1, xmm2, 0x2f
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+shl rbx, 32
+or r11, rbx
+
+pcmpistrm xmm1, xmm2, 0x33
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+mov r12, rbx
+
+pcmpistrm xmm1, xmm2, 0x37
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+shl rbx, 32
+or r12, rbx
+
+pcmpistrm xmm1, xmm2, 0x3b
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+mov r13, rbx
+
+pcmpistrm xmm1, xmm2, 0x3f
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+shl rbx, 32
+or r13, rbx
+
+pcmpistrm xmm1, xmm2, 0x53
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movaps xmm3, xmm0
+mov r14, rbx
+
+pcmpistrm xmm1, xmm2, 0x67
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movaps xmm4, xmm0
+shl rbx, 32
+or r14, rbx
+
+pcmpistrm xmm1, xmm2, 0x7b
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movaps xmm5, xmm0
+mov r15, rbx
+
+pcmpistrm xmm1, xmm2, 0x4f
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movaps xmm6, xmm0
+shl rbx, 32
+or r15, rbx
+
+hlt
+
+align 16
+.data:
+db 0x18, 0xfc, 0xe8, 0x03, 0x00, 0x80, 0xd0, 0x8a, 0x00, 0x00, 0x07, 0x00, 0x07, 0x00, 0x07, 0x00
+db 0x18, 0xfc, 0xe8, 0x03, 0x00, 0x80, 0xe7, 0x03, 0x17, 0xfc, 0x00, 0x00, 0xd0, 0x8a, 0x05, 0x00
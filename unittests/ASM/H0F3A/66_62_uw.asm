@@ -0,0 +1,221 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "RDI": "0x8c1001f08c1001f",
+    "RBP": "0xc1000200c100c0",
+    "R8": "0xc100e000c100e0",
+    "R9": "0x8c100fd08c1003f",
+    "R10": "0x8c1001f08c1001f",
+    "R11": "0xc1000200c100c0",
+    "R12": "0xc1002000c10020",
+    "R13": "0x8c1003d08c100ff",
+    "R14": "0x8c1000000c10000",
+    "R15": "0xc1000008c10000",
+    "XMM3": ["0x0", "0xffffffffffff0000"],
+    "XMM4": ["0xffffffffffffffff", "0xffff"],
+    "XMM5": ["0xffffffffffffffff", "0xffffffffffffffff"],
+    "XMM6": ["0xffff0000", "0x0"]
+  }
+}
+%endif
+
+; pcmpistrm with unsigned words, every aggregation and polarity
+; Each result is packed in to 32 bits as (RFLAGS & 0x8D5) << 16 | xmm0[31:0], two per register
+
+lea rsi, [rel .data]
+
+movaps xmm1, [rsi + 16 * 0]
+movaps xmm2, [rsi + 16 * 1]
+
+pcmpistrm xmm1, xmm2, 0x01
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+mov rdi, rbx
+
+pcmpistrm xmm1, xmm2, 0x05
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+shl rbx, 32
+or rdi, rbx
+
+pcmpistrm xmm1, xmm2, 0x09
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+mov rbp, rbx
+
+pcmpistrm xmm1, xmm2, 0x0d
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+shl rbx, 32
+or rbp, rbx
+
+pcmpistrm xmm1, xmm2, 0x11
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+mov r8, rbx
+
+pcmpistrm xmm1, xmm2, 0x15
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+shl rbx, 32
+or r8, rbx
+
+pcmpistrm xmm1, xmm2, 0x19
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+mov r9, rbx
+
+pcmpistrm xmm1, xmm2, 0x1d
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+shl rbx, 32
+or r9, rbx
+
+pcmpistrm xmm1, xmm2, 0x21
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+mov r10, rbx
+
+pcmpistrm xmm1, xmm2, 0x25
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+shl rbx, 32
+or r10, rbx
+
+pcmpistrm xmm1, xmm2, 0x29
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+mov r11, rbx
+
+pcmpistrm xmm1, xmm2, 0x2d
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+shl rbx, 32
+or r11, rbx
+
+pcmpistrm xmm1, xmm2, 0x31
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+mov r12, rbx
+
+pcmpistrm xmm1, xmm2, 0x35
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+shl rbx, 32
+or r12, rbx
+
+pcmpistrm xmm1, xmm2, 0x39
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+mov r13, rbx
+
+pcmpistrm xmm1, xmm2, 0x3d
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movd ecx, xmm0
+or ebx, ecx
+shl rbx, 32
+or r13, rbx
+
+pcmpistrm xmm1, xmm2, 0x51
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movaps xmm3, xmm0
+mov r14, rbx
+
+pcmpistrm xmm1, xmm2, 0x65
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movaps xmm4, xmm0
+shl rbx, 32
+or r14, rbx
+
+pcmpistrm xmm1, xmm2, 0x79
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movaps xmm5, xmm0
+mov r15, rbx
+
+pcmpistrm xmm1, xmm2, 0x4d
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+movaps xmm6, xmm0
+shl rbx, 32
+or r15, rbx
+
+hlt
+
+align 16
+.data:
+db 0x41, 0x00, 0x5a, 0x00, 0x61, 0x00, 0x34, 0x12, 0x00, 0x00, 0x55, 0x55, 0x66, 0x66, 0x77, 0x77
+db 0x61, 0x00, 0x41, 0x00, 0x5a, 0x00, 0x61, 0x00, 0x34, 0x12, 0x30, 0x00, 0x00, 0x00, 0x5a, 0x00
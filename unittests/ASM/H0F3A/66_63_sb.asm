@@ -0,0 +1,201 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "RDI": "0x8c1000000c10002",
+    "RBP": "0xc0001000c10002",
+    "R8": "0xc1000108c10000",
+    "R9": "0x8c1000008c10000",
+    "R10": "0x8c1000000c10002",
+    "R11": "0xc0001000c10002",
+    "R12": "0xc1000108c10000",
+    "R13": "0x8c1000008c10000",
+    "R14": "0x8c1000208c1000f",
+    "R15": "0xc0001008c1000f"
+  }
+}
+%endif
+
+; pcmpistri with signed bytes, every aggregation and polarity
+; Each result is packed in to 32 bits as (RFLAGS & 0x8D5) << 16 | ecx, two per register
+
+lea rsi, [rel .data]
+
+movaps xmm1, [rsi + 16 * 0]
+movaps xmm2, [rsi + 16 * 1]
+
+pcmpistri xmm1, xmm2, 0x02
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+mov rdi, rbx
+
+pcmpistri xmm1, xmm2, 0x06
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+shl rbx, 32
+or rdi, rbx
+
+pcmpistri xmm1, xmm2, 0x0a
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+mov rbp, rbx
+
+pcmpistri xmm1, xmm2, 0x0e
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+shl rbx, 32
+or rbp, rbx
+
+pcmpistri xmm1, xmm2, 0x12
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+mov r8, rbx
+
+pcmpistri xmm1, xmm2, 0x16
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+shl rbx, 32
+or r8, rbx
+
+pcmpistri xmm1, xmm2, 0x1a
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+mov r9, rbx
+
+pcmpistri xmm1, xmm2, 0x1e
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+shl rbx, 32
+or r9, rbx
+
+pcmpistri xmm1, xmm2, 0x22
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+mov r10, rbx
+
+pcmpistri xmm1, xmm2, 0x26
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+shl rbx, 32
+or r10, rbx
+
+pcmpistri xmm1, xmm2, 0x2a
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+mov r11, rbx
+
+pcmpistri xmm1, xmm2, 0x2e
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+shl rbx, 32
+or r11, rbx
+
+pcmpistri xmm1, xmm2, 0x32
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+mov r12, rbx
+
+pcmpistri xmm1, xmm2, 0x36
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+shl rbx, 32
+or r12, rbx
+
+pcmpistri xmm1, xmm2, 0x3a
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+mov r13, rbx
+
+pcmpistri xmm1, xmm2, 0x3e
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+shl rbx, 32
+or r13, rbx
+
+pcmpistri xmm1, xmm2, 0x52
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+mov r14, rbx
+
+pcmpistri xmm1, xmm2, 0x66
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+shl rbx, 32
+or r14, rbx
+
+pcmpistri xmm1, xmm2, 0x7a
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+mov r15, rbx
+
+pcmpistri xmm1, xmm2, 0x4e
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+shl rbx, 32
+or r15, rbx
+
+hlt
+
+align 16
+.data:
+db 0xf6, 0x0a, 0x80, 0x9c, 0x05, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a
+db 0xfb, 0x14, 0x80, 0x00, 0x05, 0x0a, 0x0b, 0xf5, 0x9c, 0x9b, 0x01, 0x02, 0xf6, 0x7f, 0x00, 0x03
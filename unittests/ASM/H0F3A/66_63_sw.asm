@@ -0,0 +1,201 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "RDI": "0x8c1000008c10000",
+    "RBP": "0xc0000808c10000",
+    "R8": "0xc1000400c10003",
+    "R9": "0x8c1000000c10003",
+    "R10": "0x8c1000008c10000",
+    "R11": "0xc0000808c10000",
+    "R12": "0xc1000400c10003",
+    "R13": "0x8c1000000c10003",
+    "R14": "0x8c1000300c10007",
+    "R15": "0xc0000800c10007"
+  }
+}
+%endif
+
+; pcmpistri with signed words, every aggregation and polarity
+; Each result is packed in to 32 bits as (RFLAGS & 0x8D5) << 16 | ecx, two per register
+
+lea rsi, [rel .data]
+
+movaps xmm1, [rsi + 16 * 0]
+movaps xmm2, [rsi + 16 * 1]
+
+pcmpistri xmm1, xmm2, 0x03
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+mov rdi, rbx
+
+pcmpistri xmm1, xmm2, 0x07
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+shl rbx, 32
+or rdi, rbx
+
+pcmpistri xmm1, xmm2, 0x0b
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+mov rbp, rbx
+
+pcmpistri xmm1, xmm2, 0x0f
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+shl rbx, 32
+or rbp, rbx
+
+pcmpistri xmm1, xmm2, 0x13
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+mov r8, rbx
+
+pcmpistri xmm1, xmm2, 0x17
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+shl rbx, 32
+or r8, rbx
+
+pcmpistri xmm1, xmm2, 0x1b
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+mov r9, rbx
+
+pcmpistri xmm1, xmm2, 0x1f
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+shl rbx, 32
+or r9, rbx
+
+pcmpistri xmm1, xmm2, 0x23
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+mov r10, rbx
+
+pcmpistri xmm1, xmm2, 0x27
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+shl rbx, 32
+or r10, rbx
+
+pcmpistri xmm1, xmm2, 0x2b
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+mov r11, rbx
+
+pcmpistri xmm1, xmm2, 0x2f
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+shl rbx, 32
+or r11, rbx
+
+pcmpistri xmm1, xmm2, 0x33
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+mov r12, rbx
+
+pcmpistri xmm1, xmm2, 0x37
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+shl rbx, 32
+or r12, rbx
+
+pcmpistri xmm1, xmm2, 0x3b
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+mov r13, rbx
+
+pcmpistri xmm1, xmm2, 0x3f
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+shl rbx, 32
+or r13, rbx
+
+pcmpistri xmm1, xmm2, 0x53
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+mov r14, rbx
+
+pcmpistri xmm1, xmm2, 0x67
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+shl rbx, 32
+or r14, rbx
+
+pcmpistri xmm1, xmm2, 0x7b
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+mov r15, rbx
+
+pcmpistri xmm1, xmm2, 0x4f
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+shl rbx, 32
+or r15, rbx
+
+hlt
+
+align 16
+.data:
+db 0x18, 0xfc, 0xe8, 0x03, 0x00, 0x80, 0xd0, 0x8a, 0x00, 0x00, 0x07, 0x00, 0x07, 0x00, 0x07, 0x00
+db 0x18, 0xfc, 0xe8, 0x03, 0x00, 0x80, 0xe7, 0x03, 0x17, 0xfc, 0x00, 0x00, 0xd0, 0x8a, 0x05, 0x00
@@ -0,0 +1,201 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "RDI": "0x8c1000008c10000",
+    "RBP": "0xc1000100c10006",
+    "R8": "0xc1000500c10005",
+    "R9": "0x8c1000008c10000",
+    "R10": "0x8c1000008c10000",
+    "R11": "0xc1000100c10006",
+    "R12": "0xc1000500c10005",
+    "R13": "0x8c1000008c10000",
+    "R14": "0x8c1000400c10007",
+    "R15": "0xc1000108c10007"
+  }
+}
+%endif
+
+; pcmpistri with unsigned words, every aggregation and polarity
+; Each result is packed in to 32 bits as (RFLAGS & 0x8D5) << 16 | ecx, two per register
+
+lea rsi, [rel .data]
+
+movaps xmm1, [rsi + 16 * 0]
+movaps xmm2, [rsi + 16 * 1]
+
+pcmpistri xmm1, xmm2, 0x01
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+mov rdi, rbx
+
+pcmpistri xmm1, xmm2, 0x05
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+shl rbx, 32
+or rdi, rbx
+
+pcmpistri xmm1, xmm2, 0x09
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+mov rbp, rbx
+
+pcmpistri xmm1, xmm2, 0x0d
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+shl rbx, 32
+or rbp, rbx
+
+pcmpistri xmm1, xmm2, 0x11
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+mov r8, rbx
+
+pcmpistri xmm1, xmm2, 0x15
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+shl rbx, 32
+or r8, rbx
+
+pcmpistri xmm1, xmm2, 0x19
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+mov r9, rbx
+
+pcmpistri xmm1, xmm2, 0x1d
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+shl rbx, 32
+or r9, rbx
+
+pcmpistri xmm1, xmm2, 0x21
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+mov r10, rbx
+
+pcmpistri xmm1, xmm2, 0x25
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+shl rbx, 32
+or r10, rbx
+
+pcmpistri xmm1, xmm2, 0x29
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+mov r11, rbx
+
+pcmpistri xmm1, xmm2, 0x2d
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+shl rbx, 32
+or r11, rbx
+
+pcmpistri xmm1, xmm2, 0x31
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+mov r12, rbx
+
+pcmpistri xmm1, xmm2, 0x35
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+shl rbx, 32
+or r12, rbx
+
+pcmpistri xmm1, xmm2, 0x39
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+mov r13, rbx
+
+pcmpistri xmm1, xmm2, 0x3d
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+shl rbx, 32
+or r13, rbx
+
+pcmpistri xmm1, xmm2, 0x51
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+mov r14, rbx
+
+pcmpistri xmm1, xmm2, 0x65
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+shl rbx, 32
+or r14, rbx
+
+pcmpistri xmm1, xmm2, 0x79
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+mov r15, rbx
+
+pcmpistri xmm1, xmm2, 0x4d
+pushfq
+pop rbx
+and ebx, 0x8d5
+shl ebx, 16
+or ebx, ecx
+shl rbx, 32
+or r15, rbx
+
+hlt
+
+align 16
+.data:
+db 0x41, 0x00, 0x5a, 0x00, 0x61, 0x00, 0x34, 0x12, 0x00, 0x00, 0x55, 0x55, 0x66, 0x66, 0x77, 0x77
+db 0x61, 0x00, 0x41, 0x00, 0x5a, 0x00, 0x61, 0x00, 0x34, 0x12, 0x30, 0x00, 0x00, 0x00, 0x5a, 0x00
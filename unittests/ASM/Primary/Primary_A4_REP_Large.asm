@@ -0,0 +1,37 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "RAX": "0x0102030405065508",
+    "RBX": "0x6602030405060708",
+    "RCX": "0x0",
+    "RSI": "0xE0002710",
+    "RDI": "0xE0006710",
+    "R8": "0x0"
+  },
+  "MemoryRegions": {
+    "0x100000000": "4096"
+  }
+}
+%endif
+
+; Copies span multiple chunks of the bulk copy
+mov rdx, 0xe0000000
+
+cld
+mov rdi, rdx
+mov rax, 0x0102030405060708
+mov rcx, 1250
+rep stosq
+
+mov byte [rdx + 4097], 0x55
+mov byte [rdx + 9999], 0x66
+
+mov rsi, rdx
+lea rdi, [rdx + 0x4000]
+mov rcx, 10000
+rep movsb ; rdi <- rsi
+
+mov rax, [rdx + 0x4000 + 4096]
+mov rbx, [rdx + 0x4000 + 9992]
+mov r8, [rdx + 0x4000 + 10000]
+hlt
@@ -0,0 +1,33 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "RAX": "0x9700",
+    "RCX": "0x7CF",
+    "RSI": "0xE0001771",
+    "RDI": "0xE0005771"
+  },
+  "MemoryRegions": {
+    "0x100000000": "4096"
+  }
+}
+%endif
+
+; Mismatch past the first chunk of the bulk compare
+mov rdx, 0xe0000000
+
+cld
+mov rdi, rdx
+mov rax, 0
+mov rcx, 0x8000
+rep stosb
+
+mov byte [rdx + 0x4000 + 6000], 1
+
+mov rsi, rdx
+lea rdi, [rdx + 0x4000]
+mov rcx, 8000
+repe cmpsb
+
+mov rax, 0
+lahf
+hlt
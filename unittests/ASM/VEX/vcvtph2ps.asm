@@ -0,0 +1,32 @@
+%ifdef CONFIG
+{
+  "HostFeatures": ["AVX", "F16C"],
+  "RegData": {
+    "XMM1": ["0xC00000003F800000", "0x477FE0003EAAA000", "0x0000000000000000", "0x0000000000000000"],
+    "XMM2": ["0xC00000003F800000", "0x477FE0003EAAA000", "0xB87FC00033800000", "0xFF8000007F800000"],
+    "XMM3": ["0xB87FC00033800000", "0xFF8000007F800000", "0x0000000000000000", "0x0000000000000000"],
+    "XMM4": ["0x7FC020007FC02000", "0x8000000000000000", "0x42C8000040490000", "0x3F7FE000BF000000"]
+  },
+  "MemoryRegions": {
+    "0x100000000": "4096"
+  }
+}
+%endif
+
+lea rdx, [rel .data]
+
+vmovapd ymm0, [rdx]
+
+vcvtph2ps xmm1, xmm0
+vcvtph2ps ymm2, xmm0
+vcvtph2ps xmm3, [rdx + 8]
+vcvtph2ps ymm4, [rdx + 16]
+
+hlt
+
+align 32
+.data:
+dq 0x7BFF3555C0003C00 ; 1.0, -2.0, 0.333, 65504
+dq 0xFC007C0083FF0001 ; denormals
+dq 0x800000007C017E01 ; inf, -inf, qnan, snan
+dq 0x3BFFB80056404248 ; 0, -0, 3.14, 100
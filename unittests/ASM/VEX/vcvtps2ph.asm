@@ -0,0 +1,68 @@
+%ifdef CONFIG
+{
+  "HostFeatures": ["AVX", "F16C"],
+  "RegData": {
+    "XMM2": ["0x3C023C00BC013C01", "0x0000000000000000", "0x0000000000000000", "0x0000000000000000"],
+    "XMM3": ["0x3C013C00BC013C00", "0x0000000000000000", "0x0000000000000000", "0x0000000000000000"],
+    "XMM4": ["0x3C023C01BC003C01", "0x0000000000000000", "0x0000000000000000", "0x0000000000000000"],
+    "XMM5": ["0x3C013C00BC003C00", "0x0000000000000000", "0x0000000000000000", "0x0000000000000000"],
+    "XMM6": ["0x3C023C00BC013C01", "0x00117C00FC007C00", "0x0000000000000000", "0x0000000000000000"],
+    "XMM7": ["0x7E007C0000008011", "0x7BFF000180002E66", "0x0000000000000000", "0x0000000000000000"],
+    "XMM8": ["0x3C013C00BC013C00", "0x0000000000000000", "0x0000000000000000", "0x0000000000000000"],
+    "XMM9": ["0x7E007C0000008011", "0x7BFF000180002E66", "0x0000000000000000", "0x0000000000000000"],
+    "XMM10": ["0x3C023C00BC013C01", "0x0000000000000000", "0x0000000000000000", "0x0000000000000000"],
+    "XMM11": ["0x3C023C00BC013C01", "0x7E007C0000008011", "0x7BFF000180002E66", "0xFFFFFFFFFFFFFFFF"]
+  },
+  "MemoryRegions": {
+    "0x100000000": "4096"
+  }
+}
+%endif
+
+lea rdx, [rel .data]
+
+vmovapd ymm0, [rdx + 32 * 0]
+vmovapd ymm1, [rdx + 32 * 1]
+
+; Immediate rounding modes
+vcvtps2ph xmm2, xmm0, 0
+vcvtps2ph xmm3, xmm0, 1
+vcvtps2ph xmm4, xmm0, 2
+vcvtps2ph xmm5, xmm0, 3
+vcvtps2ph xmm6, ymm0, 0
+vcvtps2ph xmm7, ymm1, 1
+
+; MXCSR rounding mode, round down
+sub rsp, 4
+stmxcsr [rsp]
+mov eax, [rsp]
+or dword [rsp], 0x2000
+ldmxcsr [rsp]
+vcvtps2ph xmm8, xmm0, 4
+vcvtps2ph xmm9, ymm1, 4
+; The immediate still wins over MXCSR
+vcvtps2ph xmm10, xmm0, 0
+mov [rsp], eax
+ldmxcsr [rsp]
+add rsp, 4
+
+; Memory destination only writes the converted elements
+vpcmpeqb ymm11, ymm11, ymm11
+vmovapd [rdx + 32 * 2], ymm11
+vcvtps2ph [rdx + 32 * 2], xmm0, 0
+vcvtps2ph [rdx + 32 * 2 + 8], ymm1, 0
+vmovapd ymm11, [rdx + 32 * 2]
+
+hlt
+
+align 32
+.data:
+dq 0xBF8014003F801400 ; 1 + 2^-11 + 2^-13, -(...)
+dq 0x3F8030003F801000 ; 1 + 2^-11, 1 + 3 * 2^-11
+dq 0xC788B8004788B800 ; 70000, -70000
+dq 0x358637BD477FF000 ; 65520, 1e-6
+dq 0x3089705FB58637BD ; -1e-6, 1e-9
+dq 0x7FC000007F800000 ; inf, nan
+dq 0x800000003DCCCCCD ; 0.1, -0
+dq 0x477FE00033A00000 ; 2^-24 + 2^-26, 65504
+dq 0x0000000000000000 ; Output
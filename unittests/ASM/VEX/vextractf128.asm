@@ -0,0 +1,46 @@
+%ifdef CONFIG
+{
+  "HostFeatures": ["AVX"],
+  "RegData": {
+    "XMM1":  ["0x80017F02FF030004", "0x0123456789ABCDEF", "0x0000000000000000", "0x0000000000000000"],
+    "XMM2":  ["0xFEDCBA9876543210", "0x7FFF80000001FFFF", "0x0000000000000000", "0x0000000000000000"],
+    "XMM3":  ["0xFEDCBA9876543210", "0x7FFF80000001FFFF", "0x0000000000000000", "0x0000000000000000"],
+    "XMM5":  ["0xFEDCBA9876543210", "0x7FFF80000001FFFF", "0x98C0A2620F3059FE", "0x8D4C309A6C066453"]
+  },
+  "MemoryRegions": {
+    "0x100000000": "4096"
+  }
+}
+%endif
+
+lea rdx, [rel .data]
+
+vmovapd ymm0, [rdx]
+
+vextractf128 xmm1, ymm0, 0
+vextractf128 xmm2, ymm0, 1
+
+; Upper lane of the destination is zeroed
+vmovapd ymm3, ymm0
+vextractf128 xmm3, ymm0, 1
+
+; Memory destination only writes 128 bits
+mov rax, 0xe0000000
+vmovapd ymm4, [rdx + 32 * 1]
+vmovdqu [rax], ymm4
+vextractf128 [rax], ymm0, 1
+vmovdqu ymm5, [rax]
+
+hlt
+
+align 32
+.data:
+dq 0x80017F02FF030004
+dq 0x0123456789ABCDEF
+dq 0xFEDCBA9876543210
+dq 0x7FFF80000001FFFF
+
+dq 0x7007B09267823CDC
+dq 0x339BEF28D149A48F
+dq 0x98C0A2620F3059FE
+dq 0x8D4C309A6C066453
@@ -0,0 +1,75 @@
+%ifdef CONFIG
+{
+  "HostFeatures": ["AVX", "FMA"],
+  "RegData": {
+    "XMM3": ["0x41300000B3800000", "0x3F0000003F000000", "0x0000000000000000", "0x0000000000000000"],
+    "XMM4": ["0x41300000B3800000", "0x3F0000003F000000", "0x0000000000000000", "0x0000000000000000"],
+    "XMM5": ["0x41300000B3800000", "0x3F0000003F000000", "0xC130000032800000", "0x40A00000AB800000"],
+    "XMM6": ["0x41300000B3800000", "0x3F0000003F000000", "0xC130000032800000", "0x40A00000AB800000"],
+    "XMM7": ["0x41300000B3800000", "0x3F0000003F000000", "0x0000000000000000", "0x0000000000000000"],
+    "XMM8": ["0x41300000B3800000", "0x3F0000003F000000", "0x0000000000000000", "0x0000000000000000"],
+    "XMM9": ["0x41300000B3800000", "0x3F0000003F000000", "0xC130000032800000", "0x40A00000AB800000"],
+    "XMM10": ["0x41300000B3800000", "0x3F0000003F000000", "0xC130000032800000", "0x40A00000AB800000"],
+    "XMM11": ["0x41300000B3800000", "0x3F0000003F000000", "0x0000000000000000", "0x0000000000000000"],
+    "XMM12": ["0x41300000B3800000", "0x3F0000003F000000", "0x0000000000000000", "0x0000000000000000"],
+    "XMM13": ["0x41300000B3800000", "0x3F0000003F000000", "0xC130000032800000", "0x40A00000AB800000"],
+    "XMM14": ["0x41300000B3800000", "0x3F0000003F000000", "0xC130000032800000", "0x40A00000AB800000"]
+  },
+  "MemoryRegions": {
+    "0x100000000": "4096"
+  }
+}
+%endif
+
+lea rdx, [rel .data]
+
+vmovapd ymm0, [rdx + 32 * 0]
+vmovapd ymm1, [rdx + 32 * 1]
+vmovapd ymm2, [rdx + 32 * 2]
+
+; 132 form
+vmovapd ymm3, ymm0
+vfmadd132ps xmm3, xmm2, xmm1
+vmovapd ymm4, ymm0
+vfmadd132ps xmm4, xmm2, [rdx + 32 * 1]
+vmovapd ymm5, ymm0
+vfmadd132ps ymm5, ymm2, ymm1
+vmovapd ymm6, ymm0
+vfmadd132ps ymm6, ymm2, [rdx + 32 * 1]
+
+; 213 form
+vmovapd ymm7, ymm1
+vfmadd213ps xmm7, xmm0, xmm2
+vmovapd ymm8, ymm1
+vfmadd213ps xmm8, xmm0, [rdx + 32 * 2]
+vmovapd ymm9, ymm1
+vfmadd213ps ymm9, ymm0, ymm2
+vmovapd ymm10, ymm1
+vfmadd213ps ymm10, ymm0, [rdx + 32 * 2]
+
+; 231 form
+vmovapd ymm11, ymm2
+vfmadd231ps xmm11, xmm0, xmm1
+vmovapd ymm12, ymm2
+vfmadd231ps xmm12, xmm0, [rdx + 32 * 1]
+vmovapd ymm13, ymm2
+vfmadd231ps ymm13, ymm0, ymm1
+vmovapd ymm14, ymm2
+vfmadd231ps ymm14, ymm0, [rdx + 32 * 1]
+
+hlt
+
+align 32
+.data:
+dq 0x402000003F800800 ; A
+dq 0x501502F9C0400000
+dq 0xC0E800003DCCCCCD
+dq 0x404000003F800008
+dq 0x408000003F7FF000 ; B
+dq 0x2EDBE6FF3F000000
+dq 0x4000000041200000
+dq 0xBF8000003F7FFFF0
+dq 0x3F800000BF800000 ; C
+dq 0xBF00000040000000
+dq 0x40600000BF800000
+dq 0x41000000BF800000
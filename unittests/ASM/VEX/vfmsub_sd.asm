@@ -0,0 +1,57 @@
+%ifdef CONFIG
+{
+  "HostFeatures": ["AVX", "FMA"],
+  "RegData": {
+    "XMM3": ["0x4000000000000000", "0x4004000000000000", "0x0000000000000000", "0x0000000000000000"],
+    "XMM4": ["0x4000000000000000", "0x4004000000000000", "0x0000000000000000", "0x0000000000000000"],
+    "XMM5": ["0x4000000000000000", "0x4010000000000000", "0x0000000000000000", "0x0000000000000000"],
+    "XMM6": ["0x4000000000000000", "0x4010000000000000", "0x0000000000000000", "0x0000000000000000"],
+    "XMM7": ["0x4000000000000000", "0x3FF0000000000000", "0x0000000000000000", "0x0000000000000000"],
+    "XMM8": ["0x4000000000000000", "0x3FF0000000000000", "0x0000000000000000", "0x0000000000000000"]
+  },
+  "MemoryRegions": {
+    "0x100000000": "4096"
+  }
+}
+%endif
+
+lea rdx, [rel .data]
+
+vmovapd ymm0, [rdx + 32 * 0]
+vmovapd ymm1, [rdx + 32 * 1]
+vmovapd ymm2, [rdx + 32 * 2]
+
+; 132 form
+vmovapd ymm3, ymm0
+vfmsub132sd xmm3, xmm2, xmm1
+vmovapd ymm4, ymm0
+vfmsub132sd xmm4, xmm2, [rdx + 32 * 1]
+
+; 213 form
+vmovapd ymm5, ymm1
+vfmsub213sd xmm5, xmm0, xmm2
+vmovapd ymm6, ymm1
+vfmsub213sd xmm6, xmm0, [rdx + 32 * 2]
+
+; 231 form
+vmovapd ymm7, ymm2
+vfmsub231sd xmm7, xmm0, xmm1
+vmovapd ymm8, ymm2
+vfmsub231sd xmm8, xmm0, [rdx + 32 * 1]
+
+hlt
+
+align 32
+.data:
+dq 0x3FF0000000400000 ; A
+dq 0x4004000000000000
+dq 0xC008000000000000
+dq 0x54B249AD2594C37D
+dq 0x3FEFFFFFFF800000 ; B
+dq 0x4010000000000000
+dq 0x3FE0000000000000
+dq 0x2B2BFF2EE48E0530
+dq 0xBFF0000000000000 ; C
+dq 0x3FF0000000000000
+dq 0x4000000000000000
+dq 0xBFE0000000000000
@@ -0,0 +1,75 @@
+%ifdef CONFIG
+{
+  "HostFeatures": ["AVX", "FMA"],
+  "RegData": {
+    "XMM3": ["0xBC30000000000000", "0x4022000000000000", "0x0000000000000000", "0x0000000000000000"],
+    "XMM4": ["0xBC30000000000000", "0x4022000000000000", "0x0000000000000000", "0x0000000000000000"],
+    "XMM5": ["0xBC30000000000000", "0x4022000000000000", "0x3FE0000000000000", "0x3FF8000000000000"],
+    "XMM6": ["0xBC30000000000000", "0x4022000000000000", "0x3FE0000000000000", "0x3FF8000000000000"],
+    "XMM7": ["0xBC30000000000000", "0x4022000000000000", "0x0000000000000000", "0x0000000000000000"],
+    "XMM8": ["0xBC30000000000000", "0x4022000000000000", "0x0000000000000000", "0x0000000000000000"],
+    "XMM9": ["0xBC30000000000000", "0x4022000000000000", "0x3FE0000000000000", "0x3FF8000000000000"],
+    "XMM10": ["0xBC30000000000000", "0x4022000000000000", "0x3FE0000000000000", "0x3FF8000000000000"],
+    "XMM11": ["0xBC30000000000000", "0x4022000000000000", "0x0000000000000000", "0x0000000000000000"],
+    "XMM12": ["0xBC30000000000000", "0x4022000000000000", "0x0000000000000000", "0x0000000000000000"],
+    "XMM13": ["0xBC30000000000000", "0x4022000000000000", "0x3FE0000000000000", "0x3FF8000000000000"],
+    "XMM14": ["0xBC30000000000000", "0x4022000000000000", "0x3FE0000000000000", "0x3FF8000000000000"]
+  },
+  "MemoryRegions": {
+    "0x100000000": "4096"
+  }
+}
+%endif
+
+lea rdx, [rel .data]
+
+vmovapd ymm0, [rdx + 32 * 0]
+vmovapd ymm1, [rdx + 32 * 1]
+vmovapd ymm2, [rdx + 32 * 2]
+
+; 132 form
+vmovapd ymm3, ymm0
+vfmsubadd132pd xmm3, xmm2, xmm1
+vmovapd ymm4, ymm0
+vfmsubadd132pd xmm4, xmm2, [rdx + 32 * 1]
+vmovapd ymm5, ymm0
+vfmsubadd132pd ymm5, ymm2, ymm1
+vmovapd ymm6, ymm0
+vfmsubadd132pd ymm6, ymm2, [rdx + 32 * 1]
+
+; 213 form
+vmovapd ymm7, ymm1
+vfmsubadd213pd xmm7, xmm0, xmm2
+vmovapd ymm8, ymm1
+vfmsubadd213pd xmm8, xmm0, [rdx + 32 * 2]
+vmovapd ymm9, ymm1
+vfmsubadd213pd ymm9, ymm0, ymm2
+vmovapd ymm10, ymm1
+vfmsubadd213pd ymm10, ymm0, [rdx + 32 * 2]
+
+; 231 form
+vmovapd ymm11, ymm2
+vfmsubadd231pd xmm11, xmm0, xmm1
+vmovapd ymm12, ymm2
+vfmsubadd231pd xmm12, xmm0, [rdx + 32 * 1]
+vmovapd ymm13, ymm2
+vfmsubadd231pd ymm13, ymm0, ymm1
+vmovapd ymm14, ymm2
+vfmsubadd231pd ymm14, ymm0, [rdx + 32 * 1]
+
+hlt
+
+align 32
+.data:
+dq 0x3FF0000000400000 ; A
+dq 0x4004000000000000
+dq 0xC008000000000000
+dq 0x54B249AD2594C37D
+dq 0x3FEFFFFFFF800000 ; B
+dq 0x4010000000000000
+dq 0x3FE0000000000000
+dq 0x2B2BFF2EE48E0530
+dq 0xBFF0000000000000 ; C
+dq 0x3FF0000000000000
+dq 0x4000000000000000
+dq 0xBFE0000000000000
@@ -0,0 +1,57 @@
+%ifdef CONFIG
+{
+  "HostFeatures": ["AVX", "FMA"],
+  "RegData": {
+    "XMM3": ["0x4020000033800000", "0x501502F9C0400000", "0x0000000000000000", "0x0000000000000000"],
+    "XMM4": ["0x4020000033800000", "0x501502F9C0400000", "0x0000000000000000", "0x0000000000000000"],
+    "XMM5": ["0x4080000033800000", "0x2EDBE6FF3F000000", "0x0000000000000000", "0x0000000000000000"],
+    "XMM6": ["0x4080000033800000", "0x2EDBE6FF3F000000", "0x0000000000000000", "0x0000000000000000"],
+    "XMM7": ["0x3F80000033800000", "0xBF00000040000000", "0x0000000000000000", "0x0000000000000000"],
+    "XMM8": ["0x3F80000033800000", "0xBF00000040000000", "0x0000000000000000", "0x0000000000000000"]
+  },
+  "MemoryRegions": {
+    "0x100000000": "4096"
+  }
+}
+%endif
+
+lea rdx, [rel .data]
+
+vmovapd ymm0, [rdx + 32 * 0]
+vmovapd ymm1, [rdx + 32 * 1]
+vmovapd ymm2, [rdx + 32 * 2]
+
+; 132 form
+vmovapd ymm3, ymm0
+vfnmsub132ss xmm3, xmm2, xmm1
+vmovapd ymm4, ymm0
+vfnmsub132ss xmm4, xmm2, [rdx + 32 * 1]
+
+; 213 form
+vmovapd ymm5, ymm1
+vfnmsub213ss xmm5, xmm0, xmm2
+vmovapd ymm6, ymm1
+vfnmsub213ss xmm6, xmm0, [rdx + 32 * 2]
+
+; 231 form
+vmovapd ymm7, ymm2
+vfnmsub231ss xmm7, xmm0, xmm1
+vmovapd ymm8, ymm2
+vfnmsub231ss xmm8, xmm0, [rdx + 32 * 1]
+
+hlt
+
+align 32
+.data:
+dq 0x402000003F800800 ; A
+dq 0x501502F9C0400000
+dq 0xC0E800003DCCCCCD
+dq 0x404000003F800008
+dq 0x408000003F7FF000 ; B
+dq 0x2EDBE6FF3F000000
+dq 0x4000000041200000
+dq 0xBF8000003F7FFFF0
+dq 0x3F800000BF800000 ; C
+dq 0xBF00000040000000
+dq 0x40600000BF800000
+dq 0x41000000BF800000
@@ -0,0 +1,57 @@
+%ifdef CONFIG
+{
+  "HostFeatures": ["AVX"],
+  "RegData": {
+    "XMM2":  ["0x80017F02FF030004", "0x0123456789ABCDEF", "0xFEDCBA9876543210", "0x7FFF80000001FFFF"],
+    "XMM3":  ["0x80017F02FF030004", "0x0123456789ABCDEF", "0xFEDCBA9876543210", "0x7FFF80000001FFFF"],
+    "XMM4":  ["0x80017F02FF030004", "0x0123456789ABCDEF", "0x0000000000000000", "0x0000000000000000"],
+    "XMM5":  ["0x80017F02807F01FE", "0x012345673333CCCC", "0x8000000076543210", "0x0F1E2D3C0001FFFF"],
+    "XMM6":  ["0x80017F02807F01FE", "0x012345673333CCCC", "0x8000000076543210", "0x0F1E2D3C0001FFFF"],
+    "XMM7":  ["0x80017F02807F01FE", "0x012345673333CCCC", "0x0000000000000000", "0x0000000000000000"],
+    "XMM8":  ["0x00FFFF00807F01FE", "0x5555AAAA3333CCCC", "0x800000007FFFFFFF", "0x0F1E2D3C4B5A6978"],
+    "XMM9":  ["0x00FFFF00807F01FE", "0x5555AAAA3333CCCC", "0x800000007FFFFFFF", "0x0F1E2D3C4B5A6978"],
+    "XMM10": ["0x00FFFF00807F01FE", "0x5555AAAA3333CCCC", "0x0000000000000000", "0x0000000000000000"],
+    "XMM11": ["0x80017F02FF030004", "0x5555AAAA3333CCCC", "0x800000007FFFFFFF", "0x7FFF80000001FFFF"],
+    "XMM12": ["0x80017F02FF030004", "0x5555AAAA3333CCCC", "0x800000007FFFFFFF", "0x7FFF80000001FFFF"],
+    "XMM13": ["0x80017F02FF030004", "0x5555AAAA3333CCCC", "0x0000000000000000", "0x0000000000000000"]
+  },
+  "MemoryRegions": {
+    "0x100000000": "4096"
+  }
+}
+%endif
+
+lea rdx, [rel .data]
+
+vmovapd ymm0, [rdx + 32 * 0]
+vmovapd ymm1, [rdx + 32 * 1]
+
+vpblendd ymm2, ymm0, ymm1, 0x00
+vpblendd ymm3, ymm0, [rdx + 32 * 1], 0x00
+vpblendd xmm4, xmm0, xmm1, 0x00
+
+vpblendd ymm5, ymm0, ymm1, 0xA5
+vpblendd ymm6, ymm0, [rdx + 32 * 1], 0xA5
+vpblendd xmm7, xmm0, xmm1, 0xA5
+
+vpblendd ymm8, ymm0, ymm1, 0xFF
+vpblendd ymm9, ymm0, [rdx + 32 * 1], 0xFF
+vpblendd xmm10, xmm0, xmm1, 0xFF
+
+vpblendd ymm11, ymm0, ymm1, 0x3C
+vpblendd ymm12, ymm0, [rdx + 32 * 1], 0x3C
+vpblendd xmm13, xmm0, xmm1, 0x3C
+
+hlt
+
+align 32
+.data:
+dq 0x80017F02FF030004
+dq 0x0123456789ABCDEF
+dq 0xFEDCBA9876543210
+dq 0x7FFF80000001FFFF
+
+dq 0x00FFFF00807F01FE
+dq 0x5555AAAA3333CCCC
+dq 0x800000007FFFFFFF
+dq 0x0F1E2D3C4B5A6978
@@ -0,0 +1,39 @@
+%ifdef CONFIG
+{
+  "HostFeatures": ["AVX"],
+  "RegData": {
+    "XMM2":  ["0x012345677FFF8000", "0xFF030004FEDCBA98", "0x80017F0289ABCDEF", "0x7654321080017F02"],
+    "XMM3":  ["0x012345677FFF8000", "0xFF030004FEDCBA98", "0x80017F0289ABCDEF", "0x7654321080017F02"],
+    "XMM4":  ["0x012345677FFF8000", "0xFF030004FEDCBA98", "0x80017F0289ABCDEF", "0x7654321080017F02"]
+  },
+  "MemoryRegions": {
+    "0x100000000": "4096"
+  }
+}
+%endif
+
+lea rdx, [rel .data]
+
+vmovapd ymm0, [rdx + 32 * 0]
+vmovapd ymm1, [rdx + 32 * 1]
+
+vpermps ymm2, ymm1, ymm0
+vpermps ymm3, ymm1, [rdx]
+
+; Permute with itself as the index
+vmovapd ymm4, ymm1
+vpermps ymm4, ymm4, ymm0
+
+hlt
+
+align 32
+.data:
+dq 0x80017F02FF030004
+dq 0x0123456789ABCDEF
+dq 0xFEDCBA9876543210
+dq 0x7FFF80000001FFFF
+
+dq 0x0000000300000007
+dq 0x0000000000000005
+dq 0xFFFFFFF900000002
+dq 0x0000000480000001
@@ -0,0 +1,79 @@
+%ifdef CONFIG
+{
+  "HostFeatures": ["AVX"],
+  "RegData": {
+    "XMM0":  ["0xB4000004EEEEEEEE", "0xB7000007AB000000", "0x0000000000000000", "0x0000000000000000"],
+    "XMM1":  ["0x0000000000000000", "0x0000000000000000", "0x0000000000000000", "0x0000000000000000"],
+    "XMM2":  ["0xB4000004EEEEEEEE", "0x0000000000000000", "0x0000000000000000", "0x0000000000000000"],
+    "XMM3":  ["0x0000000000000000", "0x0000000000000000", "0x0000000000000000", "0x0000000000000000"],
+    "XMM5":  ["0xB5000005EEEEEEEE", "0xB8000008AC000000", "0x0000000000000000", "0x0000000000000000"],
+    "XMM6":  ["0x0000000000000000", "0x0000000000000000", "0x0000000000000000", "0x0000000000000000"],
+    "XMM7":  ["0xB3000003EEEEEEEE", "0x0000000000000000", "0x0000000000000000", "0x0000000000000000"],
+    "XMM8":  ["0x0000000000000000", "0x0000000000000000", "0x0000000000000000", "0x0000000000000000"]
+  },
+  "MemoryRegions": {
+    "0x100000000": "4096"
+  }
+}
+%endif
+
+lea rdx, [rel .data]
+
+; rbx points at the middle of the table
+lea rbx, [rdx + 64]
+
+; Index 4 in the SIB byte, which is the no-index encoding for GPRs
+vmovapd ymm4, [rdx + 32 * 4]
+vmovapd ymm12, [rdx + 32 * 4]
+
+vmovapd ymm0, [rdx + 32 * 6]
+vmovapd ymm1, [rdx + 32 * 5]
+vpgatherqd xmm0, [rbx + ymm4 * 4], xmm1
+
+vmovapd ymm2, [rdx + 32 * 6]
+vmovapd ymm3, [rdx + 32 * 5]
+vpgatherqd xmm2, [rbx + xmm4 * 4], xmm3
+
+vmovapd ymm5, [rdx + 32 * 6]
+vmovapd ymm6, [rdx + 32 * 5]
+vpgatherqd xmm5, [rbx + ymm12 * 4 + 8], xmm6
+
+vmovapd ymm7, [rdx + 32 * 6]
+vmovapd ymm8, [rdx + 32 * 5]
+vpgatherqd xmm7, [rbx + xmm12 * 4 - 8], xmm8
+
+hlt
+
+align 32
+.data:
+dq 0xA0000000B0000000 ; Table
+dq 0xA1000000B1000001
+dq 0xA2000000B2000002
+dq 0xA3000000B3000003
+dq 0xA4000000B4000004
+dq 0xA5000000B5000005
+dq 0xA6000000B6000006
+dq 0xA7000000B7000007
+dq 0xA8000000B8000008
+dq 0xA9000000B9000009
+dq 0xAA000000BA00000A
+dq 0xAB000000BB00000B
+dq 0xAC000000BC00000C
+dq 0xAD000000BD00000D
+dq 0xAE000000BE00000E
+dq 0xAF000000BF00000F
+
+dq 0x0000000000000003 ; Index
+dq 0xFFFFFFFFFFFFFFF8
+dq 0x0000000000000007
+dq 0xFFFFFFFFFFFFFFFE
+
+dq 0x8000000000000000 ; Mask
+dq 0xFFFFFFFF80000000
+dq 0x000000007FFFFFFF
+dq 0x8000000180000001
+
+dq 0xEEEEEEEEEEEEEEEE ; Sentinel
+dq 0xEEEEEEEEEEEEEEEE
+dq 0xEEEEEEEEEEEEEEEE
+dq 0xEEEEEEEEEEEEEEEE
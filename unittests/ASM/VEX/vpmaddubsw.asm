@@ -0,0 +1,39 @@
+%ifdef CONFIG
+{
+  "HostFeatures": ["AVX"],
+  "RegData": {
+    "XMM2":  ["0x7FFF7FFF7FFF7FFF", "0x80000081C0FF007F", "0x810000003A36FFBE", "0x25531680005A7FFF"],
+    "XMM3":  ["0x7FFF7FFF7FFF7FFF", "0x80000081C0FF007F", "0x810000003A36FFBE", "0x25531680005A7FFF"],
+    "XMM4":  ["0x7FFF7FFF7FFF7FFF", "0x80000081C0FF007F", "0x0000000000000000", "0x0000000000000000"],
+    "XMM5":  ["0x7FFF7FFF7FFF7FFF", "0x80000081C0FF007F", "0x0000000000000000", "0x0000000000000000"]
+  },
+  "MemoryRegions": {
+    "0x100000000": "4096"
+  }
+}
+%endif
+
+lea rdx, [rel .data]
+
+vmovapd ymm0, [rdx + 32 * 0]
+vmovapd ymm1, [rdx + 32 * 1]
+
+vpmaddubsw ymm2, ymm0, ymm1
+vpmaddubsw ymm3, ymm0, [rdx + 32 * 1]
+
+vpmaddubsw xmm4, xmm0, xmm1
+vpmaddubsw xmm5, xmm0, [rdx + 32 * 1]
+
+hlt
+
+align 32
+.data:
+dq 0xFFFFFFFFFFFFFFFF
+dq 0x80FF01027F7FFF01
+dq 0xFEDCBA9876543210
+dq 0x7FFF80000001FFFF
+
+dq 0x7F7F7F7F7F7F7F7F
+dq 0x80807F0180010180
+dq 0x800000007FFFFFFF
+dq 0x0F1E2D3C4B5A6978
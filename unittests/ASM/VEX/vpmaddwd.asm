@@ -0,0 +1,39 @@
+%ifdef CONFIG
+{
+  "HostFeatures": ["AVX"],
+  "RegData": {
+    "XMM2":  ["0xFF017EFF007E0A75", "0xE93E7C05F2590C85", "0x009200003B29579C", "0xF0F0F0E2FFFFE1E2"],
+    "XMM3":  ["0xFF017EFF007E0A75", "0xE93E7C05F2590C85", "0x009200003B29579C", "0xF0F0F0E2FFFFE1E2"],
+    "XMM4":  ["0xFF017EFF007E0A75", "0xE93E7C05F2590C85", "0x0000000000000000", "0x0000000000000000"],
+    "XMM5":  ["0xFF017EFF007E0A75", "0xE93E7C05F2590C85", "0x0000000000000000", "0x0000000000000000"]
+  },
+  "MemoryRegions": {
+    "0x100000000": "4096"
+  }
+}
+%endif
+
+lea rdx, [rel .data]
+
+vmovapd ymm0, [rdx + 32 * 0]
+vmovapd ymm1, [rdx + 32 * 1]
+
+vpmaddwd ymm2, ymm0, ymm1
+vpmaddwd ymm3, ymm0, [rdx + 32 * 1]
+
+vpmaddwd xmm4, xmm0, xmm1
+vpmaddwd xmm5, xmm0, [rdx + 32 * 1]
+
+hlt
+
+align 32
+.data:
+dq 0x80017F02FF030004
+dq 0x0123456789ABCDEF
+dq 0xFEDCBA9876543210
+dq 0x7FFF80000001FFFF
+
+dq 0x00FFFF00807F01FE
+dq 0x5555AAAA3333CCCC
+dq 0x800000007FFFFFFF
+dq 0x0F1E2D3C4B5A6978
@@ -0,0 +1,39 @@
+%ifdef CONFIG
+{
+  "HostFeatures": ["AVX"],
+  "RegData": {
+    "XMM2":  ["0x0023456789ABCDEF", "0x040003FF007F0180", "0x7FFF32107F107F76", "0xBABABABA00000100"],
+    "XMM3":  ["0x0023456789ABCDEF", "0x040003FF007F0180", "0x7FFF32107F107F76", "0xBABABABA00000100"],
+    "XMM4":  ["0x0023456789ABCDEF", "0x040003FF007F0180", "0x0000000000000000", "0x0000000000000000"],
+    "XMM5":  ["0x0023456789ABCDEF", "0x040003FF007F0180", "0x0000000000000000", "0x0000000000000000"]
+  },
+  "MemoryRegions": {
+    "0x100000000": "4096"
+  }
+}
+%endif
+
+lea rdx, [rel .data]
+
+vmovapd ymm0, [rdx + 32 * 0]
+vmovapd ymm1, [rdx + 32 * 1]
+
+vpshufb ymm2, ymm0, ymm1
+vpshufb ymm3, ymm0, [rdx + 32 * 1]
+
+vpshufb xmm4, xmm0, xmm1
+vpshufb xmm5, xmm0, [rdx + 32 * 1]
+
+hlt
+
+align 32
+.data:
+dq 0x80017F02FF030004
+dq 0x0123456789ABCDEF
+dq 0xFEDCBA9876543210
+dq 0x7FFF80000001FFFF
+
+dq 0x800E0D0C0B0A0908
+dq 0x0001020384050607
+dq 0x1F1E11100F007F03
+dq 0x0505050580800A0B
@@ -0,0 +1,44 @@
+%ifdef CONFIG
+{
+  "HostFeatures": ["AVX"],
+  "RegData": {
+    "XMM1":  ["0x89ABCDEF01234567", "0xFF03000480017F02", "0x0001FFFF7FFF8000", "0x76543210FEDCBA98"],
+    "XMM2":  ["0x89ABCDEF01234567", "0xFF03000480017F02", "0x0001FFFF7FFF8000", "0x76543210FEDCBA98"],
+    "XMM3":  ["0x89ABCDEF01234567", "0xFF03000480017F02", "0x0000000000000000", "0x0000000000000000"],
+    "XMM4":  ["0x80017F02FF030004", "0x0123456789ABCDEF", "0xFEDCBA9876543210", "0x7FFF80000001FFFF"],
+    "XMM5":  ["0x80017F02FF030004", "0x0123456789ABCDEF", "0xFEDCBA9876543210", "0x7FFF80000001FFFF"],
+    "XMM6":  ["0x80017F02FF030004", "0x0123456789ABCDEF", "0x0000000000000000", "0x0000000000000000"],
+    "XMM7":  ["0xFF030004FF030004", "0xFF030004FF030004", "0x7654321076543210", "0x7654321076543210"],
+    "XMM8":  ["0xFF030004FF030004", "0xFF030004FF030004", "0x7654321076543210", "0x7654321076543210"],
+    "XMM9":  ["0xFF030004FF030004", "0xFF030004FF030004", "0x0000000000000000", "0x0000000000000000"]
+  },
+  "MemoryRegions": {
+    "0x100000000": "4096"
+  }
+}
+%endif
+
+lea rdx, [rel .data]
+
+vmovapd ymm0, [rdx]
+
+vpshufd ymm1, ymm0, 0x1B
+vpshufd ymm2, [rdx], 0x1B
+vpshufd xmm3, xmm0, 0x1B
+
+vpshufd ymm4, ymm0, 0xE4
+vpshufd ymm5, [rdx], 0xE4
+vpshufd xmm6, xmm0, 0xE4
+
+vpshufd ymm7, ymm0, 0x00
+vpshufd ymm8, [rdx], 0x00
+vpshufd xmm9, xmm0, 0x00
+
+hlt
+
+align 32
+.data:
+dq 0x80017F02FF030004
+dq 0x0123456789ABCDEF
+dq 0xFEDCBA9876543210
+dq 0x7FFF80000001FFFF
@@ -0,0 +1,37 @@
+%ifdef CONFIG
+{
+  "HostFeatures": ["AVX"],
+  "RegData": {
+    "XMM1":  ["0x80017F02FF030004", "0xCDEF89AB45670123", "0xFEDCBA9876543210", "0xFFFF000180007FFF"],
+    "XMM2":  ["0x80017F02FF030004", "0xCDEF89AB45670123", "0xFEDCBA9876543210", "0xFFFF000180007FFF"],
+    "XMM3":  ["0x80017F02FF030004", "0xCDEF89AB45670123", "0x0000000000000000", "0x0000000000000000"],
+    "XMM4":  ["0x80017F02FF030004", "0x89ABCDEF01234567", "0xFEDCBA9876543210", "0x0001FFFF7FFF8000"],
+    "XMM5":  ["0x80017F02FF030004", "0x89ABCDEF01234567", "0xFEDCBA9876543210", "0x0001FFFF7FFF8000"],
+    "XMM6":  ["0x80017F02FF030004", "0x89ABCDEF01234567", "0x0000000000000000", "0x0000000000000000"]
+  },
+  "MemoryRegions": {
+    "0x100000000": "4096"
+  }
+}
+%endif
+
+lea rdx, [rel .data]
+
+vmovapd ymm0, [rdx]
+
+vpshufhw ymm1, ymm0, 0x1B
+vpshufhw ymm2, [rdx], 0x1B
+vpshufhw xmm3, xmm0, 0x1B
+
+vpshufhw ymm4, ymm0, 0x4E
+vpshufhw ymm5, [rdx], 0x4E
+vpshufhw xmm6, xmm0, 0x4E
+
+hlt
+
+align 32
+.data:
+dq 0x80017F02FF030004
+dq 0x0123456789ABCDEF
+dq 0xFEDCBA9876543210
+dq 0x7FFF80000001FFFF
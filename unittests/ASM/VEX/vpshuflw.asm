@@ -0,0 +1,37 @@
+%ifdef CONFIG
+{
+  "HostFeatures": ["AVX"],
+  "RegData": {
+    "XMM1":  ["0x0004FF037F028001", "0x0123456789ABCDEF", "0x32107654BA98FEDC", "0x7FFF80000001FFFF"],
+    "XMM2":  ["0x0004FF037F028001", "0x0123456789ABCDEF", "0x32107654BA98FEDC", "0x7FFF80000001FFFF"],
+    "XMM3":  ["0x0004FF037F028001", "0x0123456789ABCDEF", "0x0000000000000000", "0x0000000000000000"],
+    "XMM4":  ["0xFF03000480017F02", "0x0123456789ABCDEF", "0x76543210FEDCBA98", "0x7FFF80000001FFFF"],
+    "XMM5":  ["0xFF03000480017F02", "0x0123456789ABCDEF", "0x76543210FEDCBA98", "0x7FFF80000001FFFF"],
+    "XMM6":  ["0xFF03000480017F02", "0x0123456789ABCDEF", "0x0000000000000000", "0x0000000000000000"]
+  },
+  "MemoryRegions": {
+    "0x100000000": "4096"
+  }
+}
+%endif
+
+lea rdx, [rel .data]
+
+vmovapd ymm0, [rdx]
+
+vpshuflw ymm1, ymm0, 0x1B
+vpshuflw ymm2, [rdx], 0x1B
+vpshuflw xmm3, xmm0, 0x1B
+
+vpshuflw ymm4, ymm0, 0x4E
+vpshuflw ymm5, [rdx], 0x4E
+vpshuflw xmm6, xmm0, 0x4E
+
+hlt
+
+align 32
+.data:
+dq 0x80017F02FF030004
+dq 0x0123456789ABCDEF
+dq 0xFEDCBA9876543210
+dq 0x7FFF80000001FFFF
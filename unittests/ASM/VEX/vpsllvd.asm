@@ -0,0 +1,39 @@
+%ifdef CONFIG
+{
+  "HostFeatures": ["AVX"],
+  "RegData": {
+    "XMM2":  ["0x0002FE04FF030004", "0x0000000080000000", "0xEDCBA98000000000", "0x8000000001FFFF00"],
+    "XMM3":  ["0x0002FE04FF030004", "0x0000000080000000", "0xEDCBA98000000000", "0x8000000001FFFF00"],
+    "XMM4":  ["0x0002FE04FF030004", "0x0000000080000000", "0x0000000000000000", "0x0000000000000000"],
+    "XMM5":  ["0x0002FE04FF030004", "0x0000000080000000", "0x0000000000000000", "0x0000000000000000"]
+  },
+  "MemoryRegions": {
+    "0x100000000": "4096"
+  }
+}
+%endif
+
+lea rdx, [rel .data]
+
+vmovapd ymm0, [rdx + 32 * 0]
+vmovapd ymm1, [rdx + 32 * 1]
+
+vpsllvd ymm2, ymm0, ymm1
+vpsllvd ymm3, ymm0, [rdx + 32 * 1]
+
+vpsllvd xmm4, xmm0, xmm1
+vpsllvd xmm5, xmm0, [rdx + 32 * 1]
+
+hlt
+
+align 32
+.data:
+dq 0x80017F02FF030004
+dq 0x0123456789ABCDEF
+dq 0xFEDCBA9876543210
+dq 0x7FFF80000001FFFF
+
+dq 0x0000000100000000
+dq 0x000000200000001F
+dq 0x00000004FFFFFFFF
+dq 0x0000001000000008
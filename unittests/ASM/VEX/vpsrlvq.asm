@@ -0,0 +1,39 @@
+%ifdef CONFIG
+{
+  "HostFeatures": ["AVX"],
+  "RegData": {
+    "XMM2":  ["0x4000BF817F818002", "0x0000000000000000", "0x0000000000000001", "0x0000000000000000"],
+    "XMM3":  ["0x4000BF817F818002", "0x0000000000000000", "0x0000000000000001", "0x0000000000000000"],
+    "XMM4":  ["0x4000BF817F818002", "0x0000000000000000", "0x0000000000000000", "0x0000000000000000"],
+    "XMM5":  ["0x4000BF817F818002", "0x0000000000000000", "0x0000000000000000", "0x0000000000000000"]
+  },
+  "MemoryRegions": {
+    "0x100000000": "4096"
+  }
+}
+%endif
+
+lea rdx, [rel .data]
+
+vmovapd ymm0, [rdx + 32 * 0]
+vmovapd ymm1, [rdx + 32 * 1]
+
+vpsrlvq ymm2, ymm0, ymm1
+vpsrlvq ymm3, ymm0, [rdx + 32 * 1]
+
+vpsrlvq xmm4, xmm0, xmm1
+vpsrlvq xmm5, xmm0, [rdx + 32 * 1]
+
+hlt
+
+align 32
+.data:
+dq 0x80017F02FF030004
+dq 0x0123456789ABCDEF
+dq 0xFEDCBA9876543210
+dq 0x7FFF80000001FFFF
+
+dq 0x0000000000000001
+dq 0x0000000000000040
+dq 0x000000000000003F
+dq 0x8000000000000004
@@ -0,0 +1,205 @@
+/*
+  AVX2 integer kernels
+
+  checks a handful of real AVX2 kernels against scalar versions: a nibble lookup popcount built on VPSHUFB and the
+  multiply-add reductions, table lookups through VPGATHERDD with and without a mask, and a VPERMD/VPSRLVD bit unpack
+
+  the hidden benchmark runs the popcount and gather kernels over a larger buffer and prints the throughput
+*/
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <immintrin.h>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#define AVX2_TARGET __attribute__((target("avx2")))
+
+static bool SupportsAVX2() {
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx2");
+}
+
+AVX2_TARGET static uint32_t HorizontalSum(__m256i Value) {
+  __m128i Sum = _mm_add_epi32(_mm256_castsi256_si128(Value), _mm256_extracti128_si256(Value, 1));
+  uint32_t Lanes[4];
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(Lanes), Sum);
+  return Lanes[0] + Lanes[1] + Lanes[2] + Lanes[3];
+}
+
+// Looks up the bit count of each nibble with VPSHUFB, then widens the byte counts to dwords with the multiply-adds
+AVX2_TARGET static uint64_t PopcountAVX2(const uint8_t *Data, size_t Size) {
+  const __m256i Lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                          0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+  const __m256i LowMask = _mm256_set1_epi8(0x0F);
+  const __m256i OnesBytes = _mm256_set1_epi8(1);
+  const __m256i OnesWords = _mm256_set1_epi16(1);
+
+  __m256i Acc = _mm256_setzero_si256();
+  for (size_t i = 0; i < Size; i += 32) {
+    const __m256i Value = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&Data[i]));
+    const __m256i Low = _mm256_and_si256(Value, LowMask);
+    const __m256i High = _mm256_and_si256(_mm256_srli_epi16(Value, 4), LowMask);
+    const __m256i Counts = _mm256_add_epi8(_mm256_shuffle_epi8(Lookup, Low), _mm256_shuffle_epi8(Lookup, High));
+    const __m256i Words = _mm256_maddubs_epi16(Counts, OnesBytes);
+    Acc = _mm256_add_epi32(Acc, _mm256_madd_epi16(Words, OnesWords));
+  }
+
+  return HorizontalSum(Acc);
+}
+
+static uint64_t PopcountScalar(const uint8_t *Data, size_t Size) {
+  uint64_t Count = 0;
+  for (size_t i = 0; i < Size; ++i) {
+    Count += __builtin_popcount(Data[i]);
+  }
+  return Count;
+}
+
+AVX2_TARGET static uint32_t GatherSum(const uint32_t *Table, const int32_t *Indices, size_t Count) {
+  __m256i Acc = _mm256_setzero_si256();
+  for (size_t i = 0; i < Count; i += 8) {
+    const __m256i Index = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&Indices[i]));
+    Acc = _mm256_add_epi32(Acc, _mm256_i32gather_epi32(reinterpret_cast<const int*>(Table), Index, 4));
+  }
+  return HorizontalSum(Acc);
+}
+
+AVX2_TARGET static void MaskedGather(const uint64_t *Table, const int32_t *Indices, const int64_t *Mask, uint64_t *Result) {
+  const __m256i Src = _mm256_set1_epi64x(0x5A5A5A5A5A5A5A5A);
+  const __m128i Index = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Indices));
+  const __m256i MaskVec = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Mask));
+  const __m256i Gathered = _mm256_mask_i32gather_epi64(Src, reinterpret_cast<const long long*>(Table), Index, MaskVec, 8);
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(Result), Gathered);
+}
+
+// Spreads nibbles 0-3 of the first dword and nibbles 4-7 of the second dword out to one dword each
+AVX2_TARGET static void UnpackNibbles(const uint32_t *Src, uint32_t *Dest) {
+  const __m256i Value = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Src));
+  const __m256i Spread = _mm256_permutevar8x32_epi32(Value, _mm256_setr_epi32(0, 0, 0, 0, 1, 1, 1, 1));
+  const __m256i Shifted = _mm256_srlv_epi32(Spread, _mm256_setr_epi32(0, 4, 8, 12, 16, 20, 24, 28));
+  const __m256i Masked = _mm256_and_si256(Shifted, _mm256_set1_epi32(0xF));
+  // Keep odd dwords from a left shifted copy to exercise the blend and the other shift direction
+  const __m256i Doubled = _mm256_sllv_epi32(Masked, _mm256_set1_epi32(1));
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(Dest), _mm256_blend_epi32(Masked, Doubled, 0b10101010));
+}
+
+AVX2_TARGET static uint32_t NegativeByteMask(const int8_t *Src) {
+  return _mm256_movemask_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(Src)));
+}
+
+static std::vector<uint8_t> MakeBuffer(size_t Size) {
+  std::vector<uint8_t> Buffer(Size);
+  uint32_t State = 0x12345678;
+  for (auto &Byte : Buffer) {
+    State = State * 1664525 + 1013904223;
+    Byte = State >> 24;
+  }
+  return Buffer;
+}
+
+TEST_CASE("AVX2: popcount") {
+  if (!SupportsAVX2()) {
+    WARN("Host has no AVX2");
+    return;
+  }
+
+  const auto Buffer = MakeBuffer(4096);
+  CHECK(PopcountAVX2(Buffer.data(), Buffer.size()) == PopcountScalar(Buffer.data(), Buffer.size()));
+
+  const std::vector<uint8_t> AllSet(256, 0xFF);
+  CHECK(PopcountAVX2(AllSet.data(), AllSet.size()) == 256 * 8);
+}
+
+TEST_CASE("AVX2: gathers") {
+  if (!SupportsAVX2()) {
+    WARN("Host has no AVX2");
+    return;
+  }
+
+  uint32_t Table[256];
+  for (uint32_t i = 0; i < 256; ++i) {
+    Table[i] = i * 0x01010101U;
+  }
+
+  int32_t Indices[64];
+  uint32_t Expected = 0;
+  for (int32_t i = 0; i < 64; ++i) {
+    Indices[i] = (i * 37) & 0xFF;
+    Expected += Table[Indices[i]];
+  }
+  CHECK(GatherSum(Table, Indices, 64) == Expected);
+
+  // Masked off elements keep the source value and are never loaded
+  const uint64_t Table64[4] = {0x1111111111111111, 0x2222222222222222, 0x3333333333333333, 0x4444444444444444};
+  const int32_t Indices64[4] = {3, 1000000, 0, 2};
+  const int64_t Mask[4] = {-1, 0, INT64_MIN, 1};
+  uint64_t Result[4];
+  MaskedGather(Table64, Indices64, Mask, Result);
+  CHECK(Result[0] == Table64[3]);
+  CHECK(Result[1] == 0x5A5A5A5A5A5A5A5A);
+  CHECK(Result[2] == Table64[0]);
+  CHECK(Result[3] == 0x5A5A5A5A5A5A5A5A);
+}
+
+TEST_CASE("AVX2: permutes, variable shifts and movemask") {
+  if (!SupportsAVX2()) {
+    WARN("Host has no AVX2");
+    return;
+  }
+
+  const uint32_t Src[8] = {0x76543210, 0xFEDCBA98, 0, 0, 0, 0, 0, 0};
+  uint32_t Dest[8];
+  UnpackNibbles(Src, Dest);
+  for (uint32_t i = 0; i < 8; ++i) {
+    const uint32_t Nibble = (Src[i / 4] >> (i * 4)) & 0xF;
+    CHECK(Dest[i] == ((i & 1) ? Nibble << 1 : Nibble));
+  }
+
+  int8_t Bytes[32];
+  uint32_t ExpectedMask = 0;
+  for (int i = 0; i < 32; ++i) {
+    Bytes[i] = static_cast<int8_t>((i * 53) ^ 0x5C);
+    ExpectedMask |= (Bytes[i] < 0 ? 1U : 0U) << i;
+  }
+  CHECK(NegativeByteMask(Bytes) == ExpectedMask);
+}
+
+TEST_CASE("AVX2: kernel throughput", "[.][benchmark]") {
+  if (!SupportsAVX2()) {
+    WARN("Host has no AVX2");
+    return;
+  }
+
+  constexpr size_t Size = 1024 * 1024;
+  constexpr size_t Iterations = 100;
+  const auto Buffer = MakeBuffer(Size);
+  const auto Expected = PopcountScalar(Buffer.data(), Size);
+
+  auto Start = std::chrono::high_resolution_clock::now();
+  for (size_t i = 0; i < Iterations; ++i) {
+    REQUIRE(PopcountAVX2(Buffer.data(), Size) == Expected);
+  }
+  auto End = std::chrono::high_resolution_clock::now();
+  double Seconds = std::chrono::duration<double>(End - Start).count();
+  printf("popcount: %8.2f GB/s\n", static_cast<double>(Iterations * Size) / Seconds / 1e9);
+
+  // Random lookups into a table that fits in L1
+  static uint32_t Table[4096];
+  std::vector<int32_t> Indices(Size / 4);
+  for (size_t i = 0; i < Indices.size(); ++i) {
+    Table[i % 4096] = static_cast<uint32_t>(i);
+    Indices[i] = Buffer[i] | (Buffer[i + 1] & 0xF) << 8;
+  }
+
+  uint32_t Sum = 0;
+  Start = std::chrono::high_resolution_clock::now();
+  for (size_t i = 0; i < Iterations; ++i) {
+    Sum += GatherSum(Table, Indices.data(), Indices.size());
+  }
+  End = std::chrono::high_resolution_clock::now();
+  Seconds = std::chrono::duration<double>(End - Start).count();
+  printf("gather: %8.2f Melements/s (checksum %08x)\n", static_cast<double>(Iterations * Indices.size()) / Seconds / 1e6, Sum);
+}
@@ -0,0 +1,61 @@
+/*
+  Short lived processes
+
+  with CacheObjectCodeCompilation enabled FEX shares the code it compiles for a file between processes through FEXServer
+  every process after the first one should pick up the code of the shell and its libraries from the shared cache
+
+  the hidden benchmark spawns 1000 shells, the elapsed time is printed
+*/
+#include <chrono>
+#include <cstdio>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <catch2/catch.hpp>
+
+extern char **environ;
+
+static int SpawnShell(const char *Command) {
+  char Shell[] = "/bin/sh";
+  char Flag[] = "-c";
+  char *Args[] = {Shell, Flag, const_cast<char*>(Command), nullptr};
+
+  pid_t PID{};
+  if (posix_spawn(&PID, Shell, nullptr, nullptr, Args, environ) != 0) {
+    return -1;
+  }
+
+  int Status{};
+  if (waitpid(PID, &Status, 0) != PID || !WIFEXITED(Status)) {
+    return -1;
+  }
+
+  return WEXITSTATUS(Status);
+}
+
+TEST_CASE("shared code cache: repeated processes behave the same") {
+  // The second and third run use the code the first one left behind
+  for (int i = 0; i < 3; ++i) {
+    CHECK(SpawnShell("true") == 0);
+    CHECK(SpawnShell("exit 3") == 3);
+    CHECK(SpawnShell("i=0; while [ $i -lt 100 ]; do i=$((i+1)); done; [ $i -eq 100 ]") == 0);
+  }
+}
+
+TEST_CASE("shared code cache: spawn 1000 shells", "[.][benchmark]") {
+  constexpr int NumProcesses = 1000;
+
+  auto Start = std::chrono::high_resolution_clock::now();
+  int Failed{};
+  for (int i = 0; i < NumProcesses; ++i) {
+    if (SpawnShell("true") != 0) {
+      ++Failed;
+    }
+  }
+  auto End = std::chrono::high_resolution_clock::now();
+
+  CHECK(Failed == 0);
+  printf("%d processes in %lld ms\n", NumProcesses,
+    static_cast<long long>(std::chrono::duration_cast<std::chrono::milliseconds>(End - Start).count()));
+}
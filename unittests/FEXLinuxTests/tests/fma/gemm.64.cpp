@@ -0,0 +1,182 @@
+/*
+  FMA3 and F16C
+
+  checks that the fused ops round once by comparing against std::fma and that half-float conversions round the way
+  the immediate asks for
+
+  the hidden benchmark runs a small single precision GEMM with 256-bit FMAs and prints the GFLOP/s
+*/
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <immintrin.h>
+#include <type_traits>
+
+#include <catch2/catch.hpp>
+
+#define FMA_TARGET __attribute__((target("avx,fma,f16c")))
+
+template<typename T>
+static auto Bits(T Value) {
+  std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t> Result;
+  memcpy(&Result, &Value, sizeof(T));
+  return Result;
+}
+
+static bool SupportsFMA() {
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("fma") && __builtin_cpu_supports("f16c");
+}
+
+FMA_TARGET static void FMAdd(const float *A, const float *B, const float *C, float *Result) {
+  _mm256_storeu_ps(Result, _mm256_fmadd_ps(_mm256_loadu_ps(A), _mm256_loadu_ps(B), _mm256_loadu_ps(C)));
+}
+
+FMA_TARGET static void FNMSub(const double *A, const double *B, const double *C, double *Result) {
+  _mm256_storeu_pd(Result, _mm256_fnmsub_pd(_mm256_loadu_pd(A), _mm256_loadu_pd(B), _mm256_loadu_pd(C)));
+}
+
+FMA_TARGET static void FMAddSub(const float *A, const float *B, const float *C, float *Result) {
+  _mm256_storeu_ps(Result, _mm256_fmaddsub_ps(_mm256_loadu_ps(A), _mm256_loadu_ps(B), _mm256_loadu_ps(C)));
+}
+
+FMA_TARGET static float FMAddScalar(float A, float B, float C) {
+  return _mm_cvtss_f32(_mm_fmadd_ss(_mm_set_ss(A), _mm_set_ss(B), _mm_set_ss(C)));
+}
+
+template<int Rounding>
+FMA_TARGET static void ToHalf(const float *Src, uint16_t *Dest) {
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(Dest), _mm256_cvtps_ph(_mm256_loadu_ps(Src), Rounding));
+}
+
+FMA_TARGET static void FromHalf(const uint16_t *Src, float *Dest) {
+  _mm256_storeu_ps(Dest, _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(Src))));
+}
+
+TEST_CASE("FMA3: single rounding") {
+  if (!SupportsFMA()) {
+    WARN("Host has no FMA3/F16C");
+    return;
+  }
+
+  // (1 + 2^-23) * (1 - 2^-23) - 1 is -2^-46 fused and 0 when the product is rounded first
+  const float E = std::ldexp(1.0f, -23);
+  const float A[8] = {1.0f + E, 3.0f, -0.1f, 1e30f, 1.0f + E, 0.5f, -7.25f, 1e-20f};
+  const float B[8] = {1.0f - E, 1.0f / 3.0f, 10.0f, 1e30f, 1.0f + E, 0.5f, 4.0f, 1e-20f};
+  const float C[8] = {-1.0f, -1.0f, 1.0f, -INFINITY, -1.0f, -0.25f, 29.0f, 0.0f};
+  float Result[8];
+
+  FMAdd(A, B, C, Result);
+  for (size_t i = 0; i < 8; ++i) {
+    CHECK(Bits(Result[i]) == Bits(std::fma(A[i], B[i], C[i])));
+  }
+  CHECK(Result[0] == -std::ldexp(1.0f, -46));
+
+  CHECK(FMAddScalar(A[0], B[0], C[0]) == -std::ldexp(1.0f, -46));
+
+  // Even elements subtract, odd elements add
+  FMAddSub(A, B, C, Result);
+  for (size_t i = 0; i < 8; ++i) {
+    const float Expected = std::fma(A[i], B[i], (i & 1) ? C[i] : -C[i]);
+    CHECK(Bits(Result[i]) == Bits(Expected));
+  }
+
+  const double ED = std::ldexp(1.0, -52);
+  const double AD[4] = {1.0 + ED, 2.0, -3.0, 1e300};
+  const double BD[4] = {1.0 - ED, 0.1, 0.7, 1e10};
+  const double CD[4] = {-1.0, 5.0, 0.0, 1.0};
+  double ResultD[4];
+  FNMSub(AD, BD, CD, ResultD);
+  for (size_t i = 0; i < 4; ++i) {
+    CHECK(Bits(ResultD[i]) == Bits(std::fma(-AD[i], BD[i], -CD[i])));
+  }
+}
+
+TEST_CASE("F16C: conversions and rounding") {
+  if (!SupportsFMA()) {
+    WARN("Host has no FMA3/F16C");
+    return;
+  }
+
+  // 1 + 2^-11 sits exactly between two halves, 1 + 3 * 2^-12 is above the midpoint
+  const float Src[8] = {1.0f, 1.0f + std::ldexp(1.0f, -11), 1.0f + 3 * std::ldexp(1.0f, -12), -2.5f,
+                        65520.0f, std::ldexp(1.0f, -24), NAN, -INFINITY};
+  uint16_t Nearest[8];
+  uint16_t Truncated[8];
+  ToHalf<_MM_FROUND_TO_NEAREST_INT>(Src, Nearest);
+  ToHalf<_MM_FROUND_TO_ZERO>(Src, Truncated);
+
+  CHECK(Nearest[0] == 0x3C00);
+  CHECK(Nearest[1] == 0x3C00);
+  CHECK(Nearest[2] == 0x3C01);
+  CHECK(Nearest[3] == 0xC100);
+  CHECK(Nearest[4] == 0x7C00);
+  CHECK(Nearest[5] == 0x0001);
+  CHECK((Nearest[6] & 0x7E00) == 0x7E00);
+  CHECK(Nearest[7] == 0xFC00);
+
+  CHECK(Truncated[2] == 0x3C00);
+  CHECK(Truncated[4] == 0x7BFF);
+
+  float Back[8];
+  FromHalf(Nearest, Back);
+  CHECK(Back[0] == 1.0f);
+  CHECK(Back[2] == 1.0f + std::ldexp(1.0f, -10));
+  CHECK(Back[3] == -2.5f);
+  CHECK(std::isinf(Back[4]));
+  CHECK(Back[5] == std::ldexp(1.0f, -24));
+  CHECK(std::isnan(Back[6]));
+}
+
+// C += A * B where A is MxK, B is KxN and N is a multiple of 8
+FMA_TARGET static void Gemm(const float *A, const float *B, float *C, size_t M, size_t N, size_t K) {
+  for (size_t i = 0; i < M; ++i) {
+    for (size_t j = 0; j < N; j += 8) {
+      __m256 Acc = _mm256_loadu_ps(&C[i * N + j]);
+      for (size_t k = 0; k < K; ++k) {
+        Acc = _mm256_fmadd_ps(_mm256_broadcast_ss(&A[i * K + k]), _mm256_loadu_ps(&B[k * N + j]), Acc);
+      }
+      _mm256_storeu_ps(&C[i * N + j], Acc);
+    }
+  }
+}
+
+TEST_CASE("FMA3: GEMM", "[.][benchmark]") {
+  if (!SupportsFMA()) {
+    WARN("Host has no FMA3/F16C");
+    return;
+  }
+
+  constexpr size_t Size = 128;
+  static float A[Size * Size];
+  static float B[Size * Size];
+  static float C[Size * Size];
+  for (size_t i = 0; i < Size * Size; ++i) {
+    A[i] = static_cast<float>(i % 7) * 0.25f;
+    B[i] = static_cast<float>(i % 5) * 0.5f;
+  }
+
+  // Small integers times powers of two are exact so the result can be checked against a plain loop
+  Gemm(A, B, C, Size, Size, Size);
+  for (size_t i = 0; i < Size; i += 17) {
+    for (size_t j = 0; j < Size; j += 13) {
+      float Expected = 0.0f;
+      for (size_t k = 0; k < Size; ++k) {
+        Expected += A[i * Size + k] * B[k * Size + j];
+      }
+      REQUIRE(C[i * Size + j] == Expected);
+    }
+  }
+
+  constexpr size_t Iterations = 200;
+  auto Start = std::chrono::high_resolution_clock::now();
+  for (size_t i = 0; i < Iterations; ++i) {
+    Gemm(A, B, C, Size, Size, Size);
+  }
+  auto End = std::chrono::high_resolution_clock::now();
+
+  const double Seconds = std::chrono::duration<double>(End - Start).count();
+  printf("sgemm %zux%zu: %8.2f GFLOP/s\n", Size, Size, static_cast<double>(Iterations * 2 * Size * Size * Size) / Seconds / 1e9);
+}
@@ -0,0 +1,219 @@
+/*
+  Path lookups in the rootfs
+
+  with a SquashFS or EroFS rootfs FEX answers these from the image instead of going through the FUSE mount
+  absolute lookups and lookups relative to a directory FD have to agree with each other
+  opened files have to keep the path and identity they have in the mount
+
+  the hidden benchmark walks /usr cold and warm and loads a few libraries, the elapsed times are printed
+*/
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#include <dlfcn.h>
+#include <fcntl.h>
+#include <ftw.h>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+TEST_CASE("rootfs: absolute and dirfd relative lookups agree") {
+  int DirFD = open("/usr", O_RDONLY | O_DIRECTORY);
+  REQUIRE(DirFD != -1);
+
+  for (const char *Name : {"bin", "lib", "share"}) {
+    auto Path = std::string("/usr/") + Name;
+
+    struct stat Absolute{};
+    struct stat Relative{};
+    if (stat(Path.c_str(), &Absolute) != 0) {
+      continue;
+    }
+
+    REQUIRE(fstatat(DirFD, Name, &Relative, 0) == 0);
+    CHECK(Absolute.st_dev == Relative.st_dev);
+    CHECK(Absolute.st_ino == Relative.st_ino);
+    CHECK(Absolute.st_mode == Relative.st_mode);
+
+    REQUIRE(lstat(Path.c_str(), &Absolute) == 0);
+    REQUIRE(fstatat(DirFD, Name, &Relative, AT_SYMLINK_NOFOLLOW) == 0);
+    CHECK(Absolute.st_ino == Relative.st_ino);
+    CHECK(Absolute.st_mode == Relative.st_mode);
+
+    if (S_ISLNK(Absolute.st_mode)) {
+      char AbsoluteTarget[PATH_MAX]{};
+      char RelativeTarget[PATH_MAX]{};
+      REQUIRE(readlink(Path.c_str(), AbsoluteTarget, sizeof(AbsoluteTarget)) > 0);
+      REQUIRE(readlinkat(DirFD, Name, RelativeTarget, sizeof(RelativeTarget)) > 0);
+      CHECK(strcmp(AbsoluteTarget, RelativeTarget) == 0);
+    }
+    else {
+      char Target[PATH_MAX];
+      errno = 0;
+      CHECK(readlink(Path.c_str(), Target, sizeof(Target)) == -1);
+      CHECK(errno == EINVAL);
+    }
+  }
+
+  struct stat Buffer{};
+  CHECK(fstatat(DirFD, "does-not-exist", &Buffer, 0) == -1);
+  CHECK(errno == ENOENT);
+
+  close(DirFD);
+}
+
+TEST_CASE("rootfs: reopened files keep their identity") {
+  const char *Path = "/etc/passwd";
+  int FD1 = open(Path, O_RDONLY);
+  if (FD1 == -1) {
+    WARN("No /etc/passwd");
+    return;
+  }
+  int FD2 = open(Path, O_RDONLY);
+  REQUIRE(FD2 != -1);
+
+  struct stat Stat1{};
+  struct stat Stat2{};
+  REQUIRE(fstat(FD1, &Stat1) == 0);
+  REQUIRE(fstat(FD2, &Stat2) == 0);
+  CHECK(Stat1.st_dev == Stat2.st_dev);
+  CHECK(Stat1.st_ino == Stat2.st_ino);
+
+  // Each open has its own file offset
+  char Data1[16]{};
+  char Data2[16]{};
+  REQUIRE(read(FD1, Data1, sizeof(Data1)) > 0);
+  REQUIRE(read(FD2, Data2, sizeof(Data2)) > 0);
+  CHECK(memcmp(Data1, Data2, sizeof(Data1)) == 0);
+
+  // Read-only, writes must fail
+  CHECK(write(FD1, Data1, sizeof(Data1)) == -1);
+
+  close(FD1);
+  close(FD2);
+}
+
+TEST_CASE("rootfs: stat agrees with fstat of the opened file") {
+  // Identity has to match for hard link and cycle detection in fts, find and cp
+  int Checked{};
+  for (const char *Path : {"/etc/passwd", "/usr/lib/os-release", "/etc/ld.so.cache"}) {
+    struct stat PathStat{};
+    if (stat(Path, &PathStat) != 0) {
+      continue;
+    }
+
+    int FD = open(Path, O_RDONLY);
+    REQUIRE(FD != -1);
+
+    struct stat FDStat{};
+    REQUIRE(fstat(FD, &FDStat) == 0);
+    CHECK(PathStat.st_dev == FDStat.st_dev);
+    CHECK(PathStat.st_ino == FDStat.st_ino);
+    CHECK(PathStat.st_mode == FDStat.st_mode);
+    CHECK(PathStat.st_size == FDStat.st_size);
+    CHECK(PathStat.st_nlink == FDStat.st_nlink);
+
+    close(FD);
+    ++Checked;
+  }
+
+  if (!Checked) {
+    WARN("No files to check");
+  }
+}
+
+static std::string GetFDPath(int FD) {
+  char Buffer[PATH_MAX]{};
+  auto Length = readlink(("/proc/self/fd/" + std::to_string(FD)).c_str(), Buffer, sizeof(Buffer) - 1);
+  return Length > 0 ? std::string(Buffer, Length) : std::string{};
+}
+
+TEST_CASE("rootfs: opened libraries keep their own paths") {
+  // AOTIR and the code cache name files by the FD path, a shared path would mix up their caches
+  std::vector<std::string> Libraries;
+  for (const char *Path : {
+      "/lib/x86_64-linux-gnu/libc.so.6", "/lib/x86_64-linux-gnu/libm.so.6", "/lib/x86_64-linux-gnu/libz.so.1",
+      "/usr/lib/libc.so.6", "/usr/lib/libm.so.6", "/usr/lib64/libc.so.6", "/usr/lib64/libm.so.6"}) {
+    if (access(Path, R_OK) == 0) {
+      Libraries.emplace_back(Path);
+    }
+  }
+
+  if (Libraries.size() < 2) {
+    WARN("Needs two libraries");
+    return;
+  }
+
+  std::vector<std::string> FDPaths;
+  std::vector<std::string> ResolvedPaths;
+  for (auto &Library : Libraries) {
+    int FD = open(Library.c_str(), O_RDONLY | O_CLOEXEC);
+    REQUIRE(FD != -1);
+    auto FDPath = GetFDPath(FD);
+    close(FD);
+
+    REQUIRE(!FDPath.empty());
+    CHECK(FDPath.find("memfd:") == std::string::npos);
+    CHECK(FDPath.find("(deleted)") == std::string::npos);
+
+    // The basename is part of the AOTIR file ID
+    char Resolved[PATH_MAX]{};
+    REQUIRE(realpath(Library.c_str(), Resolved) != nullptr);
+    const std::string ResolvedName = strrchr(Resolved, '/') + 1;
+    CHECK(FDPath.substr(FDPath.rfind('/') + 1) == ResolvedName);
+
+    FDPaths.emplace_back(std::move(FDPath));
+    ResolvedPaths.emplace_back(Resolved);
+  }
+
+  // Different files never share a path, even when the guest reaches them through symlinks
+  for (size_t i = 0; i < FDPaths.size(); ++i) {
+    for (size_t j = i + 1; j < FDPaths.size(); ++j) {
+      if (ResolvedPaths[i] != ResolvedPaths[j]) {
+        CHECK(FDPaths[i] != FDPaths[j]);
+      }
+    }
+  }
+}
+
+static size_t Entries;
+
+static int CountEntry(const char *, const struct stat *, int, struct FTW *) {
+  ++Entries;
+  return 0;
+}
+
+TEST_CASE("rootfs: find /usr", "[.][benchmark]") {
+  for (const char *Pass : {"cold", "warm"}) {
+    Entries = 0;
+    auto Start = std::chrono::high_resolution_clock::now();
+    REQUIRE(nftw("/usr", CountEntry, 64, FTW_PHYS) == 0);
+    auto End = std::chrono::high_resolution_clock::now();
+
+    printf("%s: %zu entries in %lld ms\n", Pass, Entries,
+      static_cast<long long>(std::chrono::duration_cast<std::chrono::milliseconds>(End - Start).count()));
+  }
+}
+
+TEST_CASE("rootfs: library loading", "[.][benchmark]") {
+  for (const char *Pass : {"cold", "warm"}) {
+    auto Start = std::chrono::high_resolution_clock::now();
+    int Loaded{};
+    for (const char *Library : {"libz.so.1", "libstdc++.so.6", "libcrypto.so.3", "libX11.so.6", "libgtk-3.so.0"}) {
+      void *Handle = dlopen(Library, RTLD_NOW | RTLD_LOCAL);
+      if (Handle) {
+        ++Loaded;
+        dlclose(Handle);
+      }
+    }
+    auto End = std::chrono::high_resolution_clock::now();
+
+    printf("%s: loaded %d libraries in %lld us\n", Pass, Loaded,
+      static_cast<long long>(std::chrono::duration_cast<std::chrono::microseconds>(End - Start).count()));
+  }
+}
@@ -0,0 +1,92 @@
+/*
+  mmap/munmap churn through the 32-bit allocator
+
+  keeps a working set of mappings with varying sizes alive while continuously replacing random entries
+  this fragments the address space, which stresses the free range search of the allocator
+  on 64-bit MAP_32BIT forces the same allocator
+
+  elapsed time is printed so it doubles as a microbenchmark
+*/
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <sys/mman.h>
+
+#include <catch2/catch.hpp>
+
+#ifndef MAP_32BIT
+#define MAP_32BIT 0
+#endif
+
+constexpr size_t PageSize = 4096;
+constexpr int NumLive = 1024;
+constexpr int NumIterations = 100000;
+
+struct Mapping {
+  uint8_t *Ptr;
+  size_t Size;
+};
+
+static Mapping Live[NumLive];
+
+static uint32_t Random(uint32_t *State) {
+  *State = *State * 1664525 + 1013904223;
+  return *State >> 8;
+}
+
+static bool Overlaps(const Mapping &A, const Mapping &B) {
+  return A.Ptr < B.Ptr + B.Size && B.Ptr < A.Ptr + A.Size;
+}
+
+TEST_CASE("mmap: churn") {
+  uint32_t State = 1;
+  int Failures{};
+
+  auto Map = [&](Mapping *Entry) {
+    // Mostly small mappings with the occasional large one
+    const size_t Pages = (Random(&State) % 16 == 0) ? 64 + Random(&State) % 256 : 1 + Random(&State) % 8;
+    Entry->Size = Pages * PageSize;
+    Entry->Ptr = reinterpret_cast<uint8_t*>(mmap(nullptr, Entry->Size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_32BIT, -1, 0));
+    REQUIRE(Entry->Ptr != MAP_FAILED);
+    REQUIRE(reinterpret_cast<uintptr_t>(Entry->Ptr) + Entry->Size <= 0x1'0000'0000ULL);
+
+    // Fresh anonymous memory must be zero, and stamping it catches overlapping mappings
+    if (Entry->Ptr[0] != 0 || Entry->Ptr[Entry->Size - 1] != 0) {
+      ++Failures;
+    }
+    Entry->Ptr[0] = 0xFF;
+    Entry->Ptr[Entry->Size - 1] = 0xFF;
+  };
+
+  auto Start = std::chrono::high_resolution_clock::now();
+
+  for (int i = 0; i < NumLive; ++i) {
+    Map(&Live[i]);
+  }
+
+  for (int i = 0; i < NumIterations; ++i) {
+    auto &Entry = Live[Random(&State) % NumLive];
+    REQUIRE(munmap(Entry.Ptr, Entry.Size) == 0);
+    Map(&Entry);
+  }
+
+  auto End = std::chrono::high_resolution_clock::now();
+  printf("%d mmap/munmap pairs in %lld ms\n", NumIterations,
+    static_cast<long long>(std::chrono::duration_cast<std::chrono::milliseconds>(End - Start).count()));
+
+  // The allocator must never hand out a range that is still live
+  for (int i = 0; i < NumLive; ++i) {
+    for (int j = i + 1; j < NumLive; ++j) {
+      if (Overlaps(Live[i], Live[j])) {
+        ++Failures;
+      }
+    }
+  }
+
+  for (int i = 0; i < NumLive; ++i) {
+    munmap(Live[i].Ptr, Live[i].Size);
+  }
+
+  CHECK(Failures == 0);
+}
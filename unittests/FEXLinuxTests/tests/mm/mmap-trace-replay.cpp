@@ -0,0 +1,152 @@
+/*
+  replays an mmap/mprotect/munmap trace shaped like a JIT heavy process
+
+  the trace reserves large PROT_NONE regions, commits pieces of them RW, flips committed code to RX
+  and keeps many small anonymous arenas coming and going
+  this leaves tens of thousands of mappings alive, which stresses the VMA tracking lookups and splits
+
+  committed memory and fresh arenas are written and read back along the way
+  elapsed time is printed so it doubles as a microbenchmark
+*/
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <sys/mman.h>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+constexpr size_t PageSize = 4096;
+constexpr int NumRegions = 16;
+constexpr size_t RegionPages = 4096;
+constexpr int NumArenas = 4096;
+constexpr int NumSteps = 200000;
+
+enum class Op : uint8_t {
+  Commit,
+  Protect,
+  Decommit,
+  ArenaMap,
+  ArenaUnmap,
+};
+
+struct TraceEntry {
+  Op Type;
+  uint16_t Target;
+  uint16_t Page;
+  uint16_t Pages;
+};
+
+static uint32_t Random(uint32_t *State) {
+  *State = *State * 1664525 + 1013904223;
+  return *State >> 8;
+}
+
+// Deterministic trace, the mix roughly follows what a JVM does while warming up
+static std::vector<TraceEntry> GenerateTrace() {
+  std::vector<TraceEntry> Trace;
+  Trace.reserve(NumSteps);
+  uint32_t State = 7;
+
+  for (int i = 0; i < NumSteps; ++i) {
+    const auto Kind = Random(&State) % 10;
+    const uint16_t Pages = 1 + Random(&State) % 4;
+    const uint16_t Page = Random(&State) % (RegionPages - Pages);
+
+    if (Kind < 3) {
+      Trace.push_back({Op::Commit, static_cast<uint16_t>(Random(&State) % NumRegions), Page, Pages});
+    }
+    else if (Kind < 6) {
+      Trace.push_back({Op::Protect, static_cast<uint16_t>(Random(&State) % NumRegions), Page, Pages});
+    }
+    else if (Kind < 7) {
+      Trace.push_back({Op::Decommit, static_cast<uint16_t>(Random(&State) % NumRegions), Page, Pages});
+    }
+    else if (Kind < 9) {
+      Trace.push_back({Op::ArenaMap, static_cast<uint16_t>(Random(&State) % NumArenas), 0, Pages});
+    }
+    else {
+      Trace.push_back({Op::ArenaUnmap, static_cast<uint16_t>(Random(&State) % NumArenas), 0, 0});
+    }
+  }
+
+  return Trace;
+}
+
+TEST_CASE("mmap: trace replay") {
+  const auto Trace = GenerateTrace();
+
+  uint8_t *Regions[NumRegions];
+  for (auto &Region : Regions) {
+    Region = reinterpret_cast<uint8_t*>(mmap(nullptr, RegionPages * PageSize, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0));
+    REQUIRE(Region != MAP_FAILED);
+  }
+
+  struct Arena {
+    uint8_t *Ptr;
+    size_t Size;
+  };
+  Arena Arenas[NumArenas]{};
+
+  int Failures{};
+  auto Start = std::chrono::high_resolution_clock::now();
+
+  for (const auto &Entry : Trace) {
+    switch (Entry.Type) {
+      case Op::Commit: {
+        auto Ptr = Regions[Entry.Target] + Entry.Page * PageSize;
+        REQUIRE(mprotect(Ptr, Entry.Pages * PageSize, PROT_READ | PROT_WRITE) == 0);
+        Ptr[0] = static_cast<uint8_t>(Entry.Page);
+        Failures += Ptr[0] != static_cast<uint8_t>(Entry.Page);
+        break;
+      }
+      case Op::Protect: {
+        auto Ptr = Regions[Entry.Target] + Entry.Page * PageSize;
+        REQUIRE(mprotect(Ptr, Entry.Pages * PageSize, PROT_READ | PROT_EXEC) == 0);
+        break;
+      }
+      case Op::Decommit: {
+        auto Ptr = Regions[Entry.Target] + Entry.Page * PageSize;
+        REQUIRE(mprotect(Ptr, Entry.Pages * PageSize, PROT_NONE) == 0);
+        break;
+      }
+      case Op::ArenaMap: {
+        auto &Arena = Arenas[Entry.Target];
+        if (Arena.Ptr) {
+          REQUIRE(munmap(Arena.Ptr, Arena.Size) == 0);
+        }
+        Arena.Size = Entry.Pages * PageSize;
+        Arena.Ptr = reinterpret_cast<uint8_t*>(mmap(nullptr, Arena.Size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+        REQUIRE(Arena.Ptr != MAP_FAILED);
+        // Fresh anonymous memory must be zero
+        Failures += Arena.Ptr[0] != 0;
+        Arena.Ptr[0] = 1;
+        break;
+      }
+      case Op::ArenaUnmap: {
+        auto &Arena = Arenas[Entry.Target];
+        if (Arena.Ptr) {
+          REQUIRE(munmap(Arena.Ptr, Arena.Size) == 0);
+          Arena.Ptr = nullptr;
+        }
+        break;
+      }
+    }
+  }
+
+  auto End = std::chrono::high_resolution_clock::now();
+  printf("%zu trace entries in %lld ms\n", Trace.size(),
+    static_cast<long long>(std::chrono::duration_cast<std::chrono::milliseconds>(End - Start).count()));
+
+  for (auto &Arena : Arenas) {
+    if (Arena.Ptr) {
+      munmap(Arena.Ptr, Arena.Size);
+    }
+  }
+
+  for (auto &Region : Regions) {
+    munmap(Region, RegionPages * PageSize);
+  }
+
+  CHECK(Failures == 0);
+}
@@ -0,0 +1,100 @@
+/*
+  tests for smc changes on a page that also holds frequently written data
+*/
+// FEX config: FEX_SMCTHRASHTHRESHOLD=100
+
+#include "smc-common.h"
+
+#include <cpuid.h>
+
+#include <catch2/catch.hpp>
+
+constexpr uint32_t ThrashThreshold = 100;
+
+// Data writes are only performed in place when FEX runs on an arm64 host
+static bool RunningUnderFEXOnArm64() {
+  uint32_t eax, ebx, ecx, edx;
+  __cpuid(0x4000'0000, eax, ebx, ecx, edx);
+
+  char Signature[12];
+  memcpy(&Signature[0], &ebx, 4);
+  memcpy(&Signature[4], &ecx, 4);
+  memcpy(&Signature[8], &edx, 4);
+  if (memcmp(Signature, "FEXIFEXIEMU", 11) != 0) {
+    return false;
+  }
+
+  // Host architecture, 2 is arm64
+  __cpuid(0x4000'0001, eax, ebx, ecx, edx);
+  return (eax & 0xF) == 2;
+}
+
+// Changes guest memory without a store the emulator could see
+static void StealthWrite(void *Addr, uint8_t Value) {
+  int fd = open("/proc/self/mem", O_RDWR | O_CLOEXEC);
+  REQUIRE(fd != -1);
+  REQUIRE(pwrite(fd, &Value, 1, reinterpret_cast<uintptr_t>(Addr)) == 1);
+  close(fd);
+}
+
+TEST_CASE("SMC: data next to code") {
+  auto code = (char *)mmap(0, 4096, PROT_READ | PROT_WRITE | PROT_EXEC, MAP_PRIVATE | MAP_ANON, 0, 0);
+  auto data = (volatile uint32_t *)(code + 2048);
+
+  // mov eax, imm32
+  code[0] = 0xB8;
+  code[1] = 0x00;
+  code[2] = 0x00;
+  code[3] = 0x00;
+  code[4] = 0x00;
+
+  // ret
+  code[5] = 0xC3;
+
+  auto fn = (int (*)())code;
+
+  // Data writes on the code page must not break code that is still valid, however often they happen
+  for (uint32_t i = 0; i < 1000; ++i) {
+    *data = i;
+    CHECK(fn() == 0);
+  }
+
+  // Code on the page must still be invalidated once it is changed
+  for (uint32_t i = 1; i < 100; ++i) {
+    *data = i;
+    code[1] = i;
+    CHECK(fn() == i);
+  }
+
+  CHECK(*data == 99);
+}
+
+TEST_CASE("SMC: code survives data writes") {
+  if (!RunningUnderFEXOnArm64()) {
+    SUCCEED("Data writes always invalidate here");
+    return;
+  }
+
+  auto code = (char *)mmap(0, 4096, PROT_READ | PROT_WRITE | PROT_EXEC, MAP_PRIVATE | MAP_ANON, 0, 0);
+  auto data = (volatile uint32_t *)(code + 2048);
+
+  // mov eax, 0; ret
+  const uint8_t Code[] = { 0xB8, 0x00, 0x00, 0x00, 0x00, 0xC3 };
+  memcpy(code, Code, sizeof(Code));
+
+  auto fn = (int (*)())code;
+  CHECK(fn() == 0);
+
+  // Only recompiling the block would pick this up
+  StealthWrite(&code[1], 42);
+
+  // Stay below the threshold, past it the page switches to validation
+  for (uint32_t i = 0; i < ThrashThreshold / 2; ++i) {
+    *data = i;
+    CHECK(*data == i);
+    CHECK(fn() == 0);
+  }
+
+  StealthWrite(&code[1], 0);
+  munmap(code, 4096);
+}
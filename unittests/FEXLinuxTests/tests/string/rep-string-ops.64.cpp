@@ -0,0 +1,233 @@
+/*
+  REP MOVS/STOS/CMPS
+
+  FEX turns these in to bulk memory ops that work on chunks of elements
+  checks overlapping copies, downwards walks and that a fault in the middle of a copy leaves RCX/RSI/RDI at a
+  point the instruction can continue from
+
+  the hidden benchmark prints the throughput of each op across sizes
+*/
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <signal.h>
+#include <sys/mman.h>
+#include <ucontext.h>
+#include <unistd.h>
+
+#include <catch2/catch.hpp>
+
+static void RepMovsb(void *Dest, const void *Src, size_t Count) {
+  __asm volatile("rep movsb" : "+D"(Dest), "+S"(Src), "+c"(Count) :: "memory");
+}
+
+static void RepMovsbDown(void *Dest, const void *Src, size_t Count) {
+  __asm volatile("std; rep movsb; cld" : "+D"(Dest), "+S"(Src), "+c"(Count) :: "memory");
+}
+
+static void RepStosq(void *Dest, uint64_t Value, size_t Count) {
+  __asm volatile("rep stosq" : "+D"(Dest), "+c"(Count) : "a"(Value) : "memory");
+}
+
+static void RepStosdDown(void *Dest, uint32_t Value, size_t Count) {
+  __asm volatile("std; rep stosl; cld" : "+D"(Dest), "+c"(Count) : "a"(Value) : "memory");
+}
+
+// Returns the remaining count
+static size_t RepeCmpsb(const void *Src1, const void *Src2, size_t Count) {
+  __asm volatile("repe cmpsb" : "+S"(Src1), "+D"(Src2), "+c"(Count) :: "memory", "cc");
+  return Count;
+}
+
+static size_t RepneCmpsb(const void *Src1, const void *Src2, size_t Count) {
+  __asm volatile("repne cmpsb" : "+S"(Src1), "+D"(Src2), "+c"(Count) :: "memory", "cc");
+  return Count;
+}
+
+TEST_CASE("rep movsb: large and overlapping copies") {
+  constexpr size_t Size = 3 * 4096 + 123;
+  static uint8_t Src[Size + 64];
+  static uint8_t Dest[Size + 64];
+
+  for (size_t i = 0; i < sizeof(Src); ++i) {
+    Src[i] = i * 7;
+  }
+
+  RepMovsb(Dest, Src, Size);
+  CHECK(memcmp(Dest, Src, Size) == 0);
+  CHECK(Dest[Size] == 0);
+
+  // Copying upwards with the destination one byte ahead replicates the first byte
+  memset(Dest, 0, sizeof(Dest));
+  Dest[0] = 0x5A;
+  RepMovsb(Dest + 1, Dest, Size);
+  for (size_t i = 0; i <= Size; ++i) {
+    REQUIRE(Dest[i] == 0x5A);
+  }
+  CHECK(Dest[Size + 1] == 0);
+
+  // Copying downwards with the destination one byte behind replicates the last byte
+  memset(Dest, 0, sizeof(Dest));
+  Dest[Size] = 0xA5;
+  RepMovsbDown(Dest + Size - 1, Dest + Size, Size);
+  for (size_t i = 0; i <= Size; ++i) {
+    REQUIRE(Dest[i] == 0xA5);
+  }
+
+  // Downwards walk without overlap
+  memset(Dest, 0, sizeof(Dest));
+  RepMovsbDown(Dest + Size - 1, Src + Size - 1, Size);
+  CHECK(memcmp(Dest, Src, Size) == 0);
+}
+
+TEST_CASE("rep stos: both directions") {
+  constexpr size_t Count = 3000;
+  static uint64_t Buffer[Count + 2];
+
+  RepStosq(&Buffer[1], 0x0102030405060708ULL, Count);
+  CHECK(Buffer[0] == 0);
+  CHECK(Buffer[1] == 0x0102030405060708ULL);
+  CHECK(Buffer[Count] == 0x0102030405060708ULL);
+  CHECK(Buffer[Count + 1] == 0);
+
+  static uint32_t Buffer32[Count + 2];
+  RepStosdDown(&Buffer32[Count], 0x11223344, Count);
+  CHECK(Buffer32[0] == 0);
+  CHECK(Buffer32[1] == 0x11223344);
+  CHECK(Buffer32[Count] == 0x11223344);
+  CHECK(Buffer32[Count + 1] == 0);
+}
+
+TEST_CASE("repe/repne cmpsb: stops at the right element") {
+  constexpr size_t Size = 10000;
+  static uint8_t A[Size];
+  static uint8_t B[Size];
+
+  CHECK(RepeCmpsb(A, B, Size) == 0);
+
+  // Past a chunk and in the middle of a 16 byte block
+  B[6007] = 1;
+  CHECK(RepeCmpsb(A, B, Size) == Size - 6008);
+
+  // repne stops at the first equal pair
+  memset(A, 1, Size);
+  CHECK(RepneCmpsb(A, B, Size) == Size - 6008);
+}
+
+TEST_CASE("repe cmpsb: mismatch right before an unmapped page") {
+  // The compare stops at the mismatch, the bytes after it are never touched
+  auto A = static_cast<uint8_t*>(mmap(nullptr, 2 * 4096, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+  auto B = static_cast<uint8_t*>(mmap(nullptr, 2 * 4096, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+  REQUIRE(A != MAP_FAILED);
+  REQUIRE(B != MAP_FAILED);
+  REQUIRE(mprotect(A + 4096, 4096, PROT_NONE) == 0);
+  REQUIRE(mprotect(B + 4096, 4096, PROT_NONE) == 0);
+
+  // Last byte of both pages
+  B[4095] = 1;
+  CHECK(RepeCmpsb(A + 4096 - 20, B + 4096 - 20, 100) == 100 - 20);
+
+  // Only the second side ends up next to the guard page, the first side stays in the middle of its page
+  B[4095] = 0;
+  B[4090] = 1;
+  CHECK(RepeCmpsb(A + 1000, B + 4096 - 40, 200) == 200 - 35);
+
+  munmap(A, 2 * 4096);
+  munmap(B, 2 * 4096);
+}
+
+static uint8_t *FaultPage;
+static int Faults;
+static bool ConsistentAtFault;
+
+static uint8_t *FaultSrc;
+static uint8_t *FaultDest;
+static size_t FaultCount;
+
+static void FaultHandler(int, siginfo_t *si, void *context) {
+  auto uctx = reinterpret_cast<ucontext_t*>(context);
+  auto RCX = static_cast<uint64_t>(uctx->uc_mcontext.gregs[REG_RCX]);
+  auto RSI = reinterpret_cast<uint8_t*>(uctx->uc_mcontext.gregs[REG_RSI]);
+  auto RDI = reinterpret_cast<uint8_t*>(uctx->uc_mcontext.gregs[REG_RDI]);
+
+  // Everything below RDI is done and the registers agree on how far the copy got
+  const size_t Done = FaultCount - RCX;
+  ConsistentAtFault = RSI == FaultSrc + Done && RDI == FaultDest + Done &&
+                      RDI <= reinterpret_cast<uint8_t*>(si->si_addr) &&
+                      memcmp(FaultDest, FaultSrc, Done) == 0;
+
+  ++Faults;
+  mprotect(FaultPage, 4096, PROT_READ | PROT_WRITE);
+}
+
+TEST_CASE("rep movsb: fault in the middle of a copy") {
+  constexpr size_t Pages = 4;
+  auto Src = static_cast<uint8_t*>(mmap(nullptr, Pages * 4096, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+  auto Dest = static_cast<uint8_t*>(mmap(nullptr, Pages * 4096, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+  REQUIRE(Src != MAP_FAILED);
+  REQUIRE(Dest != MAP_FAILED);
+
+  for (size_t i = 0; i < Pages * 4096; ++i) {
+    Src[i] = i * 13;
+  }
+
+  // The third destination page faults once
+  FaultPage = Dest + 2 * 4096;
+  REQUIRE(mprotect(FaultPage, 4096, PROT_READ) == 0);
+
+  struct sigaction act{}, oldact{};
+  act.sa_sigaction = FaultHandler;
+  act.sa_flags = SA_SIGINFO;
+  sigaction(SIGSEGV, &act, &oldact);
+
+  // Start off page alignment so the fault isn't on a chunk boundary
+  FaultSrc = Src + 100;
+  FaultDest = Dest + 100;
+  FaultCount = Pages * 4096 - 200;
+  RepMovsb(FaultDest, FaultSrc, FaultCount);
+
+  sigaction(SIGSEGV, &oldact, nullptr);
+
+  CHECK(Faults == 1);
+  CHECK(ConsistentAtFault);
+  CHECK(memcmp(FaultDest, FaultSrc, FaultCount) == 0);
+
+  munmap(Src, Pages * 4096);
+  munmap(Dest, Pages * 4096);
+}
+
+template<typename Fn>
+static void Benchmark(const char *Name, size_t Size, Fn &&Op) {
+  // Roughly the same amount of bytes for every size
+  const size_t Iterations = std::max<size_t>(1, (size_t{1} << 30) / Size);
+
+  auto Start = std::chrono::high_resolution_clock::now();
+  for (size_t i = 0; i < Iterations; ++i) {
+    Op();
+  }
+  auto End = std::chrono::high_resolution_clock::now();
+
+  const double Seconds = std::chrono::duration<double>(End - Start).count();
+  printf("%-12s %8zu bytes: %8.2f GB/s\n", Name, Size, static_cast<double>(Iterations * Size) / Seconds / 1e9);
+}
+
+TEST_CASE("rep string ops: throughput", "[.][benchmark]") {
+  constexpr size_t MaxSize = 1024 * 1024;
+  auto A = static_cast<uint8_t*>(mmap(nullptr, MaxSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+  auto B = static_cast<uint8_t*>(mmap(nullptr, MaxSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+  REQUIRE(A != MAP_FAILED);
+  REQUIRE(B != MAP_FAILED);
+  memset(A, 1, MaxSize);
+  memset(B, 1, MaxSize);
+
+  for (size_t Size : {16, 64, 256, 1024, 4096, 65536, 1024 * 1024}) {
+    Benchmark("rep movsb", Size, [&] { RepMovsb(B, A, Size); });
+    Benchmark("rep stosq", Size, [&] { RepStosq(B, 0, Size / 8); });
+    Benchmark("repe cmpsb", Size, [&] { CHECK(RepeCmpsb(A, A, Size) == 0); });
+  }
+
+  munmap(A, MaxSize);
+  munmap(B, MaxSize);
+}
@@ -0,0 +1,209 @@
+/*
+  tests for batched calls in the libGL thunks
+
+  These need an OpenGL driver and are hidden by default. Mesa's software renderer works without a GPU or X server:
+    EGL_PLATFORM=surfaceless LIBGL_ALWAYS_SOFTWARE=1 gl-batching.64 "[gl]"
+
+  The [benchmark] test reports call throughput, compare against a run with FEX_THUNKS_NO_BATCHING=1 to see the effect of batching.
+*/
+
+#include <catch2/catch.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <dlfcn.h>
+#include <type_traits>
+
+namespace {
+// Subset of EGL/egl.h and GL/gl.h, looked up at runtime so the test builds without GL development files
+using EGLDisplay = void*;
+using EGLConfig = void*;
+using EGLContext = void*;
+using EGLint = int32_t;
+using GLenum = unsigned int;
+
+constexpr EGLint EGL_NONE = 0x3038;
+constexpr EGLint EGL_SURFACE_TYPE = 0x3033;
+constexpr EGLint EGL_PBUFFER_BIT = 0x0001;
+constexpr EGLint EGL_RENDERABLE_TYPE = 0x3040;
+constexpr EGLint EGL_OPENGL_BIT = 0x0008;
+constexpr unsigned EGL_OPENGL_API = 0x30A2;
+
+constexpr GLenum GL_BLEND = 0x0BE2;
+constexpr GLenum GL_COLOR_CLEAR_VALUE = 0x0C22;
+
+struct GLFunctions {
+  void (*ClearColor)(float, float, float, float);
+  void (*Enable)(GLenum);
+  void (*Disable)(GLenum);
+  void (*Color4f)(float, float, float, float);
+  unsigned char (*IsEnabled)(GLenum);
+  void (*GetFloatv)(GLenum, float*);
+  void (*Finish)();
+};
+
+template<typename Fn>
+void Lookup(Fn &Target, void *Handle, const char *Name) {
+  Target = reinterpret_cast<Fn>(dlsym(Handle, Name));
+  REQUIRE(Target);
+}
+
+// Functions exported from libGL are called through the direct thunks
+GLFunctions DirectFunctions(void *LibGL) {
+  GLFunctions Fn;
+  Lookup(Fn.ClearColor, LibGL, "glClearColor");
+  Lookup(Fn.Enable, LibGL, "glEnable");
+  Lookup(Fn.Disable, LibGL, "glDisable");
+  Lookup(Fn.Color4f, LibGL, "glColor4f");
+  Lookup(Fn.IsEnabled, LibGL, "glIsEnabled");
+  Lookup(Fn.GetFloatv, LibGL, "glGetFloatv");
+  Lookup(Fn.Finish, LibGL, "glFinish");
+  return Fn;
+}
+
+// Functions returned by glXGetProcAddress are called through the signature-based indirect thunks
+GLFunctions ProcAddressFunctions(void *LibGL) {
+  using GetProcAddressFn = void *(*)(const unsigned char*);
+  GetProcAddressFn GetProcAddress;
+  Lookup(GetProcAddress, LibGL, "glXGetProcAddress");
+
+  auto Get = [&](auto &Target, const char *Name) {
+    Target = reinterpret_cast<std::remove_reference_t<decltype(Target)>>(GetProcAddress(reinterpret_cast<const unsigned char*>(Name)));
+    REQUIRE(Target);
+  };
+
+  GLFunctions Fn;
+  Get(Fn.ClearColor, "glClearColor");
+  Get(Fn.Enable, "glEnable");
+  Get(Fn.Disable, "glDisable");
+  Get(Fn.Color4f, "glColor4f");
+  Get(Fn.IsEnabled, "glIsEnabled");
+  Get(Fn.GetFloatv, "glGetFloatv");
+  Get(Fn.Finish, "glFinish");
+  return Fn;
+}
+
+// Makes a legacy OpenGL context current without any window system surface
+void *CreateContext() {
+  auto LibGL = dlopen("libGL.so.1", RTLD_NOW | RTLD_GLOBAL);
+  auto LibEGL = dlopen("libEGL.so.1", RTLD_NOW | RTLD_GLOBAL);
+  REQUIRE(LibGL);
+  REQUIRE(LibEGL);
+
+  EGLDisplay (*GetDisplay)(void*);
+  unsigned (*Initialize)(EGLDisplay, EGLint*, EGLint*);
+  unsigned (*BindAPI)(unsigned);
+  unsigned (*ChooseConfig)(EGLDisplay, const EGLint*, EGLConfig*, EGLint, EGLint*);
+  EGLContext (*CreateContext)(EGLDisplay, EGLConfig, EGLContext, const EGLint*);
+  unsigned (*MakeCurrent)(EGLDisplay, void*, void*, EGLContext);
+  Lookup(GetDisplay, LibEGL, "eglGetDisplay");
+  Lookup(Initialize, LibEGL, "eglInitialize");
+  Lookup(BindAPI, LibEGL, "eglBindAPI");
+  Lookup(ChooseConfig, LibEGL, "eglChooseConfig");
+  Lookup(CreateContext, LibEGL, "eglCreateContext");
+  Lookup(MakeCurrent, LibEGL, "eglMakeCurrent");
+
+  auto Display = GetDisplay(nullptr);
+  REQUIRE(Display);
+  REQUIRE(Initialize(Display, nullptr, nullptr));
+  REQUIRE(BindAPI(EGL_OPENGL_API));
+
+  const EGLint ConfigAttribs[] = {
+    EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+    EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+    EGL_NONE,
+  };
+  EGLConfig Config;
+  EGLint NumConfigs = 0;
+  REQUIRE(ChooseConfig(Display, ConfigAttribs, &Config, 1, &NumConfigs));
+  REQUIRE(NumConfigs == 1);
+
+  auto Context = CreateContext(Display, Config, nullptr, nullptr);
+  REQUIRE(Context);
+  REQUIRE(MakeCurrent(Display, nullptr, nullptr, Context));
+  return LibGL;
+}
+
+void CheckState(const GLFunctions &Fn) {
+  // Recorded calls must be executed before any call that returns data
+  Fn.ClearColor(0.25f, 0.5f, 0.75f, 1.0f);
+  float Color[4] {};
+  Fn.GetFloatv(GL_COLOR_CLEAR_VALUE, Color);
+  CHECK(Color[0] == 0.25f);
+  CHECK(Color[1] == 0.5f);
+  CHECK(Color[2] == 0.75f);
+  CHECK(Color[3] == 1.0f);
+
+  // Order is preserved, including across multiple flushes of a full batch
+  for (int i = 0; i < 100000; ++i) {
+    Fn.Enable(GL_BLEND);
+    Fn.Disable(GL_BLEND);
+  }
+  CHECK(!Fn.IsEnabled(GL_BLEND));
+  Fn.Enable(GL_BLEND);
+  CHECK(Fn.IsEnabled(GL_BLEND));
+  Fn.Disable(GL_BLEND);
+}
+}
+
+TEST_CASE("GL batching: state", "[.][gl]") {
+  auto LibGL = CreateContext();
+
+  SECTION("Direct calls") {
+    CheckState(DirectFunctions(LibGL));
+  }
+
+  SECTION("glXGetProcAddress") {
+    CheckState(ProcAddressFunctions(LibGL));
+  }
+
+  SECTION("Mixed") {
+    // Both paths share the same batch
+    auto Direct = DirectFunctions(LibGL);
+    auto Indirect = ProcAddressFunctions(LibGL);
+    Direct.Enable(GL_BLEND);
+    Indirect.Disable(GL_BLEND);
+    Direct.Enable(GL_BLEND);
+    CHECK(Indirect.IsEnabled(GL_BLEND));
+    Indirect.Disable(GL_BLEND);
+    CHECK(!Direct.IsEnabled(GL_BLEND));
+  }
+}
+
+TEST_CASE("GL batching: call throughput", "[.][gl][benchmark]") {
+  auto LibGL = CreateContext();
+  constexpr int Iterations = 1000000;
+
+  auto Measure = [](const GLFunctions &Fn, auto &&Body) {
+    Fn.Finish();
+    auto Begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < Iterations; ++i) {
+      Body(i);
+    }
+    // Include the time it takes for the calls to execute on the host
+    Fn.Finish();
+    std::chrono::duration<double> Time = std::chrono::steady_clock::now() - Begin;
+    return Iterations / Time.count() / 1e6;
+  };
+
+  printf("%-20s %16s %16s\n", "call", "direct Mcalls/s", "getproc Mcalls/s");
+  auto Report = [&](const char *Name, auto &&Body) {
+    auto Direct = DirectFunctions(LibGL);
+    auto Indirect = ProcAddressFunctions(LibGL);
+    printf("%-20s %16.2f %16.2f\n", Name,
+      Measure(Direct, [&](int i) { Body(Direct, i); }),
+      Measure(Indirect, [&](int i) { Body(Indirect, i); }));
+  };
+
+  Report("glColor4f", [](const GLFunctions &Fn, int i) {
+    Fn.Color4f(i * 1e-6f, 0.5f, 0.5f, 1.0f);
+  });
+  Report("glEnable/glDisable", [](const GLFunctions &Fn, int i) {
+    (i & 1 ? Fn.Disable : Fn.Enable)(GL_BLEND);
+  });
+  // Returns a value, so this is never batched
+  Report("glIsEnabled", [](const GLFunctions &Fn, int) {
+    Fn.IsEnabled(GL_BLEND);
+  });
+}
@@ -0,0 +1,200 @@
+/*
+  accuracy tests for the libm thunks
+
+  The thunked functions are compared against the guest libm.
+  The tests load libm-guest.so themselves and fail if its host side isn't loaded.
+  That needs FEX with the libm thunk configured, so they are hidden by default:
+    LD_LIBRARY_PATH=<guest thunks directory> libm-thunks.64 "[thunks]"
+*/
+
+#include <catch2/catch.hpp>
+
+#include <cerrno>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <dlfcn.h>
+#include <iterator>
+#include <limits>
+#include <vector>
+
+#include "thunk_util.h"
+
+namespace {
+// Always the guest libm implementations
+void *GuestLibm() {
+  static void *Handle = dlopen("libm.so.6", RTLD_NOW | RTLD_NOLOAD);
+  return Handle;
+}
+
+// The thunk library rather than whatever the process resolved
+void *ThunkLibm() {
+  static void *Handle = LoadThunkLibrary("libm-guest.so", "libm");
+  return Handle;
+}
+
+// Guest and thunked implementation of {Name}
+template<typename Fn>
+std::pair<Fn, Fn> Lookup(const char *Name) {
+  auto Thunked = reinterpret_cast<Fn>(dlsym(ThunkLibm(), Name));
+  INFO(Name);
+  REQUIRE(Thunked);
+  RequireFromThunkLibrary(reinterpret_cast<const void*>(Thunked), "libm-guest.so");
+
+  return {
+    reinterpret_cast<Fn>(dlsym(GuestLibm(), Name)),
+    Thunked,
+  };
+}
+
+// Distance in representable values, 0 if both are the same NaN/inf class
+template<typename T>
+uint64_t ULPDistance(T a, T b) {
+  if (std::isnan(a) || std::isnan(b)) {
+    return std::isnan(a) && std::isnan(b) ? 0 : UINT64_MAX;
+  }
+
+  using Int = std::conditional_t<sizeof(T) == 8, int64_t, int32_t>;
+  Int ia, ib;
+  memcpy(&ia, &a, sizeof(T));
+  memcpy(&ib, &b, sizeof(T));
+
+  // Map sign-magnitude to a monotonic integer line
+  auto Ordered = [](Int i) -> int64_t {
+    return i < 0 ? static_cast<int64_t>(std::numeric_limits<Int>::min()) - i : i;
+  };
+  auto Diff = Ordered(ia) - Ordered(ib);
+  return Diff < 0 ? -Diff : Diff;
+}
+
+template<typename T>
+std::vector<T> Inputs(T Min, T Max) {
+  std::vector<T> Values {
+    T(0), -T(0), T(1), T(-1), T(0.5), T(2),
+    std::numeric_limits<T>::infinity(), -std::numeric_limits<T>::infinity(),
+    std::numeric_limits<T>::quiet_NaN(),
+    std::numeric_limits<T>::denorm_min(), std::numeric_limits<T>::min(), std::numeric_limits<T>::max(),
+  };
+
+  // Linear sweep plus an exponential sweep to cover large and tiny magnitudes
+  constexpr int Steps = 20000;
+  for (int i = 0; i <= Steps; ++i) {
+    Values.push_back(Min + (Max - Min) * T(i) / T(Steps));
+  }
+  for (int e = std::numeric_limits<T>::min_exponent; e < std::numeric_limits<T>::max_exponent; ++e) {
+    Values.push_back(std::ldexp(T(1.37), e));
+    Values.push_back(-std::ldexp(T(1.37), e));
+  }
+  return Values;
+}
+
+template<typename T>
+struct Result {
+  T Value;
+  int Errno;
+};
+
+template<typename Fn, typename... Args>
+auto Call(Fn F, Args... args) {
+  errno = 0;
+  auto Value = F(args...);
+  return Result<decltype(Value)> {Value, errno};
+}
+
+template<typename T>
+void Compare(const char *Name, T Input, Result<T> Guest, Result<T> Thunked, uint64_t &MaxULP) {
+  auto ULP = ULPDistance(Guest.Value, Thunked.Value);
+  MaxULP = std::max(MaxULP, ULP);
+
+  INFO(Name << "(" << Input << "): guest " << Guest.Value << " thunked " << Thunked.Value);
+  // Glibc doesn't promise correct rounding, allow a different host implementation to be off by one
+  CHECK(ULP <= 1);
+
+  // Whether underflow to a subnormal sets errno is implementation-defined
+  if (std::fpclassify(Guest.Value) != FP_SUBNORMAL) {
+    CHECK(Guest.Errno == Thunked.Errno);
+  }
+}
+
+template<typename T>
+void TestUnary(const char *Name, T Min, T Max) {
+  auto [Guest, Thunked] = Lookup<T(*)(T)>(Name);
+  REQUIRE(Guest);
+  REQUIRE(Thunked);
+
+  uint64_t MaxULP {};
+  for (auto x : Inputs<T>(Min, Max)) {
+    Compare(Name, x, Call(Guest, x), Call(Thunked, x), MaxULP);
+  }
+  printf("%-8s max ulp %llu\n", Name, static_cast<unsigned long long>(MaxULP));
+}
+
+template<typename T>
+void TestBinary(const char *Name, T Min, T Max, T Second[], size_t NumSecond) {
+  auto [Guest, Thunked] = Lookup<T(*)(T, T)>(Name);
+  REQUIRE(Guest);
+  REQUIRE(Thunked);
+
+  uint64_t MaxULP {};
+  for (auto x : Inputs<T>(Min, Max)) {
+    for (size_t i = 0; i < NumSecond; ++i) {
+      auto y = Second[i];
+      Compare(Name, x, Call(Guest, x, y), Call(Thunked, x, y), MaxULP);
+    }
+  }
+  printf("%-8s max ulp %llu\n", Name, static_cast<unsigned long long>(MaxULP));
+}
+}
+
+TEST_CASE("libm thunks: double", "[.][thunks]") {
+  TestUnary<double>("sin", -100.0, 100.0);
+  TestUnary<double>("cos", -100.0, 100.0);
+  TestUnary<double>("tan", -100.0, 100.0);
+  TestUnary<double>("exp", -750.0, 710.0);
+  TestUnary<double>("exp2", -1080.0, 1030.0);
+  TestUnary<double>("log", -1.0, 1000.0);
+  TestUnary<double>("log2", -1.0, 1000.0);
+  TestUnary<double>("log10", -1.0, 1000.0);
+
+  double Second[] = {-2.5, -1.0, -0.0, 0.5, 1.0, 3.0, 1e10, std::numeric_limits<double>::infinity()};
+  TestBinary<double>("pow", -10.0, 10.0, Second, std::size(Second));
+  TestBinary<double>("atan2", -10.0, 10.0, Second, std::size(Second));
+}
+
+TEST_CASE("libm thunks: float", "[.][thunks]") {
+  TestUnary<float>("sinf", -100.0f, 100.0f);
+  TestUnary<float>("cosf", -100.0f, 100.0f);
+  TestUnary<float>("tanf", -100.0f, 100.0f);
+  TestUnary<float>("expf", -110.0f, 90.0f);
+  TestUnary<float>("exp2f", -155.0f, 130.0f);
+  TestUnary<float>("logf", -1.0f, 1000.0f);
+  TestUnary<float>("log2f", -1.0f, 1000.0f);
+  TestUnary<float>("log10f", -1.0f, 1000.0f);
+
+  float Second[] = {-2.5f, -1.0f, -0.0f, 0.5f, 1.0f, 3.0f, 1e10f, std::numeric_limits<float>::infinity()};
+  TestBinary<float>("powf", -10.0f, 10.0f, Second, std::size(Second));
+  TestBinary<float>("atan2f", -10.0f, 10.0f, Second, std::size(Second));
+}
+
+TEST_CASE("libm thunks: sincos", "[.][thunks]") {
+  using SincosFn = void(*)(double, double*, double*);
+  auto [Guest, Thunked] = Lookup<SincosFn>("sincos");
+  REQUIRE(Guest);
+  REQUIRE(Thunked);
+
+  uint64_t MaxULP {};
+  for (auto x : Inputs<double>(-100.0, 100.0)) {
+    double GuestSin, GuestCos, ThunkedSin, ThunkedCos;
+    errno = 0;
+    Guest(x, &GuestSin, &GuestCos);
+    int GuestErrno = errno;
+    errno = 0;
+    Thunked(x, &ThunkedSin, &ThunkedCos);
+    int ThunkedErrno = errno;
+
+    Compare("sincos.sin", x, Result<double>{GuestSin, GuestErrno}, Result<double>{ThunkedSin, ThunkedErrno}, MaxULP);
+    Compare("sincos.cos", x, Result<double>{GuestCos, GuestErrno}, Result<double>{ThunkedCos, ThunkedErrno}, MaxULP);
+  }
+  printf("%-8s max ulp %llu\n", "sincos", static_cast<unsigned long long>(MaxULP));
+}
@@ -0,0 +1,227 @@
+/*
+  tests for the libc string thunks
+
+  The tests load libc-guest.so themselves and fail if its host side isn't loaded.
+  That needs FEX with the libc thunk configured, so they are hidden by default:
+    LD_LIBRARY_PATH=<guest thunks directory> string-thunks.64 "[thunks]"
+
+  The hidden [benchmark] test compares the throughput of the guest libc against the thunked functions.
+*/
+
+#include <catch2/catch.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <dlfcn.h>
+#include <vector>
+
+#include "thunk_util.h"
+
+namespace {
+using MemcpyFn = void *(*)(void *, const void *, size_t);
+using MemsetFn = void *(*)(void *, int, size_t);
+using MemcmpFn = int (*)(const void *, const void *, size_t);
+using StrlenFn = size_t (*)(const char *);
+using StrchrFn = char *(*)(const char *, int);
+
+struct StringFunctions {
+  MemcpyFn memcpy;
+  MemcpyFn memmove;
+  MemsetFn memset;
+  MemcmpFn memcmp;
+  StrlenFn strlen;
+  StrchrFn strchr;
+};
+
+// Looked up at runtime so the compiler can't replace the calls with inline code
+StringFunctions Lookup(void *Handle) {
+  return StringFunctions {
+    reinterpret_cast<MemcpyFn>(dlsym(Handle, "memcpy")),
+    reinterpret_cast<MemcpyFn>(dlsym(Handle, "memmove")),
+    reinterpret_cast<MemsetFn>(dlsym(Handle, "memset")),
+    reinterpret_cast<MemcmpFn>(dlsym(Handle, "memcmp")),
+    reinterpret_cast<StrlenFn>(dlsym(Handle, "strlen")),
+    reinterpret_cast<StrchrFn>(dlsym(Handle, "strchr")),
+  };
+}
+
+// The thunked functions, from the thunk library rather than whatever the process resolved
+StringFunctions Thunked() {
+  static void *Handle = LoadThunkLibrary("libc-guest.so", "libc");
+  auto Fn = Lookup(Handle);
+  RequireFromThunkLibrary(reinterpret_cast<const void*>(Fn.memcpy), "libc-guest.so");
+  RequireFromThunkLibrary(reinterpret_cast<const void*>(Fn.memmove), "libc-guest.so");
+  RequireFromThunkLibrary(reinterpret_cast<const void*>(Fn.memset), "libc-guest.so");
+  RequireFromThunkLibrary(reinterpret_cast<const void*>(Fn.memcmp), "libc-guest.so");
+  RequireFromThunkLibrary(reinterpret_cast<const void*>(Fn.strlen), "libc-guest.so");
+  RequireFromThunkLibrary(reinterpret_cast<const void*>(Fn.strchr), "libc-guest.so");
+  return Fn;
+}
+
+// Always the guest libc implementations
+StringFunctions GuestLibc() {
+  return Lookup(dlopen("libc.so.6", RTLD_NOW | RTLD_NOLOAD));
+}
+
+const size_t Sizes[] = {0, 1, 7, 63, 64, 65, 255, 256, 257, 4096, 65536 + 3};
+const size_t Offsets[] = {0, 1, 3};
+
+void Fill(std::vector<uint8_t> &Buffer, uint8_t Seed) {
+  for (size_t i = 0; i < Buffer.size(); ++i) {
+    Buffer[i] = static_cast<uint8_t>(i * 31 + Seed) | 1;
+  }
+}
+}
+
+TEST_CASE("string thunks: memcpy", "[.][thunks]") {
+  auto Fn = Thunked();
+  for (auto Size : Sizes) {
+    for (auto Offset : Offsets) {
+      std::vector<uint8_t> Src(Size + 8), Dest(Size + 8, 0);
+      Fill(Src, 5);
+
+      CHECK(Fn.memcpy(Dest.data() + Offset, Src.data() + 1, Size) == Dest.data() + Offset);
+      for (size_t i = 0; i < Size; ++i) {
+        REQUIRE(Dest[Offset + i] == Src[1 + i]);
+      }
+      // Nothing past the end was written
+      CHECK(Dest[Offset + Size] == 0);
+    }
+  }
+}
+
+TEST_CASE("string thunks: memmove", "[.][thunks]") {
+  auto Fn = Thunked();
+  for (auto Size : Sizes) {
+    for (auto Offset : Offsets) {
+      std::vector<uint8_t> Buffer(Size + 8), Expected;
+
+      // Forward overlap
+      Fill(Buffer, 7);
+      Expected = Buffer;
+      for (size_t i = 0; i < Size; ++i) {
+        Expected[i] = Buffer[i + Offset];
+      }
+      Fn.memmove(Buffer.data(), Buffer.data() + Offset, Size);
+      REQUIRE(Buffer == Expected);
+
+      // Backward overlap
+      Fill(Buffer, 9);
+      Expected = Buffer;
+      for (size_t i = Size; i != 0; --i) {
+        Expected[i - 1 + Offset] = Buffer[i - 1];
+      }
+      Fn.memmove(Buffer.data() + Offset, Buffer.data(), Size);
+      REQUIRE(Buffer == Expected);
+    }
+  }
+}
+
+TEST_CASE("string thunks: memset", "[.][thunks]") {
+  auto Fn = Thunked();
+  for (auto Size : Sizes) {
+    for (auto Offset : Offsets) {
+      std::vector<uint8_t> Buffer(Size + 8, 0);
+
+      CHECK(Fn.memset(Buffer.data() + Offset, 0x1A5, Size) == Buffer.data() + Offset);
+      for (size_t i = 0; i < Buffer.size(); ++i) {
+        const bool Inside = i >= Offset && i < Offset + Size;
+        REQUIRE(Buffer[i] == (Inside ? 0xA5 : 0));
+      }
+    }
+  }
+}
+
+TEST_CASE("string thunks: memcmp", "[.][thunks]") {
+  auto Fn = Thunked();
+  for (auto Size : Sizes) {
+    for (auto Offset : Offsets) {
+      std::vector<uint8_t> A(Size + 8), B(Size + 8);
+      Fill(A, 3);
+      Fill(B, 3);
+
+      CHECK(Fn.memcmp(A.data() + Offset, B.data() + Offset, Size) == 0);
+
+      if (Size) {
+        // Bytes compare as unsigned
+        B[Offset + Size - 1] = 0x80;
+        A[Offset + Size - 1] = 0x7F;
+        CHECK(Fn.memcmp(A.data() + Offset, B.data() + Offset, Size) < 0);
+        CHECK(Fn.memcmp(B.data() + Offset, A.data() + Offset, Size) > 0);
+      }
+    }
+  }
+}
+
+TEST_CASE("string thunks: strlen and strchr", "[.][thunks]") {
+  auto Fn = Thunked();
+  for (auto Size : Sizes) {
+    for (auto Offset : Offsets) {
+      std::vector<char> String(Offset + Size + 1, 'a');
+      String[Offset + Size] = '\0';
+      auto Str = String.data() + Offset;
+
+      CHECK(Fn.strlen(Str) == Size);
+
+      // Terminator is part of the string
+      CHECK(Fn.strchr(Str, '\0') == Str + Size);
+      CHECK(Fn.strchr(Str, 'b') == nullptr);
+
+      if (Size) {
+        Str[Size - 1] = 'b';
+        // Only the low byte of the character is used
+        CHECK(Fn.strchr(Str, 'b' | 0x100) == Str + Size - 1);
+      }
+    }
+  }
+}
+
+TEST_CASE("string thunks: throughput", "[.][benchmark]") {
+  const auto Guest = GuestLibc();
+  const auto Thunks = Thunked();
+  const size_t BenchSizes[] = {16, 256, 4096, 65536, 1 << 20};
+  // Enough work per size to get past timer resolution
+  constexpr size_t BytesPerRun = 256 << 20;
+
+  auto Measure = [](auto &&Fn, size_t Size) {
+    const size_t Iterations = BytesPerRun / Size;
+    auto Begin = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < Iterations; ++i) {
+      Fn();
+    }
+    std::chrono::duration<double> Time = std::chrono::steady_clock::now() - Begin;
+    return static_cast<double>(Iterations * Size) / Time.count() / (1 << 20);
+  };
+
+  printf("%-8s %10s %14s %14s\n", "function", "size", "guest MiB/s", "thunked MiB/s");
+  for (auto Size : BenchSizes) {
+    std::vector<char> Src(Size + 1, 'a'), Dest(Size + 1), Copy;
+    Src[Size] = '\0';
+    Copy = Src;
+
+    auto Report = [&](const char *Name, auto &&GuestFn, auto &&ThunkedFn) {
+      printf("%-8s %10zu %14.1f %14.1f\n", Name, Size, Measure(GuestFn, Size), Measure(ThunkedFn, Size));
+    };
+
+    Report("memcpy",
+      [&] { Guest.memcpy(Dest.data(), Src.data(), Size); },
+      [&] { Thunks.memcpy(Dest.data(), Src.data(), Size); });
+    Report("memmove",
+      [&] { Guest.memmove(Dest.data() + 1, Dest.data(), Size - 1); },
+      [&] { Thunks.memmove(Dest.data() + 1, Dest.data(), Size - 1); });
+    Report("memset",
+      [&] { Guest.memset(Dest.data(), 0, Size); },
+      [&] { Thunks.memset(Dest.data(), 0, Size); });
+    Report("memcmp",
+      [&] { Guest.memcmp(Copy.data(), Src.data(), Size); },
+      [&] { Thunks.memcmp(Copy.data(), Src.data(), Size); });
+    Report("strlen",
+      [&] { Guest.strlen(Src.data()); },
+      [&] { Thunks.strlen(Src.data()); });
+    Report("strchr",
+      [&] { Guest.strchr(Src.data(), 'b'); },
+      [&] { Thunks.strchr(Src.data(), 'b'); });
+  }
+}
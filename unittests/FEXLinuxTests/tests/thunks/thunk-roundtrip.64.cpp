@@ -0,0 +1,56 @@
+/*
+  round-trip cost of a guest -> host thunk call
+
+  This executes OP_THUNK directly, so it only runs under FEX and is hidden by default:
+    thunk-roundtrip.64 "[benchmark]"
+
+  fex:is_lib_loaded is used since it is always registered and does almost no work on the host,
+  so the measured time is dominated by the transition itself.
+*/
+
+#include <catch2/catch.hpp>
+
+#include <chrono>
+#include <cstdio>
+
+#include "thunk_util.h"
+
+namespace {
+struct IsLibLoadedArgs {
+  const char *Name;
+  bool rv;
+};
+
+// Same argument passing as the thunk, kept out of line to have a plain call as the baseline
+__attribute__((noinline)) int GuestIsLibLoaded(void *args) {
+  auto Args = reinterpret_cast<IsLibLoadedArgs*>(args);
+  asm volatile("" ::: "memory");
+  Args->rv = false;
+  return 0;
+}
+
+template<typename Fn>
+double Measure(Fn &&Call, size_t Iterations) {
+  IsLibLoadedArgs Args { "libthunk-roundtrip-not-a-lib" };
+  auto Begin = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < Iterations; ++i) {
+    Call(&Args);
+  }
+  std::chrono::duration<double, std::nano> Time = std::chrono::steady_clock::now() - Begin;
+  return Time.count() / Iterations;
+}
+}
+
+TEST_CASE("thunk round-trip", "[.][benchmark]") {
+  IsLibLoadedArgs Args { "libthunk-roundtrip-not-a-lib", true };
+  fexthunks_fex_is_lib_loaded(&Args);
+  REQUIRE(!Args.rv);
+
+  constexpr size_t Iterations = 10000000;
+  // Warm up the code cache so block compilation isn't part of the measurement
+  Measure(fexthunks_fex_is_lib_loaded, Iterations / 100);
+
+  printf("%-12s %10s\n", "call", "ns/call");
+  printf("%-12s %10.2f\n", "guest", Measure(GuestIsLibLoaded, Iterations));
+  printf("%-12s %10.2f\n", "thunk", Measure(fexthunks_fex_is_lib_loaded, Iterations));
+}
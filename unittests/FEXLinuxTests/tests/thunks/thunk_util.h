@@ -0,0 +1,45 @@
+#include <catch2/catch.hpp>
+
+#include <cstring>
+#include <dlfcn.h>
+
+// fex:is_lib_loaded is always registered, it reports if the host side of a thunk library was loaded.
+// This executes OP_THUNK directly, so it only works under FEX
+#if __SIZEOF_POINTER__ == 8
+extern "C" __attribute__((visibility("hidden"))) int fexthunks_fex_is_lib_loaded(void *args);
+#else
+extern "C" __attribute__((visibility("hidden"))) [[gnu::fastcall]] int fexthunks_fex_is_lib_loaded(void *args);
+#endif
+asm(".text\nfexthunks_fex_is_lib_loaded:\n.byte 0xF, 0x3F\n.byte "
+    "0xee, 0x57, 0xba, 0x0c, 0x5f, 0x6e, 0xef, 0x2a, 0x8c, 0xb5, 0x19, 0x81, 0xc9, 0x23, 0xe6, 0x51, "
+    "0xae, 0x65, 0x02, 0x8f, 0x2b, 0x5d, 0x59, 0x90, 0x6a, 0x7e, 0xe2, 0xe7, 0x1c, 0x33, 0x8a, 0xff\n"
+    ".byte 0");
+
+inline bool IsHostLibLoaded(const char *Name) {
+  struct {
+    const char *Name;
+    bool rv;
+  } Args { Name, false };
+
+  fexthunks_fex_is_lib_loaded(&Args);
+  return Args.rv;
+}
+
+// Loads guest thunk library {GuestLib} and checks that its constructor loaded host library {HostLib}.
+// The guest library is found through LD_LIBRARY_PATH, point it at the guest thunks directory
+inline void *LoadThunkLibrary(const char *GuestLib, const char *HostLib) {
+  void *Handle = dlopen(GuestLib, RTLD_NOW | RTLD_LOCAL);
+  INFO(GuestLib << ": " << (Handle ? "" : dlerror()));
+  REQUIRE(Handle);
+  INFO("host side of " << HostLib << " isn't loaded, check the FEX thunk configuration");
+  REQUIRE(IsHostLibLoaded(HostLib));
+  return Handle;
+}
+
+// Checks that {Fn} was resolved from the thunk library rather than the guest library it replaces
+inline void RequireFromThunkLibrary(const void *Fn, const char *GuestLib) {
+  Dl_info Info {};
+  REQUIRE(dladdr(Fn, &Info));
+  INFO(Info.dli_fname << " isn't " << GuestLib);
+  REQUIRE(strstr(Info.dli_fname, GuestLib) != nullptr);
+}
@@ -0,0 +1,462 @@
+/*
+  tests for recorded command buffers in the libvulkan thunks
+
+  These need a Vulkan driver and are hidden by default. Mesa's lavapipe works without a GPU:
+    VK_ICD_FILENAMES=/usr/share/vulkan/icd.d/lvp_icd.x86_64.json vulkan-recording.64 "[vulkan]"
+
+  The [benchmark] test reports command recording throughput, compare against a run with FEX_THUNKS_NO_BATCHING=1 to see the effect of recording.
+*/
+
+#include <catch2/catch.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <dlfcn.h>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace {
+// Subset of vulkan/vulkan_core.h, looked up at runtime so the test builds without Vulkan development files.
+// Non-dispatchable handles are uint64_t on 32-bit and pointers on 64-bit, both are passed the same way.
+using VkInstance = void*;
+using VkPhysicalDevice = void*;
+using VkDevice = void*;
+using VkQueue = void*;
+using VkCommandBuffer = void*;
+using VkCommandPool = uint64_t;
+using VkBuffer = uint64_t;
+using VkDeviceMemory = uint64_t;
+using VkResult = int32_t;
+using VkDeviceSize = uint64_t;
+using PFN_vkVoidFunction = void (*)();
+
+constexpr VkResult VK_SUCCESS = 0;
+constexpr uint32_t VK_API_VERSION_1_0 = 1 << 22;
+constexpr uint32_t VK_QUEUE_TRANSFER_BITS = 0x1 | 0x2 | 0x4;
+constexpr uint32_t VK_BUFFER_USAGE_TRANSFER_DST_BIT = 0x2;
+constexpr uint32_t VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT = 0x2;
+constexpr uint32_t VK_MEMORY_PROPERTY_HOST_COHERENT_BIT = 0x4;
+constexpr uint32_t VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT = 0x2;
+constexpr uint32_t VK_PIPELINE_STAGE_TRANSFER_BIT = 0x1000;
+constexpr uint32_t VK_ACCESS_TRANSFER_WRITE_BIT = 0x1000;
+constexpr uint32_t VK_STENCIL_FACE_FRONT_AND_BACK = 3;
+
+enum VkStructureType : int32_t {
+  VK_STRUCTURE_TYPE_APPLICATION_INFO = 0,
+  VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO = 1,
+  VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO = 2,
+  VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO = 3,
+  VK_STRUCTURE_TYPE_SUBMIT_INFO = 4,
+  VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO = 5,
+  VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO = 12,
+  VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO = 39,
+  VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO = 40,
+  VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO = 42,
+  VK_STRUCTURE_TYPE_MEMORY_BARRIER = 46,
+};
+
+struct VkApplicationInfo {
+  VkStructureType sType; const void *pNext;
+  const char *pApplicationName; uint32_t applicationVersion;
+  const char *pEngineName; uint32_t engineVersion;
+  uint32_t apiVersion;
+};
+
+struct VkInstanceCreateInfo {
+  VkStructureType sType; const void *pNext; uint32_t flags;
+  const VkApplicationInfo *pApplicationInfo;
+  uint32_t enabledLayerCount; const char *const *ppEnabledLayerNames;
+  uint32_t enabledExtensionCount; const char *const *ppEnabledExtensionNames;
+};
+
+struct VkQueueFamilyProperties {
+  uint32_t queueFlags; uint32_t queueCount; uint32_t timestampValidBits;
+  uint32_t minImageTransferGranularity[3];
+};
+
+struct VkDeviceQueueCreateInfo {
+  VkStructureType sType; const void *pNext; uint32_t flags;
+  uint32_t queueFamilyIndex; uint32_t queueCount; const float *pQueuePriorities;
+};
+
+struct VkDeviceCreateInfo {
+  VkStructureType sType; const void *pNext; uint32_t flags;
+  uint32_t queueCreateInfoCount; const VkDeviceQueueCreateInfo *pQueueCreateInfos;
+  uint32_t enabledLayerCount; const char *const *ppEnabledLayerNames;
+  uint32_t enabledExtensionCount; const char *const *ppEnabledExtensionNames;
+  const void *pEnabledFeatures;
+};
+
+struct VkPhysicalDeviceMemoryProperties {
+  uint32_t memoryTypeCount;
+  struct { uint32_t propertyFlags; uint32_t heapIndex; } memoryTypes[32];
+  uint32_t memoryHeapCount;
+  struct { VkDeviceSize size; uint32_t flags; } memoryHeaps[16];
+};
+
+struct VkBufferCreateInfo {
+  VkStructureType sType; const void *pNext; uint32_t flags;
+  VkDeviceSize size; uint32_t usage; uint32_t sharingMode;
+  uint32_t queueFamilyIndexCount; const uint32_t *pQueueFamilyIndices;
+};
+
+struct VkMemoryRequirements {
+  VkDeviceSize size; VkDeviceSize alignment; uint32_t memoryTypeBits;
+};
+
+struct VkMemoryAllocateInfo {
+  VkStructureType sType; const void *pNext;
+  VkDeviceSize allocationSize; uint32_t memoryTypeIndex;
+};
+
+struct VkCommandPoolCreateInfo {
+  VkStructureType sType; const void *pNext; uint32_t flags; uint32_t queueFamilyIndex;
+};
+
+struct VkCommandBufferAllocateInfo {
+  VkStructureType sType; const void *pNext;
+  VkCommandPool commandPool; uint32_t level; uint32_t commandBufferCount;
+};
+
+struct VkCommandBufferBeginInfo {
+  VkStructureType sType; const void *pNext; uint32_t flags; const void *pInheritanceInfo;
+};
+
+struct VkSubmitInfo {
+  VkStructureType sType; const void *pNext;
+  uint32_t waitSemaphoreCount; const void *pWaitSemaphores; const uint32_t *pWaitDstStageMask;
+  uint32_t commandBufferCount; const VkCommandBuffer *pCommandBuffers;
+  uint32_t signalSemaphoreCount; const void *pSignalSemaphores;
+};
+
+struct VkMemoryBarrier {
+  VkStructureType sType; const void *pNext; uint32_t srcAccessMask; uint32_t dstAccessMask;
+};
+
+struct VkViewport {
+  float x, y, width, height, minDepth, maxDepth;
+};
+
+// Commands used by the tests, either exported from libvulkan or returned by vkGetDeviceProcAddr
+struct CommandFunctions {
+  VkResult (*BeginCommandBuffer)(VkCommandBuffer, const VkCommandBufferBeginInfo*);
+  VkResult (*EndCommandBuffer)(VkCommandBuffer);
+  // Recorded
+  void (*CmdFillBuffer)(VkCommandBuffer, VkBuffer, VkDeviceSize, VkDeviceSize, uint32_t);
+  void (*CmdSetStencilReference)(VkCommandBuffer, uint32_t, uint32_t);
+  // Recorded, data is copied by the guest entrypoint
+  void (*CmdSetViewport)(VkCommandBuffer, uint32_t, uint32_t, const VkViewport*);
+  // Not recorded
+  void (*CmdUpdateBuffer)(VkCommandBuffer, VkBuffer, VkDeviceSize, VkDeviceSize, const void*);
+  void (*CmdPipelineBarrier)(VkCommandBuffer, uint32_t, uint32_t, uint32_t, uint32_t, const VkMemoryBarrier*,
+                             uint32_t, const void*, uint32_t, const void*);
+};
+
+template<typename Fn>
+void Lookup(Fn &Target, void *Handle, const char *Name) {
+  Target = reinterpret_cast<Fn>(dlsym(Handle, Name));
+  REQUIRE(Target);
+}
+
+// Transfer queue and a host visible buffer to check the results of recorded commands
+struct Context {
+  void *LibVulkan;
+  VkDevice Device;
+  VkQueue Queue;
+  uint32_t Family;
+  VkCommandPool Pool;
+  VkBuffer Buffer;
+  uint32_t *Mapped;
+  PFN_vkVoidFunction (*GetDeviceProcAddr)(VkDevice, const char*);
+  VkResult (*CreateCommandPool)(VkDevice, const VkCommandPoolCreateInfo*, const void*, VkCommandPool*);
+  void (*DestroyCommandPool)(VkDevice, VkCommandPool, const void*);
+  VkResult (*AllocateCommandBuffers)(VkDevice, const VkCommandBufferAllocateInfo*, VkCommandBuffer*);
+  void (*FreeCommandBuffers)(VkDevice, VkCommandPool, uint32_t, const VkCommandBuffer*);
+  VkResult (*ResetCommandPool)(VkDevice, VkCommandPool, uint32_t);
+  VkResult (*QueueSubmit)(VkQueue, uint32_t, const VkSubmitInfo*, uint64_t);
+  VkResult (*QueueWaitIdle)(VkQueue);
+
+  static constexpr size_t BufferWords = 16384;
+
+  VkCommandPool CreatePool() {
+    const VkCommandPoolCreateInfo PoolInfo { VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO, nullptr, VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT, Family };
+    VkCommandPool Result {};
+    REQUIRE(CreateCommandPool(Device, &PoolInfo, nullptr, &Result) == VK_SUCCESS);
+    return Result;
+  }
+
+  VkCommandBuffer AllocateCommandBuffer() {
+    return AllocateCommandBuffer(Pool);
+  }
+
+  VkCommandBuffer AllocateCommandBuffer(VkCommandPool Pool) {
+    const VkCommandBufferAllocateInfo AllocateInfo { VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO, nullptr, Pool, 0, 1 };
+    VkCommandBuffer CommandBuffer {};
+    REQUIRE(AllocateCommandBuffers(Device, &AllocateInfo, &CommandBuffer) == VK_SUCCESS);
+    return CommandBuffer;
+  }
+
+  void Submit(const std::vector<VkCommandBuffer> &CommandBuffers) {
+    const VkSubmitInfo SubmitInfo {
+      VK_STRUCTURE_TYPE_SUBMIT_INFO, nullptr, 0, nullptr, nullptr,
+      static_cast<uint32_t>(CommandBuffers.size()), CommandBuffers.data(), 0, nullptr,
+    };
+    REQUIRE(QueueSubmit(Queue, 1, &SubmitInfo, 0) == VK_SUCCESS);
+    REQUIRE(QueueWaitIdle(Queue) == VK_SUCCESS);
+  }
+};
+
+Context CreateContext() {
+  Context Ctx {};
+  Ctx.LibVulkan = dlopen("libvulkan.so.1", RTLD_NOW);
+  REQUIRE(Ctx.LibVulkan);
+
+  VkResult (*CreateInstance)(const VkInstanceCreateInfo*, const void*, VkInstance*);
+  VkResult (*EnumeratePhysicalDevices)(VkInstance, uint32_t*, VkPhysicalDevice*);
+  void (*GetQueueFamilyProperties)(VkPhysicalDevice, uint32_t*, VkQueueFamilyProperties*);
+  void (*GetMemoryProperties)(VkPhysicalDevice, VkPhysicalDeviceMemoryProperties*);
+  VkResult (*CreateDevice)(VkPhysicalDevice, const VkDeviceCreateInfo*, const void*, VkDevice*);
+  void (*GetDeviceQueue)(VkDevice, uint32_t, uint32_t, VkQueue*);
+  VkResult (*CreateBuffer)(VkDevice, const VkBufferCreateInfo*, const void*, VkBuffer*);
+  void (*GetBufferMemoryRequirements)(VkDevice, VkBuffer, VkMemoryRequirements*);
+  VkResult (*AllocateMemory)(VkDevice, const VkMemoryAllocateInfo*, const void*, VkDeviceMemory*);
+  VkResult (*BindBufferMemory)(VkDevice, VkBuffer, VkDeviceMemory, VkDeviceSize);
+  VkResult (*MapMemory)(VkDevice, VkDeviceMemory, VkDeviceSize, VkDeviceSize, uint32_t, void**);
+  Lookup(CreateInstance, Ctx.LibVulkan, "vkCreateInstance");
+  Lookup(EnumeratePhysicalDevices, Ctx.LibVulkan, "vkEnumeratePhysicalDevices");
+  Lookup(GetQueueFamilyProperties, Ctx.LibVulkan, "vkGetPhysicalDeviceQueueFamilyProperties");
+  Lookup(GetMemoryProperties, Ctx.LibVulkan, "vkGetPhysicalDeviceMemoryProperties");
+  Lookup(CreateDevice, Ctx.LibVulkan, "vkCreateDevice");
+  Lookup(GetDeviceQueue, Ctx.LibVulkan, "vkGetDeviceQueue");
+  Lookup(CreateBuffer, Ctx.LibVulkan, "vkCreateBuffer");
+  Lookup(GetBufferMemoryRequirements, Ctx.LibVulkan, "vkGetBufferMemoryRequirements");
+  Lookup(AllocateMemory, Ctx.LibVulkan, "vkAllocateMemory");
+  Lookup(BindBufferMemory, Ctx.LibVulkan, "vkBindBufferMemory");
+  Lookup(MapMemory, Ctx.LibVulkan, "vkMapMemory");
+  Lookup(Ctx.CreateCommandPool, Ctx.LibVulkan, "vkCreateCommandPool");
+  Lookup(Ctx.DestroyCommandPool, Ctx.LibVulkan, "vkDestroyCommandPool");
+  Lookup(Ctx.GetDeviceProcAddr, Ctx.LibVulkan, "vkGetDeviceProcAddr");
+  Lookup(Ctx.AllocateCommandBuffers, Ctx.LibVulkan, "vkAllocateCommandBuffers");
+  Lookup(Ctx.FreeCommandBuffers, Ctx.LibVulkan, "vkFreeCommandBuffers");
+  Lookup(Ctx.ResetCommandPool, Ctx.LibVulkan, "vkResetCommandPool");
+  Lookup(Ctx.QueueSubmit, Ctx.LibVulkan, "vkQueueSubmit");
+  Lookup(Ctx.QueueWaitIdle, Ctx.LibVulkan, "vkQueueWaitIdle");
+
+  const VkApplicationInfo AppInfo { VK_STRUCTURE_TYPE_APPLICATION_INFO, nullptr, "vulkan-recording", 1, nullptr, 0, VK_API_VERSION_1_0 };
+  const VkInstanceCreateInfo InstanceInfo { VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO, nullptr, 0, &AppInfo, 0, nullptr, 0, nullptr };
+  VkInstance Instance {};
+  REQUIRE(CreateInstance(&InstanceInfo, nullptr, &Instance) == VK_SUCCESS);
+
+  uint32_t NumDevices = 1;
+  VkPhysicalDevice PhysicalDevice {};
+  EnumeratePhysicalDevices(Instance, &NumDevices, &PhysicalDevice);
+  REQUIRE(NumDevices >= 1);
+
+  uint32_t NumFamilies = 0;
+  GetQueueFamilyProperties(PhysicalDevice, &NumFamilies, nullptr);
+  std::vector<VkQueueFamilyProperties> Families(NumFamilies);
+  GetQueueFamilyProperties(PhysicalDevice, &NumFamilies, Families.data());
+  uint32_t &Family = Ctx.Family;
+  while (Family < NumFamilies && !(Families[Family].queueFlags & VK_QUEUE_TRANSFER_BITS)) {
+    ++Family;
+  }
+  REQUIRE(Family < NumFamilies);
+
+  const float Priority = 1.0f;
+  const VkDeviceQueueCreateInfo QueueInfo { VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO, nullptr, 0, Family, 1, &Priority };
+  const VkDeviceCreateInfo DeviceInfo { VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO, nullptr, 0, 1, &QueueInfo, 0, nullptr, 0, nullptr, nullptr };
+  REQUIRE(CreateDevice(PhysicalDevice, &DeviceInfo, nullptr, &Ctx.Device) == VK_SUCCESS);
+  GetDeviceQueue(Ctx.Device, Family, 0, &Ctx.Queue);
+
+  const VkBufferCreateInfo BufferInfo {
+    VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO, nullptr, 0, Context::BufferWords * sizeof(uint32_t),
+    VK_BUFFER_USAGE_TRANSFER_DST_BIT, 0, 0, nullptr,
+  };
+  REQUIRE(CreateBuffer(Ctx.Device, &BufferInfo, nullptr, &Ctx.Buffer) == VK_SUCCESS);
+
+  VkMemoryRequirements Requirements {};
+  GetBufferMemoryRequirements(Ctx.Device, Ctx.Buffer, &Requirements);
+  VkPhysicalDeviceMemoryProperties MemoryProperties {};
+  GetMemoryProperties(PhysicalDevice, &MemoryProperties);
+  constexpr uint32_t HostMemory = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+  uint32_t MemoryType = 0;
+  while (MemoryType < MemoryProperties.memoryTypeCount &&
+         (!(Requirements.memoryTypeBits & (1U << MemoryType)) ||
+          (MemoryProperties.memoryTypes[MemoryType].propertyFlags & HostMemory) != HostMemory)) {
+    ++MemoryType;
+  }
+  REQUIRE(MemoryType < MemoryProperties.memoryTypeCount);
+
+  const VkMemoryAllocateInfo AllocateInfo { VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO, nullptr, Requirements.size, MemoryType };
+  VkDeviceMemory Memory {};
+  REQUIRE(AllocateMemory(Ctx.Device, &AllocateInfo, nullptr, &Memory) == VK_SUCCESS);
+  REQUIRE(BindBufferMemory(Ctx.Device, Ctx.Buffer, Memory, 0) == VK_SUCCESS);
+  REQUIRE(MapMemory(Ctx.Device, Memory, 0, Requirements.size, 0, reinterpret_cast<void**>(&Ctx.Mapped)) == VK_SUCCESS);
+
+  Ctx.Pool = Ctx.CreatePool();
+  return Ctx;
+}
+
+// Functions exported from libvulkan are called through the direct thunks
+CommandFunctions DirectFunctions(const Context &Ctx) {
+  CommandFunctions Fn;
+  Lookup(Fn.BeginCommandBuffer, Ctx.LibVulkan, "vkBeginCommandBuffer");
+  Lookup(Fn.EndCommandBuffer, Ctx.LibVulkan, "vkEndCommandBuffer");
+  Lookup(Fn.CmdFillBuffer, Ctx.LibVulkan, "vkCmdFillBuffer");
+  Lookup(Fn.CmdSetStencilReference, Ctx.LibVulkan, "vkCmdSetStencilReference");
+  Lookup(Fn.CmdSetViewport, Ctx.LibVulkan, "vkCmdSetViewport");
+  Lookup(Fn.CmdUpdateBuffer, Ctx.LibVulkan, "vkCmdUpdateBuffer");
+  Lookup(Fn.CmdPipelineBarrier, Ctx.LibVulkan, "vkCmdPipelineBarrier");
+  return Fn;
+}
+
+// Functions returned by vkGetDeviceProcAddr are called through the signature-based indirect thunks, like in DXVK
+CommandFunctions ProcAddressFunctions(const Context &Ctx) {
+  auto Get = [&](auto &Target, const char *Name) {
+    Target = reinterpret_cast<std::remove_reference_t<decltype(Target)>>(Ctx.GetDeviceProcAddr(Ctx.Device, Name));
+    REQUIRE(Target);
+  };
+
+  CommandFunctions Fn;
+  Get(Fn.BeginCommandBuffer, "vkBeginCommandBuffer");
+  Get(Fn.EndCommandBuffer, "vkEndCommandBuffer");
+  Get(Fn.CmdFillBuffer, "vkCmdFillBuffer");
+  Get(Fn.CmdSetStencilReference, "vkCmdSetStencilReference");
+  Get(Fn.CmdSetViewport, "vkCmdSetViewport");
+  Get(Fn.CmdUpdateBuffer, "vkCmdUpdateBuffer");
+  Get(Fn.CmdPipelineBarrier, "vkCmdPipelineBarrier");
+  return Fn;
+}
+
+void Begin(const CommandFunctions &Fn, VkCommandBuffer CommandBuffer) {
+  const VkCommandBufferBeginInfo BeginInfo { VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO, nullptr, 0, nullptr };
+  REQUIRE(Fn.BeginCommandBuffer(CommandBuffer, &BeginInfo) == VK_SUCCESS);
+}
+
+void TransferBarrier(const CommandFunctions &Fn, VkCommandBuffer CommandBuffer) {
+  const VkMemoryBarrier Barrier { VK_STRUCTURE_TYPE_MEMORY_BARRIER, nullptr, VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_TRANSFER_WRITE_BIT };
+  Fn.CmdPipelineBarrier(CommandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 1, &Barrier, 0, nullptr, 0, nullptr);
+}
+
+void CheckCommands(Context &Ctx, const CommandFunctions &Fn) {
+  auto CommandBuffer = Ctx.AllocateCommandBuffer();
+
+  // Recorded commands are replayed before commands that aren't recorded
+  Begin(Fn, CommandBuffer);
+  Fn.CmdFillBuffer(CommandBuffer, Ctx.Buffer, 0, Context::BufferWords * sizeof(uint32_t), 1);
+  TransferBarrier(Fn, CommandBuffer);
+  const uint32_t Value = 2;
+  Fn.CmdUpdateBuffer(CommandBuffer, Ctx.Buffer, 0, sizeof(Value), &Value);
+  TransferBarrier(Fn, CommandBuffer);
+  Fn.CmdFillBuffer(CommandBuffer, Ctx.Buffer, sizeof(uint32_t), sizeof(uint32_t), 3);
+  REQUIRE(Fn.EndCommandBuffer(CommandBuffer) == VK_SUCCESS);
+  Ctx.Submit({CommandBuffer});
+  CHECK(Ctx.Mapped[0] == 2);
+  CHECK(Ctx.Mapped[1] == 3);
+  CHECK(Ctx.Mapped[2] == 1);
+  CHECK(Ctx.Mapped[Context::BufferWords - 1] == 1);
+
+  // Streams span many blocks and belong to the command buffer, not the thread
+  auto Second = Ctx.AllocateCommandBuffer();
+  Begin(Fn, CommandBuffer);
+  Begin(Fn, Second);
+  constexpr size_t Half = Context::BufferWords / 2;
+  for (uint32_t i = 0; i < Half; ++i) {
+    Fn.CmdFillBuffer(CommandBuffer, Ctx.Buffer, i * sizeof(uint32_t), sizeof(uint32_t), i);
+    Fn.CmdFillBuffer(Second, Ctx.Buffer, (Half + i) * sizeof(uint32_t), sizeof(uint32_t), Half + i);
+  }
+  std::thread([&] {
+    REQUIRE(Fn.EndCommandBuffer(CommandBuffer) == VK_SUCCESS);
+  }).join();
+  REQUIRE(Fn.EndCommandBuffer(Second) == VK_SUCCESS);
+  Ctx.Submit({CommandBuffer, Second});
+  size_t Mismatches = 0;
+  for (uint32_t i = 0; i < Context::BufferWords; ++i) {
+    Mismatches += Ctx.Mapped[i] != i;
+  }
+  CHECK(Mismatches == 0);
+
+  // Commands left over from a command buffer that was reset during recording are dropped
+  Begin(Fn, CommandBuffer);
+  Fn.CmdFillBuffer(CommandBuffer, Ctx.Buffer, 0, sizeof(uint32_t), 4);
+  REQUIRE(Ctx.ResetCommandPool(Ctx.Device, Ctx.Pool, 0) == VK_SUCCESS);
+  Begin(Fn, CommandBuffer);
+  Fn.CmdFillBuffer(CommandBuffer, Ctx.Buffer, sizeof(uint32_t), sizeof(uint32_t), 5);
+  REQUIRE(Fn.EndCommandBuffer(CommandBuffer) == VK_SUCCESS);
+  Ctx.Submit({CommandBuffer});
+  CHECK(Ctx.Mapped[0] == 0);
+  CHECK(Ctx.Mapped[1] == 5);
+
+  const VkCommandBuffer CommandBuffers[] = { CommandBuffer, Second };
+  Ctx.FreeCommandBuffers(Ctx.Device, Ctx.Pool, 2, CommandBuffers);
+
+  // Destroying a pool drops the streams of its command buffers, even if the handles are reused right away
+  for (uint32_t i = 0; i < 16; ++i) {
+    auto Pool = Ctx.CreatePool();
+    auto Pending = Ctx.AllocateCommandBuffer(Pool);
+    Begin(Fn, Pending);
+    Fn.CmdFillBuffer(Pending, Ctx.Buffer, 0, sizeof(uint32_t), 6);
+    Ctx.DestroyCommandPool(Ctx.Device, Pool, nullptr);
+  }
+  auto Pool = Ctx.CreatePool();
+  auto Fresh = Ctx.AllocateCommandBuffer(Pool);
+  Begin(Fn, Fresh);
+  Fn.CmdFillBuffer(Fresh, Ctx.Buffer, sizeof(uint32_t), sizeof(uint32_t), 7);
+  REQUIRE(Fn.EndCommandBuffer(Fresh) == VK_SUCCESS);
+  Ctx.Submit({Fresh});
+  CHECK(Ctx.Mapped[0] == 0);
+  CHECK(Ctx.Mapped[1] == 7);
+  Ctx.DestroyCommandPool(Ctx.Device, Pool, nullptr);
+}
+}
+
+TEST_CASE("Vulkan recording: commands", "[.][vulkan]") {
+  auto Ctx = CreateContext();
+
+  SECTION("Direct calls") {
+    CheckCommands(Ctx, DirectFunctions(Ctx));
+  }
+
+  SECTION("vkGetDeviceProcAddr") {
+    CheckCommands(Ctx, ProcAddressFunctions(Ctx));
+  }
+}
+
+TEST_CASE("Vulkan recording: command throughput", "[.][vulkan][benchmark]") {
+  auto Ctx = CreateContext();
+  auto CommandBuffer = Ctx.AllocateCommandBuffer();
+  constexpr int Iterations = 1000000;
+
+  auto Measure = [&](const CommandFunctions &Fn, auto &&Body) {
+    Begin(Fn, CommandBuffer);
+    auto Start = std::chrono::steady_clock::now();
+    for (int i = 0; i < Iterations; ++i) {
+      Body(Fn, i);
+    }
+    // Include the time it takes for the commands to be recorded on the host
+    REQUIRE(Fn.EndCommandBuffer(CommandBuffer) == VK_SUCCESS);
+    std::chrono::duration<double> Time = std::chrono::steady_clock::now() - Start;
+    return Iterations / Time.count() / 1e6;
+  };
+
+  printf("%-24s %16s %16s\n", "command", "direct Mcmds/s", "getproc Mcmds/s");
+  auto Report = [&](const char *Name, auto &&Body) {
+    auto Direct = DirectFunctions(Ctx);
+    auto Indirect = ProcAddressFunctions(Ctx);
+    printf("%-24s %16.2f %16.2f\n", Name, Measure(Direct, Body), Measure(Indirect, Body));
+  };
+
+  Report("vkCmdSetStencilReference", [&](const CommandFunctions &Fn, int i) {
+    Fn.CmdSetStencilReference(CommandBuffer, VK_STENCIL_FACE_FRONT_AND_BACK, i & 0xff);
+  });
+  Report("vkCmdSetViewport", [&](const CommandFunctions &Fn, int i) {
+    const VkViewport Viewport { 0.0f, 0.0f, 64.0f + (i & 0xff), 64.0f, 0.0f, 1.0f };
+    Fn.CmdSetViewport(CommandBuffer, 0, 1, &Viewport);
+  });
+  Report("vkCmdFillBuffer", [&](const CommandFunctions &Fn, int i) {
+    Fn.CmdFillBuffer(CommandBuffer, Ctx.Buffer, (i % Context::BufferWords) * sizeof(uint32_t), sizeof(uint32_t), i);
+  });
+}
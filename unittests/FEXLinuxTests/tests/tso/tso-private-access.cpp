@@ -0,0 +1,116 @@
+/*
+  stresses TSO ordering of shared memory while threads hammer thread-private memory
+
+  creates 8 threads split in to producer/consumer pairs
+  each pair does message passing through shared memory
+  in between each message both threads do RBP frame and thread_local accesses
+
+  the shared accesses must keep TSO ordering even when the private accesses are relaxed
+*/
+// FEX config: FEX_TSORELAXPRIVATEACCESSES=1
+#include <cstdio>
+#include <pthread.h>
+
+#include <atomic>
+#include <cstdint>
+
+#include <catch2/catch.hpp>
+
+constexpr int NumPairs = 4;
+constexpr int NumMessages = 100000;
+
+struct alignas(64) Channel {
+  // Accessed through plain loads and stores, only TSO ordering keeps these consistent.
+  volatile uint32_t Data[4];
+  volatile uint32_t Sequence;
+};
+
+Channel Channels[NumPairs];
+
+thread_local uint64_t TLSAccumulator;
+std::atomic<int> result;
+
+__attribute__((noinline))
+static uint32_t PrivateWork(uint32_t Seed) {
+  // volatile locals force real frame accesses
+  volatile uint32_t Frame[8];
+  for (int i = 0; i < 8; ++i) {
+    Frame[i] = Seed + i;
+  }
+
+  uint32_t Sum{};
+  for (int i = 0; i < 8; ++i) {
+    Sum += Frame[i];
+  }
+
+  TLSAccumulator += Sum;
+  return Sum;
+}
+
+void *producer(void *arg) {
+  auto Chan = &Channels[reinterpret_cast<uintptr_t>(arg)];
+  uint64_t Expected{};
+
+  for (uint32_t Seq = 1; Seq <= NumMessages; ++Seq) {
+    Expected += PrivateWork(Seq);
+
+    Chan->Data[0] = Seq;
+    Chan->Data[1] = Seq + 1;
+    Chan->Data[2] = Seq + 2;
+    Chan->Data[3] = Seq + 3;
+    // Publish, with TSO all Data stores are visible before this one
+    Chan->Sequence = Seq;
+
+    // Wait for the consumer to acknowledge
+    while (Chan->Sequence != 0);
+  }
+
+  result |= TLSAccumulator != Expected;
+  return nullptr;
+}
+
+void *consumer(void *arg) {
+  auto Chan = &Channels[reinterpret_cast<uintptr_t>(arg)];
+  uint64_t Expected{};
+  int Failures{};
+
+  for (uint32_t Seq = 1; Seq <= NumMessages; ++Seq) {
+    uint32_t Observed;
+    while ((Observed = Chan->Sequence) == 0);
+
+    if (Observed != Seq ||
+        Chan->Data[0] != Seq ||
+        Chan->Data[1] != Seq + 1 ||
+        Chan->Data[2] != Seq + 2 ||
+        Chan->Data[3] != Seq + 3) {
+      ++Failures;
+    }
+
+    Expected += PrivateWork(Seq * 3);
+
+    Chan->Sequence = 0;
+  }
+
+  if (Failures) {
+    printf("Consumer observed %d out of order messages\n", Failures);
+  }
+
+  result |= Failures != 0;
+  result |= TLSAccumulator != Expected;
+  return nullptr;
+}
+
+TEST_CASE("TSO: Shared ordering with thread-private stack and TLS accesses") {
+  pthread_t tid[NumPairs * 2];
+  for (uintptr_t i = 0; i < NumPairs; i++) {
+    pthread_create(&tid[i * 2], 0, &producer, reinterpret_cast<void*>(i));
+    pthread_create(&tid[i * 2 + 1], 0, &consumer, reinterpret_cast<void*>(i));
+  }
+
+  for (int i = 0; i < NumPairs * 2; i++) {
+    void *rv;
+    pthread_join(tid[i], &rv);
+  }
+
+  CHECK(result == 0);
+}
@@ -0,0 +1,122 @@
+/*
+  checks that RBP relative accesses keep TSO ordering when RBP isn't a frame pointer
+
+  built with -fomit-frame-pointer, where RBP is a general purpose register
+  creates 8 threads split in to producer/consumer pairs
+  each pair does message passing through shared memory that is only addressed through RBP
+
+  the accesses must not be classified as thread-private stack accesses
+*/
+// FEX config: FEX_TSORELAXPRIVATEACCESSES=1
+#include <cstdio>
+#include <pthread.h>
+
+#include <atomic>
+#include <cstdint>
+
+#include <catch2/catch.hpp>
+
+constexpr int NumPairs = 4;
+constexpr int NumMessages = 100000;
+
+struct alignas(64) Channel {
+  volatile uint32_t Data[4];
+  volatile uint32_t Sequence;
+};
+
+Channel Channels[NumPairs];
+
+std::atomic<int> result;
+
+// Clobbering RBP requires building without a frame pointer, the compiler saves and restores it
+__attribute__((noinline))
+static void Publish(Channel *Chan, uint32_t Seq) {
+  asm volatile(
+    "mov %[Chan], %%rbp\n"
+    "movl %[Seq], 0(%%rbp)\n"
+    "movl %[Seq], 4(%%rbp)\n"
+    "movl %[Seq], 8(%%rbp)\n"
+    "movl %[Seq], 12(%%rbp)\n"
+    // Publish, with TSO all Data stores are visible before this one
+    "movl %[Seq], 16(%%rbp)\n"
+    :
+    : [Chan] "r" (Chan), [Seq] "r" (Seq)
+    : "rbp", "memory");
+}
+
+// Returns the sequence number, Data gets the message if it was published
+__attribute__((noinline))
+static uint32_t Receive(Channel *Chan, uint32_t Data[4]) {
+  uint32_t Seq, D0, D1, D2, D3;
+  asm volatile(
+    "mov %[Chan], %%rbp\n"
+    "movl 16(%%rbp), %[Seq]\n"
+    "movl 0(%%rbp), %[D0]\n"
+    "movl 4(%%rbp), %[D1]\n"
+    "movl 8(%%rbp), %[D2]\n"
+    "movl 12(%%rbp), %[D3]\n"
+    : [Seq] "=&r" (Seq), [D0] "=&r" (D0), [D1] "=&r" (D1), [D2] "=&r" (D2), [D3] "=&r" (D3)
+    : [Chan] "r" (Chan)
+    : "rbp", "memory");
+  Data[0] = D0;
+  Data[1] = D1;
+  Data[2] = D2;
+  Data[3] = D3;
+  return Seq;
+}
+
+void *producer(void *arg) {
+  auto Chan = &Channels[reinterpret_cast<uintptr_t>(arg)];
+
+  for (uint32_t Seq = 1; Seq <= NumMessages; ++Seq) {
+    Publish(Chan, Seq);
+
+    // Wait for the consumer to acknowledge
+    while (Chan->Sequence != 0);
+  }
+
+  return nullptr;
+}
+
+void *consumer(void *arg) {
+  auto Chan = &Channels[reinterpret_cast<uintptr_t>(arg)];
+  int Failures{};
+
+  for (uint32_t Seq = 1; Seq <= NumMessages; ++Seq) {
+    uint32_t Data[4];
+    uint32_t Observed;
+    while ((Observed = Receive(Chan, Data)) == 0);
+
+    if (Observed != Seq ||
+        Data[0] != Seq ||
+        Data[1] != Seq ||
+        Data[2] != Seq ||
+        Data[3] != Seq) {
+      ++Failures;
+    }
+
+    Chan->Sequence = 0;
+  }
+
+  if (Failures) {
+    printf("Consumer observed %d out of order messages\n", Failures);
+  }
+
+  result |= Failures != 0;
+  return nullptr;
+}
+
+TEST_CASE("TSO: Shared ordering through RBP without a frame pointer") {
+  pthread_t tid[NumPairs * 2];
+  for (uintptr_t i = 0; i < NumPairs; i++) {
+    pthread_create(&tid[i * 2], 0, &producer, reinterpret_cast<void*>(i));
+    pthread_create(&tid[i * 2 + 1], 0, &consumer, reinterpret_cast<void*>(i));
+  }
+
+  for (int i = 0; i < NumPairs * 2; i++) {
+    void *rv;
+    pthread_join(tid[i], &rv);
+  }
+
+  CHECK(result == 0);
+}
@@ -218,6 +218,12 @@ static void run_tool(clang::tooling::ToolAction& action, std::string_view code,
     const char* common_header_code = R"(namespace fexgen {
 struct returns_guest_pointer {};
 struct custom_host_impl {};
+struct custom_guest_entrypoint {};
+struct no_batch {};
+struct record_command {};
+struct generate_guest_symtable {};
+struct indirect_guest_calls {};
+struct batch_state_calls {};
 struct callback_annotation_base { bool prevent_multiple; };
 struct callback_stub : callback_annotation_base {};
 struct callback_guest : callback_annotation_base {};
@@ -277,9 +283,34 @@ SourceWithAST Fixture::run_thunkgen_guest(std::string_view prelude, std::string_
     std::string result =
         "#include <cstdint>\n"
         "#define MAKE_THUNK(lib, name, hash) extern \"C\" int fexthunks_##lib##_##name(void*);\n"
+        "#define MAKE_REGISTER_THUNK(lib, name, hash, flags) extern \"C\" int fexthunks_##lib##_##name(void*);\n"
         "template<typename>\n"
         "struct callback_thunk_defined;\n"
         "#define MAKE_CALLBACK_THUNK(name, sig, hash) template<> struct callback_thunk_defined<sig> {};\n"
+        "template<typename>\n"
+        "struct batched_callback_thunk_defined;\n"
+        "#define MAKE_BATCHED_CALLBACK_THUNK(name, sig, hash, flush, id) template<> struct batched_callback_thunk_defined<sig> {};\n"
+        "#define MAKE_FLUSHING_CALLBACK_THUNK(name, sig, hash, flush) template<> struct callback_thunk_defined<sig> {};\n"
+        "template<typename>\n"
+        "struct recorded_callback_thunk_defined;\n"
+        "#define MAKE_RECORDED_CALLBACK_THUNK(name, sig, hash, flush, id) template<> struct recorded_callback_thunk_defined<sig> {};\n"
+        "#define MAKE_STREAM_FLUSHING_CALLBACK_THUNK(name, sig, hash, flush) template<> struct callback_thunk_defined<sig> {};\n"
+        "template<typename>\n"
+        "struct register_callback_thunk_defined;\n"
+        "#define MAKE_REGISTER_CALLBACK_THUNK(name, sig, hash, flags) template<> struct register_callback_thunk_defined<sig> {};\n"
+        "#define FEX_REGISTER_THUNKS 1\n"
+        "template<auto, typename Result, typename... Args>\n"
+        "Result CallThunkWithRegisters(Args...);\n"
+        "template<auto>\n"
+        "struct CallBatch {\n"
+        "  static bool Append(uint64_t, const void*, unsigned long);\n"
+        "  static void Flush();\n"
+        "};\n"
+        "template<auto>\n"
+        "struct CommandStreams {\n"
+        "  static bool Append(const void*, uint64_t, const void*, unsigned long);\n"
+        "  static void Flush(const void*);\n"
+        "};\n"
         "#define FEX_PACKFN_LINKAGE\n"
         "template<typename Target>\n"
         "Target *MakeHostTrampolineForGuestFunction(uint8_t HostPacker[32], void (*)(uintptr_t, void*), Target*);\n"
@@ -305,6 +336,8 @@ SourceWithAST Fixture::run_thunkgen_host(std::string_view prelude, std::string_v
 
     std::string result =
         "#include <cstdint>\n"
+        "#include <cstdio>\n"
+        "#include <cstdlib>\n"
         "#include <dlfcn.h>\n"
         "template<typename Fn>\n"
         "struct function_traits;\n"
@@ -329,10 +362,13 @@ SourceWithAST Fixture::run_thunkgen_host(std::string_view prelude, std::string_v
         "template<typename>\n"
         "struct CallbackUnpack {\n"
         "  static void ForIndirectCall(void* argsv);\n"
+        "  static void ForIndirectRegisterCall();\n"
         "};\n"
         "template<typename F>\n"
         "void FinalizeHostTrampolineForGuestFunction(F*);\n"
-        "struct ExportEntry { uint8_t* sha256; void(*fn)(void *); };\n";
+        "struct ExportEntry { uint8_t* sha256; void(*fn)(void *); };\n"
+        "struct BatchedCallHeader { uint64_t Id; void* Args(); BatchedCallHeader* Next(); };\n"
+        "struct BatchedCallRange { BatchedCallHeader* Begin; BatchedCallHeader* End; };\n";
 
     auto& filename = output_filenames.host;
     {
@@ -367,11 +403,11 @@ TEST_CASE_METHOD(Fixture, "Trivial") {
             parameterCountIs(0)
         )));
 
-    // Host code
+    // Host code: packed and register entry points
     CHECK_THAT(output.host,
         matches(varDecl(
             hasName("exports"),
-            hasType(constantArrayType(hasElementType(asString("struct ExportEntry")), hasSize(2))),
+            hasType(constantArrayType(hasElementType(asString("struct ExportEntry")), hasSize(3))),
             hasInitializer(initListExpr(hasInit(0, expr()),
                                         hasInit(1, initListExpr(hasInit(0, implicitCastExpr()), hasInit(1, implicitCastExpr())))))
             // TODO: check null termination
@@ -417,11 +453,11 @@ TEST_CASE_METHOD(Fixture, "FunctionPointerViaType") {
             hasTemplateArgument(0, refersToType(asString("int (char, char)")))
         )));
 
-    // Host should export the unpacking function for callback arguments
+    // Host should export the unpacking functions for callback arguments, in memory and in registers
     CHECK_THAT(output.host,
         matches(varDecl(
             hasName("exports"),
-            hasType(constantArrayType(hasElementType(asString("struct ExportEntry")), hasSize(2))),
+            hasType(constantArrayType(hasElementType(asString("struct ExportEntry")), hasSize(3))),
             hasInitializer(hasDescendant(declRefExpr(to(cxxMethodDecl(hasName("ForIndirectCall"), ofClass(hasName("CallbackUnpack"))).bind("funcptr")))))
             )).check_binding("funcptr", +[](const clang::CXXMethodDecl* decl) {
                 auto parent = llvm::cast<clang::ClassTemplateSpecializationDecl>(decl->getParent());
@@ -455,11 +491,11 @@ TEST_CASE_METHOD(Fixture, "FunctionPointerParameter") {
             return funcptr->getType().getAsString() == "int (*)(char, char)";
         }));
 
-    // Host should export the unpacking function for function pointer arguments
+    // Host should export the unpacking functions for function pointer arguments
     CHECK_THAT(output.host,
         matches(varDecl(
             hasName("exports"),
-            hasType(constantArrayType(hasElementType(asString("struct ExportEntry")), hasSize(3))),
+            hasType(constantArrayType(hasElementType(asString("struct ExportEntry")), hasSize(4))),
             hasInitializer(hasDescendant(declRefExpr(to(cxxMethodDecl(hasName("ForIndirectCall"), ofClass(hasName("CallbackUnpack")))))))
             )));
 }
@@ -580,3 +616,175 @@ TEST_CASE_METHOD(Fixture, "VariadicFunctionsWithoutAnnotation") {
         "template<auto> struct fex_gen_config {};\n"
         "template<> struct fex_gen_config<func> {};\n", true));
 }
+
+TEST_CASE_METHOD(Fixture, "BatchedCalls") {
+    const std::string prelude =
+        "void state(int, float);\n"
+        "void draw(int);\n"
+        "void pointer(int*);\n"
+        "int query(int);\n";
+
+    const auto output = run_thunkgen(prelude,
+        "#include <thunks_common.h>\n"
+        "template<auto> struct fex_gen_config : fexgen::batch_state_calls, fexgen::indirect_guest_calls {};\n"
+        "template<> struct fex_gen_config<state> {};\n"
+        "template<> struct fex_gen_config<draw> : fexgen::no_batch {};\n"
+        "template<> struct fex_gen_config<pointer> {};\n"
+        "template<> struct fex_gen_config<query> {};\n");
+
+    auto calls = [](const char* name) {
+        return hasDescendant(callExpr(callee(functionDecl(hasName(name)))));
+    };
+
+    // Only functions without return value and pointer arguments are recorded
+    CHECK_THAT(output.guest, matches(functionDecl(hasName("fexfn_pack_state"), calls("Append"))));
+    for (auto function : { "fexfn_pack_draw", "fexfn_pack_pointer", "fexfn_pack_query" }) {
+        CHECK_THAT(output.guest, matches(functionDecl(hasName(function), calls("Flush"), unless(calls("Append")))));
+    }
+
+    // Indirect calls are batched based on their signature
+    CHECK_THAT(output.guest,
+        matches(classTemplateSpecializationDecl(
+            hasName("batched_callback_thunk_defined"),
+            hasTemplateArgument(0, refersToType(asString("void (int, float)")))
+        )));
+    CHECK_THAT(output.guest,
+        matches(classTemplateSpecializationDecl(
+            hasName("callback_thunk_defined"),
+            hasTemplateArgument(0, refersToType(asString("void (int)")))
+        )));
+
+    // Host executes recorded calls of both kinds
+    CHECK_THAT(output.host,
+        matches(functionDecl(
+            hasName("fexfn_unpack_libtest_fexbatch_flush"),
+            calls("fexfn_unpack_libtest_state"),
+            calls("ForIndirectCall"),
+            unless(calls("fexfn_unpack_libtest_draw"))
+        )));
+
+    // 4 functions, 3 register entry points for the unbatched ones, 4 signatures, the flush endpoint and the terminator
+    CHECK_THAT(output.host,
+        matches(varDecl(
+            hasName("exports"),
+            hasType(constantArrayType(hasElementType(asString("struct ExportEntry")), hasSize(13)))
+            )));
+
+    // Register calls flush the batch as well
+    CHECK_THAT(output.guest, matches(functionDecl(hasName("fexfn_pack_query"), calls("Flush"), calls("CallThunkWithRegisters"))));
+}
+
+TEST_CASE_METHOD(Fixture, "RegisterCalls") {
+    const std::string prelude =
+        "struct TestStruct { int member; };\n"
+        "int regs(int, const char*, unsigned long);\n"
+        "void by_value(TestStruct);\n"
+        "float fp(float);\n"
+        "int many(int, int, int, int, int, int, int);\n";
+
+    const auto output = run_thunkgen(prelude,
+        "#include <thunks_common.h>\n"
+        "template<auto> struct fex_gen_config : fexgen::indirect_guest_calls {};\n"
+        "template<> struct fex_gen_config<regs> {};\n"
+        "template<> struct fex_gen_config<by_value> {};\n"
+        "template<> struct fex_gen_config<fp> {};\n"
+        "template<> struct fex_gen_config<many> {};\n");
+
+    auto calls = [](const char* name) {
+        return hasDescendant(callExpr(callee(functionDecl(hasName(name)))));
+    };
+
+    // Only integer and pointer arguments that fit in the argument registers skip packing
+    CHECK_THAT(output.guest, matches(functionDecl(hasName("fexfn_pack_regs"), calls("CallThunkWithRegisters"))));
+    for (auto function : { "fexfn_pack_by_value", "fexfn_pack_fp", "fexfn_pack_many" }) {
+        CHECK_THAT(output.guest, matches(functionDecl(hasName(function), unless(calls("CallThunkWithRegisters")))));
+    }
+
+    // Host calls the implementation directly with the register arguments
+    CHECK_THAT(output.host,
+        matches(functionDecl(
+            hasName("fexfn_unpack_libtest_fexregs_regs"),
+            returns(asString("int")),
+            parameterCountIs(3)
+        )));
+
+    // Indirect calls need a register for the host function address as well
+    CHECK_THAT(output.guest,
+        matches(classTemplateSpecializationDecl(
+            hasName("register_callback_thunk_defined"),
+            hasTemplateArgument(0, refersToType(asString("int (int, const char *, unsigned long)")))
+        )));
+
+    // 4 functions, 1 register entry point, 4 signatures, 1 register signature and the terminator
+    CHECK_THAT(output.host,
+        matches(varDecl(
+            hasName("exports"),
+            hasType(constantArrayType(hasElementType(asString("struct ExportEntry")), hasSize(11)))
+            )));
+}
+
+TEST_CASE_METHOD(Fixture, "RecordedCommands") {
+    const std::string prelude =
+        "struct Object;\n"
+        "void cmd(Object*, int, float);\n"
+        "void cmd_pointer(Object*, const int*);\n"
+        "int end(Object*);\n"
+        "void other(int);\n";
+
+    const auto output = run_thunkgen(prelude,
+        "#include <thunks_common.h>\n"
+        "template<auto> struct fex_gen_config : fexgen::indirect_guest_calls {};\n"
+        "template<> struct fex_gen_config<cmd> : fexgen::record_command {};\n"
+        "template<> struct fex_gen_config<cmd_pointer> : fexgen::record_command, fexgen::custom_guest_entrypoint {};\n"
+        "template<> struct fex_gen_config<end> {};\n"
+        "template<> struct fex_gen_config<other> {};\n");
+
+    auto calls = [](const char* name) {
+        return hasDescendant(callExpr(callee(functionDecl(hasName(name)))));
+    };
+
+    // Recorded calls are appended to the stream of their first argument, other calls on the same object replay it
+    for (auto function : { "fexfn_pack_cmd", "fexfn_pack_cmd_pointer" }) {
+        CHECK_THAT(output.guest, matches(functionDecl(hasName(function), calls("Append"), unless(calls("Flush")))));
+    }
+    CHECK_THAT(output.guest, matches(functionDecl(hasName("fexfn_pack_end"), calls("Flush"), unless(calls("Append")))));
+    CHECK_THAT(output.guest, matches(functionDecl(hasName("fexfn_pack_other"), unless(calls("Flush")), unless(calls("Append")))));
+
+    // Indirect calls skip custom guest entrypoints, so only signatures without pointers to data are recorded
+    CHECK_THAT(output.guest,
+        matches(classTemplateSpecializationDecl(
+            hasName("recorded_callback_thunk_defined"),
+            hasTemplateArgument(0, refersToType(asString("void (struct Object *, int, float)")))
+        )));
+    CHECK_THAT(output.guest,
+        matches(classTemplateSpecializationDecl(
+            hasName("callback_thunk_defined"),
+            hasTemplateArgument(0, refersToType(asString("void (struct Object *, const int *)")))
+        )));
+
+    // Host executes recorded calls of both kinds
+    CHECK_THAT(output.host,
+        matches(functionDecl(
+            hasName("fexfn_unpack_libtest_fexbatch_flush"),
+            calls("fexfn_unpack_libtest_cmd"),
+            calls("fexfn_unpack_libtest_cmd_pointer"),
+            calls("ForIndirectCall"),
+            unless(calls("fexfn_unpack_libtest_end"))
+        )));
+
+    // 4 functions, 2 register entry points for the unrecorded ones, 4 signatures,
+    // 1 register signature not taking the object, the flush endpoint and the terminator
+    CHECK_THAT(output.host,
+        matches(varDecl(
+            hasName("exports"),
+            hasType(constantArrayType(hasElementType(asString("struct ExportEntry")), hasSize(13)))
+            )));
+}
+
+// Recording pointer arguments requires a guest entrypoint that copies the data
+TEST_CASE_METHOD(Fixture, "RecordedCommandsWithPointers") {
+    REQUIRE_THROWS(run_thunkgen_guest("struct Object;\nvoid cmd(Object*, const int*);\n",
+        "#include <thunks_common.h>\n"
+        "template<auto> struct fex_gen_config {};\n"
+        "template<> struct fex_gen_config<cmd> : fexgen::record_command {};\n", true));
+}